@@ -5,99 +5,213 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../src/adjlgraph.c \
+../src/allocator.c \
 ../src/arraydeque.c \
 ../src/arraylist.c \
+../src/art.c \
 ../src/avltree.c \
 ../src/bfsalg.c \
+../src/bfsalg_parallel.c \
 ../src/binarysearch.c \
 ../src/binarysearchtree.c \
 ../src/binarytree.c \
+../src/bitset.c \
+../src/bloomfilter.c \
+../src/btree.c \
+../src/ccalg.c \
 ../src/circdbllinkedlist.c \
 ../src/circlinkedlist.c \
+../src/csrgraph.c \
+../src/cuckoofilter.c \
+../src/datastats.c \
 ../src/dbllinkedlist.c \
 ../src/dbllinkedlistdeque.c \
 ../src/dfsalg.c \
 ../src/dijkstrasp.c \
+../src/dijkstrasp_parallel.c \
 ../src/fibonacciheap.c \
+../src/gaplist.c \
 ../src/hashset.c \
 ../src/hashtable.c \
+../src/hashtable_concurrent.c \
 ../src/hashtable_lp.c \
+../src/hashtable_simd.c \
 ../src/indminbinaryheap.c \
 ../src/indmindaryheap.c \
+../src/indmindblheap.c \
+../src/intrusive.c \
 ../src/linkedlist.c \
 ../src/linkedlistqueue.c \
 ../src/linkedliststack.c \
+../src/lrucache.c \
 ../src/main.c \
 ../src/maxbinaryheap.c \
 ../src/minbinaryheap.c \
+../src/mstalg.c \
+../src/nodearena.c \
+../src/numanode.c \
+../src/pairingheap.c \
+../src/prbtree.c \
+../src/radixheap.c \
+../src/radixtrie.c \
 ../src/redblacktree.c \
+../src/ringqueue.c \
+../src/roaring.c \
+../src/skiplist.c \
+../src/slidingwindow.c \
+../src/snapshot.c \
+../src/sortedarray.c \
+../src/statictrie.c \
+../src/strintern.c \
+../src/taskpool.c \
+../src/topk.c \
+../src/transclosure.c \
 ../src/treeset.c \
 ../src/trie.c \
-../src/trieext.c 
+../src/trieext.c \
+../src/unionfind.c \
+../src/unrolledlist.c \
+../src/wsdeque.c 
 
 C_DEPS += \
 ./src/adjlgraph.d \
+./src/allocator.d \
 ./src/arraydeque.d \
 ./src/arraylist.d \
+./src/art.d \
 ./src/avltree.d \
 ./src/bfsalg.d \
+./src/bfsalg_parallel.d \
 ./src/binarysearch.d \
 ./src/binarysearchtree.d \
 ./src/binarytree.d \
+./src/bitset.d \
+./src/bloomfilter.d \
+./src/btree.d \
+./src/ccalg.d \
 ./src/circdbllinkedlist.d \
 ./src/circlinkedlist.d \
+./src/csrgraph.d \
+./src/cuckoofilter.d \
+./src/datastats.d \
 ./src/dbllinkedlist.d \
 ./src/dbllinkedlistdeque.d \
 ./src/dfsalg.d \
 ./src/dijkstrasp.d \
+./src/dijkstrasp_parallel.d \
 ./src/fibonacciheap.d \
+./src/gaplist.d \
 ./src/hashset.d \
 ./src/hashtable.d \
+./src/hashtable_concurrent.d \
 ./src/hashtable_lp.d \
+./src/hashtable_simd.d \
 ./src/indminbinaryheap.d \
 ./src/indmindaryheap.d \
+./src/indmindblheap.d \
+./src/intrusive.d \
 ./src/linkedlist.d \
 ./src/linkedlistqueue.d \
 ./src/linkedliststack.d \
+./src/lrucache.d \
 ./src/main.d \
 ./src/maxbinaryheap.d \
 ./src/minbinaryheap.d \
+./src/mstalg.d \
+./src/nodearena.d \
+./src/numanode.d \
+./src/pairingheap.d \
+./src/prbtree.d \
+./src/radixheap.d \
+./src/radixtrie.d \
 ./src/redblacktree.d \
+./src/ringqueue.d \
+./src/roaring.d \
+./src/skiplist.d \
+./src/slidingwindow.d \
+./src/snapshot.d \
+./src/sortedarray.d \
+./src/statictrie.d \
+./src/strintern.d \
+./src/taskpool.d \
+./src/topk.d \
+./src/transclosure.d \
 ./src/treeset.d \
 ./src/trie.d \
-./src/trieext.d 
+./src/trieext.d \
+./src/unionfind.d \
+./src/unrolledlist.d \
+./src/wsdeque.d 
 
 OBJS += \
 ./src/adjlgraph.o \
+./src/allocator.o \
 ./src/arraydeque.o \
 ./src/arraylist.o \
+./src/art.o \
 ./src/avltree.o \
 ./src/bfsalg.o \
+./src/bfsalg_parallel.o \
 ./src/binarysearch.o \
 ./src/binarysearchtree.o \
 ./src/binarytree.o \
+./src/bitset.o \
+./src/bloomfilter.o \
+./src/btree.o \
+./src/ccalg.o \
 ./src/circdbllinkedlist.o \
 ./src/circlinkedlist.o \
+./src/csrgraph.o \
+./src/cuckoofilter.o \
+./src/datastats.o \
 ./src/dbllinkedlist.o \
 ./src/dbllinkedlistdeque.o \
 ./src/dfsalg.o \
 ./src/dijkstrasp.o \
+./src/dijkstrasp_parallel.o \
 ./src/fibonacciheap.o \
+./src/gaplist.o \
 ./src/hashset.o \
 ./src/hashtable.o \
+./src/hashtable_concurrent.o \
 ./src/hashtable_lp.o \
+./src/hashtable_simd.o \
 ./src/indminbinaryheap.o \
 ./src/indmindaryheap.o \
+./src/indmindblheap.o \
+./src/intrusive.o \
 ./src/linkedlist.o \
 ./src/linkedlistqueue.o \
 ./src/linkedliststack.o \
+./src/lrucache.o \
 ./src/main.o \
 ./src/maxbinaryheap.o \
 ./src/minbinaryheap.o \
+./src/mstalg.o \
+./src/nodearena.o \
+./src/numanode.o \
+./src/pairingheap.o \
+./src/prbtree.o \
+./src/radixheap.o \
+./src/radixtrie.o \
 ./src/redblacktree.o \
+./src/ringqueue.o \
+./src/roaring.o \
+./src/skiplist.o \
+./src/slidingwindow.o \
+./src/snapshot.o \
+./src/sortedarray.o \
+./src/statictrie.o \
+./src/strintern.o \
+./src/taskpool.o \
+./src/topk.o \
+./src/transclosure.o \
 ./src/treeset.o \
 ./src/trie.o \
-./src/trieext.o 
+./src/trieext.o \
+./src/unionfind.o \
+./src/unrolledlist.o \
+./src/wsdeque.o 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -112,7 +226,7 @@ src/%.o: ../src/%.c src/subdir.mk
 clean: clean-src
 
 clean-src:
-	-$(RM) ./src/adjlgraph.d ./src/adjlgraph.o ./src/arraydeque.d ./src/arraydeque.o ./src/arraylist.d ./src/arraylist.o ./src/avltree.d ./src/avltree.o ./src/bfsalg.d ./src/bfsalg.o ./src/binarysearch.d ./src/binarysearch.o ./src/binarysearchtree.d ./src/binarysearchtree.o ./src/binarytree.d ./src/binarytree.o ./src/circdbllinkedlist.d ./src/circdbllinkedlist.o ./src/circlinkedlist.d ./src/circlinkedlist.o ./src/dbllinkedlist.d ./src/dbllinkedlist.o ./src/dbllinkedlistdeque.d ./src/dbllinkedlistdeque.o ./src/dfsalg.d ./src/dfsalg.o ./src/dijkstrasp.d ./src/dijkstrasp.o ./src/fibonacciheap.d ./src/fibonacciheap.o ./src/hashset.d ./src/hashset.o ./src/hashtable.d ./src/hashtable.o ./src/hashtable_lp.d ./src/hashtable_lp.o ./src/indminbinaryheap.d ./src/indminbinaryheap.o ./src/indmindaryheap.d ./src/indmindaryheap.o ./src/linkedlist.d ./src/linkedlist.o ./src/linkedlistqueue.d ./src/linkedlistqueue.o ./src/linkedliststack.d ./src/linkedliststack.o ./src/main.d ./src/main.o ./src/maxbinaryheap.d ./src/maxbinaryheap.o ./src/minbinaryheap.d ./src/minbinaryheap.o ./src/redblacktree.d ./src/redblacktree.o ./src/treeset.d ./src/treeset.o ./src/trie.d ./src/trie.o ./src/trieext.d ./src/trieext.o
+	-$(RM) ./src/adjlgraph.d ./src/adjlgraph.o ./src/allocator.d ./src/allocator.o ./src/arraydeque.d ./src/arraydeque.o ./src/arraylist.d ./src/arraylist.o ./src/art.d ./src/art.o ./src/avltree.d ./src/avltree.o ./src/bfsalg.d ./src/bfsalg.o ./src/bfsalg_parallel.d ./src/bfsalg_parallel.o ./src/binarysearch.d ./src/binarysearch.o ./src/binarysearchtree.d ./src/binarysearchtree.o ./src/binarytree.d ./src/binarytree.o ./src/bitset.d ./src/bitset.o ./src/bloomfilter.d ./src/bloomfilter.o ./src/btree.d ./src/btree.o ./src/ccalg.d ./src/ccalg.o ./src/circdbllinkedlist.d ./src/circdbllinkedlist.o ./src/circlinkedlist.d ./src/circlinkedlist.o ./src/csrgraph.d ./src/csrgraph.o ./src/cuckoofilter.d ./src/cuckoofilter.o ./src/datastats.d ./src/datastats.o ./src/dbllinkedlist.d ./src/dbllinkedlist.o ./src/dbllinkedlistdeque.d ./src/dbllinkedlistdeque.o ./src/dfsalg.d ./src/dfsalg.o ./src/dijkstrasp.d ./src/dijkstrasp.o ./src/dijkstrasp_parallel.d ./src/dijkstrasp_parallel.o ./src/fibonacciheap.d ./src/fibonacciheap.o ./src/gaplist.d ./src/gaplist.o ./src/hashset.d ./src/hashset.o ./src/hashtable.d ./src/hashtable.o ./src/hashtable_concurrent.d ./src/hashtable_concurrent.o ./src/hashtable_lp.d ./src/hashtable_lp.o ./src/hashtable_simd.d ./src/hashtable_simd.o ./src/indminbinaryheap.d ./src/indminbinaryheap.o ./src/indmindaryheap.d ./src/indmindaryheap.o ./src/indmindblheap.d ./src/indmindblheap.o ./src/intrusive.d ./src/intrusive.o ./src/linkedlist.d ./src/linkedlist.o ./src/linkedlistqueue.d ./src/linkedlistqueue.o ./src/linkedliststack.d ./src/linkedliststack.o ./src/lrucache.d ./src/lrucache.o ./src/main.d ./src/main.o ./src/maxbinaryheap.d ./src/maxbinaryheap.o ./src/minbinaryheap.d ./src/minbinaryheap.o ./src/mstalg.d ./src/mstalg.o ./src/nodearena.d ./src/nodearena.o ./src/numanode.d ./src/numanode.o ./src/pairingheap.d ./src/pairingheap.o ./src/prbtree.d ./src/prbtree.o ./src/radixheap.d ./src/radixheap.o ./src/radixtrie.d ./src/radixtrie.o ./src/redblacktree.d ./src/redblacktree.o ./src/ringqueue.d ./src/ringqueue.o ./src/roaring.d ./src/roaring.o ./src/skiplist.d ./src/skiplist.o ./src/slidingwindow.d ./src/slidingwindow.o ./src/snapshot.d ./src/snapshot.o ./src/sortedarray.d ./src/sortedarray.o ./src/statictrie.d ./src/statictrie.o ./src/strintern.d ./src/strintern.o ./src/taskpool.d ./src/taskpool.o ./src/topk.d ./src/topk.o ./src/transclosure.d ./src/transclosure.o ./src/treeset.d ./src/treeset.o ./src/trie.d ./src/trie.o ./src/trieext.d ./src/trieext.o ./src/unionfind.d ./src/unionfind.o ./src/unrolledlist.d ./src/unrolledlist.o ./src/wsdeque.d ./src/wsdeque.o
 
 .PHONY: clean-src
 
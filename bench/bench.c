@@ -0,0 +1,344 @@
+/*
+ * bench.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Benchmark harness: warmup, repetitions, percentiles and CSV / JSON
+ * 				export of the results.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+
+volatile uint64_t bench_sink = 0;
+
+/*
+ * Prints the command line usage.
+ * Note: Private function.
+ * */
+void bench_usage(const char* program)
+{
+	printf( "Usage: %s [--reps N] [--warmup N] [--seed N] [--filter TEXT] [--quick]\n"
+			"          [--csv FILE] [--json FILE]\n", program );
+}
+
+/*
+ * Parses the command line options.
+ * Returns 1 if succeeded, 0 if an option is not valid (usage is printed).
+ * */
+int bench_parse_options(int argc, char** argv, struct bench_options* options)
+{
+	options->repetitions = BENCH_DEFAULT_REPS;
+	options->warmup = BENCH_DEFAULT_WARMUP;
+	options->seed = BENCH_DEFAULT_SEED;
+	options->filter = NULL;
+	options->divisor = 1;
+	options->csvpath = NULL;
+	options->jsonpath = NULL;
+
+	for (int i = 1; i < argc; i++) {
+		const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+		if (strcmp(argv[i], "--quick") == 0) {
+			options->divisor = 10;
+			continue;
+		}
+
+		if (value == NULL) {
+			bench_usage(argv[0]);
+			return 0;
+		}
+
+		if (strcmp(argv[i], "--reps") == 0)
+			options->repetitions = atoi(value);
+		else if (strcmp(argv[i], "--warmup") == 0)
+			options->warmup = atoi(value);
+		else if (strcmp(argv[i], "--seed") == 0)
+			options->seed = strtoull(value, NULL, 10);
+		else if (strcmp(argv[i], "--filter") == 0)
+			options->filter = value;
+		else if (strcmp(argv[i], "--csv") == 0)
+			options->csvpath = value;
+		else if (strcmp(argv[i], "--json") == 0)
+			options->jsonpath = value;
+		else {
+			bench_usage(argv[0]);
+			return 0;
+		}
+
+		i++;
+	}
+
+	if ((options->repetitions < 1) || (options->warmup < 0) || (options->seed == 0)) {
+		bench_usage(argv[0]);
+		return 0;
+	}
+
+	return 1;
+}
+
+/*
+ * Creates an empty suite with the given options.
+ * Returns the new suite if succeeded, NULL otherwise.
+ * */
+struct bench_suite* bench_create(const struct bench_options* options)
+{
+	struct bench_suite* suite = (struct bench_suite*)malloc(sizeof(struct bench_suite));
+	if (suite == NULL) {
+		printf("Memory error: failed to allocate memory for benchmark suite!\n");
+		return NULL;
+	}
+
+	suite->options = *options;
+	suite->results = NULL;
+	suite->count = 0;
+	suite->capacity = 0;
+
+	printf( "%-10s %-40s %9s %6s %9s %9s %9s %9s %9s\n", "group", "case", "size", "param",
+			"ns/op min", "p50", "p90", "p99", "mean" );
+	return suite;
+}
+
+/*
+ * Scales a size of a case by the options of the suite (--quick).
+ * */
+size_t bench_size(const struct bench_suite* suite, size_t size)
+{
+	size /= suite->options.divisor;
+	return (size > 0) ? size : 1;
+}
+
+/*
+ * Checks if a case is selected by the filter of the suite.
+ * */
+int bench_selected(const struct bench_suite* suite, const char* group, const char* name)
+{
+	if (suite->options.filter == NULL)
+		return 1;
+
+	char full[128];
+	snprintf(full, sizeof(full), "%s/%s", group, name);
+	return strstr(full, suite->options.filter) != NULL;
+}
+
+/*
+ * Compares two doubles (qsort).
+ * Note: Private function.
+ * */
+int bench_compare_double(const void* a, const void* b)
+{
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+/*
+ * Gets the nearest rank percentile 'q' (0 < q <= 1) of 'n' sorted samples.
+ * Note: Private function.
+ * */
+double bench_percentile(const double* sorted, int n, double q)
+{
+	int rank = (int)(q * n + 0.999999);		// ceil(q * n)
+	if (rank < 1)
+		rank = 1;
+
+	return sorted[((rank <= n) ? rank : n) - 1];
+}
+
+/*
+ * Square root by Newton iterations (the library does not link libm).
+ * Note: Private function.
+ * */
+double bench_sqrt(double x)
+{
+	if (x <= 0)
+		return 0;
+
+	double r = (x > 1) ? x : 1;
+	for (int i = 0; i < 64; i++)
+		r = 0.5 * (r + x / r);
+
+	return r;
+}
+
+/*
+ * Runs and records a benchmark case (see notes above).
+ * Returns the result, NULL if the case is filtered out.
+ * */
+const struct bench_result* bench_run( struct bench_suite* suite, const char* group,
+									  const char* name, size_t size, double param,
+									  bench_setup setup, bench_body body,
+									  bench_teardown teardown, void* arg )
+{
+	if (!bench_selected(suite, group, name))
+		return NULL;
+
+	int reps = suite->options.repetitions;
+	double* samples = (double*)malloc(reps * sizeof(double));
+	if (samples == NULL) {
+		printf("Memory error: failed to allocate memory for benchmark samples!\n");
+		return NULL;
+	}
+
+	size_t ops = 0;
+	for (int r = -suite->options.warmup; r < reps; r++) {
+		void* state = (setup != NULL) ? setup(arg, size) : arg;
+
+		struct timespec t0, t1;
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		ops = body(state);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+
+		if (teardown != NULL)
+			teardown(state);
+
+		if (r >= 0) {
+			double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+			samples[r] = ns / ((ops > 0) ? ops : 1);
+		}
+	}
+
+	if (suite->count == suite->capacity) {
+		size_t capacity = (suite->capacity > 0) ? 2 * suite->capacity : 64;
+		struct bench_result* results = (struct bench_result*)realloc( suite->results,
+																	  capacity * sizeof(struct bench_result) );
+		if (results == NULL) {
+			printf("Memory error: failed to allocate memory for benchmark results!\n");
+			free(samples);
+			return NULL;
+		}
+
+		suite->results = results;
+		suite->capacity = capacity;
+	}
+
+	struct bench_result* result = &(suite->results[suite->count++]);
+	snprintf(result->group, sizeof(result->group), "%s", group);
+	snprintf(result->name, sizeof(result->name), "%s", name);
+	result->size = size;
+	result->param = param;
+	result->ops = ops;
+	result->repetitions = reps;
+
+	double sum = 0, sumsq = 0;
+	for (int r = 0; r < reps; r++)
+		sum += samples[r];
+
+	result->mean = sum / reps;
+	for (int r = 0; r < reps; r++)
+		sumsq += (samples[r] - result->mean) * (samples[r] - result->mean);
+
+	result->stddev = bench_sqrt(sumsq / reps);
+
+	qsort(samples, reps, sizeof(double), bench_compare_double);
+	result->min = samples[0];
+	result->p50 = bench_percentile(samples, reps, 0.50);
+	result->p90 = bench_percentile(samples, reps, 0.90);
+	result->p99 = bench_percentile(samples, reps, 0.99);
+	free(samples);
+
+	printf( "%-10s %-40s %9zu %6.2f %9.1f %9.1f %9.1f %9.1f %9.1f\n", result->group,
+			result->name, result->size, result->param, result->min, result->p50,
+			result->p90, result->p99, result->mean );
+	fflush(stdout);
+	return result;
+}
+
+/*
+ * Writes the results as CSV (one header line, one line per result).
+ * Note: Private function.
+ * */
+int bench_write_csv(const struct bench_suite* suite, const char* path)
+{
+	FILE* f = fopen(path, "w");
+	if (f == NULL) {
+		printf("Error: can't write benchmark results to '%s'.\n", path);
+		return 0;
+	}
+
+	fprintf(f, "group,name,size,param,ops,repetitions,min_ns,p50_ns,p90_ns,p99_ns,mean_ns,stddev_ns\n");
+	for (size_t i = 0; i < suite->count; i++) {
+		const struct bench_result* r = &(suite->results[i]);
+		fprintf( f, "%s,%s,%zu,%g,%zu,%d,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n", r->group, r->name,
+				 r->size, r->param, r->ops, r->repetitions, r->min, r->p50, r->p90, r->p99,
+				 r->mean, r->stddev );
+	}
+
+	fclose(f);
+	return 1;
+}
+
+/*
+ * Writes the results as JSON (options of the run and an array of results).
+ * Note: Private function.
+ * */
+int bench_write_json(const struct bench_suite* suite, const char* path)
+{
+	FILE* f = fopen(path, "w");
+	if (f == NULL) {
+		printf("Error: can't write benchmark results to '%s'.\n", path);
+		return 0;
+	}
+
+	fprintf( f, "{\n  \"compiler\": \"%s\",\n  \"seed\": %llu,\n  \"repetitions\": %d,\n"
+			 "  \"warmup\": %d,\n  \"size_divisor\": %zu,\n  \"results\": [\n", __VERSION__,
+			 (unsigned long long)suite->options.seed, suite->options.repetitions,
+			 suite->options.warmup, suite->options.divisor );
+
+	for (size_t i = 0; i < suite->count; i++) {
+		const struct bench_result* r = &(suite->results[i]);
+		fprintf( f, "    { \"group\": \"%s\", \"name\": \"%s\", \"size\": %zu, \"param\": %g, "
+				 "\"ops\": %zu, \"min_ns\": %.2f, \"p50_ns\": %.2f, \"p90_ns\": %.2f, "
+				 "\"p99_ns\": %.2f, \"mean_ns\": %.2f, \"stddev_ns\": %.2f }%s\n", r->group,
+				 r->name, r->size, r->param, r->ops, r->min, r->p50, r->p90, r->p99, r->mean,
+				 r->stddev, (i + 1 < suite->count) ? "," : "" );
+	}
+
+	fprintf(f, "  ]\n}\n");
+	fclose(f);
+	return 1;
+}
+
+/*
+ * Writes the CSV / JSON files of the options.
+ * Returns 1 if succeeded, 0 if a file could not be written.
+ * */
+int bench_finish(struct bench_suite* suite)
+{
+	int result = 1;
+	if (suite->options.csvpath != NULL)
+		result &= bench_write_csv(suite, suite->options.csvpath);
+
+	if (suite->options.jsonpath != NULL)
+		result &= bench_write_json(suite, suite->options.jsonpath);
+
+	printf("\n%zu benchmark cases run.\n", suite->count);
+	return result;
+}
+
+/*
+ * Releases the suite from memory.
+ * */
+void bench_destroy(struct bench_suite* suite)
+{
+	free(suite->results);
+	free(suite);
+}
+
+/*
+ * Fills 'keys' with a random permutation of [0, n) (Fisher-Yates).
+ * */
+void bench_permutation(int* keys, size_t n, uint64_t seed)
+{
+	uint64_t state = (seed != 0) ? seed : BENCH_DEFAULT_SEED;
+	for (size_t i = 0; i < n; i++)
+		keys[i] = (int)i;
+
+	for (size_t i = n; i > 1; i--) {
+		size_t j = bench_random(&state) % i;
+		int tmp = keys[i - 1];
+		keys[i - 1] = keys[j];
+		keys[j] = tmp;
+	}
+}
@@ -0,0 +1,154 @@
+/*****************************************************************************
+ * bench.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for the benchmark harness of the library (the 'bench'
+ *  			 target, see makefile.targets).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A benchmark case is three functions: 'setup' builds the input of one repetition
+ *  (not timed), 'body' runs the measured operations and returns how many it ran,
+ *  'teardown' releases what setup built (not timed). bench_run calls them for
+ *  'warmup' repetitions (discarded) and then for 'repetitions' timed ones, and keeps
+ *  the nanoseconds per operation of each repetition:
+ *
+ *  	- min, median (p50), p90, p99 (nearest rank over the repetitions), mean and
+ *  	  standard deviation are reported;
+ *  	- every result is printed as a table row when measured and, on bench_finish,
+ *  	  written to the CSV and / or JSON files given in the options, so two releases
+ *  	  can be compared row by row (same group, name, size and parameter).
+ *
+ *  Inputs are generated from a fixed seed (bench_random), so two runs measure the
+ *  same keys, the same insertion orders and the same graphs.
+ *
+ *  Options (bench_parse_options):
+ *
+ *  	--reps N		timed repetitions (default 15)
+ *  	--warmup N		discarded repetitions (default 3)
+ *  	--seed N		seed of the generated inputs (default 42)
+ *  	--filter TEXT	runs only cases whose "group/name" contains TEXT
+ *  	--quick			sizes divided by 10 (smoke run)
+ *  	--csv FILE		writes results as CSV
+ *  	--json FILE		writes results as JSON
+ *
+ *******************************************************************************/
+
+#ifndef BENCH_H_
+	#define BENCH_H_
+
+	#include <stddef.h>
+	#include <stdint.h>
+
+	#define BENCH_DEFAULT_REPS 15
+	#define BENCH_DEFAULT_WARMUP 3
+	#define BENCH_DEFAULT_SEED 42
+
+	typedef void* (*bench_setup)(void* arg, size_t size);	// builds the input of a repetition
+	typedef size_t (*bench_body)(void* state);				// runs and counts the operations
+	typedef void (*bench_teardown)(void* state);			// releases the input
+
+	// options of a run
+	struct bench_options {
+		int repetitions;
+		int warmup;
+		uint64_t seed;
+		const char* filter;						// NULL runs every case
+		size_t divisor;							// sizes are divided by it (--quick)
+		const char* csvpath;					// NULL for no CSV output
+		const char* jsonpath;					// NULL for no JSON output
+	};
+
+	// result of a benchmark case, times in nanoseconds per operation
+	struct bench_result {
+		char group[32];
+		char name[64];
+		size_t size;							// number of elements / vertices
+		double param;							// case parameter (ex: load factor), 0 if none
+		size_t ops;								// operations per repetition
+		int repetitions;
+		double min, p50, p90, p99, mean, stddev;
+	};
+
+	// benchmark suite (options and results)
+	struct bench_suite {
+		struct bench_options options;
+		struct bench_result* results;
+		size_t count;
+		size_t capacity;
+	};
+
+	/*
+	 * Parses the command line options.
+	 * Returns 1 if succeeded, 0 if an option is not valid (usage is printed).
+	 * */
+	int bench_parse_options(int argc, char** argv, struct bench_options* options);
+
+	/*
+	 * Creates an empty suite with the given options.
+	 * Returns the new suite if succeeded, NULL otherwise.
+	 * */
+	struct bench_suite* bench_create(const struct bench_options* options);
+
+	/*
+	 * Scales a size of a case by the options of the suite (--quick).
+	 * */
+	size_t bench_size(const struct bench_suite* suite, size_t size);
+
+	/*
+	 * Checks if a case is selected by the filter of the suite.
+	 * */
+	int bench_selected(const struct bench_suite* suite, const char* group, const char* name);
+
+	/*
+	 * Runs and records a benchmark case (see notes above).
+	 * Returns the result, NULL if the case is filtered out.
+	 * */
+	const struct bench_result* bench_run( struct bench_suite* suite, const char* group,
+										  const char* name, size_t size, double param,
+										  bench_setup setup, bench_body body,
+										  bench_teardown teardown, void* arg );
+
+	/*
+	 * Writes the CSV / JSON files of the options.
+	 * Returns 1 if succeeded, 0 if a file could not be written.
+	 * */
+	int bench_finish(struct bench_suite* suite);
+
+	/*
+	 * Releases the suite from memory.
+	 * */
+	void bench_destroy(struct bench_suite* suite);
+
+	/*
+	 * Next value of a xorshift64* generator ('state' must not be 0).
+	 * */
+	static inline uint64_t bench_random(uint64_t* state) {
+		*state ^= *state >> 12;
+		*state ^= *state << 25;
+		*state ^= *state >> 27;
+		return *state * 0x2545F4914F6CDD1DULL;
+	}
+
+	/*
+	 * Fills 'keys' with a random permutation of [0, n) (Fisher-Yates).
+	 * */
+	void bench_permutation(int* keys, size_t n, uint64_t seed);
+
+	/*
+	 * Keeps the compiler from dropping a computed value.
+	 * */
+	extern volatile uint64_t bench_sink;
+
+	/*
+	 * Benchmarks of each area of the library.
+	 * */
+	void bench_hashtables(struct bench_suite* suite);
+	void bench_trees(struct bench_suite* suite);
+	void bench_heaps(struct bench_suite* suite);
+	void bench_graphs(struct bench_suite* suite);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,168 @@
+/*
+ * bench_graphs.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Benchmarks of the graph algorithms: BFS, DFS and Dijkstra over
+ * 				adjacency list and CSR graphs generated from a seed. Times are per
+ * 				visited vertex plus edge (n + m operations per search).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "adjlgraph.h"
+#include "csrgraph.h"
+#include "bfsalg.h"
+#include "dfsalg.h"
+#include "dijkstrasp.h"
+
+#define BENCH_GRAPH_DEGREE 8		// average out degree of generated graphs
+
+typedef enum {
+	BENCH_GRAPH_BFS_ADJL = 0,
+	BENCH_GRAPH_BFS_CSR = 1,
+	BENCH_GRAPH_DFS_ADJL = 2,
+	BENCH_GRAPH_DFS_CSR = 3,
+	BENCH_GRAPH_DIJKSTRA_ADJL = 4,
+	BENCH_GRAPH_DIJKSTRA_CSR_DARY = 5,
+	BENCH_GRAPH_DIJKSTRA_CSR_PAIRING = 6,
+	BENCH_GRAPH_DIJKSTRA_CSR_RADIX = 7
+} bench_graphalg;
+
+// generated graph shared by the cases of a size
+struct bench_graph {
+	int n;
+	size_t m;
+	struct adjlgraph* g;
+	struct csrgraph* cg;
+	struct bfsalg_workspace* bfs;
+	struct dijkstrasp_context* dijkstra[3];		// one per queue type
+};
+
+// a graph case
+struct bench_graphcase {
+	struct bench_graph* graph;
+	bench_graphalg alg;
+};
+
+/*
+ * Generates a directed graph with 'n' vertices and BENCH_GRAPH_DEGREE * n random edges
+ * (integer weights 1 to 100). Vertex n - 1 has no edges, so searches from vertex 0
+ * towards it visit everything reachable.
+ * Note: Private function.
+ * */
+struct bench_graph* bench_graph_create(int n, uint64_t seed)
+{
+	struct bench_graph* graph = (struct bench_graph*)malloc(sizeof(struct bench_graph));
+	graph->n = n;
+	graph->m = (size_t)n * BENCH_GRAPH_DEGREE;
+
+	struct adjlgraph_edgeitem* edges = (struct adjlgraph_edgeitem*)malloc(graph->m * sizeof(*edges));
+	uint64_t state = seed;
+	for (size_t e = 0; e < graph->m; e++) {
+		edges[e].from = (int)(bench_random(&state) % (n - 1));
+		edges[e].to = (int)(bench_random(&state) % (n - 1));
+		edges[e].weight = (double)(1 + bench_random(&state) % 100);
+	}
+
+	graph->g = adjlgraph_creategraph(n, DIRECTED_AGRAPH, NULL, NULL, NULL, NULL);
+	for (int v = 0; v < n; v++)
+		adjlgraph_addvertex(graph->g, v, NULL);
+
+	adjlgraph_addedges(graph->g, edges, graph->m, 1);
+	graph->cg = csrgraph_create_from_edges(n, DIRECTED_AGRAPH, edges, graph->m, 1);
+	free(edges);
+
+	graph->bfs = bfsalg_workspace_create(n);
+	for (int q = DIJKSTRASP_QUEUE_DARY; q <= DIJKSTRASP_QUEUE_RADIX; q++)
+		graph->dijkstra[q] = dijkstrasp_context_create_queue(n, q);
+
+	return graph;
+}
+
+/*
+ * Releases a generated graph.
+ * Note: Private function.
+ * */
+void bench_graph_destroy(struct bench_graph* graph)
+{
+	for (int q = DIJKSTRASP_QUEUE_DARY; q <= DIJKSTRASP_QUEUE_RADIX; q++)
+		dijkstrasp_context_destroy(graph->dijkstra[q]);
+
+	bfsalg_workspace_destroy(graph->bfs);
+	csrgraph_destroy(graph->cg);
+	adjlgraph_destroy(graph->g);
+	free(graph);
+}
+
+/*
+ * Runs one search from vertex 0.
+ * Note: Private function.
+ * */
+size_t bench_graph_body(void* state)
+{
+	struct bench_graphcase* c = (struct bench_graphcase*)state;
+	struct bench_graph* graph = c->graph;
+	int end = graph->n - 1, size = 0;
+	ulong count = 0;
+	int* path = NULL;
+
+	switch (c->alg) {
+		case BENCH_GRAPH_BFS_ADJL:
+			path = bfsalg_workspace_shortest_path(graph->bfs, graph->g, 0, end, &size);
+			break;
+		case BENCH_GRAPH_BFS_CSR:
+			path = bfsalg_workspace_csr_shortest_path(graph->bfs, graph->cg, 0, end, &size);
+			break;
+		case BENCH_GRAPH_DFS_ADJL:
+			dfsalg_countvertices_iteractive(graph->g, 0, &count);
+			break;
+		case BENCH_GRAPH_DFS_CSR:
+			dfsalg_csr_countvertices(graph->cg, 0, &count);
+			break;
+		case BENCH_GRAPH_DIJKSTRA_ADJL:
+			path = dijkstrasp_context_adjlist_shortest_path( graph->dijkstra[DIJKSTRASP_QUEUE_DARY],
+															 graph->g, 0, end, &size );
+			break;
+		default:
+			path = dijkstrasp_context_csr_shortest_path( graph->dijkstra[c->alg - BENCH_GRAPH_DIJKSTRA_CSR_DARY],
+														 graph->cg, 0, end, &size );
+			break;
+	}
+
+	free(path);
+	bench_sink += count + size;
+	return (size_t)graph->n + graph->m;
+}
+
+/*
+ * Benchmarks of the graph algorithms.
+ * */
+void bench_graphs(struct bench_suite* suite)
+{
+	const char* names[] = { "bfs/adjlgraph", "bfs/csr", "dfs/adjlgraph", "dfs/csr",
+							"dijkstra/adjlgraph_dary", "dijkstra/csr_dary",
+							"dijkstra/csr_pairing", "dijkstra/csr_radix" };
+	const size_t sizes[] = { 10000, 100000 };
+
+	for (int si = 0; si < 2; si++) {
+		int n = (int)bench_size(suite, sizes[si]);
+		struct bench_graph* graph = NULL;
+
+		for (int alg = BENCH_GRAPH_BFS_ADJL; alg <= BENCH_GRAPH_DIJKSTRA_CSR_RADIX; alg++) {
+			if (!bench_selected(suite, "graph", names[alg]))
+				continue;
+
+			if (graph == NULL)
+				graph = bench_graph_create(n, suite->options.seed);
+
+			struct bench_graphcase c = { graph, alg };
+			bench_run( suite, "graph", names[alg], n, BENCH_GRAPH_DEGREE, NULL, bench_graph_body,
+					   NULL, &c );
+		}
+
+		if (graph != NULL)
+			bench_graph_destroy(graph);
+	}
+}
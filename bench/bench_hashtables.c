@@ -0,0 +1,175 @@
+/*
+ * bench_hashtables.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Benchmarks of the hash tables: put, get (hit and miss) and remove at
+ * 				several sizes and load factors for hashtable (chaining), hashtable_lp
+ * 				(linear probing) and hashtable_lp with inline and robin hood storage.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "hashtable.h"
+#include "hashtable_lp.h"
+
+typedef enum { BENCH_HT_CHAINED = 0, BENCH_HT_LP = 1, BENCH_HT_LP_INLINE = 2,
+			   BENCH_HT_LP_ROBINHOOD = 3 } bench_htkind;
+typedef enum { BENCH_HT_PUT = 0, BENCH_HT_GET = 1, BENCH_HT_MISS = 2, BENCH_HT_REMOVE = 3 } bench_htop;
+
+// a hash table case
+struct bench_htcase {
+	bench_htkind kind;
+	bench_htop op;
+	float loadfactor;
+	uint64_t seed;
+};
+
+// input of a repetition
+struct bench_htstate {
+	const struct bench_htcase* c;
+	size_t n;
+	int* keys;			// 2n keys: [0, n) are put, [n, 2n) are never put
+	int* order;			// order of the measured operations
+	void* table;
+};
+
+/*
+ * Hash and equality of int keys.
+ * Note: Private functions.
+ * */
+int bench_ht_hash(const void* key)
+{
+	return (int)((uint32_t)*(const int*)key * 0x9E3779B1u);
+}
+
+int bench_ht_isequal(const void* key1, const void* key2)
+{
+	return *(const int*)key1 == *(const int*)key2;
+}
+
+/*
+ * Builds the keys and the table of a repetition (filled unless the case is 'put').
+ * Note: Private function.
+ * */
+void* bench_ht_setup(void* arg, size_t n)
+{
+	const struct bench_htcase* c = (const struct bench_htcase*)arg;
+	struct bench_htstate* s = (struct bench_htstate*)malloc(sizeof(struct bench_htstate));
+	s->c = c;
+	s->n = n;
+	s->keys = (int*)malloc(2 * n * sizeof(int));
+	s->order = (int*)malloc(n * sizeof(int));
+	bench_permutation(s->keys, 2 * n, c->seed);
+	bench_permutation(s->order, n, c->seed + 1);
+
+	if (c->kind == BENCH_HT_CHAINED)
+		s->table = hashtable_create( HASHTABLE_MIN_SIZE + 1, c->loadfactor, HASHTABLE_RESIZE_FACTOR,
+									 bench_ht_hash, bench_ht_isequal, NULL, NULL );
+	else if (c->kind == BENCH_HT_LP)
+		s->table = hashtable_lp_create( HASHTABLE_LP_MIN_SIZE + 1, c->loadfactor,
+										HASHTABLE_LP_RESIZE_FACTOR, bench_ht_hash, bench_ht_isequal,
+										NULL, NULL );
+	else if (c->kind == BENCH_HT_LP_INLINE)
+		s->table = hashtable_lp_create_inline( HASHTABLE_LP_MIN_SIZE + 1, c->loadfactor,
+											   HASHTABLE_LP_RESIZE_FACTOR, bench_ht_hash,
+											   bench_ht_isequal, NULL, NULL );
+	else
+		s->table = hashtable_lp_create_robinhood( HASHTABLE_LP_MIN_SIZE + 1, c->loadfactor,
+												  HASHTABLE_LP_RESIZE_FACTOR, bench_ht_hash,
+												  bench_ht_isequal, NULL, NULL );
+
+	if (c->op != BENCH_HT_PUT)
+		for (size_t i = 0; i < n; i++) {
+			if (c->kind == BENCH_HT_CHAINED)
+				hashtable_put((struct hashtable*)s->table, &s->keys[i], &s->keys[i]);
+			else
+				hashtable_lp_put((struct hashtable_lp*)s->table, &s->keys[i], &s->keys[i]);
+		}
+
+	return s;
+}
+
+/*
+ * Runs the measured operations of a repetition.
+ * Note: Private function.
+ * */
+size_t bench_ht_body(void* state)
+{
+	struct bench_htstate* s = (struct bench_htstate*)state;
+	uint64_t found = 0;
+
+	for (size_t i = 0; i < s->n; i++) {
+		int* key = &s->keys[s->order[i] + ((s->c->op == BENCH_HT_MISS) ? s->n : 0)];
+		if (s->c->kind == BENCH_HT_CHAINED) {
+			struct hashtable* table = (struct hashtable*)s->table;
+			switch (s->c->op) {
+				case BENCH_HT_PUT: found += hashtable_put(table, key, key); break;
+				case BENCH_HT_REMOVE: {
+					void* kvp = hashtable_remove(table, key);
+					found += (kvp != NULL);
+					free(kvp);
+					break;
+				}
+				default: found += (hashtable_get(table, key) != NULL); break;
+			}
+		}
+		else {
+			struct hashtable_lp* table = (struct hashtable_lp*)s->table;
+			switch (s->c->op) {
+				case BENCH_HT_PUT: found += hashtable_lp_put(table, key, key); break;
+				case BENCH_HT_REMOVE: {
+					void* kvp = hashtable_lp_remove(table, key);
+					found += (kvp != NULL);
+					free(kvp);
+					break;
+				}
+				default: found += (hashtable_lp_get(table, key) != NULL); break;
+			}
+		}
+	}
+
+	bench_sink += found;
+	return s->n;
+}
+
+/*
+ * Releases the input of a repetition.
+ * Note: Private function.
+ * */
+void bench_ht_teardown(void* state)
+{
+	struct bench_htstate* s = (struct bench_htstate*)state;
+	if (s->c->kind == BENCH_HT_CHAINED)
+		hashtable_destroy((struct hashtable*)s->table);
+	else
+		hashtable_lp_destroy((struct hashtable_lp*)s->table);
+
+	free(s->keys);
+	free(s->order);
+	free(s);
+}
+
+/*
+ * Benchmarks of the hash tables.
+ * */
+void bench_hashtables(struct bench_suite* suite)
+{
+	const char* kinds[] = { "hashtable", "hashtable_lp", "hashtable_lp_inline", "hashtable_lp_robinhood" };
+	const char* ops[] = { "put", "get", "get_miss", "remove" };
+	const size_t sizes[] = { 1000, 10000, 100000 };
+	const float loadfactors[] = { 0.5f, 0.75f, 0.9f };
+
+	for (int si = 0; si < 3; si++)
+		for (int li = 0; li < 3; li++)
+			for (int kind = BENCH_HT_CHAINED; kind <= BENCH_HT_LP_ROBINHOOD; kind++)
+				for (int op = BENCH_HT_PUT; op <= BENCH_HT_REMOVE; op++) {
+					struct bench_htcase c = { kind, op, loadfactors[li], suite->options.seed };
+					char name[64];
+					snprintf(name, sizeof(name), "%s/%s", kinds[kind], ops[op]);
+					bench_run( suite, "hashtable", name, bench_size(suite, sizes[si]),
+							   loadfactors[li], bench_ht_setup, bench_ht_body,
+							   bench_ht_teardown, &c );
+				}
+}
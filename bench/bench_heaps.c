@@ -0,0 +1,210 @@
+/*
+ * bench_heaps.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Benchmarks of the priority queues: 'n' inserts of random priorities
+ * 				followed by 'n' extract min (max for the max heap) for every heap
+ * 				variant of the library.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "bench.h"
+#include "minbinaryheap.h"
+#include "maxbinaryheap.h"
+#include "pairingheap.h"
+#include "fibonacciheap.h"
+#include "indminbinaryheap.h"
+#include "indmindaryheap.h"
+#include "indmindblheap.h"
+#include "radixheap.h"
+
+typedef enum {
+	BENCH_HEAP_MINBINARY = 0,
+	BENCH_HEAP_MAXBINARY = 1,
+	BENCH_HEAP_PAIRING = 2,
+	BENCH_HEAP_FIBONACCI = 3,
+	BENCH_HEAP_INDMINBINARY = 4,
+	BENCH_HEAP_INDMINDARY = 5,
+	BENCH_HEAP_INDMINDBL = 6,
+	BENCH_HEAP_RADIX = 7
+} bench_heapkind;
+
+// input of a repetition
+struct bench_heapstate {
+	bench_heapkind kind;
+	size_t n;
+	int* priorities;	// indexed heaps: priority of key index i
+};
+
+// a heap case
+struct bench_heapcase {
+	bench_heapkind kind;
+	uint64_t seed;
+};
+
+/*
+ * Compares two int priorities.
+ * Note: Private function.
+ * */
+int bench_heap_compare(const void* data1, const void* data2)
+{
+	int a = *(const int*)data1, b = *(const int*)data2;
+	return (a > b) - (a < b);
+}
+
+/*
+ * Builds the random priorities of a repetition.
+ * Note: Private function.
+ * */
+void* bench_heap_setup(void* arg, size_t n)
+{
+	const struct bench_heapcase* c = (const struct bench_heapcase*)arg;
+	struct bench_heapstate* s = (struct bench_heapstate*)malloc(sizeof(struct bench_heapstate));
+	s->kind = c->kind;
+	s->n = n;
+	s->priorities = (int*)malloc(n * sizeof(int));
+
+	uint64_t state = c->seed;
+	for (size_t i = 0; i < n; i++)
+		s->priorities[i] = (int)(bench_random(&state) % (4 * n));
+
+	return s;
+}
+
+/*
+ * Inserts all priorities, then extracts them all.
+ * Note: Private function.
+ * */
+size_t bench_heap_body(void* state)
+{
+	struct bench_heapstate* s = (struct bench_heapstate*)state;
+	int n = (int)s->n;
+	int minlimit = INT_MIN, maxlimit = INT_MAX;
+	uint64_t checksum = 0;
+
+	switch (s->kind) {
+		case BENCH_HEAP_MINBINARY:
+		case BENCH_HEAP_MAXBINARY: {
+			int ismin = (s->kind == BENCH_HEAP_MINBINARY);
+			struct heap* h = ismin
+				? minbinaryheap_createHeap(16, NULL, 0, &minlimit, &maxlimit, bench_heap_compare, NULL, NULL)
+				: maxbinaryheap_createHeap(16, NULL, 0, &minlimit, &maxlimit, bench_heap_compare, NULL, NULL);
+			for (int i = 0; i < n; i++) {
+				if (ismin) minbinaryheap_insert(h, &s->priorities[i]);
+				else maxbinaryheap_insert(h, &s->priorities[i]);
+			}
+
+			for (int i = 0; i < n; i++)
+				checksum += *(int*)(ismin ? minbinaryheap_extract(h) : maxbinaryheap_extract(h));
+
+			if (ismin) minbinaryheap_destroy(h);
+			else maxbinaryheap_destroy(h);
+			break;
+		}
+		case BENCH_HEAP_PAIRING: {
+			struct pairheap* ph = pairheap_create(bench_heap_compare, NULL, NULL);
+			for (int i = 0; i < n; i++)
+				pairheap_insert(ph, &s->priorities[i]);
+
+			for (int i = 0; i < n; i++)
+				checksum += *(int*)pairheap_extract_min(ph);
+
+			pairheap_destroy(ph);
+			break;
+		}
+		case BENCH_HEAP_FIBONACCI: {
+			struct fibheap* fh = fibheap_create(&minlimit, bench_heap_compare, NULL, NULL);
+			for (int i = 0; i < n; i++)
+				fibheap_insert(fh, &s->priorities[i]);
+
+			for (int i = 0; i < n; i++) {
+				struct fibheapnode* node = fibheap_extract_min(fh);
+				checksum += *(int*)node->key;
+				fibheap_destroynode(fh, node);
+			}
+
+			fibheap_destroy(fh);
+			break;
+		}
+		case BENCH_HEAP_INDMINBINARY: {
+			struct iminbinarypq* pq = iminbinpq_create(n, bench_heap_compare, NULL, NULL);
+			for (int i = 0; i < n; i++)
+				iminbinpq_insert(pq, i, &s->priorities[i]);
+
+			for (int i = 0; i < n; i++)
+				checksum += s->priorities[iminbinpq_extractkeyindex(pq)];
+
+			iminbinpq_destroy(pq);
+			break;
+		}
+		case BENCH_HEAP_INDMINDARY: {
+			struct idarypq* pq = imindarypq_create(4, n, bench_heap_compare, NULL, NULL);
+			for (int i = 0; i < n; i++)
+				imindarypq_insert(pq, i, &s->priorities[i]);
+
+			for (int i = 0; i < n; i++)
+				checksum += s->priorities[imindarypq_extractkeyindex(pq)];
+
+			imindarypq_destroy(pq);
+			break;
+		}
+		case BENCH_HEAP_INDMINDBL: {
+			struct imindblpq* pq = imindblpq_create(n);
+			for (int i = 0; i < n; i++)
+				imindblpq_insert(pq, i, (double)s->priorities[i]);
+
+			for (int i = 0; i < n; i++)
+				checksum += s->priorities[imindblpq_extractkeyindex(pq)];
+
+			imindblpq_destroy(pq);
+			break;
+		}
+		default: {
+			struct radixheap* rh = radixheap_create(n);
+			for (int i = 0; i < n; i++)
+				radixheap_insert(rh, i, (uint64_t)s->priorities[i]);
+
+			for (int i = 0; i < n; i++)
+				checksum += s->priorities[radixheap_extractkeyindex(rh)];
+
+			radixheap_destroy(rh);
+			break;
+		}
+	}
+
+	bench_sink += checksum;
+	return 2 * s->n;
+}
+
+/*
+ * Releases the input of a repetition.
+ * Note: Private function.
+ * */
+void bench_heap_teardown(void* state)
+{
+	struct bench_heapstate* s = (struct bench_heapstate*)state;
+	free(s->priorities);
+	free(s);
+}
+
+/*
+ * Benchmarks of the priority queues.
+ * */
+void bench_heaps(struct bench_suite* suite)
+{
+	const char* kinds[] = { "minbinaryheap", "maxbinaryheap", "pairingheap", "fibonacciheap",
+							"indminbinaryheap", "indmindaryheap_d4", "indmindblheap", "radixheap" };
+	const size_t sizes[] = { 1000, 10000, 100000 };
+
+	for (int si = 0; si < 3; si++)
+		for (int kind = BENCH_HEAP_MINBINARY; kind <= BENCH_HEAP_RADIX; kind++) {
+			struct bench_heapcase c = { kind, suite->options.seed };
+			char name[64];
+			snprintf(name, sizeof(name), "%s/insert_extract", kinds[kind]);
+			bench_run( suite, "heap", name, bench_size(suite, sizes[si]), 0, bench_heap_setup,
+					   bench_heap_body, bench_heap_teardown, &c );
+		}
+}
@@ -0,0 +1,32 @@
+/*
+ * bench_main.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Entry point of the benchmark suite (make bench, then ./bench --help
+ * 				for the options).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+
+int main(int argc, char** argv)
+{
+	struct bench_options options;
+	if (!bench_parse_options(argc, argv, &options))
+		return EXIT_FAILURE;
+
+	struct bench_suite* suite = bench_create(&options);
+	if (suite == NULL)
+		return EXIT_FAILURE;
+
+	bench_hashtables(suite);
+	bench_trees(suite);
+	bench_heaps(suite);
+	bench_graphs(suite);
+
+	int result = bench_finish(suite);
+	bench_destroy(suite);
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,219 @@
+/*
+ * bench_trees.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Benchmarks of the ordered containers: insert, find and remove of
+ * 				random keys for red-black tree (malloc and arena nodes), AVL tree and
+ * 				treeset (red-black tree and B+ tree backends).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "redblacktree.h"
+#include "avltree.h"
+#include "treeset.h"
+#include "nodearena.h"
+
+typedef enum {
+	BENCH_TREE_RBTREE = 0,
+	BENCH_TREE_RBTREE_ARENA = 1,
+	BENCH_TREE_AVLTREE = 2,
+	BENCH_TREE_TREESET_RB = 3,
+	BENCH_TREE_TREESET_BTREE = 4
+} bench_treekind;
+
+typedef enum { BENCH_TREE_INSERT = 0, BENCH_TREE_FIND = 1, BENCH_TREE_REMOVE = 2 } bench_treeop;
+
+// a tree case
+struct bench_treecase {
+	bench_treekind kind;
+	bench_treeop op;
+	uint64_t seed;
+};
+
+// input of a repetition
+struct bench_treestate {
+	const struct bench_treecase* c;
+	size_t n;
+	int* keys;			// insertion order
+	int* order;			// order of the measured operations
+	int rootkey;		// AVL tree: element added on create (never removed)
+	struct rbtree* rbtree;
+	struct avltree* avltree;
+	struct treeset* treeset;
+};
+
+/*
+ * Compares two int elements (the AVL tree takes a non const element).
+ * Note: Private functions.
+ * */
+int bench_tree_compare(const void* data1, const void* data2)
+{
+	int a = *(const int*)data1, b = *(const int*)data2;
+	return (a > b) - (a < b);
+}
+
+int bench_avltree_compare(void* data, const void* key)
+{
+	return bench_tree_compare(data, key);
+}
+
+/*
+ * Size and copy of an int element (trees copy elements when removing inner nodes).
+ * Note: Private functions.
+ * */
+size_t bench_tree_datasize(const void* data)
+{
+	return sizeof(int);
+}
+
+void bench_tree_copydata(void* dest, const void* from)
+{
+	*(int*)dest = *(const int*)from;
+}
+
+/*
+ * Inserts an element in the tree of a case.
+ * Note: Private function.
+ * */
+void bench_tree_insert(struct bench_treestate* s, int* key)
+{
+	if (s->rbtree != NULL)
+		rbtree_insert(s->rbtree, key);
+	else if (s->avltree != NULL)
+		s->avltree->root = avltree_insert(s->avltree, s->avltree->root, key);
+	else
+		treeset_add(s->treeset, key);
+}
+
+/*
+ * Builds the keys and the tree of a repetition (filled unless the case is 'insert').
+ * The AVL tree is created with its root element, so it always holds 'rootkey'.
+ * Note: Private function.
+ * */
+void* bench_tree_setup(void* arg, size_t n)
+{
+	const struct bench_treecase* c = (const struct bench_treecase*)arg;
+	struct bench_treestate* s = (struct bench_treestate*)calloc(1, sizeof(struct bench_treestate));
+	s->c = c;
+	s->n = n;
+	s->keys = (int*)malloc(n * sizeof(int));
+	s->order = (int*)malloc(n * sizeof(int));
+	bench_permutation(s->keys, n, c->seed);
+	bench_permutation(s->order, n, c->seed + 1);
+	s->rootkey = s->keys[0];
+
+	switch (c->kind) {
+		case BENCH_TREE_RBTREE:
+			s->rbtree = rbtree_create( NULL, bench_tree_datasize, bench_tree_compare, NULL, NULL,
+									   bench_tree_copydata, NULL );
+			break;
+		case BENCH_TREE_RBTREE_ARENA:
+			s->rbtree = rbtree_create( NULL, bench_tree_datasize, bench_tree_compare, NULL, NULL,
+									   bench_tree_copydata,
+									   nodearena_create(sizeof(struct rbtreenode), 0) );
+			break;
+		case BENCH_TREE_AVLTREE:
+			s->avltree = avltree_create( &s->keys[0], bench_avltree_compare, NULL, NULL,
+										bench_tree_copydata, NULL );
+			break;
+		case BENCH_TREE_TREESET_RB:
+			s->treeset = treeset_create( bench_tree_datasize, bench_tree_copydata,
+										 bench_tree_compare, NULL, NULL, TREESET_RBTREE, NULL );
+			break;
+		default:
+			s->treeset = treeset_create( bench_tree_datasize, bench_tree_copydata,
+										 bench_tree_compare, NULL, NULL, TREESET_BTREE, NULL );
+			break;
+	}
+
+	if (c->op != BENCH_TREE_INSERT)
+		for (size_t i = (s->avltree != NULL) ? 1 : 0; i < n; i++)
+			bench_tree_insert(s, &s->keys[i]);
+
+	return s;
+}
+
+/*
+ * Runs the measured operations of a repetition.
+ * Note: Private function.
+ * */
+size_t bench_tree_body(void* state)
+{
+	struct bench_treestate* s = (struct bench_treestate*)state;
+	uint64_t found = 0;
+	size_t ops = 0;
+
+	for (size_t i = 0; i < s->n; i++) {
+		int* key = (s->c->op == BENCH_TREE_INSERT) ? &s->keys[i] : &s->order[i];
+		if ((s->avltree != NULL) && (*key == s->rootkey))
+			continue;			// added by setup (removes copy elements, so compare values)
+
+		ops++;
+		switch (s->c->op) {
+			case BENCH_TREE_INSERT:
+				bench_tree_insert(s, key);
+				break;
+			case BENCH_TREE_FIND:
+				if (s->rbtree != NULL)
+					found += (rbtree_search(s->rbtree, s->rbtree->root, key) != NULL);
+				else if (s->avltree != NULL)
+					found += (avltree_search(s->avltree, s->avltree->root, key) != NULL);
+				else
+					found += treeset_contains(s->treeset, key);
+				break;
+			default:
+				if (s->rbtree != NULL)
+					found += (rbtree_delete(s->rbtree, key) != NULL);
+				else if (s->avltree != NULL)
+					s->avltree->root = avltree_delete(s->avltree, s->avltree->root, key);
+				else
+					found += (treeset_remove(s->treeset, key) != NULL);
+				break;
+		}
+	}
+
+	bench_sink += found;
+	return ops;
+}
+
+/*
+ * Releases the input of a repetition.
+ * Note: Private function.
+ * */
+void bench_tree_teardown(void* state)
+{
+	struct bench_treestate* s = (struct bench_treestate*)state;
+	if (s->rbtree != NULL)
+		rbtree_destroy(s->rbtree);
+	else if (s->avltree != NULL)
+		avltree_destroy(s->avltree);
+	else
+		treeset_destroy(s->treeset);
+
+	free(s->keys);
+	free(s->order);
+	free(s);
+}
+
+/*
+ * Benchmarks of the ordered containers.
+ * */
+void bench_trees(struct bench_suite* suite)
+{
+	const char* kinds[] = { "rbtree", "rbtree_arena", "avltree", "treeset_rbtree", "treeset_btree" };
+	const char* ops[] = { "insert", "find", "remove" };
+	const size_t sizes[] = { 1000, 10000, 100000 };
+
+	for (int si = 0; si < 3; si++)
+		for (int kind = BENCH_TREE_RBTREE; kind <= BENCH_TREE_TREESET_BTREE; kind++)
+			for (int op = BENCH_TREE_INSERT; op <= BENCH_TREE_REMOVE; op++) {
+				struct bench_treecase c = { kind, op, suite->options.seed };
+				char name[64];
+				snprintf(name, sizeof(name), "%s/%s", kinds[kind], ops[op]);
+				bench_run( suite, "tree", name, bench_size(suite, sizes[si]), 0,
+						   bench_tree_setup, bench_tree_body, bench_tree_teardown, &c );
+			}
+}
@@ -10,10 +10,12 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include "adjlgraph.h"
+#include "csrgraph.h"
 
 
 /*
- * Create a new graph vertex.
+ * Create a new graph vertex (allocated with malloc, graphs allocate theirs from the
+ * graph allocator).
  */
 struct adjlgvertex* adjlgraph_createvertex(void* vertexdata)
 {
@@ -31,7 +33,8 @@ struct adjlgvertex* adjlgraph_createvertex(void* vertexdata)
 }
 
 /*
- * Create a new graph edge node.
+ * Create a new graph edge node (allocated with malloc, graphs allocate theirs from
+ * the graph allocator).
  */
 struct adjlgedge* adjlgraph_createedge( int vindex, void* edgedata, double weight )
 {
@@ -50,6 +53,38 @@ struct adjlgedge* adjlgraph_createedge( int vindex, void* edgedata, double weigh
 	return result;
 }
 
+/*
+ * Creates a vertex and an edge node of a graph (from the graph allocator).
+ * Note: Private functions.
+ */
+struct adjlgvertex* adjlgraph_allocvertex(struct adjlgraph* graph, void* vertexdata)
+{
+	struct adjlgvertex* result = (struct adjlgvertex*)allocator_alloc(graph->allocator, sizeof(*result));
+	if (!result) {
+		printf("Memory error when allocating graph vertex!");
+		abort();
+	}
+
+	result->vertexdata = vertexdata;
+	result->edgeslist = NULL;
+	return result;
+}
+
+struct adjlgedge* adjlgraph_allocedge( struct adjlgraph* graph, int vindex, void* edgedata, double weight )
+{
+	struct adjlgedge* result = (struct adjlgedge*)allocator_alloc(graph->allocator, sizeof(*result));
+	if (!result) {
+		printf("Memory error when allocating graph edge node!");
+		abort();
+	}
+
+	result->next = NULL;
+	result->vertexindex = vindex;
+	result->edgedata = edgedata;
+	result->weight = weight;
+	return result;
+}
+
 /*
  * Create a new graph.
  */
@@ -59,7 +94,22 @@ struct adjlgraph* adjlgraph_creategraph(int numvertices, adjlgraph_edgetype etyp
 		adjlgraph_printdata printvertexfunc,
 		adjlgraph_printdata printedgefunc)
 {
-	struct adjlgraph* result = (struct adjlgraph*)malloc(sizeof(struct adjlgraph));
+	return adjlgraph_creategraph_allocator( numvertices, etype, freevertexdatafunc, freeedgedatafunc,
+											printvertexfunc, printedgefunc, NULL );
+}
+
+/*
+ * Create a new graph whose structure, vertex array, vertices and edges are allocated
+ * by 'allocator' (see allocator.h, NULL: C library).
+ */
+struct adjlgraph* adjlgraph_creategraph_allocator(int numvertices, adjlgraph_edgetype etype,
+		adjlgraph_freedata freevertexdatafunc,
+		adjlgraph_freedata freeedgedatafunc,
+		adjlgraph_printdata printvertexfunc,
+		adjlgraph_printdata printedgefunc,
+		const struct allocator* allocator)
+{
+	struct adjlgraph* result = (struct adjlgraph*)allocator_alloc(allocator, sizeof(struct adjlgraph));
 
 	if (result == NULL) {
 		printf("Memory error when allocating graph struct!");
@@ -67,11 +117,11 @@ struct adjlgraph* adjlgraph_creategraph(int numvertices, adjlgraph_edgetype etyp
 	}
 	else {
 		result->vertexlist =
-				(struct adjlgvertex**)malloc(numvertices * sizeof(struct adjlgvertex*));
+				(struct adjlgvertex**)allocator_alloc(allocator, numvertices * sizeof(struct adjlgvertex*));
 
 		if (result->vertexlist == NULL) {
 			printf("Memory error when allocating graph vertex list!");
-			free(result);
+			allocator_free(allocator, result, sizeof(struct adjlgraph));
 			abort();
 		}
 		else {
@@ -86,6 +136,8 @@ struct adjlgraph* adjlgraph_creategraph(int numvertices, adjlgraph_edgetype etyp
 			result->printvertex = printvertexfunc;
 			result->numvertices = numvertices;
 			result->_total_edges = 0;
+			result->edgeblocks = NULL;
+			result->allocator = allocator;
 		}
 	}
 
@@ -106,7 +158,7 @@ size_t adjlgraph_getnumedges(struct adjlgraph* graph) {
 void adjlgraph_addvertex(struct adjlgraph* graph, int vindex, void* vdata)
 {
 	if (vindex < graph->numvertices) {
-		struct adjlgvertex* newvertex = adjlgraph_createvertex(vdata);
+		struct adjlgvertex* newvertex = adjlgraph_allocvertex(graph, vdata);
 		graph->vertexlist[vindex] = newvertex;
 	}
 	else {
@@ -121,7 +173,7 @@ void adjlgraph_addvertex(struct adjlgraph* graph, int vindex, void* vdata)
 void adjlgraph_addedge_helper( struct adjlgraph* graph, int from, int to,
 							   void* edgedata, double weight )
 {
-	struct adjlgedge* newedge = adjlgraph_createedge( to, edgedata, weight );
+	struct adjlgedge* newedge = adjlgraph_allocedge( graph, to, edgedata, weight );
 	struct adjlgedge* edge = graph->vertexlist[from]->edgeslist;
 
 	if (edge)
@@ -135,6 +187,8 @@ void adjlgraph_addedge_helper( struct adjlgraph* graph, int from, int to,
 	else {
 		graph->vertexlist[from]->edgeslist = newedge;
 	}
+
+	graph->_total_edges++;
 }
 
 /*
@@ -149,6 +203,129 @@ void adjlgraph_addedge( struct adjlgraph* graph, int from, int to, void* edgedat
 		adjlgraph_addedge_helper(graph, to, from, edgedata, weight);
 }
 
+/*
+ * Adds an array of edges to graph in bulk. Edges are grouped by vertex with a counting
+ * sort ('nthreads' threads) and their nodes are taken from one contiguous block, so there
+ * is no allocation per edge. Missing vertices are created (with NULL data).
+ * New edges are appended after existing edges of each vertex.
+ */
+void adjlgraph_addedges( struct adjlgraph* graph, const struct adjlgraph_edgeitem* edges,
+						 size_t count, int nthreads )
+{
+	// group edges by source vertex
+	struct csrgraph* csr = csrgraph_create_from_edges( graph->numvertices, graph->etype,
+													   edges, count, nthreads );
+
+	struct adjlgraph_edgeblock* block = (struct adjlgraph_edgeblock*)allocator_alloc( graph->allocator,
+			sizeof(struct adjlgraph_edgeblock) + csr->numarcs * sizeof(struct adjlgedge) );
+	if (block == NULL) {
+		printf("Memory error when allocating graph edges block!");
+		abort();
+	}
+
+	block->count = csr->numarcs;
+	block->next = graph->edgeblocks;
+	graph->edgeblocks = block;
+
+	for (size_t v = 0; v < graph->numvertices; ++v) {
+		if (graph->vertexlist[v] == NULL)
+			graph->vertexlist[v] = adjlgraph_allocvertex(graph, NULL);
+
+		size_t first = csr->offsets[v], last = csr->offsets[v + 1];
+		if (first == last)
+			continue;
+
+		// link nodes of the vertex (they are contiguous in the block)
+		for (size_t e = first; e < last; ++e) {
+			block->edges[e].vertexindex = csr->targets[e];
+			block->edges[e].weight = csr->weights[e];
+			block->edges[e].edgedata = NULL;
+			block->edges[e].next = (e + 1 < last) ? &(block->edges[e + 1]) : NULL;
+		}
+
+		// insert at end of edges list
+		struct adjlgedge* edge = graph->vertexlist[v]->edgeslist;
+		if (edge) {
+			while (edge->next != NULL)
+				edge = edge->next;
+
+			edge->next = &(block->edges[first]);
+		}
+		else {
+			graph->vertexlist[v]->edgeslist = &(block->edges[first]);
+		}
+	}
+
+	graph->_total_edges += csr->numarcs;
+	csrgraph_destroy(csr);
+}
+
+/*
+ * Reads a binary edge list file (sequence of 'struct adjlgraph_edgeitem' records).
+ * Returns the edges array and their number in 'count', or NULL if file can not be read.
+ * Note: returned array must be released later from memory.
+ */
+struct adjlgraph_edgeitem* adjlgraph_read_edgefile( const char* path, size_t* count )
+{
+	*count = 0;
+	FILE* f = fopen(path, "rb");
+	if (f == NULL)
+		return NULL;
+
+	struct adjlgraph_edgeitem* result = NULL;
+	if (fseek(f, 0, SEEK_END) == 0) {
+		long size = ftell(f);
+		size_t n = (size > 0) ? (size_t)size / sizeof(struct adjlgraph_edgeitem) : 0;
+		rewind(f);
+
+		result = (struct adjlgraph_edgeitem*)malloc((n > 0 ? n : 1) * sizeof(struct adjlgraph_edgeitem));
+		if (result == NULL) {
+			printf("Memory error when allocating edges array!");
+			abort();
+		}
+
+		if (fread(result, sizeof(struct adjlgraph_edgeitem), n, f) != n) {
+			free(result);
+			result = NULL;
+		}
+		else
+			*count = n;
+	}
+
+	fclose(f);
+	return result;
+}
+
+/*
+ * Writes an array of edges to a binary edge list file.
+ * Returns 1 if succeeded, 0 otherwise.
+ */
+int adjlgraph_write_edgefile( const char* path, const struct adjlgraph_edgeitem* edges,
+							  size_t count )
+{
+	FILE* f = fopen(path, "wb");
+	if (f == NULL)
+		return 0;
+
+	int result = (fwrite(edges, sizeof(struct adjlgraph_edgeitem), count, f) == count);
+	if (fclose(f) != 0)
+		result = 0;
+
+	return result;
+}
+
+/*
+ * Checks if an edge node belongs to a bulk load block.
+ */
+bool adjlgraph_isblockedge(const struct adjlgraph* graph, const struct adjlgedge* e)
+{
+	for (struct adjlgraph_edgeblock* b = graph->edgeblocks; b != NULL; b = b->next)
+		if (e >= b->edges && e < b->edges + b->count)
+			return true;
+
+	return false;
+}
+
 /*
  * Print the graph
  */
@@ -222,7 +399,8 @@ void adjlgraph_destroy(struct adjlgraph* graph)
 
 			prev = e;
 			e = e->next;
-			free(prev);
+			if (graph->edgeblocks == NULL || !adjlgraph_isblockedge(graph, prev))
+				allocator_free(graph->allocator, prev, sizeof(*prev));
 		}
 
 		if (graph->vertexlist[v] != NULL)
@@ -231,12 +409,20 @@ void adjlgraph_destroy(struct adjlgraph* graph)
 					graph->freevertexdata(graph->vertexlist[v]->vertexdata);
 
 		// release verte struct
-		free(graph->vertexlist[v]);
+		allocator_free(graph->allocator, graph->vertexlist[v], sizeof(struct adjlgvertex));
 //		free(graph->vertexlist[v]);
 	}
 
-	free(graph->vertexlist);	// free vertex array
-	free(graph);				// free graph struct
+	// release bulk load blocks
+	while (graph->edgeblocks != NULL) {
+		struct adjlgraph_edgeblock* next = graph->edgeblocks->next;
+		allocator_free( graph->allocator, graph->edgeblocks, sizeof(struct adjlgraph_edgeblock)
+						+ graph->edgeblocks->count * sizeof(struct adjlgedge) );
+		graph->edgeblocks = next;
+	}
+
+	allocator_free(graph->allocator, graph->vertexlist, numvertices * sizeof(struct adjlgvertex*));	// free vertex array
+	allocator_free(graph->allocator, graph, sizeof(*graph));	// free graph struct
 }
 
 /*
@@ -246,9 +432,9 @@ void adjlgraph_destroy(struct adjlgraph* graph)
 struct adjlgraph* adjlgraph_create_copy_from(struct adjlgraph* s, bool reverse)
 {
 	int nv = s->numvertices;
-	struct adjlgraph* result = adjlgraph_creategraph(
+	struct adjlgraph* result = adjlgraph_creategraph_allocator(
 									nv, s->etype, s->freevertexdata,
-									s->freeedgedata, s->printvertex, s->printedge );
+									s->freeedgedata, s->printvertex, s->printedge, s->allocator );
 	if (result == NULL) {
 		printf("Memory error: failed to allocate adjacency list graph struct!");
 		abort();
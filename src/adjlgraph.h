@@ -228,6 +228,7 @@
 #ifndef ADJLGRAPH_H_
 	#define ADJLGRAPH_H_
 	#include <stdbool.h>
+	#include "allocator.h"
 
 	// represents a vertex
 	struct adjlgvertex {
@@ -245,6 +246,20 @@
 
 	typedef enum {UNDIRECTED_AGRAPH = 0, DIRECTED_AGRAPH} adjlgraph_edgetype;
 
+	// an edge of a bulk load (also the record of binary edge list files)
+	struct adjlgraph_edgeitem {
+		int from;
+		int to;
+		double weight;
+	};
+
+	// block of edge nodes created by a bulk load (released as a whole)
+	struct adjlgraph_edgeblock {
+		struct adjlgraph_edgeblock* next;
+		size_t count;
+		struct adjlgedge edges[];
+	};
+
 	typedef void (*adjlgraph_freedata)(void* data);
 	typedef void (*adjlgraph_printdata)(const void* data);
 
@@ -258,15 +273,19 @@
 		size_t _total_edges;
 		size_t numvertices;
 		struct adjlgvertex** vertexlist;
+		struct adjlgraph_edgeblock* edgeblocks;		// edge nodes of bulk loads
+		const struct allocator* allocator;			// allocator of graph, vertices and edges (NULL: C library)
 	};
 
 	/*
-	 * Create a new graph vertex.
+	 * Create a new graph vertex (allocated with malloc, graphs allocate theirs from the
+	 * graph allocator).
 	 */
 	struct adjlgvertex* adjlgraph_createvertex(void* vertexdata);
 
 	/*
-	 * Create a new graph edge node.
+	 * Create a new graph edge node (allocated with malloc, graphs allocate theirs from
+	 * the graph allocator).
 	 */
 	struct adjlgedge* adjlgraph_createedge(int vindex, void* edgedata, double weight);
 
@@ -279,6 +298,17 @@
 			adjlgraph_printdata printvertexfunc,
 			adjlgraph_printdata printedgefunc);
 
+	/*
+	 * Create a new graph whose structure, vertex array, vertices and edges are allocated
+	 * by 'allocator' (see allocator.h, NULL: C library).
+	 */
+	struct adjlgraph* adjlgraph_creategraph_allocator(int numvertices, adjlgraph_edgetype etype,
+			adjlgraph_freedata freevertexdatafunc,
+			adjlgraph_freedata freeedgedatafunc,
+			adjlgraph_printdata printvertexfunc,
+			adjlgraph_printdata printedgefunc,
+			const struct allocator* allocator);
+
 	/*
 	 * Create a new graph that is a copy from a given existent graph. If 'reverse' arg is true, the direction
 	 * of the edges of the result copy will be resersed.
@@ -301,6 +331,29 @@
 	void adjlgraph_addedge( struct adjlgraph* graph, int from, int to, void* edgedata,
 							double weight );
 
+	/*
+	 * Adds an array of edges to graph in bulk. Edges are grouped by vertex with a counting
+	 * sort ('nthreads' threads) and their nodes are taken from one contiguous block, so there
+	 * is no allocation per edge. Missing vertices are created (with NULL data).
+	 * New edges are appended after existing edges of each vertex.
+	 */
+	void adjlgraph_addedges( struct adjlgraph* graph, const struct adjlgraph_edgeitem* edges,
+							 size_t count, int nthreads );
+
+	/*
+	 * Reads a binary edge list file (sequence of 'struct adjlgraph_edgeitem' records).
+	 * Returns the edges array and their number in 'count', or NULL if file can not be read.
+	 * Note: returned array must be released later from memory.
+	 */
+	struct adjlgraph_edgeitem* adjlgraph_read_edgefile( const char* path, size_t* count );
+
+	/*
+	 * Writes an array of edges to a binary edge list file.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 */
+	int adjlgraph_write_edgefile( const char* path, const struct adjlgraph_edgeitem* edges,
+								  size_t count );
+
 	/*
 	 * Print the graph
 	 */
@@ -0,0 +1,228 @@
+/*
+ * allocator.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Region (bump) allocator behind the pluggable allocator interface of
+ * 				the containers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "allocator.h"
+
+#define ALLOCATOR_ALIGNUP(n) (((n) + ALLOCATOR_REGION_ALIGN - 1) & ~(size_t)(ALLOCATOR_REGION_ALIGN - 1))
+#define ALLOCATOR_BLOCK_HEADER ALLOCATOR_ALIGNUP(sizeof(struct allocator_region_block))
+
+/*
+ * Gets the first usable byte of a region block.
+ * Note: Private function.
+ */
+unsigned char* allocator_region_blockdata(struct allocator_region_block* block)
+{
+	return (unsigned char*)block + ALLOCATOR_BLOCK_HEADER;
+}
+
+/*
+ * Allocates a block of 'size' usable bytes from the parent allocator.
+ * Large allocations get a block of their own, linked after the current block so its
+ * free space is still used; other blocks become the current block.
+ * Returns the block, NULL if there is no memory.
+ * Note: Private function.
+ */
+struct allocator_region_block* allocator_region_addblock(struct allocator_region* r, size_t size, int current)
+{
+	if (size > SIZE_MAX - ALLOCATOR_BLOCK_HEADER)
+		return NULL;
+
+	struct allocator_region_block* block = (struct allocator_region_block*)allocator_alloc(
+			r->parent, ALLOCATOR_BLOCK_HEADER + size );
+	if (block == NULL)
+		return NULL;
+
+	block->size = size;
+	r->reserved += size;
+	if (current || (r->blocks == NULL)) {
+		block->next = r->blocks;
+		r->blocks = block;
+		r->next = allocator_region_blockdata(block);
+		r->end = r->next + size;
+		r->last = NULL;
+	}
+	else {
+		block->next = r->blocks->next;
+		r->blocks->next = block;
+	}
+
+	return block;
+}
+
+/*
+ * Allocates 'size' bytes from a region.
+ * Note: Private function (allocator interface of the region).
+ */
+void* allocator_region_alloc(void* ctx, size_t size)
+{
+	struct allocator_region* r = (struct allocator_region*)ctx;
+	if (size > SIZE_MAX - ALLOCATOR_REGION_ALIGN)
+		return NULL;
+
+	size = ALLOCATOR_ALIGNUP((size > 0) ? size : 1);
+	if (size > (size_t)(r->end - r->next)) {
+		if (size > r->blocksize / 4) {
+			// own block: the free space of the current block is kept
+			struct allocator_region_block* block = allocator_region_addblock(r, size, 0);
+			if (block == NULL)
+				return NULL;
+
+			r->used += size;
+			if (r->blocks == block) {
+				r->next = r->end;	// only block: nothing left in it
+				r->last = NULL;
+			}
+
+			return allocator_region_blockdata(block);
+		}
+
+		if (allocator_region_addblock(r, r->blocksize, 1) == NULL)
+			return NULL;
+	}
+
+	unsigned char* ptr = r->next;
+	r->next += size;
+	r->last = ptr;
+	r->used += size;
+	return ptr;
+}
+
+/*
+ * Resizes an allocation of a region: the last allocation grows or shrinks in place,
+ * others are copied to a new allocation when they grow.
+ * Note: Private function (allocator interface of the region).
+ */
+void* allocator_region_realloc(void* ctx, void* ptr, size_t oldsize, size_t newsize)
+{
+	struct allocator_region* r = (struct allocator_region*)ctx;
+	if (ptr == NULL)
+		return allocator_region_alloc(ctx, newsize);
+
+	if (newsize > SIZE_MAX - ALLOCATOR_REGION_ALIGN)
+		return NULL;
+
+	size_t aligned = ALLOCATOR_ALIGNUP((newsize > 0) ? newsize : 1);
+	if ((ptr == r->last) && (aligned <= (size_t)(r->end - r->last))) {
+		r->used += aligned;
+		r->used -= (size_t)(r->next - r->last);
+		r->next = r->last + aligned;
+		return ptr;
+	}
+
+	if (newsize <= oldsize)
+		return ptr;
+
+	void* result = allocator_region_alloc(ctx, newsize);
+	if (result != NULL)
+		memcpy(result, ptr, oldsize);
+
+	return result;
+}
+
+/*
+ * Releases an allocation of a region (only the last allocation gives its space back).
+ * Note: Private function (allocator interface of the region).
+ */
+void allocator_region_free(void* ctx, void* ptr, size_t size)
+{
+	struct allocator_region* r = (struct allocator_region*)ctx;
+	if ((ptr != NULL) && (ptr == r->last)) {
+		r->used -= (size_t)(r->next - r->last);
+		r->next = r->last;
+		r->last = NULL;
+	}
+}
+
+/*
+ * Creates a region allocator with blocks of 'blocksize' bytes (0: ALLOCATOR_REGION_BLOCK)
+ * taken from 'parent' (NULL: C library).
+ * Returns the region, NULL if there is no memory.
+ */
+struct allocator_region* allocator_region_create(size_t blocksize, const struct allocator* parent)
+{
+	struct allocator_region* r = (struct allocator_region*)allocator_alloc(parent, sizeof(struct allocator_region));
+	if (r == NULL)
+		return NULL;
+
+	r->allocator = (struct allocator){ allocator_region_alloc, allocator_region_realloc,
+									   allocator_region_free, r };
+	r->parent = parent;
+	r->blocksize = ALLOCATOR_ALIGNUP((blocksize > 0) ? blocksize : ALLOCATOR_REGION_BLOCK);
+	r->blocks = NULL;
+	r->next = r->end = r->last = NULL;
+	r->used = 0;
+	r->reserved = 0;
+	return r;
+}
+
+/*
+ * Gets the allocator interface of a region (to pass to container constructors).
+ */
+const struct allocator* allocator_region_get(struct allocator_region* region)
+{
+	return &(region->allocator);
+}
+
+/*
+ * Releases every allocation of a region at once. The first block is kept for
+ * the next allocations, the other ones are released.
+ */
+void allocator_region_reset(struct allocator_region* region)
+{
+	struct allocator_region_block* keep = region->blocks;
+	if ((keep != NULL) && (keep->size != region->blocksize))
+		keep = NULL;	// current block is a large allocation
+
+	struct allocator_region_block* block = region->blocks;
+	while (block != NULL) {
+		struct allocator_region_block* next = block->next;
+		if (block != keep)
+			allocator_free(region->parent, block, ALLOCATOR_BLOCK_HEADER + block->size);
+
+		block = next;
+	}
+
+	region->blocks = keep;
+	region->used = 0;
+	region->reserved = 0;
+	region->last = NULL;
+	region->next = region->end = NULL;
+	if (keep != NULL) {
+		keep->next = NULL;
+		region->reserved = keep->size;
+		region->next = allocator_region_blockdata(keep);
+		region->end = region->next + keep->size;
+	}
+}
+
+/*
+ * Gets the number of bytes allocated from a region (including alignment).
+ */
+size_t allocator_region_getused(const struct allocator_region* region)
+{
+	return region->used;
+}
+
+/*
+ * Releases a region and every allocation made from it.
+ */
+void allocator_region_destroy(struct allocator_region* region)
+{
+	if (region == NULL)
+		return;
+
+	allocator_region_reset(region);
+	if (region->blocks != NULL)
+		allocator_free(region->parent, region->blocks, ALLOCATOR_BLOCK_HEADER + region->blocks->size);
+
+	allocator_free(region->parent, region, sizeof(struct allocator_region));
+}
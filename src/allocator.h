@@ -0,0 +1,158 @@
+/*****************************************************************************
+ * allocator.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers of the pluggable allocator interface of the containers
+ *  			 and of a region (bump) allocator.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  An allocator is a table of three functions (alloc, realloc, free) plus a context
+ *  pointer given back to each of them. Containers take one in their ..._create_allocator
+ *  constructor (hashtable_create_allocator, rbtree_create_allocator,
+ *  arraylist_create_allocator, adjlgraph_creategraph_allocator, trie_create_allocator,
+ *  nodearena_create_allocator, linkedlist_nodepool_create_allocator) and route every
+ *  allocation of their structure, nodes and arrays through it. The allocator must
+ *  outlive the containers using it.
+ *
+ *  A NULL allocator is the C library (malloc, realloc, free): the helpers below test
+ *  for NULL before the indirect call, so containers created with the plain constructors
+ *  pay one predictable branch per allocation and nothing else.
+ *
+ *  Sizes are passed to realloc and free (sized deallocation), as needed by allocators
+ *  that do not keep a header per block (regions, size class pools, numa_free). Callers
+ *  always pass the size given to alloc (or to the last realloc).
+ *
+ *  Region allocator
+ *
+ *  	Allocations are carved from large blocks by bumping a pointer and are only
+ *  	released all at once, by allocator_region_reset or allocator_region_destroy, which
+ *  	tears down every container allocated from the region in O(blocks), without
+ *  	visiting their nodes. free only gives back the last allocation (a stack), realloc
+ *  	grows the last allocation in place. Regions are not thread safe: use one region per
+ *  	thread or per request, so allocations never contend on a lock.
+ *  	Containers in a region must not be destroyed after the region is reset, except
+ *  	with their ..._destroy function before the reset (which is then mostly free calls
+ *  	that do nothing).
+ *
+ *******************************************************************************/
+
+#ifndef ALLOCATOR_H_
+	#define ALLOCATOR_H_
+
+	#include <stdlib.h>
+	#include <stdint.h>
+	#include <string.h>
+
+	#define ALLOCATOR_REGION_BLOCK ((size_t)1 << 20)	// default region block size (1 MiB)
+	#define ALLOCATOR_REGION_ALIGN 16					// alignment of region allocations
+
+	// allocates 'size' bytes (NULL if there is no memory)
+	typedef void* (*allocator_allocfunc)(void* ctx, size_t size);
+
+	// resizes a block of 'oldsize' bytes to 'newsize' (NULL if there is no memory, block is kept)
+	typedef void* (*allocator_reallocfunc)(void* ctx, void* ptr, size_t oldsize, size_t newsize);
+
+	// releases a block of 'size' bytes
+	typedef void (*allocator_freefunc)(void* ctx, void* ptr, size_t size);
+
+	// allocator interface
+	struct allocator {
+		allocator_allocfunc alloc;
+		allocator_reallocfunc realloc;
+		allocator_freefunc free;
+		void* ctx;							// first argument of every function
+	};
+
+	// block of a region
+	struct allocator_region_block {
+		struct allocator_region_block* next;
+		size_t size;						// usable bytes after the header
+	};
+
+	// region (bump) allocator
+	struct allocator_region {
+		struct allocator allocator;			// interface of the region (see allocator_region_get)
+		const struct allocator* parent;		// allocator of the blocks (NULL: C library)
+		size_t blocksize;					// size of new blocks
+		struct allocator_region_block* blocks;	// current block first
+		unsigned char* next;				// next free byte of current block
+		unsigned char* end;					// end of current block
+		unsigned char* last;				// last allocation (NULL if none)
+		size_t used;						// bytes allocated (including alignment)
+		size_t reserved;					// bytes in blocks
+	};
+
+	/*
+	 * Allocates 'size' bytes with allocator 'a' (NULL: malloc).
+	 */
+	static inline void* allocator_alloc(const struct allocator* a, size_t size) {
+		return (a == NULL) ? malloc(size) : a->alloc(a->ctx, size);
+	}
+
+	/*
+	 * Allocates 'n' zeroed elements of 'size' bytes with allocator 'a' (NULL: calloc).
+	 */
+	static inline void* allocator_calloc(const struct allocator* a, size_t n, size_t size) {
+		if (a == NULL)
+			return calloc(n, size);
+
+		if ((size != 0) && (n > SIZE_MAX / size))
+			return NULL;
+
+		void* ptr = a->alloc(a->ctx, n * size);
+		if (ptr != NULL)
+			memset(ptr, 0, n * size);
+
+		return ptr;
+	}
+
+	/*
+	 * Resizes a block of 'oldsize' bytes to 'newsize' with allocator 'a' (NULL: realloc).
+	 */
+	static inline void* allocator_realloc(const struct allocator* a, void* ptr, size_t oldsize, size_t newsize) {
+		return (a == NULL) ? realloc(ptr, newsize) : a->realloc(a->ctx, ptr, oldsize, newsize);
+	}
+
+	/*
+	 * Releases a block of 'size' bytes with allocator 'a' (NULL: free).
+	 */
+	static inline void allocator_free(const struct allocator* a, void* ptr, size_t size) {
+		if (a == NULL)
+			free(ptr);
+		else if (ptr != NULL)
+			a->free(a->ctx, ptr, size);
+	}
+
+	/*
+	 * Creates a region allocator with blocks of 'blocksize' bytes (0: ALLOCATOR_REGION_BLOCK)
+	 * taken from 'parent' (NULL: C library).
+	 * Returns the region, NULL if there is no memory.
+	 */
+	struct allocator_region* allocator_region_create(size_t blocksize, const struct allocator* parent);
+
+	/*
+	 * Gets the allocator interface of a region (to pass to container constructors).
+	 */
+	const struct allocator* allocator_region_get(struct allocator_region* region);
+
+	/*
+	 * Releases every allocation of a region at once. The first block is kept for
+	 * the next allocations, the other ones are released.
+	 */
+	void allocator_region_reset(struct allocator_region* region);
+
+	/*
+	 * Gets the number of bytes allocated from a region (including alignment).
+	 */
+	size_t allocator_region_getused(const struct allocator_region* region);
+
+	/*
+	 * Releases a region and every allocation made from it.
+	 */
+	void allocator_region_destroy(struct allocator_region* region);
+
+#endif /* ALLOCATOR_H_ */
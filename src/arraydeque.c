@@ -8,11 +8,90 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <assert.h>
 #include "arraydeque.h"
 
 /*
- * Create deque instance.
+ * Rounds 'capacity' up to a power of two.
+ * Returns 0 if too large.
+ * Note: Private function.
+ */
+size_t arraydeque_round_capacity(size_t capacity)
+{
+	size_t result = ARRAYDEQUE_MIN_CAPACITY;
+	while (result < capacity) {
+		if (result > SIZE_MAX / 2 / sizeof(void*))
+			return 0;
+
+		result *= 2;
+	}
+
+	return result;
+}
+
+/*
+ * Moves the elements to a new array of 'capacity' (power of two, not lesser than
+ * size) slots, front element at slot 0.
+ * Returns 1 if succeeded, 0 otherwise.
+ * Note: Private function.
+ */
+int arraydeque_resize(struct arraydeque* arrdeque, size_t capacity)
+{
+	void** temp = (void**)malloc(sizeof(void*) * capacity);
+	if (temp == NULL)
+		return 0;
+
+	// copy the two segments: front..end of array, start of array..back
+	size_t first = arrdeque->capacity - arrdeque->frontindex;
+	if (first > arrdeque->size)
+		first = arrdeque->size;
+
+	memcpy(temp, arrdeque->arr + arrdeque->frontindex, first * sizeof(void*));
+	memcpy(temp + first, arrdeque->arr, (arrdeque->size - first) * sizeof(void*));
+
+	free(arrdeque->arr);
+	arrdeque->arr = temp;
+	arrdeque->capacity = capacity;
+	arrdeque->frontindex = 0;
+	arrdeque->backindex = arrdeque->size & (capacity - 1);
+	return 1;
+}
+
+/*
+ * Grows the array for 'count' more elements, aborts if there is no memory.
+ * Note: Private function.
+ */
+void arraydeque_grow(struct arraydeque* arrdeque, size_t count)
+{
+	size_t capacity = (count > SIZE_MAX - arrdeque->size) ? 0
+					  : arraydeque_round_capacity(arrdeque->size + count);
+
+	if (capacity == 0 || !arraydeque_resize(arrdeque, capacity)) {
+		printf("Memory error when growing arraydeque array!\n");
+		abort();
+	}
+}
+
+/*
+ * Halves the array while the size is at most a quarter of the capacity (not below
+ * mincapacity). A failed reallocation keeps the current array.
+ * Note: Private function.
+ */
+void arraydeque_shrink(struct arraydeque* arrdeque)
+{
+	size_t capacity = arrdeque->capacity;
+	while (capacity / 2 >= arrdeque->mincapacity
+		   && arrdeque->size <= capacity / ARRAYDEQUE_SHRINK_RATIO)
+		capacity /= 2;
+
+	if (capacity < arrdeque->capacity)
+		arraydeque_resize(arrdeque, capacity);
+}
+
+/*
+ * Create deque instance (capacity is rounded up to a power of two).
  */
 struct arraydeque* arraydeque_create_capacity( size_t capacity,
 									  arraydeque_printdata printdatafunc,
@@ -20,8 +99,14 @@ struct arraydeque* arraydeque_create_capacity( size_t capacity,
 {
 	assert(capacity >= ARRAYDEQUE_MIN_CAPACITY);
 
+	capacity = arraydeque_round_capacity(capacity);
+	if (capacity == 0) {
+		printf("Memory error when allocating arraydeque array!\n");
+		return NULL;
+	}
+
 	size_t arrsize = sizeof(void*) * capacity;
-	struct arraydeque* result = (struct arraydeque*)malloc(arrsize + sizeof(*result));
+	struct arraydeque* result = (struct arraydeque*)malloc(sizeof(*result));
 
 	if (result == NULL)
 		printf("Memory error when allocating arraydeque struct!\n");
@@ -37,13 +122,8 @@ struct arraydeque* arraydeque_create_capacity( size_t capacity,
 		else
 		{
 			result->arr = arrbuf;
-
-			// init array elem
-			for (int i = 0; i < capacity; i++)
-				result->arr[i] = NULL;
-
-			result->frontindex = result->backindex = -1;
-			result->capacity = capacity;
+			result->frontindex = result->backindex = 0;
+			result->capacity = result->mincapacity = capacity;
 			result->size = 0;
 			result->printdata = printdatafunc;
 			result->freedata = freedatafunc;
@@ -68,10 +148,7 @@ struct arraydeque* arraydeque_create( arraydeque_printdata printdatafunc,
  */
 int arraydeque_empty(struct arraydeque* arrdeque)
 {
-    if (arrdeque->frontindex == -1 && arrdeque->backindex == -1)
-        return 1;
-    else
-        return 0;
+    return (arrdeque->size == 0);
 }
 
 /*
@@ -79,10 +156,7 @@ int arraydeque_empty(struct arraydeque* arrdeque)
  */
 int arraydeque_full(struct arraydeque* arrdeque)
 {
-    if (arrdeque->size == arrdeque->capacity)
-        return 1;
-    else
-        return 0;
+    return (arrdeque->size == arrdeque->capacity);
 }
 
 /*
@@ -110,65 +184,25 @@ void* arraydeque_back(struct arraydeque* arrdeque)
         abort();
     }
 
-    return arrdeque->arr[arrdeque->backindex];
+    return arrdeque->arr[(arrdeque->backindex - 1) & (arrdeque->capacity - 1)];
 }
 
 /*
- * Function to insert the element
- * to the back of the deque
+ * Function to insert the element to the back of the deque
  *
  * - If the deque is full, then double the size of the current array and copy the elements
- * 		of the previous array into the new array.
- * - If deque is empty(), then assign frontIndex = backIndex = 0 and then assign X to
- * 		both arr[frontIndex] and arr[backIndex] and then increment sizeVar by one.
- *   Else, update backIndex as backIndex = (backIndex+1) %capacityVar and then assign
- *   	X to arr[backIndex] and increment sizeVar by one.
+ * 		of the previous array into the new array (two memcpy).
+ * - Assign X to arr[backIndex], update backIndex as backIndex = (backIndex + 1) & mask
+ * 		and increment size by one.
  */
 void arraydeque_push_back(struct arraydeque* arrdeque, void* x)
 {
-    if (arraydeque_full(arrdeque)) {
-
-        // If the deque is full, then
-        // double the capacity
-    	arrdeque->capacity = arrdeque->capacity * 2;
-
-        // Initialize new array of
-        // double size
-        void** temp = (void**)malloc(sizeof(void*) * arrdeque->capacity);
-
-        // Copy the elements of the
-        // previous array
-        int i = arrdeque->frontindex;
-        int j = 0;
-        while (i != arrdeque->backindex) {
-            temp[j] = arrdeque->arr[i];
-            i = (i + 1) % arrdeque->size;
-            j++;
-        }
-        temp[j] = arrdeque->arr[i];
-
-        arrdeque->frontindex = 0;
-        arrdeque->backindex = arrdeque->size - 1;
-
-        // Deallocate the memory
-        // of previous array
-        free(arrdeque->arr);
-        arrdeque->arr = temp;
-    }
+    if (arraydeque_full(arrdeque))
+    	arraydeque_grow(arrdeque, 1);
 
-    // If size is zero
-    if (arraydeque_empty(arrdeque)) {
-    	arrdeque->frontindex = arrdeque->backindex = 0;
-    	arrdeque->arr[arrdeque->backindex] = x;
-    	arrdeque->size++;
-        return;
-    }
-
-    // Increment back index cyclically
-    arrdeque->backindex = (arrdeque->backindex + 1) % arrdeque->capacity;
     arrdeque->arr[arrdeque->backindex] = x;
+    arrdeque->backindex = (arrdeque->backindex + 1) & (arrdeque->capacity - 1);
     arrdeque->size++;
-    return;
 }
 
 /*
@@ -176,59 +210,19 @@ void arraydeque_push_back(struct arraydeque* arrdeque, void* x)
  * to the front of the deque
  *
  * - If the deque is full, then double the size of the current array and copy the
- * 		elements of the previous array into the new array.
- * - If deque is empty(), then assign frontIndex = backIndex = 0 and then assign X
- * 		to both arr[frontIndex] and arr[backIndex] and then increment sizeVar by one.
- *   Else, update frontIndex as frontIndex = (frontIndex-1 + capacityVar)%capacityVar
- *   	and then assign X to arr[frontIndex] and increment sizeVar by one.
+ * 		elements of the previous array into the new array (two memcpy).
+ * - Update frontIndex as frontIndex = (frontIndex - 1) & mask, assign X to
+ * 		arr[frontIndex] and increment size by one.
  */
 void arraydeque_push_front(struct arraydeque* arrdeque, void* x)
 {
-    if (arraydeque_full(arrdeque)) {
-
-        // If the deque is full, then
-        // double the capacity
-    	arrdeque->capacity = arrdeque->capacity * 2;
-
-        // Initialize new array of
-        // double size
-    	void** temp = (void**)malloc(sizeof(void*) * arrdeque->capacity);
-
-        // Copy the elements of the
-        // previous array
-        int i = arrdeque->frontindex;
-        int j = 0;
-        while (i != arrdeque->backindex) {
-            temp[j] = arrdeque->arr[i];
-            i = (i + 1) % arrdeque->size;
-            j++;
-        }
-
-        temp[j] = arrdeque->arr[i];
-
-        arrdeque->frontindex = 0;
-        arrdeque->backindex = arrdeque->size - 1;
-
-        // Deallocate the memory
-        // of previous array
-        free(arrdeque->arr);
-        arrdeque->arr = temp;
-    }
-
-    // If size is zero
-    if (arraydeque_empty(arrdeque)) {
-    	arrdeque->frontindex = arrdeque->backindex = 0;
-    	arrdeque->arr[arrdeque->backindex] = x;
-    	arrdeque->size++;
-        return;
-    }
+    if (arraydeque_full(arrdeque))
+    	arraydeque_grow(arrdeque, 1);
 
     // Decrement front index cyclically
-    arrdeque->frontindex
-        = (arrdeque->frontindex - 1 + arrdeque->capacity) % arrdeque->capacity;
+    arrdeque->frontindex = (arrdeque->frontindex - 1) & (arrdeque->capacity - 1);
     arrdeque->arr[arrdeque->frontindex] = x;
     arrdeque->size++;
-    return;
 }
 
 /*
@@ -237,38 +231,26 @@ void arraydeque_push_front(struct arraydeque* arrdeque, void* x)
  *
  * - If the deque is empty,
  * 		print “Underflow”.
- *   Else if sizeVar is equal to 1 then
- *   	assign -1 to frontIndex and backIndex both and then decrement sizeVar by one.
  *   Else,
- *   	Update frontIndex as frontIndex = (frontIndex+1)%capacityVar and
- *   	decrement sizeVar by one.
+ *   	Update frontIndex as frontIndex = (frontIndex + 1) & mask, decrement size by
+ *   	one and apply the shrink policy.
  */
 void* arraydeque_pop_front(struct arraydeque* arrdeque)
 {
-	void* result = NULL;
-
     // If deque is empty
     if (arraydeque_empty(arrdeque)) {
     	printf("Deque underflow\n");
         abort();
     }
 
-    result = arraydeque_front(arrdeque);
-    arrdeque->arr[arrdeque->frontindex] = NULL;
-
-    // If there is only one character
-    if (arrdeque->frontindex == arrdeque->backindex) {
-
-        // Mark deque as empty
-        // and decrement sizeVar
-    	arrdeque->frontindex = arrdeque->backindex = -1;
-    	arrdeque->size--;
-        return result;
-    }
+    void* result = arrdeque->arr[arrdeque->frontindex];
 
     // Increment frontIndex cyclically
-    arrdeque->frontindex = (arrdeque->frontindex + 1) % arrdeque->capacity;
+    arrdeque->frontindex = (arrdeque->frontindex + 1) & (arrdeque->capacity - 1);
     arrdeque->size--;
+    if (arrdeque->size <= arrdeque->capacity / ARRAYDEQUE_SHRINK_RATIO)
+    	arraydeque_shrink(arrdeque);
+
     return result;
 }
 
@@ -278,53 +260,104 @@ void* arraydeque_pop_front(struct arraydeque* arrdeque)
  *
  * - If the deque is empty,
  * 		print “Underflow”.
- *   Else if sizeVar is equal to 1 then
- *   	assign -1 to frontIndex and backIndex both and then decrement sizeVar by one.
  *   Else,
- *   	Update backIndex as backIndex = (backndex-1 + capacityVar) % capacityVar and
- *   	decrement sizeVar by one.
+ *   	Update backIndex as backIndex = (backIndex - 1) & mask, decrement size by
+ *   	one and apply the shrink policy.
  */
 void* arraydeque_pop_back(struct arraydeque* arrdeque)
 {
-	void* result = NULL;
-
     // If deque is empty
     if (arraydeque_empty(arrdeque)) {
     	printf("Deque underflow\n");
         abort();
     }
 
-    result = arraydeque_back(arrdeque);
-    arrdeque->arr[arrdeque->backindex] = NULL;
-
-    // If there is only one character
-    if (arrdeque->frontindex == arrdeque->backindex) {
-
-        // Mark deque as empty
-        // and decrement sizeVar
-    	arrdeque->frontindex = arrdeque->backindex = -1;
-    	arrdeque->size--;
-        return result;
-    }
-
     // Decrement backIndex cyclically
-    arrdeque->backindex = (arrdeque->backindex - 1 + arrdeque->capacity) % arrdeque->capacity;
+    arrdeque->backindex = (arrdeque->backindex - 1) & (arrdeque->capacity - 1);
+    void* result = arrdeque->arr[arrdeque->backindex];
     arrdeque->size--;
+    if (arrdeque->size <= arrdeque->capacity / ARRAYDEQUE_SHRINK_RATIO)
+    	arraydeque_shrink(arrdeque);
+
     return result;
 }
 
+/*
+ * Inserts 'n' elements of 'items' at the back of the deque, in order, with at most
+ * one reallocation and two memcpy.
+ */
+void arraydeque_push_back_n(struct arraydeque* arrdeque, void** items, size_t n)
+{
+	if (n > arrdeque->capacity - arrdeque->size)
+		arraydeque_grow(arrdeque, n);
+
+	// free slots from backIndex to the end of the array, then from the start
+	size_t first = arrdeque->capacity - arrdeque->backindex;
+	if (first > n)
+		first = n;
+
+	memcpy(arrdeque->arr + arrdeque->backindex, items, first * sizeof(void*));
+	memcpy(arrdeque->arr, items + first, (n - first) * sizeof(void*));
+	arrdeque->backindex = (arrdeque->backindex + n) & (arrdeque->capacity - 1);
+	arrdeque->size += n;
+}
+
+/*
+ * Removes up to 'n' elements from the front of the deque into 'out', in order, with
+ * at most two memcpy.
+ * Returns the number of removed elements.
+ */
+size_t arraydeque_pop_front_n(struct arraydeque* arrdeque, void** out, size_t n)
+{
+	if (n > arrdeque->size)
+		n = arrdeque->size;
+
+	size_t first = arrdeque->capacity - arrdeque->frontindex;
+	if (first > n)
+		first = n;
+
+	memcpy(out, arrdeque->arr + arrdeque->frontindex, first * sizeof(void*));
+	memcpy(out + first, arrdeque->arr, (n - first) * sizeof(void*));
+	arrdeque->frontindex = (arrdeque->frontindex + n) & (arrdeque->capacity - 1);
+	arrdeque->size -= n;
+	if (arrdeque->size <= arrdeque->capacity / ARRAYDEQUE_SHRINK_RATIO)
+		arraydeque_shrink(arrdeque);
+
+	return n;
+}
+
+/*
+ * Makes room for at least 'capacity' elements. The capacity is not shrunk below it
+ * afterwards (see shrink policy).
+ * Returns 1 if succeeded, 0 otherwise.
+ */
+int arraydeque_reserve(struct arraydeque* arrdeque, size_t capacity)
+{
+	capacity = arraydeque_round_capacity(capacity);
+	if (capacity == 0)
+		return 0;
+
+	if (capacity > arrdeque->capacity && !arraydeque_resize(arrdeque, capacity))
+		return 0;
+
+	if (capacity > arrdeque->mincapacity)
+		arrdeque->mincapacity = capacity;
+
+	return 1;
+}
+
 /*
  * Release array deque instance from memory.
  * */
 void arraydeque_destroy(struct arraydeque* arrdeque)
 {
 	if (arrdeque->freedata != NULL)
-		for (int i = 0; i < arrdeque->capacity; ++i) {
-			if (arrdeque->arr[i] != NULL)
-				arrdeque->freedata(arrdeque->arr[i]);
-	}
+		for (size_t i = 0; i < arrdeque->size; ++i) {
+			void* data = arrdeque->arr[(arrdeque->frontindex + i) & (arrdeque->capacity - 1)];
+			if (data != NULL)
+				arrdeque->freedata(data);
+		}
+
 	free(arrdeque->arr);
 	free(arrdeque);
 }
-
-
@@ -84,6 +84,17 @@
  * 		circular array. In both implementations, we can implement all operations
  * 		in O(1) time.
  *
+ * 		Here the capacity is always a power of two, so indices wrap with a mask
+ * 		(index & (capacity - 1)) instead of a modulo. The elements occupy at most two
+ * 		contiguous segments of the array (before and after the wrap point): growing,
+ * 		shrinking and the bulk operations (push_back_n / pop_front_n) copy them with at
+ * 		most two memcpy calls.
+ *
+ * 		Shrink policy: when the size falls to a quarter of the capacity after a pop the
+ * 		array is halved, never below the creation (or reserved) capacity. Growing at
+ * 		full and shrinking at a quarter leaves a factor of two between both thresholds,
+ * 		so pushes and pops around one size never resize every time (amortized O(1)).
+ *
  *
  * Source: https://www.geeksforgeeks.org/deque-set-1-introduction-applications/
  *
@@ -92,22 +103,27 @@
 #ifndef ARRAYDEQUE_H_
 	#define ARRAYDEQUE_H_
 
+	#include <stddef.h>
+
 	#define ARRAYDEQUE_MIN_CAPACITY 16
 	#define ARRAYDEQUE_DEF_CAPACITY 16
+	#define ARRAYDEQUE_SHRINK_RATIO 4		// halve capacity when size <= capacity / ratio
 
 	typedef void (*arraydeque_freedata)(void* data);
 	typedef void (*arraydeque_printdata)(void* data);
 
 	struct arraydeque {
-		size_t capacity, size;
-		int frontindex, backindex;
+		size_t capacity, size;		// capacity is a power of two
+		size_t mincapacity;			// capacity is not shrunk below this limit
+		size_t frontindex;			// slot of the front element
+		size_t backindex;			// slot after the back element
 		arraydeque_freedata freedata;
 		arraydeque_printdata printdata;
 		void** arr;	// variable sized array
 	};
 
 	/*
-	 * Create deque instance.
+	 * Create deque instance (capacity is rounded up to a power of two).
 	 */
 	struct arraydeque* arraydeque_create_capacity( size_t capacity,
 										  arraydeque_printdata printdatafunc,
@@ -143,11 +159,9 @@
 	 * Function to insert the element to the back of the deque
 	 *
 	 * - If the deque is full, then double the size of the current array and copy the elements
-	 * 		of the previous array into the new array.
-	 * - If deque is empty(), then assign frontIndex = backIndex = 0 and then assign X to
-	 * 		both arr[frontIndex] and arr[backIndex] and then increment sizeVar by one.
-	 *   Else, update backIndex as backIndex = (backIndex+1) %capacityVar and then assign
-	 *   	X to arr[backIndex] and increment sizeVar by one.
+	 * 		of the previous array into the new array (two memcpy).
+	 * - Assign X to arr[backIndex], update backIndex as backIndex = (backIndex + 1) & mask
+	 * 		and increment size by one.
 	 */
 	void arraydeque_push_back(struct arraydeque* arrdeque, void* x);
 
@@ -156,11 +170,9 @@
 	 * to the front of the deque
 	 *
 	 * - If the deque is full, then double the size of the current array and copy the
-	 * 		elements of the previous array into the new array.
-	 * - If deque is empty(), then assign frontIndex = backIndex = 0 and then assign X
-	 * 		to both arr[frontIndex] and arr[backIndex] and then increment sizeVar by one.
-	 *   Else, update frontIndex as frontIndex = (frontIndex-1 + capacityVar)%capacityVar
-	 *   	and then assign X to arr[frontIndex] and increment sizeVar by one.
+	 * 		elements of the previous array into the new array (two memcpy).
+	 * - Update frontIndex as frontIndex = (frontIndex - 1) & mask, assign X to
+	 * 		arr[frontIndex] and increment size by one.
 	 */
 	void arraydeque_push_front(struct arraydeque* arrdeque, void* x);
 
@@ -170,11 +182,9 @@
 	 *
 	 * - If the deque is empty,
 	 * 		print “Underflow”.
-	 *   Else if sizeVar is equal to 1 then
-	 *   	assign -1 to frontIndex and backIndex both and then decrement sizeVar by one.
 	 *   Else,
-	 *   	Update frontIndex as frontIndex = (frontIndex+1)%capacityVar and
-	 *   	decrement sizeVar by one.
+	 *   	Update frontIndex as frontIndex = (frontIndex + 1) & mask, decrement size by
+	 *   	one and apply the shrink policy.
 	 */
 	void* arraydeque_pop_front(struct arraydeque* arrdeque);
 
@@ -184,14 +194,32 @@
 	 *
 	 * - If the deque is empty,
 	 * 		print “Underflow”.
-	 *   Else if sizeVar is equal to 1 then
-	 *   	assign -1 to frontIndex and backIndex both and then decrement sizeVar by one.
 	 *   Else,
-	 *   	Update backIndex as backIndex = (backndex-1 + capacityVar) % capacityVar and
-	 *   	decrement sizeVar by one.
+	 *   	Update backIndex as backIndex = (backIndex - 1) & mask, decrement size by
+	 *   	one and apply the shrink policy.
 	 */
 	void* arraydeque_pop_back(struct arraydeque* arrdeque);
 
+	/*
+	 * Inserts 'n' elements of 'items' at the back of the deque, in order, with at most
+	 * one reallocation and two memcpy.
+	 */
+	void arraydeque_push_back_n(struct arraydeque* arrdeque, void** items, size_t n);
+
+	/*
+	 * Removes up to 'n' elements from the front of the deque into 'out', in order, with
+	 * at most two memcpy.
+	 * Returns the number of removed elements.
+	 */
+	size_t arraydeque_pop_front_n(struct arraydeque* arrdeque, void** out, size_t n);
+
+	/*
+	 * Makes room for at least 'capacity' elements. The capacity is not shrunk below it
+	 * afterwards (see shrink policy).
+	 * Returns 1 if succeeded, 0 otherwise.
+	 */
+	int arraydeque_reserve(struct arraydeque* arrdeque, size_t capacity);
+
 	/*
 	 * Release array deque instance from memory.
 	 * */
@@ -7,22 +7,97 @@
  *  Implementation of a generic array list in C.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+	#define _GNU_SOURCE			// mremap
+#endif
+
 #include "arraylist.h"
 
 #include <stdlib.h>
-#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+	#include <sys/mman.h>
+#endif
+
+// state of a parallel sort
+struct arraylist_sort_state {
+	void** src;					// list buffer
+	void** tmp;					// merge buffer
+	size_t* bounds;				// chunk 'i' is [bounds[i], bounds[i + 1])
+	int nthreads;
+	arraylist_compare compare;
+	pthread_barrier_t barrier;
+};
+
+// size of the structure block of lists with an allocator (inline buffer included)
+#define ARRAYLIST_ALLOCATOR_BLOCK (sizeof(struct arraylist) + sizeof(void*) * ARRAYLIST_INLINE_CAPACITY)
+
+struct arraylist_sort_worker {
+	struct arraylist_sort_state* st;
+	int tid;
+	pthread_t thread;
+};
 
 /*
  * Creates and initializes an arraylist structure.
  * */
-struct arraylist* arraylist_create_capacity(uint capacity) {
-	uint bufsize = capacity;
+struct arraylist* arraylist_create_capacity(size_t capacity) {
+	return arraylist_create_allocator(capacity, NULL);
+}
+
+/*
+ * Creates and initializes an arraylist structure whose structure and buffer are
+ * allocated by 'allocator' (see allocator.h, NULL: C library).
+ * */
+struct arraylist* arraylist_create_allocator(size_t capacity, const struct allocator* allocator) {
+	size_t bufsize = (capacity > 0) ? capacity : 1;
+	if (allocator != NULL) {
+		// structure block always has the inline buffer: its size is known on destroy
+		struct arraylist* result = allocator_alloc(allocator, ARRAYLIST_ALLOCATOR_BLOCK);
+		if (result == NULL)
+			return NULL;
+
+		result->inlined = (bufsize <= ARRAYLIST_INLINE_CAPACITY);
+		result->buffer = result->inlined ? (void**)(result + 1)
+				: ((bufsize <= SIZE_MAX / sizeof(void*)) ? allocator_alloc(allocator, sizeof(void*) * bufsize) : NULL);
+		if (result->buffer == NULL) {
+			allocator_free(allocator, result, ARRAYLIST_ALLOCATOR_BLOCK);
+			return NULL;
+		}
+
+		result->capacity = result->inlined ? ARRAYLIST_INLINE_CAPACITY : bufsize;
+		result->length = 0;
+		result->mapped = 0;
+		result->allocator = allocator;
+		return result;
+	}
+
+	if (bufsize <= ARRAYLIST_INLINE_CAPACITY) {
+		// small list: buffer in the same block as the structure (one allocation)
+		struct arraylist* result = malloc(sizeof(struct arraylist) + sizeof(void*) * bufsize);
+		if (result == NULL)
+			return NULL;
+
+		result->buffer = (void**)(result + 1);
+		result->capacity = bufsize;
+		result->length = 0;
+		result->mapped = 0;
+		result->inlined = 1;
+		result->allocator = NULL;
+		return result;
+	}
+
 	struct arraylist* result = malloc(sizeof(struct arraylist));
 
 	if (result == NULL)
 		return NULL;
 
-	void** buffer = malloc(sizeof(void*) * bufsize);
+	void** buffer = (bufsize <= SIZE_MAX / sizeof(void*)) ? malloc(sizeof(void*) * bufsize) : NULL;
 
 	if (buffer == NULL) {
 		free(result);
@@ -32,6 +107,9 @@ struct arraylist* arraylist_create_capacity(uint capacity) {
 	result->buffer = buffer;
 	result->capacity = bufsize;
 	result->length = 0;
+	result->mapped = 0;
+	result->inlined = 0;
+	result->allocator = NULL;
 	return result;
 }
 
@@ -47,43 +125,155 @@ struct arraylist* arraylist_create() {
  * Gets the pointer to element located at index position in the
  * arraylist buffer array.
  * */
-void* arraylist_get_item_at(const struct arraylist* a, unsigned int index) {
-	if (index < 0 || index >= a->length)
+void* arraylist_get_item_at(const struct arraylist* a, size_t index) {
+	if (index >= a->length)
 		return NULL;
 
 	return *(index + a->buffer);
 }
 
 /*
- * Allocates buffer memory if necessary to insert one element.
+ * Changes buffer size to 'capacity' elements (not lesser than length).
+ * Large buffers live in an anonymous mapping resized with mremap (Linux).
  * Note: Private function.
  * */
-int arraylist_allocate_mem_if_needed_for_insertion(struct arraylist* a) {
-	if (a->capacity == a->length) {
-		float lfact = ARRAYLIST_DEFAULT_LOADFACTOR;
-		unsigned int numel = trunc(lfact * a->capacity);
-		unsigned int numbytes = numel * sizeof(void*);
-		void* newBuffer = realloc(a->buffer, numbytes);
+int arraylist_resize_buffer(struct arraylist* a, size_t capacity) {
+	if (capacity == 0)
+		capacity = 1;
+
+	if (capacity > SIZE_MAX / sizeof(void*))
+		return 0;
+
+	size_t numbytes = capacity * sizeof(void*);
+
+	if (a->inlined && capacity <= a->capacity)
+		return 1;		// inline buffer can not be shrunk
+
+	if (a->allocator != NULL) {
+		void** newBuffer = a->inlined ? allocator_alloc(a->allocator, numbytes)
+				: allocator_realloc(a->allocator, a->buffer, a->capacity * sizeof(void*), numbytes);
 		if (newBuffer == NULL)
-		{
-			// fail to reallocate memory
 			return 0;
+
+		if (a->inlined)
+			memcpy(newBuffer, a->buffer, a->length * sizeof(void*));
+
+		a->buffer = newBuffer;
+		a->capacity = capacity;
+		a->inlined = 0;
+		return 1;
+	}
+
+#if defined(__linux__)
+	if (numbytes >= ARRAYLIST_MMAP_THRESHOLD) {
+		size_t mapbytes = (numbytes + ARRAYLIST_MMAP_ALIGN - 1) & ~(ARRAYLIST_MMAP_ALIGN - 1);
+		void* newBuffer = NULL;
+		if (a->mapped) {
+			// kernel moves the pages, elements are not copied
+			newBuffer = mremap(a->buffer, a->capacity * sizeof(void*), mapbytes, MREMAP_MAYMOVE);
+			if (newBuffer == MAP_FAILED)
+				return 0;
+		}
+		else {
+			newBuffer = mmap(NULL, mapbytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (newBuffer == MAP_FAILED)
+				return 0;
+
+			memcpy(newBuffer, a->buffer, a->length * sizeof(void*));
+			if (!a->inlined)
+				free(a->buffer);
 		}
 
+	#if defined(MADV_HUGEPAGE)
+		madvise(newBuffer, mapbytes, MADV_HUGEPAGE);	// only a hint
+	#endif
+
+		a->buffer = newBuffer;
+		a->capacity = mapbytes / sizeof(void*);
+		a->mapped = 1;
+		a->inlined = 0;
+		return 1;
+	}
+
+	if (a->mapped) {
+		// back to the heap
+		void** newBuffer = malloc(numbytes);
+		if (newBuffer == NULL)
+			return 0;
+
+		memcpy(newBuffer, a->buffer, a->length * sizeof(void*));
+		munmap(a->buffer, a->capacity * sizeof(void*));
+		a->buffer = newBuffer;
+		a->capacity = capacity;
+		a->mapped = 0;
+		return 1;
+	}
+#endif
+
+	if (a->inlined) {
+		// leave the inline buffer (it stays unused in the list block)
+		void** newBuffer = malloc(numbytes);
+		if (newBuffer == NULL)
+			return 0;
+
+		memcpy(newBuffer, a->buffer, a->length * sizeof(void*));
 		a->buffer = newBuffer;
-		a->capacity = numel;
+		a->capacity = capacity;
+		a->inlined = 0;
+		return 1;
 	}
 
+	void* newBuffer = realloc(a->buffer, numbytes);
+	if (newBuffer == NULL)
+	{
+		// fail to reallocate memory
+		return 0;
+	}
+
+	a->buffer = newBuffer;
+	a->capacity = capacity;
 	return 1;
 }
 
+/*
+ * Makes room for at least 'capacity' elements (one allocation for many appends).
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int arraylist_reserve(struct arraylist* a, size_t capacity) {
+	if (capacity <= a->capacity)
+		return 1;
+
+	return arraylist_resize_buffer(a, capacity);
+}
+
+/*
+ * Allocates buffer memory if necessary to insert 'count' elements, growing by the
+ * load factor (or to the needed size if larger).
+ * Note: Private function.
+ * */
+int arraylist_allocate_mem_if_needed(struct arraylist* a, size_t count) {
+	if (count > SIZE_MAX - a->length)
+		return 0;
+
+	size_t needed = a->length + count;
+	if (needed <= a->capacity)
+		return 1;
+
+	double grown = ARRAYLIST_DEFAULT_LOADFACTOR * (double)a->capacity;
+	size_t numel = (grown < (double)(SIZE_MAX / sizeof(void*))) ? (size_t)grown : SIZE_MAX / sizeof(void*);
+	if (numel < needed)
+		numel = needed;
+
+	return arraylist_resize_buffer(a, numel);
+}
+
 /*
  * Appends an element to the end of the list.
  * param a: pointer to arraylist
  * param x: pointer to element.
  * */
 int arraylist_add(struct arraylist* a, void* x) {
-	if (arraylist_allocate_mem_if_needed_for_insertion(a)) {
+	if (arraylist_allocate_mem_if_needed(a, 1)) {
 		// add element at end
 		a->buffer[a->length++] = x;
 		return 1;
@@ -92,27 +282,42 @@ int arraylist_add(struct arraylist* a, void* x) {
 	return 0;
 }
 
+/*
+ * Appends 'n' elements of array 'src' to the end of the list, with at most one
+ * reallocation and one copy.
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int arraylist_add_all(struct arraylist* a, void** src, size_t n) {
+	if (n == 0)
+		return 1;
+
+	if (!arraylist_allocate_mem_if_needed(a, n))
+		return 0;
+
+	memcpy(a->buffer + a->length, src, n * sizeof(void*));
+	a->length += n;
+	return 1;
+}
+
 /*
  * Inserts an elements in the arraylist at given position.
  * Returns 1 if succeeded, 0 otherwise.
  * */
-int arraylist_insert(struct arraylist* a, unsigned int index, void* x) {
+int arraylist_insert(struct arraylist* a, size_t index, void* x) {
 	int result = 0;
-	unsigned int len = a->length;
-	if (index < 0 || index > len)
+	size_t len = a->length;
+	if (index > len)
 		return 0;
 
 	if (index == len) {
 		result = arraylist_add(a, x);	// insert at end
 	}
 	else {
-		if (arraylist_allocate_mem_if_needed_for_insertion(a)) {
+		if (arraylist_allocate_mem_if_needed(a, 1)) {
 			void** buffer = a->buffer;
 
 			// move after index elements one position forward
-			for(int i = len; i == index; --i) {
-				buffer[i] = buffer[i-1];
-			}
+			memmove(buffer + index + 1, buffer + index, (len - index) * sizeof(void*));
 
 			// insert x at index
 			*(index + buffer) = x;
@@ -132,42 +337,31 @@ int arraylist_insert(struct arraylist* a, unsigned int index, void* x) {
  * Returns the removed element if succeeded, NULL otherwise.
  * */
 void* arraylist_remove(struct arraylist* a, void* el) {
-	void* result = NULL;
-	unsigned int len = a->length;
+	size_t len = a->length;
 	void** buffer = a->buffer;
-	for(int i = 0; i < len; ++i) {
-		if (*(i + buffer) == el) {
-			result = el;
-			// move elements after current position one position
-			// back
-			for (int j = i+1; j < len; ++j)
-				*((j-1) + buffer) = *(j + buffer);
-
-			// decrement length
-			a->length--;
-			return result;
-		}
+	for(size_t i = 0; i < len; ++i) {
+		if (*(i + buffer) == el)
+			return arraylist_remove_at(a, i);
 	}
 
-	return result;
+	return NULL;
 }
 
 /*
  * Removes a given element at given position.
  * Returns the removed element if succeeded, NULL otherwise.
  * */
-void* arraylist_remove_at(struct arraylist* a, uint index) {
+void* arraylist_remove_at(struct arraylist* a, size_t index) {
 	void* result = NULL;
-	uint len = a->length;
+	size_t len = a->length;
 	if (index >= len)
 		return NULL;
 	else {
 		void** buffer = a->buffer;
-		result = arraylist_get_item_at(a, index);
+		result = buffer[index];
 		// move elements after current position one position
 		// back
-		for (int j = index+1; j < len; ++j)
-			*((j-1) + buffer) = *(j + buffer);
+		memmove(buffer + index, buffer + index + 1, (len - index - 1) * sizeof(void*));
 
 		// decrement length
 		a->length--;
@@ -181,20 +375,326 @@ void* arraylist_remove_at(struct arraylist* a, uint index) {
  * Returns 1 if succeeded, 0 otherwise.
  * */
 int arraylist_shrink_to_fit(struct arraylist* a) {
-	int result = 1;
-	void** buffer = a->buffer;
 	if (a->length < a->capacity)
-	{
-		void** newbuffer = realloc(buffer, sizeof(void*) * a->length);
-		if (newbuffer != NULL) {
-			a->buffer = newbuffer;
-			a->capacity = a->length;
+		return arraylist_resize_buffer(a, a->length);
+
+	return 1;
+}
+
+/*
+ * Sorts a small array by insertion.
+ * */
+void arraylist_insertion_sort(void** v, size_t n, arraylist_compare compare) {
+	for (size_t i = 1; i < n; ++i) {
+		void* x = v[i];
+		size_t j = i;
+		while (j > 0 && compare(v[j - 1], x) > 0) {
+			v[j] = v[j - 1];
+			j--;
+		}
+
+		v[j] = x;
+	}
+}
+
+/*
+ * Sorts an array by heapsort (introsort fallback when quicksort goes too deep).
+ * */
+void arraylist_heap_sort(void** v, size_t n, arraylist_compare compare) {
+	for (size_t end = n, start = n / 2; end > 1; ) {
+		size_t root;
+		if (start > 0)
+			root = --start;			// build heap
+		else {
+			void* top = v[0];		// move maximum to the end
+			v[0] = v[--end];
+			v[end] = top;
+			root = 0;
+		}
+
+		// sift down as a hole
+		void* x = v[root];
+		size_t child;
+		while ((child = 2 * root + 1) < end) {
+			if (child + 1 < end && compare(v[child + 1], v[child]) > 0)
+				child++;
+			if (compare(v[child], x) <= 0)
+				break;
+
+			v[root] = v[child];
+			root = child;
+		}
+
+		v[root] = x;
+	}
+}
+
+/*
+ * Introsort of an array with recursion depth limit 'depth'.
+ * */
+void arraylist_introsort(void** v, size_t n, arraylist_compare compare, int depth) {
+	while (n > ARRAYLIST_INSERTION_SORT_MAX) {
+		if (depth-- == 0) {
+			arraylist_heap_sort(v, n, compare);
+			return;
+		}
+
+		// median of three, first and last elements become sentinels
+		size_t mid = n / 2;
+		void* t;
+		if (compare(v[mid], v[0]) < 0) { t = v[mid]; v[mid] = v[0]; v[0] = t; }
+		if (compare(v[n - 1], v[mid]) < 0) { t = v[n - 1]; v[n - 1] = v[mid]; v[mid] = t; }
+		if (compare(v[mid], v[0]) < 0) { t = v[mid]; v[mid] = v[0]; v[0] = t; }
+
+		// Hoare partition: [0, j] <= pivot <= [j + 1, n)
+		void* pivot = v[mid];
+		size_t i = 0, j = n - 1;
+		for (;;) {
+			while (compare(v[i], pivot) < 0) i++;
+			while (compare(v[j], pivot) > 0) j--;
+			if (i >= j)
+				break;
+
+			t = v[i]; v[i] = v[j]; v[j] = t;
+			i++;
+			j--;
+		}
+
+		size_t left = j + 1;
+		if (left < n - left) {
+			arraylist_introsort(v, left, compare, depth);
+			v += left;
+			n -= left;
+		}
+		else {
+			arraylist_introsort(v + left, n - left, compare, depth);
+			n = left;
+		}
+	}
+
+	arraylist_insertion_sort(v, n, compare);
+}
+
+/*
+ * Sorts an array in ascending order (introsort).
+ * */
+void arraylist_sort_array(void** v, size_t n, arraylist_compare compare) {
+	int depth = 0;
+	for (size_t m = n; m > 1; m >>= 1)
+		depth += 2;
+
+	arraylist_introsort(v, n, compare, depth);
+}
+
+/*
+ * Sorts the list in ascending order (introsort, not stable), in O(n log n).
+ * */
+void arraylist_sort(struct arraylist* a, arraylist_compare compare) {
+	arraylist_sort_array(a->buffer, a->length, compare);
+}
+
+/*
+ * Gets how many elements of sorted 'x' (size m) come before output position 'k' of
+ * the merge of 'x' and 'y' (size n), elements of 'x' first when equal.
+ * */
+size_t arraylist_corank(size_t k, void** x, size_t m, void** y, size_t n,
+						arraylist_compare compare) {
+	size_t i = (k < m) ? k : m;
+	size_t j = k - i;
+	size_t ilow = (k > n) ? k - n : 0;
+	size_t jlow = (k > m) ? k - m : 0;
+	for (;;) {
+		if (i > 0 && j < n && compare(x[i - 1], y[j]) > 0) {
+			size_t d = (i - ilow + 1) / 2;		// too many of 'x'
+			jlow = j;
+			i -= d;
+			j += d;
+		}
+		else if (j > 0 && i < m && compare(y[j - 1], x[i]) >= 0) {
+			size_t d = (j - jlow + 1) / 2;		// too many of 'y'
+			ilow = i;
+			i += d;
+			j -= d;
 		}
 		else
-			result = 0;
+			return i;
 	}
+}
 
-	return result;
+/*
+ * Merges sorted 'x' (size m) and 'y' (size n) into 'out'.
+ * */
+void arraylist_merge(void** x, size_t m, void** y, size_t n, void** out,
+					 arraylist_compare compare) {
+	size_t i = 0, j = 0, k = 0;
+	while (i < m && j < n)
+		out[k++] = (compare(x[i], y[j]) <= 0) ? x[i++] : y[j++];
+
+	memcpy(out + k, x + i, (m - i) * sizeof(void*));
+	memcpy(out + k + m - i, y + j, (n - j) * sizeof(void*));
+}
+
+/*
+ * Parallel sort worker: sorts its chunk, then does its share of each merge round.
+ * */
+void* arraylist_sort_run(void* arg) {
+	struct arraylist_sort_worker* wk = (struct arraylist_sort_worker*)arg;
+	struct arraylist_sort_state* st = wk->st;
+	size_t* bounds = st->bounds;
+	int p = st->nthreads;
+
+	arraylist_sort_array(st->src + bounds[wk->tid], bounds[wk->tid + 1] - bounds[wk->tid],
+						 st->compare);
+	pthread_barrier_wait(&(st->barrier));
+
+	void** from = st->src;
+	void** to = st->tmp;
+	for (int w = 1; w < p; w *= 2) {
+		// pairs of runs of 'w' chunks, 't' threads per pair
+		int npairs = (p + 2 * w - 1) / (2 * w);
+		int t = (p / npairs > 0) ? p / npairs : 1;
+		for (int task = wk->tid; task < npairs * t; task += p) {
+			int pair = task / t, seg = task % t;
+			int c0 = 2 * pair * w;
+			int c1 = (c0 + w < p) ? c0 + w : p;
+			int c2 = (c0 + 2 * w < p) ? c0 + 2 * w : p;
+			size_t lo = bounds[c0], mid = bounds[c1], hi = bounds[c2];
+			size_t k0 = (hi - lo) * seg / t, k1 = (hi - lo) * (seg + 1) / t;
+			if (c1 == c2) {
+				// run without partner, copied
+				memcpy(to + lo + k0, from + lo + k0, (k1 - k0) * sizeof(void*));
+				continue;
+			}
+
+			void** x = from + lo;
+			void** y = from + mid;
+			size_t m = mid - lo, n = hi - mid;
+			size_t i0 = arraylist_corank(k0, x, m, y, n, st->compare);
+			size_t i1 = arraylist_corank(k1, x, m, y, n, st->compare);
+			arraylist_merge(x + i0, i1 - i0, y + (k0 - i0), (k1 - i1) - (k0 - i0), to + lo + k0,
+							st->compare);
+		}
+
+		pthread_barrier_wait(&(st->barrier));
+		void** swap = from;
+		from = to;
+		to = swap;
+	}
+
+	// result in merge buffer: copy own chunk back
+	if (from != st->src)
+		memcpy(st->src + bounds[wk->tid], from + bounds[wk->tid],
+			   (bounds[wk->tid + 1] - bounds[wk->tid]) * sizeof(void*));
+
+	return NULL;
+}
+
+/*
+ * Sorts the list in ascending order with 'nthreads' threads (< 1: one per online
+ * processor), parallel sort of chunks followed by parallel merges (not stable).
+ * Threads are limited to one per ARRAYLIST_PARALLEL_SORT_MIN elements (a single
+ * thread sorts in place). Falls back to arraylist_sort if there is no memory for the
+ * merge buffer.
+ * */
+void arraylist_sort_parallel(struct arraylist* a, arraylist_compare compare, int nthreads) {
+	size_t n = a->length;
+	if (nthreads < 1) {
+		long cores = sysconf(_SC_NPROCESSORS_ONLN);
+		nthreads = (cores > 0) ? (int)cores : 1;
+	}
+
+	if ((size_t)nthreads > n / ARRAYLIST_PARALLEL_SORT_MIN)
+		nthreads = (int)(n / ARRAYLIST_PARALLEL_SORT_MIN);
+
+	struct arraylist_sort_state st;
+	st.tmp = (nthreads > 1) ? allocator_alloc(a->allocator, n * sizeof(void*)) : NULL;
+	if (st.tmp == NULL) {
+		arraylist_sort(a, compare);
+		return;
+	}
+
+	st.src = a->buffer;
+	st.nthreads = nthreads;
+	st.compare = compare;
+	st.bounds = (size_t*)malloc((nthreads + 1) * sizeof(size_t));
+	struct arraylist_sort_worker* workers = malloc(nthreads * sizeof(*workers));
+	if (!st.bounds || !workers) {
+		printf("Memory error: failed to allocate parallel sort workers!");
+		abort();
+	}
+
+	for (int i = 0; i <= nthreads; ++i)
+		st.bounds[i] = n * i / nthreads;
+
+	if (pthread_barrier_init(&(st.barrier), NULL, nthreads) != 0) {
+		printf("Error: failed to initialize parallel sort barrier!");
+		abort();
+	}
+
+	for (int i = 0; i < nthreads; ++i) {
+		workers[i].st = &st;
+		workers[i].tid = i;
+		if (i > 0 && pthread_create(&(workers[i].thread), NULL, arraylist_sort_run, &(workers[i])) != 0) {
+			printf("Error: failed to create parallel sort thread!");
+			abort();
+		}
+	}
+
+	arraylist_sort_run(&(workers[0]));	// calling thread is worker 0
+
+	for (int i = 1; i < nthreads; ++i)
+		pthread_join(workers[i].thread, NULL);
+
+	pthread_barrier_destroy(&(st.barrier));
+	free(workers);
+	free(st.bounds);
+	allocator_free(a->allocator, st.tmp, n * sizeof(void*));
+}
+
+/*
+ * Gets the position of the first element of a sorted array not lesser than 'key'
+ * (greater than 'key' if 'upper').
+ * */
+size_t arraylist_bound(void** v, size_t n, const void* key, arraylist_compare compare,
+					   int upper) {
+	size_t lo = 0, hi = n;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		int cmp = compare(v[mid], key);
+		if (cmp < 0 || (upper && cmp == 0))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/*
+ * Inserts an element in a sorted list keeping it sorted (after equal elements),
+ * in O(log n) compares and one move of the next elements.
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int arraylist_insert_sorted(struct arraylist* a, void* x, arraylist_compare compare) {
+	return arraylist_insert(a, arraylist_bound(a->buffer, a->length, x, compare, 1), x);
+}
+
+/*
+ * Searches an element equal to 'key' in a sorted list, in O(log n).
+ * If 'index' is defined it receives the position of the first element not lesser
+ * than 'key' (where 'key' would be inserted).
+ * Returns the first equal element, NULL if there is none.
+ * */
+void* arraylist_find_sorted(const struct arraylist* a, const void* key,
+							arraylist_compare compare, size_t* index) {
+	size_t pos = arraylist_bound(a->buffer, a->length, key, compare, 0);
+	if (index)
+		*index = pos;
+
+	if (pos < a->length && compare(a->buffer[pos], key) == 0)
+		return a->buffer[pos];
+
+	return NULL;
 }
 
 /*
@@ -202,10 +702,22 @@ int arraylist_shrink_to_fit(struct arraylist* a) {
  * */
 void arraylist_destroy(struct arraylist* a) {
 	void** buffer = a->buffer;
+	if (a->allocator != NULL) {
+		if (!a->inlined)
+			allocator_free(a->allocator, buffer, a->capacity * sizeof(void*));
+
+		allocator_free(a->allocator, a, ARRAYLIST_ALLOCATOR_BLOCK);
+		return;
+	}
+
 	// free memory from buffer pointers
-	free(buffer);
+#if defined(__linux__)
+	if (a->mapped)
+		munmap(buffer, a->capacity * sizeof(void*));
+	else
+#endif
+	if (!a->inlined)
+		free(buffer);
 	// free arraylist struct
 	free(a);
 }
-
-
@@ -6,13 +6,52 @@
  *
  * 	Implementation of a generic array list in C.
  *
+ * 	Growth policy
+ *
+ * 	When full the buffer grows by ARRAYLIST_DEFAULT_LOADFACTOR (or to the requested size
+ * 	if larger), so n appends cost O(n) copies in total. arraylist_reserve and
+ * 	arraylist_add_all allocate once for a known number of elements. Sizes are size_t,
+ * 	a list can hold more than 4G elements.
+ *
+ * 	On Linux a buffer of ARRAYLIST_MMAP_THRESHOLD bytes or more is moved to an anonymous
+ * 	mapping (rounded to 2 MiB and advised for transparent huge pages). Later growth is
+ * 	done with mremap, which moves page table entries instead of copying the elements.
+ *
+ * 	A list created with up to ARRAYLIST_INLINE_CAPACITY elements of capacity keeps its
+ * 	buffer in the same allocation as the structure (one malloc and one free for short
+ * 	lived lists); the buffer moves to the heap the first time the list grows.
+ *
+ * 	A list created with arraylist_create_allocator takes the structure and the buffer
+ * 	from that allocator (see allocator.h) and never uses mappings: the allocator decides
+ * 	where the memory comes from (huge pages, NUMA node, region).
+ * 	For many inserts and removes at nearby positions in the middle see gaplist.h.
+ *
+ * 	Sorting
+ *
+ * 	arraylist_sort is an introsort: quicksort (median of three pivot, Hoare partition,
+ * 	loop on the larger part), insertion sort for small parts and heapsort when the
+ * 	depth passes 2 log n, so the worst case is O(n log n). arraylist_sort_parallel
+ * 	sorts one chunk per thread and merges the runs in log(threads) rounds; in every
+ * 	round each merge is split between several threads at balanced output positions
+ * 	(co-ranking by binary search), so the last merge uses every thread too.
+ * 	List element types with a compare known at compile time can use the inlined
+ * 	sort of typedcontainers.h (DEFINE_ARRAYLIST_SORT).
+ *
  */
 
 #ifndef ARRAYLIST_H_
 	#define ARRAYLIST_H_
 
+	#include <stddef.h>
+	#include "allocator.h"
+
 	#define ARRAYLIST_DEFAULT_CAPACITY  20
 	#define ARRAYLIST_DEFAULT_LOADFACTOR 2.0
+	#define ARRAYLIST_MMAP_THRESHOLD ((size_t)32 << 20)	// buffer bytes to use mremap growth
+	#define ARRAYLIST_MMAP_ALIGN ((size_t)2 << 20)		// mapping size unit (huge page)
+	#define ARRAYLIST_INLINE_CAPACITY 32				// lists up to this capacity use one allocation
+	#define ARRAYLIST_INSERTION_SORT_MAX 16				// parts sorted by insertion sort
+	#define ARRAYLIST_PARALLEL_SORT_MIN ((size_t)1 << 16)	// elements per thread of parallel sort
 
 	/*
 	 * Declares arraylist structure
@@ -21,14 +60,26 @@
 	struct arraylist {
 		//unsigned int el_size;
 		void** buffer;
-		unsigned int capacity;
-		unsigned int length;
+		size_t capacity;
+		size_t length;
+		int mapped;			// 1 if buffer is an anonymous mapping (see ARRAYLIST_MMAP_THRESHOLD)
+		int inlined;		// 1 if buffer is in the list block (see ARRAYLIST_INLINE_CAPACITY)
+		const struct allocator* allocator;	// allocator of structure and buffer (NULL: C library)
 	};
 
+	// function to compare two elements, returns a negative, zero or positive int
+	typedef int (*arraylist_compare)(const void* a, const void* b);
+
 	/*
 	 * Creates and initializes an arraylist structure with a given capacity.
 	 * */
-	struct arraylist* arraylist_create_capacity(unsigned int capacity);
+	struct arraylist* arraylist_create_capacity(size_t capacity);
+
+	/*
+	 * Creates and initializes an arraylist structure whose structure and buffer are
+	 * allocated by 'allocator' (see allocator.h, NULL: C library).
+	 * */
+	struct arraylist* arraylist_create_allocator(size_t capacity, const struct allocator* allocator);
 
 	/*
 	 * Creates and initializes an arraylist structure.
@@ -39,7 +90,7 @@
 	 * Gets the pointer to element located at index position in the
 	 * arraylist buffer array.
 	 * */
-	void* arraylist_get_item_at(const struct arraylist* a, unsigned int index);
+	void* arraylist_get_item_at(const struct arraylist* a, size_t index);
 
 	/*
 	 * Appends an element to the end of the list.
@@ -48,11 +99,24 @@
 	 * */
 	int arraylist_add(struct arraylist* a, void* x);
 
+	/*
+	 * Makes room for at least 'capacity' elements (one allocation for many appends).
+	 * Returns 1 if succeeded, 0 otherwise.
+	 * */
+	int arraylist_reserve(struct arraylist* a, size_t capacity);
+
+	/*
+	 * Appends 'n' elements of array 'src' to the end of the list, with at most one
+	 * reallocation and one copy.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 * */
+	int arraylist_add_all(struct arraylist* a, void** src, size_t n);
+
 	/*
 	 * Inserts an elements in the arraylist at given position.
 	 * Returns 1 if succeeded, 0 otherwise.
 	 * */
-	int arraylist_insert(struct arraylist* a, unsigned int index, void* x);
+	int arraylist_insert(struct arraylist* a, size_t index, void* x);
 
 	/*
 	 * Removes a given element from the list.
@@ -64,7 +128,7 @@
 	 * Removes a given element at given position.
 	 * Returns the removed element if succeeded, NULL otherwise.
 	 * */
-	void* arraylist_remove_at(struct arraylist* a, unsigned int index);
+	void* arraylist_remove_at(struct arraylist* a, size_t index);
 
 	/*
 	 * Reduces size of list and releases memory to fit only current data.
@@ -73,9 +137,37 @@
 	int arraylist_shrink_to_fit(struct arraylist* a);
 
 	/*
-	 * Reduces size of list and releases memory to fit only current data.
+	 * Sorts the list in ascending order (introsort, not stable), in O(n log n).
+	 * */
+	void arraylist_sort(struct arraylist* a, arraylist_compare compare);
+
+	/*
+	 * Sorts the list in ascending order with 'nthreads' threads (< 1: one per online
+	 * processor), parallel sort of chunks followed by parallel merges (not stable).
+	 * Threads are limited to one per ARRAYLIST_PARALLEL_SORT_MIN elements (a single
+	 * thread sorts in place). Falls back to arraylist_sort if there is no memory for the merge buffer.
+	 * */
+	void arraylist_sort_parallel(struct arraylist* a, arraylist_compare compare, int nthreads);
+
+	/*
+	 * Inserts an element in a sorted list keeping it sorted (after equal elements),
+	 * in O(log n) compares and one move of the next elements.
 	 * Returns 1 if succeeded, 0 otherwise.
 	 * */
+	int arraylist_insert_sorted(struct arraylist* a, void* x, arraylist_compare compare);
+
+	/*
+	 * Searches an element equal to 'key' in a sorted list, in O(log n).
+	 * If 'index' is defined it receives the position of the first element not lesser
+	 * than 'key' (where 'key' would be inserted).
+	 * Returns the first equal element, NULL if there is none.
+	 * */
+	void* arraylist_find_sorted(const struct arraylist* a, const void* key,
+								arraylist_compare compare, size_t* index);
+
+	/*
+	 * Releases all memory from an arraylist (includes buffer)
+	 * */
 	void arraylist_destroy(struct arraylist* a);
 
 
@@ -0,0 +1,1048 @@
+/*
+ * art.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of an adaptive radix tree (ART).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "art.h"
+
+#if defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
+
+#define ART_ISLEAF(p) (((uintptr_t)(p)) & 1)
+#define ART_LEAF(p) ((struct artleaf*)((uintptr_t)(p) & ~(uintptr_t)1))
+#define ART_TAGLEAF(l) ((void*)((uintptr_t)(l) | 1))
+#define ART_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/*
+ * Creates a new empty adaptive radix tree.
+ * Returns pointer to created tree instance.
+ */
+struct art* art_create( art_printdata printdatafunc, art_freedata freedatafunc )
+{
+	struct art* result = (struct art*)malloc(sizeof(*result));
+	if (result == NULL) {
+		printf("Memory error allocating adaptive radix tree structure instance.");
+		abort();
+	}
+
+	result->root = NULL;
+	result->size = 0;
+	result->printdata = printdatafunc;
+	result->freedata = freedatafunc;
+	return result;
+}
+
+/*
+ * Returns the number of keys in the tree.
+ */
+size_t art_getsize( const struct art* t ) {
+	return t->size;
+}
+
+/*
+ * Encodes an unsigned integer as an 8 bytes big endian key (keeps numeric order).
+ */
+void art_encode_u64( uint64_t value, unsigned char* key )
+{
+	for (int i = 7; i >= 0; i--) {
+		key[i] = (unsigned char)value;
+		value >>= 8;
+	}
+}
+
+/*
+ * Creates a leaf with a copy of a key.
+ */
+struct artleaf* art_create_leaf( const unsigned char* key, size_t keylen, void* value )
+{
+	struct artleaf* l = (struct artleaf*)malloc(sizeof(*l) + keylen);
+	if (l == NULL) {
+		printf("Memory error allocating adaptive radix tree leaf.");
+		abort();
+	}
+
+	l->value = value;
+	l->keylen = (uint32_t)keylen;
+	if (keylen > 0)
+		memcpy(l->key, key, keylen);
+
+	return l;
+}
+
+/*
+ * Checks if a leaf has a given key.
+ */
+int art_leaf_matches( const struct artleaf* l, const unsigned char* key, size_t keylen ) {
+	return l->keylen == keylen && memcmp(l->key, key, keylen) == 0;
+}
+
+/*
+ * Compares two keys (unsigned bytes, shorter key first on a tie).
+ */
+int art_key_compare( const unsigned char* a, size_t alen, const unsigned char* b, size_t blen )
+{
+	int cmp = memcmp(a, b, ART_MIN(alen, blen));
+	if (cmp != 0)
+		return cmp;
+
+	return (alen > blen) - (alen < blen);
+}
+
+/*
+ * Allocates an inner node of a given type with no children.
+ */
+struct artnode* art_alloc_node( art_nodetype type )
+{
+	size_t size = 0;
+	switch (type) {
+		case ART_NODE4: size = sizeof(struct artnode4); break;
+		case ART_NODE16: size = sizeof(struct artnode16); break;
+		case ART_NODE48: size = sizeof(struct artnode48); break;
+		case ART_NODE256: size = sizeof(struct artnode256); break;
+	}
+
+	struct artnode* n = (struct artnode*)calloc(1, size);
+	if (n == NULL) {
+		printf("Memory error allocating adaptive radix tree node.");
+		abort();
+	}
+
+	n->type = type;
+	return n;
+}
+
+/*
+ * Copies header of a node to a node of other type.
+ */
+void art_copy_header( struct artnode* dest, const struct artnode* src )
+{
+	dest->nchildren = src->nchildren;
+	dest->prefixlen = src->prefixlen;
+	memcpy(dest->prefix, src->prefix, ART_MIN(src->prefixlen, ART_MAX_PREFIX_LEN));
+	dest->value = src->value;
+}
+
+/*
+ * Finds the child of a node for a given byte.
+ * Returns pointer to the child slot, NULL if there is no child.
+ */
+void** art_findchild( struct artnode* n, unsigned char c )
+{
+	switch (n->type) {
+		case ART_NODE4: {
+			struct artnode4* a = (struct artnode4*)n;
+			for (int i = 0; i < n->nchildren; i++)
+				if (a->keys[i] == c)
+					return &a->children[i];
+			break;
+		}
+		case ART_NODE16: {
+			struct artnode16* a = (struct artnode16*)n;
+#if defined(__SSE2__)
+			// compare the 16 keys at once, mask off unused ones
+			__m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8((char)c),
+										 _mm_loadu_si128((const __m128i*)a->keys));
+			int bits = _mm_movemask_epi8(cmp) & ((1 << n->nchildren) - 1);
+			if (bits)
+				return &a->children[__builtin_ctz(bits)];
+#else
+			for (int i = 0; i < n->nchildren; i++)
+				if (a->keys[i] == c)
+					return &a->children[i];
+#endif
+			break;
+		}
+		case ART_NODE48: {
+			struct artnode48* a = (struct artnode48*)n;
+			if (a->index[c])
+				return &a->children[a->index[c] - 1];
+			break;
+		}
+		case ART_NODE256: {
+			struct artnode256* a = (struct artnode256*)n;
+			if (a->children[c])
+				return &a->children[c];
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Gets the first child of a node at or after position 'pos' (index in Node4/Node16,
+ * byte in Node48/Node256) and sets 'pos' to its position.
+ * Returns the child, NULL if there is none.
+ */
+void* art_child_at( const struct artnode* n, int* pos )
+{
+	switch (n->type) {
+		case ART_NODE4:
+			return (*pos < n->nchildren) ? ((const struct artnode4*)n)->children[*pos] : NULL;
+		case ART_NODE16:
+			return (*pos < n->nchildren) ? ((const struct artnode16*)n)->children[*pos] : NULL;
+		case ART_NODE48: {
+			const struct artnode48* a = (const struct artnode48*)n;
+			for (int b = *pos; b < 256; b++)
+				if (a->index[b]) {
+					*pos = b;
+					return a->children[a->index[b] - 1];
+				}
+			break;
+		}
+		case ART_NODE256: {
+			const struct artnode256* a = (const struct artnode256*)n;
+			for (int b = *pos; b < 256; b++)
+				if (a->children[b]) {
+					*pos = b;
+					return a->children[b];
+				}
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Gets the byte of the child at a position (see art_child_at).
+ */
+unsigned char art_key_at( const struct artnode* n, int pos )
+{
+	switch (n->type) {
+		case ART_NODE4: return ((const struct artnode4*)n)->keys[pos];
+		case ART_NODE16: return ((const struct artnode16*)n)->keys[pos];
+		default: return (unsigned char)pos;
+	}
+}
+
+/*
+ * Gets the first position of a node with a child byte greater than or equal to 'c'.
+ */
+int art_lower_pos( const struct artnode* n, unsigned char c )
+{
+	const unsigned char* keys = NULL;
+	switch (n->type) {
+		case ART_NODE4: keys = ((const struct artnode4*)n)->keys; break;
+		case ART_NODE16: keys = ((const struct artnode16*)n)->keys; break;
+		default: return c;
+	}
+
+	int i = 0;
+	while (i < n->nchildren && keys[i] < c)
+		i++;
+
+	return i;
+}
+
+/*
+ * Gets the leaf with the smallest key of a subtree (tagged leaf or inner node).
+ */
+struct artleaf* art_minimum_rec( const void* p )
+{
+	while (p != NULL && !ART_ISLEAF(p)) {
+		const struct artnode* n = (const struct artnode*)p;
+		if (n->value)
+			return n->value;
+
+		int pos = 0;
+		p = art_child_at(n, &pos);
+	}
+
+	return (p != NULL) ? ART_LEAF(p) : NULL;
+}
+
+/*
+ * Gets the leaf with the greatest key of a subtree (tagged leaf or inner node).
+ */
+struct artleaf* art_maximum_rec( const void* p )
+{
+	while (p != NULL && !ART_ISLEAF(p)) {
+		const struct artnode* n = (const struct artnode*)p;
+		if (n->nchildren == 0)
+			return n->value;
+
+		switch (n->type) {
+			case ART_NODE4: p = ((const struct artnode4*)n)->children[n->nchildren - 1]; break;
+			case ART_NODE16: p = ((const struct artnode16*)n)->children[n->nchildren - 1]; break;
+			case ART_NODE48: {
+				const struct artnode48* a = (const struct artnode48*)n;
+				int b = 255;
+				while (!a->index[b]) b--;
+				p = a->children[a->index[b] - 1];
+				break;
+			}
+			case ART_NODE256: {
+				const struct artnode256* a = (const struct artnode256*)n;
+				int b = 255;
+				while (!a->children[b]) b--;
+				p = a->children[b];
+				break;
+			}
+		}
+	}
+
+	return (p != NULL) ? ART_LEAF(p) : NULL;
+}
+
+/*
+ * Gets the leaf of the smallest/greatest key.
+ * Returns NULL if tree is empty.
+ */
+struct artleaf* art_minimum( const struct art* t ) {
+	return art_minimum_rec(t->root);
+}
+
+struct artleaf* art_maximum( const struct art* t ) {
+	return art_maximum_rec(t->root);
+}
+
+/*
+ * Gets the value of a key.
+ * Returns NULL if key is not in the tree.
+ */
+void* art_search( const struct art* t, const unsigned char* key, size_t keylen )
+{
+	void* p = t->root;
+	size_t depth = 0;
+	while (p != NULL) {
+		if (ART_ISLEAF(p)) {
+			struct artleaf* l = ART_LEAF(p);
+			return art_leaf_matches(l, key, keylen) ? l->value : NULL;
+		}
+
+		struct artnode* n = (struct artnode*)p;
+		if (n->prefixlen) {
+			// optimistic: only stored bytes are compared, leaf compare checks the rest
+			if (keylen - depth < n->prefixlen ||
+				memcmp(n->prefix, key + depth, ART_MIN(n->prefixlen, ART_MAX_PREFIX_LEN)) != 0)
+				return NULL;
+
+			depth += n->prefixlen;
+		}
+
+		if (depth == keylen)
+			return (n->value && art_leaf_matches(n->value, key, keylen)) ? n->value->value : NULL;
+
+		void** child = art_findchild(n, key[depth]);
+		p = child ? *child : NULL;
+		depth++;
+	}
+
+	return NULL;
+}
+
+/*
+ * Checks if the tree contains a given key.
+ */
+int art_contains( const struct art* t, const unsigned char* key, size_t keylen )
+{
+	void* p = t->root;
+	size_t depth = 0;
+	while (p != NULL) {
+		if (ART_ISLEAF(p))
+			return art_leaf_matches(ART_LEAF(p), key, keylen);
+
+		struct artnode* n = (struct artnode*)p;
+		if (n->prefixlen) {
+			if (keylen - depth < n->prefixlen ||
+				memcmp(n->prefix, key + depth, ART_MIN(n->prefixlen, ART_MAX_PREFIX_LEN)) != 0)
+				return 0;
+
+			depth += n->prefixlen;
+		}
+
+		if (depth == keylen)
+			return n->value && art_leaf_matches(n->value, key, keylen);
+
+		void** child = art_findchild(n, key[depth]);
+		p = child ? *child : NULL;
+		depth++;
+	}
+
+	return 0;
+}
+
+/*
+ * Adds a child to a node, growing it to the next node type if it is full
+ * ('ref' is updated with the new node).
+ */
+void art_addchild( void** ref, struct artnode* n, unsigned char c, void* child )
+{
+	switch (n->type) {
+		case ART_NODE4: {
+			struct artnode4* a = (struct artnode4*)n;
+			if (n->nchildren < 4) {
+				int i = art_lower_pos(n, c);
+				memmove(a->keys + i + 1, a->keys + i, n->nchildren - i);
+				memmove(a->children + i + 1, a->children + i, (n->nchildren - i) * sizeof(void*));
+				a->keys[i] = c;
+				a->children[i] = child;
+				n->nchildren++;
+			}
+			else {
+				struct artnode16* g = (struct artnode16*)art_alloc_node(ART_NODE16);
+				art_copy_header(&g->n, n);
+				memcpy(g->keys, a->keys, 4);
+				memcpy(g->children, a->children, 4 * sizeof(void*));
+				*ref = g;
+				free(a);
+				art_addchild(ref, &g->n, c, child);
+			}
+			break;
+		}
+		case ART_NODE16: {
+			struct artnode16* a = (struct artnode16*)n;
+			if (n->nchildren < 16) {
+				int i = art_lower_pos(n, c);
+				memmove(a->keys + i + 1, a->keys + i, n->nchildren - i);
+				memmove(a->children + i + 1, a->children + i, (n->nchildren - i) * sizeof(void*));
+				a->keys[i] = c;
+				a->children[i] = child;
+				n->nchildren++;
+			}
+			else {
+				struct artnode48* g = (struct artnode48*)art_alloc_node(ART_NODE48);
+				art_copy_header(&g->n, n);
+				for (int i = 0; i < 16; i++) {
+					g->index[a->keys[i]] = (unsigned char)(i + 1);
+					g->children[i] = a->children[i];
+				}
+				*ref = g;
+				free(a);
+				art_addchild(ref, &g->n, c, child);
+			}
+			break;
+		}
+		case ART_NODE48: {
+			struct artnode48* a = (struct artnode48*)n;
+			if (n->nchildren < 48) {
+				int pos = 0;
+				while (a->children[pos])
+					pos++;
+
+				a->children[pos] = child;
+				a->index[c] = (unsigned char)(pos + 1);
+				n->nchildren++;
+			}
+			else {
+				struct artnode256* g = (struct artnode256*)art_alloc_node(ART_NODE256);
+				art_copy_header(&g->n, n);
+				for (int b = 0; b < 256; b++)
+					if (a->index[b])
+						g->children[b] = a->children[a->index[b] - 1];
+				*ref = g;
+				free(a);
+				art_addchild(ref, &g->n, c, child);
+			}
+			break;
+		}
+		case ART_NODE256: {
+			struct artnode256* a = (struct artnode256*)n;
+			a->children[c] = child;
+			n->nchildren++;
+			break;
+		}
+	}
+}
+
+/*
+ * Replaces a Node4 left with a single entry (one child or the value) by that entry,
+ * merging compressed paths when the child is an inner node.
+ */
+void art_collapse( void** ref, struct artnode4* a )
+{
+	if (a->n.nchildren + (a->n.value != NULL) >= 2)
+		return;
+
+	if (a->n.nchildren == 0) {
+		*ref = a->n.value ? ART_TAGLEAF(a->n.value) : NULL;
+		free(a);
+		return;
+	}
+
+	void* child = a->children[0];
+	if (!ART_ISLEAF(child)) {
+		// path of child becomes: node path + child byte + child path
+		struct artnode* cn = (struct artnode*)child;
+		unsigned char buffer[ART_MAX_PREFIX_LEN];
+		size_t k = ART_MIN(a->n.prefixlen, ART_MAX_PREFIX_LEN);
+		memcpy(buffer, a->n.prefix, k);
+		if (k < ART_MAX_PREFIX_LEN)
+			buffer[k++] = a->keys[0];
+		if (k < ART_MAX_PREFIX_LEN) {
+			size_t m = ART_MIN(cn->prefixlen, ART_MAX_PREFIX_LEN - k);
+			memcpy(buffer + k, cn->prefix, m);
+			k += m;
+		}
+
+		cn->prefixlen += a->n.prefixlen + 1;
+		memcpy(cn->prefix, buffer, k);
+	}
+
+	*ref = child;
+	free(a);
+}
+
+/*
+ * Removes the child of a byte from a node, shrinking it to the previous node type when
+ * it has few children ('ref' is updated with the new node).
+ */
+void art_removechild( void** ref, struct artnode* n, unsigned char c )
+{
+	switch (n->type) {
+		case ART_NODE4: {
+			struct artnode4* a = (struct artnode4*)n;
+			int i = art_lower_pos(n, c);
+			memmove(a->keys + i, a->keys + i + 1, n->nchildren - i - 1);
+			memmove(a->children + i, a->children + i + 1, (n->nchildren - i - 1) * sizeof(void*));
+			n->nchildren--;
+			art_collapse(ref, a);
+			break;
+		}
+		case ART_NODE16: {
+			struct artnode16* a = (struct artnode16*)n;
+			int i = art_lower_pos(n, c);
+			memmove(a->keys + i, a->keys + i + 1, n->nchildren - i - 1);
+			memmove(a->children + i, a->children + i + 1, (n->nchildren - i - 1) * sizeof(void*));
+			n->nchildren--;
+			if (n->nchildren == 3) {
+				struct artnode4* s = (struct artnode4*)art_alloc_node(ART_NODE4);
+				art_copy_header(&s->n, n);
+				memcpy(s->keys, a->keys, 3);
+				memcpy(s->children, a->children, 3 * sizeof(void*));
+				*ref = s;
+				free(a);
+			}
+			break;
+		}
+		case ART_NODE48: {
+			struct artnode48* a = (struct artnode48*)n;
+			a->children[a->index[c] - 1] = NULL;
+			a->index[c] = 0;
+			n->nchildren--;
+			if (n->nchildren == 12) {
+				struct artnode16* s = (struct artnode16*)art_alloc_node(ART_NODE16);
+				art_copy_header(&s->n, n);
+				int i = 0;
+				for (int b = 0; b < 256; b++)
+					if (a->index[b]) {
+						s->keys[i] = (unsigned char)b;
+						s->children[i++] = a->children[a->index[b] - 1];
+					}
+				*ref = s;
+				free(a);
+			}
+			break;
+		}
+		case ART_NODE256: {
+			struct artnode256* a = (struct artnode256*)n;
+			a->children[c] = NULL;
+			n->nchildren--;
+			if (n->nchildren == 37) {
+				struct artnode48* s = (struct artnode48*)art_alloc_node(ART_NODE48);
+				art_copy_header(&s->n, n);
+				int pos = 0;
+				for (int b = 0; b < 256; b++)
+					if (a->children[b]) {
+						s->children[pos] = a->children[b];
+						s->index[b] = (unsigned char)(++pos);
+					}
+				*ref = s;
+				free(a);
+			}
+			break;
+		}
+	}
+}
+
+/*
+ * Puts a leaf in a new node at depth 'depth': in the value slot if its key ends there,
+ * otherwise as child of its next byte.
+ */
+void art_place_leaf( void** ref, struct artnode* n, struct artleaf* l, size_t depth )
+{
+	if (l->keylen == depth)
+		n->value = l;
+	else
+		art_addchild(ref, n, l->key[depth], ART_TAGLEAF(l));
+}
+
+/*
+ * Gets the length of the common part of the compressed path of a node and a key (from
+ * 'depth'). Bytes not stored in the node are read from a leaf of its subtree.
+ */
+size_t art_prefix_mismatch( const struct artnode* n, const unsigned char* key, size_t keylen,
+							size_t depth )
+{
+	size_t maxcmp = ART_MIN(ART_MIN(n->prefixlen, ART_MAX_PREFIX_LEN), keylen - depth);
+	size_t i = 0;
+	for (; i < maxcmp; i++)
+		if (n->prefix[i] != key[depth + i])
+			return i;
+
+	if (n->prefixlen > ART_MAX_PREFIX_LEN) {
+		const struct artleaf* l = art_minimum_rec(n);
+		maxcmp = ART_MIN(ART_MIN(l->keylen, keylen) - depth, n->prefixlen);
+		for (; i < maxcmp; i++)
+			if (l->key[depth + i] != key[depth + i])
+				return i;
+	}
+
+	return i;
+}
+
+/*
+ * Inserts a key in the subtree at 'ref' (key bytes before 'depth' are already matched).
+ */
+void art_insert_rec( struct art* t, void** ref, const unsigned char* key, size_t keylen,
+					 size_t depth, void* value, void** old )
+{
+	void* p = *ref;
+	if (p == NULL) {
+		*ref = ART_TAGLEAF(art_create_leaf(key, keylen, value));
+		t->size++;
+		return;
+	}
+
+	if (ART_ISLEAF(p)) {
+		struct artleaf* l = ART_LEAF(p);
+		if (art_leaf_matches(l, key, keylen)) {
+			*old = l->value;
+			l->value = value;
+			return;
+		}
+
+		// new node with the common part of both keys as path
+		size_t maxcmp = ART_MIN(l->keylen, keylen) - depth;
+		size_t lcp = 0;
+		while (lcp < maxcmp && l->key[depth + lcp] == key[depth + lcp])
+			lcp++;
+
+		struct artnode* n = art_alloc_node(ART_NODE4);
+		n->prefixlen = (uint32_t)lcp;
+		memcpy(n->prefix, key + depth, ART_MIN(lcp, ART_MAX_PREFIX_LEN));
+		*ref = n;
+		art_place_leaf(ref, n, l, depth + lcp);
+		art_place_leaf(ref, n, art_create_leaf(key, keylen, value), depth + lcp);
+		t->size++;
+		return;
+	}
+
+	struct artnode* n = (struct artnode*)p;
+	if (n->prefixlen) {
+		size_t pm = art_prefix_mismatch(n, key, keylen, depth);
+		if (pm < n->prefixlen) {
+			// split path: new node with the common part, old node keeps the rest
+			struct artnode* s = art_alloc_node(ART_NODE4);
+			s->prefixlen = (uint32_t)pm;
+			memcpy(s->prefix, n->prefix, ART_MIN(pm, ART_MAX_PREFIX_LEN));
+
+			unsigned char c;
+			if (n->prefixlen <= ART_MAX_PREFIX_LEN) {
+				c = n->prefix[pm];
+				n->prefixlen -= pm + 1;
+				memmove(n->prefix, n->prefix + pm + 1, ART_MIN(n->prefixlen, ART_MAX_PREFIX_LEN));
+			}
+			else {
+				const struct artleaf* l = art_minimum_rec(n);
+				c = l->key[depth + pm];
+				n->prefixlen -= pm + 1;
+				memcpy(n->prefix, l->key + depth + pm + 1, ART_MIN(n->prefixlen, ART_MAX_PREFIX_LEN));
+			}
+
+			*ref = s;
+			art_addchild(ref, s, c, n);
+			art_place_leaf(ref, s, art_create_leaf(key, keylen, value), depth + pm);
+			t->size++;
+			return;
+		}
+
+		depth += n->prefixlen;
+	}
+
+	if (depth == keylen) {
+		if (n->value) {
+			*old = n->value->value;
+			n->value->value = value;
+		}
+		else {
+			n->value = art_create_leaf(key, keylen, value);
+			t->size++;
+		}
+		return;
+	}
+
+	void** child = art_findchild(n, key[depth]);
+	if (child) {
+		art_insert_rec(t, child, key, keylen, depth + 1, value, old);
+		return;
+	}
+
+	art_addchild(ref, n, key[depth], ART_TAGLEAF(art_create_leaf(key, keylen, value)));
+	t->size++;
+}
+
+/*
+ * Inserts a key with a value, the key bytes are copied.
+ * If key already exists its value is replaced.
+ * Returns the previous value of the key (to be released by the caller) or NULL.
+ */
+void* art_insert( struct art* t, const unsigned char* key, size_t keylen, void* value )
+{
+	void* old = NULL;
+	art_insert_rec(t, &t->root, key, keylen, 0, value, &old);
+	return old;
+}
+
+/*
+ * Removes a key from the inner node subtree at 'ref'.
+ * Returns the removed leaf, NULL if key is not in the subtree.
+ */
+struct artleaf* art_remove_rec( void** ref, const unsigned char* key, size_t keylen,
+								size_t depth )
+{
+	struct artnode* n = (struct artnode*)*ref;
+	if (n->prefixlen) {
+		if (keylen - depth < n->prefixlen ||
+			memcmp(n->prefix, key + depth, ART_MIN(n->prefixlen, ART_MAX_PREFIX_LEN)) != 0)
+			return NULL;
+
+		depth += n->prefixlen;
+	}
+
+	if (depth == keylen) {
+		struct artleaf* l = n->value;
+		if (l == NULL || !art_leaf_matches(l, key, keylen))
+			return NULL;
+
+		n->value = NULL;
+		if (n->type == ART_NODE4)
+			art_collapse(ref, (struct artnode4*)n);
+
+		return l;
+	}
+
+	void** child = art_findchild(n, key[depth]);
+	if (child == NULL)
+		return NULL;
+
+	if (ART_ISLEAF(*child)) {
+		struct artleaf* l = ART_LEAF(*child);
+		if (!art_leaf_matches(l, key, keylen))
+			return NULL;
+
+		art_removechild(ref, n, key[depth]);
+		return l;
+	}
+
+	return art_remove_rec(child, key, keylen, depth + 1);
+}
+
+/*
+ * Removes a key from the tree.
+ * Returns the value of removed key, NULL if key is not in the tree.
+ */
+void* art_remove( struct art* t, const unsigned char* key, size_t keylen )
+{
+	if (t->root == NULL)
+		return NULL;
+
+	struct artleaf* l = NULL;
+	if (ART_ISLEAF(t->root)) {
+		l = ART_LEAF(t->root);
+		if (!art_leaf_matches(l, key, keylen))
+			return NULL;
+
+		t->root = NULL;
+	}
+	else {
+		l = art_remove_rec(&t->root, key, keylen, 0);
+		if (l == NULL)
+			return NULL;
+	}
+
+	void* value = l->value;
+	free(l);
+	t->size--;
+	return value;
+}
+
+/*
+ * Pushes an inner node in the cursor stack (its value not visited yet).
+ */
+void art_iter_push( struct art_iter* it, struct artnode* n )
+{
+	if (it->depth == it->capacity) {
+		it->capacity *= 2;
+		it->stack = (struct art_iterframe*)realloc(it->stack, it->capacity * sizeof(struct art_iterframe));
+		if (it->stack == NULL) {
+			printf("Memory error allocating adaptive radix tree iterator stack.");
+			abort();
+		}
+	}
+
+	it->stack[it->depth].node = n;
+	it->stack[it->depth].pos = -1;
+	it->depth++;
+}
+
+/*
+ * Initializes an empty cursor.
+ */
+void art_iter_init( struct art* t, struct art_iter* it )
+{
+	it->t = t;
+	it->depth = 0;
+	it->capacity = 16;
+	it->current = NULL;
+	it->stack = (struct art_iterframe*)malloc(it->capacity * sizeof(struct art_iterframe));
+	if (it->stack == NULL) {
+		printf("Memory error allocating adaptive radix tree iterator stack.");
+		abort();
+	}
+}
+
+/*
+ * Moves cursor to the next key.
+ * Returns leaf at cursor, NULL if cursor moved past the end.
+ * */
+struct artleaf* art_iter_next( struct art_iter* it )
+{
+	while (it->depth > 0) {
+		struct art_iterframe* f = &it->stack[it->depth - 1];
+		struct artnode* n = f->node;
+		if (f->pos == -1) {
+			f->pos = 0;
+			if (n->value) {
+				it->current = n->value;		// shorter key first
+				return it->current;
+			}
+		}
+
+		void* child = art_child_at(n, &f->pos);
+		if (child == NULL) {
+			it->depth--;
+			continue;
+		}
+
+		f->pos++;
+		if (ART_ISLEAF(child)) {
+			it->current = ART_LEAF(child);
+			return it->current;
+		}
+
+		art_iter_push(it, (struct artnode*)child);
+	}
+
+	it->current = NULL;
+	return NULL;
+}
+
+/*
+ * Moves cursor to the smallest key of a subtree.
+ */
+struct artleaf* art_iter_descend( struct art_iter* it, void* p )
+{
+	if (ART_ISLEAF(p)) {
+		it->current = ART_LEAF(p);
+		return it->current;
+	}
+
+	art_iter_push(it, (struct artnode*)p);
+	return art_iter_next(it);
+}
+
+/*
+ * Positions cursor at the smallest key (art_iter_first) or at the smallest key
+ * greater than or equal to 'key' (art_iter_seek), in O(k).
+ * Returns leaf at cursor, NULL if there is none.
+ * */
+struct artleaf* art_iter_first( struct art* t, struct art_iter* it )
+{
+	art_iter_init(t, it);
+	return (t->root != NULL) ? art_iter_descend(it, t->root) : NULL;
+}
+
+struct artleaf* art_iter_seek( struct art* t, const unsigned char* key, size_t keylen,
+							   struct art_iter* it )
+{
+	art_iter_init(t, it);
+	void* p = t->root;
+	size_t depth = 0;
+
+	while (p != NULL) {
+		if (ART_ISLEAF(p)) {
+			struct artleaf* l = ART_LEAF(p);
+			if (art_key_compare(l->key, l->keylen, key, keylen) >= 0) {
+				it->current = l;
+				return l;
+			}
+
+			return art_iter_next(it);	// frames are already after this leaf
+		}
+
+		struct artnode* n = (struct artnode*)p;
+		if (n->prefixlen) {
+			const unsigned char* path = (n->prefixlen > ART_MAX_PREFIX_LEN)
+										? art_minimum_rec(n)->key + depth : n->prefix;
+			size_t rest = keylen - depth;
+			int cmp = memcmp(path, key + depth, ART_MIN(n->prefixlen, rest));
+			if (cmp < 0)
+				return art_iter_next(it);			// whole subtree is lesser than key
+			if (cmp > 0 || rest <= n->prefixlen)
+				return art_iter_descend(it, n);		// whole subtree is not lesser than key
+
+			depth += n->prefixlen;
+		}
+
+		if (depth == keylen)
+			return art_iter_descend(it, n);
+
+		// node value is a shorter key (lesser), continue with children from key byte
+		art_iter_push(it, n);
+		struct art_iterframe* f = &it->stack[it->depth - 1];
+		unsigned char c = key[depth];
+		int pos = art_lower_pos(n, c);
+		void* child = art_child_at(n, &pos);
+		if (child == NULL || art_key_at(n, pos) != c) {
+			f->pos = pos;
+			return art_iter_next(it);
+		}
+
+		f->pos = pos + 1;
+		p = child;
+		depth++;
+	}
+
+	return NULL;
+}
+
+/*
+ * Gets the leaf at cursor, NULL if there is none.
+ * */
+struct artleaf* art_iter_get( const struct art_iter* it ) {
+	return it->current;
+}
+
+/*
+ * Releases cursor stack.
+ * */
+void art_iter_release( struct art_iter* it )
+{
+	free(it->stack);
+	it->stack = NULL;
+	it->depth = it->capacity = 0;
+	it->current = NULL;
+}
+
+/*
+ * Visits in ascending order the keys that start with a given prefix, until 'visit'
+ * returns 0.
+ * Returns the number of visited keys.
+ */
+size_t art_prefix_scan( struct art* t, const unsigned char* prefix, size_t prefixlen,
+						art_visit visit, void* context )
+{
+	size_t count = 0;
+	struct art_iter it;
+	for (struct artleaf* l = art_iter_seek(t, prefix, prefixlen, &it); l != NULL;
+		 l = art_iter_next(&it)) {
+		if (l->keylen < prefixlen || memcmp(l->key, prefix, prefixlen) != 0)
+			break;
+
+		count++;
+		if (!visit(l->key, l->keylen, l->value, context))
+			break;
+	}
+
+	art_iter_release(&it);
+	return count;
+}
+
+/*
+ * Prints tree keys (non printable bytes as hex) and values in ascending order.
+ */
+void art_print( struct art* t )
+{
+	if (t->root == NULL) {
+		printf("The tree is empty\n");
+		return;
+	}
+
+	struct art_iter it;
+	for (struct artleaf* l = art_iter_first(t, &it); l != NULL; l = art_iter_next(&it)) {
+		printf("'");
+		for (uint32_t i = 0; i < l->keylen; i++) {
+			if (isprint(l->key[i]))
+				printf("%c", l->key[i]);
+			else
+				printf("\\x%02x", l->key[i]);
+		}
+
+		printf("'");
+		if (t->printdata) {
+			printf(" -> ");
+			t->printdata(l->value);
+		}
+
+		printf("\n");
+	}
+
+	art_iter_release(&it);
+}
+
+/*
+ * Releases a subtree (tagged leaf or inner node) from memory.
+ */
+void art_clear_rec( struct art* t, void* p )
+{
+	if (p == NULL)
+		return;
+
+	if (ART_ISLEAF(p)) {
+		struct artleaf* l = ART_LEAF(p);
+		if (t->freedata)
+			t->freedata(l->value);
+
+		free(l);
+		return;
+	}
+
+	struct artnode* n = (struct artnode*)p;
+	if (n->value)
+		art_clear_rec(t, ART_TAGLEAF(n->value));
+
+	int pos = 0;
+	for (void* child = art_child_at(n, &pos); child != NULL; pos++, child = art_child_at(n, &pos))
+		art_clear_rec(t, child);
+
+	free(n);
+}
+
+/*
+ * Removes all keys from the tree (values released with 'freedata' if defined).
+ */
+void art_clear( struct art* t )
+{
+	art_clear_rec(t, t->root);
+	t->root = NULL;
+	t->size = 0;
+}
+
+/*
+ * Releases the tree, its nodes and values (if 'freedata' is defined) from memory.
+ */
+void art_destroy( struct art* t )
+{
+	art_clear(t);
+	free(t);
+}
@@ -0,0 +1,237 @@
+/*****************************************************************************
+ * art.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for an adaptive radix tree (ART), an ordered map of binary keys.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  An adaptive radix tree is a trie over the bytes of the keys (fanout 256) whose inner
+ *  nodes change their layout with the number of children, so memory stays close to
+ *  what is used:
+ *
+ *  	- Node4:   up to 4 children, sorted key bytes and child pointers;
+ *  	- Node16:  up to 16 children, sorted key bytes searched with one SSE2 compare;
+ *  	- Node48:  256 byte index (child slot + 1 for every byte) and 48 child pointers;
+ *  	- Node256: 256 child pointers indexed by byte.
+ *
+ *  Nodes grow to the next type when full and shrink back when they lose children
+ *  (Node16 at 3, Node48 at 12, Node256 at 37 children, with some hysteresis).
+ *
+ *  Path compression: a node stores the bytes shared by all keys of its subtree (its
+ *  'prefix') instead of a chain of single child nodes. Only the first ART_MAX_PREFIX_LEN
+ *  bytes are kept in the node (optimistic compression), lookups skip the rest and the
+ *  leaf compare at the end checks the whole key. Inserts read the missing bytes from a
+ *  leaf of the subtree when they need them.
+ *
+ *  Leaves keep the whole key and the value. A child pointer with the lowest bit set is
+ *  a leaf. Keys can be any byte string (no terminator needed): a key that ends inside
+ *  the path of other keys is kept in the 'value' slot of the node where it ends, so it
+ *  is visited before the node children (shorter keys come first).
+ *
+ *  Iteration is in ascending order of keys (unsigned byte compare, as memcmp) with an
+ *  explicit stack of node positions. Integer keys must be stored big endian (see
+ *  art_encode_u64) to keep numeric order.
+ *
+ * 		  Time complexity by operation (k: key length)
+ *	-------------------------------------------------
+ * 	|	search, insert, remove		| O(k)			|
+ * 	|	iterator seek				| O(k)			|
+ * 	|	iterator next				| O(1) amortized|
+ *	-------------------------------------------------
+ *
+ *  Source: V. Leis, A. Kemper, T. Neumann, "The Adaptive Radix Tree: ARTful Indexing for
+ *  		 Main-Memory Databases", ICDE (2013).
+ *  		 https://github.com/armon/libart
+ *
+ *******************************************************************************/
+
+#ifndef ART_H_
+	#define ART_H_
+
+	#include <stdlib.h>
+	#include <stdint.h>
+
+	#define ART_MAX_PREFIX_LEN 10		// prefix bytes kept in a node
+
+	typedef void (*art_freedata)(void* data);
+	typedef void (*art_printdata)(void* data);
+
+	// visit function for prefix scans, returns 0 to stop the scan
+	typedef int (*art_visit)(const unsigned char* key, size_t keylen, void* value, void* context);
+
+	typedef enum {
+		ART_NODE4 = 1,
+		ART_NODE16 = 2,
+		ART_NODE48 = 3,
+		ART_NODE256 = 4
+	} art_nodetype;
+
+	// leaf (a key and its value)
+	struct artleaf {
+		void* value;
+		uint32_t keylen;
+		unsigned char key[];
+	};
+
+	// header of every inner node
+	struct artnode {
+		uint8_t type;							// art_nodetype
+		uint16_t nchildren;						// number of children
+		uint32_t prefixlen;						// length of compressed path
+		unsigned char prefix[ART_MAX_PREFIX_LEN];	// first bytes of compressed path
+		struct artleaf* value;					// key ending at this node (or NULL)
+	};
+
+	struct artnode4 {
+		struct artnode n;
+		unsigned char keys[4];
+		void* children[4];
+	};
+
+	struct artnode16 {
+		struct artnode n;
+		unsigned char keys[16];
+		void* children[16];
+	};
+
+	struct artnode48 {
+		struct artnode n;
+		unsigned char index[256];				// child slot + 1 for each byte (0: none)
+		void* children[48];
+	};
+
+	struct artnode256 {
+		struct artnode n;
+		void* children[256];
+	};
+
+	struct art {
+		void* root;								// inner node or tagged leaf (NULL if empty)
+		size_t size;							// number of keys
+		art_printdata printdata;				// function to print a value
+		art_freedata freedata;					// function to release a value from memory
+	};
+
+	// position in an inner node of an iterator
+	struct art_iterframe {
+		struct artnode* node;
+		int pos;								// next position (-1: node value not visited)
+	};
+
+	/*
+	 * In order cursor over tree keys.
+	 *
+	 *   struct art_iter it;
+	 *   for (struct artleaf* l = art_iter_seek(t, key, keylen, &it); l; l = art_iter_next(&it)) ...
+	 *   art_iter_release(&it);
+	 *
+	 * Note: cursor is invalid after the tree is changed.
+	 * */
+	struct art_iter {
+		struct art* t;
+		struct art_iterframe* stack;
+		size_t depth;							// number of frames
+		size_t capacity;						// size of stack
+		struct artleaf* current;				// leaf at cursor (NULL: none)
+	};
+
+	/*
+	 * Creates a new empty adaptive radix tree.
+	 * Returns pointer to created tree instance.
+	 */
+	struct art* art_create( art_printdata printdatafunc, art_freedata freedatafunc );
+
+	/*
+	 * Returns the number of keys in the tree.
+	 */
+	size_t art_getsize( const struct art* t );
+
+	/*
+	 * Encodes an unsigned integer as an 8 bytes big endian key (keeps numeric order).
+	 */
+	void art_encode_u64( uint64_t value, unsigned char* key );
+
+	/*
+	 * Gets the value of a key.
+	 * Returns NULL if key is not in the tree.
+	 */
+	void* art_search( const struct art* t, const unsigned char* key, size_t keylen );
+
+	/*
+	 * Checks if the tree contains a given key.
+	 */
+	int art_contains( const struct art* t, const unsigned char* key, size_t keylen );
+
+	/*
+	 * Inserts a key with a value, the key bytes are copied.
+	 * If key already exists its value is replaced.
+	 * Returns the previous value of the key (to be released by the caller) or NULL.
+	 */
+	void* art_insert( struct art* t, const unsigned char* key, size_t keylen, void* value );
+
+	/*
+	 * Removes a key from the tree.
+	 * Returns the value of removed key, NULL if key is not in the tree.
+	 */
+	void* art_remove( struct art* t, const unsigned char* key, size_t keylen );
+
+	/*
+	 * Gets the leaf of the smallest/greatest key.
+	 * Returns NULL if tree is empty.
+	 */
+	struct artleaf* art_minimum( const struct art* t );
+	struct artleaf* art_maximum( const struct art* t );
+
+	/*
+	 * Positions cursor at the smallest key (art_iter_first) or at the smallest key
+	 * greater than or equal to 'key' (art_iter_seek), in O(k).
+	 * Returns leaf at cursor, NULL if there is none.
+	 * */
+	struct artleaf* art_iter_first( struct art* t, struct art_iter* it );
+	struct artleaf* art_iter_seek( struct art* t, const unsigned char* key, size_t keylen,
+								   struct art_iter* it );
+
+	/*
+	 * Gets the leaf at cursor, NULL if there is none.
+	 * */
+	struct artleaf* art_iter_get( const struct art_iter* it );
+
+	/*
+	 * Moves cursor to the next key.
+	 * Returns leaf at cursor, NULL if cursor moved past the end.
+	 * */
+	struct artleaf* art_iter_next( struct art_iter* it );
+
+	/*
+	 * Releases cursor stack.
+	 * */
+	void art_iter_release( struct art_iter* it );
+
+	/*
+	 * Visits in ascending order the keys that start with a given prefix, until 'visit'
+	 * returns 0.
+	 * Returns the number of visited keys.
+	 */
+	size_t art_prefix_scan( struct art* t, const unsigned char* prefix, size_t prefixlen,
+							art_visit visit, void* context );
+
+	/*
+	 * Prints tree keys (non printable bytes as hex) and values in ascending order.
+	 */
+	void art_print( struct art* t );
+
+	/*
+	 * Removes all keys from the tree (values released with 'freedata' if defined).
+	 */
+	void art_clear( struct art* t );
+
+	/*
+	 * Releases the tree, its nodes and values (if 'freedata' is defined) from memory.
+	 */
+	void art_destroy( struct art* t );
+
+#endif /* ART_H_ */
@@ -78,6 +78,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <assert.h>
 #include "avltree.h"
 #include <string.h>
 #include "linkedlistqueue.h"
@@ -103,11 +104,15 @@ int max(int a, int b)
  * Returns pointer to created avl tree instance is succeeded, NULL otherwise.
  */
 struct avltree* avltree_create(void* rootdata, avltree_cmp comparefunc, avltree_freedata freedatafunc,
-		avltree_printnode printnodefunc, avltree_copydata copydatafunc)
+		avltree_printnode printnodefunc, avltree_copydata copydatafunc, struct nodearena* arena)
 {
+	assert((arena == NULL) || (arena->nodesize >= sizeof(struct avltreenode)));
+
 	struct avltree* result = (struct avltree*)malloc(sizeof(*result));
 	if (result != NULL) {
-		result->root = avltree_createnode(rootdata);
+		result->arena = arena;
+		result->counters = (struct avltree_counters){ 0 };
+		result->root = avltree_createnode(result, rootdata);
 
 		if (result->root == NULL) {
 			free(result);
@@ -127,9 +132,14 @@ struct avltree* avltree_create(void* rootdata, avltree_cmp comparefunc, avltree_
 /*
  * Function to create a new avl tree node.
  */
-struct avltreenode* avltree_createnode(void* data)
+struct avltreenode* avltree_createnode(struct avltree* tree, void* data)
 {
-	struct avltreenode* result = (struct avltreenode*)malloc(sizeof(*result));
+	struct avltreenode* result = NULL;
+	if (tree->arena != NULL)
+		result = (struct avltreenode*)nodearena_alloc(tree->arena);
+	else
+		result = (struct avltreenode*)malloc(sizeof(*result));
+
 	if (result != NULL)
 	{
 		result->data = data;
@@ -252,8 +262,10 @@ int getbalance(struct avltreenode *N)
 struct avltreenode* avltree_insert(struct avltree* tree, struct avltreenode* node, void* data)
 {
 	/* 1. Perform the normal BST insertion */
-	if (node == NULL)
-		return avltree_createnode(data);
+	if (node == NULL) {
+		DATASTATS_COUNT(tree->counters.inserts);
+		return avltree_createnode(tree, data);
+	}
 
 	if (tree->compare(node->data, data) > 0)
 		node->left = avltree_insert(tree, node->left, data);
@@ -275,16 +287,21 @@ struct avltreenode* avltree_insert(struct avltree* tree, struct avltreenode* nod
 	// there are 4 cases
 
 	// Left Left Case
-	if (balance > 1 && tree->compare(node->left->data, data) > 0)
+	if (balance > 1 && tree->compare(node->left->data, data) > 0) {
+		DATASTATS_ADD(tree->counters.insertrotations, 1);
 		return rightrotate(node);
+	}
 
 	// Right Right Case
-	if (balance < -1 && tree->compare(node->right->data, data) < 0)
+	if (balance < -1 && tree->compare(node->right->data, data) < 0) {
+		DATASTATS_ADD(tree->counters.insertrotations, 1);
 		return leftrotate(node);
+	}
 
 	// Left Right Case
 	if (balance > 1 && tree->compare(node->left->data, data) < 0)
 	{
+		DATASTATS_ADD(tree->counters.insertrotations, 2);
 		node->left = leftrotate(node->left);
 		return rightrotate(node);
 	}
@@ -292,6 +309,7 @@ struct avltreenode* avltree_insert(struct avltree* tree, struct avltreenode* nod
 	// Right Left Case
 	if (balance < -1 && tree->compare(node->right->data, data) > 0)
 	{
+		DATASTATS_ADD(tree->counters.insertrotations, 2);
 		node->right = rightrotate(node->right);
 		return leftrotate(node);
 	}
@@ -308,7 +326,10 @@ void avltree_destroynode(struct avltree* t, struct avltreenode* node)
 	if ((t->freedata != NULL) && (node->data != NULL))
 		t->freedata(node->data);
 
-	free(node);
+	if (t->arena != NULL)
+		nodearena_free(t->arena, node);
+	else
+		free(node);
 }
 
 /*
@@ -404,6 +425,7 @@ struct avltreenode* avltree_delete(struct avltree* tree,  struct avltreenode* ro
 								// the non-empty child
 			temp->data = NULL;	// release pointer data
 			avltree_destroynode(tree, temp);	// do not release data from memory
+			DATASTATS_COUNT(tree->counters.deletes);
 		}
 		else
 		{
@@ -434,23 +456,29 @@ struct avltreenode* avltree_delete(struct avltree* tree,  struct avltreenode* ro
 	// If this node becomes unbalanced, then there are 4 cases
 
 	// Left Left Case
-	if (balance > 1 && getbalance(root->left) >= 0)
+	if (balance > 1 && getbalance(root->left) >= 0) {
+		DATASTATS_ADD(tree->counters.deleterotations, 1);
 		return rightrotate(root);
+	}
 
 	// Left Right Case
 	if (balance > 1 && getbalance(root->left) < 0)
 	{
+		DATASTATS_ADD(tree->counters.deleterotations, 2);
 		root->left = leftrotate(root->left);
 		return rightrotate(root);
 	}
 
 	// Right Right Case
-	if (balance < -1 && getbalance(root->right) <= 0)
+	if (balance < -1 && getbalance(root->right) <= 0) {
+		DATASTATS_ADD(tree->counters.deleterotations, 1);
 		return leftrotate(root);
+	}
 
 	// Right Left Case
 	if (balance < -1 && getbalance(root->right) > 0)
 	{
+		DATASTATS_ADD(tree->counters.deleterotations, 2);
 		root->right = rightrotate(root->right);
 		return leftrotate(root);
 	}
@@ -772,6 +800,160 @@ void avltree_print(struct avltree* tree, char* spaces) {
     }
 }
 
+/*
+ * Takes a statistics snapshot of the tree: size, height and the event counters
+ * (rotations per insert and delete), if compiled in.
+ * */
+void avltree_stats(const struct avltree* tree, struct avltree_stats* stats)
+{
+	*stats = (struct avltree_stats){ 0 };
+	stats->size = (size_t)avltree_getSizeIt(tree);
+	stats->height = height(tree->root);		// nodes keep the height of their subtree
+	stats->countersenabled = DATASTATS_ENABLED;
+	stats->counters = tree->counters;
+}
+
+/*
+ * Converts a statistics snapshot to a metric list (see datastats_print and
+ * datastats_export). 'metrics' must have room for DATASTATS_MAX_METRICS entries.
+ * Returns the number of metrics.
+ * */
+size_t avltree_stats_metrics(const struct avltree_stats* stats, struct datastats_metric* metrics)
+{
+	const struct avltree_counters* c = &(stats->counters);
+	size_t n = 0;
+	metrics[n++] = (struct datastats_metric){ "size", (double)stats->size, NULL };
+	metrics[n++] = (struct datastats_metric){ "height", (double)stats->height, NULL };
+
+	if (stats->countersenabled) {
+		metrics[n++] = (struct datastats_metric){ "inserts", (double)c->inserts, NULL };
+		metrics[n++] = (struct datastats_metric){ "deletes", (double)c->deletes, NULL };
+		metrics[n++] = (struct datastats_metric){ "insert_rotations", (double)c->insertrotations, NULL };
+		metrics[n++] = (struct datastats_metric){ "delete_rotations", (double)c->deleterotations, NULL };
+		metrics[n++] = (struct datastats_metric){ "rotations_per_insert",
+				(c->inserts > 0) ? (double)c->insertrotations / (double)c->inserts : 0.0, NULL };
+		metrics[n++] = (struct datastats_metric){ "rotations_per_delete",
+				(c->deletes > 0) ? (double)c->deleterotations / (double)c->deletes : 0.0, NULL };
+	}
+
+	return n;
+}
+
+/*
+ * Pushes 'node' and its leftmost (or rightmost) descendants to cursor path.
+ */
+void avltree_iter_pushdown(struct avltree_iter* it, struct avltreenode* node, int rightmost)
+{
+	while (node != NULL) {
+		assert(it->depth < AVLTREE_ITER_MAXDEPTH);
+		it->path[it->depth++] = node;
+		node = (rightmost) ? node->right : node->left;
+	}
+}
+
+/*
+ * Positions cursor at the smallest element.
+ * */
+void avltree_iter_first(const struct avltree* tree, struct avltree_iter* it)
+{
+	it->tree = tree;
+	it->depth = 0;
+	avltree_iter_pushdown(it, tree->root, 0);
+}
+
+/*
+ * Positions cursor at the largest element.
+ * */
+void avltree_iter_last(const struct avltree* tree, struct avltree_iter* it)
+{
+	it->tree = tree;
+	it->depth = 0;
+	avltree_iter_pushdown(it, tree->root, 1);
+}
+
+/*
+ * Positions cursor at the smallest element larger than or equal to 'key', in O(log n).
+ * */
+void avltree_iter_seek(const struct avltree* tree, const void* key, struct avltree_iter* it)
+{
+	struct avltreenode* node = tree->root;
+	int found = 0;	// path length up to the best candidate
+
+	it->tree = tree;
+	it->depth = 0;
+	while (node != NULL) {
+		assert(it->depth < AVLTREE_ITER_MAXDEPTH);
+		it->path[it->depth++] = node;
+
+		int c = tree->compare(node->data, key);
+		if (c == 0) {
+			found = it->depth;
+			break;
+		}
+		else if (c > 0) {
+			found = it->depth;
+			node = node->left;
+		}
+		else
+			node = node->right;
+	}
+
+	it->depth = found;
+}
+
+/*
+ * Gets the element at cursor, NULL if there is none.
+ * */
+void* avltree_iter_get(const struct avltree_iter* it) {
+	return (it->depth > 0) ? it->path[it->depth - 1]->data : NULL;
+}
+
+/*
+ * Moves cursor to the next element.
+ * Returns that element, NULL if cursor moved past the end (it stays there).
+ * */
+void* avltree_iter_next(struct avltree_iter* it)
+{
+	if (it->depth == 0)
+		return NULL;
+
+	struct avltreenode* node = it->path[it->depth - 1];
+	if (node->right != NULL)
+		avltree_iter_pushdown(it, node->right, 0);
+	else {
+		// go up until coming from a left child
+		while (it->depth > 1 && it->path[it->depth - 2]->right == it->path[it->depth - 1])
+			it->depth--;
+
+		it->depth--;
+	}
+
+	return avltree_iter_get(it);
+}
+
+/*
+ * Moves cursor to the previous element.
+ * Returns that element, NULL if cursor moved past the end (it stays there).
+ * */
+void* avltree_iter_prev(struct avltree_iter* it)
+{
+	if (it->depth == 0)
+		return NULL;
+
+	struct avltreenode* node = it->path[it->depth - 1];
+	if (node->left != NULL)
+		avltree_iter_pushdown(it, node->left, 1);
+	else {
+		// go up until coming from a right child
+		while (it->depth > 1 && it->path[it->depth - 2]->left == it->path[it->depth - 1])
+			it->depth--;
+
+		it->depth--;
+	}
+
+	return avltree_iter_get(it);
+}
+
 /*
  * Releases all tree nodes and associated data from memory.
  * Uses postorder traversal.
@@ -792,7 +974,17 @@ void avltree_deallocate(struct avltree* tree, struct avltreenode* root) {
  * */
 void avltree_clear(struct avltree* tree)
 {
-	avltree_deallocate(tree, tree->root);
+	if (tree->arena == NULL)
+		avltree_deallocate(tree, tree->root);
+	else {
+		// only data needs a walk, nodes go away with the arena blocks
+		if (tree->freedata != NULL)
+			avltree_deallocate(tree, tree->root);
+
+		nodearena_reset(tree->arena);
+	}
+
+	tree->root = NULL;
 }
 
 /*
@@ -801,6 +993,10 @@ void avltree_clear(struct avltree* tree)
 void avltree_destroy(struct avltree* tree)
 {
 	avltree_clear(tree);
+
+	if (tree->arena != NULL)
+		nodearena_destroy(tree->arena);
+
 	free(tree);
 }
 
@@ -79,6 +79,9 @@
 #ifndef AVLTREE_H_
 	#define AVLTREE_H_
 
+	#include "nodearena.h"
+	#include "datastats.h"
+
 	// An AVL tree node
 	struct avltreenode
 	{
@@ -94,25 +97,46 @@
 	typedef void (*avltree_freedata)(void* data);
 	typedef void (*avltree_printnode)(struct avltreenode* node);
 
+	// event counters (only updated when built with CDATASTRUCT_STATS, see datastats.h)
+	struct avltree_counters {
+		size_t inserts;					// successful inserts
+		size_t deletes;					// successful deletes
+		size_t insertrotations;			// rotations done by inserts (a double rotation counts 2)
+		size_t deleterotations;			// rotations done by deletes
+	};
+
+	// statistics snapshot of an avl tree (see avltree_stats)
+	struct avltree_stats {
+		size_t size;
+		int height;						// levels of the tree (0 if empty)
+		int countersenabled;			// counters below were compiled in
+		struct avltree_counters counters;
+	};
+
 	struct avltree {
 		struct avltreenode* root;
 		avltree_copydata copydata;		// (hard) copy data function from one node to another
 		avltree_cmp compare;			// comoare function (returns 0, 1 or -1)
 		avltree_freedata freedata;		// function to release data from memory.
 		avltree_printnode printnode;	// function to print data node
+		struct nodearena* arena;		// node arena (NULL if nodes are malloc'ed)
+		struct avltree_counters counters;	// event counters (see datastats.h)
 	};
 
 	/*
 	 * Function to create a new avl tree..
+	 * If 'arena' is not NULL nodes are allocated from it (node size must be at
+	 * least sizeof(struct avltreenode)); the tree owns the arena and releases it
+	 * when destroyed.
 	 * Returns pointer to created avl tree instance is succeeded, NULL otherwise.
 	 */
 	struct avltree* avltree_create(void* rootdata, avltree_cmp comparefunc, avltree_freedata freedatafunc,
-			avltree_printnode printnodefunc, avltree_copydata copydatafunc);
+			avltree_printnode printnodefunc, avltree_copydata copydatafunc, struct nodearena* arena);
 
 	/*
 	 * Function to create a new avl tree node.
 	 */
-	struct avltreenode* avltree_createnode(void* data);
+	struct avltreenode* avltree_createnode(struct avltree* tree, void* data);
 
 	/*
 	 * Recursive function to insert a key in the avl subtree rooted
@@ -311,6 +335,57 @@
 	 * */
 	void avltree_print(struct avltree* tree, char* spaces);
 
+	/*
+	 * Takes a statistics snapshot of the tree: size, height and the event counters
+	 * (rotations per insert and delete), if compiled in.
+	 * */
+	void avltree_stats(const struct avltree* tree, struct avltree_stats* stats);
+
+	/*
+	 * Converts a statistics snapshot to a metric list (see datastats_print and
+	 * datastats_export). 'metrics' must have room for DATASTATS_MAX_METRICS entries.
+	 * Returns the number of metrics.
+	 * */
+	size_t avltree_stats_metrics(const struct avltree_stats* stats, struct datastats_metric* metrics);
+
+	// nodes have no parent, so the cursor keeps the path from the root (AVL tree height
+	// is below 1.45 * log2(n + 2), 96 levels is enough for any tree that fits in memory)
+	#define AVLTREE_ITER_MAXDEPTH 96
+
+	/*
+	 * In order cursor: keeps the nodes from the root to the current one, one step is
+	 * O(1) amortized (O(log n) worst case) and no memory is allocated.
+	 * Note: cursor is invalid after the tree is changed.
+	 * */
+	struct avltree_iter {
+		const struct avltree* tree;
+		int depth;										// path length (0: no current element)
+		struct avltreenode* path[AVLTREE_ITER_MAXDEPTH];	// path[depth - 1] is current node
+	};
+
+	/*
+	 * Positions cursor at the smallest/largest element.
+	 * */
+	void avltree_iter_first(const struct avltree* tree, struct avltree_iter* it);
+	void avltree_iter_last(const struct avltree* tree, struct avltree_iter* it);
+
+	/*
+	 * Positions cursor at the smallest element larger than or equal to 'key', in O(log n).
+	 * */
+	void avltree_iter_seek(const struct avltree* tree, const void* key, struct avltree_iter* it);
+
+	/*
+	 * Gets the element at cursor, NULL if there is none.
+	 * */
+	void* avltree_iter_get(const struct avltree_iter* it);
+
+	/*
+	 * Moves cursor to the next/previous element.
+	 * Returns that element, NULL if cursor moved past the end (it stays there).
+	 * */
+	void* avltree_iter_next(struct avltree_iter* it);
+	void* avltree_iter_prev(struct avltree_iter* it);
+
 	/*
 	 * Releases all nodes and data instance from avl tree.
 	 * */
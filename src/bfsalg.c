@@ -179,81 +179,204 @@ int* bfsalg_reconstruct_path(int start, int end, int prev[], int num_nodes, int*
 	}
 }
 
+//--------------------- workspace ------------------
+
 /*
- * Perform a breadth first search on an unweighted graph at starting node 'start'.
- *
- * The BFS algorithm uses a queue data structure to track which node to visit next.
- * Upon reaching a new node the algorithm adds it to the queue to visit it later.
- *
- * Returns the computed shortest path if succeded, NULL if no path was found.
- * Also returns result path size in 'res_size'.
- * Note: return path must be released later from memory.
- *
+ * Creates a BFS workspace for graphs with up to 'numvertices' vertices.
+ * Buffers are allocated once and reused by every query run with the workspace.
  */
-int* bfsalg_shortest_path( struct adjlgraph* g, int start, int end, int* res_size )
+struct bfsalg_workspace* bfsalg_workspace_create(int numvertices)
 {
-	*res_size = -1;
-	size_t nv = g->numvertices;				// total number of vertices (nodes)
-	size_t ne = adjlgraph_getnumedges( g );	// total number of edges
+	struct bfsalg_workspace* result = malloc(sizeof(*result));
+	if (!result) {
+		printf("Memory error: failed to allocate memory for BFS workspace!");
+		abort();
+	}
+
+	result->n = numvertices;
+	result->epoch = 0;
+	result->prev = (int*)malloc(numvertices * sizeof(int));
+	result->queue = (int*)malloc(numvertices * sizeof(int));
+	result->visited = (unsigned int*)calloc(numvertices, sizeof(unsigned int));
+	if (!(result->prev) || !(result->queue) || !(result->visited)) {
+		printf("Memory error: failed to allocate memory for BFS workspace arrays!");
+		abort();
+	}
 
-	int* prev = malloc(nv * sizeof(int));	// to store the traversal path nodes
+	return result;
+}
 
-	if (!prev) {
-		printf("Memory error: failed to allocate BFS shortest path array!");
+/*
+ * Prepares workspace for a new query from 'start'.
+ * Only the epoch is advanced, stamps are cleared when it wraps around.
+ */
+void bfsalg_workspace_reset(struct bfsalg_workspace* ws, int n, int start)
+{
+	if (n > ws->n) {
+		printf("Error: graph has more vertices than BFS workspace!");
 		abort();
 	}
-	else {
-		bool* visited = (bool*)malloc(nv * sizeof(bool));
 
-		if (!visited) {
-			printf("Memory error: failed to allocate BFS shortest path visited array!");
-			abort();
-		}
+	if (++(ws->epoch) == 0) {
+		memset(ws->visited, 0, ws->n * sizeof(unsigned int));
+		ws->epoch = 1;
+	}
+
+	ws->visited[start] = ws->epoch;
+	ws->prev[start] = BFSALG_EMPTY;
+}
+
+/*
+ * Reconstructs the path of last query from start to 'end' walking only path vertices.
+ * Returns 'NULL' if 'end' was not reached.
+ */
+int* bfsalg_workspace_reconstruct_path(const struct bfsalg_workspace* ws, int end, int* res_size)
+{
+	*res_size = 0;
+	if (ws->visited[end] != ws->epoch)
+		return NULL;
+
+	int size = 0;
+	for (int at = end; at != BFSALG_EMPTY; at = ws->prev[at])
+		size++;
 
-		// initialize arrays with default values
-		bfsalg_fillintarray(prev, nv, BFSALG_EMPTY);
-		bfsalg_fillboolarray(visited, nv, false);
-
-		// create queue with enough size
-		struct bfsalg_intqueue* q = bfsalg_intqueue_create( (nv > ne) ? nv : ne );
-
-		// Start by visiting the 'start' node and add it to the queue.
-		bfsalg_intqueue_enqueue(q, start);
-		visited[start] = true;
-		int to = -1; int count = 0;
-
-		// Continue until the BFS is done.
-		while (!bfsalg_intqueue_isempty(q)) {
-			int node = bfsalg_intqueue_dequeue(q);
-			struct adjlgedge* edge = g->vertexlist[node]->edgeslist;
-
-			// Loop through all edges attached to this node. Mark nodes as visited once
-			// they're in the queue. This will prevent having duplicate nodes in the queue
-			// and speedup the BFS.
-			while (edge) {
-				to = edge->vertexindex;
-				if (!visited[to]) {
-					visited[to] = true;
-					prev[to] = node; count++;
-					bfsalg_intqueue_enqueue(q, to);
-				}
-
-				edge = edge->next;
+	int* result = (int*)malloc( size * sizeof(int) );
+	if (!result) {
+		printf( "Memory error: failed to allocate memory for result array of "
+			    "shortest path BFS algorithm!" );
+		abort();
+	}
+
+	int i = size;
+	for (int at = end; at != BFSALG_EMPTY; at = ws->prev[at])
+		result[--i] = at;
+
+	*res_size = size;
+	return result;
+}
+
+/*
+ * Perform a breadth first search on an unweighted graph at starting node 'start',
+ * using the buffers of a workspace. Search stops once 'end' is dequeued.
+ * Returns the computed shortest path if succeded, NULL if no path was found.
+ * Note: return path must be released later from memory.
+ */
+int* bfsalg_workspace_shortest_path( struct bfsalg_workspace* ws, struct adjlgraph* g,
+									 int start, int end, int* res_size )
+{
+	bfsalg_workspace_reset(ws, g->numvertices, start);
+
+	// every vertex is enqueued at most once, a flat array is enough
+	int front = 0, back = 0;
+	ws->queue[back++] = start;
+
+	while (front < back) {
+		int node = ws->queue[front++];
+
+		// stop as soon as end is reached, path to it is already known
+		if (node == end)
+			break;
+
+		// Loop through all edges attached to this node. Mark nodes as visited once
+		// they're in the queue. This will prevent having duplicate nodes in the queue
+		// and speedup the BFS.
+		struct adjlgedge* edge = g->vertexlist[node]->edgeslist;
+		while (edge) {
+			int to = edge->vertexindex;
+			if (ws->visited[to] != ws->epoch) {
+				ws->visited[to] = ws->epoch;
+				ws->prev[to] = node;
+				ws->queue[back++] = to;
 			}
+
+			edge = edge->next;
 		}
+	}
 
-		// reconstruct path
-		int* result = bfsalg_reconstruct_path(start, end, prev, count, res_size);
+	return bfsalg_workspace_reconstruct_path(ws, end, res_size);
+}
 
-		// free memory
-		free(prev);
-		free(visited);
-		free(q->ar);
-		free(q);
-		return result;
+/*
+ * Perform a breadth first search on an unweighted CSR graph at starting node 'start',
+ * using the buffers of a workspace. Search stops once 'end' is dequeued.
+ * Returns the computed shortest path if succeded, NULL if no path was found.
+ * Note: return path must be released later from memory.
+ */
+int* bfsalg_workspace_csr_shortest_path( struct bfsalg_workspace* ws, const struct csrgraph* g,
+										 int start, int end, int* res_size )
+{
+	bfsalg_workspace_reset(ws, g->numvertices, start);
+
+	int front = 0, back = 0;
+	ws->queue[back++] = start;
+
+	while (front < back) {
+		int node = ws->queue[front++];
+
+		if (node == end)
+			break;
+
+		size_t last = g->offsets[node + 1];
+		for (size_t e = g->offsets[node]; e < last; ++e) {
+			int to = g->targets[e];
+			if (ws->visited[to] != ws->epoch) {
+				ws->visited[to] = ws->epoch;
+				ws->prev[to] = node;
+				ws->queue[back++] = to;
+			}
+		}
 	}
 
-	return NULL;
+	return bfsalg_workspace_reconstruct_path(ws, end, res_size);
+}
+
+/*
+ * Releases a BFS workspace from memory.
+ */
+void bfsalg_workspace_destroy(struct bfsalg_workspace* ws)
+{
+	free(ws->prev);
+	free(ws->queue);
+	free(ws->visited);
+	free(ws);
+}
+
+//--------------------- workspace ------------------
+
+/*
+ * Perform a breadth first search on an unweighted graph at starting node 'start'.
+ *
+ * The BFS algorithm uses a queue data structure to track which node to visit next.
+ * Upon reaching a new node the algorithm adds it to the queue to visit it later.
+ *
+ * Returns the computed shortest path if succeded, NULL if no path was found.
+ * Also returns result path size in 'res_size'.
+ * Note: return path must be released later from memory.
+ *
+ */
+int* bfsalg_shortest_path( struct adjlgraph* g, int start, int end, int* res_size )
+{
+	struct bfsalg_workspace* ws = bfsalg_workspace_create(g->numvertices);
+	int* result = bfsalg_workspace_shortest_path(ws, g, start, end, res_size);
+	bfsalg_workspace_destroy(ws);
+	return result;
+}
+
+/*
+ * Perform a breadth first search on an unweighted CSR graph at starting node 'start'.
+ * Same as 'bfsalg_shortest_path' but edges are scanned from contiguous arrays.
+ *
+ * Returns the computed shortest path if succeded, NULL if no path was found.
+ * Also returns result path size in 'res_size'.
+ * Note: return path must be released later from memory.
+ *
+ */
+int* bfsalg_csr_shortest_path( const struct csrgraph* g, int start, int end, int* res_size )
+{
+	struct bfsalg_workspace* ws = bfsalg_workspace_create(g->numvertices);
+	int* result = bfsalg_workspace_csr_shortest_path(ws, g, start, end, res_size);
+	bfsalg_workspace_destroy(ws);
+	return result;
 }
 
 /*
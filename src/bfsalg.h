@@ -28,14 +28,57 @@
 #ifndef BFSALG_H_
 	#define BFSALG_H_
 	#include "adjlgraph.h"
+	#include "csrgraph.h"
 
-//	/*
-//	 * Reconstructs the graph path computed by BFS algorithm to return the shortest path
-//	 * from start to end nodes.
-//	 * If 'start' and 'end' are not connected then returns 'NULL'.
-//	 * Note: You must release result array from memory later.
-//	 */
-//	int* bfsalg_reconstruct_path(int start, int end, int prev[], int num_nodes);
+	/*
+	 * Reusable query workspace: buffers sized to the graph are allocated once and
+	 * reused by every query. Instead of clearing 'visited' before each query, every
+	 * query gets a new epoch and a vertex is visited only if its stamp matches it,
+	 * so query cost depends on the vertices touched, not on the graph size.
+	 */
+	struct bfsalg_workspace {
+		int n;						// capacity (maximum number of vertices)
+		unsigned int epoch;			// current query stamp
+		int* prev;					// previous vertex on path (valid if visited)
+		int* queue;					// BFS queue (each vertex enqueued once)
+		unsigned int* visited;		// epoch in which vertex was visited
+	};
+
+	/*
+	 * Creates a BFS workspace for graphs with up to 'numvertices' vertices.
+	 */
+	struct bfsalg_workspace* bfsalg_workspace_create(int numvertices);
+
+	/*
+	 * Perform a breadth first search on an unweighted graph at starting node 'start',
+	 * using the buffers of a workspace. Search stops once 'end' is dequeued.
+	 * Returns the computed shortest path if succeded, NULL if no path was found.
+	 * Note: return path must be released later from memory.
+	 */
+	int* bfsalg_workspace_shortest_path( struct bfsalg_workspace* ws, struct adjlgraph* g,
+										 int start, int end, int* res_size );
+
+	/*
+	 * Perform a breadth first search on an unweighted CSR graph at starting node 'start',
+	 * using the buffers of a workspace. Search stops once 'end' is dequeued.
+	 * Returns the computed shortest path if succeded, NULL if no path was found.
+	 * Note: return path must be released later from memory.
+	 */
+	int* bfsalg_workspace_csr_shortest_path( struct bfsalg_workspace* ws, const struct csrgraph* g,
+											 int start, int end, int* res_size );
+
+	/*
+	 * Releases a BFS workspace from memory.
+	 */
+	void bfsalg_workspace_destroy(struct bfsalg_workspace* ws);
+
+	/*
+	 * Reconstructs the graph path computed by BFS algorithm to return the shortest path
+	 * from start to end nodes.
+	 * If 'start' and 'end' are not connected then returns 'NULL'.
+	 * Note: You must release result array from memory later.
+	 */
+	int* bfsalg_reconstruct_path(int start, int end, int prev[], int num_nodes, int* res_size);
 
 	/*
 	 * Perform a breadth first search on an unweighted graph at starting node 'start'.
@@ -49,6 +92,14 @@
 	 */
 	int* bfsalg_shortest_path( struct adjlgraph* g, int start, int end, int* res_size );
 
+	/*
+	 * Perform a breadth first search on an unweighted CSR graph at starting node 'start'.
+	 * Same as 'bfsalg_shortest_path' but edges are scanned from contiguous arrays.
+	 * Returns the computed shortest path if succeded, NULL if no path was found.
+	 * Note: return path must be released later from memory.
+	 */
+	int* bfsalg_csr_shortest_path( const struct csrgraph* g, int start, int end, int* res_size );
+
 	/*
 	 * Prints the path. ex:'[4->7->3->2]'
 	 */
@@ -0,0 +1,390 @@
+/********************************************************************************
+ * bfsalg_parallel.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of a multi-threaded, direction-optimizing breadth
+ *  			first search on CSR graphs.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Worker threads live for the whole search and meet twice per level on a barrier:
+ *  after expanding the level, and after thread 0 builds the next frontier and picks
+ *  its direction. Bottom-up chunks are multiples of 64 vertices, so each bitmap word
+ *  written in that direction is owned by a single thread.
+ *
+ *  Source: S. Beamer, K. Asanovic, D. Patterson, "Direction-Optimizing Breadth-First Search", SC 2012.
+ *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "bfsalg.h"
+#include "bfsalg_parallel.h"
+#include "numanode.h"
+
+#define BFSALG_PARALLEL_EMPTY -1
+#define BFSALG_PARALLEL_BUFFER 256	// vertices found by a thread before they are published
+
+// shared state of a search
+struct bfsalg_parallel_state {
+	const struct csrgraph* g;			// graph (outgoing edges)
+	const struct csrgraph* rg;			// reverse graph (incoming edges)
+	int n;								// number of vertices
+	int* prev;							// parent of each vertex (result)
+	_Atomic uint64_t* visited;			// visited vertices bitmap
+	uint64_t* frontierbits;				// current frontier bitmap (bottom-up)
+	uint64_t* nextbits;					// next frontier bitmap (bottom-up)
+	size_t nwords;						// number of words of each bitmap
+	int* queue;							// current frontier queue (top-down)
+	int* nextqueue;						// next frontier queue (top-down)
+	size_t queuesize;					// current frontier size
+	atomic_size_t nextsize;				// next frontier size
+	atomic_size_t nextedges;			// edges out of next frontier
+	atomic_size_t cursor;				// next chunk to be taken by a thread
+	int numparts;						// partitions of the reverse graph (0 if not partitioned)
+	atomic_size_t* partcursor;			// next chunk of each partition (bottom-up)
+	int nthreads;						// number of threads
+	size_t unexplorededges;				// edges out of unvisited vertices
+	int bottomup;						// direction of current level
+	int done;							// search is finished
+	pthread_barrier_t barrier;			// level barrier
+};
+
+// worker thread argument
+struct bfsalg_parallel_worker {
+	struct bfsalg_parallel_state* st;
+	int tid;
+	pthread_t thread;
+};
+
+/*
+ * Publishes the vertices found by a thread to the next frontier queue.
+ */
+void bfsalg_parallel_flush(struct bfsalg_parallel_state* st, int* buf, size_t count)
+{
+	size_t pos = atomic_fetch_add_explicit(&(st->nextsize), count, memory_order_relaxed);
+	memcpy(st->nextqueue + pos, buf, count * sizeof(int));
+}
+
+/*
+ * Expands current level top-down: scans the outgoing edges of frontier vertices.
+ */
+void bfsalg_parallel_topdown(struct bfsalg_parallel_state* st)
+{
+	const struct csrgraph* g = st->g;
+	int buf[BFSALG_PARALLEL_BUFFER];
+	size_t count = 0, edges = 0, begin = 0;
+
+	while ((begin = atomic_fetch_add_explicit(&(st->cursor), BFSALG_PARALLEL_CHUNK,
+											  memory_order_relaxed)) < st->queuesize) {
+		size_t end = begin + BFSALG_PARALLEL_CHUNK;
+		if (end > st->queuesize) end = st->queuesize;
+
+		for (size_t i = begin; i < end; ++i) {
+			int u = st->queue[i];
+			for (size_t e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+				int v = g->targets[e];
+				uint64_t bit = (uint64_t)1 << (v & 63);
+
+				// cheap test first, the atomic claim decides the winner
+				if (atomic_load_explicit(&(st->visited[v >> 6]), memory_order_relaxed) & bit)
+					continue;
+				if (atomic_fetch_or_explicit(&(st->visited[v >> 6]), bit, memory_order_relaxed) & bit)
+					continue;
+
+				st->prev[v] = u;
+				edges += csrgraph_degree(g, v);
+				buf[count++] = v;
+				if (count == BFSALG_PARALLEL_BUFFER) {
+					bfsalg_parallel_flush(st, buf, count);
+					count = 0;
+				}
+			}
+		}
+	}
+
+	if (count > 0)
+		bfsalg_parallel_flush(st, buf, count);
+
+	atomic_fetch_add_explicit(&(st->nextedges), edges, memory_order_relaxed);
+}
+
+/*
+ * Takes the next bottom-up chunk of vertices: from the shared cursor, or on a
+ * partitioned graph from the home partition of the thread first, then from the
+ * other ones (in order).
+ * Returns '1' and the chunk in 'begin_p'/'end_p', '0' when all chunks were taken.
+ */
+int bfsalg_parallel_nextchunk(struct bfsalg_parallel_state* st, int tid, size_t* begin_p, size_t* end_p)
+{
+	if (st->numparts == 0) {
+		size_t begin = atomic_fetch_add_explicit(&(st->cursor), BFSALG_PARALLEL_CHUNK, memory_order_relaxed);
+		if (begin >= (size_t)st->n)
+			return 0;
+
+		*begin_p = begin;
+		*end_p = (begin + BFSALG_PARALLEL_CHUNK < (size_t)st->n) ? begin + BFSALG_PARALLEL_CHUNK : (size_t)st->n;
+		return 1;
+	}
+
+	const size_t* parts = st->rg->partitions;
+	int home = (int)((long)tid * st->numparts / st->nthreads);
+	for (int i = 0; i < st->numparts; ++i) {
+		int k = (home + i) % st->numparts;
+		size_t size = parts[k + 1] - parts[k];
+		if (atomic_load_explicit(&(st->partcursor[k]), memory_order_relaxed) >= size)
+			continue;
+
+		// partitions start on a multiple of 64, so bitmap words are still owned by one thread
+		size_t offset = atomic_fetch_add_explicit(&(st->partcursor[k]), BFSALG_PARALLEL_CHUNK, memory_order_relaxed);
+		if (offset >= size)
+			continue;
+
+		*begin_p = parts[k] + offset;
+		*end_p = parts[k] + ((offset + BFSALG_PARALLEL_CHUNK < size) ? offset + BFSALG_PARALLEL_CHUNK : size);
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * Expands current level bottom-up: every unvisited vertex looks for a parent
+ * in the frontier among its incoming edges.
+ */
+void bfsalg_parallel_bottomup(struct bfsalg_parallel_state* st, int tid)
+{
+	const struct csrgraph* rg = st->rg;
+	size_t count = 0, edges = 0, begin = 0, end = 0;
+
+	while (bfsalg_parallel_nextchunk(st, tid, &begin, &end)) {
+		for (size_t v = begin; v < end; ++v) {
+			uint64_t bit = (uint64_t)1 << (v & 63);
+			if (atomic_load_explicit(&(st->visited[v >> 6]), memory_order_relaxed) & bit)
+				continue;
+
+			for (size_t e = rg->offsets[v]; e < rg->offsets[v + 1]; ++e) {
+				int u = rg->targets[e];
+				if (st->frontierbits[u >> 6] & ((uint64_t)1 << (u & 63))) {
+					// word of 'v' is only written by this thread
+					st->prev[v] = u;
+					atomic_fetch_or_explicit(&(st->visited[v >> 6]), bit, memory_order_relaxed);
+					st->nextbits[v >> 6] |= bit;
+					edges += csrgraph_degree(st->g, v);
+					count++;
+					break;
+				}
+			}
+		}
+	}
+
+	atomic_fetch_add_explicit(&(st->nextsize), count, memory_order_relaxed);
+	atomic_fetch_add_explicit(&(st->nextedges), edges, memory_order_relaxed);
+}
+
+/*
+ * Makes the next frontier the current one and picks the direction of next level.
+ * Runs on a single thread between levels.
+ */
+void bfsalg_parallel_nextlevel(struct bfsalg_parallel_state* st)
+{
+	size_t nf = atomic_load(&(st->nextsize));
+	size_t mf = atomic_load(&(st->nextedges));
+	st->unexplorededges -= mf;
+
+	if (!st->bottomup) {
+		int* tmp = st->queue;
+		st->queue = st->nextqueue;
+		st->nextqueue = tmp;
+		st->queuesize = nf;
+
+		if (nf > 0 && mf > st->unexplorededges / BFSALG_PARALLEL_ALPHA) {
+			// frontier is large: switch to bottom-up
+			memset(st->frontierbits, 0, st->nwords * sizeof(uint64_t));
+			for (size_t i = 0; i < nf; ++i)
+				st->frontierbits[st->queue[i] >> 6] |= (uint64_t)1 << (st->queue[i] & 63);
+			st->bottomup = 1;
+		}
+	}
+	else {
+		uint64_t* tmp = st->frontierbits;
+		st->frontierbits = st->nextbits;
+		st->nextbits = tmp;
+		memset(st->nextbits, 0, st->nwords * sizeof(uint64_t));
+
+		if (nf > 0 && nf < (size_t)st->n / BFSALG_PARALLEL_BETA) {
+			// frontier is small again: switch to top-down
+			size_t k = 0;
+			for (size_t w = 0; w < st->nwords; ++w)
+				for (uint64_t bits = st->frontierbits[w]; bits != 0; bits &= bits - 1)
+					st->queue[k++] = (int)(w * 64 + __builtin_ctzll(bits));
+			st->queuesize = k;
+			st->bottomup = 0;
+		}
+	}
+
+	st->done = (nf == 0);
+	atomic_store(&(st->nextsize), 0);
+	atomic_store(&(st->nextedges), 0);
+	atomic_store(&(st->cursor), 0);
+	for (int k = 0; k < st->numparts; ++k)
+		atomic_store(&(st->partcursor[k]), 0);
+}
+
+/*
+ * Worker thread loop: expands levels until the frontier is empty.
+ */
+void* bfsalg_parallel_run(void* arg)
+{
+	struct bfsalg_parallel_worker* w = (struct bfsalg_parallel_worker*)arg;
+	struct bfsalg_parallel_state* st = w->st;
+
+	// on a partitioned graph workers run on the node of their home partition
+	// (the calling thread, worker 0, keeps its affinity)
+	if ((st->numparts > 0) && (w->tid > 0))
+		numanode_pin_thread(numanode_of_part((int)((long)w->tid * st->numparts / st->nthreads), st->numparts));
+
+	while (1) {
+		if (st->bottomup)
+			bfsalg_parallel_bottomup(st, w->tid);
+		else
+			bfsalg_parallel_topdown(st);
+
+		pthread_barrier_wait(&(st->barrier));
+		if (w->tid == 0)
+			bfsalg_parallel_nextlevel(st);
+		pthread_barrier_wait(&(st->barrier));
+
+		if (st->done)
+			break;
+	}
+
+	return NULL;
+}
+
+/*
+ * Performs a parallel breadth first search from 'start' with 'nthreads' threads.
+ * 'rg' is the reverse graph of 'g' (may be NULL if 'g' is undirected).
+ * Returns the parent array (size numvertices, -1 for start and unreachable vertices).
+ * Note: returned array must be released later from memory.
+ */
+int* bfsalg_parallel_parents( const struct csrgraph* g, const struct csrgraph* rg,
+							  int start, int nthreads )
+{
+	if (rg == NULL) {
+		if (g->etype == DIRECTED_AGRAPH) {
+			printf("Error: reverse graph is required for directed graphs!");
+			abort();
+		}
+
+		rg = g;	// undirected graph is its own reverse
+	}
+
+	if (nthreads < 1) nthreads = 1;
+
+	struct bfsalg_parallel_state st;
+	st.g = g;
+	st.rg = rg;
+	st.n = (int)g->numvertices;
+	st.nwords = g->numvertices / 64 + 1;
+	st.prev = (int*)malloc(g->numvertices * sizeof(int));
+	st.queue = (int*)malloc(g->numvertices * sizeof(int));
+	st.nextqueue = (int*)malloc(g->numvertices * sizeof(int));
+	st.visited = (_Atomic uint64_t*)calloc(st.nwords, sizeof(uint64_t));
+	st.frontierbits = (uint64_t*)calloc(st.nwords, sizeof(uint64_t));
+	st.nextbits = (uint64_t*)calloc(st.nwords, sizeof(uint64_t));
+	if (!st.prev || !st.queue || !st.nextqueue || !st.visited || !st.frontierbits || !st.nextbits) {
+		printf("Memory error: failed to allocate parallel BFS arrays!");
+		abort();
+	}
+
+	st.nthreads = nthreads;
+	st.numparts = (rg->numpartitions > 1) ? rg->numpartitions : 0;
+	st.partcursor = NULL;
+	if (st.numparts > 0) {
+		st.partcursor = (atomic_size_t*)malloc(st.numparts * sizeof(atomic_size_t));
+		if (!st.partcursor) {
+			printf("Memory error: failed to allocate parallel BFS arrays!");
+			abort();
+		}
+
+		for (int k = 0; k < st.numparts; ++k)
+			atomic_init(&(st.partcursor[k]), 0);
+	}
+
+	// parents of a partition live on its node (pages are placed before first touch)
+	for (int k = 0; k < g->numpartitions; ++k)
+		numanode_bind( st.prev + g->partitions[k], (g->partitions[k + 1] - g->partitions[k]) * sizeof(int),
+					   numanode_of_part(k, g->numpartitions) );
+
+	for (int i = 0; i < st.n; ++i)
+		st.prev[i] = BFSALG_PARALLEL_EMPTY;
+
+	atomic_fetch_or(&(st.visited[start >> 6]), (uint64_t)1 << (start & 63));
+	st.queue[0] = start;
+	st.queuesize = 1;
+	st.unexplorededges = g->numarcs - csrgraph_degree(g, start);
+	st.bottomup = 0;
+	st.done = 0;
+	atomic_init(&(st.nextsize), 0);
+	atomic_init(&(st.nextedges), 0);
+	atomic_init(&(st.cursor), 0);
+
+	if (pthread_barrier_init(&(st.barrier), NULL, nthreads) != 0) {
+		printf("Error: failed to initialize parallel BFS barrier!");
+		abort();
+	}
+
+	struct bfsalg_parallel_worker* workers = malloc(nthreads * sizeof(*workers));
+	if (!workers) {
+		printf("Memory error: failed to allocate parallel BFS workers!");
+		abort();
+	}
+
+	for (int i = 0; i < nthreads; ++i) {
+		workers[i].st = &st;
+		workers[i].tid = i;
+		if (i > 0 && pthread_create(&(workers[i].thread), NULL, bfsalg_parallel_run, &(workers[i])) != 0) {
+			printf("Error: failed to create parallel BFS thread!");
+			abort();
+		}
+	}
+
+	bfsalg_parallel_run(&(workers[0]));	// calling thread is worker 0
+
+	for (int i = 1; i < nthreads; ++i)
+		pthread_join(workers[i].thread, NULL);
+
+	pthread_barrier_destroy(&(st.barrier));
+	free(workers);
+	free(st.queue);
+	free(st.nextqueue);
+	free(st.visited);
+	free(st.frontierbits);
+	free(st.nextbits);
+	free(st.partcursor);
+	return st.prev;
+}
+
+/*
+ * Computes the shortest (unweighted) path from 'start' to 'end' with a parallel
+ * breadth first search (see bfsalg_parallel_parents).
+ * Returns the computed shortest path if succeded, NULL if no path was found.
+ * Note: return path must be released later from memory.
+ */
+int* bfsalg_parallel_shortest_path( const struct csrgraph* g, const struct csrgraph* rg,
+									int start, int end, int nthreads, int* res_size )
+{
+	int* prev = bfsalg_parallel_parents(g, rg, start, nthreads);
+	int* result = bfsalg_reconstruct_path(start, end, prev, g->numvertices, res_size);
+	free(prev);
+	return result;
+}
@@ -0,0 +1,74 @@
+/*****************************************************************************
+ * bfsalg_parallel.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a multi-threaded, direction-optimizing breadth first
+ *  			 search on CSR graphs.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  The search is level synchronous: all vertices of the current frontier are
+ *  expanded in parallel, then threads meet at a barrier and the next frontier
+ *  becomes the current one. Each level runs in one of two directions:
+ *
+ *  	- top-down: threads take chunks of the frontier queue and scan the
+ *  	  outgoing edges of each vertex. A vertex is claimed by atomically setting
+ *  	  its bit in the 'visited' bitmap, the winner writes its parent;
+ *  	- bottom-up: threads take chunks of 64 vertices (one bitmap word each) and,
+ *  	  for every unvisited vertex, scan its incoming edges looking for a parent in
+ *  	  the frontier bitmap. The scan stops at the first parent found, so when the
+ *  	  frontier is large most edges are never looked at.
+ *
+ *  Direction switches use the Beamer heuristic: go bottom-up when the edges out
+ *  of the frontier exceed 1/14 of the edges out of unvisited vertices, and back
+ *  top-down when the frontier shrinks below 1/24 of the vertices.
+ *
+ *  Bottom-up needs incoming edges: for directed graphs pass the reverse graph
+ *  (csrgraph_create_reverse), undirected graphs are their own reverse.
+ *
+ *  On graphs split with csrgraph_create_partitioned (NUMA partitions of the reverse
+ *  graph, which is the graph itself when undirected) worker threads are pinned to the
+ *  home node of a partition and bottom-up levels take chunks of their own partition
+ *  first, then of the other ones, so most incoming edge scans read local memory.
+ *  The parents of each partition are placed on its node too. Top-down levels still
+ *  share one frontier queue.
+ *
+ *  Result is the same parent array as sequential BFS (parent of start and of
+ *  unreachable vertices is -1). When a vertex has several parents in the previous
+ *  level any of them may be chosen, path lengths are always the BFS ones.
+ *
+ *  Source: S. Beamer, K. Asanovic, D. Patterson, "Direction-Optimizing Breadth-First Search", SC 2012.
+ *
+ *******************************************************************************/
+
+#ifndef BFSALG_PARALLEL_H_
+	#define BFSALG_PARALLEL_H_
+
+	#include "csrgraph.h"
+
+	#define BFSALG_PARALLEL_ALPHA 14		// top-down -> bottom-up switch factor
+	#define BFSALG_PARALLEL_BETA 24			// bottom-up -> top-down switch factor
+	#define BFSALG_PARALLEL_CHUNK 256		// vertices taken by a thread at once (multiple of 64)
+
+	/*
+	 * Performs a parallel breadth first search from 'start' with 'nthreads' threads.
+	 * 'rg' is the reverse graph of 'g' (may be NULL if 'g' is undirected).
+	 * Returns the parent array (size numvertices, -1 for start and unreachable vertices).
+	 * Note: returned array must be released later from memory.
+	 */
+	int* bfsalg_parallel_parents( const struct csrgraph* g, const struct csrgraph* rg,
+								  int start, int nthreads );
+
+	/*
+	 * Computes the shortest (unweighted) path from 'start' to 'end' with a parallel
+	 * breadth first search (see bfsalg_parallel_parents).
+	 * Returns the computed shortest path if succeded, NULL if no path was found.
+	 * Note: return path must be released later from memory.
+	 */
+	int* bfsalg_parallel_shortest_path( const struct csrgraph* g, const struct csrgraph* rg,
+										int start, int end, int nthreads, int* res_size );
+
+#endif /* BFSALG_PARALLEL_H_ */
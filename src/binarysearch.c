@@ -95,30 +95,36 @@
  */
 
 #include <stdio.h>
+#include "binarysearch.h"
 
-/* A recursive binary search function. It returns
+#if defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
+
+/* An iterative binary search function. It returns
  * location of x in given array arr[l..r] is present, otherwise -1.
  * comparefunc is a function that returns 0 if first arg equals second arg,
  * 1 if is greater than, -1 if is less than.
  *  */
 int binarySearch(void* arr[], int l, int r, void* x, int (*comparefunc)(void* a, void* b))
 {
-    if (r >= l) {
+    while (r >= l) {
         int mid = l + (r - l) / 2;		// (l+r)/2 can cause buffer overflow for integer type
+        int cmp = comparefunc(arr[mid], x);	// one call per level
 
         // If the element is present at the middle
         // itself
-        if (comparefunc(arr[mid], x) == 0)
+        if (cmp == 0)
             return mid;
 
         // If element is smaller than mid, then
         // it can only be present in left subarray
-        if (comparefunc(arr[mid], x) == 1)	// mid greater than x
-            return binarySearch(arr, l, mid - 1, x, comparefunc);
-
-        // Else the element can only be present
-        // in right subarray
-        return binarySearch(arr, mid + 1, r, x, comparefunc);
+        if (cmp == 1)	// mid greater than x
+            r = mid - 1;
+        else
+        	// Else the element can only be present
+        	// in right subarray
+        	l = mid + 1;
     }
 
     // We reach here when element is not
@@ -126,5 +132,189 @@ int binarySearch(void* arr[], int l, int r, void* x, int (*comparefunc)(void* a,
     return -1;
 }
 
+/*
+ * Counts the elements of a small block lesser than (or lesser than or equal to) 'x'.
+ */
+size_t binarysearch_countless_i32(const int32_t* a, size_t n, int32_t x)
+{
+	size_t c = 0, i = 0;
+#if defined(__SSE2__)
+	__m128i vx = _mm_set1_epi32(x);
+	for (; i + 4 <= n; i += 4) {
+		__m128i lt = _mm_cmplt_epi32(_mm_loadu_si128((const __m128i*)(a + i)), vx);
+		c += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(lt)));
+	}
+#endif
+	for (; i < n; i++)
+		c += (a[i] < x);
+
+	return c;
+}
+
+size_t binarysearch_countlesseq_i32(const int32_t* a, size_t n, int32_t x)
+{
+	size_t c = 0, i = 0;
+#if defined(__SSE2__)
+	__m128i vx = _mm_set1_epi32(x);
+	for (; i + 4 <= n; i += 4) {
+		__m128i gt = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(a + i)), vx);
+		c += 4 - __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(gt)));
+	}
+#endif
+	for (; i < n; i++)
+		c += (a[i] <= x);
+
+	return c;
+}
+
+size_t binarysearch_countless_f64(const double* a, size_t n, double x)
+{
+	size_t c = 0, i = 0;
+#if defined(__SSE2__)
+	__m128d vx = _mm_set1_pd(x);
+	for (; i + 2 <= n; i += 2)
+		c += __builtin_popcount(_mm_movemask_pd(_mm_cmplt_pd(_mm_loadu_pd(a + i), vx)));
+#endif
+	for (; i < n; i++)
+		c += (a[i] < x);
+
+	return c;
+}
+
+size_t binarysearch_countlesseq_f64(const double* a, size_t n, double x)
+{
+	size_t c = 0, i = 0;
+#if defined(__SSE2__)
+	__m128d vx = _mm_set1_pd(x);
+	for (; i + 2 <= n; i += 2)
+		c += __builtin_popcount(_mm_movemask_pd(_mm_cmple_pd(_mm_loadu_pd(a + i), vx)));
+#endif
+	for (; i < n; i++)
+		c += (a[i] <= x);
+
+	return c;
+}
+
+// no 64 bit compare in SSE2, scalar loops (vectorized by the compiler when possible)
+size_t binarysearch_countless_i64(const int64_t* a, size_t n, int64_t x)
+{
+	size_t c = 0;
+	for (size_t i = 0; i < n; i++)
+		c += (a[i] < x);
+
+	return c;
+}
 
+size_t binarysearch_countlesseq_i64(const int64_t* a, size_t n, int64_t x)
+{
+	size_t c = 0;
+	for (size_t i = 0; i < n; i++)
+		c += (a[i] <= x);
+
+	return c;
+}
+
+/*
+ * Generates the typed search kernels of a number type.
+ * 'sfx' is the suffix of generated functions and 'T' the element type.
+ */
+#define BINARYSEARCH_DEFINE(sfx, T)														\
+																						\
+size_t binarysearch_lower_bound_##sfx(const T* arr, size_t n, T x)						\
+{																						\
+	const T* base = arr;																\
+	size_t len = n;																		\
+	while (len > BINARYSEARCH_BLOCK) {													\
+		size_t half = len / 2;															\
+		__builtin_prefetch(base + half / 2);		/* both next probes */				\
+		__builtin_prefetch(base + half + half / 2);										\
+		base = (base[half - 1] < x) ? base + half : base;	/* conditional move */		\
+		len -= half;																	\
+	}																					\
+																						\
+	return (size_t)(base - arr) + binarysearch_countless_##sfx(base, len, x);			\
+}																						\
+																						\
+size_t binarysearch_upper_bound_##sfx(const T* arr, size_t n, T x)						\
+{																						\
+	const T* base = arr;																\
+	size_t len = n;																		\
+	while (len > BINARYSEARCH_BLOCK) {													\
+		size_t half = len / 2;															\
+		__builtin_prefetch(base + half / 2);											\
+		__builtin_prefetch(base + half + half / 2);										\
+		base = (base[half - 1] <= x) ? base + half : base;								\
+		len -= half;																	\
+	}																					\
+																						\
+	return (size_t)(base - arr) + binarysearch_countlesseq_##sfx(base, len, x);			\
+}																						\
+																						\
+void binarysearch_lower_bound_batch_##sfx(const T* arr, size_t n, const T* needles,		\
+										size_t m, size_t* out)							\
+{																						\
+	size_t pos[BINARYSEARCH_BATCH];														\
+	for (size_t g = 0; g < m; g += BINARYSEARCH_BATCH) {								\
+		size_t count = (m - g < BINARYSEARCH_BATCH) ? m - g : BINARYSEARCH_BATCH;		\
+		const T* x = needles + g;														\
+		for (size_t j = 0; j < count; j++)												\
+			pos[j] = 0;																	\
+																						\
+		/* same level for every needle of the group: their loads are independent */	\
+		size_t len = n;																	\
+		while (len > BINARYSEARCH_BLOCK) {												\
+			size_t half = len / 2;														\
+			for (size_t j = 0; j < count; j++) {										\
+				const T* base = arr + pos[j];											\
+				__builtin_prefetch(base + half / 2);									\
+				__builtin_prefetch(base + half + half / 2);								\
+				pos[j] += (base[half - 1] < x[j]) ? half : 0;							\
+			}																			\
+			len -= half;																\
+		}																				\
+																						\
+		for (size_t j = 0; j < count; j++)												\
+			out[g + j] = pos[j] + binarysearch_countless_##sfx(arr + pos[j], len, x[j]);	\
+	}																					\
+}																						\
+																						\
+/* in order walk of the implicit tree, returns next index of 'sorted' */				\
+size_t binarysearch_eytzinger_fill_##sfx(const T* sorted, size_t i, T* out,				\
+										size_t* ranks, size_t k, size_t n)				\
+{																						\
+	if (k <= n) {																		\
+		i = binarysearch_eytzinger_fill_##sfx(sorted, i, out, ranks, 2 * k, n);			\
+		out[k] = sorted[i];																\
+		if (ranks)																		\
+			ranks[k] = i;																\
+		i = binarysearch_eytzinger_fill_##sfx(sorted, i + 1, out, ranks, 2 * k + 1, n);	\
+	}																					\
+																						\
+	return i;																			\
+}																						\
+																						\
+void binarysearch_eytzinger_build_##sfx(const T* sorted, size_t n, T* out, size_t* ranks)	\
+{																						\
+	binarysearch_eytzinger_fill_##sfx(sorted, 0, out, ranks, 1, n);					\
+	if (ranks)																			\
+		ranks[0] = n;																	\
+}																						\
+																						\
+size_t binarysearch_eytzinger_lower_bound_##sfx(const T* eyt, size_t n, T x)			\
+{																						\
+	/* descendants of k 4 levels down: slots 16k..16k+15 */								\
+	size_t k = 1;																		\
+	while (k <= n) {																	\
+		if (16 * k <= n)																\
+			__builtin_prefetch(eyt + 16 * k);											\
+		k = 2 * k + (eyt[k] < x);														\
+	}																					\
+																						\
+	/* drop the right turns taken after the last left turn (the answer) */				\
+	k >>= __builtin_ffsll((long long)~k);												\
+	return k;																			\
+}
 
+BINARYSEARCH_DEFINE(i32, int32_t)
+BINARYSEARCH_DEFINE(i64, int64_t)
+BINARYSEARCH_DEFINE(f64, double)
@@ -92,20 +92,83 @@
  *   Useful algorithm for building more complex algorithms in computer graphics
  *   and machine learning.
  *
+ * Search kernels for sorted arrays of numbers (int32_t, int64_t, double)
+ *
+ *   binarySearch works on 'void*' arrays through a compare function. The typed kernels
+ *   below search the numbers in place and compare them directly:
+ *
+ *   	- lower/upper bound: branchless loop (the compiler emits a conditional move, no
+ *   	  mispredicted branch per level), both next probes are prefetched and the last
+ *   	  BINARYSEARCH_BLOCK elements are counted with a SIMD compare (SSE2 for int32_t
+ *   	  and double, scalar loop otherwise);
+ *   	- batch: searches many needles at once, level by level, so the cache misses of
+ *   	  the different needles overlap instead of being paid one after the other;
+ *   	- Eytzinger layout: the sorted array stored in BFS order of an implicit binary
+ *   	  tree (children of slot k are 2k and 2k+1). The first levels share few cache
+ *   	  lines and the 16 descendants of a node, 4 levels down, are contiguous, so they
+ *   	  are prefetched with one request while the search goes down.
+ *
+ *   Double arrays must not contain NaN.
+ *
+ *   Source: P. Khuong, P. Morin, "Array Layouts for Comparison-Based Searching",
+ *   		  ACM JEA 22 (2017).
+ *
  */
 
 #ifndef BINARYSEARCH_H_
 	#define BINARYSEARCH_H_
 
 	#include <stdio.h>
+	#include <stddef.h>
+	#include <stdint.h>
 
-	/* A recursive binary search function. It returns
+	#define BINARYSEARCH_BLOCK 16			// elements counted with SIMD at the end
+	#define BINARYSEARCH_BATCH 8			// needles searched together
+
+	/* An iterative binary search function. It returns
 	 * location of x in given array arr[l..r] is present, otherwise -1.
 	 * comparefunc is a function that returns 0 if first arg equals second arg,
 	 * 1 if is greater than, -1 if is less than.
 	 *  */
 	int binarySearch(void* arr[], int l, int r, void* x, int (*comparefunc)(void* a, void* b));
 
+	/*
+	 * Typed search kernels (suffix i32: int32_t, i64: int64_t, f64: double).
+	 *
+	 * lower_bound: returns the index of the first element of sorted 'arr' not lesser than
+	 * 'x' (n if there is none); upper_bound: the index of the first element greater than 'x'.
+	 *
+	 * lower_bound_batch: writes in out[i] the lower bound of needles[i] (m needles).
+	 *
+	 * eytzinger_build: writes the n elements of 'sorted' in Eytzinger order in out[1..n]
+	 * ('out' has n + 1 elements, out[0] is not used; allocate it 64 bytes aligned, ex:
+	 * aligned_alloc). If 'ranks' is defined (n + 1 elements), ranks[k] receives the index
+	 * in 'sorted' of out[k].
+	 *
+	 * eytzinger_lower_bound: returns the slot k (1..n) of the first element not lesser
+	 * than 'x' in an Eytzinger array, 0 if there is none (ranks[k] gives its sorted index).
+	 * */
+	size_t binarysearch_lower_bound_i32(const int32_t* arr, size_t n, int32_t x);
+	size_t binarysearch_upper_bound_i32(const int32_t* arr, size_t n, int32_t x);
+	void binarysearch_lower_bound_batch_i32(const int32_t* arr, size_t n, const int32_t* needles,
+											size_t m, size_t* out);
+	void binarysearch_eytzinger_build_i32(const int32_t* sorted, size_t n, int32_t* out, size_t* ranks);
+	size_t binarysearch_eytzinger_lower_bound_i32(const int32_t* eyt, size_t n, int32_t x);
+
+	size_t binarysearch_lower_bound_i64(const int64_t* arr, size_t n, int64_t x);
+	size_t binarysearch_upper_bound_i64(const int64_t* arr, size_t n, int64_t x);
+	void binarysearch_lower_bound_batch_i64(const int64_t* arr, size_t n, const int64_t* needles,
+											size_t m, size_t* out);
+	void binarysearch_eytzinger_build_i64(const int64_t* sorted, size_t n, int64_t* out, size_t* ranks);
+	size_t binarysearch_eytzinger_lower_bound_i64(const int64_t* eyt, size_t n, int64_t x);
+
+	size_t binarysearch_lower_bound_f64(const double* arr, size_t n, double x);
+	size_t binarysearch_upper_bound_f64(const double* arr, size_t n, double x);
+	void binarysearch_lower_bound_batch_f64(const double* arr, size_t n, const double* needles,
+											size_t m, size_t* out);
+	void binarysearch_eytzinger_build_f64(const double* sorted, size_t n, double* out, size_t* ranks);
+	size_t binarysearch_eytzinger_lower_bound_f64(const double* eyt, size_t n, double x);
+
 #endif /* BINARYSEARCH_H_ */
 
 
@@ -75,9 +75,10 @@
  * Returns pointer to created binary tree instance is succeeded, NULL otherwise.
  */
 struct binarytree* bst_create(void* rootdata, binarytree_cmp comparefunc, binarytree_freedata freedatafunc,
-									 binarytree_printnode printnodefunc, binarytree_copydata copydatafunc)
+									 binarytree_printnode printnodefunc, binarytree_copydata copydatafunc,
+									 struct nodearena* arena)
 {
-	struct binarytree* result = binarytree_create(rootdata, comparefunc, freedatafunc, printnodefunc, copydatafunc);
+	struct binarytree* result = binarytree_create(rootdata, comparefunc, freedatafunc, printnodefunc, copydatafunc, arena);
 	return result;
 }
 
@@ -113,7 +114,7 @@ struct binarytreenode* bst_insert(struct binarytree* tree, struct binarytreenode
 {
 	// If the tree is empty, return a new node
 	if (root == NULL) {
-		return binarytree_createnode(data);
+		return binarytree_createnode(tree, data);
 	}
 	else {
 		if (tree->compare(root->data, data) > 0)
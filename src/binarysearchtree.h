@@ -73,10 +73,12 @@
 
 	/*
 	 * Function to create a new binary (search) tree.
+	 * If 'arena' is not NULL nodes are allocated from it (see binarytree_create).
 	 * Returns pointer to created binary tree instance is succeeded, NULL otherwise.
 	 */
 	struct binarytree* bst_create(void* rootdata, binarytree_cmp comparefunc, binarytree_freedata freedatafunc,
-										 binarytree_printnode printnodefunc, binarytree_copydata copydatafunc);
+										 binarytree_printnode printnodefunc, binarytree_copydata copydatafunc,
+										 struct nodearena* arena);
 
 	/*
 	 * Insert a value in a Binary Search Tree:
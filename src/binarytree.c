@@ -155,6 +155,7 @@
 #include "binarytree.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <assert.h>
 #include "linkedlistqueue.h"
 #include <string.h>
 
@@ -163,10 +164,17 @@
  * Returns pointer to created binary tree instance is succeeded, NULL otherwise.
  */
 struct binarytree* binarytree_create(void* rootdata, binarytree_cmp comparefunc, binarytree_freedata freedatafunc,
-									 binarytree_printnode printnodefunc, binarytree_copydata copydatafunc) {
+									 binarytree_printnode printnodefunc, binarytree_copydata copydatafunc,
+									 struct nodearena* arena) {
+	assert((arena == NULL) || (arena->nodesize >= sizeof(struct binarytreenode)));
+
 	struct binarytree* result = (struct binarytree*)malloc(sizeof(*result));
 	if (result != NULL) {
-		struct binarytreenode* root = binarytree_createnode(rootdata);
+		result->arena = arena;
+		result->levelorder = NULL;
+		result->levelcount = 0;
+		result->levelcapacity = 0;
+		struct binarytreenode* root = binarytree_createnode(result, rootdata);
 
 		if (root == NULL) {
 			free(result);
@@ -184,12 +192,54 @@ struct binarytree* binarytree_create(void* rootdata, binarytree_cmp comparefunc,
 	return result;
 }
 
+/*
+ * Function to create a new binary tree in complete tree mode: the tree keeps its
+ * nodes in level order in an array (node i has children 2i+1 and 2i+2), so
+ * binarytree_insertnode_levelordered links the new node to its parent in O(1)
+ * amortized, binarytree_delete finds the deepest node in O(1) and
+ * binarytree_levelorder walks the array. Nodes come from 'arena' (created if NULL),
+ * so inserted nodes are also contiguous in memory; the tree owns the arena.
+ * Note: in this mode the tree must only be changed by binarytree_insertnode_levelordered
+ * (at the tree root), binarytree_delete and binarytree_clear, never by linking nodes.
+ * Returns pointer to created binary tree instance is succeeded, NULL otherwise.
+ */
+struct binarytree* binarytree_create_complete(void* rootdata, binarytree_cmp comparefunc, binarytree_freedata freedatafunc,
+											  binarytree_printnode printnodefunc, binarytree_copydata copydatafunc,
+											  struct nodearena* arena) {
+	struct nodearena* nodes = (arena != NULL) ? arena : nodearena_create(sizeof(struct binarytreenode), 0);
+	if (nodes == NULL)
+		return NULL;
+
+	struct binarytree* result = binarytree_create(rootdata, comparefunc, freedatafunc, printnodefunc,
+												  copydatafunc, nodes);
+	if (result == NULL) {
+		nodearena_destroy(nodes);
+		return NULL;
+	}
+
+	result->levelcapacity = BINARYTREE_LEVELORDER_CAPACITY;
+	result->levelorder = (struct binarytreenode**)malloc(result->levelcapacity * sizeof(struct binarytreenode*));
+	if (result->levelorder == NULL) {
+		binarytree_destroy(result);
+		return NULL;
+	}
+
+	result->levelorder[0] = result->root;
+	result->levelcount = 1;
+	return result;
+}
+
 /*
  * Function to create a new binary tree node.
  */
-struct binarytreenode* binarytree_createnode(void* data)
+struct binarytreenode* binarytree_createnode(struct binarytree* tree, void* data)
 {
-	struct binarytreenode* newnode = malloc(sizeof(*newnode));
+	struct binarytreenode* newnode = NULL;
+	if (tree->arena != NULL)
+		newnode = nodearena_alloc(tree->arena);
+	else
+		newnode = malloc(sizeof(*newnode));
+
 	if (newnode == NULL) {
 		fprintf(stderr, "Error allocating memory for new binary tree node.");
 		return NULL;
@@ -308,11 +358,46 @@ int binarytree_getSizeIt(const struct binarytree* tree)
 * Returns root node.
 *
 * */
-struct binarytreenode* binarytree_insertnode_levelordered(struct binarytreenode* root, void* data)
+struct binarytreenode* binarytree_insertnode_levelordered(struct binarytree* tree, struct binarytreenode* root, void* data)
 {
+	// complete tree mode: the first empty place is a child of node (count - 1) / 2
+	if ((tree->levelorder != NULL) && (root == tree->root)) {
+		if (tree->levelcount == tree->levelcapacity) {
+			size_t capacity = tree->levelcapacity * 2;
+			struct binarytreenode** levelorder = (struct binarytreenode**)realloc( tree->levelorder,
+														capacity * sizeof(struct binarytreenode*) );
+			if (levelorder == NULL) {
+				printf("Memory error: failed to allocate memory for binary tree level order array!");
+				abort();
+			}
+
+			tree->levelorder = levelorder;
+			tree->levelcapacity = capacity;
+		}
+
+		struct binarytreenode* newnode = binarytree_createnode(tree, data);
+		if (newnode == NULL)
+			return root;
+
+		size_t index = tree->levelcount++;
+		tree->levelorder[index] = newnode;
+		if (index == 0) {
+			tree->root = newnode;
+			return newnode;
+		}
+
+		struct binarytreenode* parent = tree->levelorder[(index - 1) / 2];
+		if (index % 2 == 1)
+			parent->left = newnode;
+		else
+			parent->right = newnode;
+
+		return root;
+	}
+
 	// If the tree is empty, assign new node address to root
 	if (root == NULL) {
-		root = binarytree_createnode(data);
+		root = binarytree_createnode(tree, data);
 		return root;
 	}
 
@@ -328,7 +413,7 @@ struct binarytreenode* binarytree_insertnode_levelordered(struct binarytreenode*
 		if (temp->left != NULL)
 			linkedlistqueue_enqueue(q, temp->left);
 		else {
-			temp->left = binarytree_createnode(data);
+			temp->left = binarytree_createnode(tree, data);
 			linkedlistqueue_destroy(q);
 			return root;
 		}
@@ -336,7 +421,7 @@ struct binarytreenode* binarytree_insertnode_levelordered(struct binarytreenode*
 		if (temp->right != NULL)
 			linkedlistqueue_enqueue(q, temp->right);
 		else {
-			temp->right = binarytree_createnode(data);
+			temp->right = binarytree_createnode(tree, data);
 			linkedlistqueue_destroy(q);
 			return root;
 		}
@@ -433,6 +518,41 @@ void binarytree_postorder(struct binarytreenode* node, void (*visit)(struct bina
 	visit(node);
 }
 
+/*
+* Given a binary tree, visit its nodes in level order (breadth first: root, then
+* each level from left to right). Trees in complete tree mode walk their level
+* order array (contiguous, no queue), others use a queue.
+*
+* */
+void binarytree_levelorder(struct binarytree* tree, void (*visit)(struct binarytreenode* node))
+{
+	if (tree->levelorder != NULL) {
+		for (size_t i = 0; i < tree->levelcount; ++i)
+			visit(tree->levelorder[i]);
+
+		return;
+	}
+
+	if (tree->root == NULL)
+		return;
+
+	struct linkedlistqueue* q = linkedlistqueue_create();
+	linkedlistqueue_enqueue(q, tree->root);
+
+	while (!linkedlistqueue_isempty(q)) {
+		struct binarytreenode* node = linkedlistqueue_dequeue(q);
+		visit(node);
+
+		if (node->left != NULL)
+			linkedlistqueue_enqueue(q, node->left);
+
+		if (node->right != NULL)
+			linkedlistqueue_enqueue(q, node->right);
+	}
+
+	linkedlistqueue_destroy(q);
+}
+
 /*
  * Releases binary tree node and its data from memory.
  * */
@@ -440,7 +560,10 @@ void binarytree_destroynode(struct binarytree* t, struct binarytreenode* node) {
 	if ((t->freedata != NULL) && (node->data != NULL))
 		t->freedata(node->data);
 
-	free(node);
+	if (t->arena != NULL)
+		nodearena_free(t->arena, node);
+	else
+		free(node);
 }
 
 /* Auxiliary function to delete the given deepest node
@@ -493,6 +616,46 @@ void binarytree_deletedeepest(struct binarytree* t, struct binarytreenode* d_nod
 	linkedlistqueue_destroy(q);
 }
 
+/*
+ * Deletes an element from a tree in complete tree mode: the data of the last node
+ * in level order is copied to the node of the key and the last node is unlinked.
+ * Returns root node, NULL if the tree became empty.
+ * Note: Private function.
+ * */
+struct binarytreenode* binarytree_delete_complete(struct binarytree* tree, void* key)
+{
+	size_t found = 0;
+	while ((found < tree->levelcount) && (tree->compare(tree->levelorder[found]->data, key) != 0))
+		found++;
+
+	if (found == tree->levelcount)
+		return tree->root;	// not found
+
+	size_t last = tree->levelcount - 1;
+	struct binarytreenode* deepest = tree->levelorder[last];
+	tree->levelcount--;
+
+	if (last == 0) {
+		binarytree_destroynode(tree, deepest);
+		tree->root = NULL;
+		return NULL;
+	}
+
+	// important: to avoid memory corruption of nodes data pointer
+	if (found != last)
+		tree->copydata(tree->levelorder[found]->data, deepest->data);	// hard copy
+
+	struct binarytreenode* parent = tree->levelorder[(last - 1) / 2];
+	if (last % 2 == 1)
+		parent->left = NULL;
+	else
+		parent->right = NULL;
+
+	deepest->data = NULL;	// avoid destroy node's data
+	binarytree_destroynode(tree, deepest);
+	return tree->root;
+}
+
 /*
 * Function to delete element in binary tree
 *
@@ -509,6 +672,9 @@ struct binarytreenode* binarytree_delete(struct binarytree* tree, void* key)
 	if (root == NULL)
 		return NULL;
 
+	if (tree->levelorder != NULL)
+		return binarytree_delete_complete(tree, key);
+
    if (root->left == NULL && root->right == NULL) {
 	   if (tree->compare(root->data, key) == 0)
 		   return NULL;
@@ -1004,7 +1170,27 @@ void binarytree_deallocate(struct binarytree* tree, struct binarytreenode* root)
  * Releases all nodes from binary tree.
  * */
 void binarytree_clear(struct binarytree* tree) {
-	binarytree_deallocate(tree, tree->root);
+	if (tree->levelorder != NULL) {
+		// complete tree mode: data is released walking the array
+		if (tree->freedata != NULL)
+			for (size_t i = 0; i < tree->levelcount; ++i)
+				if (tree->levelorder[i]->data != NULL)
+					tree->freedata(tree->levelorder[i]->data);
+
+		nodearena_reset(tree->arena);
+		tree->levelcount = 0;
+	}
+	else if (tree->arena == NULL)
+		binarytree_deallocate(tree, tree->root);
+	else {
+		// only data needs a walk, nodes go away with the arena blocks
+		if (tree->freedata != NULL)
+			binarytree_deallocate(tree, tree->root);
+
+		nodearena_reset(tree->arena);
+	}
+
+	tree->root = NULL;
 }
 
 /*
@@ -1012,5 +1198,10 @@ void binarytree_clear(struct binarytree* tree) {
  * */
 void binarytree_destroy(struct binarytree* tree) {
 	binarytree_clear(tree);	// release nodes and data
+
+	if (tree->arena != NULL)
+		nodearena_destroy(tree->arena);
+
+	free(tree->levelorder);
 	free(tree);				// release tree struct
 }
@@ -155,6 +155,10 @@
 #ifndef BINARYTREE_H_
 	#define BINARYTREE_H_
 
+	#include "nodearena.h"
+
+	#define BINARYTREE_LEVELORDER_CAPACITY 16	// initial level order array size (complete tree mode)
+
 	// represents a node in the binary tree
 	struct binarytreenode {
 		void* data;
@@ -174,19 +178,40 @@
 		binarytree_cmp compare;			// comoare function (returns 0, 1 or -1)
 		binarytree_freedata freedata;	// function to release data from memory.
 		binarytree_printnode printnode;	// function to print data node
+		struct nodearena* arena;		// node arena (NULL if nodes are malloc'ed)
+		struct binarytreenode** levelorder;	// complete tree mode: nodes in level order (NULL otherwise)
+		size_t levelcount;				// nodes in 'levelorder'
+		size_t levelcapacity;
 	};
 
 	/*
 	 * Function to create a new binary tree..
+	 * If 'arena' is not NULL nodes are allocated from it (node size must be at
+	 * least sizeof(struct binarytreenode)); the tree owns the arena and releases it
+	 * when destroyed.
 	 * Returns pointer to created binary tree instance is succeeded, NULL otherwise.
 	 */
 	struct binarytree* binarytree_create(void* rootdata, binarytree_cmp comparefunc, binarytree_freedata freedatafunc,
-			binarytree_printnode printnodefunc, binarytree_copydata copydatafunc);
+			binarytree_printnode printnodefunc, binarytree_copydata copydatafunc, struct nodearena* arena);
+
+	/*
+	 * Function to create a new binary tree in complete tree mode: the tree keeps its
+	 * nodes in level order in an array (node i has children 2i+1 and 2i+2), so
+	 * binarytree_insertnode_levelordered links the new node to its parent in O(1)
+	 * amortized, binarytree_delete finds the deepest node in O(1) and
+	 * binarytree_levelorder walks the array. Nodes come from 'arena' (created if NULL),
+	 * so inserted nodes are also contiguous in memory; the tree owns the arena.
+	 * Note: in this mode the tree must only be changed by binarytree_insertnode_levelordered
+	 * (at the tree root), binarytree_delete and binarytree_clear, never by linking nodes.
+	 * Returns pointer to created binary tree instance is succeeded, NULL otherwise.
+	 */
+	struct binarytree* binarytree_create_complete(void* rootdata, binarytree_cmp comparefunc, binarytree_freedata freedatafunc,
+			binarytree_printnode printnodefunc, binarytree_copydata copydatafunc, struct nodearena* arena);
 
 	/*
 	 * Function to create a new binary tree node.
 	 */
-	struct binarytreenode* binarytree_createnode(void* data);
+	struct binarytreenode* binarytree_createnode(struct binarytree* tree, void* data);
 
 	/*
 	 * Computes the number of nodes in a binary tree using recursion.
@@ -244,10 +269,14 @@
     * we make the new key as the right child. We keep traversing the tree until
     * we find a node whose either left or right child is empty.
     *
+    * Trees in complete tree mode (see binarytree_create_complete) skip the traversal
+    * when inserting at the tree root: the first empty place is the child of node
+    * (count - 1) / 2 of the level order array, so insert is O(1) amortized.
+    *
     * Returns root node.
     *
     * */
-	struct binarytreenode* binarytree_insertnode_levelordered(struct binarytreenode* root, void* data);
+	struct binarytreenode* binarytree_insertnode_levelordered(struct binarytree* tree, struct binarytreenode* root, void* data);
 
    /*
     * Given a binary tree, process its nodes in inorder.
@@ -297,6 +326,14 @@
     */
 	void binarytree_postorder(struct binarytreenode* node, void (*visit)(struct binarytreenode* node));
 
+   /*
+    * Given a binary tree, visit its nodes in level order (breadth first: root, then
+    * each level from left to right). Trees in complete tree mode walk their level
+    * order array (contiguous, no queue), others use a queue.
+    *
+    * */
+	void binarytree_levelorder(struct binarytree* tree, void (*visit)(struct binarytreenode* node));
+
    /*
     * Function to delete element in binary tree
     *
@@ -304,6 +341,9 @@
     * shrinks from the bottom (i.e. the deleted node is replaced by the bottom-
     * most and rightmost node).
     *
+    * In complete tree mode the key is searched in the level order array and the
+    * deepest node is its last element.
+    *
     * */
 	struct binarytreenode* binarytree_delete(struct binarytree* tree, void* key);
 
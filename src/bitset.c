@@ -0,0 +1,208 @@
+/*
+ * bitset.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Fixed size bitset with popcount rank and SSE2 set algebra.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitset.h"
+
+#if defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
+
+/*
+ * Creates a new empty bitset for integers in [0, nbits).
+ * Returns the new bitset if succeeded, NULL otherwise.
+ * */
+struct bitset* bitset_create(size_t nbits)
+{
+	struct bitset* set = (struct bitset*)malloc(sizeof(struct bitset));
+	if (set == NULL) {
+		printf("Memory error: failed to allocate memory for bitset!\n");
+		return NULL;
+	}
+
+	set->nbits = nbits;
+	set->nwords = (nbits + 63) / 64;
+
+	// whole cache lines (aligned_alloc size must be a multiple of the alignment)
+	size_t bytes = set->nwords * sizeof(uint64_t);
+	bytes = ((bytes + BITSET_CACHE_LINE - 1) / BITSET_CACHE_LINE) * BITSET_CACHE_LINE;
+	set->words = (uint64_t*)aligned_alloc(BITSET_CACHE_LINE, (bytes > 0) ? bytes : BITSET_CACHE_LINE);
+	if (set->words == NULL) {
+		printf("Memory error: failed to allocate memory for bitset words!\n");
+		free(set);
+		return NULL;
+	}
+
+	bitset_clearall(set);
+	return set;
+}
+
+/*
+ * Gets the number of set bits of 'n' words.
+ * */
+size_t bitset_words_count(const uint64_t* words, size_t n)
+{
+	size_t result = 0;
+	for (size_t i = 0; i < n; i++)
+		result += __builtin_popcountll(words[i]);
+
+	return result;
+}
+
+/*
+ * Gets the number of set bits.
+ * */
+size_t bitset_count(const struct bitset* set)
+{
+	return bitset_words_count(set->words, set->nwords);
+}
+
+/*
+ * Gets the number of set bits lesser than 'i' (rank), in O(i / 64).
+ * */
+size_t bitset_rank(const struct bitset* set, size_t i)
+{
+	if (i >= set->nbits)
+		return bitset_count(set);
+
+	size_t result = bitset_words_count(set->words, i / 64);
+	if (i % 64 != 0)
+		result += __builtin_popcountll(set->words[i / 64] & ((1ULL << (i % 64)) - 1));
+
+	return result;
+}
+
+/*
+ * Gets the first set bit not lesser than 'i'.
+ * Returns its index, nbits if there is none.
+ * */
+size_t bitset_next(const struct bitset* set, size_t i)
+{
+	if (i >= set->nbits)
+		return set->nbits;
+
+	size_t w = i / 64;
+	uint64_t word = set->words[w] & (~0ULL << (i % 64));
+	while (word == 0) {
+		if (++w == set->nwords)
+			return set->nbits;
+
+		word = set->words[w];
+	}
+
+	return w * 64 + __builtin_ctzll(word);
+}
+
+/*
+ * Clears all bits.
+ * */
+void bitset_clearall(struct bitset* set)
+{
+	memset(set->words, 0, set->nwords * sizeof(uint64_t));
+}
+
+/*
+ * Word kernels: dst[i] = dst[i] op src[i] for 'n' words, two words per SSE2 instruction.
+ * Returns the number of set bits of the 'n' words of 'dst'.
+ * */
+#if defined(__SSE2__)
+	#define BITSET_WORDS_KERNEL(name, sse2op, op)										\
+		size_t name(uint64_t* dst, const uint64_t* src, size_t n)						\
+		{																				\
+			size_t result = 0, i = 0;													\
+			for (; i + 2 <= n; i += 2) {												\
+				__m128i a = _mm_loadu_si128((const __m128i*)(dst + i));					\
+				__m128i b = _mm_loadu_si128((const __m128i*)(src + i));					\
+				_mm_storeu_si128((__m128i*)(dst + i), sse2op);							\
+				result += __builtin_popcountll(dst[i]) + __builtin_popcountll(dst[i + 1]);	\
+			}																			\
+			for (; i < n; i++) {														\
+				dst[i] = op;															\
+				result += __builtin_popcountll(dst[i]);									\
+			}																			\
+			return result;																\
+		}
+#else
+	#define BITSET_WORDS_KERNEL(name, sse2op, op)										\
+		size_t name(uint64_t* dst, const uint64_t* src, size_t n)						\
+		{																				\
+			size_t result = 0;															\
+			for (size_t i = 0; i < n; i++) {											\
+				dst[i] = op;															\
+				result += __builtin_popcountll(dst[i]);									\
+			}																			\
+			return result;																\
+		}
+#endif
+
+BITSET_WORDS_KERNEL(bitset_words_and, _mm_and_si128(a, b), dst[i] & src[i])
+BITSET_WORDS_KERNEL(bitset_words_or, _mm_or_si128(a, b), dst[i] | src[i])
+BITSET_WORDS_KERNEL(bitset_words_andnot, _mm_andnot_si128(b, a), dst[i] & ~src[i])
+BITSET_WORDS_KERNEL(bitset_words_xor, _mm_xor_si128(a, b), dst[i] ^ src[i])
+
+/*
+ * Clears the bits past 'nbits' in the last word (set by a longer source bitset).
+ * Returns the number of cleared bits.
+ * Note: Private function.
+ * */
+size_t bitset_trim(struct bitset* set)
+{
+	if (set->nbits % 64 == 0)
+		return 0;
+
+	uint64_t* last = &(set->words[set->nwords - 1]);
+	uint64_t extra = *last & ~((1ULL << (set->nbits % 64)) - 1);
+	*last ^= extra;
+	return __builtin_popcountll(extra);
+}
+
+/*
+ * Combines 'src' into 'dst' (dst = dst op src) over the common range.
+ * Bits of 'dst' past the range of 'src' are cleared by AND, kept by the others.
+ * Returns the number of set bits of 'dst'.
+ * */
+size_t bitset_and(struct bitset* dst, const struct bitset* src)
+{
+	size_t n = (dst->nwords < src->nwords) ? dst->nwords : src->nwords;
+	memset(dst->words + n, 0, (dst->nwords - n) * sizeof(uint64_t));
+	return bitset_words_and(dst->words, src->words, n);
+}
+
+size_t bitset_or(struct bitset* dst, const struct bitset* src)
+{
+	size_t n = (dst->nwords < src->nwords) ? dst->nwords : src->nwords;
+	size_t result = bitset_words_or(dst->words, src->words, n)
+					+ bitset_words_count(dst->words + n, dst->nwords - n);
+	return result - bitset_trim(dst);
+}
+
+size_t bitset_andnot(struct bitset* dst, const struct bitset* src)
+{
+	size_t n = (dst->nwords < src->nwords) ? dst->nwords : src->nwords;
+	return bitset_words_andnot(dst->words, src->words, n)
+		   + bitset_words_count(dst->words + n, dst->nwords - n);
+}
+
+size_t bitset_xor(struct bitset* dst, const struct bitset* src)
+{
+	size_t n = (dst->nwords < src->nwords) ? dst->nwords : src->nwords;
+	size_t result = bitset_words_xor(dst->words, src->words, n)
+					+ bitset_words_count(dst->words + n, dst->nwords - n);
+	return result - bitset_trim(dst);
+}
+
+/*
+ * Releases the bitset from memory.
+ * */
+void bitset_destroy(struct bitset* set)
+{
+	free(set->words);
+	free(set);
+}
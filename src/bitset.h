@@ -0,0 +1,148 @@
+/*****************************************************************************
+ * bitset.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a fixed size bitset, a set of integers in a dense
+ *  			 range [0, nbits) stored as one bit per integer.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A hashset or treeset of ints pays a node allocation and several pointers per element
+ *  and a bool array pays a byte per integer. A bitset pays one bit per integer of the
+ *  range (8x less than bool arrays), so it is the right set for dense id ranges such as
+ *  the visited vertices of a graph search.
+ *
+ *  Single bit operations (test, set, clear, test_and_set) are 'static inline' below,
+ *  they are a shift and a mask. bitset_test_and_set_atomic claims a bit from several
+ *  threads (an atomic OR on its word). Whole set operations work on 64 bit words:
+ *
+ *  	- count and rank use the popcount instruction (__builtin_popcountll), 64
+ *  	  integers at a time;
+ *  	- AND, OR, ANDNOT and XOR combine two sets word by word with SSE2 (128 bits per
+ *  	  instruction, scalar code if SSE2 is not available) and return the number of
+ *  	  elements of the result. The word kernels (bitset_words_...) are also used by
+ *  	  the bitmap containers of roaring bitmaps (see roaring.h).
+ *
+ *  Words are cache line aligned. Bits past 'nbits' in the last word are always zero.
+ *
+ *  Source: https://en.wikipedia.org/wiki/Bit_array
+ *
+ *******************************************************************************/
+
+#ifndef BITSET_H_
+	#define BITSET_H_
+
+	#include <stdint.h>
+	#include <stddef.h>
+
+	#define BITSET_CACHE_LINE 64
+
+	// bitset type
+	struct bitset {
+		uint64_t* words;
+		size_t nbits;						// size of the range
+		size_t nwords;
+	};
+
+	/*
+	 * Creates a new empty bitset for integers in [0, nbits).
+	 * Returns the new bitset if succeeded, NULL otherwise.
+	 * */
+	struct bitset* bitset_create(size_t nbits);
+
+	/*
+	 * Checks if bit 'i' is set.
+	 * */
+	static inline int bitset_test(const struct bitset* set, size_t i) {
+		return (set->words[i / 64] >> (i % 64)) & 1;
+	}
+
+	/*
+	 * Sets / clears bit 'i'.
+	 * */
+	static inline void bitset_set(struct bitset* set, size_t i) {
+		set->words[i / 64] |= (1ULL << (i % 64));
+	}
+
+	static inline void bitset_clear(struct bitset* set, size_t i) {
+		set->words[i / 64] &= ~(1ULL << (i % 64));
+	}
+
+	/*
+	 * Sets bit 'i'.
+	 * Returns 1 if it was already set, 0 otherwise.
+	 * */
+	static inline int bitset_test_and_set(struct bitset* set, size_t i) {
+		uint64_t mask = 1ULL << (i % 64);
+		uint64_t word = set->words[i / 64];
+		set->words[i / 64] = word | mask;
+		return (word & mask) != 0;
+	}
+
+	/*
+	 * Sets bit 'i' atomically (threads may set bits of the same word).
+	 * Returns 1 if it was already set, 0 if the calling thread set it.
+	 * */
+	static inline int bitset_test_and_set_atomic(struct bitset* set, size_t i) {
+		uint64_t mask = 1ULL << (i % 64);
+		uint64_t* word = &(set->words[i / 64]);
+		if (__atomic_load_n(word, __ATOMIC_RELAXED) & mask)
+			return 1;		// no write on the common path
+
+		return (__atomic_fetch_or(word, mask, __ATOMIC_RELAXED) & mask) != 0;
+	}
+
+	/*
+	 * Gets the number of set bits.
+	 * */
+	size_t bitset_count(const struct bitset* set);
+
+	/*
+	 * Gets the number of set bits lesser than 'i' (rank), in O(i / 64).
+	 * */
+	size_t bitset_rank(const struct bitset* set, size_t i);
+
+	/*
+	 * Gets the first set bit not lesser than 'i'.
+	 * Returns its index, nbits if there is none.
+	 * */
+	size_t bitset_next(const struct bitset* set, size_t i);
+
+	/*
+	 * Clears all bits.
+	 * */
+	void bitset_clearall(struct bitset* set);
+
+	/*
+	 * Combines 'src' into 'dst' (dst = dst op src) over the common range.
+	 * Bits of 'dst' past the range of 'src' are cleared by AND, kept by the others.
+	 * Returns the number of set bits of 'dst'.
+	 * */
+	size_t bitset_and(struct bitset* dst, const struct bitset* src);
+	size_t bitset_or(struct bitset* dst, const struct bitset* src);
+	size_t bitset_andnot(struct bitset* dst, const struct bitset* src);
+	size_t bitset_xor(struct bitset* dst, const struct bitset* src);
+
+	/*
+	 * Word kernels: dst[i] = dst[i] op src[i] for 'n' words.
+	 * Returns the number of set bits of the 'n' words of 'dst'.
+	 * */
+	size_t bitset_words_and(uint64_t* dst, const uint64_t* src, size_t n);
+	size_t bitset_words_or(uint64_t* dst, const uint64_t* src, size_t n);
+	size_t bitset_words_andnot(uint64_t* dst, const uint64_t* src, size_t n);
+	size_t bitset_words_xor(uint64_t* dst, const uint64_t* src, size_t n);
+
+	/*
+	 * Gets the number of set bits of 'n' words.
+	 * */
+	size_t bitset_words_count(const uint64_t* words, size_t n);
+
+	/*
+	 * Releases the bitset from memory.
+	 * */
+	void bitset_destroy(struct bitset* set);
+
+#endif /* BITSET_H_ */
@@ -0,0 +1,151 @@
+/*
+ * bloomfilter.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Cache line blocked Bloom filter.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bloomfilter.h"
+
+/*
+ * Remixes a 32 bit element hash to 64 bits (splitmix64 finalizer).
+ * Note: Private function.
+ * */
+uint64_t bloomfilter_mix(int hash)
+{
+	uint64_t h = (uint64_t)(uint32_t)hash + 0x9E3779B97F4A7C15ULL;
+	h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+	return h ^ (h >> 31);
+}
+
+/*
+ * Creates a new filter for 'capacity' elements with 'bitsperelement' bits each
+ * (0 for the default).
+ * Returns the new filter if succeeded, NULL otherwise.
+ * */
+struct bloomfilter* bloomfilter_create(size_t capacity, unsigned int bitsperelement,
+									   bloomfilter_hashfunc hashfunc)
+{
+	struct bloomfilter* filter = (struct bloomfilter*)malloc(sizeof(struct bloomfilter));
+	if (filter == NULL) {
+		printf("Memory error: failed to allocate memory for bloom filter!\n");
+		return NULL;
+	}
+
+	if (bitsperelement == 0)
+		bitsperelement = BLOOMFILTER_DEFAULT_BITS;
+	if (capacity == 0)
+		capacity = 1;
+
+	// optimal k = bits per element x ln 2
+	filter->nhashes = (bitsperelement * 693 + 500) / 1000;
+	if (filter->nhashes < 1)
+		filter->nhashes = 1;
+	if (filter->nhashes > BLOOMFILTER_MAX_HASHES)
+		filter->nhashes = BLOOMFILTER_MAX_HASHES;
+
+	filter->nblocks = (capacity * bitsperelement + BLOOMFILTER_BLOCK_BITS - 1) / BLOOMFILTER_BLOCK_BITS;
+	filter->capacity = capacity;
+	filter->count = 0;
+	filter->hashfunc = hashfunc;
+	filter->blocks = (struct bloomfilter_block*)aligned_alloc( BLOOMFILTER_CACHE_LINE,
+									filter->nblocks * sizeof(struct bloomfilter_block) );
+	if (filter->blocks == NULL) {
+		printf("Memory error: failed to allocate memory for bloom filter blocks!\n");
+		free(filter);
+		return NULL;
+	}
+
+	bloomfilter_clear(filter);
+	return filter;
+}
+
+/*
+ * Gets the block of a mixed hash and the double hashing steps of its bits.
+ * Note: Private function.
+ * */
+struct bloomfilter_block* bloomfilter_locate(const struct bloomfilter* filter, uint64_t h,
+											 uint32_t* h1, uint32_t* h2)
+{
+	// high half to block index without a division (multiply-shift range reduction)
+	size_t block = (size_t)(((h >> 32) * (uint64_t)filter->nblocks) >> 32);
+	*h1 = (uint32_t)h;
+	*h2 = (uint32_t)((h * 0x9E3779B97F4A7C15ULL) >> 32) | 1;
+	return &(filter->blocks[block]);
+}
+
+/*
+ * Adds an element to the filter.
+ * */
+void bloomfilter_add(struct bloomfilter* filter, const void* element)
+{
+	uint32_t h1, h2;
+	struct bloomfilter_block* block = bloomfilter_locate(filter, bloomfilter_mix(filter->hashfunc(element)),
+														 &h1, &h2);
+	for (unsigned int i = 0; i < filter->nhashes; i++) {
+		uint32_t bit = (h1 + i * h2) % BLOOMFILTER_BLOCK_BITS;
+		block->words[bit / 64] |= (1ULL << (bit % 64));
+	}
+
+	filter->count++;
+}
+
+/*
+ * Checks if an element may be in the filter.
+ * Returns 0 if it was never added, 1 if it may have been added.
+ * */
+int bloomfilter_maycontain(const struct bloomfilter* filter, const void* element)
+{
+	uint32_t h1, h2;
+	const struct bloomfilter_block* block = bloomfilter_locate(filter,
+									bloomfilter_mix(filter->hashfunc(element)), &h1, &h2);
+	for (unsigned int i = 0; i < filter->nhashes; i++) {
+		uint32_t bit = (h1 + i * h2) % BLOOMFILTER_BLOCK_BITS;
+		if ((block->words[bit / 64] & (1ULL << (bit % 64))) == 0)
+			return 0;
+	}
+
+	return 1;
+}
+
+/*
+ * Estimates the false positive rate from the fraction of set bits, in O(nblocks).
+ * */
+double bloomfilter_fprate(const struct bloomfilter* filter)
+{
+	size_t setbits = 0;
+	for (size_t b = 0; b < filter->nblocks; b++)
+		for (int w = 0; w < BLOOMFILTER_BLOCK_BITS / 64; w++)
+			setbits += __builtin_popcountll(filter->blocks[b].words[w]);
+
+	// a false positive finds k set bits
+	double fill = (double)setbits / ((double)filter->nblocks * BLOOMFILTER_BLOCK_BITS);
+	double result = 1.0;
+	for (unsigned int i = 0; i < filter->nhashes; i++)
+		result *= fill;
+
+	return result;
+}
+
+/*
+ * Removes all elements from the filter.
+ * */
+void bloomfilter_clear(struct bloomfilter* filter)
+{
+	memset(filter->blocks, 0, filter->nblocks * sizeof(struct bloomfilter_block));
+	filter->count = 0;
+}
+
+/*
+ * Releases the filter from memory.
+ * */
+void bloomfilter_destroy(struct bloomfilter* filter)
+{
+	free(filter->blocks);
+	free(filter);
+}
@@ -0,0 +1,751 @@
+/********************************************************************************
+ * btree.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of an in-memory B+ tree of elements (ordered set
+ *  			backend).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Insertion splits full nodes on the way back up (a leaf split copies the first
+ *  element of the new right leaf to the parent, an inner split moves its middle key
+ *  up). Deletion fixes nodes left with less than half of their capacity on the way
+ *  back up, borrowing one entry from a sibling or merging with it.
+ *
+ *  Source: https://en.wikipedia.org/wiki/B%2B_tree
+ *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "btree.h"
+
+#define BTREE_LEAF_MIN (BTREE_LEAF_CAPACITY / 2)		// minimum elements of a non root leaf
+#define BTREE_INNER_MIN (BTREE_INNER_CAPACITY / 2)		// minimum keys of a non root inner node
+
+/*
+ * Function to create a new empty B+ tree.
+ * Returns pointer to created tree instance.
+ */
+struct btree* btree_create( btree_calcdatasize calcdatasizefunc, btree_cmp comparefunc,
+							btree_freedata freedatafunc, btree_printdata printdatafunc,
+							btree_copydata copydatafunc )
+{
+	struct btree* result = (struct btree*)malloc(sizeof(struct btree));
+	if (!result) {
+		printf("Memory error: failed to allocate memory for B+ tree!");
+		abort();
+	}
+
+	result->root = NULL;
+	result->first = result->last = NULL;
+	result->size = 0;
+	result->height = 0;
+	result->calcdatasize = calcdatasizefunc;
+	result->compare = comparefunc;
+	result->freedata = freedatafunc;
+	result->printdata = printdatafunc;
+	result->copydata = copydatafunc;
+	return result;
+}
+
+/*
+ * Allocates a cache line aligned node.
+ */
+void* btree_allocnode(size_t size, int leaf)
+{
+	struct btreenode* result = (struct btreenode*)aligned_alloc(BTREE_NODE_ALIGN, size);
+	if (!result) {
+		printf("Memory error: failed to allocate memory for B+ tree node!");
+		abort();
+	}
+
+	result->leaf = leaf;
+	result->count = 0;
+	return result;
+}
+
+/*
+ * Creates a new empty leaf.
+ */
+struct btreeleaf* btree_createleaf()
+{
+	struct btreeleaf* result = (struct btreeleaf*)btree_allocnode(sizeof(struct btreeleaf), 1);
+	result->prev = result->next = NULL;
+	return result;
+}
+
+/*
+ * Creates a new empty inner node.
+ */
+struct btreeinner* btree_createinner() {
+	return (struct btreeinner*)btree_allocnode(sizeof(struct btreeinner), 0);
+}
+
+/*
+ * Gets position of the first element of a leaf larger than or equal to 'key'.
+ */
+int btree_leaf_lowerbound(const struct btree* tree, const struct btreeleaf* leaf, const void* key)
+{
+	int lo = 0, hi = leaf->base.count;
+	while (lo < hi) {
+		int mid = (lo + hi) >> 1;
+		if (tree->compare(leaf->items[mid], key) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/*
+ * Gets index of the child of an inner node whose range holds 'key'
+ * (number of keys lesser than or equal to 'key').
+ */
+int btree_inner_childindex(const struct btree* tree, const struct btreeinner* node, const void* key)
+{
+	int lo = 0, hi = node->base.count;
+	while (lo < hi) {
+		int mid = (lo + hi) >> 1;
+		if (tree->compare(node->keys[mid], key) <= 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/*
+ * Gets the leaf whose range holds 'key'.
+ */
+struct btreeleaf* btree_findleaf(const struct btree* tree, const void* key)
+{
+	struct btreenode* node = tree->root;
+	if (node == NULL)
+		return NULL;
+
+	while (!node->leaf) {
+		struct btreeinner* inner = (struct btreeinner*)node;
+		node = inner->children[btree_inner_childindex(tree, inner, key)];
+	}
+
+	return (struct btreeleaf*)node;
+}
+
+/*
+ * Searches for an element equal to 'key'.
+ * Returns element instance if found, NULL otherwise.
+ */
+void* btree_search(const struct btree* tree, const void* key)
+{
+	struct btreeleaf* leaf = btree_findleaf(tree, key);
+	if (leaf == NULL)
+		return NULL;
+
+	int i = btree_leaf_lowerbound(tree, leaf, key);
+	if (i < leaf->base.count && tree->compare(leaf->items[i], key) == 0)
+		return leaf->items[i];
+
+	return NULL;
+}
+
+/*
+ * Inserts element in a leaf, splitting it if full.
+ * Returns '1' if inserted, '0' if element exists. On split the new right leaf and
+ * its first element are returned in 'splitnode_p' and 'splitkey_p'.
+ */
+int btree_leaf_insert(struct btree* tree, struct btreeleaf* leaf, void* data,
+					  void** splitkey_p, struct btreenode** splitnode_p)
+{
+	int count = leaf->base.count;
+	int i = btree_leaf_lowerbound(tree, leaf, data);
+	if (i < count && tree->compare(leaf->items[i], data) == 0)
+		return 0;
+
+	if (count < BTREE_LEAF_CAPACITY) {
+		memmove(leaf->items + i + 1, leaf->items + i, (count - i) * sizeof(void*));
+		leaf->items[i] = data;
+		leaf->base.count++;
+		return 1;
+	}
+
+	// full leaf: split in two halves
+	void* buf[BTREE_LEAF_CAPACITY + 1];
+	memcpy(buf, leaf->items, i * sizeof(void*));
+	buf[i] = data;
+	memcpy(buf + i + 1, leaf->items + i, (count - i) * sizeof(void*));
+
+	struct btreeleaf* right = btree_createleaf();
+	int leftcount = (BTREE_LEAF_CAPACITY + 1) / 2;
+	leaf->base.count = leftcount;
+	right->base.count = BTREE_LEAF_CAPACITY + 1 - leftcount;
+	memcpy(leaf->items, buf, leftcount * sizeof(void*));
+	memcpy(right->items, buf + leftcount, right->base.count * sizeof(void*));
+
+	right->prev = leaf;
+	right->next = leaf->next;
+	if (leaf->next != NULL)
+		leaf->next->prev = right;
+	else
+		tree->last = right;
+	leaf->next = right;
+
+	*splitkey_p = right->items[0];
+	*splitnode_p = (struct btreenode*)right;
+	return 1;
+}
+
+/*
+ * Inserts element in the subtree of 'node' (see btree_leaf_insert).
+ */
+int btree_insert_node(struct btree* tree, struct btreenode* node, void* data,
+					  void** splitkey_p, struct btreenode** splitnode_p)
+{
+	if (node->leaf)
+		return btree_leaf_insert(tree, (struct btreeleaf*)node, data, splitkey_p, splitnode_p);
+
+	struct btreeinner* inner = (struct btreeinner*)node;
+	int i = btree_inner_childindex(tree, inner, data);
+	void* childkey = NULL;
+	struct btreenode* childsplit = NULL;
+	int result = btree_insert_node(tree, inner->children[i], data, &childkey, &childsplit);
+	if (childsplit == NULL)
+		return result;
+
+	// new child goes right after the one that was split
+	int count = inner->base.count;
+	if (count < BTREE_INNER_CAPACITY) {
+		memmove(inner->keys + i + 1, inner->keys + i, (count - i) * sizeof(void*));
+		memmove(inner->children + i + 2, inner->children + i + 1, (count - i) * sizeof(struct btreenode*));
+		inner->keys[i] = childkey;
+		inner->children[i + 1] = childsplit;
+		inner->base.count++;
+		return result;
+	}
+
+	// full inner node: split and move middle key up
+	void* keys[BTREE_INNER_CAPACITY + 1];
+	struct btreenode* children[BTREE_INNER_CAPACITY + 2];
+	memcpy(keys, inner->keys, i * sizeof(void*));
+	keys[i] = childkey;
+	memcpy(keys + i + 1, inner->keys + i, (count - i) * sizeof(void*));
+	memcpy(children, inner->children, (i + 1) * sizeof(struct btreenode*));
+	children[i + 1] = childsplit;
+	memcpy(children + i + 2, inner->children + i + 1, (count - i) * sizeof(struct btreenode*));
+
+	struct btreeinner* right = btree_createinner();
+	int mid = (BTREE_INNER_CAPACITY + 1) / 2;
+	inner->base.count = mid;
+	right->base.count = BTREE_INNER_CAPACITY - mid;
+	memcpy(inner->keys, keys, mid * sizeof(void*));
+	memcpy(inner->children, children, (mid + 1) * sizeof(struct btreenode*));
+	memcpy(right->keys, keys + mid + 1, right->base.count * sizeof(void*));
+	memcpy(right->children, children + mid + 1, (right->base.count + 1) * sizeof(struct btreenode*));
+
+	*splitkey_p = keys[mid];
+	*splitnode_p = (struct btreenode*)right;
+	return result;
+}
+
+/*
+ * Inserts an element in the tree (elements are unique).
+ * Returns '1' (true) if inserted, '0' (false) if an equal element already exists.
+ */
+int btree_insert(struct btree* tree, void* data)
+{
+	if (tree->root == NULL) {
+		struct btreeleaf* leaf = btree_createleaf();
+		leaf->items[0] = data;
+		leaf->base.count = 1;
+		tree->root = (struct btreenode*)leaf;
+		tree->first = tree->last = leaf;
+		tree->height = 1;
+		tree->size = 1;
+		return 1;
+	}
+
+	void* splitkey = NULL;
+	struct btreenode* splitnode = NULL;
+	int result = btree_insert_node(tree, tree->root, data, &splitkey, &splitnode);
+
+	if (splitnode != NULL) {
+		// root was split: tree grows one level
+		struct btreeinner* root = btree_createinner();
+		root->base.count = 1;
+		root->keys[0] = splitkey;
+		root->children[0] = tree->root;
+		root->children[1] = splitnode;
+		tree->root = (struct btreenode*)root;
+		tree->height++;
+	}
+
+	tree->size += result;
+	return result;
+}
+
+/*
+ * Removes key 'k' and child 'k + 1' from an inner node.
+ */
+void btree_inner_removeat(struct btreeinner* node, int k)
+{
+	int count = node->base.count;
+	memmove(node->keys + k, node->keys + k + 1, (count - k - 1) * sizeof(void*));
+	memmove(node->children + k + 1, node->children + k + 2, (count - k - 1) * sizeof(struct btreenode*));
+	node->base.count--;
+}
+
+/*
+ * Unlinks a leaf from the leaves list and releases it.
+ */
+void btree_leaf_unlink(struct btree* tree, struct btreeleaf* leaf)
+{
+	if (leaf->prev != NULL)
+		leaf->prev->next = leaf->next;
+	else
+		tree->first = leaf->next;
+
+	if (leaf->next != NULL)
+		leaf->next->prev = leaf->prev;
+	else
+		tree->last = leaf->prev;
+
+	free(leaf);
+}
+
+/*
+ * Fixes underflow of child 'i' of 'parent' borrowing from or merging with a sibling.
+ */
+void btree_leaf_rebalance(struct btree* tree, struct btreeinner* parent, int i)
+{
+	struct btreeleaf* c = (struct btreeleaf*)parent->children[i];
+	struct btreeleaf* left = (i > 0) ? (struct btreeleaf*)parent->children[i - 1] : NULL;
+	struct btreeleaf* right = (i < parent->base.count) ? (struct btreeleaf*)parent->children[i + 1] : NULL;
+
+	if (left != NULL && left->base.count > BTREE_LEAF_MIN) {
+		// move last element of left sibling to the front
+		memmove(c->items + 1, c->items, c->base.count * sizeof(void*));
+		c->items[0] = left->items[--(left->base.count)];
+		c->base.count++;
+		parent->keys[i - 1] = c->items[0];
+	}
+	else if (right != NULL && right->base.count > BTREE_LEAF_MIN) {
+		// move first element of right sibling to the end
+		c->items[c->base.count++] = right->items[0];
+		memmove(right->items, right->items + 1, (--(right->base.count)) * sizeof(void*));
+		parent->keys[i] = right->items[0];
+	}
+	else if (left != NULL) {
+		memcpy(left->items + left->base.count, c->items, c->base.count * sizeof(void*));
+		left->base.count += c->base.count;
+		btree_inner_removeat(parent, i - 1);
+		btree_leaf_unlink(tree, c);
+	}
+	else {
+		memcpy(c->items + c->base.count, right->items, right->base.count * sizeof(void*));
+		c->base.count += right->base.count;
+		btree_inner_removeat(parent, i);
+		btree_leaf_unlink(tree, right);
+	}
+}
+
+/*
+ * Fixes underflow of inner child 'i' of 'parent' borrowing from or merging with a
+ * sibling (keys rotate through the parent separator).
+ */
+void btree_inner_rebalance(struct btreeinner* parent, int i)
+{
+	struct btreeinner* c = (struct btreeinner*)parent->children[i];
+	struct btreeinner* left = (i > 0) ? (struct btreeinner*)parent->children[i - 1] : NULL;
+	struct btreeinner* right = (i < parent->base.count) ? (struct btreeinner*)parent->children[i + 1] : NULL;
+	int count = c->base.count;
+
+	if (left != NULL && left->base.count > BTREE_INNER_MIN) {
+		memmove(c->keys + 1, c->keys, count * sizeof(void*));
+		memmove(c->children + 1, c->children, (count + 1) * sizeof(struct btreenode*));
+		c->keys[0] = parent->keys[i - 1];
+		c->children[0] = left->children[left->base.count];
+		c->base.count++;
+		parent->keys[i - 1] = left->keys[--(left->base.count)];
+	}
+	else if (right != NULL && right->base.count > BTREE_INNER_MIN) {
+		c->keys[count] = parent->keys[i];
+		c->children[count + 1] = right->children[0];
+		c->base.count++;
+		parent->keys[i] = right->keys[0];
+		int rcount = --(right->base.count);
+		memmove(right->keys, right->keys + 1, rcount * sizeof(void*));
+		memmove(right->children, right->children + 1, (rcount + 1) * sizeof(struct btreenode*));
+	}
+	else {
+		// merge right node into left one
+		struct btreeinner* l = (left != NULL) ? left : c;
+		struct btreeinner* r = (left != NULL) ? c : right;
+		int k = (left != NULL) ? i - 1 : i;
+		int lcount = l->base.count;
+
+		l->keys[lcount] = parent->keys[k];
+		memcpy(l->keys + lcount + 1, r->keys, r->base.count * sizeof(void*));
+		memcpy(l->children + lcount + 1, r->children, (r->base.count + 1) * sizeof(struct btreenode*));
+		l->base.count += 1 + r->base.count;
+		btree_inner_removeat(parent, k);
+		free(r);
+	}
+}
+
+/*
+ * Deletes the element equal to 'key' from the subtree of 'node'.
+ * If the smallest element of the subtree changed, the new one is returned in 'newmin_p'.
+ * Returns deleted element if succeeded, NULL otherwise.
+ */
+void* btree_delete_node(struct btree* tree, struct btreenode* node, const void* key, void** newmin_p)
+{
+	if (node->leaf) {
+		struct btreeleaf* leaf = (struct btreeleaf*)node;
+		int i = btree_leaf_lowerbound(tree, leaf, key);
+		if (i == leaf->base.count || tree->compare(leaf->items[i], key) != 0)
+			return NULL;
+
+		void* result = leaf->items[i];
+		memmove(leaf->items + i, leaf->items + i + 1, (leaf->base.count - i - 1) * sizeof(void*));
+		leaf->base.count--;
+		if (i == 0 && leaf->base.count > 0)
+			*newmin_p = leaf->items[0];
+
+		return result;
+	}
+
+	struct btreeinner* inner = (struct btreeinner*)node;
+	int i = btree_inner_childindex(tree, inner, key);
+	struct btreenode* child = inner->children[i];
+	void* newmin = NULL;
+	void* result = btree_delete_node(tree, child, key, &newmin);
+	if (result == NULL)
+		return NULL;
+
+	// keep separator equal to the smallest element of the child (it may be released)
+	if (newmin != NULL) {
+		if (i > 0)
+			inner->keys[i - 1] = newmin;
+		else
+			*newmin_p = newmin;
+	}
+
+	if (child->leaf && child->count < BTREE_LEAF_MIN)
+		btree_leaf_rebalance(tree, inner, i);
+	else if (!child->leaf && child->count < BTREE_INNER_MIN)
+		btree_inner_rebalance(inner, i);
+
+	return result;
+}
+
+/*
+ * Deletes the element equal to 'key'.
+ * Returns deleted element if succeeded, NULL otherwise.
+ */
+void* btree_delete(struct btree* tree, const void* key)
+{
+	if (tree->root == NULL)
+		return NULL;
+
+	void* newmin = NULL;
+	void* result = btree_delete_node(tree, tree->root, key, &newmin);
+	if (result == NULL)
+		return NULL;
+
+	tree->size--;
+	struct btreenode* root = tree->root;
+	if (root->leaf && root->count == 0) {
+		free(root);
+		tree->root = NULL;
+		tree->first = tree->last = NULL;
+		tree->height = 0;
+	}
+	else if (!root->leaf && root->count == 0) {
+		// root has a single child: tree shrinks one level
+		tree->root = ((struct btreeinner*)root)->children[0];
+		free(root);
+		tree->height--;
+	}
+
+	return result;
+}
+
+/*
+ * Gets smallest element. Returns NULL if tree is empty.
+ */
+void* btree_min(const struct btree* tree) {
+	return (tree->first != NULL) ? tree->first->items[0] : NULL;
+}
+
+/*
+ * Gets largest element. Returns NULL if tree is empty.
+ */
+void* btree_max(const struct btree* tree) {
+	return (tree->last != NULL) ? tree->last->items[tree->last->base.count - 1] : NULL;
+}
+
+/*
+ * Gets greatest element lesser than or equal to 'key'.
+ * Returns NULL if there is no such element.
+ */
+void* btree_floor(const struct btree* tree, const void* key)
+{
+	struct btreeleaf* leaf = btree_findleaf(tree, key);
+	if (leaf == NULL)
+		return NULL;
+
+	int i = btree_leaf_lowerbound(tree, leaf, key);
+	if (i < leaf->base.count && tree->compare(leaf->items[i], key) == 0)
+		return leaf->items[i];
+
+	// only the first leaf can start above the key (separators are leaf minimums)
+	return (i > 0) ? leaf->items[i - 1] : NULL;
+}
+
+/*
+ * Finds position of the smallest element larger than or equal to 'key'.
+ * Returns its leaf (and position in 'pos_p') or NULL if there is no such element.
+ */
+struct btreeleaf* btree_lowerbound(const struct btree* tree, const void* key, int* pos_p)
+{
+	struct btreeleaf* leaf = btree_findleaf(tree, key);
+	if (leaf == NULL)
+		return NULL;
+
+	int i = btree_leaf_lowerbound(tree, leaf, key);
+	if (i == leaf->base.count) {
+		leaf = leaf->next;
+		i = 0;
+	}
+
+	*pos_p = i;
+	return leaf;
+}
+
+/*
+ * Gets smallest element larger than or equal to 'key'.
+ * Returns NULL if there is no such element.
+ */
+void* btree_ceiling(const struct btree* tree, const void* key)
+{
+	int pos = 0;
+	struct btreeleaf* leaf = btree_lowerbound(tree, key, &pos);
+	return (leaf != NULL) ? leaf->items[pos] : NULL;
+}
+
+/*
+ * Gets the number of elements lesser than 'key' (or lesser than or equal if
+ * 'inclusive' is true).
+ * Note: nodes do not keep subtree counts, leaves before 'key' are walked (O(n / 61)).
+ */
+size_t btree_rank(const struct btree* tree, const void* key, int inclusive)
+{
+	size_t result = 0;
+
+	for (struct btreeleaf* leaf = tree->first; leaf != NULL; leaf = leaf->next) {
+		int c = tree->compare(leaf->items[leaf->base.count - 1], key);
+		if (c < 0 || (inclusive && c == 0)) {
+			result += leaf->base.count;
+			continue;
+		}
+
+		// key falls inside this leaf
+		int i = btree_leaf_lowerbound(tree, leaf, key);
+		if (inclusive && i < leaf->base.count && tree->compare(leaf->items[i], key) == 0)
+			i++;
+
+		return result + i;
+	}
+
+	return result;
+}
+
+/*
+ * Gets the element at position 'k' (0 based) in ascending order.
+ * Returns NULL if 'k' is out of range.
+ * Note: leaves before position 'k' are walked (O(k / 61)).
+ */
+void* btree_select(const struct btree* tree, size_t k)
+{
+	for (struct btreeleaf* leaf = tree->first; leaf != NULL; leaf = leaf->next) {
+		if (k < (size_t)leaf->base.count)
+			return leaf->items[k];
+
+		k -= leaf->base.count;
+	}
+
+	return NULL;
+}
+
+/*
+ * Builds the tree from 'n' elements sorted in strictly ascending order, in O(n)
+ * (bottom up: full leaves first, then one level of inner nodes at a time).
+ * Tree must be empty.
+ * Returns 1 (true) if succeeded, 0 (false) if tree is not empty or elements are
+ * not sorted.
+ */
+int btree_build_sorted(struct btree* tree, void** items, size_t n)
+{
+	if (tree->root != NULL)
+		return 0;
+
+	for (size_t i = 1; i < n; ++i) {
+		if (tree->compare(items[i - 1], items[i]) >= 0)
+			return 0;
+	}
+
+	if (n == 0)
+		return 1;
+
+	// nodes of current level and smallest element of each one
+	size_t count = (n + BTREE_LEAF_CAPACITY - 1) / BTREE_LEAF_CAPACITY;
+	struct btreenode** nodes = (struct btreenode**)malloc(count * sizeof(struct btreenode*));
+	void** mins = (void**)malloc(count * sizeof(void*));
+	if (!nodes || !mins) {
+		printf("Memory error: failed to allocate memory for B+ tree bulk load!");
+		abort();
+	}
+
+	// elements are spread evenly, so no leaf is left under half full
+	struct btreeleaf* prev = NULL;
+	size_t pos = 0;
+	for (size_t j = 0; j < count; ++j) {
+		int take = (int)(n / count + (j < n % count));
+		struct btreeleaf* leaf = btree_createleaf();
+		memcpy(leaf->items, items + pos, take * sizeof(void*));
+		leaf->base.count = take;
+		pos += take;
+
+		leaf->prev = prev;
+		if (prev != NULL)
+			prev->next = leaf;
+		else
+			tree->first = leaf;
+
+		prev = leaf;
+		nodes[j] = (struct btreenode*)leaf;
+		mins[j] = leaf->items[0];
+	}
+
+	tree->last = prev;
+	tree->height = 1;
+
+	// inner levels, built in place over previous one (parent 'j' only reads entries >= j)
+	while (count > 1) {
+		size_t parents = (count + BTREE_INNER_CAPACITY) / (BTREE_INNER_CAPACITY + 1);
+		pos = 0;
+		for (size_t j = 0; j < parents; ++j) {
+			int take = (int)(count / parents + (j < count % parents));
+			struct btreeinner* inner = btree_createinner();
+			void* min = mins[pos];
+			memcpy(inner->children, nodes + pos, take * sizeof(struct btreenode*));
+			memcpy(inner->keys, mins + pos + 1, (take - 1) * sizeof(void*));
+			inner->base.count = take - 1;
+			pos += take;
+
+			nodes[j] = (struct btreenode*)inner;
+			mins[j] = min;
+		}
+
+		count = parents;
+		tree->height++;
+	}
+
+	tree->root = nodes[0];
+	tree->size = n;
+	free(nodes);
+	free(mins);
+	return 1;
+}
+
+/*
+ * Prints nodes of subtree of 'node' at a given depth.
+ */
+void btree_print_level(const struct btree* tree, const struct btreenode* node, int depth)
+{
+	if (depth > 0) {
+		const struct btreeinner* inner = (const struct btreeinner*)node;
+		for (int i = 0; i <= inner->base.count; ++i)
+			btree_print_level(tree, inner->children[i], depth - 1);
+		return;
+	}
+
+	void* const* items = node->leaf ? ((const struct btreeleaf*)node)->items
+									: ((const struct btreeinner*)node)->keys;
+	printf("[");
+	for (int i = 0; i < node->count; ++i) {
+		if (i > 0) printf(" ");
+		tree->printdata(items[i]);
+	}
+	printf("] ");
+}
+
+/*
+ * Prints tree nodes, one level per line.
+ */
+void btree_print(const struct btree* tree)
+{
+	if (!tree->printdata) {
+		printf("Error: 'printdata' function is undefined. Can't print tree.");
+		abort();
+	}
+
+	if (tree->root == NULL) {
+		printf("[]\n");
+		return;
+	}
+
+	for (int d = 0; d < tree->height; ++d) {
+		btree_print_level(tree, tree->root, d);
+		printf("\n");
+	}
+}
+
+/*
+ * Releases the nodes of subtree of 'node'.
+ */
+void btree_freenodes(struct btreenode* node)
+{
+	if (!node->leaf) {
+		struct btreeinner* inner = (struct btreeinner*)node;
+		for (int i = 0; i <= inner->base.count; ++i)
+			btree_freenodes(inner->children[i]);
+	}
+
+	free(node);
+}
+
+/*
+ * Releases all nodes and data instances from tree.
+ */
+void btree_clear(struct btree* tree)
+{
+	if (tree->freedata != NULL)
+		for (struct btreeleaf* leaf = tree->first; leaf != NULL; leaf = leaf->next)
+			for (int i = 0; i < leaf->base.count; ++i)
+				tree->freedata(leaf->items[i]);
+
+	if (tree->root != NULL)
+		btree_freenodes(tree->root);
+
+	tree->root = NULL;
+	tree->first = tree->last = NULL;
+	tree->size = 0;
+	tree->height = 0;
+}
+
+/*
+ * Releases all nodes, his data, and the tree structure instance from memory.
+ */
+void btree_destroy(struct btree* tree)
+{
+	btree_clear(tree);
+	free(tree);
+}
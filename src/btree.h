@@ -0,0 +1,181 @@
+/*****************************************************************************
+ * btree.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for an in-memory B+ tree of elements (ordered set backend).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A red-black tree holds one element per node, so a lookup follows about
+ *  2 * log2(n) pointers, each one a likely cache miss on large trees (~25 for 10M
+ *  elements). A B+ tree stores many elements per node in contiguous arrays:
+ *
+ *  	- leaf nodes hold up to 61 elements and are linked in order (prev/next), so
+ *  	  min, max, floor, ceiling and range scans walk arrays instead of chasing
+ *  	  parent pointers;
+ *  	- inner nodes hold up to 31 separator keys and 32 children, the separator
+ *  	  before child 'i' always is the smallest element of that child subtree;
+ *  	- every node is 512 bytes (8 cache lines) and cache line aligned.
+ *
+ *  A tree of 10M elements has height 5 (vs. ~24 for a red-black tree) and each node
+ *  is searched with a binary search over its array.
+ *
+ *  Elements are stored by pointer (as in the red-black tree), so comparisons still
+ *  read the elements themselves. Separators point to elements that are in the tree,
+ *  they are updated when the smallest element of a subtree is removed.
+ *
+ *  ------------------------------------------------------------------------
+ *  | Operation				| Time			| Nodes visited				   |
+ *  ------------------------------------------------------------------------
+ *  | search/floor/ceiling	| O(log n)		| height (log32(n))			   |
+ *  | insert/delete			| O(log n)		| height (+ split/merge)	   |
+ *  | min/max				| O(1)			| first/last leaf			   |
+ *  | range scan of k		| O(log n + k)	| height + k / 61 leaves	   |
+ *  ------------------------------------------------------------------------
+ *
+ *  Source: https://en.wikipedia.org/wiki/B%2B_tree
+ *
+ *******************************************************************************/
+
+#ifndef BTREE_H_
+	#define BTREE_H_
+
+	#include <stdlib.h>
+
+	#define BTREE_LEAF_CAPACITY 61		// elements of a leaf (node has 512 bytes)
+	#define BTREE_INNER_CAPACITY 31		// keys of an inner node (node has 512 bytes)
+	#define BTREE_NODE_ALIGN 64			// node alignment (cache line)
+
+	// callback functions (same as red-black tree ones)
+	typedef size_t (*btree_calcdatasize)(const void* data);
+	typedef void (*btree_copydata)(void* dest, const void* from);
+	typedef int (*btree_cmp)(const void* data1, const void* data2);
+	typedef void (*btree_freedata)(void* data);
+	typedef void (*btree_printdata)(const void* data);
+
+	// header of all nodes
+	struct btreenode {
+		int leaf;								// 1 if node is a leaf
+		int count;								// elements (leaf) or keys (inner node)
+	};
+
+	// leaf node
+	struct btreeleaf {
+		struct btreenode base;
+		struct btreeleaf* prev;				// previous leaf in order
+		struct btreeleaf* next;				// next leaf in order
+		void* items[BTREE_LEAF_CAPACITY];		// elements in ascending order
+	};
+
+	// inner node
+	struct btreeinner {
+		struct btreenode base;
+		void* keys[BTREE_INNER_CAPACITY];		// keys[i]: smallest element of children[i + 1]
+		struct btreenode* children[BTREE_INNER_CAPACITY + 1];
+	};
+
+	struct btree {
+		struct btreenode* root;				// root node (NULL if tree is empty)
+		struct btreeleaf* first;				// leaf with smallest elements
+		struct btreeleaf* last;				// leaf with largest elements
+		size_t size;							// number of elements
+		int height;							// number of levels
+		btree_calcdatasize calcdatasize;		// function to calculate size of data in bytes
+		btree_copydata copydata;				// (hard) copy data function
+		btree_cmp compare;						// compare function (returns 0, 1 or -1)
+		btree_freedata freedata;				// function to release data from memory
+		btree_printdata printdata;				// function to print data
+	};
+
+	/*
+	 * Function to create a new empty B+ tree.
+	 * Returns pointer to created tree instance.
+	 */
+	struct btree* btree_create( btree_calcdatasize calcdatasizefunc, btree_cmp comparefunc,
+								btree_freedata freedatafunc, btree_printdata printdatafunc,
+								btree_copydata copydatafunc );
+
+	/*
+	 * Searches for an element equal to 'key'.
+	 * Returns element instance if found, NULL otherwise.
+	 */
+	void* btree_search(const struct btree* tree, const void* key);
+
+	/*
+	 * Inserts an element in the tree (elements are unique).
+	 * Returns '1' (true) if inserted, '0' (false) if an equal element already exists.
+	 */
+	int btree_insert(struct btree* tree, void* data);
+
+	/*
+	 * Deletes the element equal to 'key'.
+	 * Returns deleted element if succeeded, NULL otherwise.
+	 */
+	void* btree_delete(struct btree* tree, const void* key);
+
+	/*
+	 * Gets smallest/largest element. Returns NULL if tree is empty.
+	 */
+	void* btree_min(const struct btree* tree);
+	void* btree_max(const struct btree* tree);
+
+	/*
+	 * Gets greatest element lesser than or equal to 'key'.
+	 * Returns NULL if there is no such element.
+	 */
+	void* btree_floor(const struct btree* tree, const void* key);
+
+	/*
+	 * Gets smallest element larger than or equal to 'key'.
+	 * Returns NULL if there is no such element.
+	 */
+	void* btree_ceiling(const struct btree* tree, const void* key);
+
+	/*
+	 * Finds position of the smallest element larger than or equal to 'key'.
+	 * Returns its leaf (and position in 'pos_p') or NULL if there is no such element.
+	 */
+	struct btreeleaf* btree_lowerbound(const struct btree* tree, const void* key, int* pos_p);
+
+	/*
+	 * Gets the number of elements lesser than 'key' (or lesser than or equal if
+	 * 'inclusive' is true).
+	 * Note: nodes do not keep subtree counts, leaves before 'key' are walked (O(n / 61)).
+	 */
+	size_t btree_rank(const struct btree* tree, const void* key, int inclusive);
+
+	/*
+	 * Gets the element at position 'k' (0 based) in ascending order.
+	 * Returns NULL if 'k' is out of range.
+	 * Note: leaves before position 'k' are walked (O(k / 61)).
+	 */
+	void* btree_select(const struct btree* tree, size_t k);
+
+	/*
+	 * Builds the tree from 'n' elements sorted in strictly ascending order, in O(n)
+	 * (bottom up: full leaves first, then one level of inner nodes at a time).
+	 * Tree must be empty.
+	 * Returns 1 (true) if succeeded, 0 (false) if tree is not empty or elements are
+	 * not sorted.
+	 */
+	int btree_build_sorted(struct btree* tree, void** items, size_t n);
+
+	/*
+	 * Prints tree nodes, one level per line.
+	 */
+	void btree_print(const struct btree* tree);
+
+	/*
+	 * Releases all nodes and data instances from tree.
+	 */
+	void btree_clear(struct btree* tree);
+
+	/*
+	 * Releases all nodes, his data, and the tree structure instance from memory.
+	 */
+	void btree_destroy(struct btree* tree);
+
+#endif /* BTREE_H_ */
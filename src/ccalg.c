@@ -0,0 +1,262 @@
+/*
+ * ccalg.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Connected components: union-find over the edges (sequential) and
+ * 				Shiloach-Vishkin hooking and pointer jumping (multi-threaded).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "ccalg.h"
+#include "unionfind.h"
+
+/*
+ * Labels each vertex with the smallest vertex of its set (vertices are visited in
+ * ascending order, so the first one seen of a set is its smallest).
+ * Returns the labels, number of sets in 'numcomponents_p'.
+ * Note: Private function.
+ */
+int* ccalg_labels(struct unionfind* uf, int* numcomponents_p)
+{
+	int n = uf->n;
+	int* labels = (int*)malloc(((n > 0) ? n : 1) * sizeof(int));
+	int* first = (int*)malloc(((n > 0) ? n : 1) * sizeof(int));
+	if ((labels == NULL) || (first == NULL)) {
+		printf("Memory error: failed to allocate memory for connected components!");
+		abort();
+	}
+
+	for (int v = 0; v < n; ++v)
+		first[v] = -1;
+
+	for (int v = 0; v < n; ++v) {
+		int root = unionfind_find(uf, v);
+		if (first[root] < 0)
+			first[root] = v;
+
+		labels[v] = first[root];
+	}
+
+	*numcomponents_p = unionfind_getnumsets(uf);
+	free(first);
+	return labels;
+}
+
+/*
+ * Computes the connected components of an adjacency list graph.
+ * Number of components is returned in 'numcomponents_p'.
+ * Returns the component label of each vertex (smallest vertex of the component).
+ * Note: returned array must be released later from memory.
+ */
+int* ccalg_components_adjlist(const struct adjlgraph* g, int* numcomponents_p)
+{
+	struct unionfind* uf = unionfind_create((int)g->numvertices);
+	for (size_t v = 0; v < g->numvertices; ++v)
+		if (g->vertexlist[v] != NULL)
+			for (struct adjlgedge* e = g->vertexlist[v]->edgeslist; e != NULL; e = e->next)
+				unionfind_union(uf, (int)v, e->vertexindex);
+
+	int* labels = ccalg_labels(uf, numcomponents_p);
+	unionfind_destroy(uf);
+	return labels;
+}
+
+/*
+ * Computes the connected components of a CSR graph.
+ * Number of components is returned in 'numcomponents_p'.
+ * Returns the component label of each vertex (smallest vertex of the component).
+ * Note: returned array must be released later from memory.
+ */
+int* ccalg_components_csr(const struct csrgraph* g, int* numcomponents_p)
+{
+	struct unionfind* uf = unionfind_create((int)g->numvertices);
+	for (size_t v = 0; v < g->numvertices; ++v)
+		for (size_t e = g->offsets[v]; e < g->offsets[v + 1]; ++e)
+			unionfind_union(uf, (int)v, g->targets[e]);
+
+	int* labels = ccalg_labels(uf, numcomponents_p);
+	unionfind_destroy(uf);
+	return labels;
+}
+
+// shared state of a parallel components search
+struct ccalg_parallel_state {
+	const struct csrgraph* g;
+	int n;								// number of vertices
+	_Atomic int* comp;					// component label of each vertex (result)
+	atomic_size_t hookcursor;			// next chunk of the hook phase
+	atomic_size_t compresscursor;		// next chunk of the compress phase
+	atomic_int changed;					// a root was hooked this round
+	int done;							// no change in last round
+	pthread_barrier_t barrier;			// phase barrier
+};
+
+// worker thread argument
+struct ccalg_parallel_worker {
+	struct ccalg_parallel_state* st;
+	int tid;
+	pthread_t thread;
+};
+
+/*
+ * Hook phase: links the root of the larger label of each edge below the smaller one.
+ * Note: Private function.
+ */
+void ccalg_parallel_hook(struct ccalg_parallel_state* st)
+{
+	const struct csrgraph* g = st->g;
+	_Atomic int* comp = st->comp;
+	int changed = 0;
+
+	for (;;) {
+		size_t begin = atomic_fetch_add_explicit(&(st->hookcursor), CCALG_PARALLEL_CHUNK, memory_order_relaxed);
+		if (begin >= (size_t)st->n)
+			break;
+
+		size_t end = (begin + CCALG_PARALLEL_CHUNK < (size_t)st->n) ? begin + CCALG_PARALLEL_CHUNK : (size_t)st->n;
+		for (size_t u = begin; u < end; ++u)
+			for (size_t e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+				int cu = atomic_load_explicit(&comp[u], memory_order_relaxed);
+				int cv = atomic_load_explicit(&comp[g->targets[e]], memory_order_relaxed);
+				if (cu == cv)
+					continue;
+
+				int high = (cu > cv) ? cu : cv;
+				int low = (cu > cv) ? cv : cu;
+				int root = high;
+				if ((atomic_load_explicit(&comp[high], memory_order_relaxed) == high)
+					&& atomic_compare_exchange_strong_explicit(&comp[high], &root, low,
+															   memory_order_relaxed, memory_order_relaxed))
+					changed = 1;
+			}
+	}
+
+	if (changed)
+		atomic_store_explicit(&(st->changed), 1, memory_order_relaxed);
+}
+
+/*
+ * Compress phase: points every vertex to the root of its tree.
+ * Note: Private function.
+ */
+void ccalg_parallel_compress(struct ccalg_parallel_state* st)
+{
+	_Atomic int* comp = st->comp;
+
+	for (;;) {
+		size_t begin = atomic_fetch_add_explicit(&(st->compresscursor), CCALG_PARALLEL_CHUNK, memory_order_relaxed);
+		if (begin >= (size_t)st->n)
+			break;
+
+		size_t end = (begin + CCALG_PARALLEL_CHUNK < (size_t)st->n) ? begin + CCALG_PARALLEL_CHUNK : (size_t)st->n;
+		for (size_t v = begin; v < end; ++v) {
+			int c = atomic_load_explicit(&comp[v], memory_order_relaxed);
+			int cc = atomic_load_explicit(&comp[c], memory_order_relaxed);
+			while (c != cc) {
+				c = cc;
+				cc = atomic_load_explicit(&comp[c], memory_order_relaxed);
+			}
+
+			atomic_store_explicit(&comp[v], c, memory_order_relaxed);
+		}
+	}
+}
+
+/*
+ * Worker thread loop: runs hook and compress rounds until nothing changes.
+ */
+void* ccalg_parallel_run(void* arg)
+{
+	struct ccalg_parallel_worker* w = (struct ccalg_parallel_worker*)arg;
+	struct ccalg_parallel_state* st = w->st;
+
+	while (1) {
+		ccalg_parallel_hook(st);
+		pthread_barrier_wait(&(st->barrier));
+		ccalg_parallel_compress(st);
+		pthread_barrier_wait(&(st->barrier));
+
+		if (w->tid == 0) {
+			st->done = !atomic_load(&(st->changed));
+			atomic_store(&(st->changed), 0);
+			atomic_store(&(st->hookcursor), 0);
+			atomic_store(&(st->compresscursor), 0);
+		}
+		pthread_barrier_wait(&(st->barrier));
+
+		if (st->done)
+			break;
+	}
+
+	return NULL;
+}
+
+/*
+ * Computes the connected components of a CSR graph with 'nthreads' threads
+ * (Shiloach-Vishkin, see implementation notes).
+ * Number of components is returned in 'numcomponents_p'.
+ * Returns the component label of each vertex, same labels as ccalg_components_csr.
+ * Note: returned array must be released later from memory.
+ */
+int* ccalg_components_parallel(const struct csrgraph* g, int nthreads, int* numcomponents_p)
+{
+	if (nthreads < 1) nthreads = 1;
+
+	struct ccalg_parallel_state st;
+	st.g = g;
+	st.n = (int)g->numvertices;
+	st.comp = (_Atomic int*)malloc(((st.n > 0) ? st.n : 1) * sizeof(int));
+	if (!st.comp) {
+		printf("Memory error: failed to allocate parallel components array!");
+		abort();
+	}
+
+	for (int v = 0; v < st.n; ++v)
+		atomic_init(&(st.comp[v]), v);
+
+	atomic_init(&(st.hookcursor), 0);
+	atomic_init(&(st.compresscursor), 0);
+	atomic_init(&(st.changed), 0);
+	st.done = 0;
+
+	if (pthread_barrier_init(&(st.barrier), NULL, nthreads) != 0) {
+		printf("Error: failed to initialize parallel components barrier!");
+		abort();
+	}
+
+	struct ccalg_parallel_worker* workers = malloc(nthreads * sizeof(*workers));
+	if (!workers) {
+		printf("Memory error: failed to allocate parallel components workers!");
+		abort();
+	}
+
+	for (int i = 0; i < nthreads; ++i) {
+		workers[i].st = &st;
+		workers[i].tid = i;
+		if (i > 0 && pthread_create(&(workers[i].thread), NULL, ccalg_parallel_run, &(workers[i])) != 0) {
+			printf("Error: failed to create parallel components thread!");
+			abort();
+		}
+	}
+
+	ccalg_parallel_run(&(workers[0]));	// calling thread is worker 0
+
+	for (int i = 1; i < nthreads; ++i)
+		pthread_join(workers[i].thread, NULL);
+
+	pthread_barrier_destroy(&(st.barrier));
+	free(workers);
+
+	// every vertex points to its root, the smallest vertex of its component
+	int* labels = (int*)st.comp;
+	int count = 0;
+	for (int v = 0; v < st.n; ++v)
+		count += (labels[v] == v);
+
+	*numcomponents_p = count;
+	return labels;
+}
@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * ccalg.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for connected components of adjacency list and CSR
+ *  			 graphs: sequential (union-find) and multi-threaded (Shiloach-Vishkin).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Result is a label per vertex: the smallest vertex of its component, so both
+ *  algorithms return the same array and two vertices are connected when their
+ *  labels are equal. Components of directed graphs are the weakly connected ones
+ *  (edges taken as undirected, see dfsalg_scc for strongly connected components).
+ *
+ *  The sequential version runs a union-find structure (see unionfind.h) over the
+ *  edges, then labels the vertices in one pass.
+ *
+ *  The parallel version is Shiloach-Vishkin, as in the GAP benchmark suite: every
+ *  vertex starts as its own component ('comp[v] = v') and threads repeat two phases,
+ *  separated by barriers, until a hook phase changes nothing:
+ *
+ *  	- hook: for every edge u-v with comp[u] != comp[v], when the larger label is
+ *  	  a root (comp[high] == high) it is linked below the smaller one with a CAS;
+ *  	- compress: every vertex follows comp[] up to its root (pointer jumping), so
+ *  	  trees are flat again for the next hook phase.
+ *
+ *  Roots are only linked below smaller labels and labels only decrease, so the
+ *  root of a component is its smallest vertex. Threads take chunks of
+ *  CCALG_PARALLEL_CHUNK vertices from a shared cursor, each edge is scanned from
+ *  its source only, and the number of rounds is small in practice (a few for low
+ *  diameter graphs).
+ *
+ *  Sources: Y. Shiloach, U. Vishkin, "An O(log n) Parallel Connectivity Algorithm",
+ *  		 Journal of Algorithms (1982).
+ *  		 S. Beamer, K. Asanovic, D. Patterson, "The GAP Benchmark Suite", arXiv (2015).
+ *
+ *******************************************************************************/
+
+#ifndef CCALG_H_
+	#define CCALG_H_
+
+	#include "adjlgraph.h"
+	#include "csrgraph.h"
+
+	#define CCALG_PARALLEL_CHUNK 1024		// vertices taken by a thread at once
+
+	/*
+	 * Computes the connected components of an adjacency list graph.
+	 * Number of components is returned in 'numcomponents_p'.
+	 * Returns the component label of each vertex (smallest vertex of the component).
+	 * Note: returned array must be released later from memory.
+	 */
+	int* ccalg_components_adjlist(const struct adjlgraph* g, int* numcomponents_p);
+
+	/*
+	 * Computes the connected components of a CSR graph.
+	 * Number of components is returned in 'numcomponents_p'.
+	 * Returns the component label of each vertex (smallest vertex of the component).
+	 * Note: returned array must be released later from memory.
+	 */
+	int* ccalg_components_csr(const struct csrgraph* g, int* numcomponents_p);
+
+	/*
+	 * Computes the connected components of a CSR graph with 'nthreads' threads
+	 * (Shiloach-Vishkin, see implementation notes).
+	 * Number of components is returned in 'numcomponents_p'.
+	 * Returns the component label of each vertex, same labels as ccalg_components_csr.
+	 * Note: returned array must be released later from memory.
+	 */
+	int* ccalg_components_parallel(const struct csrgraph* g, int nthreads, int* numcomponents_p);
+
+#endif /* CCALG_H_ */
@@ -0,0 +1,670 @@
+/*
+ * csrgraph.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of an immutable graph in compressed sparse row (CSR) format.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "csrgraph.h"
+#include "numanode.h"
+
+// shared state of the threads of a bulk build
+struct csrgraph_bulk_state {
+	struct csrgraph* g;							// graph being built
+	const struct adjlgraph_edgeitem* edges;		// input edges
+	size_t count;								// number of input edges
+	size_t* slots;								// degree counters, then insert positions
+	int nthreads;								// number of threads
+	void (*phase)(struct csrgraph_bulk_state* st, size_t begin, size_t end);
+};
+
+// thread argument of a bulk build phase
+struct csrgraph_bulk_worker {
+	struct csrgraph_bulk_state* st;
+	int tid;
+	pthread_t thread;
+};
+
+/*
+ * Allocates a CSR graph struct without arrays (not mapped, no payloads).
+ */
+struct csrgraph* csrgraph_alloc(adjlgraph_edgetype etype, size_t numvertices)
+{
+	struct csrgraph* result = (struct csrgraph*)malloc(sizeof(*result));
+	if (!result) {
+		printf("Memory error when allocating CSR graph struct!");
+		abort();
+	}
+
+	result->etype = etype;
+	result->numvertices = numvertices;
+	result->numarcs = 0;
+	result->offsets = NULL;
+	result->targets = NULL;
+	result->weights = NULL;
+	result->vertexpayload = NULL;
+	result->vertexrecordsize = 0;
+	result->edgepayload = NULL;
+	result->edgerecordsize = 0;
+	result->mapping = NULL;
+	result->mappingsize = 0;
+	result->numpartitions = 0;
+	result->partitions = NULL;
+	return result;
+}
+
+/*
+ * Builds an immutable CSR graph from an adjacency list graph.
+ * Edges keep the order of the source edge lists. The source graph is not changed.
+ * Returns the new CSR graph.
+ */
+struct csrgraph* adjlgraph_freeze_to_csr(const struct adjlgraph* g)
+{
+	size_t nv = g->numvertices;
+	struct csrgraph* result = csrgraph_alloc(g->etype, nv);
+	result->offsets = (size_t*)malloc((nv + 1) * sizeof(size_t));
+	if (!(result->offsets)) {
+		printf("Memory error when allocating CSR graph offsets array!");
+		abort();
+	}
+
+	// first pass: count edges of each vertex (prefix sum gives the offsets)
+	size_t count = 0;
+	struct adjlgedge* edge = NULL;
+	for (size_t v = 0; v < nv; ++v) {
+		result->offsets[v] = count;
+		if (g->vertexlist[v] != NULL)
+			for (edge = g->vertexlist[v]->edgeslist; edge != NULL; edge = edge->next)
+				count++;
+	}
+
+	result->offsets[nv] = count;
+	result->numarcs = count;
+
+	// avoid zero size allocations on graphs without edges
+	result->targets = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+	result->weights = (double*)malloc((count > 0 ? count : 1) * sizeof(double));
+	if (!(result->targets) || !(result->weights)) {
+		printf("Memory error when allocating CSR graph edge arrays!");
+		abort();
+	}
+
+	// second pass: copy edges
+	size_t pos = 0;
+	for (size_t v = 0; v < nv; ++v) {
+		if (g->vertexlist[v] != NULL)
+			for (edge = g->vertexlist[v]->edgeslist; edge != NULL; edge = edge->next) {
+				result->targets[pos] = edge->vertexindex;
+				result->weights[pos] = edge->weight;
+				pos++;
+			}
+	}
+
+	return result;
+}
+
+/*
+ * Increments the slot of vertex 'v' and returns its previous value.
+ * Atomic only when several threads share the slots.
+ */
+size_t csrgraph_bulk_next(struct csrgraph_bulk_state* st, int v)
+{
+	if (st->nthreads > 1)
+		return __atomic_fetch_add(&(st->slots[v]), 1, __ATOMIC_RELAXED);
+	else
+		return st->slots[v]++;
+}
+
+/*
+ * Bulk build phase 1: counts the edges leaving each vertex.
+ */
+void csrgraph_bulk_count(struct csrgraph_bulk_state* st, size_t begin, size_t end)
+{
+	size_t n = st->g->numvertices;
+	for (size_t i = begin; i < end; ++i) {
+		const struct adjlgraph_edgeitem* e = &(st->edges[i]);
+		if (e->from < 0 || (size_t)e->from >= n || e->to < 0 || (size_t)e->to >= n) {
+			printf("Out of range error: edge (%d, %d) vertex index must be less than %zu.", e->from, e->to, n);
+			abort();
+		}
+
+		csrgraph_bulk_next(st, e->from);
+		if (st->g->etype == UNDIRECTED_AGRAPH)
+			csrgraph_bulk_next(st, e->to);
+	}
+}
+
+/*
+ * Bulk build phase 2: places each edge at the next free position of its vertex.
+ */
+void csrgraph_bulk_place(struct csrgraph_bulk_state* st, size_t begin, size_t end)
+{
+	struct csrgraph* g = st->g;
+	for (size_t i = begin; i < end; ++i) {
+		const struct adjlgraph_edgeitem* e = &(st->edges[i]);
+		size_t pos = csrgraph_bulk_next(st, e->from);
+		g->targets[pos] = e->to;
+		g->weights[pos] = e->weight;
+
+		if (g->etype == UNDIRECTED_AGRAPH) {
+			pos = csrgraph_bulk_next(st, e->to);
+			g->targets[pos] = e->from;
+			g->weights[pos] = e->weight;
+		}
+	}
+}
+
+/*
+ * Runs a bulk build phase worker on its share of the input edges.
+ */
+void* csrgraph_bulk_run(void* arg)
+{
+	struct csrgraph_bulk_worker* w = (struct csrgraph_bulk_worker*)arg;
+	struct csrgraph_bulk_state* st = w->st;
+	size_t begin = st->count * w->tid / st->nthreads;
+	size_t end = st->count * (w->tid + 1) / st->nthreads;
+
+	st->phase(st, begin, end);
+	return NULL;
+}
+
+/*
+ * Runs a bulk build phase with all threads (calling thread is worker 0).
+ */
+void csrgraph_bulk_parallel(struct csrgraph_bulk_state* st,
+							void (*phase)(struct csrgraph_bulk_state* st, size_t begin, size_t end))
+{
+	struct csrgraph_bulk_worker workers[st->nthreads];
+	st->phase = phase;
+
+	for (int i = 0; i < st->nthreads; ++i) {
+		workers[i].st = st;
+		workers[i].tid = i;
+		if (i > 0 && pthread_create(&(workers[i].thread), NULL, csrgraph_bulk_run, &(workers[i])) != 0) {
+			printf("Error: failed to create CSR graph build thread!");
+			abort();
+		}
+	}
+
+	csrgraph_bulk_run(&(workers[0]));
+
+	for (int i = 1; i < st->nthreads; ++i)
+		pthread_join(workers[i].thread, NULL);
+}
+
+/*
+ * Builds a CSR graph directly from an array of edges, without an adjacency list graph.
+ * Degrees are counted in one pass and edges are placed in a second pass, both split
+ * among 'nthreads' threads. Undirected edges are stored in both directions.
+ * Note: with one thread edges of a vertex keep the input order, with more threads
+ * their order inside a vertex is not defined.
+ * Returns the new CSR graph.
+ */
+struct csrgraph* csrgraph_create_from_edges(size_t numvertices, adjlgraph_edgetype etype,
+											const struct adjlgraph_edgeitem* edges, size_t count,
+											int nthreads)
+{
+	size_t nv = numvertices;
+	struct csrgraph* result = csrgraph_alloc(etype, nv);
+	result->offsets = (size_t*)malloc((nv + 1) * sizeof(size_t));
+
+	struct csrgraph_bulk_state st;
+	st.g = result;
+	st.edges = edges;
+	st.count = count;
+	st.nthreads = (nthreads < 1) ? 1 : nthreads;
+	st.slots = (size_t*)calloc(nv + 1, sizeof(size_t));
+	if (!(result->offsets) || !(st.slots)) {
+		printf("Memory error when allocating CSR graph offsets array!");
+		abort();
+	}
+
+	// count degrees, prefix sum gives the offsets
+	csrgraph_bulk_parallel(&st, csrgraph_bulk_count);
+
+	size_t total = 0;
+	for (size_t v = 0; v < nv; ++v) {
+		size_t degree = st.slots[v];
+		result->offsets[v] = total;
+		st.slots[v] = total;	// insert position
+		total += degree;
+	}
+
+	result->offsets[nv] = total;
+	result->numarcs = total;
+	result->targets = (int*)malloc((total > 0 ? total : 1) * sizeof(int));
+	result->weights = (double*)malloc((total > 0 ? total : 1) * sizeof(double));
+	if (!(result->targets) || !(result->weights)) {
+		printf("Memory error when allocating CSR graph edge arrays!");
+		abort();
+	}
+
+	// place edges
+	csrgraph_bulk_parallel(&st, csrgraph_bulk_place);
+
+	free(st.slots);
+	return result;
+}
+
+/*
+ * Builds the reverse (transposed) graph: every edge u->v becomes v->u.
+ * Used for backward searches (ex: bidirectional Dijkstra).
+ * Returns the new CSR graph.
+ */
+struct csrgraph* csrgraph_create_reverse(const struct csrgraph* g)
+{
+	size_t nv = g->numvertices;
+	size_t count = g->numarcs;
+	struct csrgraph* result = csrgraph_alloc(g->etype, nv);
+	result->numarcs = count;
+	result->offsets = (size_t*)calloc(nv + 1, sizeof(size_t));
+	result->targets = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+	if (g->weights != NULL)
+		result->weights = (double*)malloc((count > 0 ? count : 1) * sizeof(double));
+	if (!(result->offsets) || !(result->targets) || (g->weights && !(result->weights))) {
+		printf("Memory error when allocating CSR graph arrays!");
+		abort();
+	}
+
+	// count incoming edges of each vertex, then prefix sum
+	for (size_t e = 0; e < count; ++e)
+		result->offsets[g->targets[e] + 1]++;
+
+	for (size_t v = 0; v < nv; ++v)
+		result->offsets[v + 1] += result->offsets[v];
+
+	// scatter edges, 'offsets[v]' is used as insert position and restored below
+	for (size_t u = 0; u < nv; ++u)
+		for (size_t e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+			size_t pos = result->offsets[g->targets[e]]++;
+			result->targets[pos] = (int)u;
+			if (g->weights != NULL)
+				result->weights[pos] = g->weights[e];
+		}
+
+	for (size_t v = nv; v > 0; --v)
+		result->offsets[v] = result->offsets[v - 1];
+
+	result->offsets[0] = 0;
+	return result;
+}
+
+// thread argument of a partitioned copy
+struct csrgraph_partition_worker {
+	const struct csrgraph* src;			// source graph
+	struct csrgraph* g;					// partitioned graph
+	int part;							// partition copied by the thread
+	pthread_t thread;
+};
+
+/*
+ * Copies the arrays of one partition, from a thread pinned to its home node.
+ * Note: Private function.
+ */
+void* csrgraph_partition_copy(void* arg)
+{
+	struct csrgraph_partition_worker* w = (struct csrgraph_partition_worker*)arg;
+	const struct csrgraph* src = w->src;
+	struct csrgraph* g = w->g;
+	numanode_pin_thread(numanode_of_part(w->part, g->numpartitions));
+
+	size_t first = g->partitions[w->part], last = g->partitions[w->part + 1];
+	if (w->part == g->numpartitions - 1)
+		last++;		// last partition also holds offsets[numvertices]
+
+	memcpy(g->offsets + first, src->offsets + first, (last - first) * sizeof(size_t));
+
+	size_t efirst = src->offsets[g->partitions[w->part]];
+	size_t elast = src->offsets[g->partitions[w->part + 1]];
+	memcpy(g->targets + efirst, src->targets + efirst, (elast - efirst) * sizeof(int));
+	if (src->weights != NULL)
+		memcpy(g->weights + efirst, src->weights + efirst, (elast - efirst) * sizeof(double));
+
+	return NULL;
+}
+
+/*
+ * Builds a copy of a graph split in 'numpartitions' vertex ranges (0: one per NUMA
+ * node), the arrays of each range placed on its home node (see NUMA partitions).
+ * Vertex and edge payloads are not copied.
+ * Returns the new CSR graph.
+ */
+struct csrgraph* csrgraph_create_partitioned(const struct csrgraph* g, int numpartitions)
+{
+	size_t nv = g->numvertices, count = g->numarcs;
+	if (numpartitions <= 0)
+		numpartitions = numanode_getcount();
+
+	// one anonymous mapping: partitions, offsets, targets and weights, page aligned
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	size_t partspos = 0;
+	size_t offsetspos = (partspos + (numpartitions + 1) * sizeof(size_t) + page - 1) & ~(page - 1);
+	size_t targetspos = (offsetspos + (nv + 1) * sizeof(size_t) + page - 1) & ~(page - 1);
+	size_t weightspos = (targetspos + count * sizeof(int) + page - 1) & ~(page - 1);
+	size_t size = weightspos + ((g->weights != NULL) ? count * sizeof(double) : 0);
+	char* base = (char*)numanode_alloc(size, 0);
+	if (base == NULL) {
+		printf("Memory error when allocating partitioned CSR graph!");
+		abort();
+	}
+
+	struct csrgraph* result = csrgraph_alloc(g->etype, nv);
+	result->numarcs = count;
+	result->offsets = (size_t*)(base + offsetspos);
+	result->targets = (int*)(base + targetspos);
+	result->weights = (g->weights != NULL) ? (double*)(base + weightspos) : NULL;
+	result->mapping = base;
+	result->mappingsize = size;
+	result->numpartitions = numpartitions;
+
+	// boundary 'k' is the first vertex where vertices plus edges before it reach k / P
+	size_t* parts = (size_t*)(base + partspos);
+	size_t total = nv + count;
+	parts[0] = 0;
+	for (int k = 1; k < numpartitions; ++k) {
+		size_t target = (size_t)((double)total * k / numpartitions);
+		size_t lo = parts[k - 1], hi = nv;
+		while (lo < hi) {
+			size_t mid = lo + (hi - lo) / 2;
+			if (g->offsets[mid] + mid < target) lo = mid + 1;
+			else hi = mid;
+		}
+
+		lo -= lo % CSRGRAPH_PARTITION_ALIGN;
+		parts[k] = (lo > parts[k - 1]) ? lo : parts[k - 1];
+	}
+	parts[numpartitions] = nv;
+	result->partitions = parts;
+
+	// place each partition, then copy it from its node
+	for (int k = 0; k < numpartitions; ++k) {
+		int node = numanode_of_part(k, numpartitions);
+		size_t first = parts[k], last = parts[k + 1] + (k == numpartitions - 1);
+		size_t efirst = g->offsets[parts[k]], elast = g->offsets[parts[k + 1]];
+		numanode_bind(result->offsets + first, (last - first) * sizeof(size_t), node);
+		numanode_bind(result->targets + efirst, (elast - efirst) * sizeof(int), node);
+		if (g->weights != NULL)
+			numanode_bind(result->weights + efirst, (elast - efirst) * sizeof(double), node);
+	}
+
+	struct csrgraph_partition_worker* workers = malloc(numpartitions * sizeof(*workers));
+	if (!workers) {
+		printf("Memory error when allocating partitioned CSR graph workers!");
+		abort();
+	}
+
+	for (int k = 0; k < numpartitions; ++k) {
+		workers[k] = (struct csrgraph_partition_worker){ g, result, k, 0 };
+		if (pthread_create(&(workers[k].thread), NULL, csrgraph_partition_copy, &(workers[k])) != 0) {
+			printf("Error: failed to create CSR graph partition thread!");
+			abort();
+		}
+	}
+
+	for (int k = 0; k < numpartitions; ++k)
+		pthread_join(workers[k].thread, NULL);
+
+	free(workers);
+	return result;
+}
+
+/*
+ * Gets the partition of vertex 'v' (0 if graph is not partitioned).
+ */
+int csrgraph_partition_of(const struct csrgraph* g, int v)
+{
+	int lo = 0, hi = g->numpartitions - 1;
+	while (lo < hi) {
+		int mid = lo + (hi - lo + 1) / 2;
+		if (g->partitions[mid] <= (size_t)v) lo = mid;
+		else hi = mid - 1;
+	}
+
+	return (lo > 0) ? lo : 0;
+}
+
+/*
+ * Gets the number of edges in the graph (undirected edges are counted once).
+ */
+size_t csrgraph_getnumedges(const struct csrgraph* g) {
+	if (g->etype == UNDIRECTED_AGRAPH) return g->numarcs / 2;
+	else return g->numarcs;
+}
+
+/*
+ * Gets the number of edges leaving a given vertex.
+ */
+size_t csrgraph_degree(const struct csrgraph* g, int v) {
+	return g->offsets[v + 1] - g->offsets[v];
+}
+
+/*
+ * Print the graph
+ */
+void csrgraph_print(const struct csrgraph* g)
+{
+	for (size_t v = 0; v < g->numvertices; v++) {
+		printf("Vertex [%zu] |", v);
+
+		for (size_t e = g->offsets[v]; e < g->offsets[v + 1]; ++e) {
+			if (g->etype == DIRECTED_AGRAPH && g->weights != NULL)
+				printf("-(%f)", g->weights[e]);
+
+			printf("->%d", g->targets[e]);
+		}
+
+		printf("->NULL\n");
+	}
+}
+
+/*
+ * Gets the payload record of vertex 'v' or NULL if graph has no vertex payloads.
+ */
+const void* csrgraph_vertexpayload(const struct csrgraph* g, int v) {
+	if (g->vertexpayload == NULL) return NULL;
+	return (const char*)g->vertexpayload + (size_t)v * g->vertexrecordsize;
+}
+
+/*
+ * Gets the payload record of edge 'e' (position in 'targets') or NULL if graph has no
+ * edge payloads.
+ */
+const void* csrgraph_edgepayload(const struct csrgraph* g, size_t e) {
+	if (g->edgepayload == NULL) return NULL;
+	return (const char*)g->edgepayload + e * g->edgerecordsize;
+}
+
+/*
+ * Rounds a file position up to the section alignment.
+ */
+uint64_t csrgraph_file_align(uint64_t pos) {
+	return (pos + CSRGRAPH_FILE_ALIGN - 1) & ~((uint64_t)CSRGRAPH_FILE_ALIGN - 1);
+}
+
+/*
+ * Writes a file section at its aligned position (padding with zeros).
+ * Returns 1 if succeeded, 0 otherwise.
+ */
+int csrgraph_file_write_section(FILE* f, uint64_t* pos, uint64_t offset, const void* data, size_t size)
+{
+	static const char zeros[CSRGRAPH_FILE_ALIGN] = { 0 };
+	if (offset > *pos && fwrite(zeros, 1, offset - *pos, f) != offset - *pos)
+		return 0;
+	if (size > 0 && fwrite(data, 1, size, f) != size)
+		return 0;
+
+	*pos = offset + size;
+	return 1;
+}
+
+/*
+ * Saves the graph to a binary file that can be mapped back with 'csrgraph_map'.
+ * Weights are stored only if 'withweights' is true. Vertex/edge payloads are optional
+ * arrays of fixed size records (NULL or record size 0 for none), edge payloads follow
+ * the order of 'targets'.
+ * Returns 1 if succeeded, 0 otherwise.
+ */
+int csrgraph_save(const struct csrgraph* g, const char* path, int withweights,
+				  const void* vertexpayload, size_t vertexrecordsize,
+				  const void* edgepayload, size_t edgerecordsize)
+{
+	if (sizeof(size_t) != sizeof(uint64_t) || sizeof(int) != sizeof(int32_t))
+		return 0;	// arrays are written as they are in memory
+
+	struct csrgraph_fileheader h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, CSRGRAPH_FILE_MAGIC, sizeof(h.magic));
+	h.version = CSRGRAPH_FILE_VERSION;
+	h.byteorder = CSRGRAPH_FILE_BYTEORDER;
+	h.directed = (g->etype == DIRECTED_AGRAPH);
+	h.numvertices = g->numvertices;
+	h.numarcs = g->numarcs;
+
+	withweights = withweights && (g->weights != NULL);
+	if (!vertexpayload) vertexrecordsize = 0;
+	if (!edgepayload) edgerecordsize = 0;
+
+	// sections layout
+	h.offsetspos = csrgraph_file_align(sizeof(h));
+	h.targetspos = csrgraph_file_align(h.offsetspos + (h.numvertices + 1) * sizeof(uint64_t));
+	uint64_t end = h.targetspos + h.numarcs * sizeof(int32_t);
+	if (withweights) {
+		h.weightspos = csrgraph_file_align(end);
+		end = h.weightspos + h.numarcs * sizeof(double);
+	}
+	if (vertexrecordsize > 0) {
+		h.vertexpayloadpos = csrgraph_file_align(end);
+		h.vertexrecordsize = vertexrecordsize;
+		end = h.vertexpayloadpos + h.numvertices * vertexrecordsize;
+	}
+	if (edgerecordsize > 0) {
+		h.edgepayloadpos = csrgraph_file_align(end);
+		h.edgerecordsize = edgerecordsize;
+		end = h.edgepayloadpos + h.numarcs * edgerecordsize;
+	}
+	h.filesize = end;
+
+	FILE* f = fopen(path, "wb");
+	if (f == NULL)
+		return 0;
+
+	uint64_t pos = 0;
+	int result = csrgraph_file_write_section(f, &pos, 0, &h, sizeof(h))
+			&& csrgraph_file_write_section(f, &pos, h.offsetspos, g->offsets, (h.numvertices + 1) * sizeof(uint64_t))
+			&& csrgraph_file_write_section(f, &pos, h.targetspos, g->targets, h.numarcs * sizeof(int32_t));
+	if (result && withweights)
+		result = csrgraph_file_write_section(f, &pos, h.weightspos, g->weights, h.numarcs * sizeof(double));
+	if (result && vertexrecordsize > 0)
+		result = csrgraph_file_write_section(f, &pos, h.vertexpayloadpos, vertexpayload, h.numvertices * vertexrecordsize);
+	if (result && edgerecordsize > 0)
+		result = csrgraph_file_write_section(f, &pos, h.edgepayloadpos, edgepayload, h.numarcs * edgerecordsize);
+
+	if (fclose(f) != 0)
+		result = 0;
+
+	return result;
+}
+
+/*
+ * Checks if a file section is inside the file and aligned.
+ */
+int csrgraph_file_section_ok(const struct csrgraph_fileheader* h, uint64_t pos, uint64_t count, uint64_t size)
+{
+	if (pos % CSRGRAPH_FILE_ALIGN != 0 || pos > h->filesize)
+		return 0;
+
+	return size == 0 || count <= (h->filesize - pos) / size;
+}
+
+/*
+ * Maps a graph file saved with 'csrgraph_save' into memory. Arrays point directly into
+ * the read only mapping (no parsing, no copy), pages are loaded on first access and are
+ * shared with every other process mapping the same file.
+ * Graphs saved without weights have 'weights' set to NULL.
+ * Returns the mapped graph or NULL if file can not be mapped or is not a valid graph file.
+ * Note: mapped arrays must not be changed. 'csrgraph_destroy' unmaps the file.
+ */
+struct csrgraph* csrgraph_map(const char* path)
+{
+	if (sizeof(size_t) != sizeof(uint64_t) || sizeof(int) != sizeof(int32_t))
+		return NULL;
+
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(struct csrgraph_fileheader)) {
+		close(fd);
+		return NULL;
+	}
+
+	void* mapping = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);	// mapping keeps the file open
+	if (mapping == MAP_FAILED)
+		return NULL;
+
+	const struct csrgraph_fileheader* h = (const struct csrgraph_fileheader*)mapping;
+	int valid = memcmp(h->magic, CSRGRAPH_FILE_MAGIC, sizeof(h->magic)) == 0
+			&& h->version == CSRGRAPH_FILE_VERSION
+			&& h->byteorder == CSRGRAPH_FILE_BYTEORDER
+			&& h->filesize <= (uint64_t)st.st_size
+			&& h->numvertices < (uint64_t)INT32_MAX
+			&& csrgraph_file_section_ok(h, h->offsetspos, h->numvertices + 1, sizeof(uint64_t))
+			&& csrgraph_file_section_ok(h, h->targetspos, h->numarcs, sizeof(int32_t))
+			&& (h->weightspos == 0 || csrgraph_file_section_ok(h, h->weightspos, h->numarcs, sizeof(double)))
+			&& (h->vertexpayloadpos == 0
+					|| csrgraph_file_section_ok(h, h->vertexpayloadpos, h->numvertices, h->vertexrecordsize))
+			&& (h->edgepayloadpos == 0
+					|| csrgraph_file_section_ok(h, h->edgepayloadpos, h->numarcs, h->edgerecordsize));
+	if (!valid) {
+		munmap(mapping, st.st_size);
+		return NULL;
+	}
+
+	char* base = (char*)mapping;
+	struct csrgraph* result = csrgraph_alloc(h->directed ? DIRECTED_AGRAPH : UNDIRECTED_AGRAPH, h->numvertices);
+	result->numarcs = h->numarcs;
+	result->offsets = (size_t*)(base + h->offsetspos);
+	result->targets = (int*)(base + h->targetspos);
+	result->weights = (h->weightspos != 0) ? (double*)(base + h->weightspos) : NULL;
+	if (h->vertexpayloadpos != 0) {
+		result->vertexpayload = base + h->vertexpayloadpos;
+		result->vertexrecordsize = h->vertexrecordsize;
+	}
+	if (h->edgepayloadpos != 0) {
+		result->edgepayload = base + h->edgepayloadpos;
+		result->edgerecordsize = h->edgerecordsize;
+	}
+	result->mapping = mapping;
+	result->mappingsize = st.st_size;
+	return result;
+}
+
+/*
+ * Releases graph resources from memory.
+ */
+void csrgraph_destroy(struct csrgraph* g)
+{
+	if (g->mapping != NULL) {
+		munmap(g->mapping, g->mappingsize);	// arrays live in the mapped file
+	}
+	else {
+		free(g->offsets);
+		free(g->targets);
+		free(g->weights);
+	}
+
+	free(g);
+}
@@ -0,0 +1,195 @@
+/*
+ * csrgraph.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C headers for an immutable graph in compressed sparse row (CSR) format.
+ *
+ * Compressed sparse row
+ *
+ * 		The edges of all vertices are stored in three flat arrays instead of one linked
+ * 		list per vertex:
+ *
+ * 			- offsets[numvertices + 1]: edges of vertex 'v' are stored in positions
+ * 			  offsets[v] .. offsets[v + 1] - 1 of the other arrays;
+ * 			- targets[numedges]: destination vertex of each edge;
+ * 			- weights[numedges]: weight of each edge.
+ *
+ * 		Visiting the neighbours of a vertex is a sequential scan over contiguous memory,
+ * 		so traversals (BFS, DFS, Dijkstra) do not take a cache miss per edge, and each edge
+ * 		costs 12 bytes (vs. a 32 byte list node plus allocator overhead).
+ *
+ * 		The graph is built once from an adjacency list graph (adjlgraph_freeze_to_csr)
+ * 		or directly from an edge array (csrgraph_create_from_edges) and can not be
+ * 		changed afterwards. Edge data pointers are not kept.
+ *
+ * -----------------------------------------------------------
+ * | Action				| Adjacency List 	| CSR			 |
+ * -----------------------------------------------------------
+ * | Adding Edge		| O(1)				| rebuild O(V+E) |
+ * | Neighbours of v	| O(deg(v)) (list)	| O(deg(v)) (array) |
+ * | Memory per edge	| node + malloc		| 12 bytes		 |
+ * -----------------------------------------------------------
+ *
+ * Graph files
+ *
+ * 		csrgraph_save writes the arrays as they are in memory after a small header, each
+ * 		section aligned to 64 bytes. csrgraph_map maps the file and points the arrays into
+ * 		the mapping, so loading a graph costs only the page faults of the pages used.
+ * 		Files are only readable on machines with the same byte order and 64 bit size_t.
+ *
+ * NUMA partitions
+ *
+ * 		csrgraph_create_partitioned copies a graph split in ranges of vertices (balanced
+ * 		by vertices plus edges, boundaries multiple of CSRGRAPH_PARTITION_ALIGN). The
+ * 		offsets, targets and weights of partition 'k' are placed on its home node
+ * 		(numanode_of_part, see numanode.h) and copied by a thread pinned to it, so
+ * 		workers pinned to that node scan local memory (see bfsalg_parallel).
+ *
+ * Source: https://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_(CSR,_CRS_or_Yale_format)
+ *
+ */
+
+#ifndef CSRGRAPH_H_
+	#define CSRGRAPH_H_
+
+	#include <stdlib.h>
+	#include <stdint.h>
+	#include "adjlgraph.h"
+
+	#define CSRGRAPH_FILE_MAGIC "CSRGRAPH"		// first 8 bytes of a graph file
+	#define CSRGRAPH_FILE_VERSION 1
+	#define CSRGRAPH_FILE_BYTEORDER 0x01020304	// detects files written with other byte order
+	#define CSRGRAPH_FILE_ALIGN 64				// alignment of file sections
+	#define CSRGRAPH_PARTITION_ALIGN 64			// partition boundaries are multiple of it (one bitmap word)
+
+	// compressed sparse row graph struct
+	struct csrgraph {
+		adjlgraph_edgetype etype;		// type of source graph edges
+		size_t numvertices;				// number of vertices
+		size_t numarcs;					// number of stored (directed) edges
+		size_t* offsets;				// first edge of each vertex (numvertices + 1)
+		int* targets;					// destination vertex of each edge
+		double* weights;				// weight of each edge (NULL if unweighted)
+		const void* vertexpayload;		// fixed size record of each vertex (or NULL)
+		size_t vertexrecordsize;		// size of a vertex record
+		const void* edgepayload;		// fixed size record of each edge (or NULL)
+		size_t edgerecordsize;			// size of an edge record
+		void* mapping;					// mapped graph file (NULL if arrays are allocated)
+		size_t mappingsize;				// size of mapping
+		int numpartitions;				// number of vertex partitions (0 if not partitioned)
+		const size_t* partitions;		// first vertex of each partition (numpartitions + 1)
+	};
+
+	// header of a graph file, followed by the sections it points to (file positions
+	// are multiples of CSRGRAPH_FILE_ALIGN, a position of 0 means section is absent)
+	struct csrgraph_fileheader {
+		char magic[8];					// CSRGRAPH_FILE_MAGIC
+		uint32_t version;				// CSRGRAPH_FILE_VERSION
+		uint32_t byteorder;				// CSRGRAPH_FILE_BYTEORDER
+		uint32_t directed;				// edge type
+		uint32_t reserved;
+		uint64_t numvertices;
+		uint64_t numarcs;
+		uint64_t offsetspos;			// uint64_t[numvertices + 1]
+		uint64_t targetspos;			// int32_t[numarcs]
+		uint64_t weightspos;			// double[numarcs]
+		uint64_t vertexpayloadpos;		// numvertices records
+		uint64_t vertexrecordsize;
+		uint64_t edgepayloadpos;		// numarcs records
+		uint64_t edgerecordsize;
+		uint64_t filesize;				// total file size
+	};
+
+	/*
+	 * Builds an immutable CSR graph from an adjacency list graph.
+	 * Edges keep the order of the source edge lists. The source graph is not changed.
+	 * Returns the new CSR graph.
+	 */
+	struct csrgraph* adjlgraph_freeze_to_csr(const struct adjlgraph* g);
+
+	/*
+	 * Builds a CSR graph directly from an array of edges, without an adjacency list graph.
+	 * Degrees are counted in one pass and edges are placed in a second pass, both split
+	 * among 'nthreads' threads. Undirected edges are stored in both directions.
+	 * Note: with one thread edges of a vertex keep the input order, with more threads
+	 * their order inside a vertex is not defined.
+	 * Returns the new CSR graph.
+	 */
+	struct csrgraph* csrgraph_create_from_edges(size_t numvertices, adjlgraph_edgetype etype,
+												const struct adjlgraph_edgeitem* edges, size_t count,
+												int nthreads);
+
+	/*
+	 * Builds the reverse (transposed) graph: every edge u->v becomes v->u.
+	 * Used for backward searches (ex: bidirectional Dijkstra).
+	 * Returns the new CSR graph.
+	 */
+	struct csrgraph* csrgraph_create_reverse(const struct csrgraph* g);
+
+	/*
+	 * Builds a copy of a graph split in 'numpartitions' vertex ranges (0: one per NUMA
+	 * node), the arrays of each range placed on its home node (see NUMA partitions).
+	 * Vertex and edge payloads are not copied.
+	 * Returns the new CSR graph.
+	 */
+	struct csrgraph* csrgraph_create_partitioned(const struct csrgraph* g, int numpartitions);
+
+	/*
+	 * Gets the partition of vertex 'v' (0 if graph is not partitioned).
+	 */
+	int csrgraph_partition_of(const struct csrgraph* g, int v);
+
+	/*
+	 * Gets the number of edges in the graph (undirected edges are counted once).
+	 */
+	size_t csrgraph_getnumedges(const struct csrgraph* g);
+
+	/*
+	 * Gets the number of edges leaving a given vertex.
+	 */
+	size_t csrgraph_degree(const struct csrgraph* g, int v);
+
+	/*
+	 * Print the graph
+	 */
+	void csrgraph_print(const struct csrgraph* g);
+
+	/*
+	 * Gets the payload record of vertex 'v' or NULL if graph has no vertex payloads.
+	 */
+	const void* csrgraph_vertexpayload(const struct csrgraph* g, int v);
+
+	/*
+	 * Gets the payload record of edge 'e' (position in 'targets') or NULL if graph has no
+	 * edge payloads.
+	 */
+	const void* csrgraph_edgepayload(const struct csrgraph* g, size_t e);
+
+	/*
+	 * Saves the graph to a binary file that can be mapped back with 'csrgraph_map'.
+	 * Weights are stored only if 'withweights' is true. Vertex/edge payloads are optional
+	 * arrays of fixed size records (NULL or record size 0 for none), edge payloads follow
+	 * the order of 'targets'.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 */
+	int csrgraph_save(const struct csrgraph* g, const char* path, int withweights,
+					  const void* vertexpayload, size_t vertexrecordsize,
+					  const void* edgepayload, size_t edgerecordsize);
+
+	/*
+	 * Maps a graph file saved with 'csrgraph_save' into memory. Arrays point directly into
+	 * the read only mapping (no parsing, no copy), pages are loaded on first access and are
+	 * shared with every other process mapping the same file.
+	 * Graphs saved without weights have 'weights' set to NULL.
+	 * Returns the mapped graph or NULL if file can not be mapped or is not a valid graph file.
+	 * Note: mapped arrays must not be changed. 'csrgraph_destroy' unmaps the file.
+	 */
+	struct csrgraph* csrgraph_map(const char* path);
+
+	/*
+	 * Releases graph resources from memory (or unmaps a mapped graph).
+	 */
+	void csrgraph_destroy(struct csrgraph* g);
+
+#endif /* CSRGRAPH_H_ */
@@ -0,0 +1,252 @@
+/*
+ * cuckoofilter.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Cuckoo filter with 16 bit fingerprints and 4 slot buckets.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cuckoofilter.h"
+
+/*
+ * Creates a new filter for 'capacity' elements.
+ * Returns the new filter if succeeded, NULL otherwise.
+ * */
+struct cuckoofilter* cuckoofilter_create(size_t capacity, cuckoofilter_hashfunc hashfunc)
+{
+	struct cuckoofilter* filter = (struct cuckoofilter*)malloc(sizeof(struct cuckoofilter));
+	if (filter == NULL) {
+		printf("Memory error: failed to allocate memory for cuckoo filter!\n");
+		return NULL;
+	}
+
+	// buckets for 95% load
+	size_t needed = (capacity * 100 + 95 * CUCKOOFILTER_BUCKET_SLOTS - 1) / (95 * CUCKOOFILTER_BUCKET_SLOTS);
+	size_t nbuckets = 1;
+	while (nbuckets < needed)
+		nbuckets *= 2;
+
+	filter->buckets = (struct cuckoofilter_bucket*)aligned_alloc( CUCKOOFILTER_CACHE_LINE,
+		((nbuckets * sizeof(struct cuckoofilter_bucket) + CUCKOOFILTER_CACHE_LINE - 1)
+		 / CUCKOOFILTER_CACHE_LINE) * CUCKOOFILTER_CACHE_LINE );
+	if (filter->buckets == NULL) {
+		printf("Memory error: failed to allocate memory for cuckoo filter buckets!\n");
+		free(filter);
+		return NULL;
+	}
+
+	filter->mask = nbuckets - 1;
+	filter->hashfunc = hashfunc;
+	filter->seed = 0x2545F4914F6CDD1DULL;
+	cuckoofilter_clear(filter);
+	return filter;
+}
+
+/*
+ * Gets the bucket index and the (non zero) fingerprint of an element.
+ * Note: Private function.
+ * */
+void cuckoofilter_locate(const struct cuckoofilter* filter, const void* element,
+						 size_t* index, uint16_t* fingerprint)
+{
+	uint64_t h = (uint64_t)(uint32_t)filter->hashfunc(element) + 0x9E3779B97F4A7C15ULL;
+	h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+	h ^= h >> 31;
+
+	*index = (size_t)h & filter->mask;
+	*fingerprint = (uint16_t)(h >> 48);
+	if (*fingerprint == 0)
+		*fingerprint = 1;
+}
+
+/*
+ * Gets the other bucket of a fingerprint stored in bucket 'index'.
+ * Note: Private function.
+ * */
+size_t cuckoofilter_altindex(const struct cuckoofilter* filter, size_t index, uint16_t fingerprint)
+{
+	return (index ^ ((size_t)fingerprint * 0x5BD1E995u)) & filter->mask;
+}
+
+/*
+ * Stores a fingerprint in a free slot of a bucket.
+ * Returns 1 if succeeded, 0 if bucket is full.
+ * Note: Private function.
+ * */
+int cuckoofilter_bucket_put(struct cuckoofilter_bucket* bucket, uint16_t fingerprint)
+{
+	for (int i = 0; i < CUCKOOFILTER_BUCKET_SLOTS; i++)
+		if (bucket->slots[i] == 0) {
+			bucket->slots[i] = fingerprint;
+			return 1;
+		}
+
+	return 0;
+}
+
+/*
+ * Checks if a bucket holds a fingerprint.
+ * Note: Private function.
+ * */
+int cuckoofilter_bucket_has(const struct cuckoofilter_bucket* bucket, uint16_t fingerprint)
+{
+	int result = 0;
+	for (int i = 0; i < CUCKOOFILTER_BUCKET_SLOTS; i++)
+		result |= (bucket->slots[i] == fingerprint);
+
+	return result;
+}
+
+/*
+ * Clears one copy of a fingerprint from a bucket.
+ * Returns 1 if succeeded, 0 if not found.
+ * Note: Private function.
+ * */
+int cuckoofilter_bucket_delete(struct cuckoofilter_bucket* bucket, uint16_t fingerprint)
+{
+	for (int i = 0; i < CUCKOOFILTER_BUCKET_SLOTS; i++)
+		if (bucket->slots[i] == fingerprint) {
+			bucket->slots[i] = 0;
+			return 1;
+		}
+
+	return 0;
+}
+
+/*
+ * Stores a fingerprint in one of its buckets, moving other fingerprints as needed.
+ * If there is no room left the last moved fingerprint becomes the victim.
+ * Note: Private function.
+ * */
+void cuckoofilter_insert(struct cuckoofilter* filter, size_t index, uint16_t fingerprint)
+{
+	size_t alt = cuckoofilter_altindex(filter, index, fingerprint);
+	if (cuckoofilter_bucket_put(&(filter->buckets[index]), fingerprint)
+		|| cuckoofilter_bucket_put(&(filter->buckets[alt]), fingerprint))
+		return;
+
+	size_t i = (filter->seed & 1) ? index : alt;
+	for (int kick = 0; kick < CUCKOOFILTER_MAX_KICKS; kick++) {
+		// xorshift64 picks the slot to evict
+		filter->seed ^= filter->seed << 13;
+		filter->seed ^= filter->seed >> 7;
+		filter->seed ^= filter->seed << 17;
+
+		uint16_t* slot = &(filter->buckets[i].slots[filter->seed % CUCKOOFILTER_BUCKET_SLOTS]);
+		uint16_t evicted = *slot;
+		*slot = fingerprint;
+		fingerprint = evicted;
+		i = cuckoofilter_altindex(filter, i, fingerprint);
+		if (cuckoofilter_bucket_put(&(filter->buckets[i]), fingerprint))
+			return;
+	}
+
+	filter->victim = fingerprint;
+	filter->victimindex = i;
+}
+
+/*
+ * Adds an element to the filter.
+ * Returns 1 if succeeded, 0 if filter is full.
+ * */
+int cuckoofilter_add(struct cuckoofilter* filter, const void* element)
+{
+	if (filter->victim != 0)
+		return 0;
+
+	size_t index;
+	uint16_t fingerprint;
+	cuckoofilter_locate(filter, element, &index, &fingerprint);
+	cuckoofilter_insert(filter, index, fingerprint);
+	filter->count++;
+	return 1;
+}
+
+/*
+ * Checks if an element may be in the filter.
+ * Returns 0 if it is not in the filter, 1 if it may be.
+ * */
+int cuckoofilter_maycontain(const struct cuckoofilter* filter, const void* element)
+{
+	size_t index;
+	uint16_t fingerprint;
+	cuckoofilter_locate(filter, element, &index, &fingerprint);
+	size_t alt = cuckoofilter_altindex(filter, index, fingerprint);
+
+	if (filter->victim == fingerprint && (filter->victimindex == index || filter->victimindex == alt))
+		return 1;
+
+	return cuckoofilter_bucket_has(&(filter->buckets[index]), fingerprint)
+		   | cuckoofilter_bucket_has(&(filter->buckets[alt]), fingerprint);
+}
+
+/*
+ * Removes an element added before (removing other elements may remove an element
+ * with the same fingerprint).
+ * Returns 1 if a fingerprint was removed, 0 otherwise.
+ * */
+int cuckoofilter_remove(struct cuckoofilter* filter, const void* element)
+{
+	size_t index;
+	uint16_t fingerprint;
+	cuckoofilter_locate(filter, element, &index, &fingerprint);
+	size_t alt = cuckoofilter_altindex(filter, index, fingerprint);
+
+	if (cuckoofilter_bucket_delete(&(filter->buckets[index]), fingerprint)
+		|| cuckoofilter_bucket_delete(&(filter->buckets[alt]), fingerprint)) {
+		filter->count--;
+		if (filter->victim != 0) {
+			// a slot is free now: the victim gets a place again
+			uint16_t victim = filter->victim;
+			filter->victim = 0;
+			cuckoofilter_insert(filter, filter->victimindex, victim);
+		}
+
+		return 1;
+	}
+
+	if (filter->victim == fingerprint && (filter->victimindex == index || filter->victimindex == alt)) {
+		filter->victim = 0;
+		filter->count--;
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * Gets the number of elements / the number of slots.
+ * */
+size_t cuckoofilter_getsize(const struct cuckoofilter* filter)
+{
+	return filter->count;
+}
+
+size_t cuckoofilter_getcapacity(const struct cuckoofilter* filter)
+{
+	return (filter->mask + 1) * CUCKOOFILTER_BUCKET_SLOTS;
+}
+
+/*
+ * Removes all elements from the filter.
+ * */
+void cuckoofilter_clear(struct cuckoofilter* filter)
+{
+	memset(filter->buckets, 0, (filter->mask + 1) * sizeof(struct cuckoofilter_bucket));
+	filter->count = 0;
+	filter->victim = 0;
+	filter->victimindex = 0;
+}
+
+/*
+ * Releases the filter from memory.
+ * */
+void cuckoofilter_destroy(struct cuckoofilter* filter)
+{
+	free(filter->buckets);
+	free(filter);
+}
@@ -0,0 +1,106 @@
+/*****************************************************************************
+ * cuckoofilter.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a cuckoo filter, a probabilistic set membership test
+ *  			 that supports deletes.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  The filter stores a 16 bit fingerprint of each element in one of two candidate
+ *  buckets of 4 slots (a bucket is 8 bytes, 8 buckets per cache line):
+ *
+ *  	i1 = hash index, i2 = i1 xor hash(fingerprint)
+ *
+ *  so the alternate bucket of a stored fingerprint is computed from the fingerprint
+ *  alone (partial-key cuckoo hashing). An insert with both buckets full moves a random
+ *  fingerprint of one of them to its alternate bucket, up to CUCKOOFILTER_MAX_KICKS
+ *  times. A lookup reads both buckets (at most two cache misses); a delete clears one
+ *  copy of the fingerprint, so only elements that were added may be removed.
+ *
+ *  The table is sized for 95% load (typical with 4 slots per bucket). When the kicks
+ *  run out the last evicted fingerprint is kept in a victim slot (nothing added is
+ *  lost) and the filter is full: following inserts fail until a delete empties the
+ *  victim slot. False positives: about 8 / 2^16 (0.012%) at full load.
+ *
+ *  Elements are hashed with the hashset_hashfunc callback (32 bit hash) remixed to 64
+ *  bits: the low half selects the bucket, the high half gives the fingerprint.
+ *
+ *  Source: B. Fan, D. G. Andersen, M. Kaminsky, M. D. Mitzenmacher, "Cuckoo Filter:
+ *  		 Practically Better Than Bloom", CoNEXT (2014).
+ *
+ *******************************************************************************/
+
+#ifndef CUCKOOFILTER_H_
+	#define CUCKOOFILTER_H_
+
+	#include <stdint.h>
+	#include <stddef.h>
+
+	#define CUCKOOFILTER_CACHE_LINE 64
+	#define CUCKOOFILTER_BUCKET_SLOTS 4
+	#define CUCKOOFILTER_MAX_KICKS 500
+
+	typedef int (*cuckoofilter_hashfunc)(const void* element);	// same as hashset_hashfunc
+
+	// bucket of fingerprints (0 is an empty slot)
+	struct cuckoofilter_bucket {
+		uint16_t slots[CUCKOOFILTER_BUCKET_SLOTS];
+	};
+
+	// cuckoo filter type
+	struct cuckoofilter {
+		struct cuckoofilter_bucket* buckets;
+		size_t mask;							// number of buckets - 1 (power of two)
+		size_t count;							// stored fingerprints (including the victim)
+		uint16_t victim;						// fingerprint that found no slot (0 if none)
+		size_t victimindex;						// one of the victim buckets
+		uint64_t seed;							// random state for kicks
+		cuckoofilter_hashfunc hashfunc;
+	};
+
+	/*
+	 * Creates a new filter for 'capacity' elements.
+	 * Returns the new filter if succeeded, NULL otherwise.
+	 * */
+	struct cuckoofilter* cuckoofilter_create(size_t capacity, cuckoofilter_hashfunc hashfunc);
+
+	/*
+	 * Adds an element to the filter.
+	 * Returns 1 if succeeded, 0 if filter is full.
+	 * */
+	int cuckoofilter_add(struct cuckoofilter* filter, const void* element);
+
+	/*
+	 * Checks if an element may be in the filter.
+	 * Returns 0 if it is not in the filter, 1 if it may be.
+	 * */
+	int cuckoofilter_maycontain(const struct cuckoofilter* filter, const void* element);
+
+	/*
+	 * Removes an element added before (removing other elements may remove an element
+	 * with the same fingerprint).
+	 * Returns 1 if a fingerprint was removed, 0 otherwise.
+	 * */
+	int cuckoofilter_remove(struct cuckoofilter* filter, const void* element);
+
+	/*
+	 * Gets the number of elements / the number of slots.
+	 * */
+	size_t cuckoofilter_getsize(const struct cuckoofilter* filter);
+	size_t cuckoofilter_getcapacity(const struct cuckoofilter* filter);
+
+	/*
+	 * Removes all elements from the filter.
+	 * */
+	void cuckoofilter_clear(struct cuckoofilter* filter);
+
+	/*
+	 * Releases the filter from memory.
+	 * */
+	void cuckoofilter_destroy(struct cuckoofilter* filter);
+
+#endif /* CUCKOOFILTER_H_ */
@@ -0,0 +1,179 @@
+/*
+ * datastats.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Instrumentation layer shared by the hash tables, trees and heaps:
+ * 				histograms, metric lists, text and Prometheus output.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "datastats.h"
+
+/*
+ * Mean of the values of a histogram (0 if empty).
+ * */
+double datastats_histogram_mean(const struct datastats_histogram* h)
+{
+	return (h->samples > 0) ? (double)h->total / (double)h->samples : 0.0;
+}
+
+/*
+ * Smallest value not exceeded by a fraction 'p' (0 to 1) of the values of a histogram.
+ * Values of the last bin are reported as the histogram maximum.
+ * */
+size_t datastats_histogram_percentile(const struct datastats_histogram* h, double p)
+{
+	if (h->samples == 0)
+		return 0;
+
+	size_t rank = (size_t)(p * (double)h->samples);
+	if (rank < 1) rank = 1;
+	if (rank > h->samples) rank = h->samples;
+
+	size_t cumulative = 0;
+	for (size_t i = 0; i < DATASTATS_HISTOGRAM_BINS - 1; i++) {
+		cumulative += h->bins[i];
+		if (cumulative >= rank)
+			return i;
+	}
+
+	return h->max;
+}
+
+/*
+ * Monotonic clock in nanoseconds (used to time resizes).
+ * */
+uint64_t datastats_nanotime()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Converts a heap statistics snapshot to a metric list (see datastats_print and
+ * datastats_export). 'metrics' must have room for DATASTATS_MAX_METRICS entries.
+ * Returns the number of metrics.
+ * */
+size_t datastats_heap_metrics(const struct datastats_heap* stats, struct datastats_metric* metrics)
+{
+	size_t n = 0;
+	metrics[n++] = (struct datastats_metric){ "size", (double)stats->size, NULL };
+	metrics[n++] = (struct datastats_metric){ "capacity", (double)stats->capacity, NULL };
+	metrics[n++] = (struct datastats_metric){ "height", (double)stats->height, NULL };
+
+	if (stats->countersenabled) {
+		metrics[n++] = (struct datastats_metric){ "sift_ups", (double)stats->sift.ups, NULL };
+		metrics[n++] = (struct datastats_metric){ "sift_downs", (double)stats->sift.downs, NULL };
+		metrics[n++] = (struct datastats_metric){ "sift_up_depth", 0, &(stats->sift.updepth) };
+		metrics[n++] = (struct datastats_metric){ "sift_down_depth", 0, &(stats->sift.downdepth) };
+	}
+
+	return n;
+}
+
+/*
+ * Prints a metric list as text, one metric per line (histograms are summarized by
+ * mean, percentiles, maximum and non empty bins).
+ * */
+void datastats_print(const char* title, const struct datastats_metric* metrics, size_t n)
+{
+	printf("%s\n", title);
+
+	for (size_t i = 0; i < n; i++) {
+		const struct datastats_histogram* h = metrics[i].histogram;
+		if (h == NULL) {
+			printf("  %-24s %.6g\n", metrics[i].name, metrics[i].value);
+			continue;
+		}
+
+		printf( "  %-24s samples %zu, mean %.2f, p50 %zu, p90 %zu, p99 %zu, max %zu\n",
+				metrics[i].name, h->samples, datastats_histogram_mean(h),
+				datastats_histogram_percentile(h, 0.5), datastats_histogram_percentile(h, 0.9),
+				datastats_histogram_percentile(h, 0.99), h->max );
+
+		if (h->samples == 0)
+			continue;
+
+		printf("  %-24s", "");
+		for (size_t b = 0; b < DATASTATS_HISTOGRAM_BINS; b++)
+			if (h->bins[b] > 0)
+				printf( " %zu%s:%zu", b, (b == DATASTATS_HISTOGRAM_BINS - 1) ? "+" : "", h->bins[b] );
+
+		printf("\n");
+	}
+}
+
+/*
+ * Writes the label set of a Prometheus sample ('le' is the bucket bound, NULL if none).
+ * Quotes and backslashes of the instance name are escaped.
+ * Note: Private function.
+ * */
+void datastats_export_labels(FILE* out, const char* instance, const char* le)
+{
+	if ((instance == NULL) && (le == NULL))
+		return;
+
+	fputc('{', out);
+	if (instance != NULL) {
+		fputs("instance=\"", out);
+		for (const char* c = instance; *c != '\0'; c++) {
+			if ((*c == '"') || (*c == '\\'))
+				fputc('\\', out);
+			fputc((*c == '\n') ? ' ' : *c, out);
+		}
+		fputc('"', out);
+	}
+
+	if (le != NULL)
+		fprintf(out, "%sle=\"%s\"", (instance != NULL) ? "," : "", le);
+
+	fputc('}', out);
+}
+
+/*
+ * Writes a metric list in the Prometheus text format. Metric names are prefixed by
+ * 'prefix' and labeled with instance="'instance'" (no label if NULL). Histograms are
+ * written as cumulative buckets (le="0", le="1", ..., le="+Inf") plus sum and count.
+ * Returns 1 if succeeded, 0 if a write failed.
+ * */
+int datastats_export( FILE* out, const char* prefix, const char* instance,
+					  const struct datastats_metric* metrics, size_t n )
+{
+	for (size_t i = 0; i < n; i++) {
+		const struct datastats_histogram* h = metrics[i].histogram;
+		const char* name = metrics[i].name;
+
+		if (h == NULL) {
+			fprintf(out, "# TYPE %s_%s gauge\n%s_%s", prefix, name, prefix, name);
+			datastats_export_labels(out, instance, NULL);
+			fprintf(out, " %.17g\n", metrics[i].value);
+			continue;
+		}
+
+		fprintf(out, "# TYPE %s_%s histogram\n", prefix, name);
+
+		size_t cumulative = 0;
+		char le[24];
+		for (size_t b = 0; b < DATASTATS_HISTOGRAM_BINS - 1; b++) {
+			cumulative += h->bins[b];
+			snprintf(le, sizeof(le), "%zu", b);
+			fprintf(out, "%s_%s_bucket", prefix, name);
+			datastats_export_labels(out, instance, le);
+			fprintf(out, " %zu\n", cumulative);
+		}
+
+		fprintf(out, "%s_%s_bucket", prefix, name);
+		datastats_export_labels(out, instance, "+Inf");
+		fprintf(out, " %zu\n%s_%s_sum", h->samples, prefix, name);
+		datastats_export_labels(out, instance, NULL);
+		fprintf(out, " %zu\n%s_%s_count", h->total, prefix, name);
+		datastats_export_labels(out, instance, NULL);
+		fprintf(out, " %zu\n", h->samples);
+	}
+
+	return !ferror(out);
+}
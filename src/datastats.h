@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * datastats.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers of the instrumentation layer shared by the hash tables,
+ *  			 trees and heaps (histograms, counters and metrics export).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Instrumented structures offer a snapshot function (hashtable_stats, rbtree_stats,
+ *  minbinaryheap_stats, ...) and a second one (..._stats_metrics) that turns the
+ *  snapshot into a list of named metrics. The list is written as text by datastats_print,
+ *  or in the Prometheus text format by datastats_export, which is the input of the usual
+ *  metrics exporters (node exporter textfile collector, pushgateway, ...).
+ *
+ *  There are two kinds of numbers:
+ *
+ *  	- structural numbers (chain lengths, probe distances, tombstones, tree height)
+ *  	  are computed by the snapshot function from the structure itself, so they are
+ *  	  always available;
+ *  	- event counters (collisions, resizes and resize time, rotations, sift depths)
+ *  	  are updated by the operations. They are opt-in at compile time: build the
+ *  	  library with -DCDATASTRUCT_STATS, otherwise the DATASTATS_ macros below expand
+ *  	  to nothing and operations pay nothing.
+ *
+ *  Counter fields are part of the structures in both builds, so objects compiled with
+ *  and without the flag can be mixed; snapshots report whether counters were compiled
+ *  in and metric lists leave them out when they were not.
+ *
+ *  Histograms have DATASTATS_HISTOGRAM_BINS fixed bins of width 1: bin i counts value i
+ *  and the last bin counts all larger values (the exact maximum is kept apart).
+ *
+ *  Source: https://prometheus.io/docs/instrumenting/exposition_formats/
+ *
+ *******************************************************************************/
+
+#ifndef DATASTATS_H_
+	#define DATASTATS_H_
+
+	#include <stdio.h>
+	#include <stdint.h>
+	#include <stddef.h>
+
+	#define DATASTATS_HISTOGRAM_BINS 32		// last bin counts values >= DATASTATS_HISTOGRAM_BINS - 1
+	#define DATASTATS_MAX_METRICS 24		// maximum size of the metric list of a snapshot
+
+	#if defined(CDATASTRUCT_STATS)
+		#define DATASTATS_ENABLED 1
+		#define DATASTATS_COUNT(counter) ((counter)++)
+		#define DATASTATS_ADD(counter, value) ((counter) += (value))
+		#define DATASTATS_ONLY(code) code
+	#else
+		#define DATASTATS_ENABLED 0
+		#define DATASTATS_COUNT(counter) ((void)0)
+		#define DATASTATS_ADD(counter, value) ((void)0)
+		#define DATASTATS_ONLY(code)
+	#endif
+
+	// histogram of small non negative values
+	struct datastats_histogram {
+		size_t bins[DATASTATS_HISTOGRAM_BINS];
+		size_t samples;						// number of added values
+		size_t total;						// sum of added values
+		size_t max;							// largest added value
+	};
+
+	// sift counters of a heap (one histogram sample per sift)
+	struct datastats_sift {
+		size_t ups;							// sift up operations (insert, decrease key)
+		size_t downs;						// sift down operations (extract, build)
+		struct datastats_histogram updepth;	// levels moved by each sift up
+		struct datastats_histogram downdepth;	// levels moved by each sift down
+	};
+
+	// statistics snapshot of a heap (see minbinaryheap_stats, maxbinaryheap_stats and
+	// imindarypq_stats)
+	struct datastats_heap {
+		size_t size;
+		size_t capacity;
+		int height;							// levels of the heap (0 if empty)
+		int countersenabled;				// sift counters were compiled in
+		struct datastats_sift sift;
+	};
+
+	// a named metric of a snapshot (a value or a histogram)
+	struct datastats_metric {
+		const char* name;					// metric name (lower case, '_' separated)
+		double value;						// value (unused by histograms)
+		const struct datastats_histogram* histogram;	// NULL for plain values
+	};
+
+	/*
+	 * Adds a value to a histogram.
+	 * */
+	static inline void datastats_histogram_add(struct datastats_histogram* h, size_t value) {
+		h->bins[(value < DATASTATS_HISTOGRAM_BINS - 1) ? value : DATASTATS_HISTOGRAM_BINS - 1]++;
+		h->samples++;
+		h->total += value;
+		if (value > h->max)
+			h->max = value;
+	}
+
+	/*
+	 * Mean of the values of a histogram (0 if empty).
+	 * */
+	double datastats_histogram_mean(const struct datastats_histogram* h);
+
+	/*
+	 * Smallest value not exceeded by a fraction 'p' (0 to 1) of the values of a histogram.
+	 * Values of the last bin are reported as the histogram maximum.
+	 * */
+	size_t datastats_histogram_percentile(const struct datastats_histogram* h, double p);
+
+	/*
+	 * Monotonic clock in nanoseconds (used to time resizes).
+	 * */
+	uint64_t datastats_nanotime();
+
+	/*
+	 * Converts a heap statistics snapshot to a metric list (see datastats_print and
+	 * datastats_export). 'metrics' must have room for DATASTATS_MAX_METRICS entries.
+	 * Returns the number of metrics.
+	 * */
+	size_t datastats_heap_metrics(const struct datastats_heap* stats, struct datastats_metric* metrics);
+
+	/*
+	 * Prints a metric list as text, one metric per line (histograms are summarized by
+	 * mean, percentiles, maximum and non empty bins).
+	 * */
+	void datastats_print(const char* title, const struct datastats_metric* metrics, size_t n);
+
+	/*
+	 * Writes a metric list in the Prometheus text format. Metric names are prefixed by
+	 * 'prefix' and labeled with instance="'instance'" (no label if NULL). Histograms are
+	 * written as cumulative buckets (le="0", le="1", ..., le="+Inf") plus sum and count.
+	 * Returns 1 if succeeded, 0 if a write failed.
+	 * */
+	int datastats_export( FILE* out, const char* prefix, const char* instance,
+						  const struct datastats_metric* metrics, size_t n );
+
+#endif /* DATASTATS_H_ */
@@ -93,49 +93,13 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
 #include "adjlgraph.h"
 #include "dfsalg.h"
-
-/*
- * Recursively computes the number of adjacency list graph connected vertices starting at a given vertice,
- * using the Deph-first search algorithm.
- * Returns the number of counted vertices.
- */
-void dfsalg_dfs_rec(struct adjlgraph* g, bool* visited, int vertice, ulong* result)
-{
-	// We have already visited this node
-	if (visited[vertice])
-		return;
-
-	// mark as visited
-	visited[vertice] = true;
-	*result +=1;
-	struct adjlgvertex* v = g->vertexlist[vertice];
-	struct adjlgedge* e = v->edgeslist;
-
-	// visit all neighbor vertices
-	while (e != NULL) {
-		dfsalg_dfs_rec(g, visited, e->vertexindex, result);
-		e = e->next;
-	}
-}
-
-/*
- * Uses Depth-first search algorithm to compute number of connectd vertices in adjacency list graph
- * starting at a given vertice.
- * Returns result as pointer to unsigned long.
- */
-void dfsalg_countvertices(struct adjlgraph* g, int start, ulong* result)
-{
-	size_t numvert = g->numvertices;
-	bool visited[numvert];
-	for(int i = 0; i < numvert; ++i)
-		visited[i] = false;
-
-	*result = 0;
-	dfsalg_dfs_rec(g, visited, start, result);
-}
-
+#include "transclosure.h"
+#include "bitset.h"
 
 //-----------------------------------------------
 /*
@@ -175,128 +139,545 @@ int dfsalg_istack_pop(struct dfsalgistack* s) {
 //----------------------------------------------
 
 
+//--------------------- DFS engine ------------------
+
+/*
+ * Creates a DFS workspace for graphs with up to 'numvertices' vertices.
+ * Buffers are allocated once and reused by every traversal run with the workspace.
+ */
+struct dfsalg_workspace* dfsalg_workspace_create(int numvertices)
+{
+	struct dfsalg_workspace* result = (struct dfsalg_workspace*)malloc(sizeof(*result));
+	if (result == NULL) {
+		printf("Memory error: failed to allocate memory for DFS workspace!\n");
+		abort();
+	}
+
+	result->n = numvertices;
+	result->epoch = 0;
+	result->time = 0;
+	result->stack = dfsalg_create_istack(numvertices);
+	result->cursor = (struct adjlgedge**)malloc(numvertices * sizeof(struct adjlgedge*));
+	result->discovery = (int*)malloc(numvertices * sizeof(int));
+	result->finish = (int*)malloc(numvertices * sizeof(int));
+	result->seen = (unsigned int*)calloc(numvertices, sizeof(unsigned int));
+	if (!(result->cursor) || !(result->discovery) || !(result->finish) || !(result->seen)) {
+		printf("Memory error: failed to allocate memory for DFS workspace arrays!\n");
+		abort();
+	}
+
+	return result;
+}
+
+/*
+ * Starts a new traversal: all vertices become undiscovered and time restarts at 0.
+ * Only the epoch is advanced, stamps are cleared when it wraps around.
+ */
+void dfsalg_workspace_begin(struct dfsalg_workspace* ws)
+{
+	if (++(ws->epoch) == 0) {
+		memset(ws->seen, 0, ws->n * sizeof(unsigned int));
+		ws->epoch = 1;
+	}
+
+	ws->time = 0;
+}
+
+/*
+ * Checks if vertex 'v' was discovered since last 'dfsalg_workspace_begin'.
+ */
+bool dfsalg_isdiscovered(const struct dfsalg_workspace* ws, int v)
+{
+	return ws->seen[v] == ws->epoch;
+}
+
+/*
+ * Marks 'v' as discovered and pushes it onto the DFS path.
+ */
+void dfsalg_discover(struct dfsalg_workspace* ws, struct adjlgraph* g, int v, int parent,
+					 const struct dfsalg_visitor* visitor)
+{
+	ws->seen[v] = ws->epoch;
+	ws->discovery[v] = ws->time++;
+	ws->finish[v] = -1;
+	ws->cursor[v] = (g->vertexlist[v] != NULL) ? g->vertexlist[v]->edgeslist : NULL;
+	dfsalg_istack_push(ws->stack, v);
+
+	if (visitor && visitor->preorder)
+		visitor->preorder(v, parent, visitor->arg);
+}
+
+/*
+ * Runs an iteractive depth first search from 'start' over vertices not yet discovered
+ * in the current traversal, calling the visitor callbacks ('visitor' may be NULL).
+ * Each stacked vertex keeps a cursor to its next unexplored edge, so a vertex is pushed
+ * only once and the stack never holds more than 'numvertices' elements.
+ * Returns the number of vertices discovered by this call.
+ */
+size_t dfsalg_visit(struct dfsalg_workspace* ws, struct adjlgraph* g, int start,
+					const struct dfsalg_visitor* visitor)
+{
+	if (g->numvertices > ws->n) {
+		printf("Error: graph has more vertices than DFS workspace!\n");
+		abort();
+	}
+
+	if (dfsalg_isdiscovered(ws, start))
+		return 0;
+
+	size_t result = 1;
+	dfsalg_discover(ws, g, start, -1, visitor);
+	struct dfsalgistack* s = ws->stack;
+
+	while (!dfsalg_istack_isempty(s)) {
+		int from = dfsalg_istack_peek(s);
+		struct adjlgedge* edge = ws->cursor[from];
+
+		if (edge == NULL) {
+			// all edges explored, backtrack
+			dfsalg_istack_pop(s);
+			ws->finish[from] = ws->time++;
+			if (visitor && visitor->postorder)
+				visitor->postorder(from, dfsalg_istack_isempty(s) ? -1 : dfsalg_istack_peek(s),
+								   visitor->arg);
+			continue;
+		}
+
+		ws->cursor[from] = edge->next;
+		int to = edge->vertexindex;
+		if (!dfsalg_isdiscovered(ws, to)) {
+			result++;
+			dfsalg_discover(ws, g, to, from, visitor);
+		}
+		else if (visitor && visitor->nontreeedge)
+			visitor->nontreeedge(from, to, visitor->arg);
+	}
+
+	return result;
+}
+
+/*
+ * Releases a DFS workspace from memory.
+ */
+void dfsalg_workspace_destroy(struct dfsalg_workspace* ws)
+{
+	free(ws->stack);
+	free(ws->cursor);
+	free(ws->discovery);
+	free(ws->finish);
+	free(ws->seen);
+	free(ws);
+}
+
+// topological sort state
+struct dfsalg_toposort_state {
+	struct dfsalg_workspace* ws;
+	int* order;				// result (filled backwards)
+	int pos;				// next free position of 'order'
+	bool cycle;				// a back edge was found
+};
+
+void dfsalg_toposort_post(int v, int parent, void* arg) {
+	struct dfsalg_toposort_state* st = (struct dfsalg_toposort_state*)arg;
+	st->order[--(st->pos)] = v;
+}
+
+void dfsalg_toposort_edge(int from, int to, void* arg) {
+	struct dfsalg_toposort_state* st = (struct dfsalg_toposort_state*)arg;
+	if (st->ws->finish[to] == -1)
+		st->cycle = true;	// 'to' is still on the DFS path: back edge
+}
+
+/*
+ * Computes a topological order of a directed graph (an edge u->v puts 'u' before 'v'),
+ * using reverse DFS post-order.
+ * Returns an array with all vertices or NULL if the graph has a cycle.
+ * Note: returned array must be released later from memory.
+ */
+int* dfsalg_toposort(struct dfsalg_workspace* ws, struct adjlgraph* g)
+{
+	int n = g->numvertices;
+	struct dfsalg_toposort_state st = { ws, (int*)malloc((n > 0 ? n : 1) * sizeof(int)), n, false };
+	struct dfsalg_visitor visitor = { NULL, dfsalg_toposort_post, dfsalg_toposort_edge, &st };
+	if (!st.order) {
+		printf("Memory error: failed to allocate memory for topological order!\n");
+		abort();
+	}
+
+	dfsalg_workspace_begin(ws);
+	for (int v = 0; v < n && !st.cycle; ++v)
+		dfsalg_visit(ws, g, v, &visitor);
+
+	if (st.cycle) {
+		free(st.order);
+		return NULL;
+	}
+
+	return st.order;
+}
+
+// Tarjan SCC state ('discovery' times of the workspace are the Tarjan indexes)
+struct dfsalg_scc_state {
+	struct dfsalg_workspace* ws;
+	int* low;				// lowest index reachable from subtree
+	struct bitset* onstack;	// vertex is on Tarjan stack
+	struct dfsalgistack* s;	// Tarjan stack
+	int* component;			// result
+	int count;				// number of components
+};
+
+void dfsalg_scc_pre(int v, int parent, void* arg) {
+	struct dfsalg_scc_state* st = (struct dfsalg_scc_state*)arg;
+	st->low[v] = st->ws->discovery[v];
+	bitset_set(st->onstack, v);
+	dfsalg_istack_push(st->s, v);
+}
+
+void dfsalg_scc_edge(int from, int to, void* arg) {
+	struct dfsalg_scc_state* st = (struct dfsalg_scc_state*)arg;
+	if (bitset_test(st->onstack, to) && st->ws->discovery[to] < st->low[from])
+		st->low[from] = st->ws->discovery[to];
+}
+
+void dfsalg_scc_post(int v, int parent, void* arg) {
+	struct dfsalg_scc_state* st = (struct dfsalg_scc_state*)arg;
+	if (st->low[v] == st->ws->discovery[v]) {
+		// 'v' is the root of a component: pop its members
+		int w;
+		do {
+			w = dfsalg_istack_pop(st->s);
+			bitset_clear(st->onstack, w);
+			st->component[w] = st->count;
+		} while (w != v);
+
+		st->count++;
+	}
+
+	if (parent != -1 && st->low[v] < st->low[parent])
+		st->low[parent] = st->low[v];
+}
+
+/*
+ * Computes the strongly connected components of an adjacency list graph with Tarjan
+ * algorithm run on the iteractive DFS engine.
+ * Fills 'component' (size numvertices) with the component of each vertex, numbered in
+ * reverse topological order (see dfsalg_csr_scc).
+ * Returns the number of components.
+ */
+int dfsalg_scc(struct dfsalg_workspace* ws, struct adjlgraph* g, int* component)
+{
+	int n = g->numvertices;
+	struct dfsalg_scc_state st;
+	st.ws = ws;
+	st.low = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+	st.onstack = bitset_create(n);
+	st.s = dfsalg_create_istack(n);
+	st.component = component;
+	st.count = 0;
+	if (!st.low || !st.onstack) {
+		printf("Memory error: failed to allocate memory for SCC arrays!\n");
+		abort();
+	}
+
+	struct dfsalg_visitor visitor = { dfsalg_scc_pre, dfsalg_scc_post, dfsalg_scc_edge, &st };
+	dfsalg_workspace_begin(ws);
+	for (int v = 0; v < n; ++v)
+		dfsalg_visit(ws, g, v, &visitor);
+
+	free(st.s);
+	bitset_destroy(st.onstack);
+	free(st.low);
+	return st.count;
+}
+
+//--------------------- DFS engine ------------------
+
+/*
+ * Uses Depth-first search algorithm to compute number of connectd vertices in adjacency list graph
+ * starting at a given vertice.
+ * Returns result as pointer to unsigned long.
+ */
+void dfsalg_countvertices(struct adjlgraph* g, int start, ulong* result)
+{
+	struct dfsalg_workspace* ws = dfsalg_workspace_create(g->numvertices);
+	dfsalg_workspace_begin(ws);
+	*result = dfsalg_visit(ws, g, start, NULL);
+	dfsalg_workspace_destroy(ws);
+}
+
 /*
  * Uses Depth-first search iteractive algorithm to compute number of connectd vertices in an adjacency list
  * graph starting at a given vertice.
  * Returns number of connectd vertices result as a pointer to unsigned long.
  */
 void dfsalg_countvertices_iteractive(struct adjlgraph* g, int start, ulong* result)
+{
+	dfsalg_countvertices(g, start, result);
+}
+
+/*
+ * Uses Depth-first search iteractive algorithm to compute number of connectd vertices in a CSR
+ * graph starting at a given vertice.
+ * Each stacked vertex keeps a cursor to its next unexplored edge, so a vertex is pushed only
+ * once and the stack never holds more than 'numvertices' elements.
+ * Returns number of connectd vertices result as a pointer to unsigned long.
+ */
+void dfsalg_csr_countvertices(const struct csrgraph* g, int start, ulong* result)
 {
 	*result = 0;
-	int n = g->numvertices;
+	size_t n = g->numvertices;
 	struct dfsalgistack* s = dfsalg_create_istack(n);
-	bool visited[n];
-	for(int i = 0;i < n; i++) {
-		visited[i] = false;
+	size_t* cursor = (size_t*)malloc(n * sizeof(size_t));	// next edge to explore
+	struct bitset* visited = bitset_create(n);				// 1 bit per vertex
+
+	if (!cursor || !visited) {
+		printf("Memory error: failed to allocate memory for DFS arrays!\n");
+		abort();
 	}
 
-	// get start vertice
-	int from = start;
-	struct adjlgvertex* fromv = g->vertexlist[from];
-	// push start vertice index onto stack
-	dfsalg_istack_push(s, from);
-	struct adjlgedge* edge = NULL;
+	bitset_set(visited, start);
+	cursor[start] = g->offsets[start];
+	*result += 1;
+	dfsalg_istack_push(s, start);
 
 	while (!dfsalg_istack_isempty(s)) {
-		from = dfsalg_istack_pop(s);
+		int from = dfsalg_istack_peek(s);
 
-		if (!visited[from]) {
-			visited[from] = true;
+		if (cursor[from] == g->offsets[from + 1]) {
+			dfsalg_istack_pop(s);	// all edges explored, backtrack
+			continue;
+		}
+
+		int to = g->targets[cursor[from]++];
+		if (!bitset_test_and_set(visited, to)) {
+			cursor[to] = g->offsets[to];
 			*result += 1;
-			fromv = g->vertexlist[from];
-			edge = fromv->edgeslist;
-			while (edge) {
-				int to = edge->vertexindex;
-				dfsalg_istack_push(s, to);
-				edge = edge->next;
-			}
+			dfsalg_istack_push(s, to);
 		}
 	}
 
-	// release stack
+	bitset_destroy(visited);
+	free(cursor);
 	free(s);
 }
 
+// vertices claimed by one worker of a parallel count
+struct dfsalg_parallel_count {
+	ulong count;
+} __attribute__((aligned(TASKPOOL_CACHE_LINE)));
+
+// shared state of a parallel count
+struct dfsalg_parallel_state {
+	struct adjlgraph* g;					// adjacency list graph (or NULL)
+	const struct csrgraph* csr;				// CSR graph (or NULL)
+	struct bitset* visited;					// claimed vertices
+	struct dfsalg_parallel_count* counts;	// per worker counts
+};
+
 /*
- * DFS recursive graph traversal.
+ * Claims vertex 'v'.
+ * Returns true if the calling thread is the first one.
+ * Note: Private function.
  */
-void dfsagl_dfs_traverse_rec(struct adjlgraph* g, int u, bool* vis)
+bool dfsalg_parallel_claim(struct dfsalg_parallel_state* st, int v)
 {
-	vis[u] = true;
-	struct adjlgedge* edge = g->vertexlist[u]->edgeslist;
-	while (edge) {
-		if (!vis[edge->vertexindex])
-			dfsagl_dfs_traverse_rec(g, edge->vertexindex, vis);
-		edge = edge->next;
-	}
+	return !bitset_test_and_set_atomic(st->visited, v);
 }
 
 /*
- * Find ancestors of each node in the given adjacency list graph.
- * Returns an array of linked lists. Each array index is the vertice number and each value is a
- * linked list of ancestors for the given vertice.
- *
- * Time Complexity: O(V^2)
- * Auxiliary Space: O(|V| + |E|)
+ * Work item of a parallel count: explores the edges of a claimed vertex. The last
+ * vertex claimed is explored by the same item (depth-first), the others are spawned.
+ * Note: Private function.
  */
-struct dfsalgancestornode** dfsalg_find_ancestors(struct adjlgraph* g)
+void dfsalg_parallel_task(struct taskpool* pool, void* item, int worker, void* arg)
 {
-	size_t n = g->numvertices;
-	struct dfsalgancestornode** result = calloc(n, sizeof(struct dfsalgancestornode));
+	struct dfsalg_parallel_state* st = (struct dfsalg_parallel_state*)arg;
+	int v = (int)(intptr_t)item;
+	while (v >= 0) {
+		int next = -1;
+		if (st->g != NULL) {
+			struct adjlgvertex* vx = st->g->vertexlist[v];
+			for (struct adjlgedge* e = (vx != NULL) ? vx->edgeslist : NULL; e != NULL; e = e->next)
+				if (dfsalg_parallel_claim(st, e->vertexindex)) {
+					st->counts[worker].count++;
+					if (next >= 0)
+						taskpool_spawn(pool, worker, (void*)(intptr_t)next);
+					next = e->vertexindex;
+				}
+		}
+		else {
+			for (size_t i = st->csr->offsets[v]; i < st->csr->offsets[v + 1]; i++)
+				if (dfsalg_parallel_claim(st, st->csr->targets[i])) {
+					st->counts[worker].count++;
+					if (next >= 0)
+						taskpool_spawn(pool, worker, (void*)(intptr_t)next);
+					next = st->csr->targets[i];
+				}
+		}
+
+		v = next;
+	}
+}
 
-	// Create an adjancency list with
-	// edges reversed
-	struct adjlgraph* rev = adjlgraph_create_copy_from(g, true);
-	if (rev == NULL) {
-		printf("Memory error: failed to allocate memory for reversed graph!\n");
+/*
+ * Runs a parallel count of the vertices reachable from 'start'.
+ * Note: Private function.
+ */
+ulong dfsalg_parallel_count(struct taskpool* pool, struct dfsalg_parallel_state* st,
+							size_t n, int start)
+{
+	int nthreads = taskpool_getthreads(pool);
+	st->visited = bitset_create(n);
+	st->counts = (struct dfsalg_parallel_count*)aligned_alloc(TASKPOOL_CACHE_LINE,
+								nthreads * sizeof(struct dfsalg_parallel_count));
+	if (!st->visited || !st->counts) {
+		printf("Memory error: failed to allocate memory for DFS arrays!\n");
 		abort();
 	}
 
-	bool visited[n];
+	for (int i = 0; i < nthreads; i++)
+		st->counts[i].count = 0;
 
-	// Resultant List where for each
-    // index i from 0 to n-1 the resultant
-    // sorted ancestors list for ith
-    // index will be stored
-	for (int i = 0; i < n; ++i) {
-		// init visited to false
-		for (int j = 0; j < n; ++j) {
-			visited[j] = false;
-		}
+	bitset_set(st->visited, start);
+	void* root = (void*)(intptr_t)start;
+	taskpool_run(pool, dfsalg_parallel_task, st, &root, 1);
+
+	ulong result = 1;
+	for (int i = 0; i < nthreads; i++)
+		result += st->counts[i].count;
+
+	free(st->counts);
+	bitset_destroy(st->visited);
+	return result;
+}
+
+/*
+ * Parallel count of the vertices reachable from 'start' on the threads of 'pool'.
+ * Each vertex is claimed once with an atomic bit and its edges are explored by the
+ * worker that claimed it; the other claimed vertices are spawned as work items that
+ * idle workers steal (see taskpool.h). Vertices are not visited in DFS order across
+ * workers, only within each one.
+ * Returns number of connectd vertices result as a pointer to unsigned long.
+ */
+void dfsalg_countvertices_parallel(struct taskpool* pool, struct adjlgraph* g, int start,
+								   ulong* result)
+{
+	struct dfsalg_parallel_state st = { .g = g, .csr = NULL };
+	*result = dfsalg_parallel_count(pool, &st, g->numvertices, start);
+}
+
+void dfsalg_csr_countvertices_parallel(struct taskpool* pool, const struct csrgraph* g,
+									   int start, ulong* result)
+{
+	struct dfsalg_parallel_state st = { .g = NULL, .csr = g };
+	*result = dfsalg_parallel_count(pool, &st, g->numvertices, start);
+}
+
+/*
+ * Computes the strongly connected components of a CSR graph with an iteractive version of
+ * Tarjan algorithm (no recursion, stack depth bounded by the number of vertices).
+ * Fills 'component' (size numvertices) with the component of each vertex.
+ * Components are numbered in reverse topological order: an edge between two components
+ * always goes from a higher to a lower component number.
+ * Returns the number of components.
+ */
+int dfsalg_csr_scc(const struct csrgraph* g, int* component)
+{
+	size_t n = g->numvertices;
+	struct dfsalgistack* calls = dfsalg_create_istack(n);	// DFS path
+	struct dfsalgistack* s = dfsalg_create_istack(n);		// Tarjan stack
+	size_t* cursor = (size_t*)malloc(n * sizeof(size_t));	// next edge to explore
+	int* index = (int*)malloc(n * sizeof(int));
+	int* low = (int*)malloc(n * sizeof(int));
+	struct bitset* onstack = bitset_create(n);
+
+	if (!cursor || !index || !low || !onstack) {
+		printf("Memory error: failed to allocate memory for SCC arrays!\n");
+		abort();
+	}
 
-		// current vertice has no ancestors by default
-		result[i] = NULL;
-
-		// traverse reversed graph to find current vertice neighbors
-		dfsagl_dfs_traverse_rec(rev, i, visited);
-
-		// linked lits of ancestor nodes
-		struct dfsalgancestornode* first = NULL;
-		struct dfsalgancestornode* current = NULL;
-		struct dfsalgancestornode* prev = NULL;
-
-		for (int j = 0; j < n; j++) {
-			// All the ancestors for node i
-			// will be visited after DFS call
-			if (visited[j] && (i != j)) {
-				current = (struct dfsalgancestornode*)malloc(sizeof(struct dfsalgancestornode));
-				current->vertice = j;
-				current->next = NULL;
-				if (prev) prev->next = current;
-				prev = current;
+	for (size_t i = 0; i < n; ++i)
+		index[i] = -1;
+
+	int nextindex = 0, count = 0;
+	for (size_t root = 0; root < n; ++root) {
+		if (index[root] != -1)
+			continue;
+
+		index[root] = low[root] = nextindex++;
+		cursor[root] = g->offsets[root];
+		bitset_set(onstack, root);
+		dfsalg_istack_push(s, root);
+		dfsalg_istack_push(calls, root);
+
+		while (!dfsalg_istack_isempty(calls)) {
+			int v = dfsalg_istack_peek(calls);
+
+			if (cursor[v] < g->offsets[v + 1]) {
+				int w = g->targets[cursor[v]++];
+				if (index[w] == -1) {
+					// tree edge: descend
+					index[w] = low[w] = nextindex++;
+					cursor[w] = g->offsets[w];
+					bitset_set(onstack, w);
+					dfsalg_istack_push(s, w);
+					dfsalg_istack_push(calls, w);
+				}
+				else if (bitset_test(onstack, w) && index[w] < low[v])
+					low[v] = index[w];
+
+				continue;
 			}
 
-			if (!first) first = current;
-		}
+			// all edges explored, backtrack
+			dfsalg_istack_pop(calls);
+			if (low[v] == index[v]) {
+				// 'v' is the root of a component: pop its members
+				int w;
+				do {
+					w = dfsalg_istack_pop(s);
+					bitset_clear(onstack, w);
+					component[w] = count;
+				} while (w != v);
+
+				count++;
+			}
 
-		// Store the resultant node list in the
-		// corresponding index
-		result[i] = first;
+			if (!dfsalg_istack_isempty(calls)) {
+				int u = dfsalg_istack_peek(calls);
+				if (low[v] < low[u])
+					low[u] = low[v];
+			}
+		}
 	}
 
-	// release reversed graph
-	adjlgraph_destroy(rev);
+	bitset_destroy(onstack);
+	free(low);
+	free(index);
+	free(cursor);
+	free(s);
+	free(calls);
+	return count;
+}
+
+/*
+ * Find ancestors of each node in the given adjacency list graph.
+ * Returns an array of linked lists. Each array index is the vertice number and each value is a
+ * linked list of ancestors for the given vertice.
+ * Graph is condensed into strongly connected components and ancestors are propagated as
+ * bitsets in topological order (see transclosure.h).
+ *
+ * Time Complexity: O(V + E + E * C / 64) plus output size (C components)
+ * Auxiliary Space: O(V + E + C^2 / 8)
+ */
+struct dfsalgancestornode** dfsalg_find_ancestors(struct adjlgraph* g)
+{
+	struct csrgraph* csr = adjlgraph_freeze_to_csr(g);
+	struct transclosure* tc = transclosure_ancestors_create(csr, 1);
+	struct dfsalgancestornode** result = transclosure_to_ancestorlists(tc);
 
+	transclosure_destroy(tc);
+	csrgraph_destroy(csr);
 	return result;
 }
 
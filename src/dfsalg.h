@@ -86,7 +86,10 @@
 
 #ifndef DFSALG_H_
 	#define DFSALG_H_
+	#include <stdbool.h>
 	#include "adjlgraph.h"
+	#include "csrgraph.h"
+	#include "taskpool.h"
 
 	/*
 	 * Declares the ancestor node struct for find ancestors function
@@ -96,6 +99,92 @@
 		struct dfsalgancestornode* next;
 	};
 
+	struct dfsalgistack;	// integer stack (see dfsalg.c)
+
+	/*
+	 * Vertex callback of the DFS engine. 'parent' is -1 for the root of a DFS tree.
+	 */
+	typedef void (*dfsalg_vertexfunc)(int v, int parent, void* arg);
+
+	/*
+	 * Edge callback of the DFS engine.
+	 */
+	typedef void (*dfsalg_edgefunc)(int from, int to, void* arg);
+
+	/*
+	 * DFS engine callbacks (any of them may be NULL).
+	 */
+	struct dfsalg_visitor {
+		dfsalg_vertexfunc preorder;			// vertex discovered
+		dfsalg_vertexfunc postorder;		// all edges of the vertex explored
+		dfsalg_edgefunc nontreeedge;		// edge to an already discovered vertex
+		void* arg;							// user argument given to callbacks
+	};
+
+	/*
+	 * Reusable workspace of the iteractive DFS engine.
+	 * A vertex is discovered only if its 'seen' stamp matches the current epoch, so
+	 * starting a new traversal does not clear any array. 'discovery' and 'finish'
+	 * times are valid for discovered vertices ('finish' is -1 while on the DFS path).
+	 */
+	struct dfsalg_workspace {
+		int n;								// capacity (maximum number of vertices)
+		unsigned int epoch;					// current traversal stamp
+		int time;							// next discovery/finish time
+		struct dfsalgistack* stack;			// DFS path
+		struct adjlgedge** cursor;			// next edge to explore of each vertex on the path
+		int* discovery;						// discovery time of each vertex
+		int* finish;						// finish time of each vertex
+		unsigned int* seen;					// epoch in which vertex was discovered
+	};
+
+	/*
+	 * Creates a DFS workspace for graphs with up to 'numvertices' vertices.
+	 * Buffers are allocated once and reused by every traversal run with the workspace.
+	 */
+	struct dfsalg_workspace* dfsalg_workspace_create(int numvertices);
+
+	/*
+	 * Starts a new traversal: all vertices become undiscovered and time restarts at 0.
+	 */
+	void dfsalg_workspace_begin(struct dfsalg_workspace* ws);
+
+	/*
+	 * Checks if vertex 'v' was discovered since last 'dfsalg_workspace_begin'.
+	 */
+	bool dfsalg_isdiscovered(const struct dfsalg_workspace* ws, int v);
+
+	/*
+	 * Runs an iteractive depth first search from 'start' over vertices not yet discovered
+	 * in the current traversal, calling the visitor callbacks ('visitor' may be NULL).
+	 * Calling it for every vertex after one 'dfsalg_workspace_begin' visits a DFS forest.
+	 * Returns the number of vertices discovered by this call.
+	 */
+	size_t dfsalg_visit(struct dfsalg_workspace* ws, struct adjlgraph* g, int start,
+						const struct dfsalg_visitor* visitor);
+
+	/*
+	 * Releases a DFS workspace from memory.
+	 */
+	void dfsalg_workspace_destroy(struct dfsalg_workspace* ws);
+
+	/*
+	 * Computes a topological order of a directed graph (an edge u->v puts 'u' before 'v'),
+	 * using reverse DFS post-order.
+	 * Returns an array with all vertices or NULL if the graph has a cycle.
+	 * Note: returned array must be released later from memory.
+	 */
+	int* dfsalg_toposort(struct dfsalg_workspace* ws, struct adjlgraph* g);
+
+	/*
+	 * Computes the strongly connected components of an adjacency list graph with Tarjan
+	 * algorithm run on the iteractive DFS engine.
+	 * Fills 'component' (size numvertices) with the component of each vertex, numbered in
+	 * reverse topological order (see dfsalg_csr_scc).
+	 * Returns the number of components.
+	 */
+	int dfsalg_scc(struct dfsalg_workspace* ws, struct adjlgraph* g, int* component);
+
 	/*
 	 * Uses Depth-first search algorithm to compute number of connectd vertices in adjacency list graph
 	 * starting at a given vertice.
@@ -109,13 +198,45 @@
 	 */
 	void dfsalg_countvertices_iteractive(struct adjlgraph* g, int start, ulong* result);
 
+	/*
+	 * Uses Depth-first search iteractive algorithm to compute number of connectd vertices in a CSR
+	 * graph starting at a given vertice. Stack depth is bounded by the number of vertices.
+	 * Returns number of connectd vertices result as a pointer to unsigned long.
+	 */
+	void dfsalg_csr_countvertices(const struct csrgraph* g, int start, ulong* result);
+
+	/*
+	 * Parallel count of the vertices reachable from 'start' on the threads of 'pool'.
+	 * Each vertex is claimed once with an atomic bit and its edges are explored by the
+	 * worker that claimed it; the other claimed vertices are spawned as work items that
+	 * idle workers steal (see taskpool.h). Vertices are not visited in DFS order across
+	 * workers, only within each one.
+	 * Returns number of connectd vertices result as a pointer to unsigned long.
+	 */
+	void dfsalg_countvertices_parallel(struct taskpool* pool, struct adjlgraph* g, int start,
+									   ulong* result);
+	void dfsalg_csr_countvertices_parallel(struct taskpool* pool, const struct csrgraph* g,
+										   int start, ulong* result);
+
+	/*
+	 * Computes the strongly connected components of a CSR graph with an iteractive version of
+	 * Tarjan algorithm (no recursion, stack depth bounded by the number of vertices).
+	 * Fills 'component' (size numvertices) with the component of each vertex.
+	 * Components are numbered in reverse topological order: an edge between two components
+	 * always goes from a higher to a lower component number.
+	 * Returns the number of components.
+	 */
+	int dfsalg_csr_scc(const struct csrgraph* g, int* component);
+
 	/*
 	 * Find ancestors of each node in the given adjacency list graph.
 	 * Returns an array of linked lists. Each array index is the vertice number and each value is a
 	 * linked list of ancestors for the given vertice.
+	 * Graph is condensed into strongly connected components and ancestors are propagated as
+	 * bitsets in topological order (see transclosure.h).
 	 *
-	 * Time Complexity: O(V2)
-	 * Auxiliary Space: O(|V| + |E|)
+	 * Time Complexity: O(V + E + E * C / 64) plus output size (C components)
+	 * Auxiliary Space: O(V + E + C^2 / 8)
 	 */
 	struct dfsalgancestornode** dfsalg_find_ancestors(struct adjlgraph* g);
 
@@ -12,7 +12,11 @@
 #include <float.h>
 #include <string.h>
 #include "adjlgraph.h"
-#include "indminbinaryheap.h"
+#include "csrgraph.h"
+#include "indmindblheap.h"
+#include "pairingheap.h"
+#include "radixheap.h"
+#include "dijkstrasp.h"
 
 #define DIJKSTRA_EPS 1e-6	// handle very small differences with double values
 #define DIJKSTRA_EMPTY -1	// empty slot
@@ -58,14 +62,6 @@ double dijkstrasp_abs(double value) {
 
 // Utility functions --------------
 
-/*
- * Declare vertice/distance pair struct to be stored in priority queue.
- */
-struct dijkstra_vert_dist_pair {
-	int vid;
-	double dist;
-};
-
 /*
  * Checks if double value is too small.
  */
@@ -83,27 +79,6 @@ int dijkstrasp_compare(const double a, const double b) {
 	else return 0;
 }
 
-/*
- * Compare function for priority queue.
- */
-int dijkstrasp_compare_pq( const void* a, const void* b ) {
-
-	double da = *((double*)a);
-	double db = *((double*)b);
-
-	if ( dijkstra_too_small( da - db ) ) return 0;
-	else if (da > db) return 1;
-	else if (da < db) return -1;
-	else return 0;
-}
-
-/*
- * Free data function for priority queue.
- */
-void dijkstrasp_freedata_pq( void* data ) {
-	free(data);
-}
-
 /**
 * Reconstructs the shortest path (of nodes) from 'start' to 'end' inclusive.
 *
@@ -146,106 +121,593 @@ int* dijkstrasp_adjlist_reconstructPath(int start, int end, int* prev, int n,
 	return NULL;
 }
 
+//--------------------- context ------------------
+
 /*
- * Computes the shortest path and distance from a start vertice to destination vertice
- * using the Dijkstra shortest path algorithm.
- *
- * Returns shortest path from start vertice to end vertice or 'NULL' if end vertice
- * is unreachable. Also distance to vertices is filled and returned in 'dist' array.
- * 'spath_size_p' returns the size of shortest path array.
- * Note: 'dist' argument must have size equal to number of vertices in graph.
+ * Compares two distances of pairing heap elements (pointers to 'dist' entries).
  */
-int* dijkstrasp_adjlist_shortest_path(struct adjlgraph* g, int start, int end,
-		double* dist, int* spath_size_p)
+int dijkstrasp_pairheap_compare(const void* a, const void* b) {
+	double da = *((const double*)a), db = *((const double*)b);
+	return (da > db) - (da < db);
+}
+
+/*
+ * Creates a Dijkstra context for graphs with up to 'numvertices' vertices using the
+ * given priority queue type (see dijkstrasp_queue).
+ */
+struct dijkstrasp_context* dijkstrasp_context_create_queue(int numvertices, dijkstrasp_queue queue)
+{
+	struct dijkstrasp_context* result = (struct dijkstrasp_context*)malloc(sizeof(*result));
+	if (!result) {
+		printf("Memory error: failed to allocate memory for Dijkstra context!");
+		abort();
+	}
+
+	result->n = numvertices;
+	result->epoch = 0;
+	result->numsettled = 0;
+	result->dist = (double*)malloc(numvertices * sizeof(double));
+	result->prev = (int*)malloc(numvertices * sizeof(int));
+	result->seen = (unsigned int*)calloc(numvertices, sizeof(unsigned int));
+	result->settled = (unsigned int*)calloc(numvertices, sizeof(unsigned int));
+	if (!(result->dist) || !(result->prev) || !(result->seen) || !(result->settled)) {
+		printf("Memory error: failed to allocate memory for Dijkstra context arrays!");
+		abort();
+	}
+
+	result->queue = queue;
+	result->pq = NULL;
+	result->ph = NULL;
+	result->handles = NULL;
+	result->rh = NULL;
+	switch (queue) {
+		case DIJKSTRASP_QUEUE_PAIRING:
+			result->ph = pairheap_create(dijkstrasp_pairheap_compare, NULL, NULL);
+			result->handles = (struct pairheapnode**)malloc(numvertices * sizeof(struct pairheapnode*));
+			if (!(result->handles)) {
+				printf("Memory error: failed to allocate memory for Dijkstra context arrays!");
+				abort();
+			}
+			break;
+		case DIJKSTRASP_QUEUE_RADIX:
+			result->rh = radixheap_create(numvertices);
+			break;
+		default:
+			result->pq = imindblpq_create(numvertices);
+			break;
+	}
+
+	return result;
+}
+
+/*
+ * Creates a Dijkstra context for graphs with up to 'numvertices' vertices.
+ * Buffers are allocated once and reused by every query run with the context.
+ */
+struct dijkstrasp_context* dijkstrasp_context_create(int numvertices)
+{
+	return dijkstrasp_context_create_queue(numvertices, DIJKSTRASP_QUEUE_DARY);
+}
+
+//--------------------- priority queue of context ------------------
+
+/*
+ * Gets the radix heap priority of a distance (distances must be integers).
+ */
+uint64_t dijkstrasp_radixkey(double value)
+{
+	uint64_t key = (uint64_t)value;
+	if (value < 0 || (double)key != value) {
+		printf("Error: radix heap queue requires non-negative integer edge weights!");
+		abort();
+	}
+
+	return key;
+}
+
+/*
+ * Checks if priority queue of context is empty.
+ */
+int dijkstrasp_pq_isempty(const struct dijkstrasp_context* ctx)
+{
+	switch (ctx->queue) {
+		case DIJKSTRASP_QUEUE_PAIRING: return pairheap_isempty(ctx->ph);
+		case DIJKSTRASP_QUEUE_RADIX: return radixheap_isempty(ctx->rh);
+		default: return imindblpq_isempty(ctx->pq);
+	}
+}
+
+/*
+ * Queues vertex 'v' with its distance ('ctx->dist[v]').
+ */
+void dijkstrasp_pq_insert(struct dijkstrasp_context* ctx, int v)
+{
+	switch (ctx->queue) {
+		case DIJKSTRASP_QUEUE_PAIRING:
+			ctx->handles[v] = pairheap_insert(ctx->ph, &ctx->dist[v]);
+			break;
+		case DIJKSTRASP_QUEUE_RADIX:
+			radixheap_insert(ctx->rh, v, dijkstrasp_radixkey(ctx->dist[v]));
+			break;
+		default:
+			imindblpq_insert(ctx->pq, v, ctx->dist[v]);
+			break;
+	}
+}
+
+/*
+ * Updates queued vertex 'v' after its distance ('ctx->dist[v]') was decreased.
+ */
+void dijkstrasp_pq_decrease(struct dijkstrasp_context* ctx, int v)
+{
+	switch (ctx->queue) {
+		case DIJKSTRASP_QUEUE_PAIRING:
+			pairheap_decrease_key(ctx->ph, ctx->handles[v], &ctx->dist[v]);
+			break;
+		case DIJKSTRASP_QUEUE_RADIX:
+			radixheap_decrease(ctx->rh, v, dijkstrasp_radixkey(ctx->dist[v]));
+			break;
+		default:
+			imindblpq_decrease(ctx->pq, v, ctx->dist[v]);
+			break;
+	}
+}
+
+/*
+ * Removes the queued vertex with minimum distance.
+ * Returns removed vertex.
+ */
+int dijkstrasp_pq_extract(struct dijkstrasp_context* ctx)
+{
+	switch (ctx->queue) {
+		case DIJKSTRASP_QUEUE_PAIRING:
+			// elements point to 'dist' entries, vertex is the entry index
+			return (int)((double*)pairheap_extract_min(ctx->ph) - ctx->dist);
+		case DIJKSTRASP_QUEUE_RADIX:
+			return radixheap_extractkeyindex(ctx->rh);
+		default:
+			return imindblpq_extractkeyindex(ctx->pq);
+	}
+}
+
+/*
+ * Gets minimum distance of queued vertices (queue must not be empty).
+ */
+double dijkstrasp_pq_peekvalue(struct dijkstrasp_context* ctx)
+{
+	switch (ctx->queue) {
+		case DIJKSTRASP_QUEUE_PAIRING: return *((double*)pairheap_peek(ctx->ph));
+		case DIJKSTRASP_QUEUE_RADIX: return (double)radixheap_peekvalue(ctx->rh);
+		default: return imindblpq_peekvalue(ctx->pq);
+	}
+}
+
+/*
+ * Removes all queued vertices.
+ */
+void dijkstrasp_pq_clear(struct dijkstrasp_context* ctx)
+{
+	switch (ctx->queue) {
+		case DIJKSTRASP_QUEUE_PAIRING: pairheap_clear(ctx->ph); break;
+		case DIJKSTRASP_QUEUE_RADIX: radixheap_clear(ctx->rh); break;
+		default: imindblpq_clear(ctx->pq); break;
+	}
+}
+
+//--------------------- priority queue of context ------------------
+
+/*
+ * Checks that a CSR graph has edge weights (mapped graphs may have none).
+ */
+void dijkstrasp_check_weights(const struct csrgraph* g)
+{
+	if (g->weights == NULL) {
+		printf("Error: Dijkstra algorithm requires a weighted graph!");
+		abort();
+	}
+}
+
+/*
+ * Prepares context buffers for a new query from 'start'.
+ * Only the epoch is advanced, stamps are cleared when it wraps around.
+ */
+void dijkstrasp_context_reset(struct dijkstrasp_context* ctx, int n, int start)
+{
+	if (n > ctx->n) {
+		printf("Error: graph has more vertices than Dijkstra context!");
+		abort();
+	}
+
+	if (++(ctx->epoch) == 0) {
+		memset(ctx->seen, 0, ctx->n * sizeof(unsigned int));
+		memset(ctx->settled, 0, ctx->n * sizeof(unsigned int));
+		ctx->epoch = 1;
+	}
+
+	dijkstrasp_pq_clear(ctx);	// O(number of queued vertices)
+	ctx->numsettled = 0;
+
+	ctx->seen[start] = ctx->epoch;
+	ctx->dist[start] = 0.0;	// dist to start vertice is zero
+	ctx->prev[start] = DIJKSTRA_EMPTY;
+	dijkstrasp_pq_insert(ctx, start);
+}
+
+/*
+ * Gets the distance from start of last query to vertex 'v'.
+ * Returns 'DBL_MAX' if 'v' was not reached.
+ */
+double dijkstrasp_context_distance(const struct dijkstrasp_context* ctx, int v)
+{
+	return (ctx->seen[v] == ctx->epoch) ? ctx->dist[v] : DBL_MAX;
+}
+
+/*
+ * Relaxes edge 'from' -> 'to' with given weight.
+ */
+void dijkstrasp_context_relax(struct dijkstrasp_context* ctx, int from, int to, double weight)
+{
+	// You cannot get a shorter path by revisiting
+	// a node you have already visited before.
+	if (ctx->settled[to] == ctx->epoch)
+		return;
+
+	double new_dist = ctx->dist[from] + weight;
+	if (ctx->seen[to] != ctx->epoch) {
+		ctx->seen[to] = ctx->epoch;	// first time reached
+		ctx->prev[to] = from;
+		ctx->dist[to] = new_dist;
+		dijkstrasp_pq_insert(ctx, to);
+	}
+	else if (dijkstrasp_compare(new_dist, ctx->dist[to]) < 0) {
+		ctx->prev[to] = from;		// save vertice on path
+		ctx->dist[to] = new_dist;	// update dist with minimum distance
+		dijkstrasp_pq_decrease(ctx, to);
+	}
+}
+
+/*
+ * Reconstructs the shortest path of last query from 'start' to 'end' inclusive.
+ * Walks only the path vertices, result array has the exact path size.
+ * Returns 'NULL' if 'end' was not reached (or is not a vertex, ex: -1 for one to all queries).
+ */
+int* dijkstrasp_context_reconstruct_path(const struct dijkstrasp_context* ctx, int end,
+										 int* spath_size_p)
 {
-//	int result = -1;
-	double init_val = 0.0;
-	double* dblp = malloc(sizeof(double));
-	*dblp = init_val;
-	int ki = start;	// key index for priority queue
-	int n = g->numvertices;
-	int* prev = (int*)malloc(n * sizeof(int));
-
-	// initialize prev with empty slot value
-	dijkstrasp_fillintarray(prev, n, DIJKSTRA_EMPTY);
-
-//	double* dist = (double*)(malloc( n * sizeof(double) ));
-	_Bool* visited = (calloc( n, sizeof(_Bool) ));	// initializes to zeros (false)
-
-	// initialize dist to max possible value (+oo)
-	dijkstrasp_filldblarray(dist, n, DBL_MAX);
-	dist[start] = 0.0;	// dist to start vertice is zero
-
-	// create empty indexed priority queue
-	struct iminbinarypq* ipq = iminbinpq_create (2 * n,
-									dijkstrasp_compare_pq, NULL, dijkstrasp_freedata_pq );
-
-	// create ipq node
-	//struct dijkstra_vert_dist_pair* node = dijkstra_createnode(start, dist[start]);
-	iminbinpq_insert(ipq, ki, dblp);	// inserts (start, 0) pair in priority queue
-	int from_vert = -1;
-	int to_vert = -1;
-
-	while (!iminbinpq_isempty( ipq ))
+	*spath_size_p = 0;
+	if (end < 0 || end >= ctx->n || ctx->seen[end] != ctx->epoch)
+		return NULL;
+
+	int size = 0;
+	for (int at = end; at != DIJKSTRA_EMPTY; at = ctx->prev[at])
+		size++;
+
+	int* result = (int*)malloc(size * sizeof(int));
+	if (!result) {
+		printf( "Memory error: failed to allocate memory for result array of "
+				"shortest path Dijkstra algorithm!" );
+		abort();
+	}
+
+	int i = size;
+	for (int at = end; at != DIJKSTRA_EMPTY; at = ctx->prev[at])
+		result[--i] = at;
+
+	*spath_size_p = size;
+	return result;
+}
+
+/*
+ * Computes the shortest path from a start vertice to destination vertice of an adjacency
+ * list graph, using the buffers of a context (no allocation besides the result path).
+ * Returns shortest path or 'NULL' if end vertice is unreachable. Use
+ * 'dijkstrasp_context_distance' to read distances (valid until the next query).
+ */
+int* dijkstrasp_context_adjlist_shortest_path(struct dijkstrasp_context* ctx, struct adjlgraph* g,
+		int start, int end, int* spath_size_p)
+{
+	dijkstrasp_context_reset(ctx, g->numvertices, start);
+
+	while (!dijkstrasp_pq_isempty( ctx ))
 	{
-		//node = iminbinpq_extractkey( ipq );
-		from_vert = iminbinpq_peekkeyindex(ipq);
-		visited[from_vert] = true;
-		double* min_value_p = (double*)iminbinpq_extractkey( ipq );
-
-		// We already found a better path before we got to
-		// processing this node so we can ignore it.
-		if (dijkstrasp_compare(dist[from_vert], *min_value_p) < 0) {
-			free(min_value_p);
-			continue;
-		} else
-			free(min_value_p);// release double pointer (not needed anymore)
+		int from_vert = dijkstrasp_pq_extract(ctx);
+		ctx->settled[from_vert] = ctx->epoch;
+		ctx->numsettled++;
 
 		struct adjlgedge* edge = g->vertexlist[from_vert]->edgeslist;
 		while (edge) {
-			to_vert = edge->vertexindex;
-			// You cannot get a shorter path by revisiting
-			// a node you have already visited before.
-			if (!(visited[to_vert])) {
-				// Relax edge by updating minimum cost if applicable.
-				double* new_dist_p = (double*)malloc(sizeof(double));
-				*new_dist_p = dist[from_vert] + edge->weight;
-
-				if (dijkstrasp_compare(*new_dist_p, dist[to_vert]) < 0) {
-					// found short distance
-					prev[to_vert] = from_vert;		// save vertice on path
-					dist[to_vert] = *new_dist_p;	// update dist with minimum distance
-					ki = to_vert;
-//					node = dijkstra_createnode(to_vert, dist[to_vert]);
-					if (!iminbinpq_contains( ipq, ki))
-						iminbinpq_insert( ipq, ki, new_dist_p);	// insert in priority queue
-					else
-						iminbinpq_decrease(ipq, ki, new_dist_p);
-				} else
-					free(new_dist_p);
-			}
-
+			dijkstrasp_context_relax(ctx, from_vert, edge->vertexindex, edge->weight);
 			edge = edge->next;
 		}
 
 		// Once we've visited all the nodes spanning from the end
 		// node we know we can return the minimum distance value to
 		// the end node because it cannot get any better after this point.
-		if (from_vert == end) {
-//			result = dist[end];
+		if (from_vert == end)
 			break;
+	}
+
+	return dijkstrasp_context_reconstruct_path(ctx, end, spath_size_p);
+}
+
+/*
+ * Computes the shortest path from a start vertice to destination vertice of a CSR graph,
+ * using the buffers of a context (no allocation besides the result path).
+ * Returns shortest path or 'NULL' if end vertice is unreachable. Use
+ * 'dijkstrasp_context_distance' to read distances (valid until the next query).
+ */
+int* dijkstrasp_context_csr_shortest_path(struct dijkstrasp_context* ctx, const struct csrgraph* g,
+		int start, int end, int* spath_size_p)
+{
+	dijkstrasp_check_weights(g);
+	dijkstrasp_context_reset(ctx, g->numvertices, start);
+
+	while (!dijkstrasp_pq_isempty( ctx ))
+	{
+		int from_vert = dijkstrasp_pq_extract(ctx);
+		ctx->settled[from_vert] = ctx->epoch;
+		ctx->numsettled++;
+
+		size_t last = g->offsets[from_vert + 1];
+		for (size_t e = g->offsets[from_vert]; e < last; ++e)
+			dijkstrasp_context_relax(ctx, from_vert, g->targets[e], g->weights[e]);
+
+		// distance to end can not get any better after this point
+		if (from_vert == end)
+			break;
+	}
+
+	return dijkstrasp_context_reconstruct_path(ctx, end, spath_size_p);
+}
+
+/*
+ * Computes the shortest path from a start vertice to destination vertice of a CSR graph
+ * using A* search. Vertices are extracted by 'dist + heuristic(v)', so search is guided
+ * towards 'end'. The heuristic must never overestimate the distance to 'end' (admissible),
+ * otherwise result may not be the shortest path. A vertex is reopened if a shorter
+ * path to it is found after being settled (only happens with inconsistent heuristics).
+ * Returns shortest path or 'NULL' if end vertice is unreachable. Use
+ * 'dijkstrasp_context_distance' to read distances (valid until the next query).
+ */
+int* dijkstrasp_context_astar_csr_shortest_path(struct dijkstrasp_context* ctx, const struct csrgraph* g,
+		int start, int end, dijkstrasp_heuristic heuristic, void* arg, int* spath_size_p)
+{
+	dijkstrasp_check_weights(g);
+	if (ctx->queue != DIJKSTRASP_QUEUE_DARY) {
+		printf("Error: A* search requires a Dijkstra context with the 4-ary heap queue!");
+		abort();
+	}
+
+	dijkstrasp_context_reset(ctx, g->numvertices, start);
+
+	while (!imindblpq_isempty( ctx->pq ))
+	{
+		int from_vert = imindblpq_extractkeyindex(ctx->pq);
+		ctx->settled[from_vert] = ctx->epoch;
+		ctx->numsettled++;
+
+		// first time end is extracted its distance is final (admissible heuristic)
+		if (from_vert == end)
+			break;
+
+		size_t last = g->offsets[from_vert + 1];
+		for (size_t e = g->offsets[from_vert]; e < last; ++e) {
+			int to = g->targets[e];
+			double new_dist = ctx->dist[from_vert] + g->weights[e];
+
+			if (ctx->seen[to] != ctx->epoch) {
+				ctx->seen[to] = ctx->epoch;	// first time reached
+			}
+			else if (dijkstrasp_compare(new_dist, ctx->dist[to]) >= 0)
+				continue;
+
+			ctx->prev[to] = from_vert;
+			ctx->dist[to] = new_dist;
+			imindblpq_push(ctx->pq, to, new_dist + heuristic(to, end, arg));
 		}
 	}
 
-	// free resources
-	free(visited);
-	iminbinpq_destroy(ipq);
+	return dijkstrasp_context_reconstruct_path(ctx, end, spath_size_p);
+}
+
+/*
+ * Computes the shortest path from a start vertice to destination vertice of a CSR graph
+ * with bidirectional Dijkstra: a forward search from 'start' on 'g' and a backward search
+ * from 'end' on 'rg' (reverse graph of 'g', see csrgraph_create_reverse) run alternately
+ * until their frontiers meet, so only two small balls around start and end are settled.
+ *
+ * 'fwd' and 'bwd' are the contexts of each search.
+ * Returns shortest path or 'NULL' if end vertice is unreachable, path distance is returned
+ * in 'dist_p' ('DBL_MAX' if unreachable).
+ */
+int* dijkstrasp_context_bidirectional(struct dijkstrasp_context* fwd, struct dijkstrasp_context* bwd,
+		const struct csrgraph* g, const struct csrgraph* rg, int start, int end,
+		double* dist_p, int* spath_size_p)
+{
+	dijkstrasp_check_weights(g);
+	dijkstrasp_check_weights(rg);
+	dijkstrasp_context_reset(fwd, g->numvertices, start);
+	dijkstrasp_context_reset(bwd, rg->numvertices, end);
+
+	double best = (start == end) ? 0.0 : DBL_MAX;	// shortest path length found so far
+	int meet = (start == end) ? start : DIJKSTRA_EMPTY;	// vertex where best path crosses
+
+	while (!dijkstrasp_pq_isempty( fwd ) && !dijkstrasp_pq_isempty( bwd ))
+	{
+		// no path through unsettled vertices can be shorter than the two queue tops
+		double ftop = dijkstrasp_pq_peekvalue(fwd), btop = dijkstrasp_pq_peekvalue(bwd);
+		if (ftop + btop >= best)
+			break;
 
-	// reconstruct output path
-	int* shortest_path = dijkstrasp_adjlist_reconstructPath(start, end, prev, n, spath_size_p);
+		// expand the side with the smallest frontier distance
+		int isforward = (ftop <= btop);
+		struct dijkstrasp_context* ctx = isforward ? fwd : bwd;
+		struct dijkstrasp_context* other = isforward ? bwd : fwd;
+		const struct csrgraph* sg = isforward ? g : rg;
+
+		int from_vert = dijkstrasp_pq_extract(ctx);
+		ctx->settled[from_vert] = ctx->epoch;
+		ctx->numsettled++;
+
+		size_t last = sg->offsets[from_vert + 1];
+		for (size_t e = sg->offsets[from_vert]; e < last; ++e) {
+			int to = sg->targets[e];
+			dijkstrasp_context_relax(ctx, from_vert, to, sg->weights[e]);
+
+			// both searches reached 'to', check path start -> to -> end
+			if (ctx->seen[to] == ctx->epoch && other->seen[to] == other->epoch
+					&& ctx->dist[to] + other->dist[to] < best) {
+				best = ctx->dist[to] + other->dist[to];
+				meet = to;
+			}
+		}
+	}
 
-	free(prev);
-	return shortest_path;
+	*dist_p = best;
+	*spath_size_p = 0;
+	if (meet == DIJKSTRA_EMPTY)
+		return NULL;
+
+	// start -> meet on forward search tree, meet -> end on backward search tree
+	int fsize = 0, size = 0;
+	for (int at = meet; at != DIJKSTRA_EMPTY; at = fwd->prev[at])
+		fsize++;
+
+	size = fsize;
+	for (int at = bwd->prev[meet]; at != DIJKSTRA_EMPTY; at = bwd->prev[at])
+		size++;
+
+	int* result = (int*)malloc(size * sizeof(int));
+	if (!result) {
+		printf( "Memory error: failed to allocate memory for result array of "
+				"shortest path Dijkstra algorithm!" );
+		abort();
+	}
+
+	int i = fsize;
+	for (int at = meet; at != DIJKSTRA_EMPTY; at = fwd->prev[at])
+		result[--i] = at;
+
+	i = fsize;
+	for (int at = bwd->prev[meet]; at != DIJKSTRA_EMPTY; at = bwd->prev[at])
+		result[i++] = at;
+
+	*spath_size_p = size;
+	return result;
+}
+
+/*
+ * Copies distances of last query to 'dist' array of size 'n'.
+ */
+void dijkstrasp_context_copy_distances(const struct dijkstrasp_context* ctx, double* dist, int n)
+{
+	for (int i = 0; i < n; ++i)
+		dist[i] = dijkstrasp_context_distance(ctx, i);
+}
+
+/*
+ * Releases a Dijkstra context from memory.
+ */
+void dijkstrasp_context_destroy(struct dijkstrasp_context* ctx)
+{
+	free(ctx->dist);
+	free(ctx->prev);
+	free(ctx->seen);
+	free(ctx->settled);
+	if (ctx->pq) imindblpq_destroy(ctx->pq);
+	if (ctx->ph) pairheap_destroy(ctx->ph);
+	if (ctx->rh) radixheap_destroy(ctx->rh);
+	free(ctx->handles);
+	free(ctx);
+}
+
+//--------------------- context ------------------
+
+/*
+ * Computes the shortest path and distance from a start vertice to destination vertice
+ * using the Dijkstra shortest path algorithm.
+ *
+ * Returns shortest path from start vertice to end vertice or 'NULL' if end vertice
+ * is unreachable. Also distance to vertices is filled and returned in 'dist' array.
+ * 'spath_size_p' returns the size of shortest path array.
+ * Note: 'dist' argument must have size equal to number of vertices in graph.
+ */
+int* dijkstrasp_adjlist_shortest_path(struct adjlgraph* g, int start, int end,
+		double* dist, int* spath_size_p)
+{
+	return dijkstrasp_adjlist_shortest_path_queue(g, start, end, DIJKSTRASP_QUEUE_DARY,
+												  dist, spath_size_p);
+}
+
+/*
+ * Same as 'dijkstrasp_adjlist_shortest_path' with the given priority queue type
+ * (see dijkstrasp_queue).
+ */
+int* dijkstrasp_adjlist_shortest_path_queue(struct adjlgraph* g, int start, int end,
+		dijkstrasp_queue queue, double* dist, int* spath_size_p)
+{
+	struct dijkstrasp_context* ctx = dijkstrasp_context_create_queue(g->numvertices, queue);
+	int* result = dijkstrasp_context_adjlist_shortest_path(ctx, g, start, end, spath_size_p);
+
+	dijkstrasp_context_copy_distances(ctx, dist, g->numvertices);
+	dijkstrasp_context_destroy(ctx);
+	return result;
+}
+
+/*
+ * Computes the shortest path and distance from a start vertice to destination vertice
+ * of a CSR graph using the Dijkstra shortest path algorithm.
+ *
+ * Same contract as 'dijkstrasp_adjlist_shortest_path', edges of the vertex being
+ * relaxed are read from contiguous arrays.
+ * Note: 'dist' argument must have size equal to number of vertices in graph.
+ */
+int* dijkstrasp_csr_shortest_path(const struct csrgraph* g, int start, int end,
+		double* dist, int* spath_size_p)
+{
+	struct dijkstrasp_context* ctx = dijkstrasp_context_create(g->numvertices);
+	int* result = dijkstrasp_context_csr_shortest_path(ctx, g, start, end, spath_size_p);
+
+	dijkstrasp_context_copy_distances(ctx, dist, g->numvertices);
+	dijkstrasp_context_destroy(ctx);
+	return result;
+}
+
+/*
+ * Computes the shortest path from a start vertice to destination vertice of a CSR graph
+ * using A* search guided by 'heuristic' (see dijkstrasp_context_astar_csr_shortest_path).
+ * Returns shortest path or 'NULL' if end vertice is unreachable, path distance is returned
+ * in 'dist_p' ('DBL_MAX' if unreachable).
+ */
+int* dijkstrasp_astar(const struct csrgraph* g, int start, int end,
+		dijkstrasp_heuristic heuristic, void* arg, double* dist_p, int* spath_size_p)
+{
+	struct dijkstrasp_context* ctx = dijkstrasp_context_create(g->numvertices);
+	int* result = dijkstrasp_context_astar_csr_shortest_path(ctx, g, start, end,
+															 heuristic, arg, spath_size_p);
+
+	*dist_p = dijkstrasp_context_distance(ctx, end);
+	dijkstrasp_context_destroy(ctx);
+	return result;
+}
+
+/*
+ * Computes the shortest path from a start vertice to destination vertice of a CSR graph
+ * with bidirectional Dijkstra ('rg' is the reverse graph of 'g', see csrgraph_create_reverse).
+ * Returns shortest path or 'NULL' if end vertice is unreachable, path distance is returned
+ * in 'dist_p' ('DBL_MAX' if unreachable).
+ */
+int* dijkstrasp_bidirectional(const struct csrgraph* g, const struct csrgraph* rg,
+		int start, int end, double* dist_p, int* spath_size_p)
+{
+	struct dijkstrasp_context* fwd = dijkstrasp_context_create(g->numvertices);
+	struct dijkstrasp_context* bwd = dijkstrasp_context_create(rg->numvertices);
+	int* result = dijkstrasp_context_bidirectional(fwd, bwd, g, rg, start, end,
+												   dist_p, spath_size_p);
+
+	dijkstrasp_context_destroy(fwd);
+	dijkstrasp_context_destroy(bwd);
+	return result;
 }
 
 /*
@@ -36,6 +36,122 @@
 #ifndef DIJKSTRASP_H_
 	#define DIJKSTRASP_H_
 
+	#include "adjlgraph.h"
+	#include "csrgraph.h"
+	#include "indmindblheap.h"
+	#include "pairingheap.h"
+	#include "radixheap.h"
+
+	/*
+	 * Priority queue of a Dijkstra context.
+	 * 	- DIJKSTRASP_QUEUE_DARY: indexed 4-ary heap of doubles (see indmindblheap.h);
+	 * 	- DIJKSTRASP_QUEUE_PAIRING: pairing heap with a node handle per queued vertex, its
+	 * 	  decrease key is cheaper when many edges improve the distance of queued vertices;
+	 * 	- DIJKSTRASP_QUEUE_RADIX: radix heap, O(1) insert and decrease and no compares
+	 * 	  between distances, only for integer edge weights (an error is throw otherwise).
+	 * A* search (dijkstrasp_context_astar_csr_shortest_path) requires the 4-ary heap.
+	 */
+	typedef enum {
+		DIJKSTRASP_QUEUE_DARY = 0,
+		DIJKSTRASP_QUEUE_PAIRING = 1,
+		DIJKSTRASP_QUEUE_RADIX = 2
+	} dijkstrasp_queue;
+
+	/*
+	 * Reusable query context: buffers sized to the graph are allocated once and
+	 * reused by every query, so a query does not allocate per vertex or per edge.
+	 *
+	 * Buffers are never cleared between queries. Each query gets a new epoch and
+	 * 'dist'/'prev' of a vertex are only valid when 'seen' matches it, so the cost
+	 * of a query depends on the vertices it touches, not on the graph size.
+	 */
+	struct dijkstrasp_context {
+		int n;						// capacity (maximum number of vertices)
+		unsigned int epoch;			// current query stamp
+		int numsettled;				// vertices settled by last query
+		double* dist;				// distance from start of each vertex
+		int* prev;					// previous vertex on shortest path
+		unsigned int* seen;			// epoch in which vertex was reached
+		unsigned int* settled;		// epoch in which vertex was settled
+		dijkstrasp_queue queue;		// priority queue type
+		struct imindblpq* pq;		// indexed priority queue of distances (4-ary heap)
+		struct pairheap* ph;		// pairing heap (elements point to 'dist' entries)
+		struct pairheapnode** handles;	// pairing heap node of each queued vertex
+		struct radixheap* rh;		// radix heap of integer distances
+	};
+
+	/*
+	 * A* heuristic: estimate of the distance from vertex 'v' to 'target'.
+	 * 'arg' is the user argument given to the search (ex: vertex coordinates).
+	 */
+	typedef double (*dijkstrasp_heuristic)(int v, int target, void* arg);
+
+	/*
+	 * Creates a Dijkstra context for graphs with up to 'numvertices' vertices.
+	 * Buffers are allocated once and reused by every query run with the context.
+	 */
+	struct dijkstrasp_context* dijkstrasp_context_create(int numvertices);
+
+	/*
+	 * Creates a Dijkstra context for graphs with up to 'numvertices' vertices using the
+	 * given priority queue type (see dijkstrasp_queue).
+	 */
+	struct dijkstrasp_context* dijkstrasp_context_create_queue(int numvertices, dijkstrasp_queue queue);
+
+	/*
+	 * Computes the shortest path from a start vertice to destination vertice of an adjacency
+	 * list graph, using the buffers of a context (no allocation besides the result path).
+	 * Returns shortest path or 'NULL' if end vertice is unreachable. Use
+	 * 'dijkstrasp_context_distance' to read distances (valid until the next query).
+	 */
+	int* dijkstrasp_context_adjlist_shortest_path(struct dijkstrasp_context* ctx, struct adjlgraph* g,
+			int start, int end, int* spath_size_p);
+
+	/*
+	 * Computes the shortest path from a start vertice to destination vertice of a CSR graph,
+	 * using the buffers of a context (no allocation besides the result path).
+	 * Returns shortest path or 'NULL' if end vertice is unreachable. Use
+	 * 'dijkstrasp_context_distance' to read distances (valid until the next query).
+	 */
+	int* dijkstrasp_context_csr_shortest_path(struct dijkstrasp_context* ctx, const struct csrgraph* g,
+			int start, int end, int* spath_size_p);
+
+	/*
+	 * Computes the shortest path from a start vertice to destination vertice of a CSR graph
+	 * using A* search. Vertices are extracted by 'dist + heuristic(v)', so search is guided
+	 * towards 'end'. The heuristic must never overestimate the distance to 'end' (admissible),
+	 * otherwise result may not be the shortest path.
+	 * Returns shortest path or 'NULL' if end vertice is unreachable. Use
+	 * 'dijkstrasp_context_distance' to read distances (valid until the next query).
+	 */
+	int* dijkstrasp_context_astar_csr_shortest_path(struct dijkstrasp_context* ctx, const struct csrgraph* g,
+			int start, int end, dijkstrasp_heuristic heuristic, void* arg, int* spath_size_p);
+
+	/*
+	 * Computes the shortest path from a start vertice to destination vertice of a CSR graph
+	 * with bidirectional Dijkstra: a forward search from 'start' on 'g' and a backward search
+	 * from 'end' on 'rg' (reverse graph of 'g', see csrgraph_create_reverse) run alternately
+	 * until their frontiers meet, so only two small balls around start and end are settled.
+	 *
+	 * 'fwd' and 'bwd' are the contexts of each search.
+	 * Returns shortest path or 'NULL' if end vertice is unreachable, path distance is returned
+	 * in 'dist_p' ('DBL_MAX' if unreachable).
+	 */
+	int* dijkstrasp_context_bidirectional(struct dijkstrasp_context* fwd, struct dijkstrasp_context* bwd,
+			const struct csrgraph* g, const struct csrgraph* rg, int start, int end,
+			double* dist_p, int* spath_size_p);
+
+	/*
+	 * Gets the distance from start of last query to vertex 'v'.
+	 * Returns 'DBL_MAX' if 'v' was not reached.
+	 */
+	double dijkstrasp_context_distance(const struct dijkstrasp_context* ctx, int v);
+
+	/*
+	 * Releases a Dijkstra context from memory.
+	 */
+	void dijkstrasp_context_destroy(struct dijkstrasp_context* ctx);
+
 	/*
 	 * Computes the shortest path and distance from a start vertice to destination vertice
 	 * using the Dijkstra shortest path algorithm.
@@ -48,6 +164,40 @@
 	int* dijkstrasp_adjlist_shortest_path(struct adjlgraph* g, int start, int end,
 			double* dist, int* spath_size_p);
 
+	/*
+	 * Same as 'dijkstrasp_adjlist_shortest_path' with the given priority queue type
+	 * (see dijkstrasp_queue).
+	 */
+	int* dijkstrasp_adjlist_shortest_path_queue(struct adjlgraph* g, int start, int end,
+			dijkstrasp_queue queue, double* dist, int* spath_size_p);
+
+	/*
+	 * Computes the shortest path and distance from a start vertice to destination vertice
+	 * of a CSR graph using the Dijkstra shortest path algorithm.
+	 * Same contract as 'dijkstrasp_adjlist_shortest_path'.
+	 * Note: 'dist' argument must have size equal to number of vertices in graph.
+	 */
+	int* dijkstrasp_csr_shortest_path(const struct csrgraph* g, int start, int end,
+			double* dist, int* spath_size_p);
+
+	/*
+	 * Computes the shortest path from a start vertice to destination vertice of a CSR graph
+	 * using A* search guided by 'heuristic' (see dijkstrasp_context_astar_csr_shortest_path).
+	 * Returns shortest path or 'NULL' if end vertice is unreachable, path distance is returned
+	 * in 'dist_p' ('DBL_MAX' if unreachable).
+	 */
+	int* dijkstrasp_astar(const struct csrgraph* g, int start, int end,
+			dijkstrasp_heuristic heuristic, void* arg, double* dist_p, int* spath_size_p);
+
+	/*
+	 * Computes the shortest path from a start vertice to destination vertice of a CSR graph
+	 * with bidirectional Dijkstra ('rg' is the reverse graph of 'g', see csrgraph_create_reverse).
+	 * Returns shortest path or 'NULL' if end vertice is unreachable, path distance is returned
+	 * in 'dist_p' ('DBL_MAX' if unreachable).
+	 */
+	int* dijkstrasp_bidirectional(const struct csrgraph* g, const struct csrgraph* rg,
+			int start, int end, double* dist_p, int* spath_size_p);
+
 	/*
 	 * Prints the path. ex:'[4->7->3->2]'
 	 */
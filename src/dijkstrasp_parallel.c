@@ -0,0 +1,546 @@
+/********************************************************************************
+ * dijkstrasp_parallel.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of a multi-threaded single source shortest paths
+ *  			algorithm (delta-stepping) on CSR graphs.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Worker threads live for the whole search and meet four times per phase on a
+ *  barrier: after relaxing the frontier (each thread also publishes its smallest non
+ *  empty bucket), after reserving room for its part of the next frontier, after
+ *  thread 0 sets up the next phase, and after the next frontier is copied.
+ *  Distances are updated with atomic builtins on the caller 'dist' array, plain
+ *  loads and stores are used when running with a single thread.
+ *
+ *  Source: U. Meyer, P. Sanders, "Delta-stepping: a parallelizable shortest path algorithm",
+ *  		 Journal of Algorithms 49 (2003).
+ *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <float.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "dijkstrasp_parallel.h"
+
+#define DIJKSTRASP_PARALLEL_EMPTY -1
+#define DIJKSTRASP_PARALLEL_NOBUCKET SIZE_MAX
+#define DIJKSTRASP_PARALLEL_UNRESOLVED INT32_MAX	// parent not found yet
+#define DIJKSTRASP_PARALLEL_MAXBUCKETS (1 << 20)	// maximum size of the buckets ring
+
+// bucket of vertices (private to a thread)
+struct dijkstrasp_parallel_bucket {
+	int* items;
+	size_t size;
+	size_t capacity;
+};
+
+// shared state of a search
+struct dijkstrasp_parallel_state {
+	const struct csrgraph* g;			// graph
+	int n;								// number of vertices
+	int start;							// source vertex
+	int nthreads;						// number of threads
+	double delta;						// bucket width
+	double* dist;						// distance of each vertex (result)
+	int* prev;							// parent of each vertex (result, may be NULL)
+	size_t numbuckets;					// size of buckets ring
+	int* frontier;						// vertices of current bucket
+	size_t frontiersize;				// current frontier size
+	size_t frontiercapacity;			// frontier array capacity
+	atomic_size_t cursor;				// next chunk of frontier to be taken by a thread
+	atomic_size_t nextsize;				// next frontier size (room reserved by threads)
+	atomic_size_t nextbucket;			// smallest non empty bucket of all threads
+	size_t bucket;						// current bucket number
+	int done;							// search is finished
+	atomic_int* round;					// round in which parent of each vertex was found
+	atomic_size_t resolved;				// parents found in current round
+	size_t unresolved;					// vertices without parent
+	pthread_barrier_t barrier;			// phase barrier
+};
+
+// worker thread argument
+struct dijkstrasp_parallel_worker {
+	struct dijkstrasp_parallel_state* st;
+	int tid;
+	pthread_t thread;
+	struct dijkstrasp_parallel_bucket* buckets;	// ring of private buckets
+	size_t pending;								// vertices in private buckets
+	size_t minbucket;							// no private bucket below this one is in use
+	size_t pos;									// position of private bucket in next frontier
+};
+
+/*
+ * Gets the bucket number of a distance.
+ */
+size_t dijkstrasp_parallel_bucketof(const struct dijkstrasp_parallel_state* st, double d) {
+	return (size_t)(d / st->delta);
+}
+
+/*
+ * Reads the distance of vertex 'v'.
+ */
+double dijkstrasp_parallel_distance(const struct dijkstrasp_parallel_state* st, int v)
+{
+	if (st->nthreads == 1)
+		return st->dist[v];
+
+	double result;
+	__atomic_load(&(st->dist[v]), &result, __ATOMIC_RELAXED);
+	return result;
+}
+
+/*
+ * Lowers the distance of vertex 'v' to 'value' if it is smaller.
+ * Returns '1' (true) if distance was lowered, '0' (false) otherwise.
+ */
+int dijkstrasp_parallel_lower(struct dijkstrasp_parallel_state* st, int v, double value)
+{
+	double* p = &(st->dist[v]);
+	if (st->nthreads == 1) {
+		if (value >= *p)
+			return 0;
+
+		*p = value;
+		return 1;
+	}
+
+	double old;
+	__atomic_load(p, &old, __ATOMIC_RELAXED);
+	while (value < old)
+		if (__atomic_compare_exchange(p, &old, &value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			return 1;
+
+	return 0;
+}
+
+/*
+ * Adds vertex 'v' to a private bucket.
+ */
+void dijkstrasp_parallel_push(struct dijkstrasp_parallel_bucket* b, int v)
+{
+	if (b->size == b->capacity) {
+		size_t capacity = (b->capacity > 0) ? b->capacity * 2 : 16;
+		int* items = (int*)realloc(b->items, capacity * sizeof(int));
+		if (!items) {
+			printf("Memory error: failed to grow delta-stepping bucket!");
+			abort();
+		}
+
+		b->items = items;
+		b->capacity = capacity;
+	}
+
+	b->items[b->size++] = v;
+}
+
+/*
+ * Relaxes the edges of the current frontier and returns the smallest non empty
+ * private bucket ('DIJKSTRASP_PARALLEL_NOBUCKET' if all are empty).
+ */
+size_t dijkstrasp_parallel_relax(struct dijkstrasp_parallel_worker* w)
+{
+	struct dijkstrasp_parallel_state* st = w->st;
+	const struct csrgraph* g = st->g;
+	size_t begin = 0;
+
+	while ((begin = atomic_fetch_add_explicit(&(st->cursor), DIJKSTRASP_PARALLEL_CHUNK,
+											  memory_order_relaxed)) < st->frontiersize) {
+		size_t end = begin + DIJKSTRASP_PARALLEL_CHUNK;
+		if (end > st->frontiersize) end = st->frontiersize;
+
+		for (size_t i = begin; i < end; ++i) {
+			int u = st->frontier[i];
+			double du = dijkstrasp_parallel_distance(st, u);
+
+			// stale entry: vertex moved to a lower bucket and was expanded there
+			if (dijkstrasp_parallel_bucketof(st, du) < st->bucket)
+				continue;
+
+			for (size_t e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+				int v = g->targets[e];
+				double nd = du + g->weights[e];
+				if (dijkstrasp_parallel_lower(st, v, nd)) {
+					size_t b = dijkstrasp_parallel_bucketof(st, nd);
+					dijkstrasp_parallel_push(&(w->buckets[b % st->numbuckets]), v);
+					w->pending++;
+					if (b < w->minbucket) w->minbucket = b;
+				}
+			}
+		}
+	}
+
+	if (w->pending == 0)
+		return DIJKSTRASP_PARALLEL_NOBUCKET;
+
+	// buckets in use are always inside the ring window starting at current bucket
+	if (w->minbucket < st->bucket) w->minbucket = st->bucket;
+	while (w->buckets[w->minbucket % st->numbuckets].size == 0)
+		w->minbucket++;
+
+	return w->minbucket;
+}
+
+/*
+ * Makes the next frontier the current one. Runs on a single thread between phases.
+ */
+void dijkstrasp_parallel_nextphase(struct dijkstrasp_parallel_state* st, size_t next)
+{
+	size_t size = atomic_load(&(st->nextsize));
+	if (size > st->frontiercapacity) {
+		size_t capacity = st->frontiercapacity * 2;
+		if (capacity < size) capacity = size;
+
+		int* frontier = (int*)realloc(st->frontier, capacity * sizeof(int));
+		if (!frontier) {
+			printf("Memory error: failed to grow delta-stepping frontier!");
+			abort();
+		}
+
+		st->frontier = frontier;
+		st->frontiercapacity = capacity;
+	}
+
+	st->frontiersize = size;
+	st->bucket = next;
+	st->done = (next == DIJKSTRASP_PARALLEL_NOBUCKET);
+	atomic_store(&(st->nextsize), 0);
+	atomic_store(&(st->nextbucket), DIJKSTRASP_PARALLEL_NOBUCKET);
+	atomic_store(&(st->cursor), 0);
+}
+
+/*
+ * Lowers the shared smallest non empty bucket to 'b'.
+ */
+void dijkstrasp_parallel_minbucket(struct dijkstrasp_parallel_state* st, size_t b)
+{
+	size_t old = atomic_load_explicit(&(st->nextbucket), memory_order_relaxed);
+	while (b < old &&
+		   !atomic_compare_exchange_weak_explicit(&(st->nextbucket), &old, b,
+												  memory_order_relaxed, memory_order_relaxed));
+}
+
+/*
+ * Finds a parent for vertices of chunks owned by thread 'tid' in round 'r'.
+ * Round 0 takes any tight edge from a vertex with a smaller distance. Later rounds
+ * solve the remaining vertices (only reached by ties) from vertices solved in
+ * previous rounds, so a parent is always solved before its children.
+ */
+void dijkstrasp_parallel_parents_round(struct dijkstrasp_parallel_state* st, int tid, int r)
+{
+	const struct csrgraph* g = st->g;
+	size_t resolved = 0;
+
+	for (size_t begin = (size_t)tid * DIJKSTRASP_PARALLEL_CHUNK; begin < (size_t)st->n;
+		 begin += (size_t)st->nthreads * DIJKSTRASP_PARALLEL_CHUNK) {
+		size_t end = begin + DIJKSTRASP_PARALLEL_CHUNK;
+		if (end > (size_t)st->n) end = st->n;
+
+		for (size_t u = begin; u < end; ++u) {
+			double du = st->dist[u];
+			if (du == DBL_MAX)
+				continue;
+			if (r > 0 && atomic_load_explicit(&(st->round[u]), memory_order_relaxed) >= r)
+				continue;
+
+			for (size_t e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+				int v = g->targets[e];
+				if (v == st->start || du + g->weights[e] != st->dist[v])
+					continue;
+
+				if (r == 0) {
+					if (du < st->dist[v])
+						__atomic_store_n(&(st->prev[v]), (int)u, __ATOMIC_RELAXED);
+				}
+				else {
+					int expected = DIJKSTRASP_PARALLEL_UNRESOLVED;
+					if (atomic_compare_exchange_strong_explicit(&(st->round[v]), &expected, r,
+							memory_order_relaxed, memory_order_relaxed)) {
+						st->prev[v] = (int)u;
+						resolved++;
+					}
+				}
+			}
+		}
+	}
+
+	atomic_fetch_add_explicit(&(st->resolved), resolved, memory_order_relaxed);
+}
+
+/*
+ * Marks vertices of chunks owned by thread 'tid' still without parent after round 0.
+ */
+void dijkstrasp_parallel_parents_mark(struct dijkstrasp_parallel_state* st, int tid)
+{
+	size_t unresolved = 0;
+
+	for (size_t begin = (size_t)tid * DIJKSTRASP_PARALLEL_CHUNK; begin < (size_t)st->n;
+		 begin += (size_t)st->nthreads * DIJKSTRASP_PARALLEL_CHUNK) {
+		size_t end = begin + DIJKSTRASP_PARALLEL_CHUNK;
+		if (end > (size_t)st->n) end = st->n;
+
+		for (size_t v = begin; v < end; ++v) {
+			int r = 0;
+			if (st->dist[v] != DBL_MAX && (int)v != st->start &&
+				__atomic_load_n(&(st->prev[v]), __ATOMIC_RELAXED) == DIJKSTRASP_PARALLEL_EMPTY) {
+				r = DIJKSTRASP_PARALLEL_UNRESOLVED;
+				unresolved++;
+			}
+
+			atomic_store_explicit(&(st->round[v]), r, memory_order_relaxed);
+		}
+	}
+
+	atomic_fetch_add_explicit(&(st->resolved), unresolved, memory_order_relaxed);
+}
+
+/*
+ * Computes the parents of all vertices once distances are final.
+ */
+void dijkstrasp_parallel_parents(struct dijkstrasp_parallel_worker* w)
+{
+	struct dijkstrasp_parallel_state* st = w->st;
+
+	dijkstrasp_parallel_parents_round(st, w->tid, 0);
+	pthread_barrier_wait(&(st->barrier));
+	if (w->tid == 0)
+		atomic_store(&(st->resolved), 0);
+	pthread_barrier_wait(&(st->barrier));
+
+	dijkstrasp_parallel_parents_mark(st, w->tid);
+	pthread_barrier_wait(&(st->barrier));
+	if (w->tid == 0) {
+		st->unresolved = atomic_load(&(st->resolved));
+		atomic_store(&(st->resolved), 0);
+	}
+	pthread_barrier_wait(&(st->barrier));
+
+	// rounds only happen with ties (zero weight edges), usually none
+	for (int r = 1; st->unresolved > 0; ++r) {
+		dijkstrasp_parallel_parents_round(st, w->tid, r);
+		pthread_barrier_wait(&(st->barrier));
+
+		if (w->tid == 0) {
+			size_t resolved = atomic_load(&(st->resolved));
+			st->unresolved = (resolved > 0) ? st->unresolved - resolved : 0;
+			atomic_store(&(st->resolved), 0);
+		}
+		pthread_barrier_wait(&(st->barrier));
+	}
+}
+
+/*
+ * Worker thread loop: expands buckets until all are empty.
+ */
+void* dijkstrasp_parallel_run(void* arg)
+{
+	struct dijkstrasp_parallel_worker* w = (struct dijkstrasp_parallel_worker*)arg;
+	struct dijkstrasp_parallel_state* st = w->st;
+
+	while (1) {
+		dijkstrasp_parallel_minbucket(st, dijkstrasp_parallel_relax(w));
+		pthread_barrier_wait(&(st->barrier));
+
+		// reserve room for private part of next frontier
+		size_t next = atomic_load(&(st->nextbucket));
+		struct dijkstrasp_parallel_bucket* b = NULL;
+		if (next != DIJKSTRASP_PARALLEL_NOBUCKET) {
+			b = &(w->buckets[next % st->numbuckets]);
+			w->pos = atomic_fetch_add_explicit(&(st->nextsize), b->size, memory_order_relaxed);
+		}
+		pthread_barrier_wait(&(st->barrier));
+
+		if (w->tid == 0)
+			dijkstrasp_parallel_nextphase(st, next);
+		pthread_barrier_wait(&(st->barrier));
+
+		if (st->done)
+			break;
+
+		if (b->size > 0) {
+			memcpy(st->frontier + w->pos, b->items, b->size * sizeof(int));
+			w->pending -= b->size;
+			b->size = 0;
+		}
+		pthread_barrier_wait(&(st->barrier));
+	}
+
+	if (st->prev != NULL)
+		dijkstrasp_parallel_parents(w);
+
+	return NULL;
+}
+
+/*
+ * Gets the maximum edge weight of a graph (aborts on negative weights).
+ */
+double dijkstrasp_parallel_maxweight(const struct csrgraph* g)
+{
+	if (g->weights == NULL) {
+		printf("Error: delta-stepping requires a weighted graph!");
+		abort();
+	}
+
+	double result = 0.0;
+	for (size_t e = 0; e < g->numarcs; ++e) {
+		if (g->weights[e] < 0) {
+			printf("Error: delta-stepping requires non-negative edge weights!");
+			abort();
+		}
+
+		if (g->weights[e] > result)
+			result = g->weights[e];
+	}
+
+	return result;
+}
+
+/*
+ * Gets the default bucket width of a graph with maximum edge weight 'maxweight'.
+ */
+double dijkstrasp_parallel_delta_of(const struct csrgraph* g, double maxweight)
+{
+	if (g->numarcs == 0 || maxweight == 0.0)
+		return 1.0;
+
+	return maxweight * (double)g->numvertices / (double)g->numarcs;
+}
+
+/*
+ * Gets a default bucket width for delta-stepping: maximum edge weight divided by
+ * average vertex degree (Meyer and Sanders). Returns 1.0 for graphs without edges.
+ */
+double dijkstrasp_parallel_default_delta(const struct csrgraph* g)
+{
+	return dijkstrasp_parallel_delta_of(g, dijkstrasp_parallel_maxweight(g));
+}
+
+/*
+ * Computes the shortest distances from 'start' to all vertices of a CSR graph with
+ * delta-stepping, using 'nthreads' threads and buckets of width 'delta' (0 or
+ * negative uses dijkstrasp_parallel_default_delta).
+ *
+ * 'dist' (size numvertices) is filled with the distances ('DBL_MAX' if unreachable).
+ * 'prev' (size numvertices, may be NULL) is filled with the previous vertex on a
+ * shortest path (-1 for start and unreachable vertices).
+ */
+void dijkstrasp_parallel_delta_stepping( const struct csrgraph* g, int start, double delta,
+										 int nthreads, double* dist, int* prev )
+{
+	if (start < 0 || (size_t)start >= g->numvertices) {
+		printf("Error: delta-stepping start vertex is out of range!");
+		abort();
+	}
+
+	if (nthreads < 1) nthreads = 1;
+
+	double maxweight = dijkstrasp_parallel_maxweight(g);
+	if (delta <= 0)
+		delta = dijkstrasp_parallel_delta_of(g, maxweight);
+
+	// a bucket can only push to the next maxweight / delta buckets
+	if (maxweight / delta > DIJKSTRASP_PARALLEL_MAXBUCKETS - 3)
+		delta = maxweight / (DIJKSTRASP_PARALLEL_MAXBUCKETS - 3);
+
+	struct dijkstrasp_parallel_state st;
+	st.g = g;
+	st.n = (int)g->numvertices;
+	st.start = start;
+	st.nthreads = nthreads;
+	st.delta = delta;
+	st.dist = dist;
+	st.prev = prev;
+	st.numbuckets = (size_t)(maxweight / delta) + 3;
+	st.frontiercapacity = 1024;
+	st.frontier = (int*)malloc(st.frontiercapacity * sizeof(int));
+	st.round = (prev != NULL) ? (atomic_int*)malloc(g->numvertices * sizeof(atomic_int)) : NULL;
+	if (!st.frontier || (prev && !st.round)) {
+		printf("Memory error: failed to allocate delta-stepping arrays!");
+		abort();
+	}
+
+	for (int i = 0; i < st.n; ++i)
+		dist[i] = DBL_MAX;
+	if (prev != NULL)
+		for (int i = 0; i < st.n; ++i)
+			prev[i] = DIJKSTRASP_PARALLEL_EMPTY;
+
+	dist[start] = 0.0;
+	st.frontier[0] = start;
+	st.frontiersize = 1;
+	st.bucket = 0;
+	st.done = 0;
+	st.unresolved = 0;
+	atomic_init(&(st.cursor), 0);
+	atomic_init(&(st.nextsize), 0);
+	atomic_init(&(st.nextbucket), DIJKSTRASP_PARALLEL_NOBUCKET);
+	atomic_init(&(st.resolved), 0);
+
+	if (pthread_barrier_init(&(st.barrier), NULL, nthreads) != 0) {
+		printf("Error: failed to initialize delta-stepping barrier!");
+		abort();
+	}
+
+	struct dijkstrasp_parallel_worker* workers = malloc(nthreads * sizeof(*workers));
+	if (!workers) {
+		printf("Memory error: failed to allocate delta-stepping workers!");
+		abort();
+	}
+
+	for (int i = 0; i < nthreads; ++i) {
+		workers[i].st = &st;
+		workers[i].tid = i;
+		workers[i].pos = 0;
+		workers[i].pending = 0;
+		workers[i].minbucket = 0;
+		workers[i].buckets = calloc(st.numbuckets, sizeof(struct dijkstrasp_parallel_bucket));
+		if (!(workers[i].buckets)) {
+			printf("Memory error: failed to allocate delta-stepping buckets!");
+			abort();
+		}
+	}
+
+	for (int i = 1; i < nthreads; ++i)
+		if (pthread_create(&(workers[i].thread), NULL, dijkstrasp_parallel_run, &(workers[i])) != 0) {
+			printf("Error: failed to create delta-stepping thread!");
+			abort();
+		}
+
+	dijkstrasp_parallel_run(&(workers[0]));	// calling thread is worker 0
+
+	for (int i = 1; i < nthreads; ++i)
+		pthread_join(workers[i].thread, NULL);
+
+	for (int i = 0; i < nthreads; ++i) {
+		for (size_t b = 0; b < st.numbuckets; ++b)
+			free(workers[i].buckets[b].items);
+		free(workers[i].buckets);
+	}
+
+	pthread_barrier_destroy(&(st.barrier));
+	free(workers);
+	free(st.frontier);
+	free(st.round);
+}
+
+/*
+ * Computes the shortest distances from 'start' to all vertices of an adjacency list
+ * graph with delta-stepping (graph is frozen to CSR format first, see
+ * dijkstrasp_parallel_delta_stepping).
+ */
+void dijkstrasp_parallel_adjlist_delta_stepping( struct adjlgraph* g, int start, double delta,
+												 int nthreads, double* dist, int* prev )
+{
+	struct csrgraph* cg = adjlgraph_freeze_to_csr(g);
+	dijkstrasp_parallel_delta_stepping(cg, start, delta, nthreads, dist, prev);
+	csrgraph_destroy(cg);
+}
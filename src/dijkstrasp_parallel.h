@@ -0,0 +1,76 @@
+/*****************************************************************************
+ * dijkstrasp_parallel.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a multi-threaded single source shortest paths
+ *  			 algorithm (delta-stepping) on CSR graphs.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Dijkstra settles one vertex at a time, so it can not use more than one core.
+ *  Delta-stepping relaxes the order: tentative distances are grouped in buckets of
+ *  width 'delta' and all vertices of the smallest non empty bucket are expanded at
+ *  once, in parallel. A vertex may be expanded more than once (its distance may still
+ *  improve inside the bucket), which is the extra work paid for parallelism:
+ *
+ *  	- delta -> 0 behaves like Dijkstra (one distance per bucket, no extra work);
+ *  	- delta -> infinite behaves like Bellman-Ford (one bucket, lots of extra work).
+ *
+ *  Threads take chunks of the current bucket and relax edges with an atomic
+ *  compare-and-swap on the distance. Improved vertices are pushed to buckets private
+ *  to each thread, merged into the next frontier between phases (no locks).
+ *  Relaxing from bucket 'b' can only reach buckets b .. b + maxweight/delta, so
+ *  buckets are kept in a small ring instead of one array per distance range.
+ *
+ *  Parents ('prev') are computed after distances are final: the parent of 'v' is any
+ *  vertex 'u' with dist[u] + w(u, v) == dist[v]. Ties among equal distances (zero
+ *  weight edges) are solved in rounds so that parents never form a cycle.
+ *
+ *  Edge weights must be non-negative. Results are the same distances as Dijkstra
+ *  (equal within DIJKSTRA_EPS, see dijkstrasp_compare), parents may differ
+ *  when there is more than one shortest path.
+ *
+ *  Source: U. Meyer, P. Sanders, "Delta-stepping: a parallelizable shortest path algorithm",
+ *  		 Journal of Algorithms 49 (2003).
+ *  		 GAP Benchmark Suite, sssp.cc (S. Beamer).
+ *
+ *******************************************************************************/
+
+#ifndef DIJKSTRASP_PARALLEL_H_
+	#define DIJKSTRASP_PARALLEL_H_
+
+	#include "adjlgraph.h"
+	#include "csrgraph.h"
+
+	#define DIJKSTRASP_PARALLEL_CHUNK 64		// frontier vertices taken by a thread at once
+
+	/*
+	 * Gets a default bucket width for delta-stepping: maximum edge weight divided by
+	 * average vertex degree (Meyer and Sanders). Returns 1.0 for graphs without edges.
+	 */
+	double dijkstrasp_parallel_default_delta(const struct csrgraph* g);
+
+	/*
+	 * Computes the shortest distances from 'start' to all vertices of a CSR graph with
+	 * delta-stepping, using 'nthreads' threads and buckets of width 'delta' (0 or
+	 * negative uses dijkstrasp_parallel_default_delta).
+	 *
+	 * 'dist' (size numvertices) is filled with the distances ('DBL_MAX' if unreachable).
+	 * 'prev' (size numvertices, may be NULL) is filled with the previous vertex on a
+	 * shortest path (-1 for start and unreachable vertices).
+	 */
+	void dijkstrasp_parallel_delta_stepping( const struct csrgraph* g, int start, double delta,
+											 int nthreads, double* dist, int* prev );
+
+	/*
+	 * Computes the shortest distances from 'start' to all vertices of an adjacency list
+	 * graph with delta-stepping (graph is frozen to CSR format first, see
+	 * dijkstrasp_parallel_delta_stepping).
+	 */
+	void dijkstrasp_parallel_adjlist_delta_stepping( struct adjlgraph* g, int start, double delta,
+													 int nthreads, double* dist, int* prev );
+
+#endif /* DIJKSTRASP_PARALLEL_H_ */
@@ -11,43 +11,6 @@
 #include "fibonacciheap.h"
 
 
-#define FIBHEAP_EULER_CONST 2.718281828459045235
-#define FIBHEAP_TAYLOR_ITERATIONS 20
-
-/*
- * Computes the natural log of a number.
- * Note: no need for math.h (4 to 5 decimals precision but is enough)
- */
-double fibheap_nat_log(double x) {
-    // Trap illegal values
-    if (x <= 0) {
-        return 0.0/0.0;  // NaN
-    }
-
-    // Confine x to a sensible range
-    int power_adjust = 0;
-    while (x > 1.0) {
-        x /= FIBHEAP_EULER_CONST;
-        power_adjust++;
-    }
-    while (x < .25) {
-        x *= FIBHEAP_EULER_CONST;
-        power_adjust--;
-    }
-
-    // Now use the Taylor series to calculate the logarithm
-    x -= 1.0;
-    double t = 0.0, s = 1.0, z = x;
-    for (int k = 1; k <= FIBHEAP_TAYLOR_ITERATIONS; k++) {
-        t += z * s / k;
-        z *= x;
-        s = -s;
-    }
-
-    // Combine the result with the power_adjust value and return
-    return t + power_adjust;
-}
-
 /*
  * Creates a new fibonacci heap instance.
  */
@@ -99,8 +62,11 @@ struct fibheapnode* fibheap_createnode(void* val)
  *            Set H(min) pointer to x.
  *       4- Else:
  *            Insert x into root list and update H(min) if needed.
+ *
+ * Returns the created node: a stable handle to the element (until it is extracted)
+ * for fibheap_decrease_key and fibheap_delete_node, NULL if out of memory.
  */
-void fibheap_insert(struct fibheap* fh, void* val)
+struct fibheapnode* fibheap_insert(struct fibheap* fh, void* val)
 {
     struct fibheapnode* new_node = fibheap_createnode(val);
 
@@ -119,6 +85,8 @@ void fibheap_insert(struct fibheap* fh, void* val)
 
 		fh->no_of_nodes++;
     }
+
+    return new_node;
 }
 
 /*
@@ -169,49 +137,51 @@ void fibheap_fibonnaci_link(struct fibheap* fh, struct fibheapnode* ptr2, struct
 	// free ptr2 from his double linked list
     (ptr2->left)->right = ptr2->right;
     (ptr2->right)->left = ptr2->left;
-    if (ptr1->right == ptr1)
-    	fh->mini = ptr1;
 
-    // free left/right ponteirs of ptr2
     ptr2->left = ptr2;
     ptr2->right = ptr2;
     ptr2->parent = ptr1;
-    if (ptr1->child == NULL)
-        ptr1->child = ptr2;
-
-    ptr2->right = ptr1->child;
-    ptr2->left = (ptr1->child)->left;
-
-    ((ptr1->child)->left)->right = ptr2;
-    (ptr1->child)->left = ptr2;
+    ptr2->mark = FIBHEAP_MARK_WHITE;
 
-    if (fh->compare(ptr2->key, (ptr1->child)->key) < 0)
+    if (ptr1->child == NULL)
         ptr1->child = ptr2;
+    else {
+		ptr2->right = ptr1->child;
+		ptr2->left = (ptr1->child)->left;
+		((ptr1->child)->left)->right = ptr2;
+		(ptr1->child)->left = ptr2;
+    }
 
     ptr1->degree++;
 }
 
 /*
  * Consolidating the heap.
+ *
+ * Root list is first unlinked into a NULL terminated list, so linking trees does not
+ * change the list being walked. Roots of same degree are linked until all roots have
+ * different degrees, then the root list is rebuilt and the minimum found.
+ * Note: degree of a node is at most log_phi(n) (< 1.45 * log2(n)), so
+ * FIBHEAP_MAX_DEGREE entries are enough for any heap size.
  */
 void fibheap_consolidate(struct fibheap* fh)
 {
-//	struct fibheapnode* mini = fh->mini;
-    int temp1;
-    float temp2 = (fibheap_nat_log(fh->no_of_nodes)) / (fibheap_nat_log(2)) + 1;
-    int temp3 = temp2;
-    int size = temp3+1;
-    struct fibheapnode* arr[temp3+1];
-    for (int i = 0; i <= temp3; i++)
+    struct fibheapnode* arr[FIBHEAP_MAX_DEGREE + 1];
+    for (int i = 0; i <= FIBHEAP_MAX_DEGREE; i++)
         arr[i] = NULL;
+
+    // break circular root list
+    fh->mini->left->right = NULL;
     struct fibheapnode* ptr1 = fh->mini;
     struct fibheapnode* ptr2;
     struct fibheapnode* ptr3;
-    struct fibheapnode* ptr4 = ptr1;
-    do {
-        ptr4 = ptr4->right;
-        temp1 = ptr1->degree;
-        while ((arr[temp1] != NULL) && (temp1 < size)) {
+    struct fibheapnode* next;
+
+    while (ptr1 != NULL) {
+    	next = ptr1->right;
+    	ptr1->left = ptr1->right = ptr1;
+        int temp1 = ptr1->degree;
+        while (arr[temp1] != NULL) {
             ptr2 = arr[temp1];
             if (fh->compare(ptr1->key, ptr2->key) > 0)	// (ptr1->key > ptr2->key)
             {
@@ -219,24 +189,17 @@ void fibheap_consolidate(struct fibheap* fh)
                 ptr1 = ptr2;
                 ptr2 = ptr3;
             }
-            if (ptr2 == fh->mini)
-                fh->mini = ptr1;
-            // fh->mini = mini;
             fibheap_fibonnaci_link(fh, ptr2, ptr1);
-            if (ptr1->right == ptr1)
-                fh->mini = ptr1;
             arr[temp1] = NULL;
             temp1++;
         }
         arr[temp1] = ptr1;
-        ptr1 = ptr1->right;
-    } while (ptr1 != fh->mini);
+        ptr1 = next;
+    }
 
     fh->mini = NULL;
-    for (int j = 0; j <= temp3; j++) {
+    for (int j = 0; j <= FIBHEAP_MAX_DEGREE; j++) {
         if (arr[j] != NULL) {
-            arr[j]->left = arr[j];
-            arr[j]->right = arr[j];
             if (fh->mini != NULL) {
                 ((fh->mini)->left)->right = arr[j];
                 arr[j]->right = fh->mini;
@@ -248,10 +211,6 @@ void fibheap_consolidate(struct fibheap* fh)
             else {
                 fh->mini = arr[j];
             }
-            if (fh->mini == NULL)
-            	fh->mini = arr[j];
-            else if (fh->compare(arr[j]->key, (fh->mini)->key) < 0)	// (arr[j]->key < mini->key)
-            	fh->mini = arr[j];
         }
     }
 }
@@ -338,7 +297,7 @@ void fibheap_cut(struct fibheap* fh, struct fibheapnode* found, struct fibheapno
     found->left = mini->left;
     mini->left = found;
     found->parent = NULL;
-    found->mark = FIBHEAP_MARK_BLACK;	// 'B';
+    found->mark = FIBHEAP_MARK_WHITE;	// roots are unmarked
 }
 
 /*
@@ -378,16 +337,23 @@ void fibheap_cascade_cut(struct fibheap* fh, struct fibheapnode* temp)
  *        If p[p[x]] is unmarked, mark it.
  *        Else, cut off p[p[x]] and repeat steps 4.2 to 4.5, taking p[p[x]] as ‘x’.
  *
+ * 'found' is the node handle returned by fibheap_insert, so no search is needed:
+ * O(1) amortized.
+ * Note: new value must not be greater than the current one.
  */
 void fibheap_decrease_key(struct fibheap* fh, struct fibheapnode* found, void* val)
 {
 	struct fibheapnode* mini = fh->mini;
 
-    if (mini == NULL)
+    if (mini == NULL) {
     	printf("The Heap is Empty");
+    	return;
+    }
 
-    if (found == NULL)
+    if (found == NULL) {
     	printf("Node not found in the Heap");
+    	return;
+    }
 
     found->key = val;
 
@@ -405,6 +371,7 @@ void fibheap_decrease_key(struct fibheap* fh, struct fibheapnode* found, void* v
 
 /*
  * Function to find the given node and decrease his value
+ * Note: searches all nodes (O(n)), use fibheap_decrease_key with the node handle.
  */
 void fibheap_find_and_decrease(struct fibheap* fh, struct fibheapnode* mini, void* old_val, void* val)
 {
@@ -441,6 +408,8 @@ void fibheap_find_and_decrease(struct fibheap* fh, struct fibheapnode* mini, voi
  *    	the root list.
  *    3- Apply Extract_min() algorithm to the Fibonacci heap.
  *
+ * Note: searches all nodes for 'val' (O(n)), use fibheap_delete_node with the node
+ * handle.
  */
 struct fibheapnode* fibheap_delete(struct fibheap* fh, void* val)
 {
@@ -461,6 +430,24 @@ struct fibheapnode* fibheap_delete(struct fibheap* fh, void* val)
     return result;
 }
 
+/*
+ * Removes a node from the heap given its handle (as returned by fibheap_insert), in
+ * O(log n) amortized: node is cut to the root list (with cascading cuts, as a decrease
+ * key to minus infinite) and extracted as the minimum.
+ * Returns the removed node (to be released with fibheap_destroynode).
+ */
+struct fibheapnode* fibheap_delete_node(struct fibheap* fh, struct fibheapnode* node)
+{
+	struct fibheapnode* parent = node->parent;
+	if (parent != NULL) {
+		fibheap_cut(fh, node, parent);
+		fibheap_cascade_cut(fh, parent);
+	}
+
+	fh->mini = node;
+	return fibheap_extract_min(fh);
+}
+
 /*
  * Function to display the heap
  */
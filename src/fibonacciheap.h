@@ -103,6 +103,7 @@
 	#define FIBHEAP_FLAG_YES  'Y'
 	#define FIBHEAP_MARK_WHITE  'W'
 	#define FIBHEAP_MARK_BLACK  'B'
+	#define FIBHEAP_MAX_DEGREE 64	// node degree is at most log_phi(n) (< 46 for int sizes)
 
 
 	// Creating a structure to represent a node in the heap
@@ -155,8 +156,11 @@
 	 *            Set H(min) pointer to x.
 	 *       4- Else:
 	 *            Insert x into root list and update H(min) if needed.
+	 *
+	 * Returns the created node: a stable handle to the element (until it is extracted)
+	 * for fibheap_decrease_key and fibheap_delete_node, NULL if out of memory.
 	 */
-	void fibheap_insert(struct fibheap* fh, void* val);
+	struct fibheapnode* fibheap_insert(struct fibheap* fh, void* val);
 
 	/*
 	 * Union of two Fibonacci heaps h1 with h2 and return result heap as h1 in O(1)
@@ -207,11 +211,15 @@
 	 *        If p[p[x]] is unmarked, mark it.
 	 *        Else, cut off p[p[x]] and repeat steps 4.2 to 4.5, taking p[p[x]] as ‘x’.
 	 *
+	 * 'found' is the node handle returned by fibheap_insert, so no search is needed:
+	 * O(1) amortized.
+	 * Note: new value must not be greater than the current one.
 	 */
 	void fibheap_decrease_key(struct fibheap* fh, struct fibheapnode* found, void* val);
 
 	/*
 	 * Function to find the given node and decrease his value
+	 * Note: searches all nodes (O(n)), use fibheap_decrease_key with the node handle.
 	 */
 	void fibheap_find_and_decrease(struct fibheap* fh, struct fibheapnode* mini,
 									void* old_val, void* val);
@@ -227,9 +235,19 @@
 	 *    	the root list.
 	 *    3- Apply Extract_min() algorithm to the Fibonacci heap.
 	 *
+	 * Note: searches all nodes for 'val' (O(n)), use fibheap_delete_node with the node
+	 * handle.
 	 */
 	struct fibheapnode* fibheap_delete(struct fibheap* fh, void* val);
 
+	/*
+	 * Removes a node from the heap given its handle (as returned by fibheap_insert), in
+	 * O(log n) amortized: node is cut to the root list (with cascading cuts, as a decrease
+	 * key to minus infinite) and extracted as the minimum.
+	 * Returns the removed node (to be released with fibheap_destroynode).
+	 */
+	struct fibheapnode* fibheap_delete_node(struct fibheap* fh, struct fibheapnode* node);
+
 	/*
 	 * Function to display the heap
 	 */
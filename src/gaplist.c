@@ -0,0 +1,214 @@
+/*
+ * gaplist.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Gap buffer list, O(1) inserts and removes near the last edit position.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "gaplist.h"
+
+/*
+ * Initializes an empty gaplist structure stored by the caller (no allocation).
+ * */
+void gaplist_init(struct gaplist* g) {
+	g->buffer = g->inlineitems;
+	g->capacity = GAPLIST_INLINE_CAPACITY;
+	g->gapstart = 0;
+	g->gapend = GAPLIST_INLINE_CAPACITY;
+}
+
+/*
+ * Releases the buffer of a gaplist initialized with gaplist_init.
+ * */
+void gaplist_release(struct gaplist* g) {
+	if (g->buffer != g->inlineitems)
+		free(g->buffer);
+
+	gaplist_init(g);
+}
+
+/*
+ * Creates and initializes a gaplist structure with a given capacity.
+ * Returns NULL if there is no memory.
+ * */
+struct gaplist* gaplist_create_capacity(size_t capacity) {
+	struct gaplist* result = malloc(sizeof(struct gaplist));
+	if (result == NULL)
+		return NULL;
+
+	gaplist_init(result);
+	if (capacity > GAPLIST_INLINE_CAPACITY) {
+		if (capacity > SIZE_MAX / sizeof(void*)) {
+			free(result);
+			return NULL;
+		}
+
+		result->buffer = malloc(capacity * sizeof(void*));
+		if (result->buffer == NULL) {
+			free(result);
+			return NULL;
+		}
+
+		result->capacity = capacity;
+		result->gapend = capacity;
+	}
+
+	return result;
+}
+
+/*
+ * Creates and initializes a gaplist structure.
+ * */
+struct gaplist* gaplist_create() {
+	return gaplist_create_capacity(GAPLIST_DEFAULT_CAPACITY);
+}
+
+/*
+ * Gets the number of elements in the list.
+ * */
+size_t gaplist_getsize(const struct gaplist* g) {
+	return g->capacity - (g->gapend - g->gapstart);
+}
+
+/*
+ * Gets the element at position 'index', in O(1).
+ * Returns NULL if index is out of bounds.
+ * */
+void* gaplist_get_item_at(const struct gaplist* g, size_t index) {
+	if (index >= gaplist_getsize(g))
+		return NULL;
+
+	return (index < g->gapstart) ? g->buffer[index]
+								 : g->buffer[index + (g->gapend - g->gapstart)];
+}
+
+/*
+ * Replaces the element at position 'index', in O(1).
+ * Returns the old element, NULL if index is out of bounds.
+ * */
+void* gaplist_set_item_at(struct gaplist* g, size_t index, void* x) {
+	if (index >= gaplist_getsize(g))
+		return NULL;
+
+	if (index >= g->gapstart)
+		index += g->gapend - g->gapstart;
+
+	void* old = g->buffer[index];
+	g->buffer[index] = x;
+	return old;
+}
+
+/*
+ * Moves the gap to start at 'index', copying the elements between the old and
+ * the new position.
+ * Note: Private function.
+ * */
+void gaplist_move_gap(struct gaplist* g, size_t index) {
+	size_t gaplen = g->gapend - g->gapstart;
+	if (index < g->gapstart) {
+		// elements [index, gapstart) go to the end of the gap
+		size_t count = g->gapstart - index;
+		memmove(g->buffer + g->gapend - count, g->buffer + index, count * sizeof(void*));
+	}
+	else if (index > g->gapstart) {
+		// elements [gapend, gapend + count) go to the start of the gap
+		size_t count = index - g->gapstart;
+		memmove(g->buffer + g->gapstart, g->buffer + g->gapend, count * sizeof(void*));
+	}
+
+	g->gapstart = index;
+	g->gapend = index + gaplen;
+}
+
+/*
+ * Doubles the buffer, the new slots are added to the gap.
+ * Returns 1 if succeeded, 0 otherwise.
+ * Note: Private function.
+ * */
+int gaplist_grow(struct gaplist* g) {
+	if (g->capacity > SIZE_MAX / 2 / sizeof(void*))
+		return 0;
+
+	size_t capacity = g->capacity * 2;
+	void** newBuffer = malloc(capacity * sizeof(void*));
+	if (newBuffer == NULL)
+		return 0;
+
+	size_t tail = g->capacity - g->gapend;
+	memcpy(newBuffer, g->buffer, g->gapstart * sizeof(void*));
+	memcpy(newBuffer + capacity - tail, g->buffer + g->gapend, tail * sizeof(void*));
+	if (g->buffer != g->inlineitems)
+		free(g->buffer);
+
+	g->buffer = newBuffer;
+	g->gapend = capacity - tail;
+	g->capacity = capacity;
+	return 1;
+}
+
+/*
+ * Inserts an element at position 'index' (0..size), moving the gap there.
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int gaplist_insert(struct gaplist* g, size_t index, void* x) {
+	if (index > gaplist_getsize(g))
+		return 0;
+
+	if (g->gapstart == g->gapend && !gaplist_grow(g))
+		return 0;
+
+	gaplist_move_gap(g, index);
+	g->buffer[g->gapstart++] = x;
+	return 1;
+}
+
+/*
+ * Appends an element to the end of the list.
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int gaplist_add(struct gaplist* g, void* x) {
+	return gaplist_insert(g, gaplist_getsize(g), x);
+}
+
+/*
+ * Removes the element at position 'index', moving the gap there.
+ * Returns the removed element if succeeded, NULL otherwise.
+ * */
+void* gaplist_remove_at(struct gaplist* g, size_t index) {
+	if (index >= gaplist_getsize(g))
+		return NULL;
+
+	gaplist_move_gap(g, index);
+	return g->buffer[g->gapend++];
+}
+
+/*
+ * Removes all elements (keeps the buffer).
+ * */
+void gaplist_clear(struct gaplist* g) {
+	g->gapstart = 0;
+	g->gapend = g->capacity;
+}
+
+/*
+ * Copies the elements in order to 'out' (capacity: size), two block copies.
+ * */
+void gaplist_to_array(const struct gaplist* g, void** out) {
+	size_t tail = g->capacity - g->gapend;
+	memcpy(out, g->buffer, g->gapstart * sizeof(void*));
+	memcpy(out + g->gapstart, g->buffer + g->gapend, tail * sizeof(void*));
+}
+
+/*
+ * Releases all memory from a gaplist created with gaplist_create (includes buffer).
+ * */
+void gaplist_destroy(struct gaplist* g) {
+	if (g->buffer != g->inlineitems)
+		free(g->buffer);
+
+	free(g);
+}
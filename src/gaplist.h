@@ -0,0 +1,125 @@
+/*****************************************************************************
+ * gaplist.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a gap buffer list, an array list for many inserts and
+ *  			 removes at nearby positions in the middle (text editor like).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Elements are stored in one array with a hole (the gap) at the last edit position:
+ *
+ *  	[ 0 .. gapstart )  elements before the gap
+ *  	[ gapstart .. gapend )  free slots
+ *  	[ gapend .. capacity )  elements after the gap
+ *
+ *  Getting or setting element i is O(1) (i, or i + gap length when i >= gapstart).
+ *  An insert or remove at position p first moves the gap to p, copying only the
+ *  elements between the old and the new position (one memmove), and then takes or
+ *  gives back one slot of the gap. A sequence of edits at nearby positions costs
+ *  O(1) amortized each, where an arraylist shifts all the elements after p on every
+ *  insert. Edits at random positions cost O(n) like in an arraylist.
+ *
+ *  When the gap is empty the buffer doubles and the new space becomes the gap.
+ *  Lists up to GAPLIST_INLINE_CAPACITY elements use the buffer inside the structure,
+ *  so a gaplist embedded in another structure or on the stack (gaplist_init) does not
+ *  allocate until it grows.
+ *
+ *  Source: C. Finseth, "The Craft of Text Editing", chapter 6 (1991).
+ *
+ *******************************************************************************/
+
+#ifndef GAPLIST_H_
+	#define GAPLIST_H_
+
+	#include <stddef.h>
+
+	#define GAPLIST_DEFAULT_CAPACITY 64
+	#define GAPLIST_INLINE_CAPACITY 16		// elements stored in the structure
+
+	/*
+	 * Declares gaplist structure
+	 * */
+	struct gaplist {
+		void** buffer;			// inlineitems or heap array with 'capacity' slots
+		size_t capacity;
+		size_t gapstart;		// first free slot
+		size_t gapend;			// first element after the gap
+		void* inlineitems[GAPLIST_INLINE_CAPACITY];
+	};
+
+	/*
+	 * Initializes an empty gaplist structure stored by the caller (no allocation).
+	 * */
+	void gaplist_init(struct gaplist* g);
+
+	/*
+	 * Releases the buffer of a gaplist initialized with gaplist_init.
+	 * */
+	void gaplist_release(struct gaplist* g);
+
+	/*
+	 * Creates and initializes a gaplist structure with a given capacity.
+	 * Returns NULL if there is no memory.
+	 * */
+	struct gaplist* gaplist_create_capacity(size_t capacity);
+
+	/*
+	 * Creates and initializes a gaplist structure.
+	 * */
+	struct gaplist* gaplist_create();
+
+	/*
+	 * Gets the number of elements in the list.
+	 * */
+	size_t gaplist_getsize(const struct gaplist* g);
+
+	/*
+	 * Gets the element at position 'index', in O(1).
+	 * Returns NULL if index is out of bounds.
+	 * */
+	void* gaplist_get_item_at(const struct gaplist* g, size_t index);
+
+	/*
+	 * Replaces the element at position 'index', in O(1).
+	 * Returns the old element, NULL if index is out of bounds.
+	 * */
+	void* gaplist_set_item_at(struct gaplist* g, size_t index, void* x);
+
+	/*
+	 * Inserts an element at position 'index' (0..size), moving the gap there.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 * */
+	int gaplist_insert(struct gaplist* g, size_t index, void* x);
+
+	/*
+	 * Appends an element to the end of the list.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 * */
+	int gaplist_add(struct gaplist* g, void* x);
+
+	/*
+	 * Removes the element at position 'index', moving the gap there.
+	 * Returns the removed element if succeeded, NULL otherwise.
+	 * */
+	void* gaplist_remove_at(struct gaplist* g, size_t index);
+
+	/*
+	 * Removes all elements (keeps the buffer).
+	 * */
+	void gaplist_clear(struct gaplist* g);
+
+	/*
+	 * Copies the elements in order to 'out' (capacity: size), two block copies.
+	 * */
+	void gaplist_to_array(const struct gaplist* g, void** out);
+
+	/*
+	 * Releases all memory from a gaplist created with gaplist_create (includes buffer).
+	 * */
+	void gaplist_destroy(struct gaplist* g);
+
+#endif /* GAPLIST_H_ */
@@ -95,6 +95,9 @@ struct hashset* hashset_create_capacity( size_t capacity, hashset_hashfunc hashf
 										   hashfunc, isequalfunc,
 										   NULL, freedatafunc );
 		result->printelement = printelementfunc;
+		result->prefilter = HASHSET_PREFILTER_NONE;
+		result->bloom = NULL;
+		result->cuckoo = NULL;
 	}
 	else
 	{
@@ -119,6 +122,91 @@ struct hashset* hashset_create( hashset_hashfunc hashfunc,
 	return result;
 }
 
+/*
+ * Releases the current pre-filter and builds a new one of given type for 'capacity'
+ * elements from the elements of the set.
+ * Returns 1 if succeeded, 0 otherwise (the set has no pre-filter).
+ * Note: Private function.
+ */
+int hashset_prefilter_build(struct hashset* set, int prefilter, size_t capacity)
+{
+	if (set->bloom != NULL)
+		bloomfilter_destroy(set->bloom);
+	if (set->cuckoo != NULL)
+		cuckoofilter_destroy(set->cuckoo);
+
+	set->bloom = NULL;
+	set->cuckoo = NULL;
+	set->prefilter = HASHSET_PREFILTER_NONE;
+	if (prefilter == HASHSET_PREFILTER_NONE)
+		return 1;
+
+	// elements are walked in place (no copy of the set)
+	struct hashset_iter it;
+	void* e = NULL;
+
+	if (prefilter == HASHSET_PREFILTER_BLOOM) {
+		set->bloom = bloomfilter_create(capacity, BLOOMFILTER_DEFAULT_BITS, set->htable->hashfunc);
+		if (set->bloom != NULL)
+			for (e = hashset_iter_begin(set, &it); e != NULL; e = hashset_iter_next(&it))
+				bloomfilter_add(set->bloom, e);
+	}
+	else {
+		// a full filter (unlucky kicks) is built again twice as large
+		do {
+			if (set->cuckoo != NULL) {
+				cuckoofilter_destroy(set->cuckoo);
+				capacity *= 2;
+			}
+
+			set->cuckoo = cuckoofilter_create(capacity, set->htable->hashfunc);
+			e = hashset_iter_begin(set, &it);
+			while (set->cuckoo != NULL && e != NULL && cuckoofilter_add(set->cuckoo, e))
+				e = hashset_iter_next(&it);
+
+			if (set->cuckoo == NULL || e == NULL)
+				break;
+		} while (1);
+	}
+
+	if (set->bloom == NULL && set->cuckoo == NULL)
+		return 0;
+
+	set->prefilter = prefilter;
+	return 1;
+}
+
+/*
+ * Sets a membership pre-filter (HASHSET_PREFILTER_...) checked before the hash table,
+ * so most lookups of absent elements are answered without walking a bucket chain.
+ * The filter is built from the current elements and rebuilt (twice as large) when
+ * the set outgrows it.
+ * Returns 1 if succeeded, 0 otherwise (no memory, the set has no pre-filter).
+ */
+int hashset_set_prefilter(struct hashset* set, int prefilter)
+{
+	size_t capacity = 2 * hashset_getsize(set);
+	if (capacity < set->htable->capacity)
+		capacity = set->htable->capacity;
+
+	return hashset_prefilter_build(set, prefilter, capacity);
+}
+
+/*
+ * Checks the pre-filter (if any).
+ * Returns 0 if element is surely not in the set, 1 if it may be.
+ * Note: Private function.
+ */
+int hashset_prefilter_maycontain(struct hashset* set, const void* value)
+{
+	if (set->bloom != NULL)
+		return bloomfilter_maycontain(set->bloom, value);
+	if (set->cuckoo != NULL)
+		return cuckoofilter_maycontain(set->cuckoo, value);
+
+	return 1;
+}
+
 /*
  * Returns the number of elements in the set.
  */
@@ -132,10 +220,43 @@ size_t hashset_getsize(struct hashset* set)
  */
 int hashset_contains(struct hashset* set, void* value)
 {
+	if (!hashset_prefilter_maycontain(set, value))
+		return 0;
+
 	void* el = hashtable_get(set->htable, value);
 	return (el != NULL);
 }
 
+/*
+ * Checks if the hashset contains each of 'n' given elements.
+ * out_found[i] is set to 1 if values[i] is in the set, 0 otherwise.
+ */
+void hashset_contains_batch(struct hashset* set, void** values, size_t n, int* out_found)
+{
+	struct hashtable_keyvalue_pair* found[HASHTABLE_BATCH_CHUNK];
+	void* candidates[HASHTABLE_BATCH_CHUNK];
+	size_t positions[HASHTABLE_BATCH_CHUNK];
+
+	for (size_t start = 0; start < n; start += HASHTABLE_BATCH_CHUNK) {
+		size_t len = (n - start < HASHTABLE_BATCH_CHUNK) ? (n - start) : HASHTABLE_BATCH_CHUNK;
+
+		// only elements passing the pre-filter go to the hash table
+		size_t ncandidates = 0;
+		for (size_t i = 0; i < len; ++i) {
+			out_found[start + i] = 0;
+			if (hashset_prefilter_maycontain(set, values[start + i])) {
+				candidates[ncandidates] = values[start + i];
+				positions[ncandidates++] = start + i;
+			}
+		}
+
+		// set elements are the hashtable keys (values are NULL), so check pairs
+		hashtable_find_batch(set->htable, candidates, ncandidates, found);
+		for (size_t i = 0; i < ncandidates; ++i)
+			out_found[positions[i]] = (found[i] != NULL);
+	}
+}
+
 /*
  * Adds a new element in the set.
  * Note: Must be unique (its a property of sets).
@@ -143,8 +264,17 @@ int hashset_contains(struct hashset* set, void* value)
 void hashset_add(struct hashset* set, void* value)
 {
 	// duplicated values are not allowed in sets
-	if (!hashset_contains(set, value))
-		hashtable_put(set->htable, value, HASHSET_ELEMENT_CONTENT);
+	if (hashset_contains(set, value))
+		return;
+
+	hashtable_put(set->htable, value, HASHSET_ELEMENT_CONTENT);
+	if (set->bloom != NULL) {
+		bloomfilter_add(set->bloom, value);
+		if (set->bloom->count > set->bloom->capacity)
+			hashset_prefilter_build(set, HASHSET_PREFILTER_BLOOM, 2 * set->bloom->capacity);
+	}
+	else if (set->cuckoo != NULL && !cuckoofilter_add(set->cuckoo, value))
+		hashset_prefilter_build(set, HASHSET_PREFILTER_CUCKOO, 2 * cuckoofilter_getcapacity(set->cuckoo));
 }
 
 /*
@@ -159,6 +289,8 @@ void* hashset_remove(struct hashset* set, void* value)
 	{
 		result = kvp->key;
 		free(kvp);
+		if (set->cuckoo != NULL)
+			cuckoofilter_remove(set->cuckoo, result);
 	}
 
 	return result;
@@ -167,6 +299,7 @@ void* hashset_remove(struct hashset* set, void* value)
 /*
  * Shallow copies all elements from the hashtable to an array.
  * You have to free result array from memory later in your code.
+ * Note: to only walk the elements use hashset_iter_begin (no copy).
  */
 void** hashset_toarray(struct hashset* set)
 {
@@ -174,6 +307,67 @@ void** hashset_toarray(struct hashset* set)
 	return result;
 }
 
+/*
+ * Starts an iteration over the elements of the set, walking the hash table buckets
+ * in place (no copy).
+ * Returns the first element, NULL if the set is empty.
+ * Note: the set must not be changed while iterating.
+ */
+void* hashset_iter_begin(const struct hashset* set, struct hashset_iter* it)
+{
+	struct hashtable_keyvalue_pair* kvp = hashtable_iter_begin(set->htable, &(it->it));
+	return (kvp != NULL) ? kvp->key : NULL;
+}
+
+/*
+ * Moves an iteration to the next element.
+ * Returns the element, NULL if there are no more elements.
+ */
+void* hashset_iter_next(struct hashset_iter* it)
+{
+	struct hashtable_keyvalue_pair* kvp = hashtable_iter_next(&(it->it));
+	return (kvp != NULL) ? kvp->key : NULL;
+}
+
+// visit function and argument of a set traversal
+struct hashset_visit_state {
+	hashset_visitfunc visit;
+	void* arg;
+};
+
+/*
+ * Visits the element (key) of a key/value pair of the set hash table.
+ * Note: Private function.
+ */
+void hashset_visit_pair(struct hashtable_keyvalue_pair* kvp, int worker, void* arg)
+{
+	struct hashset_visit_state* st = (struct hashset_visit_state*)arg;
+	st->visit(kvp->key, worker, st->arg);
+}
+
+/*
+ * Calls 'visit' for every element of the set (worker 0).
+ * Note: the set must not be changed during the traversal.
+ */
+void hashset_foreach(const struct hashset* set, hashset_visitfunc visit, void* arg)
+{
+	struct hashset_visit_state st = { visit, arg };
+	hashtable_foreach(set->htable, hashset_visit_pair, &st);
+}
+
+/*
+ * Calls 'visit' for every element of the set, in any order and concurrently on the
+ * threads of 'pool' (buckets are split in 'nchunks' ranges, 0: 8 per thread, see
+ * hashtable_parallel_foreach).
+ * Note: the set must not be changed during the traversal.
+ */
+void hashset_parallel_foreach(struct taskpool* pool, const struct hashset* set, size_t nchunks,
+							  hashset_visitfunc visit, void* arg)
+{
+	struct hashset_visit_state st = { visit, arg };
+	hashtable_parallel_foreach(pool, set->htable, nchunks, hashset_visit_pair, &st);
+}
+
 /*
  * Prints all elements in set.
  */
@@ -184,20 +378,16 @@ void hashset_print(struct hashset* set)
 		abort();
 	}
 	else {
-		void** keys = hashset_toarray(set);
-		size_t size = hashset_getsize(set);
+		struct hashset_iter it;
 		printf("{ ");
 
-		if (size > 0) {
-			set->printelement(keys[0]);
-
-			for (int i = 1; i < size; ++i) {
-				printf(", ");
-				set->printelement(keys[i]);
-			}
+		const char* separator = "";
+		for (void* e = hashset_iter_begin(set, &it); e != NULL; e = hashset_iter_next(&it)) {
+			printf("%s", separator);
+			set->printelement(e);
+			separator = ", ";
 		}
 
-		free(keys);
 		printf(" }\n");
 	}
 }
@@ -208,6 +398,10 @@ void hashset_print(struct hashset* set)
 void hashset_clear(struct hashset* set)
 {
 	hashtable_clear(set->htable);
+	if (set->bloom != NULL)
+		bloomfilter_clear(set->bloom);
+	if (set->cuckoo != NULL)
+		cuckoofilter_clear(set->cuckoo);
 }
 
 /*
@@ -215,6 +409,7 @@ void hashset_clear(struct hashset* set)
  * */
 void hashset_destroy(struct hashset* set)
 {
+	hashset_prefilter_build(set, HASHSET_PREFILTER_NONE, 0);
 	hashtable_destroy(set->htable);
 	free(set);
 }
@@ -75,20 +75,37 @@
 	#define HASHSET_H_
 
 	#include "hashtable.h"
+	#include "bloomfilter.h"
+	#include "cuckoofilter.h"
 
 	#define HASHSET_DEFAULT_CAPACITY HASHTABLE_DEFAULT_CAPACITY
 	#define HASHSET_DEFAULT_LOAD_FACTOR HASHTABLE_DEFAULT_LOAD_FACTOR
 	#define HASHSET_DEFAULT_RESIZE_FACTOR HASHTABLE_RESIZE_FACTOR
 	#define HASHSET_ELEMENT_CONTENT NULL
 
+	// membership pre-filters (see hashset_set_prefilter)
+	#define HASHSET_PREFILTER_NONE 0
+	#define HASHSET_PREFILTER_BLOOM 1		// blocked Bloom filter (removed elements keep their bits)
+	#define HASHSET_PREFILTER_CUCKOO 2		// cuckoo filter (follows removes)
+
 	typedef hashtable_hashfunc hashset_hashfunc;	// function to compute elements hash value
 	typedef hashtable_isequal hashset_isequal;		// function to check if two elements are equal
 	typedef void (*hashset_printelement)(void* element); // function to print a set element
 	typedef hashtable_freedata hashset_freedata;	// function to release elements from memory
+	// callback of foreach traversals ('worker' is the index of the running thread, 0 if sequential)
+	typedef void (*hashset_visitfunc)(void* element, int worker, void* arg);
+
+	// cursor over the elements of a set (see hashset_iter_begin)
+	struct hashset_iter {
+		struct hashtable_iter it;
+	};
 
 	struct hashset {
 		struct hashtable* htable;
 		hashset_printelement printelement;
+		int prefilter;							// pre-filter type (HASHSET_PREFILTER_...)
+		struct bloomfilter* bloom;				// Bloom pre-filter (or NULL)
+		struct cuckoofilter* cuckoo;			// cuckoo pre-filter (or NULL)
 	};
 
 
@@ -108,6 +125,15 @@
 									hashset_printelement printelementfunc,
 									hashset_freedata freedatafunc );
 
+	/*
+	 * Sets a membership pre-filter (HASHSET_PREFILTER_...) checked before the hash table,
+	 * so most lookups of absent elements are answered without walking a bucket chain.
+	 * The filter is built from the current elements and rebuilt (twice as large) when
+	 * the set outgrows it.
+	 * Returns 1 if succeeded, 0 otherwise (no memory, the set has no pre-filter).
+	 */
+	int hashset_set_prefilter( struct hashset* set, int prefilter );
+
 	/*
 	 * Returns the number of elements in the set.
 	 */
@@ -118,6 +144,13 @@
 	 */
 	int hashset_contains( struct hashset* set, void* value );
 
+	/*
+	 * Checks if the hashset contains each of 'n' given elements.
+	 * out_found[i] is set to 1 if values[i] is in the set, 0 otherwise.
+	 * Lookups are batched (see hashtable_find_batch).
+	 */
+	void hashset_contains_batch(struct hashset* set, void** values, size_t n, int* out_found);
+
 	/*
 	 * Adds a new element in the set.
 	 * Note: Must be unique (its a property of sets).
@@ -133,9 +166,42 @@
 	/*
 	 * Shallow copies all elements from the hashset to an array.
 	 * You have to free result array from memory later in your code.
+	 * Note: to only walk the elements use hashset_iter_begin (no copy).
 	 */
 	void** hashset_toarray(struct hashset* set);
 
+	/*
+	 * Starts an iteration over the elements of the set, walking the hash table buckets
+	 * in place (no copy).
+	 * Returns the first element, NULL if the set is empty.
+	 * Usage:
+	 *   struct hashset_iter it;
+	 *   for (void* e = hashset_iter_begin(set, &it); e != NULL; e = hashset_iter_next(&it)) ...
+	 * Note: the set must not be changed while iterating.
+	 */
+	void* hashset_iter_begin(const struct hashset* set, struct hashset_iter* it);
+
+	/*
+	 * Moves an iteration to the next element.
+	 * Returns the element, NULL if there are no more elements.
+	 */
+	void* hashset_iter_next(struct hashset_iter* it);
+
+	/*
+	 * Calls 'visit' for every element of the set (worker 0).
+	 * Note: the set must not be changed during the traversal.
+	 */
+	void hashset_foreach(const struct hashset* set, hashset_visitfunc visit, void* arg);
+
+	/*
+	 * Calls 'visit' for every element of the set, in any order and concurrently on the
+	 * threads of 'pool' (buckets are split in 'nchunks' ranges, 0: 8 per thread, see
+	 * hashtable_parallel_foreach).
+	 * Note: the set must not be changed during the traversal.
+	 */
+	void hashset_parallel_foreach(struct taskpool* pool, const struct hashset* set, size_t nchunks,
+								  hashset_visitfunc visit, void* arg);
+
 	/*
 	 * Prints all elements in set.
 	 */
@@ -44,7 +44,9 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "linkedlist.h"
+#include "taskpool.h"
 #include <assert.h>
+#include <string.h>
 
 /*
  * Checls if a given number is prime-
@@ -88,28 +90,37 @@ int hashtable_compute_threshold(size_t capacity, float loadfactor)
 }
 
 /*
- * Creates a new hash table with given initial size and load factor.
- * Note: freedatafunc function should release key pair key/data.
- * */
-struct hashtable* hashtable_create( size_t capacity, float loadfactor, float resizefactor,
-									  hashtable_hashfunc hashfunc,
-									  hashtable_isequal isequalfunc,
-									  hashtable_printitem printitemfunc,
-									  hashtable_freedata freedatafunc )
+ * Gets the smallest power of two greater or equal than a given number.
+ */
+size_t hashtable_next_pow2(size_t n)
 {
-	assert(capacity > HASHTABLE_MIN_SIZE);
-	assert( (loadfactor > 0.1) && (loadfactor < 1.0) );
-	assert( (resizefactor > 1.0) && (resizefactor < 10.0) );
+	size_t result = 1;
+	while (result < n)
+		result <<= 1;
 
-	capacity = hashtable_get_prime(capacity);
+	return result;
+}
 
-	uint arr_size = capacity * sizeof(struct linkedlist);
-	struct hashtable* result = malloc(sizeof(*result));
+/*
+ * Creates a new hash table with an exact capacity (no prime or power of two rounding).
+ * Only one of 'hashfunc' and 'hashfunc64' should be set.
+ * */
+struct hashtable* hashtable_create_exact( size_t capacity, float loadfactor,
+										  hashtable_hashfunc hashfunc,
+										  hashtable_hashfunc64 hashfunc64,
+										  hashtable_isequal isequalfunc,
+										  hashtable_printitem printitemfunc,
+										  hashtable_freedata freedatafunc,
+										  const struct allocator* allocator )
+{
+	size_t arr_size = capacity * sizeof(struct linkedlist*);
+	struct hashtable* result = allocator_alloc(allocator, sizeof(*result));
 
 	if (result == NULL)
 		return result;
 	else {
-		result->harray = (struct linkedlist**)malloc(arr_size);
+		result->allocator = allocator;
+		result->harray = (struct linkedlist**)allocator_alloc(allocator, arr_size);
 		if (!(result->harray)) {
 			printf("Error: failed to allocate memory for hashtable array!");
 			abort();
@@ -120,6 +131,7 @@ struct hashtable* hashtable_create( size_t capacity, float loadfactor, float res
 		result->threshold = hashtable_compute_threshold(capacity, loadfactor);
 
 		result->hashfunc = hashfunc;
+		result->hashfunc64 = hashfunc64;
 		result->isequal = isequalfunc;
 		result->printitem = printitemfunc;
 		result->freedata = freedatafunc;
@@ -131,11 +143,115 @@ struct hashtable* hashtable_create( size_t capacity, float loadfactor, float res
 
 		result->count = 0;
 		result->resizefactor = HASHTABLE_RESIZE_FACTOR;
+		result->incremental = 0;
+		result->oldarray = NULL;
+		result->oldcapacity = 0;
+		result->migrateindex = 0;
+		result->counters = (struct hashtable_counters){ 0 };
+
+		result->nodepool = linkedlist_nodepool_create_allocator(HASHTABLE_NODEPOOL_SLAB, allocator);
+		if (result->nodepool == NULL) {
+			printf("Error: failed to allocate memory for hashtable node pool!");
+			abort();
+		}
 	}
 
 	return result;
 }
 
+/*
+ * Creates a new hash table with given initial size and load factor.
+ * Note: freedatafunc function should release key pair key/data.
+ * */
+struct hashtable* hashtable_create( size_t capacity, float loadfactor, float resizefactor,
+									  hashtable_hashfunc hashfunc,
+									  hashtable_isequal isequalfunc,
+									  hashtable_printitem printitemfunc,
+									  hashtable_freedata freedatafunc )
+{
+	return hashtable_create_allocator( capacity, loadfactor, resizefactor, hashfunc,
+									   isequalfunc, printitemfunc, freedatafunc, NULL );
+}
+
+/*
+ * Creates a new hash table with given initial size and load factor, whose structure,
+ * hash arrays, bucket lists and list nodes are allocated by 'allocator' (see
+ * allocator.h, NULL: C library).
+ * Note: key/value pairs are still allocated with malloc (released by freedatafunc).
+ * */
+struct hashtable* hashtable_create_allocator( size_t capacity, float loadfactor, float resizefactor,
+											  hashtable_hashfunc hashfunc,
+											  hashtable_isequal isequalfunc,
+											  hashtable_printitem printitemfunc,
+											  hashtable_freedata freedatafunc,
+											  const struct allocator* allocator )
+{
+	assert(capacity > HASHTABLE_MIN_SIZE);
+	assert( (loadfactor > 0.1) && (loadfactor < 1.0) );
+	assert( (resizefactor > 1.0) && (resizefactor < 10.0) );
+
+	capacity = hashtable_get_prime(capacity);
+
+	return hashtable_create_exact( capacity, loadfactor, hashfunc, NULL,
+								   isequalfunc, printitemfunc, freedatafunc, allocator );
+}
+
+/*
+ * Creates a new hash table using a 64 bit hash function, given initial size and load factor.
+ * Capacity is rounded up to a power of two and buckets are selected with fibonacci
+ * (multiply-shift) hashing, so no division or prime search is ever needed.
+ * */
+struct hashtable* hashtable_create64( size_t capacity, float loadfactor, float resizefactor,
+									  hashtable_hashfunc64 hashfunc64,
+									  hashtable_isequal isequalfunc,
+									  hashtable_printitem printitemfunc,
+									  hashtable_freedata freedatafunc )
+{
+	assert(capacity > HASHTABLE_MIN_SIZE);
+	assert( (loadfactor > 0.1) && (loadfactor < 1.0) );
+	assert( (resizefactor > 1.0) && (resizefactor < 10.0) );
+
+	capacity = hashtable_next_pow2(capacity);
+
+	return hashtable_create_exact( capacity, loadfactor, NULL, hashfunc64,
+								   isequalfunc, printitemfunc, freedatafunc, NULL );
+}
+
+/*
+ * Computes the hash value of a key with the table hash function.
+ * */
+uint64_t hashtable_hashkey(const struct hashtable* htable, const void* key)
+{
+	if (htable->hashfunc64 != NULL)
+		return htable->hashfunc64(key);
+	else
+		return (uint64_t)(int64_t)htable->hashfunc(key);
+}
+
+/*
+ * Maps a hash value to a bucket of a hash array with given capacity.
+ * 64 bit hash tables use fibonacci hashing (top bits of hash * 2^64/phi), others
+ * use modulo of the (prime) capacity.
+ * */
+size_t hashtable_bucket_index(const struct hashtable* htable, uint64_t hash, size_t capacity)
+{
+	if (htable->hashfunc64 != NULL)
+		return (size_t)((hash * HASHTABLE_FIBONACCI_MULT) >> (64 - __builtin_ctzll(capacity)));
+	else
+		return hash % capacity;
+}
+
+/*
+ * Computes the hash array size for the next reallocation.
+ * */
+size_t hashtable_next_capacity(const struct hashtable* htable)
+{
+	if (htable->hashfunc64 != NULL)
+		return hashtable_next_pow2( htable->resizefactor * (float)(htable->capacity) );
+	else
+		return hashtable_get_prime( htable->resizefactor * (float)(htable->capacity) );
+}
+
 /*
  * Creates a new hash table with default settings (size = 16, LF = 0.75).
  * */
@@ -153,118 +269,274 @@ struct hashtable* hashtable_create_default( hashtable_hashfunc hashfunc,
 	return result;
 }
 
+/*
+ * Creates a new hash table with incremental resize, given initial size and load factor.
+ * When the threshold is reached the old and new hash arrays are kept side by side and
+ * each later put/get/remove migrates at most HASHTABLE_MIGRATE_STEP buckets, so no
+ * single operation pays for a full rehash.
+ * */
+struct hashtable* hashtable_create_incremental( size_t capacity, float loadfactor, float resizefactor,
+												hashtable_hashfunc hashfunc,
+												hashtable_isequal isequalfunc,
+												hashtable_printitem printitemfunc,
+												hashtable_freedata freedatafunc )
+{
+	struct hashtable* result = hashtable_create( capacity, loadfactor, resizefactor,
+												 hashfunc, isequalfunc,
+												 printitemfunc, freedatafunc );
+	if (result != NULL)
+		result->incremental = 1;
+
+	return result;
+}
+
 /*
  * Checks if a given hash array slot is empty.
  * Returns 1 if slot is empty, 0 otherwise.
  * */
-int hashtable_isemptybucket(const struct hashtable* htable, int bucket) {
-	return ((htable->harray[bucket] == NULL) || (htable->harray[bucket]->size == 0));
+int hashtable_isemptybucket(struct linkedlist** arr, size_t bucket) {
+	return ((arr[bucket] == NULL) || (arr[bucket]->size == 0));
 }
 
 /*
- * Inserts a new key/value pair in the given hashtable array.
+ * Appends an existing key/value pair to a bucket of the given hashtable array.
  * Returns: '1' (true) if succeeded, '0' (false) otherwise.
  * Note: does not verify if key already exists in the linked list.
  */
-int hashtable_insert_on_array( int bucket,
+int hashtable_append_on_array( size_t bucket,
 							   hashtable_isequal isequal,
 							   hashtable_freedata freedata,
-							   size_t capacity,
-						       struct linkedlist** arr, void* key, void* value )
+							   struct linkedlist_nodepool* pool,
+							   struct linkedlist** arr,
+							   struct hashtable_keyvalue_pair* kvp )
 {
-	int result = 0;
-
 	struct linkedlist* list = NULL;
-	struct hashtable_keyvalue_pair* kvp = NULL;
-	kvp = (struct hashtable_keyvalue_pair*)malloc(sizeof(*kvp));
-	kvp->key = key;
-	kvp->value = value;
 
 	if (arr[bucket] == NULL)
-		list = linkedlist_create(isequal, freedata);
+		list = linkedlist_create_pooled(isequal, freedata, pool);
 	else
 		list = arr[bucket];
 
 	if (linkedlist_append(list, kvp)) {
 		arr[bucket] = list;
-		result = 1;	// succeess
+		return 1;	// succeess
 	}
 	else {
 		printf("Error: failed to append node in linked list of hashtable bucket!");
 		abort();
 	}
+}
 
-	return result;
+/*
+ * Inserts a new key/value pair in the given hashtable array.
+ * Returns: '1' (true) if succeeded, '0' (false) otherwise.
+ * Note: does not verify if key already exists in the linked list.
+ */
+int hashtable_insert_on_array( size_t bucket,
+							   hashtable_isequal isequal,
+							   hashtable_freedata freedata,
+							   struct linkedlist_nodepool* pool,
+						       struct linkedlist** arr, void* key, void* value, uint64_t hash )
+{
+	struct hashtable_keyvalue_pair* kvp = NULL;
+	kvp = (struct hashtable_keyvalue_pair*)malloc(sizeof(*kvp));
+	if (kvp == NULL) {
+		printf("Memory error: failed to allocate memory for hashtable key/value pair!");
+		abort();
+	}
+
+	kvp->key = key;
+	kvp->value = value;
+	kvp->hash = hash;
+
+	return hashtable_append_on_array(bucket, isequal, freedata, pool, arr, kvp);
 }
 
 /*
- * Reallocates all items in the hash table array.
- * Must be invoked every time hash table array if resized.
- * Returns 1 if succeeded, 0 otherwise.
+ * Moves all key/value pairs of a bucket from the old hash array to the current one.
+ * Pairs are relinked, not copied.
  * */
-void hashtable_reallocate( struct hashtable* htable,
-										size_t new_size ) {
-	int hashvalue = -1;
-	int bucket = -1;
-	struct linkedlist** new_array = (struct linkedlist**)malloc(sizeof(struct linkedlist) * new_size);
+void hashtable_migrate_bucket(struct hashtable* htable, size_t bucket)
+{
+	struct linkedlist* list = htable->oldarray[bucket];
+	struct linkedlistnode* node = NULL;
+	struct hashtable_keyvalue_pair* kvp = NULL;
 
-	// important: don't forget to initialize
-	for (int i = 0; i < new_size; ++i) {
-		new_array[i] = NULL;
+	if (list == NULL)
+		return;
+
+	while ((node = linkedlist_remove_first(list)) != NULL) {
+		kvp = (struct hashtable_keyvalue_pair*)node->data;
+		// stored hash avoids calling hash function again
+		hashtable_append_on_array( hashtable_bucket_index(htable, kvp->hash, htable->capacity),
+								   htable->isequal, htable->freedata, htable->nodepool,
+								   htable->harray, kvp );
+		linkedlist_freenode(list, node);
 	}
 
-	int capacity = htable->capacity;
-	int count = 0;
-	int numItems = htable->count;
-	struct linkedlist* list = NULL;
-	struct linkedlistnode* listnode = NULL;
-	struct hashtable_keyvalue_pair* kvp = NULL;
+	linkedlist_destroy(list);	// empty list, no data to release
+	htable->oldarray[bucket] = NULL;
+}
 
-	for (int i = 0; i < capacity; ++i) {
-		// skip empty buckets
-		if (hashtable_isemptybucket(htable, i))
-		{
-			if (htable->harray[i] != NULL)
-				free(htable->harray[i]);
-			continue;
+/*
+ * Migrates up to HASHTABLE_MIGRATE_STEP buckets of an ongoing resize.
+ * Releases the old hash array when all buckets were moved.
+ * */
+void hashtable_migrate_step(struct hashtable* htable)
+{
+	DATASTATS_ONLY(uint64_t start = datastats_nanotime();)
+
+	for (int i = 0; (i < HASHTABLE_MIGRATE_STEP) && (htable->oldarray != NULL); ++i) {
+		hashtable_migrate_bucket(htable, htable->migrateindex++);
+
+		if (htable->migrateindex == htable->oldcapacity) {
+			allocator_free( htable->allocator, htable->oldarray,
+							htable->oldcapacity * sizeof(struct linkedlist*) );
+			htable->oldarray = NULL;
+			htable->oldcapacity = 0;
+			htable->migrateindex = 0;
 		}
+	}
 
-		list = htable->harray[i];
-		listnode = linkedlist_getfirst(list);
+	DATASTATS_ADD(htable->counters.resizens, datastats_nanotime() - start);
+}
 
-		while (listnode != NULL) {
-			kvp = (struct hashtable_keyvalue_pair*)listnode->data;
-			hashvalue = htable->hashfunc(kvp->key);
-			bucket = hashvalue % new_size;
+/*
+ * Completes an ongoing incremental resize, if any.
+ * */
+void hashtable_finish_resize(struct hashtable* htable)
+{
+	while (htable->oldarray != NULL)
+		hashtable_migrate_step(htable);
+}
 
-			if (hashtable_insert_on_array( bucket, htable->isequal,
-										   htable->freedata, new_size,
-										   new_array, kvp->key, kvp->value)
-										 )
-			{
-				if (++count == numItems) {
-					free(kvp);
-					break;
-				}
-			}
-			else {
-				printf("Function hashtable_reallocate(): Error inserting new item in hashtable array!");
-				abort();
-			}
+/*
+ * Starts a resize: current hash array becomes the old array and an empty array with
+ * the new size takes its place. Buckets are moved later by hashtable_migrate_step.
+ * */
+void hashtable_start_resize(struct hashtable* htable, size_t new_size)
+{
+	hashtable_finish_resize(htable);	// only one resize at a time
+	DATASTATS_ONLY(uint64_t start = datastats_nanotime();)
 
-			free(kvp);
-			listnode = listnode->next;
-		}
+	struct linkedlist** new_array = (struct linkedlist**)allocator_alloc( htable->allocator,
+																		  sizeof(struct linkedlist*) * new_size );
+	if (new_array == NULL) {
+		printf("Memory error: failed to allocate memory for reallocated hashtable array!");
+		abort();
+	}
 
-		linkedlist_destroy(list);
+	// important: don't forget to initialize
+	for (size_t i = 0; i < new_size; ++i) {
+		new_array[i] = NULL;
 	}
 
-	free(htable->harray);	// release old array
+	htable->oldarray = htable->harray;
+	htable->oldcapacity = htable->capacity;
+	htable->migrateindex = 0;
 	htable->harray = new_array;
-	//htable->count = count; // no need. is the same.
 	htable->capacity = new_size;
 	htable->threshold = hashtable_compute_threshold(new_size, htable->loadfactor);
-//	return result;
+
+	DATASTATS_COUNT(htable->counters.resizes);
+	DATASTATS_ADD(htable->counters.resizens, datastats_nanotime() - start);
+}
+
+/*
+ * Reallocates all items in the hash table array.
+ * Must be invoked every time hash table array if resized.
+ * */
+void hashtable_reallocate( struct hashtable* htable,
+						   size_t new_size ) {
+	hashtable_start_resize(htable, new_size);
+	hashtable_finish_resize(htable);
+}
+
+/*
+ * Gets the hash array and bucket where a key with given hash value lives.
+ * While a resize is in progress, buckets of the old array not yet migrated still
+ * hold their keys.
+ * */
+struct linkedlist** hashtable_locate(const struct hashtable* htable, uint64_t hashvalue, size_t* bucket)
+{
+	if (htable->oldarray != NULL) {
+		size_t oldbucket = hashtable_bucket_index(htable, hashvalue, htable->oldcapacity);
+		if (oldbucket >= htable->migrateindex) {
+			*bucket = oldbucket;
+			return htable->oldarray;
+		}
+	}
+
+	*bucket = hashtable_bucket_index(htable, hashvalue, htable->capacity);
+	return htable->harray;
+}
+
+/*
+ * Finds the key/value pair of a given key with given hash value (no resize work is done).
+ * Nodes with a different stored hash are skipped without calling 'isequal'.
+ * Returns pointer to key/value pair if succeeded, NULL otherwise.
+ * */
+struct hashtable_keyvalue_pair* hashtable_find(const struct hashtable* htable, const void* key, uint64_t hash)
+{
+	size_t bucket = 0;
+	struct linkedlist** arr = hashtable_locate(htable, hash, &bucket);
+
+	if (hashtable_isemptybucket(arr, bucket))
+		return NULL;	// not found
+
+	// Note: must scan node by node because list entries are
+	// keyvalue pairs, not keys only
+	struct linkedlistnode* node = linkedlist_getfirst(arr[bucket]);
+	struct hashtable_keyvalue_pair* kvp = NULL;
+	while (node) {
+		kvp = (struct hashtable_keyvalue_pair*)(node->data);
+		if ((kvp->hash == hash) && (htable->isequal(kvp->key, key)))
+			return kvp;
+		else
+			node = node->next;
+	}
+
+	return NULL;
+}
+
+/*
+ * Adds the key/value with an already computed hash value to the hash table.
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int hashtable_put_hashed(struct hashtable* htable, void* key, void* value, uint64_t hash)
+{
+	// already exists?
+	if (hashtable_find(htable, key, hash) != NULL)
+	{
+		// duplicated keys are not allowed
+		printf("Error: failed to insert key in hashtable. Duplicate keys are not allowed.\n");
+		return 0;
+	}
+
+	size_t bucket = 0;
+	struct linkedlist** arr = hashtable_locate(htable, hash, &bucket);
+	DATASTATS_COUNT(htable->counters.puts);
+	DATASTATS_ADD(htable->counters.collisions, !hashtable_isemptybucket(arr, bucket));
+
+	if (hashtable_insert_on_array(bucket, htable->isequal, htable->freedata, htable->nodepool, arr, key, value, hash))
+		htable->count++;
+	else
+	{
+		printf("Error: failed to insert key/value pair on hashtable array bucket!");
+		abort();
+	}
+
+	// if threshold reached, reallocate and re-hash
+	if (htable->count >= htable->threshold) {
+		size_t new_size = hashtable_next_capacity(htable);
+
+		if (htable->incremental)
+			hashtable_start_resize(htable, new_size);
+		else
+			hashtable_reallocate(htable, new_size);
+	}
+
+	return 1;
 }
 
 /*
@@ -274,60 +546,96 @@ void hashtable_reallocate( struct hashtable* htable,
  * */
 int hashtable_put(struct hashtable* htable, void* key, void* value)
 {
-	int result = 0;
-	int hashvalue = htable->hashfunc(key);
-	int bucket = hashvalue % htable->capacity;
-	struct linkedlist* list = NULL;
-//	struct hashtablekeyvaluepair* kvp = NULL;
+	if (htable->oldarray != NULL)
+		hashtable_migrate_step(htable);
 
-//	kvp = (struct hashtablekeyvaluepair*)malloc(sizeof(*kvp));
-//	kvp->key = key;
-//	kvp->value = value;
+	return hashtable_put_hashed(htable, key, value, hashtable_hashkey(htable, key));
+}
 
-	if (hashtable_isemptybucket(htable, bucket)) {
+/*
+ * Computes hash values and prefetches buckets of a chunk of keys.
+ * First pass touches the bucket slots, second pass the bucket lists, so the cache
+ * misses of all keys in the chunk overlap instead of being paid one after another.
+ * */
+void hashtable_prefetch_chunk(struct hashtable* htable, void** keys, size_t n, uint64_t* hashes)
+{
+	size_t buckets[HASHTABLE_BATCH_CHUNK];
+	struct linkedlist** arrays[HASHTABLE_BATCH_CHUNK];
 
-		if (hashtable_insert_on_array( bucket, htable->isequal, htable->freedata,
-									   htable->capacity, htable->harray, key, value))
-		{
-			htable->count++;
-			result = 1;	// succeess
-		}
-		else
-		{
-			printf("Error: failed to insert key/value pair on hashtable array bucket!");
-			abort();
-		}
+	for (size_t i = 0; i < n; ++i) {
+		hashes[i] = hashtable_hashkey(htable, keys[i]);
+		arrays[i] = hashtable_locate(htable, hashes[i], &buckets[i]);
+		__builtin_prefetch(&(arrays[i][buckets[i]]));
 	}
-	else {
-		// already exists?
-		if (hashtable_get(htable, key) != NULL)
-		{
-			// duplicated keys are not allowed
-			printf("Error: failed to insert key in hashtable. Duplicate keys are not allowed.\n");
-			return 0;
-		}
-		else
-		{
-			if (hashtable_insert_on_array( bucket, htable->isequal, htable->freedata,
-										   htable->capacity, htable->harray, key, value))
-			{
-				htable->harray[bucket] = list;
-				htable->count++;
-				result = 1;	// succeess
-			}
-			else
-			{
-				printf("Error: failed to insert key/value pair on hashtable array bucket!");
-				abort();
-			}
-		}
+
+	for (size_t i = 0; i < n; ++i) {
+		struct linkedlist* list = arrays[i][buckets[i]];
+		if (list != NULL)
+			__builtin_prefetch(list);
 	}
+}
 
-	// if threshold reached, reallocate and re-hash
-	if (htable->count == htable->threshold) {
-//		printf("Reallocation after inserting %zu elements...\n", htable->count);
-		hashtable_reallocate(htable, hashtable_get_prime( htable->resizefactor * (float)(htable->capacity) ) );
-//		printf("After reallocating, capacity = %zu ...\n", htable->capacity);
+/*
+ * Gets the key/value pairs associated with an array of 'n' keys.
+ * out_pairs[i] receives the key/value pair of keys[i] or NULL if key was not found.
+ * */
+void hashtable_find_batch(struct hashtable* htable, void** keys, size_t n,
+						  struct hashtable_keyvalue_pair** out_pairs)
+{
+	uint64_t hashes[HASHTABLE_BATCH_CHUNK];
+
+	for (size_t start = 0; start < n; start += HASHTABLE_BATCH_CHUNK) {
+		size_t len = (n - start < HASHTABLE_BATCH_CHUNK) ? (n - start) : HASHTABLE_BATCH_CHUNK;
+
+		// resize work is done before locating buckets
+		for (size_t i = 0; (i < len) && (htable->oldarray != NULL); ++i)
+			hashtable_migrate_step(htable);
+
+		hashtable_prefetch_chunk(htable, keys + start, len, hashes);
+
+		for (size_t i = 0; i < len; ++i)
+			out_pairs[start + i] = hashtable_find(htable, keys[start + i], hashes[i]);
+	}
+}
+
+/*
+ * Gets the values associated with an array of 'n' keys.
+ * out_values[i] receives the value of keys[i] (not the key/value pair) or NULL if
+ * key was not found.
+ * */
+void hashtable_get_batch(struct hashtable* htable, void** keys, size_t n, void** out_values)
+{
+	struct hashtable_keyvalue_pair* pairs[HASHTABLE_BATCH_CHUNK];
+
+	for (size_t start = 0; start < n; start += HASHTABLE_BATCH_CHUNK) {
+		size_t len = (n - start < HASHTABLE_BATCH_CHUNK) ? (n - start) : HASHTABLE_BATCH_CHUNK;
+
+		hashtable_find_batch(htable, keys + start, len, pairs);
+		for (size_t i = 0; i < len; ++i)
+			out_values[start + i] = (pairs[i] != NULL) ? pairs[i]->value : NULL;
+	}
+}
+
+/*
+ * Adds an array of 'n' key/value pairs to the hash table.
+ * Returns the number of pairs inserted (duplicate keys are not inserted).
+ * */
+size_t hashtable_put_batch(struct hashtable* htable, void** keys, void** values, size_t n)
+{
+	uint64_t hashes[HASHTABLE_BATCH_CHUNK];
+	size_t result = 0;
+
+	for (size_t start = 0; start < n; start += HASHTABLE_BATCH_CHUNK) {
+		size_t len = (n - start < HASHTABLE_BATCH_CHUNK) ? (n - start) : HASHTABLE_BATCH_CHUNK;
+
+		for (size_t i = 0; (i < len) && (htable->oldarray != NULL); ++i)
+			hashtable_migrate_step(htable);
+
+		hashtable_prefetch_chunk(htable, keys + start, len, hashes);
+
+		// inserts stay sequential (a resize may happen in between)
+		for (size_t i = 0; i < len; ++i)
+			result += hashtable_put_hashed(htable, keys[start + i], values[start + i], hashes[i]);
 	}
 
 	return result;
@@ -347,37 +655,11 @@ int hashtable_contains(struct hashtable* htable, void* key)
  * Returns pointer to value if succeeded, NULL otherwise.
  * */
 void* hashtable_get(const struct hashtable* htable, const void* key) {
-	void* result = NULL;
-	int hashvalue = htable->hashfunc(key);
-	int bucket = hashvalue % htable->capacity;
+	// migrating buckets does not change table contents, only where they are stored
+	if (htable->oldarray != NULL)
+		hashtable_migrate_step((struct hashtable*)htable);
 
-	if (hashtable_isemptybucket(htable, bucket)) {
-		// not found
-		return result;
-	}
-	else
-	{
-		struct linkedlist* list = htable->harray[bucket];
-
-		if (list)
-		{
-			// Note: must scan node by node because list entries are
-			// keyvalue pairs, not keys only
-			struct linkedlistnode* node = linkedlist_getfirst(list);
-			struct hashtable_keyvalue_pair* kvp = NULL;
-			while (node) {
-				kvp = (struct hashtable_keyvalue_pair*)(node->data);
-				if (htable->isequal(kvp->key, key)) {
-					result = kvp;
-					break;
-				}
-				else
-					node = node->next;
-			}
-		}
-	}
-
-	return result;
+	return hashtable_find(htable, key, hashtable_hashkey(htable, key));
 }
 
 /*
@@ -387,15 +669,20 @@ void* hashtable_get(const struct hashtable* htable, const void* key) {
 struct hashtable_keyvalue_pair* hashtable_remove(struct hashtable* htable, const void* key)
 {
 	struct hashtable_keyvalue_pair* result = NULL;
-	int hashvalue = htable->hashfunc(key);
-	int bucket = hashvalue % htable->capacity;
 
-	if (hashtable_isemptybucket(htable, bucket)) {
+	if (htable->oldarray != NULL)
+		hashtable_migrate_step(htable);
+
+	uint64_t hash = hashtable_hashkey(htable, key);
+	size_t bucket = 0;
+	struct linkedlist** arr = hashtable_locate(htable, hash, &bucket);
+
+	if (hashtable_isemptybucket(arr, bucket)) {
 		// not found
 		return result;
 	}
 	else {
-		struct linkedlist* list = htable->harray[bucket];
+		struct linkedlist* list = arr[bucket];
 		struct linkedlistnode* node = linkedlist_getfirst(list);
 		struct linkedlistnode* first = node;
 		struct linkedlistnode* prev = NULL;
@@ -403,15 +690,18 @@ struct hashtable_keyvalue_pair* hashtable_remove(struct hashtable* htable, const
 		struct hashtable_keyvalue_pair* kvp = NULL;
 		while (node != NULL) {
 			kvp = (struct hashtable_keyvalue_pair*)(node->data);
-			if (htable->isequal(key, kvp->key)) {
+			if ((kvp->hash == hash) && (htable->isequal(key, kvp->key))) {
 				if (node == first) {
 					del = linkedlist_remove_first(list);
-					free(del);
+					linkedlist_freenode(list, del);
 				} else {
 					del = node;
 					prev->next = node->next;	// remove from list
 					node->next = NULL;
-					free(del);
+					list->size--;
+					if (*(list->tailp) == del)
+						*(list->tailp) = prev;
+					linkedlist_freenode(list, del);
 				}
 
 				result = kvp;
@@ -432,6 +722,8 @@ struct hashtable_keyvalue_pair* hashtable_remove(struct hashtable* htable, const
  */
 void hashtable_print(struct hashtable* htable)
 {
+	hashtable_finish_resize(htable);
+
 	if (!(htable->printitem)) {
 		printf("Error: 'printitem' function is undefined.");
 		abort();
@@ -471,12 +763,295 @@ void hashtable_print(struct hashtable* htable)
 	printf("}\n");
 }
 
+/*
+ * Saves the hash table to a snapshot file (see snapshot.h): one record per pair with
+ * its memoized hash and the key and value written by 'codec' (values are not saved
+ * if codec->encodevalue is NULL), grouped by bucket, then the offset of each bucket.
+ * An incremental resize in progress is completed first.
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int hashtable_save(struct hashtable* htable, const char* path, const struct snapshot_codec* codec)
+{
+	hashtable_finish_resize(htable);
+
+	uint64_t* index = (uint64_t*)malloc((htable->capacity + 1) * sizeof(uint64_t));
+	if (index == NULL)
+		return 0;
+
+	struct snapshot_writer w;
+	if (!snapshot_writer_open(&w, path, SNAPSHOT_MAGIC_HASHTABLE)) {
+		free(index);
+		return 0;
+	}
+
+	for (size_t i = 0; i < htable->capacity; ++i) {
+		index[i] = w.pos;
+		if (hashtable_isemptybucket(htable->harray, i))
+			continue;
+
+		for (struct linkedlistnode* node = linkedlist_getfirst(htable->harray[i]); node != NULL; node = node->next) {
+			struct hashtable_keyvalue_pair* kvp = (struct hashtable_keyvalue_pair*)node->data;
+			snapshot_write_record(&w, codec, kvp->hash, kvp->key, kvp->value);
+		}
+	}
+
+	index[htable->capacity] = w.pos;
+	w.header.indexpos = w.pos;
+	snapshot_write(&w, index, (htable->capacity + 1) * sizeof(uint64_t));
+	free(index);
+
+	w.header.capacity = htable->capacity;
+	w.header.loadfactor = htable->loadfactor;
+	w.header.resizefactor = htable->resizefactor;
+	w.header.flags = ((codec->encodevalue != NULL) ? SNAPSHOT_FLAG_VALUES : 0)
+					 | ((htable->hashfunc64 != NULL) ? SNAPSHOT_FLAG_HASH64 : 0)
+					 | (htable->incremental ? SNAPSHOT_FLAG_INCREMENTAL : 0);
+	return snapshot_writer_close(&w);
+}
+
+/*
+ * Checks the hash settings of a hash table snapshot: a capacity usable with the hash
+ * function kind the table was saved with (64 bit tables use power of two capacities),
+ * and that function given.
+ * Note: Private function.
+ * */
+int hashtable_snapshot_ok( const struct snapshot_fileheader* h, hashtable_hashfunc hashfunc,
+						   hashtable_hashfunc64 hashfunc64 )
+{
+	if (h->flags & SNAPSHOT_FLAG_HASH64)
+		return (hashfunc64 != NULL) && (h->capacity >= 2) && ((h->capacity & (h->capacity - 1)) == 0);
+	else
+		return (hashfunc != NULL) && (h->capacity >= 1);
+}
+
+/*
+ * Loads a hash table saved with 'hashtable_save', with the capacity and settings
+ * of the saved table. Pairs are decoded in one sequential pass and linked to their
+ * bucket by the saved hash: no rehash, duplicate check or resize. If the saved hash
+ * of the first key is not the hash of 'hashfunc' (or 'hashfunc64', tables saved with a
+ * 64 bit hash function) all keys are hashed again.
+ * Decoded keys and values belong to the table: 'freedatafunc' releases them with
+ * their pair (see hashtable_create).
+ * Returns the new hash table or NULL if the file can not be read or is not a valid
+ * hash table snapshot.
+ * */
+struct hashtable* hashtable_load( const char* path, const struct snapshot_codec* codec,
+								  hashtable_hashfunc hashfunc,
+								  hashtable_hashfunc64 hashfunc64,
+								  hashtable_isequal isequalfunc,
+								  hashtable_printitem printitemfunc,
+								  hashtable_freedata freedatafunc )
+{
+	struct snapshot_image img;
+	if (!snapshot_image_open(&img, path, SNAPSHOT_MAGIC_HASHTABLE, 1))
+		return NULL;
+
+	const struct snapshot_fileheader* h = img.header;
+	int hash64 = ((h->flags & SNAPSHOT_FLAG_HASH64) != 0);
+	struct hashtable* result = NULL;
+	if (hashtable_snapshot_ok(h, hashfunc, hashfunc64))
+		result = hashtable_create_exact( h->capacity, h->loadfactor,
+										 hash64 ? NULL : hashfunc, hash64 ? hashfunc64 : NULL,
+										 isequalfunc, printitemfunc, freedatafunc, NULL );
+	if (result == NULL) {
+		snapshot_image_close(&img);
+		return NULL;
+	}
+
+	result->resizefactor = h->resizefactor;
+	result->incremental = ((h->flags & SNAPSHOT_FLAG_INCREMENTAL) != 0);
+
+	int rehash = -1;	// decided with the first key
+	uint64_t pos = h->recordspos;
+	for (uint64_t i = 0; i < h->count; ++i) {
+		const struct snapshot_record* rec = snapshot_image_record(&img, pos);
+		if (rec == NULL) {
+			hashtable_destroy(result);		// corrupt file
+			snapshot_image_close(&img);
+			return NULL;
+		}
+
+		void* key = codec->decodekey(rec->data, rec->keysize, codec->arg);
+		void* value = ((codec->decodevalue != NULL) && (h->flags & SNAPSHOT_FLAG_VALUES))
+					  ? codec->decodevalue(snapshot_record_value(rec), rec->valuesize, codec->arg) : NULL;
+
+		if (rehash < 0)
+			rehash = (hashtable_hashkey(result, key) != rec->hash);
+
+		if (rehash)
+			hashtable_put(result, key, value);
+		else {
+			hashtable_insert_on_array( hashtable_bucket_index(result, rec->hash, result->capacity),
+									   result->isequal, result->freedata, result->nodepool,
+									   result->harray, key, value, rec->hash );
+			result->count++;
+		}
+
+		pos = snapshot_record_next(rec, pos);
+	}
+
+	snapshot_image_close(&img);
+	return result;
+}
+
+/*
+ * Opens a read only view of a hash table snapshot: the file is mapped and lookups
+ * read the records of one bucket in place (pages are loaded on first access), so
+ * no table is built. Keys are matched by their encoding (codec->encodekey).
+ * Returns the view or NULL if the file can not be mapped or is not a valid hash
+ * table snapshot.
+ * */
+struct hashtable_view* hashtable_view_open( const char* path, const struct snapshot_codec* codec,
+											hashtable_hashfunc hashfunc,
+											hashtable_hashfunc64 hashfunc64 )
+{
+	struct hashtable_view* view = (struct hashtable_view*)calloc(1, sizeof(struct hashtable_view));
+	if (view == NULL)
+		return NULL;
+
+	if (!snapshot_image_open(&(view->image), path, SNAPSHOT_MAGIC_HASHTABLE, 0)) {
+		free(view);
+		return NULL;
+	}
+
+	const struct snapshot_fileheader* h = view->image.header;
+	int hash64 = ((h->flags & SNAPSHOT_FLAG_HASH64) != 0);
+	if ((h->indexpos == 0) || !hashtable_snapshot_ok(h, hashfunc, hashfunc64)) {
+		hashtable_view_close(view);
+		return NULL;
+	}
+
+	view->index = (const uint64_t*)(view->image.data + h->indexpos);
+	view->count = h->count;
+	view->capacity = h->capacity;
+	view->shape.hashfunc = hash64 ? NULL : hashfunc;
+	view->shape.hashfunc64 = hash64 ? hashfunc64 : NULL;
+	view->shape.capacity = h->capacity;
+	view->codec = *codec;
+	return view;
+}
+
+/*
+ * Gets the encoded value (in the mapping) of a given key, 'valuesize' receives its
+ * size (if not NULL).
+ * Returns pointer to the encoded value if succeeded, NULL otherwise.
+ * */
+const void* hashtable_view_get(const struct hashtable_view* view, const void* key, size_t* valuesize)
+{
+	unsigned char small[SNAPSHOT_FILE_ALIGN * 16];
+	unsigned char* encoded = small;
+	size_t size = view->codec.encodekey(key, small, sizeof(small), view->codec.arg);
+	if (size > sizeof(small)) {
+		encoded = (unsigned char*)malloc(size);
+		if (encoded == NULL) {
+			printf("Memory error: failed to allocate memory for encoded key!");
+			abort();
+		}
+
+		view->codec.encodekey(key, encoded, size, view->codec.arg);
+	}
+
+	uint64_t hash = hashtable_hashkey(&(view->shape), key);
+	size_t bucket = hashtable_bucket_index(&(view->shape), hash, view->capacity);
+	const void* result = NULL;
+
+	for (uint64_t pos = view->index[bucket]; pos < view->index[bucket + 1]; ) {
+		const struct snapshot_record* rec = snapshot_image_record(&(view->image), pos);
+		if (rec == NULL)
+			break;		// corrupt file
+
+		if ((rec->hash == hash) && (rec->keysize == size) && (memcmp(rec->data, encoded, size) == 0)) {
+			result = snapshot_record_value(rec);
+			if (valuesize != NULL)
+				*valuesize = rec->valuesize;
+			break;
+		}
+
+		pos = snapshot_record_next(rec, pos);
+	}
+
+	if (encoded != small)
+		free(encoded);
+
+	return result;
+}
+
+/*
+ * Unmaps the snapshot and releases the view from memory.
+ * */
+void hashtable_view_close(struct hashtable_view* view)
+{
+	snapshot_image_close(&(view->image));
+	free(view);
+}
+
+/*
+ * Adds the chain lengths of the buckets [from, capacity) of a hash array to a snapshot.
+ * Note: Private function.
+ * */
+void hashtable_stats_buckets( struct linkedlist** arr, size_t from, size_t capacity,
+							  struct hashtable_stats* stats )
+{
+	for (size_t i = from; i < capacity; ++i) {
+		size_t length = (arr[i] == NULL) ? 0 : arr[i]->size;
+		datastats_histogram_add(&(stats->chains), length);
+		stats->usedbuckets += (length > 0);
+	}
+}
+
+/*
+ * Takes a statistics snapshot of the hash table: histogram of the chain length of
+ * every bucket (buckets of an ongoing incremental resize included) and the event
+ * counters, if compiled in.
+ * */
+void hashtable_stats(const struct hashtable* htable, struct hashtable_stats* stats)
+{
+	*stats = (struct hashtable_stats){ 0 };
+	stats->count = htable->count;
+	stats->capacity = htable->capacity;
+	stats->loadfactor = (htable->capacity > 0) ? (double)htable->count / (double)htable->capacity : 0.0;
+
+	hashtable_stats_buckets(htable->harray, 0, htable->capacity, stats);
+	if (htable->oldarray != NULL)
+		hashtable_stats_buckets(htable->oldarray, htable->migrateindex, htable->oldcapacity, stats);
+
+	stats->countersenabled = DATASTATS_ENABLED;
+	stats->counters = htable->counters;
+}
+
+/*
+ * Converts a statistics snapshot to a metric list (see datastats_print and
+ * datastats_export). 'metrics' must have room for DATASTATS_MAX_METRICS entries.
+ * Returns the number of metrics.
+ * */
+size_t hashtable_stats_metrics(const struct hashtable_stats* stats, struct datastats_metric* metrics)
+{
+	size_t n = 0;
+	metrics[n++] = (struct datastats_metric){ "count", (double)stats->count, NULL };
+	metrics[n++] = (struct datastats_metric){ "capacity", (double)stats->capacity, NULL };
+	metrics[n++] = (struct datastats_metric){ "load_factor", stats->loadfactor, NULL };
+	metrics[n++] = (struct datastats_metric){ "used_buckets", (double)stats->usedbuckets, NULL };
+	metrics[n++] = (struct datastats_metric){ "chain_length", 0, &(stats->chains) };
+
+	if (stats->countersenabled) {
+		metrics[n++] = (struct datastats_metric){ "puts", (double)stats->counters.puts, NULL };
+		metrics[n++] = (struct datastats_metric){ "collisions", (double)stats->counters.collisions, NULL };
+		metrics[n++] = (struct datastats_metric){ "resizes", (double)stats->counters.resizes, NULL };
+		metrics[n++] = (struct datastats_metric){ "resize_seconds", stats->counters.resizens / 1e9, NULL };
+	}
+
+	return n;
+}
+
 /*
  * Shallow copies all keys from the hashtable to an array.
  * You have to free result array from memory later in your code.
+ * Note: to only walk the keys use hashtable_iter_begin (no copy).
  */
 void** hashtable_keys(struct hashtable* htable)
 {
+	hashtable_finish_resize(htable);
+
 	void** result = NULL;
 
 	if (htable->count > 0)
@@ -510,9 +1085,12 @@ void** hashtable_keys(struct hashtable* htable)
 /*
  * Shallow copies all key/value pairs from the hashtable to an array.
  * You have to free result array from memory later in your code.
+ * Note: to only walk the pairs use hashtable_iter_begin (no copy).
  */
 struct hashtable_keyvalue_pair** hashtable_toarray(struct hashtable* htable)
 {
+	hashtable_finish_resize(htable);
+
 	struct hashtable_keyvalue_pair** result = NULL;
 
 	if (htable->count > 0)
@@ -543,11 +1121,161 @@ struct hashtable_keyvalue_pair** hashtable_toarray(struct hashtable* htable)
 	return result;
 }
 
+/*
+ * Sets the bucket range of the share of an iteration in a hash array: buckets
+ * [from, capacity) split in 'nchunks' ranges.
+ * Note: Private function.
+ * */
+void hashtable_iter_range( struct hashtable_iter* it, struct linkedlist** array,
+						   size_t from, size_t capacity )
+{
+	size_t len = capacity - from;
+	it->array = array;
+	it->bucket = from + (len * it->chunk) / it->nchunks;
+	it->end = from + (len * (it->chunk + 1)) / it->nchunks;
+}
+
+/*
+ * Moves an iteration to the first node of the next non empty bucket, from the
+ * current hash array to the not yet migrated buckets of the old one.
+ * Returns the key/value pair of the node, NULL if there are no more pairs.
+ * Note: Private function.
+ * */
+struct hashtable_keyvalue_pair* hashtable_iter_advance(struct hashtable_iter* it)
+{
+	const struct hashtable* htable = it->htable;
+
+	while (it->node == NULL) {
+		if (it->bucket < it->end) {
+			struct linkedlist* list = it->array[it->bucket++];
+			if ((list != NULL) && (list->size > 0))
+				it->node = linkedlist_getfirst(list);
+		}
+		else if ((it->array == htable->harray) && (htable->oldarray != NULL))
+			hashtable_iter_range(it, htable->oldarray, htable->migrateindex, htable->oldcapacity);
+		else
+			return NULL;	// all buckets walked
+	}
+
+	return (struct hashtable_keyvalue_pair*)it->node->data;
+}
+
+/*
+ * Starts an iteration over the share 'chunk' (0..nchunks - 1) of the buckets of the
+ * hash table. The 'nchunks' iterations together visit every pair once, so they can
+ * run on different threads.
+ * Returns the first key/value pair of the chunk, NULL if it is empty.
+ * */
+struct hashtable_keyvalue_pair* hashtable_iter_chunk(const struct hashtable* htable, size_t chunk,
+													 size_t nchunks, struct hashtable_iter* it)
+{
+	assert(chunk < nchunks);
+
+	it->htable = htable;
+	it->node = NULL;
+	it->chunk = chunk;
+	it->nchunks = nchunks;
+	hashtable_iter_range(it, htable->harray, 0, htable->capacity);
+	return hashtable_iter_advance(it);
+}
+
+/*
+ * Starts an iteration over the key/value pairs of the hash table, walking the
+ * buckets in place (pairs of an ongoing incremental resize included).
+ * Returns the first key/value pair, NULL if the table is empty.
+ * Note: the table must not be changed while iterating.
+ * */
+struct hashtable_keyvalue_pair* hashtable_iter_begin(const struct hashtable* htable,
+													 struct hashtable_iter* it)
+{
+	return hashtable_iter_chunk(htable, 0, 1, it);
+}
+
+/*
+ * Moves an iteration to the next key/value pair.
+ * Returns the key/value pair, NULL if there are no more pairs.
+ * */
+struct hashtable_keyvalue_pair* hashtable_iter_next(struct hashtable_iter* it)
+{
+	if (it->node == NULL)
+		return NULL;
+
+	it->node = it->node->next;
+	return hashtable_iter_advance(it);
+}
+
+/*
+ * Calls 'visit' for every key/value pair of the hash table (worker 0), in bucket order.
+ * Note: the table must not be changed during the traversal.
+ * */
+void hashtable_foreach(const struct hashtable* htable, hashtable_visitfunc visit, void* arg)
+{
+	struct hashtable_iter it;
+	for (struct hashtable_keyvalue_pair* kvp = hashtable_iter_begin(htable, &it);
+		 kvp != NULL; kvp = hashtable_iter_next(&it))
+		visit(kvp, 0, arg);
+}
+
+// state of a parallel traversal
+struct hashtable_parallel_state {
+	const struct hashtable* htable;
+	size_t nchunks;
+	hashtable_visitfunc visit;
+	void* arg;
+};
+
+/*
+ * Work item of a parallel traversal: visits the pairs of one bucket range (items are
+ * chunk numbers + 1, work items can't be NULL).
+ * Note: Private function.
+ * */
+void hashtable_parallel_task(struct taskpool* pool, void* item, int worker, void* arg)
+{
+	struct hashtable_parallel_state* st = (struct hashtable_parallel_state*)arg;
+	struct hashtable_iter it;
+	size_t chunk = (size_t)(uintptr_t)item - 1;
+
+	for (struct hashtable_keyvalue_pair* kvp = hashtable_iter_chunk(st->htable, chunk, st->nchunks, &it);
+		 kvp != NULL; kvp = hashtable_iter_next(&it))
+		st->visit(kvp, worker, st->arg);
+}
+
+/*
+ * Calls 'visit' for every key/value pair of the hash table, in any order and
+ * concurrently on the threads of 'pool'. The buckets are split in 'nchunks' ranges
+ * (0: 8 per thread) walked as work items (see hashtable_iter_chunk), so scans and
+ * aggregations (one accumulator per worker) need no copy of the table.
+ * Note: the table must not be changed during the traversal.
+ * */
+void hashtable_parallel_foreach(struct taskpool* pool, const struct hashtable* htable,
+								size_t nchunks, hashtable_visitfunc visit, void* arg)
+{
+	if (nchunks == 0)
+		nchunks = 8 * (size_t)taskpool_getthreads(pool);
+	if (nchunks > htable->capacity)
+		nchunks = htable->capacity;
+
+	void** items = (void**)malloc(nchunks * sizeof(void*));
+	if (items == NULL) {
+		printf("Memory error: failed to allocate memory for parallel traversal!\n");
+		abort();
+	}
+
+	for (size_t i = 0; i < nchunks; ++i)
+		items[i] = (void*)(uintptr_t)(i + 1);
+
+	struct hashtable_parallel_state st = { htable, nchunks, visit, arg };
+	taskpool_run(pool, hashtable_parallel_task, &st, items, nchunks);
+	free(items);
+}
+
 /*
  * Removes all elements from the hashtable.
  * */
 void hashtable_clear(struct hashtable* htable)
 {
+	hashtable_finish_resize(htable);
+
 	int size = htable->capacity;
 	struct linkedlist* list = NULL;
 
@@ -567,6 +1295,8 @@ void hashtable_clear(struct hashtable* htable)
  * */
 void hashtable_destroy(struct hashtable* htable)
 {
+	hashtable_finish_resize(htable);
+
 	struct linkedlist* list = NULL;
 	struct linkedlistnode* node = NULL;
 
@@ -584,12 +1314,14 @@ void hashtable_destroy(struct hashtable* htable)
 				node = node->next;
 			}
 
+			list->freedata = NULL;	// already released above
 			linkedlist_destroy(list);
 		}
 	}
 
-	free(htable->harray);
-	free(htable);
+	linkedlist_nodepool_destroy(htable->nodepool);	// releases all nodes in O(slabs)
+	allocator_free(htable->allocator, htable->harray, htable->capacity * sizeof(struct linkedlist*));
+	allocator_free(htable->allocator, htable, sizeof(*htable));
 }
 
 
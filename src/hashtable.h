@@ -29,6 +29,11 @@
  *  elements are stored in the same index by using a linked list.
  *  If j is the slot for multiple elements, it contains a pointer to the head of the list
  *  of elements. If no element is present, j contains NIL.
+ *  All bucket lists take their nodes from one node pool owned by the table, so
+ *  put/remove churn reuses pool nodes instead of calling malloc/free.
+ *  A table created with hashtable_create_allocator takes its structure, hash arrays,
+ *  bucket lists and pool slabs from the given allocator (see allocator.h); key/value
+ *  pairs stay on malloc, as they are released by the user 'freedata' function.
  *--------------------------------------------
  *
  *  Hashing
@@ -44,29 +49,75 @@
 	#define HASHTABLE_H_
 
 	#include <stdlib.h>
+	#include <stdint.h>
 	#include "linkedlist.h"
+	#include "datastats.h"
+	#include "snapshot.h"
+	#include "allocator.h"
 
 	#define HASHTABLE_DEFAULT_CAPACITY 16
 	#define HASHTABLE_DEFAULT_LOAD_FACTOR 0.75
 	#define HASHTABLE_MIN_SIZE 10
 	#define HASHTABLE_RESIZE_FACTOR 2.0
+	#define HASHTABLE_FIBONACCI_MULT 0x9E3779B97F4A7C15ULL	// 2^64 / golden ratio (64 bit hash tables)
+	#define HASHTABLE_BATCH_CHUNK 16		// keys hashed and prefetched together by batch operations
+	#define HASHTABLE_MIGRATE_STEP 4		// buckets moved per operation during an incremental resize
+	#define HASHTABLE_NODEPOOL_SLAB 256		// bucket list nodes allocated at once
 
 	// key/value pair type
 	struct hashtable_keyvalue_pair {
 		void* key;
 		void* value;
+		uint64_t hash;				// memoized key hash (skips rehashing and most 'isequal' calls)
 	};
 
 	typedef void (*hashtable_freedata)(void* data);
 	typedef int (*hashtable_isequal)(const void* key1, const void* key2);
 	typedef int (*hashtable_hashfunc)(const void* key);
+	typedef uint64_t (*hashtable_hashfunc64)(const void* key);
 	typedef void (*hashtable_printitem)(const struct hashtable_keyvalue_pair* kvp);
+	// callback of foreach traversals ('worker' is the index of the running thread, 0 if sequential)
+	typedef void (*hashtable_visitfunc)(struct hashtable_keyvalue_pair* kvp, int worker, void* arg);
+
+	struct taskpool;	// work-stealing thread pool (see taskpool.h)
+
+	// event counters (only updated when built with CDATASTRUCT_STATS, see datastats.h)
+	struct hashtable_counters {
+		size_t puts;									// inserted key/value pairs
+		size_t collisions;								// pairs inserted in a non empty bucket
+		size_t resizes;									// hash array reallocations
+		uint64_t resizens;								// time spent resizing (ns, incremental migration included)
+	};
+
+	// statistics snapshot of a hash table (see hashtable_stats)
+	struct hashtable_stats {
+		size_t count;
+		size_t capacity;
+		double loadfactor;								// count / capacity
+		size_t usedbuckets;								// non empty buckets
+		struct datastats_histogram chains;				// chain length of every bucket (empty ones included)
+		int countersenabled;							// counters below were compiled in
+		struct hashtable_counters counters;
+	};
+
+	// cursor over the key/value pairs of a hash table, buckets are walked in place
+	// (see hashtable_iter_begin)
+	struct hashtable_iter {
+		const struct hashtable* htable;
+		struct linkedlist** array;						// hash array being walked
+		struct linkedlistnode* node;					// current node (NULL at the end)
+		size_t bucket;									// next bucket to walk
+		size_t end;										// end of the bucket range of 'array'
+		size_t chunk;									// bucket range share (chunk of 'nchunks')
+		size_t nchunks;
+	};
 
 	// hash table type
 	struct hashtable {
 		size_t count;									// number of elements in the hashtable
 		size_t capacity;								// size of hash array
 		hashtable_hashfunc hashfunc;					// hash function
+		hashtable_hashfunc64 hashfunc64;				// 64 bit hash function (power of two capacity, NULL if unused)
 		hashtable_isequal isequal;						// key compare for equality function
 		hashtable_freedata freedata;					// release key/value pair from memory
 		hashtable_printitem printitem;					// prints key/value pair
@@ -74,6 +125,23 @@
 		float loadfactor;								// fraction of hash array filled to generate a reallocation
 		float resizefactor;								// to compute new hash array size for reallocation (new_size = resizefactor * capacity)
 		struct linkedlist** harray;						// hash array
+		int incremental;								// resize incrementally (1) or at once (0)
+		struct linkedlist** oldarray;					// hash array being migrated (NULL if no resize in progress)
+		size_t oldcapacity;								// size of old hash array
+		size_t migrateindex;							// next old array bucket to migrate
+		struct linkedlist_nodepool* nodepool;			// list nodes pool shared by all buckets
+		struct hashtable_counters counters;				// event counters (see datastats.h)
+		const struct allocator* allocator;				// allocator of table, arrays and buckets (NULL: C library)
+	};
+
+	// read only view of a hash table snapshot (see hashtable_view_open)
+	struct hashtable_view {
+		struct snapshot_image image;					// mapped snapshot file
+		const uint64_t* index;							// offset of the first record of each bucket
+		size_t count;									// number of key/value pairs
+		size_t capacity;								// number of buckets
+		struct hashtable shape;							// hash settings of the saved table (no buckets)
+		struct snapshot_codec codec;
 	};
 
 	/*
@@ -93,6 +161,42 @@
 										hashtable_printitem printitemfunc,
 										hashtable_freedata freedatafunc );
 
+	/*
+	 * Creates a new hash table with given initial size and load factor, whose structure,
+	 * hash arrays, bucket lists and list nodes are allocated by 'allocator' (see
+	 * allocator.h, NULL: C library).
+	 * Note: key/value pairs are still allocated with malloc (released by freedatafunc).
+	 * */
+	struct hashtable* hashtable_create_allocator( size_t size, float loadfactor, float resizefactor,
+												  hashtable_hashfunc hashfunc,
+												  hashtable_isequal isequalfunc,
+												  hashtable_printitem printitemfunc,
+												  hashtable_freedata freedatafunc,
+												  const struct allocator* allocator );
+
+	/*
+	 * Creates a new hash table using a 64 bit hash function, given initial size and load factor.
+	 * Capacity is rounded up to a power of two and buckets are selected with fibonacci
+	 * (multiply-shift) hashing, so no division or prime search is ever needed.
+	 * */
+	struct hashtable* hashtable_create64( size_t size, float loadfactor, float resizefactor,
+										  hashtable_hashfunc64 hashfunc64,
+										  hashtable_isequal isequalfunc,
+										  hashtable_printitem printitemfunc,
+										  hashtable_freedata freedatafunc );
+
+	/*
+	 * Creates a new hash table with incremental resize, given initial size and load factor.
+	 * When the threshold is reached the old and new hash arrays are kept side by side and
+	 * each later put/get/remove migrates at most HASHTABLE_MIGRATE_STEP buckets, so no
+	 * single operation pays for a full rehash.
+	 * */
+	struct hashtable* hashtable_create_incremental( size_t size, float loadfactor, float resizefactor,
+													hashtable_hashfunc hashfunc,
+													hashtable_isequal isequalfunc,
+													hashtable_printitem printitemfunc,
+													hashtable_freedata freedatafunc );
+
 	/*
 	 * Gets the value associated with given key.
 	 * Returns pointer to value if succeeded, NULL otherwise.
@@ -110,6 +214,29 @@
 	 * */
 	int hashtable_put( struct hashtable* htable, void* key, void* value );
 
+	/*
+	 * Gets the key/value pairs associated with an array of 'n' keys (batch version of
+	 * hashtable_get).
+	 * out_pairs[i] receives the key/value pair of keys[i] or NULL if key was not found.
+	 * Keys are hashed and their buckets prefetched in chunks before being resolved,
+	 * so memory accesses of different keys overlap.
+	 * */
+	void hashtable_find_batch(struct hashtable* htable, void** keys, size_t n,
+							  struct hashtable_keyvalue_pair** out_pairs);
+
+	/*
+	 * Gets the values associated with an array of 'n' keys.
+	 * out_values[i] receives the value of keys[i] (not the key/value pair) or NULL if
+	 * key was not found.
+	 * */
+	void hashtable_get_batch(struct hashtable* htable, void** keys, size_t n, void** out_values);
+
+	/*
+	 * Adds an array of 'n' key/value pairs to the hash table.
+	 * Returns the number of pairs inserted (duplicate keys are not inserted).
+	 * */
+	size_t hashtable_put_batch(struct hashtable* htable, void** keys, void** values, size_t n);
+
 	/*
 	 * Deletes the key/value pair from the hash table for a given key.
 	 * Returns removed key/value pair reference if succeeded, NULL otherwise.
@@ -120,20 +247,130 @@
 	/*
 	 * Shallow copies all keys from the hashtable to an array.
 	 * You have to free result array from memory later in your code.
+	 * Note: to only walk the keys use hashtable_iter_begin (no copy).
 	 */
 	void** hashtable_keys(struct hashtable* htable);
 
 	/*
 	 * Shallow copies all key/value pairs from the hashtable to an array.
 	 * You have to free result array from memory later in your code.
+	 * Note: to only walk the pairs use hashtable_iter_begin (no copy).
 	 */
 	struct hashtable_keyvalue_pair** hashtable_toarray(struct hashtable* htable);
 
+	/*
+	 * Starts an iteration over the key/value pairs of the hash table, walking the
+	 * buckets in place (pairs of an ongoing incremental resize included).
+	 * Returns the first key/value pair, NULL if the table is empty.
+	 * Usage:
+	 *   struct hashtable_iter it;
+	 *   for (struct hashtable_keyvalue_pair* kvp = hashtable_iter_begin(htable, &it);
+	 *        kvp != NULL; kvp = hashtable_iter_next(&it)) ...
+	 * Note: the table must not be changed while iterating.
+	 * */
+	struct hashtable_keyvalue_pair* hashtable_iter_begin(const struct hashtable* htable,
+														 struct hashtable_iter* it);
+
+	/*
+	 * Starts an iteration over the share 'chunk' (0..nchunks - 1) of the buckets of the
+	 * hash table. The 'nchunks' iterations together visit every pair once, so they can
+	 * run on different threads.
+	 * Returns the first key/value pair of the chunk, NULL if it is empty.
+	 * */
+	struct hashtable_keyvalue_pair* hashtable_iter_chunk(const struct hashtable* htable, size_t chunk,
+														 size_t nchunks, struct hashtable_iter* it);
+
+	/*
+	 * Moves an iteration to the next key/value pair.
+	 * Returns the key/value pair, NULL if there are no more pairs.
+	 * */
+	struct hashtable_keyvalue_pair* hashtable_iter_next(struct hashtable_iter* it);
+
+	/*
+	 * Calls 'visit' for every key/value pair of the hash table (worker 0), in bucket order.
+	 * Note: the table must not be changed during the traversal.
+	 * */
+	void hashtable_foreach(const struct hashtable* htable, hashtable_visitfunc visit, void* arg);
+
+	/*
+	 * Calls 'visit' for every key/value pair of the hash table, in any order and
+	 * concurrently on the threads of 'pool'. The buckets are split in 'nchunks' ranges
+	 * (0: 8 per thread) walked as work items (see hashtable_iter_chunk), so scans and
+	 * aggregations (one accumulator per worker) need no copy of the table.
+	 * Note: the table must not be changed during the traversal.
+	 * */
+	void hashtable_parallel_foreach(struct taskpool* pool, const struct hashtable* htable,
+									size_t nchunks, hashtable_visitfunc visit, void* arg);
+
 	/*
 	 * Prints the hashtable items.
 	 */
 	void hashtable_print(struct hashtable* htable);
 
+	/*
+	 * Saves the hash table to a snapshot file (see snapshot.h): one record per pair with
+	 * its memoized hash and the key and value written by 'codec' (values are not saved
+	 * if codec->encodevalue is NULL), grouped by bucket, then the offset of each bucket.
+	 * An incremental resize in progress is completed first.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 * */
+	int hashtable_save(struct hashtable* htable, const char* path, const struct snapshot_codec* codec);
+
+	/*
+	 * Loads a hash table saved with 'hashtable_save', with the capacity and settings
+	 * of the saved table. Pairs are decoded in one sequential pass and linked to their
+	 * bucket by the saved hash: no rehash, duplicate check or resize. If the saved hash
+	 * of the first key is not the hash of 'hashfunc' (or 'hashfunc64', tables saved with a
+	 * 64 bit hash function) all keys are hashed again.
+	 * Decoded keys and values belong to the table: 'freedatafunc' releases them with
+	 * their pair (see hashtable_create).
+	 * Returns the new hash table or NULL if the file can not be read or is not a valid
+	 * hash table snapshot.
+	 * */
+	struct hashtable* hashtable_load( const char* path, const struct snapshot_codec* codec,
+									  hashtable_hashfunc hashfunc,
+									  hashtable_hashfunc64 hashfunc64,
+									  hashtable_isequal isequalfunc,
+									  hashtable_printitem printitemfunc,
+									  hashtable_freedata freedatafunc );
+
+	/*
+	 * Opens a read only view of a hash table snapshot: the file is mapped and lookups
+	 * read the records of one bucket in place (pages are loaded on first access), so
+	 * no table is built. Keys are matched by their encoding (codec->encodekey).
+	 * Returns the view or NULL if the file can not be mapped or is not a valid hash
+	 * table snapshot.
+	 * */
+	struct hashtable_view* hashtable_view_open( const char* path, const struct snapshot_codec* codec,
+												hashtable_hashfunc hashfunc,
+												hashtable_hashfunc64 hashfunc64 );
+
+	/*
+	 * Gets the encoded value (in the mapping) of a given key, 'valuesize' receives its
+	 * size (if not NULL).
+	 * Returns pointer to the encoded value if succeeded, NULL otherwise.
+	 * */
+	const void* hashtable_view_get(const struct hashtable_view* view, const void* key, size_t* valuesize);
+
+	/*
+	 * Unmaps the snapshot and releases the view from memory.
+	 * */
+	void hashtable_view_close(struct hashtable_view* view);
+
+	/*
+	 * Takes a statistics snapshot of the hash table: histogram of the chain length of
+	 * every bucket (buckets of an ongoing incremental resize included) and the event
+	 * counters, if compiled in.
+	 * */
+	void hashtable_stats(const struct hashtable* htable, struct hashtable_stats* stats);
+
+	/*
+	 * Converts a statistics snapshot to a metric list (see datastats_print and
+	 * datastats_export). 'metrics' must have room for DATASTATS_MAX_METRICS entries.
+	 * Returns the number of metrics.
+	 * */
+	size_t hashtable_stats_metrics(const struct hashtable_stats* stats, struct datastats_metric* metrics);
+
 	/*
 	 * Removes all elements from the hashtable.
 	 * */
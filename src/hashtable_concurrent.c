@@ -0,0 +1,306 @@
+/********************************************************************************
+ * hashtable_concurrent.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements a thread safe hash table in C by sharding the key space
+ *  			across independently locked hash tables.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Each shard is a chained hash table (hashtable.h) guarded by a pthread
+ *  reader-writer lock. Shard = top bits of (hash * 2^64/phi).
+ *
+ *  Source: https://en.wikipedia.org/wiki/Lock_striping
+ *
+ ***************************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "hashtable_concurrent.h"
+#include "numanode.h"
+
+/*
+ * Creates a new concurrent hash table with default settings
+ * (64 shards, LF = 0.75).
+ * */
+struct hashtable_concurrent* hashtable_concurrent_create_default( hashtable_hashfunc hashfunc,
+																  hashtable_isequal isequalfunc,
+																  hashtable_printitem printitemfunc,
+																  hashtable_freedata freedatafunc )
+{
+	return hashtable_concurrent_create( HASHTABLE_CONCURRENT_DEFAULT_SHARDS,
+										HASHTABLE_CONCURRENT_DEFAULT_SHARDS * HASHTABLE_DEFAULT_CAPACITY,
+										HASHTABLE_DEFAULT_LOAD_FACTOR,
+										hashfunc, isequalfunc,
+										printitemfunc, freedatafunc );
+}
+
+/*
+ * Creates a new concurrent hash table, shards placed on NUMA nodes if 'numa' is '1'.
+ * Note: Private function.
+ * */
+struct hashtable_concurrent* hashtable_concurrent_create_with( size_t nshards, size_t size,
+															   float loadfactor,
+															   hashtable_hashfunc hashfunc,
+															   hashtable_isequal isequalfunc,
+															   hashtable_printitem printitemfunc,
+															   hashtable_freedata freedatafunc,
+															   int numa )
+{
+	assert(nshards > 0);
+
+	struct hashtable_concurrent* result = malloc(sizeof(*result));
+
+	if (result == NULL)
+		return result;
+	else {
+		int numnodes = numa ? numanode_getcount() : 1;
+		if (nshards < (size_t)numnodes)
+			nshards = numnodes;	// every node owns a shard
+
+		result->nshards = 1;
+		result->shardbits = 0;
+		while (result->nshards < nshards) {
+			result->nshards <<= 1;
+			result->shardbits++;
+		}
+
+		size_t arraysize = result->nshards * sizeof(struct hashtable_concurrent_shard);
+		if (numa)
+			// page aligned, so the shards of each node can be bound to it
+			result->shards = (struct hashtable_concurrent_shard*)numanode_alloc(arraysize, 0);
+		else
+			result->shards = (struct hashtable_concurrent_shard*)aligned_alloc( HASHTABLE_CONCURRENT_CACHE_LINE,
+																				arraysize );
+		if (result->shards == NULL) {
+			printf("Memory error: failed to allocate memory for hashtable shards!");
+			abort();
+		}
+
+		result->numa = numa;
+		size_t shardsize = size / result->nshards;
+		if (shardsize <= HASHTABLE_MIN_SIZE)
+			shardsize = HASHTABLE_MIN_SIZE + 1;
+
+		for (size_t i = 0; i < result->nshards; ++i) {
+			struct hashtable_concurrent_shard* shard = &(result->shards[i]);
+			shard->node = numa ? numanode_of_part((int)i, (int)result->nshards) : 0;
+			shard->region = NULL;
+			if (numa) {
+				if ((i == 0) || (shard->node != result->shards[i - 1].node)) {
+					// first shard of a node: bind the range of shards of the node
+					size_t last = i;
+					while ((last + 1 < result->nshards)
+						   && (numanode_of_part((int)(last + 1), (int)result->nshards) == shard->node))
+						last++;
+
+					numanode_bind(shard, (last - i + 1) * sizeof(*shard), shard->node);
+				}
+
+				shard->region = allocator_region_create( HASHTABLE_CONCURRENT_NUMA_BLOCK,
+														 numanode_allocator(shard->node) );
+				if (shard->region == NULL) {
+					printf("Memory error: failed to allocate memory for hashtable shard region!");
+					abort();
+				}
+			}
+
+			if (pthread_rwlock_init(&(shard->lock), NULL) != 0) {
+				printf("Error: failed to initialize hashtable shard lock!");
+				abort();
+			}
+
+			shard->htable = hashtable_create_allocator( shardsize, loadfactor, HASHTABLE_RESIZE_FACTOR,
+														hashfunc, isequalfunc, printitemfunc, freedatafunc,
+														numa ? allocator_region_get(shard->region) : NULL );
+			if (shard->htable == NULL) {
+				printf("Memory error: failed to allocate memory for hashtable shard!");
+				abort();
+			}
+		}
+
+		result->hashfunc = hashfunc;
+		result->printitem = printitemfunc;
+	}
+
+	return result;
+}
+
+/*
+ * Creates a new concurrent hash table with a given number of shards (rounded up
+ * to a power of two) and initial total size.
+ * */
+struct hashtable_concurrent* hashtable_concurrent_create( size_t nshards, size_t size,
+														  float loadfactor,
+														  hashtable_hashfunc hashfunc,
+														  hashtable_isequal isequalfunc,
+														  hashtable_printitem printitemfunc,
+														  hashtable_freedata freedatafunc )
+{
+	return hashtable_concurrent_create_with( nshards, size, loadfactor, hashfunc, isequalfunc,
+											 printitemfunc, freedatafunc, 0 );
+}
+
+/*
+ * Creates a new concurrent hash table partitioned on the NUMA nodes: shards are
+ * split in one range per node and allocated on it (see implementation notes).
+ * Number of shards is rounded up to a power of two, at least the number of nodes.
+ * */
+struct hashtable_concurrent* hashtable_concurrent_create_numa( size_t nshards, size_t size,
+															   float loadfactor,
+															   hashtable_hashfunc hashfunc,
+															   hashtable_isequal isequalfunc,
+															   hashtable_printitem printitemfunc,
+															   hashtable_freedata freedatafunc )
+{
+	return hashtable_concurrent_create_with( nshards, size, loadfactor, hashfunc, isequalfunc,
+											 printitemfunc, freedatafunc, 1 );
+}
+
+/*
+ * Gets the shard of a given key.
+ * */
+struct hashtable_concurrent_shard* hashtable_concurrent_shard_of( const struct hashtable_concurrent* htable,
+																  const void* key )
+{
+	if (htable->shardbits == 0)
+		return &(htable->shards[0]);
+
+	uint64_t hash = (uint64_t)(int64_t)htable->hashfunc(key) * HASHTABLE_FIBONACCI_MULT;
+	return &(htable->shards[hash >> (64 - htable->shardbits)]);
+}
+
+/*
+ * Gets the home NUMA node of a given key (node of its shard, 0 if table is not NUMA
+ * partitioned).
+ * */
+int hashtable_concurrent_getnode(const struct hashtable_concurrent* htable, const void* key)
+{
+	return hashtable_concurrent_shard_of(htable, key)->node;
+}
+
+/*
+ * Gets the number of elements in the hash table.
+ * Note: with concurrent writers is only a snapshot.
+ * */
+size_t hashtable_concurrent_count(struct hashtable_concurrent* htable)
+{
+	size_t result = 0;
+
+	for (size_t i = 0; i < htable->nshards; ++i) {
+		pthread_rwlock_rdlock(&(htable->shards[i].lock));
+		result += htable->shards[i].htable->count;
+		pthread_rwlock_unlock(&(htable->shards[i].lock));
+	}
+
+	return result;
+}
+
+/*
+ * Checks if the hash table contains a given key.
+ * Returns '1' (true) if succeeded, '0' (false) otherwise.
+ * */
+int hashtable_concurrent_contains(struct hashtable_concurrent* htable, const void* key)
+{
+	struct hashtable_concurrent_shard* shard = hashtable_concurrent_shard_of(htable, key);
+
+	pthread_rwlock_rdlock(&(shard->lock));
+	int result = (hashtable_get(shard->htable, key) != NULL);
+	pthread_rwlock_unlock(&(shard->lock));
+
+	return result;
+}
+
+/*
+ * Gets the value associated with given key.
+ * Returns pointer to value if succeeded, NULL otherwise.
+ * */
+void* hashtable_concurrent_get(struct hashtable_concurrent* htable, const void* key)
+{
+	struct hashtable_concurrent_shard* shard = hashtable_concurrent_shard_of(htable, key);
+	void* result = NULL;
+
+	pthread_rwlock_rdlock(&(shard->lock));
+	// copy value while locked, the key/value pair may be removed right after unlock
+	struct hashtable_keyvalue_pair* kvp = (struct hashtable_keyvalue_pair*)hashtable_get(shard->htable, key);
+	if (kvp != NULL)
+		result = kvp->value;
+	pthread_rwlock_unlock(&(shard->lock));
+
+	return result;
+}
+
+/*
+ * Adds the key/value to the hash table.
+ * Returns 1 if succeeded, 0 otherwise (key already exists).
+ * */
+int hashtable_concurrent_put(struct hashtable_concurrent* htable, void* key, void* value)
+{
+	struct hashtable_concurrent_shard* shard = hashtable_concurrent_shard_of(htable, key);
+	int result = 0;
+
+	pthread_rwlock_wrlock(&(shard->lock));
+	if (hashtable_get(shard->htable, key) == NULL)
+		result = hashtable_put(shard->htable, key, value);
+	pthread_rwlock_unlock(&(shard->lock));
+
+	return result;
+}
+
+/*
+ * Deletes the key/value pair from the hash table for a given key.
+ * Returns removed key/value pair if succeeded, NULL otherwise.
+ * */
+struct hashtable_keyvalue_pair* hashtable_concurrent_remove(struct hashtable_concurrent* htable, const void* key)
+{
+	struct hashtable_concurrent_shard* shard = hashtable_concurrent_shard_of(htable, key);
+
+	pthread_rwlock_wrlock(&(shard->lock));
+	struct hashtable_keyvalue_pair* result = hashtable_remove(shard->htable, key);
+	pthread_rwlock_unlock(&(shard->lock));
+
+	return result;
+}
+
+/*
+ * Prints the hashtable items, shard by shard.
+ */
+void hashtable_concurrent_print(struct hashtable_concurrent* htable)
+{
+	if (!(htable->printitem)) {
+		printf("Error: 'printitem' function is undefined.");
+		abort();
+	}
+
+	for (size_t i = 0; i < htable->nshards; ++i) {
+		pthread_rwlock_rdlock(&(htable->shards[i].lock));
+		printf("Shard %zu:\n", i);
+		hashtable_print(htable->shards[i].htable);
+		pthread_rwlock_unlock(&(htable->shards[i].lock));
+	}
+}
+
+/*
+ * Releases the hash table from memory.
+ * */
+void hashtable_concurrent_destroy(struct hashtable_concurrent* htable)
+{
+	for (size_t i = 0; i < htable->nshards; ++i) {
+		hashtable_destroy(htable->shards[i].htable);
+		pthread_rwlock_destroy(&(htable->shards[i].lock));
+		allocator_region_destroy(htable->shards[i].region);	// NULL if not NUMA
+	}
+
+	if (htable->numa)
+		numanode_free(htable->shards, htable->nshards * sizeof(struct hashtable_concurrent_shard));
+	else
+		free(htable->shards);
+	free(htable);
+}
@@ -0,0 +1,157 @@
+/*****************************************************************************
+ * hashtable_concurrent.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: Implements a thread safe hash table in C by sharding the key space
+ *  			 across independently locked hash tables.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A single lock around one hash table serializes every thread. Here the table is
+ *  split in N shards (N is a power of two), each one being a regular chained hash
+ *  table (see hashtable.h) protected by its own reader-writer lock.
+ *
+ *  The shard of a key is selected with the top bits of the mixed key hash, while
+ *  buckets inside a shard are selected with the low bits (modulo a prime), so both
+ *  levels stay well distributed.
+ *
+ *  	- get/contains take the shard lock for reading (many readers at once);
+ *  	- put/remove take the shard lock for writing.
+ *
+ *  Threads working on different shards never touch the same lock, so throughput
+ *  grows with the number of threads as long as N is well above the thread count.
+ *  Each shard is aligned to a cache line to avoid false sharing between locks.
+ *
+ *  Shards never resize incrementally (incremental resize moves buckets on reads,
+ *  which would not be safe under a read lock).
+ *
+ *  NUMA partitioned mode (hashtable_concurrent_create_numa)
+ *
+ *  	Shards are split in consecutive ranges, one per NUMA node (see numanode.h),
+ *  	so each node owns a range of the top bits of the key hashes. The locks of a
+ *  	range are bound to its node, and the hash arrays, bucket lists and list nodes
+ *  	of each shard come from a region allocator of node local blocks (the region
+ *  	is only used under the shard write lock). Workers pinned to a node
+ *  	(numanode_pin_thread) should take the keys whose hashtable_concurrent_getnode
+ *  	is their node, so lookups and inserts stay on local memory.
+ *  	Key/value pairs are allocated by the inserting thread (malloc), so they are
+ *  	local when inserted by the home node workers.
+ *
+ *  Source: https://en.wikipedia.org/wiki/Lock_striping
+ *
+ *******************************************************************************/
+
+#ifndef HASHTABLE_CONCURRENT_H_
+	#define HASHTABLE_CONCURRENT_H_
+
+	#include <stdlib.h>
+	#include <pthread.h>
+	#include "hashtable.h"
+	#include "allocator.h"
+
+	#define HASHTABLE_CONCURRENT_DEFAULT_SHARDS 64
+	#define HASHTABLE_CONCURRENT_CACHE_LINE 64
+	#define HASHTABLE_CONCURRENT_NUMA_BLOCK (256 * 1024)	// region block size of NUMA shards
+
+	// a shard: hash table and its lock
+	struct hashtable_concurrent_shard {
+		pthread_rwlock_t lock;								// reader-writer lock of the shard
+		struct hashtable* htable;							// shard hash table
+		int node;											// home NUMA node of the shard
+		struct allocator_region* region;					// node local memory of the shard (NULL if not NUMA)
+	} __attribute__((aligned(HASHTABLE_CONCURRENT_CACHE_LINE)));
+
+	// concurrent hash table type
+	struct hashtable_concurrent {
+		size_t nshards;										// number of shards (power of 2)
+		unsigned int shardbits;								// log2 of number of shards
+		hashtable_hashfunc hashfunc;						// hash function
+		hashtable_printitem printitem;						// prints key/value pair
+		struct hashtable_concurrent_shard* shards;			// shards array
+		int numa;											// '1' if shards are placed on NUMA nodes
+	};
+
+	/*
+	 * Creates a new concurrent hash table with default settings
+	 * (64 shards, LF = 0.75).
+	 * */
+	struct hashtable_concurrent* hashtable_concurrent_create_default( hashtable_hashfunc hashfunc,
+																	  hashtable_isequal isequalfunc,
+																	  hashtable_printitem printitemfunc,
+																	  hashtable_freedata freedatafunc );
+
+	/*
+	 * Creates a new concurrent hash table with a given number of shards (rounded up
+	 * to a power of two) and initial total size.
+	 * */
+	struct hashtable_concurrent* hashtable_concurrent_create( size_t nshards, size_t size,
+															  float loadfactor,
+															  hashtable_hashfunc hashfunc,
+															  hashtable_isequal isequalfunc,
+															  hashtable_printitem printitemfunc,
+															  hashtable_freedata freedatafunc );
+
+	/*
+	 * Creates a new concurrent hash table partitioned on the NUMA nodes: shards are
+	 * split in one range per node and allocated on it (see implementation notes).
+	 * Number of shards is rounded up to a power of two, at least the number of nodes.
+	 * */
+	struct hashtable_concurrent* hashtable_concurrent_create_numa( size_t nshards, size_t size,
+																   float loadfactor,
+																   hashtable_hashfunc hashfunc,
+																   hashtable_isequal isequalfunc,
+																   hashtable_printitem printitemfunc,
+																   hashtable_freedata freedatafunc );
+
+	/*
+	 * Gets the home NUMA node of a given key (node of its shard, 0 if table is not NUMA
+	 * partitioned).
+	 * */
+	int hashtable_concurrent_getnode(const struct hashtable_concurrent* htable, const void* key);
+
+	/*
+	 * Gets the number of elements in the hash table.
+	 * Note: with concurrent writers is only a snapshot.
+	 * */
+	size_t hashtable_concurrent_count(struct hashtable_concurrent* htable);
+
+	/*
+	 * Checks if the hash table contains a given key.
+	 * Returns '1' (true) if succeeded, '0' (false) otherwise.
+	 * */
+	int hashtable_concurrent_contains(struct hashtable_concurrent* htable, const void* key);
+
+	/*
+	 * Gets the value associated with given key.
+	 * Returns pointer to value if succeeded, NULL otherwise.
+	 * */
+	void* hashtable_concurrent_get(struct hashtable_concurrent* htable, const void* key);
+
+	/*
+	 * Adds the key/value to the hash table.
+	 * Returns 1 if succeeded, 0 otherwise (key already exists).
+	 * */
+	int hashtable_concurrent_put(struct hashtable_concurrent* htable, void* key, void* value);
+
+	/*
+	 * Deletes the key/value pair from the hash table for a given key.
+	 * Returns removed key/value pair if succeeded, NULL otherwise.
+	 * Note: returned pair must be released from memory by the caller.
+	 * */
+	struct hashtable_keyvalue_pair* hashtable_concurrent_remove(struct hashtable_concurrent* htable, const void* key);
+
+	/*
+	 * Prints the hashtable items, shard by shard.
+	 */
+	void hashtable_concurrent_print(struct hashtable_concurrent* htable);
+
+	/*
+	 * Releases the hash table from memory.
+	 * Note: no other thread may be using the table.
+	 * */
+	void hashtable_concurrent_destroy(struct hashtable_concurrent* htable);
+
+#endif /* HASHTABLE_CONCURRENT_H_ */
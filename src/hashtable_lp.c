@@ -44,6 +44,10 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <pthread.h>
 
 #include "hashtable_lp.h"
 
@@ -88,6 +92,53 @@ int hashtable_lp_compute_threshold(size_t capacity, float loadfactor)
 	return (int)((float)capacity * loadfactor);
 }
 
+/*
+ * Gets the smallest power of two greater or equal than a given number.
+ */
+size_t hashtable_lp_next_pow2(size_t n)
+{
+	size_t result = 1;
+	while (result < n)
+		result <<= 1;
+
+	return result;
+}
+
+/*
+ * Computes the hash value of a key with the table hash function.
+ * */
+uint64_t hashtable_lp_hashkey(const struct hashtable_lp* htable, const void* key)
+{
+	if (htable->hashfunc64 != NULL)
+		return htable->hashfunc64(key);
+	else
+		return (uint64_t)(int64_t)htable->hashfunc(key);
+}
+
+/*
+ * Maps a hash value to the home slot of a hash array with given capacity.
+ * 64 bit hash tables use fibonacci hashing (top bits of hash * 2^64/phi), others
+ * use modulo of the (prime) capacity.
+ * */
+size_t hashtable_lp_slot_index(const struct hashtable_lp* htable, uint64_t hash, size_t capacity)
+{
+	if (htable->hashfunc64 != NULL)
+		return (size_t)((hash * HASHTABLE_LP_FIBONACCI_MULT) >> (64 - __builtin_ctzll(capacity)));
+	else
+		return hash % capacity;
+}
+
+/*
+ * Computes the hash array size for the next reallocation.
+ * */
+size_t hashtable_lp_next_capacity(const struct hashtable_lp* htable)
+{
+	if (htable->hashfunc64 != NULL)
+		return hashtable_lp_next_pow2( htable->resizefactor * (float)(htable->capacity) );
+	else
+		return hashtable_lp_get_prime( htable->resizefactor * (float)(htable->capacity) );
+}
+
 /*
  * Creates a new hash table with default settings (size = 25, LF = 0.75).
  * */
@@ -104,28 +155,758 @@ struct hashtable_lp* hashtable_lp_create_default( hashtable_lp_hashfunc hashfunc
 }
 
 /*
- * Initializes hash array
- */
-void hashtable_lp_initialize_array(struct hashtable_lp_keyvalue_pair* emptykvp, struct hashtable_lp_keyvalue_pair** array, size_t size)
+ * Initializes hash array
+ */
+void hashtable_lp_initialize_array(struct hashtable_lp_keyvalue_pair* emptykvp, struct hashtable_lp_keyvalue_pair** array, size_t size)
+{
+	if (array)
+		for (int i = 0; i < size; ++i) {
+			array[i] = (struct hashtable_lp_keyvalue_pair*)malloc(sizeof(struct hashtable_lp_keyvalue_pair));
+			array[i]->key = emptykvp->key;
+			array[i]->value = emptykvp->value;
+			array[i]->hash = emptykvp->hash;
+		}
+}
+
+/*
+ * Creates a new hash table with an exact capacity (no prime or power of two rounding).
+ * Only one of 'hashfunc' and 'hashfunc64' should be set.
+ * */
+struct hashtable_lp* hashtable_lp_create_exact( size_t capacity, float loadfactor, float resizefactor,
+												hashtable_lp_hashfunc hashfunc,
+												hashtable_lp_hashfunc64 hashfunc64,
+												hashtable_lp_isequal isequalfunc,
+												hashtable_lp_printitem printitemfunc,
+												hashtable_lp_freedata freedatafunc )
+{
+	struct hashtable_lp* result = malloc(sizeof(*result));
+
+	if (result == NULL)
+		return result;
+	else {
+		uint arr_size = capacity * sizeof(struct hashtable_lp_keyvalue_pair);
+		result->harray = (struct hashtable_lp_keyvalue_pair**)malloc(arr_size);
+		result->capacity = capacity;
+		result->loadfactor = loadfactor;
+		result->threshold = hashtable_lp_compute_threshold(capacity, loadfactor);
+
+		result->hashfunc = hashfunc;
+		result->hashfunc64 = hashfunc64;
+		result->isequal = isequalfunc;
+		result->printitem = printitemfunc;
+		result->freedata = freedatafunc;
+		result->empty_kvp = (struct hashtable_lp_keyvalue_pair*)malloc(sizeof(struct hashtable_lp_keyvalue_pair));
+		result->empty_kvp->key = NULL;
+		result->empty_kvp->value = NULL;
+		result->empty_kvp->hash = 0;
+
+		int* delk = (int*)malloc(sizeof(int)); int* delv = (int*)malloc(sizeof(int));
+		*delk = -1; *delv = -1;
+
+		result->deleted_kvp = (struct hashtable_lp_keyvalue_pair*)malloc(sizeof(struct hashtable_lp_keyvalue_pair));
+		result->deleted_kvp->key = delk;
+		result->deleted_kvp->value = delv;
+		result->deleted_kvp->hash = 0;
+
+		// initialize hash array with dummy value (empty slots)
+		hashtable_lp_initialize_array(result->empty_kvp, result->harray, capacity);
+
+//		for (int i = 0; i < capacity; ++i) {
+//			result->harray[i] = (struct hashtablelpkeyvaluepair)malloc(sizeof(*(result->harray[i])));
+//			result->harray[i]->key = result->empty_kvp->key;
+//			result->harray[i]->value = result->empty_kvp->value;
+//		}
+
+		result->count = 0;
+		result->resizefactor = resizefactor;
+		result->storage = HASHTABLE_LP_STORAGE_INDIRECT;
+		result->lockfree = NULL;
+		result->deleted = 0;
+		result->slots = NULL;
+		result->counters = (struct hashtable_lp_counters){ 0 };
+	}
+
+	return result;
+}
+
+/*
+ * Creates a new hash table with given initial size and load factor.
+ * */
+struct hashtable_lp* hashtable_lp_create( size_t capacity, float loadfactor, float resizefactor,
+										  hashtable_lp_hashfunc hashfunc,
+										  hashtable_lp_isequal isequalfunc,
+										  hashtable_lp_printitem printitemfunc,
+										  hashtable_lp_freedata freedatafunc )
+{
+	assert(capacity > HASHTABLE_LP_MIN_SIZE);
+	assert( (loadfactor > 0.1) && (loadfactor < 1.0) );
+	assert( (resizefactor > 1.0) && (resizefactor < 10.0) );
+
+	return hashtable_lp_create_exact( hashtable_lp_get_prime(capacity), loadfactor, resizefactor,
+									  hashfunc, NULL, isequalfunc, printitemfunc, freedatafunc );
+}
+
+/*
+ * Creates a new hash table using a 64 bit hash function, given initial size and load factor.
+ * Capacity is rounded up to a power of two and slots are selected with fibonacci
+ * (multiply-shift) hashing, so no division or prime search is ever needed.
+ * */
+struct hashtable_lp* hashtable_lp_create64( size_t capacity, float loadfactor, float resizefactor,
+											hashtable_lp_hashfunc64 hashfunc64,
+											hashtable_lp_isequal isequalfunc,
+											hashtable_lp_printitem printitemfunc,
+											hashtable_lp_freedata freedatafunc )
+{
+	assert(capacity > HASHTABLE_LP_MIN_SIZE);
+	assert( (loadfactor > 0.1) && (loadfactor < 1.0) );
+	assert( (resizefactor > 1.0) && (resizefactor < 10.0) );
+
+	return hashtable_lp_create_exact( hashtable_lp_next_pow2(capacity), loadfactor, resizefactor,
+									  NULL, hashfunc64, isequalfunc, printitemfunc, freedatafunc );
+}
+
+//--------------------- inline storage ------------------
+
+/*
+ * Creates a new hash table with inline storage and an exact capacity.
+ * Only one of 'hashfunc' and 'hashfunc64' should be set.
+ * */
+struct hashtable_lp* hashtable_lp_create_inline_exact( size_t capacity, float loadfactor, float resizefactor,
+													   hashtable_lp_hashfunc hashfunc,
+													   hashtable_lp_hashfunc64 hashfunc64,
+													   hashtable_lp_isequal isequalfunc,
+													   hashtable_lp_printitem printitemfunc,
+													   hashtable_lp_freedata freedatafunc )
+{
+	struct hashtable_lp* result = malloc(sizeof(*result));
+
+	if (result == NULL)
+		return result;
+	else {
+		// calloc initializes all slots as empty (HASHTABLE_LP_SLOT_EMPTY = 0)
+		result->slots = (struct hashtable_lp_slot*)calloc(capacity, sizeof(struct hashtable_lp_slot));
+		if (result->slots == NULL) {
+			printf("Memory error: failed to allocate memory for hashtable inline slots array!");
+			free(result);
+			abort();
+		}
+
+		result->storage = HASHTABLE_LP_STORAGE_INLINE;
+		result->lockfree = NULL;
+		result->harray = NULL;
+		result->empty_kvp = NULL;
+		result->deleted_kvp = NULL;
+		result->capacity = capacity;
+		result->loadfactor = loadfactor;
+		result->resizefactor = resizefactor;
+		result->threshold = hashtable_lp_compute_threshold(capacity, loadfactor);
+		result->hashfunc = hashfunc;
+		result->hashfunc64 = hashfunc64;
+		result->isequal = isequalfunc;
+		result->printitem = printitemfunc;
+		result->freedata = freedatafunc;
+		result->count = 0;
+		result->deleted = 0;
+		result->counters = (struct hashtable_lp_counters){ 0 };
+	}
+
+	return result;
+}
+
+/*
+ * Creates a new hash table with inline storage and given initial size and load factor.
+ * Key, value and slot state are kept together in one flat array (no per-slot heap
+ * records).
+ * Note: unlike the default storage, duplicate keys are not allowed.
+ * */
+struct hashtable_lp* hashtable_lp_create_inline( size_t capacity, float loadfactor, float resizefactor,
+												 hashtable_lp_hashfunc hashfunc,
+												 hashtable_lp_isequal isequalfunc,
+												 hashtable_lp_printitem printitemfunc,
+												 hashtable_lp_freedata freedatafunc )
+{
+	assert(capacity > HASHTABLE_LP_MIN_SIZE);
+	assert( (loadfactor > 0.1) && (loadfactor < 1.0) );
+	assert( (resizefactor > 1.0) && (resizefactor < 10.0) );
+
+	return hashtable_lp_create_inline_exact( hashtable_lp_get_prime(capacity), loadfactor, resizefactor,
+											 hashfunc, NULL, isequalfunc, printitemfunc, freedatafunc );
+}
+
+/*
+ * Creates a new hash table with inline storage using a 64 bit hash function.
+ * Capacity is rounded up to a power of two (see hashtable_lp_create64).
+ * */
+struct hashtable_lp* hashtable_lp_create_inline64( size_t capacity, float loadfactor, float resizefactor,
+												   hashtable_lp_hashfunc64 hashfunc64,
+												   hashtable_lp_isequal isequalfunc,
+												   hashtable_lp_printitem printitemfunc,
+												   hashtable_lp_freedata freedatafunc )
+{
+	assert(capacity > HASHTABLE_LP_MIN_SIZE);
+	assert( (loadfactor > 0.1) && (loadfactor < 1.0) );
+	assert( (resizefactor > 1.0) && (resizefactor < 10.0) );
+
+	return hashtable_lp_create_inline_exact( hashtable_lp_next_pow2(capacity), loadfactor, resizefactor,
+											 NULL, hashfunc64, isequalfunc, printitemfunc, freedatafunc );
+}
+
+/*
+ * Creates a new hash table with inline storage and default settings (size = 25, LF = 0.75).
+ * */
+struct hashtable_lp* hashtable_lp_create_inline_default( hashtable_lp_hashfunc hashfunc,
+														 hashtable_lp_isequal isequalfunc,
+														 hashtable_lp_printitem printitemfunc,
+														 hashtable_lp_freedata freedatafunc )
+{
+	return hashtable_lp_create_inline( HASHTABLE_LP_DEFAULT_SIZE, HASHTABLE_LP_DEFAULT_LOAD_FACTOR,
+									   HASHTABLE_LP_RESIZE_FACTOR,
+									   hashfunc, isequalfunc,
+									   printitemfunc, freedatafunc );
+}
+
+/*
+ * Finds the slot holding a given key with a given hash value (inline storage).
+ * Probing stops at the first empty slot; deleted slots are skipped by their control
+ * state and full slots with a different stored hash without calling 'isequal'.
+ * Returns the slot index if found, -1 otherwise.
+ * */
+long hashtable_lp_inline_find(const struct hashtable_lp* htable, const void* key, uint64_t hash)
+{
+	size_t cap = htable->capacity;
+	size_t slot = hashtable_lp_slot_index(htable, hash, cap);
+	struct hashtable_lp_slot* slots = htable->slots;
+
+	for (size_t probes = 0; probes < cap; ++probes) {
+		if (slots[slot].state == HASHTABLE_LP_SLOT_EMPTY)
+			break;	// not found
+
+		if ((slots[slot].state == HASHTABLE_LP_SLOT_FULL) && (slots[slot].kvp.hash == hash)
+			&& (htable->isequal(key, slots[slot].kvp.key)))
+			return (long)slot;
+
+		if (++slot == cap) slot = 0;	// increment index and wrap around the table
+	}
+
+	return -1;
+}
+
+/*
+ * Inserts a key/value pair in a slots array without checking for duplicates or
+ * threshold (inline storage). Used by put and rehash.
+ * Returns the used slot index.
+ * */
+size_t hashtable_lp_inline_place( struct hashtable_lp_slot* slots, size_t cap,
+								  size_t slot, void* key, void* value, uint64_t hash )
+{
+	// move until an empty or deleted slot is found
+	while (slots[slot].state == HASHTABLE_LP_SLOT_FULL) {
+		if (++slot == cap) slot = 0;
+	}
+
+	slots[slot].kvp.key = key;
+	slots[slot].kvp.value = value;
+	slots[slot].kvp.hash = hash;
+	slots[slot].state = HASHTABLE_LP_SLOT_FULL;
+	return slot;
+}
+
+/*
+ * Rehashes all inline slots into a new array with given size.
+ * Deleted slots are dropped in the process.
+ * */
+void hashtable_lp_inline_reallocate(struct hashtable_lp* htable, size_t new_size)
+{
+	DATASTATS_ONLY(uint64_t start = datastats_nanotime();)
+	struct hashtable_lp_slot* new_slots =
+			(struct hashtable_lp_slot*)calloc(new_size, sizeof(struct hashtable_lp_slot));
+
+	if (new_slots == NULL) {
+		printf("Memory error: failed to allocate memory for reallocated hashtable slots array!");
+		abort();
+	}
+
+	struct hashtable_lp_slot* old = htable->slots;
+	for (size_t i = 0; i < htable->capacity; ++i) {
+		if (old[i].state != HASHTABLE_LP_SLOT_FULL)
+			continue;
+
+		// stored hash avoids calling hash function again
+		size_t slot = hashtable_lp_slot_index(htable, old[i].kvp.hash, new_size);
+		hashtable_lp_inline_place(new_slots, new_size, slot, old[i].kvp.key, old[i].kvp.value, old[i].kvp.hash);
+	}
+
+	free(old);
+	htable->slots = new_slots;
+	htable->capacity = new_size;
+	htable->deleted = 0;
+	htable->threshold = hashtable_lp_compute_threshold(new_size, htable->loadfactor);
+
+	DATASTATS_COUNT(htable->counters.resizes);
+	DATASTATS_ADD(htable->counters.resizens, datastats_nanotime() - start);
+}
+
+/*
+ * Adds the key/value to the hash table (inline storage).
+ * Returns 1 if succeeded, 0 otherwise (key already exists).
+ * */
+int hashtable_lp_inline_put(struct hashtable_lp* htable, void* key, void* value, uint64_t hash)
+{
+	if (hashtable_lp_inline_find(htable, key, hash) >= 0)
+		return 0;	// duplicated keys are not allowed
+
+	size_t slot = hashtable_lp_slot_index(htable, hash, htable->capacity);
+	DATASTATS_ONLY(size_t home = slot;)
+	slot = hashtable_lp_inline_place(htable->slots, htable->capacity, slot, key, value, hash);
+	htable->count++;
+	DATASTATS_COUNT(htable->counters.puts);
+	DATASTATS_ADD(htable->counters.collisions, (slot != home));
+
+	// if threshold reached (deleted slots also lengthen probe chains), reallocate
+	// and re-hash. Only grow when live elements alone justify it.
+	if ((htable->count + htable->deleted) >= htable->threshold) {
+		size_t new_size = htable->capacity;
+		if (htable->count >= (size_t)(htable->threshold / 2))
+			new_size = hashtable_lp_next_capacity(htable);
+
+		hashtable_lp_inline_reallocate(htable, new_size);
+	}
+
+	return 1;
+}
+
+/*
+ * Deletes the key/value pair for a given key (inline storage).
+ * Returns a heap copy of removed key/value pair if succeeded, NULL otherwise.
+ * */
+struct hashtable_lp_keyvalue_pair* hashtable_lp_inline_remove(struct hashtable_lp* htable, const void* key)
+{
+	struct hashtable_lp_keyvalue_pair* result = NULL;
+	long slot = hashtable_lp_inline_find(htable, key, hashtable_lp_hashkey(htable, key));
+
+	if (slot >= 0) {
+		result = (struct hashtable_lp_keyvalue_pair*)malloc(sizeof(*result));
+		if (result == NULL) {
+			printf("Memory error: failed to allocate memory for removed key/value pair!");
+			abort();
+		}
+
+		*result = htable->slots[slot].kvp;
+		htable->slots[slot].kvp.key = htable->slots[slot].kvp.value = NULL;
+		htable->slots[slot].state = HASHTABLE_LP_SLOT_DELETED;
+		htable->count--;
+		htable->deleted++;
+	}
+
+	return result;
+}
+
+//--------------------- inline storage ------------------
+
+//--------------------- robin hood storage ------------------
+
+/*
+ * Creates a new hash table with robin hood storage and an exact capacity.
+ * Only one of 'hashfunc' and 'hashfunc64' should be set.
+ * */
+struct hashtable_lp* hashtable_lp_create_robinhood_exact( size_t capacity, float loadfactor, float resizefactor,
+														  hashtable_lp_hashfunc hashfunc,
+														  hashtable_lp_hashfunc64 hashfunc64,
+														  hashtable_lp_isequal isequalfunc,
+														  hashtable_lp_printitem printitemfunc,
+														  hashtable_lp_freedata freedatafunc )
+{
+	// same flat slots array as inline storage (calloc also zeroes the distances)
+	struct hashtable_lp* result = hashtable_lp_create_inline_exact( capacity, loadfactor, resizefactor,
+																	hashfunc, hashfunc64, isequalfunc,
+																	printitemfunc, freedatafunc );
+	if (result != NULL)
+		result->storage = HASHTABLE_LP_STORAGE_ROBINHOOD;
+
+	return result;
+}
+
+/*
+ * Creates a new hash table with robin hood storage and given initial size and load factor.
+ * Slots are inline (see hashtable_lp_create_inline) and keep the probe distance of
+ * their element: inserts keep distances even, lookups of missing keys stop early and
+ * removes use backward-shift deletion, so no deleted slots are ever left behind.
+ * Note: duplicate keys are not allowed.
+ * */
+struct hashtable_lp* hashtable_lp_create_robinhood( size_t capacity, float loadfactor, float resizefactor,
+													hashtable_lp_hashfunc hashfunc,
+													hashtable_lp_isequal isequalfunc,
+													hashtable_lp_printitem printitemfunc,
+													hashtable_lp_freedata freedatafunc )
+{
+	assert(capacity > HASHTABLE_LP_MIN_SIZE);
+	assert( (loadfactor > 0.1) && (loadfactor < 1.0) );
+	assert( (resizefactor > 1.0) && (resizefactor < 10.0) );
+
+	return hashtable_lp_create_robinhood_exact( hashtable_lp_get_prime(capacity), loadfactor, resizefactor,
+												hashfunc, NULL, isequalfunc, printitemfunc, freedatafunc );
+}
+
+/*
+ * Creates a new hash table with robin hood storage using a 64 bit hash function.
+ * Capacity is rounded up to a power of two (see hashtable_lp_create64).
+ * */
+struct hashtable_lp* hashtable_lp_create_robinhood64( size_t capacity, float loadfactor, float resizefactor,
+													  hashtable_lp_hashfunc64 hashfunc64,
+													  hashtable_lp_isequal isequalfunc,
+													  hashtable_lp_printitem printitemfunc,
+													  hashtable_lp_freedata freedatafunc )
+{
+	assert(capacity > HASHTABLE_LP_MIN_SIZE);
+	assert( (loadfactor > 0.1) && (loadfactor < 1.0) );
+	assert( (resizefactor > 1.0) && (resizefactor < 10.0) );
+
+	return hashtable_lp_create_robinhood_exact( hashtable_lp_next_pow2(capacity), loadfactor, resizefactor,
+												NULL, hashfunc64, isequalfunc, printitemfunc, freedatafunc );
+}
+
+/*
+ * Creates a new hash table with robin hood storage and default settings
+ * (size = 25, LF = 0.9).
+ * */
+struct hashtable_lp* hashtable_lp_create_robinhood_default( hashtable_lp_hashfunc hashfunc,
+															hashtable_lp_isequal isequalfunc,
+															hashtable_lp_printitem printitemfunc,
+															hashtable_lp_freedata freedatafunc )
+{
+	return hashtable_lp_create_robinhood( HASHTABLE_LP_DEFAULT_SIZE, HASHTABLE_LP_ROBINHOOD_DEFAULT_LOAD_FACTOR,
+										  HASHTABLE_LP_RESIZE_FACTOR,
+										  hashfunc, isequalfunc,
+										  printitemfunc, freedatafunc );
+}
+
+/*
+ * Finds the slot holding a given key with a given hash value (robin hood storage).
+ * Probing stops at the first empty slot or at the first element closer to its home
+ * slot than the key would be at that slot (the key would have displaced it).
+ * Returns the slot index if found, -1 otherwise.
+ * */
+long hashtable_lp_robinhood_find(const struct hashtable_lp* htable, const void* key, uint64_t hash)
+{
+	size_t cap = htable->capacity;
+	size_t slot = hashtable_lp_slot_index(htable, hash, cap);
+	struct hashtable_lp_slot* slots = htable->slots;
+
+	for (uint32_t distance = 0; distance < cap; ++distance) {
+		if ((slots[slot].state == HASHTABLE_LP_SLOT_EMPTY) || (slots[slot].distance < distance))
+			break;	// not found
+
+		if ((slots[slot].kvp.hash == hash) && (htable->isequal(key, slots[slot].kvp.key)))
+			return (long)slot;
+
+		if (++slot == cap) slot = 0;	// increment index and wrap around the table
+	}
+
+	return -1;
+}
+
+/*
+ * Inserts a key/value pair in a slots array without checking for duplicates or
+ * threshold (robin hood storage). Used by put and rehash.
+ * Walking from the home slot, the carried element is swapped with any element closer
+ * to its home slot, and the displaced element is carried on until an empty slot.
+ * Returns the slot index of the inserted key/value pair.
+ * */
+size_t hashtable_lp_robinhood_place( struct hashtable_lp_slot* slots, size_t cap,
+									 size_t slot, void* key, void* value, uint64_t hash )
+{
+	struct hashtable_lp_slot carried = { { key, value, hash }, HASHTABLE_LP_SLOT_FULL, 0 };
+	size_t result = cap;	// set when the new pair is stored
+
+	while (slots[slot].state == HASHTABLE_LP_SLOT_FULL) {
+		if (slots[slot].distance < carried.distance) {
+			struct hashtable_lp_slot tmp = slots[slot];
+			slots[slot] = carried;
+			carried = tmp;
+			if (result == cap) result = slot;
+		}
+
+		carried.distance++;
+		if (++slot == cap) slot = 0;
+	}
+
+	slots[slot] = carried;
+	return (result == cap) ? slot : result;
+}
+
+/*
+ * Rehashes all robin hood slots into a new array with given size.
+ * */
+void hashtable_lp_robinhood_reallocate(struct hashtable_lp* htable, size_t new_size)
+{
+	DATASTATS_ONLY(uint64_t start = datastats_nanotime();)
+	struct hashtable_lp_slot* new_slots =
+			(struct hashtable_lp_slot*)calloc(new_size, sizeof(struct hashtable_lp_slot));
+
+	if (new_slots == NULL) {
+		printf("Memory error: failed to allocate memory for reallocated hashtable slots array!");
+		abort();
+	}
+
+	struct hashtable_lp_slot* old = htable->slots;
+	for (size_t i = 0; i < htable->capacity; ++i) {
+		if (old[i].state != HASHTABLE_LP_SLOT_FULL)
+			continue;
+
+		// stored hash avoids calling hash function again
+		size_t slot = hashtable_lp_slot_index(htable, old[i].kvp.hash, new_size);
+		hashtable_lp_robinhood_place(new_slots, new_size, slot, old[i].kvp.key, old[i].kvp.value, old[i].kvp.hash);
+	}
+
+	free(old);
+	htable->slots = new_slots;
+	htable->capacity = new_size;
+	htable->threshold = hashtable_lp_compute_threshold(new_size, htable->loadfactor);
+
+	DATASTATS_COUNT(htable->counters.resizes);
+	DATASTATS_ADD(htable->counters.resizens, datastats_nanotime() - start);
+}
+
+/*
+ * Adds the key/value to the hash table (robin hood storage).
+ * Returns 1 if succeeded, 0 otherwise (key already exists).
+ * */
+int hashtable_lp_robinhood_put(struct hashtable_lp* htable, void* key, void* value, uint64_t hash)
+{
+	if (hashtable_lp_robinhood_find(htable, key, hash) >= 0)
+		return 0;	// duplicated keys are not allowed
+
+	size_t slot = hashtable_lp_slot_index(htable, hash, htable->capacity);
+	DATASTATS_ONLY(size_t home = slot;)
+	slot = hashtable_lp_robinhood_place(htable->slots, htable->capacity, slot, key, value, hash);
+	htable->count++;
+	DATASTATS_COUNT(htable->counters.puts);
+	DATASTATS_ADD(htable->counters.collisions, (slot != home));
+
+	// if threshold reached, reallocate and re-hash
+	if (htable->count >= htable->threshold)
+		hashtable_lp_robinhood_reallocate(htable, hashtable_lp_next_capacity(htable));
+
+	return 1;
+}
+
+/*
+ * Empties a full slot (robin hood storage).
+ * Following elements are shifted one slot back, up to the first empty slot or element
+ * at its home slot (backward-shift deletion), so the probe distance of every element
+ * stays exact and no deleted slot is left.
+ * */
+void hashtable_lp_robinhood_unlink(struct hashtable_lp* htable, size_t slot)
+{
+	size_t cap = htable->capacity;
+	struct hashtable_lp_slot* slots = htable->slots;
+	size_t next = (slot + 1 == cap) ? 0 : slot + 1;
+
+	while ((slots[next].state == HASHTABLE_LP_SLOT_FULL) && (slots[next].distance > 0)) {
+		slots[slot] = slots[next];
+		slots[slot].distance--;
+		slot = next;
+		if (++next == cap) next = 0;
+	}
+
+	slots[slot] = (struct hashtable_lp_slot){ { NULL, NULL, 0 }, HASHTABLE_LP_SLOT_EMPTY, 0 };
+	htable->count--;
+}
+
+/*
+ * Deletes the key/value pair for a given key (robin hood storage, see
+ * hashtable_lp_robinhood_unlink).
+ * Returns a heap copy of removed key/value pair if succeeded, NULL otherwise.
+ * */
+struct hashtable_lp_keyvalue_pair* hashtable_lp_robinhood_remove(struct hashtable_lp* htable, const void* key)
+{
+	struct hashtable_lp_keyvalue_pair* result = NULL;
+	long found = hashtable_lp_robinhood_find(htable, key, hashtable_lp_hashkey(htable, key));
+
+	if (found >= 0) {
+		result = (struct hashtable_lp_keyvalue_pair*)malloc(sizeof(*result));
+		if (result == NULL) {
+			printf("Memory error: failed to allocate memory for removed key/value pair!");
+			abort();
+		}
+
+		*result = htable->slots[found].kvp;
+		hashtable_lp_robinhood_unlink(htable, (size_t)found);
+	}
+
+	return result;
+}
+
+//--------------------- robin hood storage ------------------
+
+//--------------------- lock-free reads ------------------
+
+// marks deleted slots of lock-free tables
+static struct hashtable_lp_keyvalue_pair hashtable_lp_lockfree_tombstone = { NULL, NULL, 0 };
+
+// epoch based reclamation state (shared by all lock-free tables)
+static _Atomic unsigned long hashtable_lp_global_epoch = 1;
+static _Atomic(struct hashtable_lp_reader*) hashtable_lp_readers = NULL;
+static __thread struct hashtable_lp_reader* hashtable_lp_thread_reader = NULL;
+static pthread_key_t hashtable_lp_reader_key;
+static pthread_once_t hashtable_lp_reader_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Releases the reader record of an exiting thread so other threads can reuse it.
+ * */
+void hashtable_lp_reader_release(void* data)
+{
+	struct hashtable_lp_reader* reader = (struct hashtable_lp_reader*)data;
+	atomic_store(&(reader->epoch), 0);
+	atomic_store(&(reader->inuse), 0);
+}
+
+/*
+ * Creates the thread specific key used to release reader records.
+ * */
+void hashtable_lp_reader_key_create()
+{
+	if (pthread_key_create(&hashtable_lp_reader_key, hashtable_lp_reader_release) != 0) {
+		printf("Error: failed to create hashtable reader thread key!");
+		abort();
+	}
+}
+
+/*
+ * Gets the reader record of the calling thread (registered on first use).
+ * */
+struct hashtable_lp_reader* hashtable_lp_reader_get()
+{
+	struct hashtable_lp_reader* reader = hashtable_lp_thread_reader;
+	if (reader != NULL)
+		return reader;
+
+	pthread_once(&hashtable_lp_reader_once, hashtable_lp_reader_key_create);
+
+	// reuse a record released by a terminated thread
+	for (reader = atomic_load(&hashtable_lp_readers); reader != NULL; reader = reader->next) {
+		int expected = 0;
+		if (atomic_compare_exchange_strong(&(reader->inuse), &expected, 1))
+			break;
+	}
+
+	if (reader == NULL) {
+		reader = (struct hashtable_lp_reader*)aligned_alloc(HASHTABLE_LP_CACHE_LINE, sizeof(struct hashtable_lp_reader));
+		if (reader == NULL) {
+			printf("Memory error: failed to allocate memory for hashtable reader!");
+			abort();
+		}
+
+		atomic_init(&(reader->epoch), 0);
+		atomic_init(&(reader->inuse), 1);
+
+		// push to readers list (lock-free, records are never removed)
+		reader->next = atomic_load(&hashtable_lp_readers);
+		while (!atomic_compare_exchange_weak(&hashtable_lp_readers, &(reader->next), reader))
+			;
+	}
+
+	pthread_setspecific(hashtable_lp_reader_key, reader);
+	hashtable_lp_thread_reader = reader;
+	return reader;
+}
+
+/*
+ * Enters a read section: announces current epoch in the thread own record.
+ * Memory retired from now on is not released until the section ends.
+ * */
+struct hashtable_lp_reader* hashtable_lp_read_begin()
+{
+	struct hashtable_lp_reader* reader = hashtable_lp_reader_get();
+	atomic_store(&(reader->epoch), atomic_load(&hashtable_lp_global_epoch));
+	return reader;
+}
+
+/*
+ * Leaves a read section.
+ * */
+void hashtable_lp_read_end(struct hashtable_lp_reader* reader)
+{
+	atomic_store_explicit(&(reader->epoch), 0, memory_order_release);
+}
+
+/*
+ * Releases retired memory no reader can still reference: items retired before
+ * the oldest epoch announced by a reader inside a read section.
+ * Must be invoked by writers (write lock held).
+ * */
+void hashtable_lp_lockfree_reclaim(struct hashtable_lp_lockfree* lf)
+{
+	unsigned long oldest = ULONG_MAX;
+
+	for (struct hashtable_lp_reader* r = atomic_load(&hashtable_lp_readers); r != NULL; r = r->next) {
+		unsigned long e = atomic_load(&(r->epoch));
+		if ((e != 0) && (e < oldest))
+			oldest = e;
+	}
+
+	struct hashtable_lp_retired** link = &(lf->retired);
+	while (*link != NULL) {
+		struct hashtable_lp_retired* item = *link;
+		if (item->epoch < oldest) {
+			*link = item->next;
+			free(item->ptr);
+			free(item);
+		}
+		else
+			link = &(item->next);
+	}
+}
+
+/*
+ * Retires memory unlinked from the table. It will be released once every reader
+ * that might still see it has left its read section.
+ * Must be invoked by writers (write lock held).
+ * */
+void hashtable_lp_lockfree_retire(struct hashtable_lp_lockfree* lf, void* ptr)
 {
-	if (array)
-		for (int i = 0; i < size; ++i) {
-			array[i] = (struct hashtable_lp_keyvalue_pair*)malloc(sizeof(struct hashtable_lp_keyvalue_pair));
-			array[i]->key = emptykvp->key;
-			array[i]->value = emptykvp->value;
-		}
+	struct hashtable_lp_retired* item = (struct hashtable_lp_retired*)malloc(sizeof(*item));
+	if (item == NULL) {
+		printf("Memory error: failed to allocate memory for retired hashtable item!");
+		abort();
+	}
+
+	item->ptr = ptr;
+	item->epoch = atomic_fetch_add(&hashtable_lp_global_epoch, 1);
+	item->next = lf->retired;
+	lf->retired = item;
+
+	hashtable_lp_lockfree_reclaim(lf);
 }
 
 /*
- * Creates a new hash table with given initial size and load factor.
+ * Allocates a slots array for lock-free tables (all slots empty).
  * */
-struct hashtable_lp* hashtable_lp_create( size_t capacity, float loadfactor, float resizefactor,
-										  hashtable_lp_hashfunc hashfunc,
-										  hashtable_lp_isequal isequalfunc,
-										  hashtable_lp_printitem printitemfunc,
-										  hashtable_lp_freedata freedatafunc )
+struct hashtable_lp_lockfree_array* hashtable_lp_lockfree_array_create(size_t capacity)
 {
+	struct hashtable_lp_lockfree_array* result = (struct hashtable_lp_lockfree_array*)calloc( 1,
+						sizeof(struct hashtable_lp_lockfree_array) + capacity * sizeof(result->slots[0]) );
+	if (result == NULL) {
+		printf("Memory error: failed to allocate memory for hashtable slots array!");
+		abort();
+	}
 
+	result->capacity = capacity;
+	return result;
+}
+
+/*
+ * Creates a new hash table with lock-free reads, given initial size and load factor.
+ * get/contains take no locks and write no shared memory; writers are serialized by
+ * an internal mutex and publish changes with atomic stores.
+ * Note: duplicate keys are not allowed.
+ * */
+struct hashtable_lp* hashtable_lp_create_lockfree( size_t capacity, float loadfactor, float resizefactor,
+												   hashtable_lp_hashfunc hashfunc,
+												   hashtable_lp_isequal isequalfunc,
+												   hashtable_lp_printitem printitemfunc,
+												   hashtable_lp_freedata freedatafunc )
+{
 	assert(capacity > HASHTABLE_LP_MIN_SIZE);
 	assert( (loadfactor > 0.1) && (loadfactor < 1.0) );
 	assert( (resizefactor > 1.0) && (resizefactor < 10.0) );
@@ -137,43 +918,263 @@ struct hashtable_lp* hashtable_lp_create( size_t capacity, float loadfactor, flo
 	if (result == NULL)
 		return result;
 	else {
-		uint arr_size = capacity * sizeof(struct hashtable_lp_keyvalue_pair);
-		result->harray = (struct hashtable_lp_keyvalue_pair**)malloc(arr_size);
+		result->lockfree = (struct hashtable_lp_lockfree*)malloc(sizeof(struct hashtable_lp_lockfree));
+		if (result->lockfree == NULL) {
+			printf("Memory error: failed to allocate memory for hashtable lock-free state!");
+			abort();
+		}
+
+		atomic_init(&(result->lockfree->array), hashtable_lp_lockfree_array_create(capacity));
+		pthread_mutex_init(&(result->lockfree->writelock), NULL);
+		result->lockfree->retired = NULL;
+
+		result->storage = HASHTABLE_LP_STORAGE_LOCKFREE;
+		result->harray = NULL;
+		result->slots = NULL;
+		result->empty_kvp = NULL;
+		result->deleted_kvp = NULL;
 		result->capacity = capacity;
 		result->loadfactor = loadfactor;
+		result->resizefactor = resizefactor;
 		result->threshold = hashtable_lp_compute_threshold(capacity, loadfactor);
-
 		result->hashfunc = hashfunc;
+		result->hashfunc64 = NULL;
 		result->isequal = isequalfunc;
 		result->printitem = printitemfunc;
 		result->freedata = freedatafunc;
-		result->empty_kvp = (struct hashtable_lp_keyvalue_pair*)malloc(sizeof(struct hashtable_lp_keyvalue_pair));
-		result->empty_kvp->key = NULL;
-		result->empty_kvp->value = NULL;
+		result->count = 0;
+		result->deleted = 0;
+		result->counters = (struct hashtable_lp_counters){ 0 };
+	}
 
-		int* delk = (int*)malloc(sizeof(int)); int* delv = (int*)malloc(sizeof(int));
-		*delk = -1; *delv = -1;
+	return result;
+}
 
-		result->deleted_kvp = (struct hashtable_lp_keyvalue_pair*)malloc(sizeof(struct hashtable_lp_keyvalue_pair));
-		result->deleted_kvp->key = delk;
-		result->deleted_kvp->value = delv;
+/*
+ * Finds the slot holding a given key in a lock-free slots array.
+ * Returns the slot index if found, -1 otherwise.
+ * Note: caller must be inside a read section or hold the write lock.
+ * */
+long hashtable_lp_lockfree_find( const struct hashtable_lp* htable,
+								 struct hashtable_lp_lockfree_array* arr,
+								 const void* key, uint64_t hash )
+{
+	size_t cap = arr->capacity;
+	size_t slot = hashtable_lp_slot_index(htable, hash, cap);
 
-		// initialize hash array with dummy value (empty slots)
-		hashtable_lp_initialize_array(result->empty_kvp, result->harray, capacity);
+	for (size_t probes = 0; probes < cap; ++probes) {
+		struct hashtable_lp_keyvalue_pair* kvp = atomic_load_explicit(&(arr->slots[slot]), memory_order_acquire);
 
-//		for (int i = 0; i < capacity; ++i) {
-//			result->harray[i] = (struct hashtablelpkeyvaluepair)malloc(sizeof(*(result->harray[i])));
-//			result->harray[i]->key = result->empty_kvp->key;
-//			result->harray[i]->value = result->empty_kvp->value;
-//		}
+		if (kvp == NULL)
+			break;	// not found
 
-		result->count = 0;
-		result->resizefactor = resizefactor;
+		if ((kvp != &hashtable_lp_lockfree_tombstone) && (kvp->hash == hash)
+			&& (htable->isequal(key, kvp->key)))
+			return (long)slot;
+
+		if (++slot == cap) slot = 0;	// increment index and wrap around the table
+	}
+
+	return -1;
+}
+
+/*
+ * Gets the value associated with given key (lock-free).
+ * Returns pointer to value if succeeded, NULL otherwise.
+ * */
+void* hashtable_lp_lockfree_get(const struct hashtable_lp* htable, const void* key, uint64_t hash)
+{
+	void* result = NULL;
+	struct hashtable_lp_reader* reader = hashtable_lp_read_begin();
+
+	struct hashtable_lp_lockfree_array* arr = atomic_load_explicit(&(htable->lockfree->array), memory_order_acquire);
+	long slot = hashtable_lp_lockfree_find(htable, arr, key, hash);
+	if (slot >= 0)
+		result = atomic_load_explicit(&(arr->slots[slot]), memory_order_acquire)->value;
+
+	hashtable_lp_read_end(reader);
+	return result;
+}
+
+/*
+ * Checks if hastable contains element with the given key (lock-free).
+ * */
+int hashtable_lp_lockfree_contains(const struct hashtable_lp* htable, const void* key, uint64_t hash)
+{
+	struct hashtable_lp_reader* reader = hashtable_lp_read_begin();
+
+	struct hashtable_lp_lockfree_array* arr = atomic_load_explicit(&(htable->lockfree->array), memory_order_acquire);
+	int result = (hashtable_lp_lockfree_find(htable, arr, key, hash) >= 0);
+
+	hashtable_lp_read_end(reader);
+	return result;
+}
+
+/*
+ * Stores a key/value pair in the first free slot of its probe sequence.
+ * Returns 1 if a deleted slot was reused, 0 otherwise.
+ * */
+int hashtable_lp_lockfree_place( const struct hashtable_lp* htable,
+								 struct hashtable_lp_lockfree_array* arr,
+								 struct hashtable_lp_keyvalue_pair* kvp )
+{
+	size_t cap = arr->capacity;
+	size_t slot = hashtable_lp_slot_index(htable, kvp->hash, cap);
+	struct hashtable_lp_keyvalue_pair* cur = NULL;
+
+	while (((cur = atomic_load_explicit(&(arr->slots[slot]), memory_order_relaxed)) != NULL)
+		   && (cur != &hashtable_lp_lockfree_tombstone)) {
+		if (++slot == cap) slot = 0;
+	}
+
+	// release: readers see a fully initialized pair
+	atomic_store_explicit(&(arr->slots[slot]), kvp, memory_order_release);
+	return (cur == &hashtable_lp_lockfree_tombstone);
+}
+
+/*
+ * Rebuilds the slots array with a given size and publishes it to readers.
+ * Old array is retired (deleted slots are dropped in the process).
+ * */
+void hashtable_lp_lockfree_reallocate(struct hashtable_lp* htable, size_t new_size)
+{
+	DATASTATS_ONLY(uint64_t start = datastats_nanotime();)
+	struct hashtable_lp_lockfree_array* old = atomic_load(&(htable->lockfree->array));
+	struct hashtable_lp_lockfree_array* arr = hashtable_lp_lockfree_array_create(new_size);
+
+	for (size_t i = 0; i < old->capacity; ++i) {
+		struct hashtable_lp_keyvalue_pair* kvp = atomic_load_explicit(&(old->slots[i]), memory_order_relaxed);
+		if ((kvp != NULL) && (kvp != &hashtable_lp_lockfree_tombstone))
+			hashtable_lp_lockfree_place(htable, arr, kvp);
+	}
+
+	atomic_store(&(htable->lockfree->array), arr);
+	hashtable_lp_lockfree_retire(htable->lockfree, old);
+
+	htable->capacity = new_size;
+	htable->deleted = 0;
+	htable->threshold = hashtable_lp_compute_threshold(new_size, htable->loadfactor);
+
+	DATASTATS_COUNT(htable->counters.resizes);
+	DATASTATS_ADD(htable->counters.resizens, datastats_nanotime() - start);
+}
+
+/*
+ * Adds the key/value to the hash table (lock-free reads mode).
+ * Returns 1 if succeeded, 0 otherwise (key already exists).
+ * */
+int hashtable_lp_lockfree_put(struct hashtable_lp* htable, void* key, void* value, uint64_t hash)
+{
+	int result = 0;
+	pthread_mutex_lock(&(htable->lockfree->writelock));
+
+	struct hashtable_lp_lockfree_array* arr = atomic_load(&(htable->lockfree->array));
+	if (hashtable_lp_lockfree_find(htable, arr, key, hash) < 0) {
+		struct hashtable_lp_keyvalue_pair* kvp = (struct hashtable_lp_keyvalue_pair*)malloc(sizeof(*kvp));
+		if (kvp == NULL) {
+			printf("Memory error: failed to allocate memory for hashtable key/value pair!");
+			abort();
+		}
+
+		kvp->key = key;
+		kvp->value = value;
+		kvp->hash = hash;
+
+		DATASTATS_ONLY(struct hashtable_lp_keyvalue_pair* home =
+			atomic_load_explicit(&(arr->slots[hashtable_lp_slot_index(htable, hash, arr->capacity)]),
+								 memory_order_relaxed);)
+		DATASTATS_COUNT(htable->counters.puts);
+		DATASTATS_ADD(htable->counters.collisions, (home != NULL) && (home != &hashtable_lp_lockfree_tombstone));
+
+		if (hashtable_lp_lockfree_place(htable, arr, kvp))
+			htable->deleted--;
+		htable->count++;
+
+		// if threshold reached (deleted slots included), reallocate.
+		// Only grow when live elements alone justify it.
+		if ((htable->count + htable->deleted) >= htable->threshold) {
+			size_t new_size = htable->capacity;
+			if (htable->count >= (size_t)(htable->threshold / 2))
+				new_size = hashtable_lp_next_capacity(htable);
+
+			hashtable_lp_lockfree_reallocate(htable, new_size);
+		}
+
+		result = 1;
+	}
+
+	pthread_mutex_unlock(&(htable->lockfree->writelock));
+	return result;
+}
+
+/*
+ * Deletes the key/value pair for a given key (lock-free reads mode).
+ * Returns a heap copy of removed key/value pair if succeeded, NULL otherwise
+ * (the pair stored in the table may still be in use by readers).
+ * */
+struct hashtable_lp_keyvalue_pair* hashtable_lp_lockfree_remove(struct hashtable_lp* htable, const void* key)
+{
+	struct hashtable_lp_keyvalue_pair* result = NULL;
+	uint64_t hash = hashtable_lp_hashkey(htable, key);
+	pthread_mutex_lock(&(htable->lockfree->writelock));
+
+	struct hashtable_lp_lockfree_array* arr = atomic_load(&(htable->lockfree->array));
+	long slot = hashtable_lp_lockfree_find(htable, arr, key, hash);
+
+	if (slot >= 0) {
+		struct hashtable_lp_keyvalue_pair* kvp = atomic_load(&(arr->slots[slot]));
+
+		result = (struct hashtable_lp_keyvalue_pair*)malloc(sizeof(*result));
+		if (result == NULL) {
+			printf("Memory error: failed to allocate memory for removed key/value pair!");
+			abort();
+		}
+
+		*result = *kvp;
+		atomic_store_explicit(&(arr->slots[slot]), &hashtable_lp_lockfree_tombstone, memory_order_release);
+		hashtable_lp_lockfree_retire(htable->lockfree, kvp);
+		htable->count--;
+		htable->deleted++;
 	}
 
+	pthread_mutex_unlock(&(htable->lockfree->writelock));
 	return result;
 }
 
+/*
+ * Releases a lock-free hash table from memory.
+ * Note: no other thread may be using the table.
+ * */
+void hashtable_lp_lockfree_destroy(struct hashtable_lp* htable)
+{
+	struct hashtable_lp_lockfree_array* arr = atomic_load(&(htable->lockfree->array));
+
+	for (size_t i = 0; i < arr->capacity; ++i) {
+		struct hashtable_lp_keyvalue_pair* kvp = atomic_load(&(arr->slots[i]));
+		if ((kvp != NULL) && (kvp != &hashtable_lp_lockfree_tombstone)) {
+			if (htable->freedata)
+				htable->freedata(kvp);	// free key and value
+
+			free(kvp);
+		}
+	}
+
+	struct hashtable_lp_retired* item = htable->lockfree->retired;
+	while (item != NULL) {
+		struct hashtable_lp_retired* next = item->next;
+		free(item->ptr);
+		free(item);
+		item = next;
+	}
+
+	free(arr);
+	pthread_mutex_destroy(&(htable->lockfree->writelock));
+	free(htable->lockfree);
+	free(htable);
+}
+
+//--------------------- lock-free reads ------------------
+
 /*
  * Checks if a given hash array slot is empty.
  * Returns 1 if slot is empty, 0 otherwise.
@@ -201,9 +1202,9 @@ int hashtable_lp_isdeleted(struct hashtable_lp* htable, int slot) {
  * */
 void hashtable_lp_reallocate(struct hashtable_lp* htable, int new_size)
 {
+	DATASTATS_ONLY(uint64_t start = datastats_nanotime();)
 	int capacity = htable->capacity;
 	struct hashtable_lp_keyvalue_pair* kvp = NULL;
-	int hashvalue = -1;
 	int slot = -1;
 
 	// create new array
@@ -229,11 +1230,15 @@ void hashtable_lp_reallocate(struct hashtable_lp* htable, int new_size)
 			continue;
 		}
 
-		hashvalue = htable->hashfunc(kvp->key);
-		slot = hashvalue % new_size;
+		slot = hashtable_lp_slot_index(htable, kvp->hash, new_size);	// no need to re-hash the key
+
+		// move until an empty slot is found
+		while (new_array[slot]->key != NULL)
+			slot = (slot + 1) % new_size;
 
 		new_array[slot]->key = kvp->key;
 		new_array[slot]->value = kvp->value;
+		new_array[slot]->hash = kvp->hash;
 
 		free(kvp);
 	}
@@ -242,16 +1247,25 @@ void hashtable_lp_reallocate(struct hashtable_lp* htable, int new_size)
 	htable->harray = new_array;
 	htable->capacity = new_size;
 	htable->threshold = hashtable_lp_compute_threshold(new_size, htable->loadfactor);
+
+	DATASTATS_COUNT(htable->counters.resizes);
+	DATASTATS_ADD(htable->counters.resizens, datastats_nanotime() - start);
 }
 
 /*
- * Adds the key/value to the hash table.
+ * Adds the key/value with an already computed hash value to the hash table.
  * Returns 1 if succeeded, 0 otherwise.
  * */
-int hashtable_lp_put(struct hashtable_lp* htable, void* key, void* value) {
+int hashtable_lp_put_hashed(struct hashtable_lp* htable, void* key, void* value, uint64_t hash) {
+	if (htable->storage == HASHTABLE_LP_STORAGE_INLINE)
+		return hashtable_lp_inline_put(htable, key, value, hash);
+	else if (htable->storage == HASHTABLE_LP_STORAGE_ROBINHOOD)
+		return hashtable_lp_robinhood_put(htable, key, value, hash);
+	else if (htable->storage == HASHTABLE_LP_STORAGE_LOCKFREE)
+		return hashtable_lp_lockfree_put(htable, key, value, hash);
+
 	int result = 0;
-	int hashvalue = htable->hashfunc(key);
-	int slot = hashvalue % htable->capacity;
+	int slot = hashtable_lp_slot_index(htable, hash, htable->capacity);
 
 	// move until an empty or deleted slot is found
 	while (!hashtable_lp_isempty(htable, slot) && (!hashtable_lp_isdeleted(htable, slot)))
@@ -260,14 +1274,18 @@ int hashtable_lp_put(struct hashtable_lp* htable, void* key, void* value) {
 		slot = slot % htable->capacity;	// increment index and wrap around the table
 	}
 
+	DATASTATS_COUNT(htable->counters.puts);
+	DATASTATS_ADD(htable->counters.collisions, (slot != hashtable_lp_slot_index(htable, hash, htable->capacity)));
+
 	htable->harray[slot]->key = key;
 	htable->harray[slot]->value = value;
+	htable->harray[slot]->hash = hash;
 	htable->count++;
 
 	// if threshold reached, reallocate and re-ash
 	if (htable->count == htable->threshold) {
 //		printf("Reallocation after inserting %zu elements...\n", htable->count);
-		hashtable_lp_reallocate(htable, hashtable_lp_get_prime( htable->resizefactor * (float)(htable->capacity) ) );
+		hashtable_lp_reallocate(htable, hashtable_lp_next_capacity(htable));
 //		printf("After reallocating, capacity = %zu ...\n", htable->capacity);
 	}
 
@@ -275,15 +1293,30 @@ int hashtable_lp_put(struct hashtable_lp* htable, void* key, void* value) {
 	return result;
 }
 
+/*
+ * Adds the key/value to the hash table.
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int hashtable_lp_put(struct hashtable_lp* htable, void* key, void* value) {
+	return hashtable_lp_put_hashed(htable, key, value, hashtable_lp_hashkey(htable, key));
+}
+
 /*
  * Checks if hastable contains element with the given key.
  * Returns '1' (true) if succeeded, '0' (false) otherwise.
  * */
 int hashtable_lp_contains(const struct hashtable_lp* htable, const void* key)
 {
+	if (htable->storage == HASHTABLE_LP_STORAGE_INLINE)
+		return (hashtable_lp_inline_find(htable, key, hashtable_lp_hashkey(htable, key)) >= 0);
+	else if (htable->storage == HASHTABLE_LP_STORAGE_ROBINHOOD)
+		return (hashtable_lp_robinhood_find(htable, key, hashtable_lp_hashkey(htable, key)) >= 0);
+	else if (htable->storage == HASHTABLE_LP_STORAGE_LOCKFREE)
+		return hashtable_lp_lockfree_contains(htable, key, hashtable_lp_hashkey(htable, key));
+
 	int result= 0;
-	int hashvalue = htable->hashfunc(key);
-	int slot = hashvalue % htable->capacity;
+	uint64_t hash = hashtable_lp_hashkey(htable, key);
+	int slot = hashtable_lp_slot_index(htable, hash, htable->capacity);
 
 	if (hashtable_lp_isempty(htable, slot)) {
 		// not found
@@ -294,7 +1327,7 @@ int hashtable_lp_contains(const struct hashtable_lp* htable, const void* key)
 		// move until an empty slot is found or item found
 		while (!hashtable_lp_isempty(htable, slot))  {
 			// found item?
-			if (htable->isequal(key, htable->harray[slot]->key)) {
+			if ((htable->harray[slot]->hash == hash) && (htable->isequal(key, htable->harray[slot]->key))) {
 				result = 1;
 				break;
 			}
@@ -308,13 +1341,23 @@ int hashtable_lp_contains(const struct hashtable_lp* htable, const void* key)
 }
 
 /*
- * Gets the value associated with given key.
+ * Gets the value associated with given key with an already computed hash value.
  * Returns pointer to value if succeeded, NULL otherwise.
  * */
-void* hashtable_lp_get(const struct hashtable_lp* htable, const void* key) {
+void* hashtable_lp_get_hashed(const struct hashtable_lp* htable, const void* key, uint64_t hash) {
+	if (htable->storage == HASHTABLE_LP_STORAGE_INLINE) {
+		long slot = hashtable_lp_inline_find(htable, key, hash);
+		return (slot >= 0) ? htable->slots[slot].kvp.value : NULL;
+	}
+	else if (htable->storage == HASHTABLE_LP_STORAGE_ROBINHOOD) {
+		long slot = hashtable_lp_robinhood_find(htable, key, hash);
+		return (slot >= 0) ? htable->slots[slot].kvp.value : NULL;
+	}
+	else if (htable->storage == HASHTABLE_LP_STORAGE_LOCKFREE)
+		return hashtable_lp_lockfree_get(htable, key, hash);
+
 	void* result = NULL;
-	int hashvalue = htable->hashfunc(key);
-	int slot = hashvalue % htable->capacity;
+	int slot = hashtable_lp_slot_index(htable, hash, htable->capacity);
 
 	if (hashtable_lp_isempty(htable, slot)) {
 		// not found
@@ -325,7 +1368,7 @@ void* hashtable_lp_get(const struct hashtable_lp* htable, const void* key) {
 		// move until an empty slot is found or item found
 		while (!hashtable_lp_isempty(htable, slot))  {
 			// found item?
-			if (htable->isequal(key, htable->harray[slot]->key)) {
+			if ((htable->harray[slot]->hash == hash) && (htable->isequal(key, htable->harray[slot]->key))) {
 				result = htable->harray[slot]->value;
 				break;
 			}
@@ -338,15 +1381,87 @@ void* hashtable_lp_get(const struct hashtable_lp* htable, const void* key) {
 	return result;
 }
 
+/*
+ * Gets the value associated with given key.
+ * Returns pointer to value if succeeded, NULL otherwise.
+ * */
+void* hashtable_lp_get(const struct hashtable_lp* htable, const void* key) {
+	return hashtable_lp_get_hashed(htable, key, hashtable_lp_hashkey(htable, key));
+}
+
+/*
+ * Computes hash values of a chunk of keys and prefetches their home slots, so the
+ * cache misses of all keys in the chunk overlap.
+ * */
+void hashtable_lp_prefetch_chunk(const struct hashtable_lp* htable, void** keys, size_t n, uint64_t* hashes)
+{
+	for (size_t i = 0; i < n; ++i) {
+		hashes[i] = hashtable_lp_hashkey(htable, keys[i]);
+		size_t slot = hashtable_lp_slot_index(htable, hashes[i], htable->capacity);
+
+		if (htable->slots != NULL)
+			__builtin_prefetch(&(htable->slots[slot]));	// inline and robin hood storage
+		else if (htable->storage == HASHTABLE_LP_STORAGE_INDIRECT)
+			__builtin_prefetch(htable->harray[slot]);
+	}
+}
+
+/*
+ * Gets the values associated with an array of 'n' keys.
+ * out_values[i] receives the value of keys[i] or NULL if key was not found.
+ * */
+void hashtable_lp_get_batch(const struct hashtable_lp* htable, void** keys, size_t n, void** out_values)
+{
+	uint64_t hashes[HASHTABLE_LP_BATCH_CHUNK];
+
+	for (size_t start = 0; start < n; start += HASHTABLE_LP_BATCH_CHUNK) {
+		size_t len = (n - start < HASHTABLE_LP_BATCH_CHUNK) ? (n - start) : HASHTABLE_LP_BATCH_CHUNK;
+
+		hashtable_lp_prefetch_chunk(htable, keys + start, len, hashes);
+
+		for (size_t i = 0; i < len; ++i)
+			out_values[start + i] = hashtable_lp_get_hashed(htable, keys[start + i], hashes[i]);
+	}
+}
+
+/*
+ * Adds an array of 'n' key/value pairs to the hash table.
+ * Returns the number of pairs inserted.
+ * */
+size_t hashtable_lp_put_batch(struct hashtable_lp* htable, void** keys, void** values, size_t n)
+{
+	uint64_t hashes[HASHTABLE_LP_BATCH_CHUNK];
+	size_t result = 0;
+
+	for (size_t start = 0; start < n; start += HASHTABLE_LP_BATCH_CHUNK) {
+		size_t len = (n - start < HASHTABLE_LP_BATCH_CHUNK) ? (n - start) : HASHTABLE_LP_BATCH_CHUNK;
+
+		hashtable_lp_prefetch_chunk(htable, keys + start, len, hashes);
+
+		// inserts stay sequential (a resize may happen in between)
+		for (size_t i = 0; i < len; ++i)
+			result += hashtable_lp_put_hashed(htable, keys[start + i], values[start + i], hashes[i]);
+	}
+
+	return result;
+}
+
 /*
  * Deletes the value associated with given key.
  * Returns pointer to key/value pair if succeeded, NULL otherwise.
  * Note: Deleted bucket will be filled with dummy key/value pair values.
  * */
 struct hashtable_lp_keyvalue_pair* hashtable_lp_remove(struct hashtable_lp* htable, const void* key) {
+	if (htable->storage == HASHTABLE_LP_STORAGE_INLINE)
+		return hashtable_lp_inline_remove(htable, key);
+	else if (htable->storage == HASHTABLE_LP_STORAGE_ROBINHOOD)
+		return hashtable_lp_robinhood_remove(htable, key);
+	else if (htable->storage == HASHTABLE_LP_STORAGE_LOCKFREE)
+		return hashtable_lp_lockfree_remove(htable, key);
+
 	struct hashtable_lp_keyvalue_pair* result = NULL;
-	int hashvalue = htable->hashfunc(key);
-	int slot = hashvalue % htable->capacity;
+	uint64_t hash = hashtable_lp_hashkey(htable, key);
+	int slot = hashtable_lp_slot_index(htable, hash, htable->capacity);
 
 	if (hashtable_lp_isempty(htable, slot)) {
 		// not found
@@ -357,7 +1472,7 @@ struct hashtable_lp_keyvalue_pair* hashtable_lp_remove(struct hashtable_lp* htab
 		// move until an empty slot is found or item found
 		while (!hashtable_lp_isempty(htable, slot))  {
 			// found item?
-			if (htable->isequal(key, htable->harray[slot]->key)) {
+			if ((htable->harray[slot]->hash == hash) && (htable->isequal(key, htable->harray[slot]->key))) {
 				result = htable->harray[slot];
 				// mark as deleted key/value pair in slot
 				struct hashtable_lp_keyvalue_pair* new_kvp =
@@ -365,6 +1480,7 @@ struct hashtable_lp_keyvalue_pair* hashtable_lp_remove(struct hashtable_lp* htab
 				htable->harray[slot] = new_kvp;
 				htable->harray[slot]->key = htable->deleted_kvp->key;
 				htable->harray[slot]->value = htable->deleted_kvp->value;
+				htable->harray[slot]->hash = htable->deleted_kvp->hash;
 				htable->count--;
 				break;
 			}
@@ -377,6 +1493,28 @@ struct hashtable_lp_keyvalue_pair* hashtable_lp_remove(struct hashtable_lp* htab
 	return result;
 }
 
+/*
+ * Deletes the key/value pair from the hash table for a given key, without returning it.
+ * Robin hood tables erase without any allocation (other storages release the pair
+ * copy returned by hashtable_lp_remove). Key and value are not released.
+ * Returns 1 if succeeded, 0 otherwise (key not found).
+ * */
+int hashtable_lp_erase(struct hashtable_lp* htable, const void* key)
+{
+	if (htable->storage == HASHTABLE_LP_STORAGE_ROBINHOOD) {
+		long found = hashtable_lp_robinhood_find(htable, key, hashtable_lp_hashkey(htable, key));
+		if (found < 0)
+			return 0;
+
+		hashtable_lp_robinhood_unlink(htable, (size_t)found);
+		return 1;
+	}
+
+	struct hashtable_lp_keyvalue_pair* kvp = hashtable_lp_remove(htable, key);
+	free(kvp);
+	return (kvp != NULL);
+}
+
 /*
  * Prints the hashtable items.
  */
@@ -396,7 +1534,51 @@ void hashtable_lp_print(struct hashtable_lp* htable)
 	printf("{\n");
 	struct hashtable_lp_keyvalue_pair* kvp = NULL;
 
+	if (htable->storage == HASHTABLE_LP_STORAGE_LOCKFREE) {
+		// writers are blocked while printing
+		pthread_mutex_lock(&(htable->lockfree->writelock));
+		struct hashtable_lp_lockfree_array* arr = atomic_load(&(htable->lockfree->array));
+		cap = arr->capacity;
+
+		for (int i = 0; i < cap; ++i) {
+			kvp = atomic_load(&(arr->slots[i]));
+			if (kvp == NULL)
+				printf("%s%s", spaces, EMPTY_STR);
+			else if (kvp == &hashtable_lp_lockfree_tombstone)
+				printf("%s%s", spaces, DELETED_STR);
+			else {
+				printf("%s(", spaces);
+				htable->printitem(kvp);
+				printf(")");
+			}
+
+			if (i < (cap-1))
+				printf("%s", COMMA_STR);
+		}
+
+		pthread_mutex_unlock(&(htable->lockfree->writelock));
+		printf("\n}\n");
+		return;
+	}
+
 	for (int i = 0; i < cap; ++i) {
+		if (htable->slots != NULL) {		// inline and robin hood storage
+			kvp = &(htable->slots[i].kvp);
+			if (htable->slots[i].state == HASHTABLE_LP_SLOT_EMPTY)
+				printf("%s%s", spaces, EMPTY_STR);
+			else if (htable->slots[i].state == HASHTABLE_LP_SLOT_DELETED)
+				printf("%s%s", spaces, DELETED_STR);
+			else {
+				printf("%s(", spaces);
+				htable->printitem(kvp);
+				printf(")");
+			}
+
+			if (i < (cap-1))
+				printf("%s", COMMA_STR);
+			continue;
+		}
+
 		kvp = (struct hashtable_lp_keyvalue_pair*)htable->harray[i];
 
 		if (hashtable_lp_isempty(htable, i)) {
@@ -420,10 +1602,110 @@ void hashtable_lp_print(struct hashtable_lp* htable)
 	printf("\n}\n");
 }
 
+/*
+ * Takes a statistics snapshot of the hash table: histogram of the probe distance of
+ * every element (slots between its home slot and its slot, so a lookup of the
+ * element reads distance + 1 slots), deleted slots and the event counters, if
+ * compiled in.
+ * Note: lock-free tables must not have concurrent writers during the snapshot.
+ * */
+void hashtable_lp_stats(const struct hashtable_lp* htable, struct hashtable_lp_stats* stats)
+{
+	struct hashtable_lp_lockfree_array* arr = NULL;
+	size_t cap = htable->capacity;
+
+	*stats = (struct hashtable_lp_stats){ 0 };
+	if (htable->storage == HASHTABLE_LP_STORAGE_LOCKFREE) {
+		arr = atomic_load(&(htable->lockfree->array));
+		cap = arr->capacity;
+	}
+
+	for (size_t i = 0; i < cap; ++i) {
+		uint64_t hash = 0;
+
+		if (htable->slots != NULL) {		// inline and robin hood storage
+			stats->deleted += (htable->slots[i].state == HASHTABLE_LP_SLOT_DELETED);
+			if (htable->slots[i].state != HASHTABLE_LP_SLOT_FULL)
+				continue;
+
+			hash = htable->slots[i].kvp.hash;
+		}
+		else if (htable->storage == HASHTABLE_LP_STORAGE_LOCKFREE) {
+			struct hashtable_lp_keyvalue_pair* kvp = atomic_load_explicit(&(arr->slots[i]), memory_order_acquire);
+			stats->deleted += (kvp == &hashtable_lp_lockfree_tombstone);
+			if ((kvp == NULL) || (kvp == &hashtable_lp_lockfree_tombstone))
+				continue;
+
+			hash = kvp->hash;
+		}
+		else {
+			if (hashtable_lp_isempty(htable, i))
+				continue;
+
+			if (hashtable_lp_isdeleted((struct hashtable_lp*)htable, i)) {
+				stats->deleted++;
+				continue;
+			}
+
+			hash = htable->harray[i]->hash;
+		}
+
+		size_t home = hashtable_lp_slot_index(htable, hash, cap);
+		datastats_histogram_add(&(stats->probes), (i >= home) ? (i - home) : (i + cap - home));
+	}
+
+	stats->count = htable->count;
+	stats->capacity = cap;
+	stats->loadfactor = (cap > 0) ? (double)htable->count / (double)cap : 0.0;
+	stats->tombstoneratio = (cap > 0) ? (double)stats->deleted / (double)cap : 0.0;
+	stats->countersenabled = DATASTATS_ENABLED;
+	stats->counters = htable->counters;
+}
+
+/*
+ * Converts a statistics snapshot to a metric list (see datastats_print and
+ * datastats_export). 'metrics' must have room for DATASTATS_MAX_METRICS entries.
+ * Returns the number of metrics.
+ * */
+size_t hashtable_lp_stats_metrics(const struct hashtable_lp_stats* stats, struct datastats_metric* metrics)
+{
+	size_t n = 0;
+	metrics[n++] = (struct datastats_metric){ "count", (double)stats->count, NULL };
+	metrics[n++] = (struct datastats_metric){ "capacity", (double)stats->capacity, NULL };
+	metrics[n++] = (struct datastats_metric){ "load_factor", stats->loadfactor, NULL };
+	metrics[n++] = (struct datastats_metric){ "deleted_slots", (double)stats->deleted, NULL };
+	metrics[n++] = (struct datastats_metric){ "tombstone_ratio", stats->tombstoneratio, NULL };
+	metrics[n++] = (struct datastats_metric){ "probe_distance", 0, &(stats->probes) };
+
+	if (stats->countersenabled) {
+		metrics[n++] = (struct datastats_metric){ "puts", (double)stats->counters.puts, NULL };
+		metrics[n++] = (struct datastats_metric){ "collisions", (double)stats->counters.collisions, NULL };
+		metrics[n++] = (struct datastats_metric){ "resizes", (double)stats->counters.resizes, NULL };
+		metrics[n++] = (struct datastats_metric){ "resize_seconds", stats->counters.resizens / 1e9, NULL };
+	}
+
+	return n;
+}
+
 /*
  * Release hash table from memory.
  * */
 void hashtable_lp_destroy(struct hashtable_lp* htable) {
+	if (htable->storage == HASHTABLE_LP_STORAGE_LOCKFREE) {
+		hashtable_lp_lockfree_destroy(htable);
+		return;
+	}
+
+	if (htable->slots != NULL) {		// inline and robin hood storage
+		for (size_t i = 0; i < htable->capacity; ++i)
+			if ((htable->freedata) && (htable->slots[i].state == HASHTABLE_LP_SLOT_FULL))
+				htable->freedata(&(htable->slots[i].kvp));	// free key and value
+
+		free(htable->slots);
+		free(htable);
+		return;
+	}
+
 	free(htable->empty_kvp);
 	free(htable->deleted_kvp->key);
 	free(htable->deleted_kvp->value);
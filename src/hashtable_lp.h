@@ -30,6 +30,16 @@
  *  Linear Probing
  *
  *  In linear probing, collision is resolved by checking the next slot.
+ *
+ *  Robin Hood hashing (optional storage mode)
+ *
+ *  Each slot records the probe distance of its element (slots from its home slot).
+ *  An insert that meets an element closer to its home than the new one swaps them and
+ *  carries on with the displaced element ("takes from the rich"), so probe distances
+ *  stay short and even. Lookups stop as soon as they meet an element closer to home
+ *  than the searched key would be, which keeps misses short. Removes shift the
+ *  following elements one slot back (backward-shift deletion) instead of leaving
+ *  tombstones, so churn never lengthens probe chains and high load factors are usable.
  * ------------------------------------------------------
  *
  *  Hashing
@@ -45,23 +55,107 @@
 	#define HASHTABLE_LP_H_
 
 	#include <stdlib.h>
+	#include <stdint.h>
+	#include <stdatomic.h>
+	#include <pthread.h>
+	#include "datastats.h"
 
 	#define HASHTABLE_LP_DEFAULT_SIZE 25
 	#define HASHTABLE_LP_DEFAULT_LOAD_FACTOR 0.75
+	#define HASHTABLE_LP_ROBINHOOD_DEFAULT_LOAD_FACTOR 0.9		// robin hood tables stay fast when fuller
 	#define HASHTABLE_LP_MIN_SIZE 10
 	#define HASHTABLE_LP_RESIZE_FACTOR 2.0
+	#define HASHTABLE_LP_CACHE_LINE 64
+	#define HASHTABLE_LP_BATCH_CHUNK 16		// keys hashed and prefetched together by batch operations
+	#define HASHTABLE_LP_FIBONACCI_MULT 0x9E3779B97F4A7C15ULL	// 2^64 / golden ratio (64 bit hash tables)
+
+	// control states of an inline storage slot
+	#define HASHTABLE_LP_SLOT_EMPTY 0
+	#define HASHTABLE_LP_SLOT_FULL 1
+	#define HASHTABLE_LP_SLOT_DELETED 2
 
 	// key/value pair type
 	struct hashtable_lp_keyvalue_pair {
 		void* key;
 		void* value;
+		uint64_t hash;				// memoized key hash (skips rehashing and most 'isequal' calls)
+	};
+
+	// inline storage slot (key/value pair and control state stored side by side)
+	struct hashtable_lp_slot {
+		struct hashtable_lp_keyvalue_pair kvp;
+		unsigned char state;							// empty, full or deleted
+		uint32_t distance;								// slots from the home slot (robin hood storage only)
+	};
+
+	/*
+	 * Storage mode of the hash array.
+	 * 	- indirect: each slot points to a heap allocated key/value pair (default);
+	 * 	- inline: slots are stored by value in one flat array with a one-byte control
+	 * 			  state, so probing never chases pointers nor calls 'isequal' to
+	 * 			  detect empty or deleted slots.
+	 * 	- lock-free: slots are atomic pointers to immutable key/value pairs; readers
+	 * 				 take no locks and writers publish new pairs/arrays atomically.
+	 * 	- robin hood: inline slots that also keep the probe distance of their element;
+	 * 				  inserts displace elements closer to home, lookups stop early and
+	 * 				  removes shift elements back (no deleted slots).
+	 */
+	typedef enum { HASHTABLE_LP_STORAGE_INDIRECT = 0, HASHTABLE_LP_STORAGE_INLINE,
+				   HASHTABLE_LP_STORAGE_LOCKFREE, HASHTABLE_LP_STORAGE_ROBINHOOD } hashtable_lp_storage;
+
+	// slots array of lock-free tables (published to readers as a whole on resize)
+	struct hashtable_lp_lockfree_array {
+		size_t capacity;											// number of slots
+		_Atomic(struct hashtable_lp_keyvalue_pair*) slots[];		// NULL = empty slot
+	};
+
+	// memory unlinked by a writer, released when no reader can still see it
+	struct hashtable_lp_retired {
+		void* ptr;													// retired memory
+		unsigned long epoch;										// global epoch at retire time
+		struct hashtable_lp_retired* next;
+	};
+
+	// per thread reader record (epoch announced while reading, 0 when outside)
+	struct hashtable_lp_reader {
+		_Atomic unsigned long epoch;
+		_Atomic int inuse;											// owned by a live thread
+		struct hashtable_lp_reader* next;
+	} __attribute__((aligned(HASHTABLE_LP_CACHE_LINE)));
+
+	// state of lock-free tables
+	struct hashtable_lp_lockfree {
+		_Atomic(struct hashtable_lp_lockfree_array*) array;		// current slots array
+		pthread_mutex_t writelock;									// serializes writers
+		struct hashtable_lp_retired* retired;						// memory waiting to be released
 	};
 
 	typedef int (*hashtable_lp_hashfunc)(const void* key);
+	typedef uint64_t (*hashtable_lp_hashfunc64)(const void* key);
 	typedef int (*hashtable_lp_isequal)(const void* key1, const void* key2);
 	typedef void (*hashtable_lp_printitem)(const struct hashtable_lp_keyvalue_pair* kvp);
 	typedef void (*hashtable_lp_freedata)(void* data);
 
+	// event counters (only updated when built with CDATASTRUCT_STATS, see datastats.h)
+	struct hashtable_lp_counters {
+		size_t puts;									// inserted key/value pairs
+		size_t collisions;								// pairs inserted away from their home slot
+		size_t resizes;									// hash array reallocations (growth or cleanup of deleted slots)
+		uint64_t resizens;								// time spent resizing (ns)
+	};
+
+	// statistics snapshot of a hash table (see hashtable_lp_stats)
+	struct hashtable_lp_stats {
+		size_t count;
+		size_t capacity;
+		double loadfactor;								// count / capacity
+		size_t deleted;									// deleted slots (tombstones)
+		double tombstoneratio;							// deleted / capacity
+		struct datastats_histogram probes;				// distance of every element from its home slot
+		int countersenabled;							// counters below were compiled in
+		struct hashtable_lp_counters counters;
+	};
+
 
 	// hash table type
 	struct hashtable_lp {
@@ -70,6 +164,7 @@
 		size_t count;										// number of elements in the hashtable
 		size_t capacity;									// size of hash array
 		hashtable_lp_hashfunc hashfunc;					// hash function
+		hashtable_lp_hashfunc64 hashfunc64;				// 64 bit hash function (power of two capacity, NULL if unused)
 		hashtable_lp_isequal isequal;					// key compare for equality function
 		hashtable_lp_printitem printitem;				// function to print hastable item (key/value) pair
 		hashtable_lp_freedata freedata;					// release key/value from memory function
@@ -77,6 +172,11 @@
 		float loadfactor;								// fraction of hash array filled to generate a reallocation
 		float resizefactor;								// to compute new hash array size for reallocation (new_size = resizefactor * capacity)
 		struct hashtable_lp_keyvalue_pair** harray;		// hash array
+		hashtable_lp_storage storage;					// storage mode of the hash array
+		size_t deleted;									// number of deleted slots (inline storage only)
+		struct hashtable_lp_slot* slots;				// hash array of inline slots (inline and robin hood storage only)
+		struct hashtable_lp_lockfree* lockfree;			// lock-free reads state (lock-free storage only)
+		struct hashtable_lp_counters counters;			// event counters (see datastats.h)
 	};
 
 	/*
@@ -96,6 +196,94 @@
 											  hashtable_lp_printitem printitemfunc,
 											  hashtable_lp_freedata freedatafunc );
 
+	/*
+	 * Creates a new hash table with inline storage and default settings (size = 25, LF = 0.75).
+	 * */
+	struct hashtable_lp* hashtable_lp_create_inline_default( hashtable_lp_hashfunc hashfunc,
+															 hashtable_lp_isequal isequalfunc,
+															 hashtable_lp_printitem printitemfunc,
+															 hashtable_lp_freedata freedatafunc );
+
+	/*
+	 * Creates a new hash table with inline storage and given initial size and load factor.
+	 * Key, value and slot state are kept together in one flat array (no per-slot heap
+	 * records).
+	 * Note: unlike the default storage, duplicate keys are not allowed.
+	 * */
+	struct hashtable_lp* hashtable_lp_create_inline( size_t size, float loadfactor, float resizefactor,
+													 hashtable_lp_hashfunc hashfunc,
+													 hashtable_lp_isequal isequalfunc,
+													 hashtable_lp_printitem printitemfunc,
+													 hashtable_lp_freedata freedatafunc );
+
+	/*
+	 * Creates a new hash table using a 64 bit hash function, given initial size and load factor.
+	 * Capacity is rounded up to a power of two and slots are selected with fibonacci
+	 * (multiply-shift) hashing, so no division or prime search is ever needed.
+	 * */
+	struct hashtable_lp* hashtable_lp_create64( size_t size, float loadfactor, float resizefactor,
+												hashtable_lp_hashfunc64 hashfunc64,
+												hashtable_lp_isequal isequalfunc,
+												hashtable_lp_printitem printitemfunc,
+												hashtable_lp_freedata freedatafunc );
+
+	/*
+	 * Creates a new hash table with inline storage using a 64 bit hash function.
+	 * Capacity is rounded up to a power of two (see hashtable_lp_create64).
+	 * */
+	struct hashtable_lp* hashtable_lp_create_inline64( size_t size, float loadfactor, float resizefactor,
+													   hashtable_lp_hashfunc64 hashfunc64,
+													   hashtable_lp_isequal isequalfunc,
+													   hashtable_lp_printitem printitemfunc,
+													   hashtable_lp_freedata freedatafunc );
+
+	/*
+	 * Creates a new hash table with robin hood storage and default settings
+	 * (size = 25, LF = 0.9).
+	 * */
+	struct hashtable_lp* hashtable_lp_create_robinhood_default( hashtable_lp_hashfunc hashfunc,
+																hashtable_lp_isequal isequalfunc,
+																hashtable_lp_printitem printitemfunc,
+																hashtable_lp_freedata freedatafunc );
+
+	/*
+	 * Creates a new hash table with robin hood storage and given initial size and load factor.
+	 * Slots are inline (see hashtable_lp_create_inline) and keep the probe distance of
+	 * their element: inserts keep distances even, lookups of missing keys stop early and
+	 * removes use backward-shift deletion, so no deleted slots are ever left behind.
+	 * Note: duplicate keys are not allowed.
+	 * */
+	struct hashtable_lp* hashtable_lp_create_robinhood( size_t size, float loadfactor, float resizefactor,
+														hashtable_lp_hashfunc hashfunc,
+														hashtable_lp_isequal isequalfunc,
+														hashtable_lp_printitem printitemfunc,
+														hashtable_lp_freedata freedatafunc );
+
+	/*
+	 * Creates a new hash table with robin hood storage using a 64 bit hash function.
+	 * Capacity is rounded up to a power of two (see hashtable_lp_create64).
+	 * */
+	struct hashtable_lp* hashtable_lp_create_robinhood64( size_t size, float loadfactor, float resizefactor,
+														  hashtable_lp_hashfunc64 hashfunc64,
+														  hashtable_lp_isequal isequalfunc,
+														  hashtable_lp_printitem printitemfunc,
+														  hashtable_lp_freedata freedatafunc );
+
+	/*
+	 * Creates a new hash table with lock-free reads, given initial size and load factor.
+	 * hashtable_lp_get/hashtable_lp_contains take no locks and only write to a per
+	 * thread record, so reads scale with cores. Writers (put/remove) are serialized by
+	 * an internal mutex; replaced pairs and arrays are released with epoch based
+	 * reclamation once no reader can still reference them.
+	 * Notes: duplicate keys are not allowed; remove returns a copy that caller must
+	 * release; batch functions work but do not prefetch.
+	 * */
+	struct hashtable_lp* hashtable_lp_create_lockfree( size_t size, float loadfactor, float resizefactor,
+													   hashtable_lp_hashfunc hashfunc,
+													   hashtable_lp_isequal isequalfunc,
+													   hashtable_lp_printitem printitemfunc,
+													   hashtable_lp_freedata freedatafunc );
+
 	/*
 	 * Checks if hastable contains element with the given key.
 	 * Returns '1' (true) if succeeded, '0' (false) otherwise.
@@ -114,17 +302,55 @@
 	 * */
 	int hashtable_lp_put(struct hashtable_lp* htable, void* key, void* value);
 
+	/*
+	 * Gets the values associated with an array of 'n' keys.
+	 * out_values[i] receives the value of keys[i] or NULL if key was not found.
+	 * Keys are hashed and their slots prefetched in chunks before being resolved,
+	 * so memory accesses of different keys overlap.
+	 * */
+	void hashtable_lp_get_batch(const struct hashtable_lp* htable, void** keys, size_t n, void** out_values);
+
+	/*
+	 * Adds an array of 'n' key/value pairs to the hash table.
+	 * Returns the number of pairs inserted.
+	 * */
+	size_t hashtable_lp_put_batch(struct hashtable_lp* htable, void** keys, void** values, size_t n);
+
 	/*
 	 * Deletes the key/value pair from the hash table for a given key.
 	 * Returns removed key/value pair reference if succeeded, NULL otherwise.
 	 * */
 	struct hashtable_lp_keyvalue_pair* hashtable_lp_remove(struct hashtable_lp* htable, const void* key);
 
+	/*
+	 * Deletes the key/value pair from the hash table for a given key, without returning it.
+	 * Robin hood tables erase without any allocation (other storages release the pair
+	 * copy returned by hashtable_lp_remove). Key and value are not released.
+	 * Returns 1 if succeeded, 0 otherwise (key not found).
+	 * */
+	int hashtable_lp_erase(struct hashtable_lp* htable, const void* key);
+
 	/*
 	 * Prints the hashtable items.
 	 */
 	void hashtable_lp_print(struct hashtable_lp* htable);
 
+	/*
+	 * Takes a statistics snapshot of the hash table: histogram of the probe distance of
+	 * every element (slots between its home slot and its slot, so a lookup of the
+	 * element reads distance + 1 slots), deleted slots and the event counters, if
+	 * compiled in.
+	 * Note: lock-free tables must not have concurrent writers during the snapshot.
+	 * */
+	void hashtable_lp_stats(const struct hashtable_lp* htable, struct hashtable_lp_stats* stats);
+
+	/*
+	 * Converts a statistics snapshot to a metric list (see datastats_print and
+	 * datastats_export). 'metrics' must have room for DATASTATS_MAX_METRICS entries.
+	 * Returns the number of metrics.
+	 * */
+	size_t hashtable_lp_stats_metrics(const struct hashtable_lp_stats* stats, struct datastats_metric* metrics);
+
 	/*
 	 * Releases the hash table from memory.
 	 * */
@@ -0,0 +1,395 @@
+/********************************************************************************
+ * hashtable_simd.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Implements an hash table data structure in C using open addressing
+ *  			with group probing (swiss table layout).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Each slot has a control byte (EMPTY, DELETED or a 7 bit hash tag). Slots are
+ *  probed in groups of 16: the control bytes of a group are compared against the
+ *  tag of the searched key in one step, and only matching slots are compared with
+ *  'isequal'.
+ *
+ *  Group matching uses SSE2 on x86, NEON on AArch64 and a portable loop otherwise.
+ *
+ *  Source: https://abseil.io/about/design/swisstables
+ *
+ ***************************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#if defined(__SSE2__)
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	#include <arm_neon.h>
+#endif
+
+#include "hashtable_simd.h"
+
+/*
+ * Mixes the user hash value (bits of poor hash functions, like identity, are spread
+ * over the whole 64 bit word).
+ */
+uint64_t hashtable_simd_mix(int hashvalue)
+{
+	return (uint64_t)(unsigned int)hashvalue * 0x9E3779B97F4A7C15ULL;
+}
+
+/*
+ * Gets the group index where probing starts (h1).
+ */
+size_t hashtable_simd_h1(uint64_t hash, size_t groupmask)
+{
+	return (size_t)(hash >> 32) & groupmask;
+}
+
+/*
+ * Gets the 7 bit tag stored in control byte (h2).
+ */
+int8_t hashtable_simd_h2(uint64_t hash)
+{
+	return (int8_t)((hash >> 25) & 0x7F);
+}
+
+/*
+ * Compares the 16 control bytes of a group against a given byte.
+ * Returns a bit mask where bit i is set if ctrl[i] == b.
+ */
+unsigned int hashtable_simd_group_match(const int8_t* ctrl, int8_t b)
+{
+#if defined(__SSE2__)
+	__m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+	__m128i eq = _mm_cmpeq_epi8(group, _mm_set1_epi8(b));
+	return (unsigned int)_mm_movemask_epi8(eq);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+	uint8x16_t eq = vceqq_s8(vld1q_s8(ctrl), vdupq_n_s8(b));
+	uint8x16_t masked = vandq_u8(eq, vld1q_u8(bits));
+	return (unsigned int)vaddv_u8(vget_low_u8(masked))
+			| ((unsigned int)vaddv_u8(vget_high_u8(masked)) << 8);
+#else
+	unsigned int mask = 0;
+	for (int i = 0; i < HASHTABLE_SIMD_GROUP_SIZE; ++i)
+		if (ctrl[i] == b)
+			mask |= (1u << i);
+	return mask;
+#endif
+}
+
+/*
+ * Gets a bit mask of the empty or deleted slots of a group (control bytes with
+ * the high bit set).
+ */
+unsigned int hashtable_simd_group_match_free(const int8_t* ctrl)
+{
+#if defined(__SSE2__)
+	return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+	uint8x16_t neg = vcltq_s8(vld1q_s8(ctrl), vdupq_n_s8(0));
+	uint8x16_t masked = vandq_u8(neg, vld1q_u8(bits));
+	return (unsigned int)vaddv_u8(vget_low_u8(masked))
+			| ((unsigned int)vaddv_u8(vget_high_u8(masked)) << 8);
+#else
+	unsigned int mask = 0;
+	for (int i = 0; i < HASHTABLE_SIMD_GROUP_SIZE; ++i)
+		if (ctrl[i] < 0)
+			mask |= (1u << i);
+	return mask;
+#endif
+}
+
+/*
+ * Computes the threshold value.
+ * threshold = capacity * loadfactor (at least one slot is always left empty)
+ */
+size_t hashtable_simd_compute_threshold(size_t capacity, float loadfactor)
+{
+	size_t result = (size_t)((float)capacity * loadfactor);
+	return (result < capacity) ? result : (capacity - 1);
+}
+
+/*
+ * Allocates the control and slots arrays for a given number of groups.
+ */
+void hashtable_simd_allocate_arrays(struct hashtable_simd* htable, size_t ngroups)
+{
+	size_t capacity = ngroups * HASHTABLE_SIMD_GROUP_SIZE;
+
+	htable->ctrl = (int8_t*)malloc(capacity * sizeof(int8_t));
+	htable->slots = (struct hashtable_simd_keyvalue_pair*)malloc(capacity * sizeof(struct hashtable_simd_keyvalue_pair));
+
+	if ((htable->ctrl == NULL) || (htable->slots == NULL)) {
+		printf("Memory error: failed to allocate memory for hashtable arrays!");
+		abort();
+	}
+
+	memset(htable->ctrl, HASHTABLE_SIMD_CTRL_EMPTY, capacity);
+	htable->capacity = capacity;
+	htable->groupmask = ngroups - 1;
+	htable->deleted = 0;
+	htable->threshold = hashtable_simd_compute_threshold(capacity, htable->loadfactor);
+}
+
+/*
+ * Creates a new hash table with default settings (size = 32, LF = 0.875).
+ * */
+struct hashtable_simd* hashtable_simd_create_default( hashtable_simd_hashfunc hashfunc,
+													  hashtable_simd_isequal isequalfunc,
+													  hashtable_simd_printitem printitemfunc,
+													  hashtable_simd_freedata freedatafunc )
+{
+	return hashtable_simd_create( HASHTABLE_SIMD_DEFAULT_SIZE, HASHTABLE_SIMD_DEFAULT_LOAD_FACTOR,
+								  hashfunc, isequalfunc,
+								  printitemfunc, freedatafunc );
+}
+
+/*
+ * Creates a new hash table with given initial size and load factor.
+ * Size is rounded up to a power of two number of groups (16 slots each).
+ * */
+struct hashtable_simd* hashtable_simd_create( size_t size, float loadfactor,
+											  hashtable_simd_hashfunc hashfunc,
+											  hashtable_simd_isequal isequalfunc,
+											  hashtable_simd_printitem printitemfunc,
+											  hashtable_simd_freedata freedatafunc )
+{
+	assert(size > 0);
+	assert( (loadfactor > 0.1) && (loadfactor < 1.0) );
+
+	struct hashtable_simd* result = malloc(sizeof(*result));
+
+	if (result == NULL)
+		return result;
+	else {
+		size_t ngroups = 1;
+		while (ngroups * HASHTABLE_SIMD_GROUP_SIZE < size)
+			ngroups <<= 1;
+
+		result->loadfactor = loadfactor;
+		result->hashfunc = hashfunc;
+		result->isequal = isequalfunc;
+		result->printitem = printitemfunc;
+		result->freedata = freedatafunc;
+		result->count = 0;
+		hashtable_simd_allocate_arrays(result, ngroups);
+	}
+
+	return result;
+}
+
+/*
+ * Finds the slot holding a given key.
+ * Returns the slot index if found, -1 otherwise.
+ * */
+long hashtable_simd_find(const struct hashtable_simd* htable, const void* key)
+{
+	uint64_t hash = hashtable_simd_mix(htable->hashfunc(key));
+	int8_t tag = hashtable_simd_h2(hash);
+	size_t group = hashtable_simd_h1(hash, htable->groupmask);
+
+	for (size_t probe = 1; probe <= htable->groupmask + 1; ++probe) {
+		const int8_t* ctrl = htable->ctrl + group * HASHTABLE_SIMD_GROUP_SIZE;
+		unsigned int mask = hashtable_simd_group_match(ctrl, tag);
+
+		// compare keys of candidate slots only
+		while (mask) {
+			size_t slot = group * HASHTABLE_SIMD_GROUP_SIZE + __builtin_ctz(mask);
+			if (htable->isequal(key, htable->slots[slot].key))
+				return (long)slot;
+			mask &= mask - 1;	// clear lowest bit
+		}
+
+		// an empty slot ends the probe sequence
+		if (hashtable_simd_group_match(ctrl, HASHTABLE_SIMD_CTRL_EMPTY))
+			break;
+
+		group = (group + probe) & htable->groupmask;	// triangular probing
+	}
+
+	return -1;
+}
+
+/*
+ * Inserts a key/value pair in the first empty or deleted slot of its probe sequence,
+ * without checking for duplicates or threshold (used by put and rehash).
+ * */
+void hashtable_simd_place(struct hashtable_simd* htable, uint64_t hash, void* key, void* value)
+{
+	size_t group = hashtable_simd_h1(hash, htable->groupmask);
+
+	for (size_t probe = 1; ; ++probe) {
+		int8_t* ctrl = htable->ctrl + group * HASHTABLE_SIMD_GROUP_SIZE;
+		unsigned int mask = hashtable_simd_group_match_free(ctrl);
+
+		if (mask) {
+			int i = __builtin_ctz(mask);
+			if (ctrl[i] == HASHTABLE_SIMD_CTRL_DELETED)
+				htable->deleted--;
+
+			ctrl[i] = hashtable_simd_h2(hash);
+			htable->slots[group * HASHTABLE_SIMD_GROUP_SIZE + i].key = key;
+			htable->slots[group * HASHTABLE_SIMD_GROUP_SIZE + i].value = value;
+			return;
+		}
+
+		group = (group + probe) & htable->groupmask;
+	}
+}
+
+/*
+ * Rehashes all elements into new arrays with a given number of groups.
+ * Deleted slots are dropped in the process.
+ * */
+void hashtable_simd_reallocate(struct hashtable_simd* htable, size_t ngroups)
+{
+	int8_t* old_ctrl = htable->ctrl;
+	struct hashtable_simd_keyvalue_pair* old_slots = htable->slots;
+	size_t old_capacity = htable->capacity;
+
+	hashtable_simd_allocate_arrays(htable, ngroups);
+
+	for (size_t i = 0; i < old_capacity; ++i) {
+		if (old_ctrl[i] < 0)
+			continue;	// skip empty and deleted slots
+
+		uint64_t hash = hashtable_simd_mix(htable->hashfunc(old_slots[i].key));
+		hashtable_simd_place(htable, hash, old_slots[i].key, old_slots[i].value);
+	}
+
+	free(old_ctrl);
+	free(old_slots);
+}
+
+/*
+ * Checks if hastable contains element with the given key.
+ * Returns '1' (true) if succeeded, '0' (false) otherwise.
+ * */
+int hashtable_simd_contains(const struct hashtable_simd* htable, const void* key)
+{
+	return (hashtable_simd_find(htable, key) >= 0);
+}
+
+/*
+ * Gets the value associated with given key.
+ * Returns pointer to value if succeeded, NULL otherwise.
+ * */
+void* hashtable_simd_get(const struct hashtable_simd* htable, const void* key)
+{
+	long slot = hashtable_simd_find(htable, key);
+	return (slot >= 0) ? htable->slots[slot].value : NULL;
+}
+
+/*
+ * Adds the key/value to the hash table.
+ * Returns 1 if succeeded, 0 otherwise (key already exists).
+ * */
+int hashtable_simd_put(struct hashtable_simd* htable, void* key, void* value)
+{
+	if (hashtable_simd_find(htable, key) >= 0)
+		return 0;	// duplicated keys are not allowed
+
+	hashtable_simd_place(htable, hashtable_simd_mix(htable->hashfunc(key)), key, value);
+	htable->count++;
+
+	// if threshold reached (tombstones included), reallocate and re-hash.
+	// Only grow when live elements alone justify it.
+	if ((htable->count + htable->deleted) >= htable->threshold) {
+		size_t ngroups = htable->groupmask + 1;
+		if (htable->count >= htable->threshold / 2)
+			ngroups <<= 1;
+
+		hashtable_simd_reallocate(htable, ngroups);
+	}
+
+	return 1;
+}
+
+/*
+ * Deletes the key/value pair from the hash table for a given key.
+ * Returns a copy of removed key/value pair if succeeded, NULL otherwise.
+ * */
+struct hashtable_simd_keyvalue_pair* hashtable_simd_remove(struct hashtable_simd* htable, const void* key)
+{
+	struct hashtable_simd_keyvalue_pair* result = NULL;
+	long slot = hashtable_simd_find(htable, key);
+
+	if (slot >= 0) {
+		result = (struct hashtable_simd_keyvalue_pair*)malloc(sizeof(*result));
+		if (result == NULL) {
+			printf("Memory error: failed to allocate memory for removed key/value pair!");
+			abort();
+		}
+
+		*result = htable->slots[slot];
+
+		// if the group still has an empty slot no probe sequence goes past it,
+		// so the slot can be emptied instead of leaving a tombstone
+		int8_t* ctrl = htable->ctrl + (slot / HASHTABLE_SIMD_GROUP_SIZE) * HASHTABLE_SIMD_GROUP_SIZE;
+		if (hashtable_simd_group_match(ctrl, HASHTABLE_SIMD_CTRL_EMPTY))
+			htable->ctrl[slot] = HASHTABLE_SIMD_CTRL_EMPTY;
+		else {
+			htable->ctrl[slot] = HASHTABLE_SIMD_CTRL_DELETED;
+			htable->deleted++;
+		}
+
+		htable->count--;
+	}
+
+	return result;
+}
+
+/*
+ * Prints the hashtable items.
+ */
+void hashtable_simd_print(struct hashtable_simd* htable)
+{
+	if (!(htable->printitem)) {
+		printf("Error: 'printitem' function is undefined.");
+		abort();
+	}
+
+	const char* COMMA_STR = ",";
+	const char* spaces = " ";
+	size_t printed = 0;
+
+	printf("{\n");
+
+	for (size_t i = 0; i < htable->capacity; ++i) {
+		if (htable->ctrl[i] < 0)
+			continue;	// skip empty and deleted slots
+
+		printf("%s(", spaces);
+		htable->printitem(&(htable->slots[i]));
+		printf(")");
+
+		if (++printed < htable->count)
+			printf("%s", COMMA_STR);
+	}
+
+	printf("\n}\n");
+}
+
+/*
+ * Releases the hash table from memory.
+ * */
+void hashtable_simd_destroy(struct hashtable_simd* htable)
+{
+	if (htable->freedata)
+		for (size_t i = 0; i < htable->capacity; ++i)
+			if (htable->ctrl[i] >= 0)
+				htable->freedata(&(htable->slots[i]));	// free key and value
+
+	free(htable->ctrl);
+	free(htable->slots);
+	free(htable);
+}
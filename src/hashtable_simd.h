@@ -0,0 +1,134 @@
+/*****************************************************************************
+ * hashtable_simd.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: Implements an hash table data structure in C using open addressing
+ *  			 with group probing (swiss table layout).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Like linear probing, all key/value pairs live in one flat array. Next to it the
+ *  table keeps a control array with one byte per slot:
+ *
+ *  	- EMPTY   (1000 0000): slot was never used;
+ *  	- DELETED (1111 1110): slot held an element that was removed (tombstone);
+ *  	- FULL    (0xxx xxxx): slot is in use, low 7 bits store a tag taken from the
+ *  						   element hash (h2).
+ *
+ *  Slots are grouped 16 at a time. The remaining hash bits (h1) select the first
+ *  group to inspect. A lookup loads the 16 control bytes of a group and compares
+ *  all of them against the tag at once (SSE2 or NEON when available, a plain loop
+ *  otherwise), producing a bit mask of candidate slots. Only candidates are compared
+ *  with 'isequal', so almost every probe costs a single key comparison. If the group
+ *  has an EMPTY byte the key is not in the table, otherwise the next group is
+ *  inspected (triangular probing over groups).
+ *
+ *  Because a whole group is rejected in one step, long probe sequences are cheap and
+ *  the table can run at a load factor of 0.875 before growing.
+ *
+ *  Capacity is always a power of two multiple of the group size and doubles when
+ *  the threshold is reached.
+ *
+ *  Source: https://abseil.io/about/design/swisstables
+ *
+ *******************************************************************************/
+
+#ifndef HASHTABLE_SIMD_H_
+	#define HASHTABLE_SIMD_H_
+
+	#include <stdlib.h>
+	#include <stdint.h>
+
+	#define HASHTABLE_SIMD_GROUP_SIZE 16
+	#define HASHTABLE_SIMD_DEFAULT_SIZE 32
+	#define HASHTABLE_SIMD_DEFAULT_LOAD_FACTOR 0.875
+
+	// control bytes
+	#define HASHTABLE_SIMD_CTRL_EMPTY ((int8_t)-128)		// 0x80
+	#define HASHTABLE_SIMD_CTRL_DELETED ((int8_t)-2)		// 0xFE
+
+	// key/value pair type
+	struct hashtable_simd_keyvalue_pair {
+		void* key;
+		void* value;
+	};
+
+	typedef int (*hashtable_simd_hashfunc)(const void* key);
+	typedef int (*hashtable_simd_isequal)(const void* key1, const void* key2);
+	typedef void (*hashtable_simd_printitem)(const struct hashtable_simd_keyvalue_pair* kvp);
+	typedef void (*hashtable_simd_freedata)(void* data);
+
+	// hash table type
+	struct hashtable_simd {
+		size_t count;										// number of elements in the hashtable
+		size_t deleted;										// number of deleted slots (tombstones)
+		size_t capacity;									// size of hash array (multiple of group size)
+		size_t groupmask;									// number of groups - 1 (number of groups is a power of 2)
+		size_t threshold;									// limit of used slots to rise a reallocation (loadfactor * capacity)
+		float loadfactor;									// fraction of hash array filled to generate a reallocation
+		hashtable_simd_hashfunc hashfunc;					// hash function
+		hashtable_simd_isequal isequal;						// key compare for equality function
+		hashtable_simd_printitem printitem;					// function to print hastable item (key/value) pair
+		hashtable_simd_freedata freedata;					// release key/value from memory function
+		int8_t* ctrl;										// control bytes (one per slot)
+		struct hashtable_simd_keyvalue_pair* slots;			// hash array
+	};
+
+	/*
+	 * Creates a new hash table with default settings (size = 32, LF = 0.875).
+	 * */
+	struct hashtable_simd* hashtable_simd_create_default( hashtable_simd_hashfunc hashfunc,
+														  hashtable_simd_isequal isequalfunc,
+														  hashtable_simd_printitem printitemfunc,
+														  hashtable_simd_freedata freedatafunc );
+
+	/*
+	 * Creates a new hash table with given initial size and load factor.
+	 * Size is rounded up to a power of two number of groups (16 slots each).
+	 * Note: duplicate keys are not allowed.
+	 * */
+	struct hashtable_simd* hashtable_simd_create( size_t size, float loadfactor,
+												  hashtable_simd_hashfunc hashfunc,
+												  hashtable_simd_isequal isequalfunc,
+												  hashtable_simd_printitem printitemfunc,
+												  hashtable_simd_freedata freedatafunc );
+
+	/*
+	 * Checks if hastable contains element with the given key.
+	 * Returns '1' (true) if succeeded, '0' (false) otherwise.
+	 * */
+	int hashtable_simd_contains(const struct hashtable_simd* htable, const void* key);
+
+	/*
+	 * Gets the value associated with given key.
+	 * Returns pointer to value if succeeded, NULL otherwise.
+	 * */
+	void* hashtable_simd_get(const struct hashtable_simd* htable, const void* key);
+
+	/*
+	 * Adds the key/value to the hash table.
+	 * Returns 1 if succeeded, 0 otherwise (key already exists).
+	 * */
+	int hashtable_simd_put(struct hashtable_simd* htable, void* key, void* value);
+
+	/*
+	 * Deletes the key/value pair from the hash table for a given key.
+	 * Returns a copy of removed key/value pair if succeeded, NULL otherwise.
+	 * Note: returned pair must be released from memory by the caller.
+	 * */
+	struct hashtable_simd_keyvalue_pair* hashtable_simd_remove(struct hashtable_simd* htable, const void* key);
+
+	/*
+	 * Prints the hashtable items.
+	 */
+	void hashtable_simd_print(struct hashtable_simd* htable);
+
+	/*
+	 * Releases the hash table from memory.
+	 * */
+	void hashtable_simd_destroy(struct hashtable_simd* htable);
+
+#endif /* HASHTABLE_SIMD_H_ */
@@ -9,6 +9,8 @@
 #ifndef HEAPSTRUCT_H_
 	#define HEAPSTRUCT_H_
 
+	#include "datastats.h"
+
 	// callback function to calculate size of data in bytes
 //	typedef size_t (*heap_calcdatasize)(const void* data);
 	typedef int (*heap_cmp)(const void* data, const void* key);
@@ -30,6 +32,7 @@
 		void* MAXVALUE;
 		void* MINVALUE;
 		void** arr;
+		struct datastats_sift sift;		// sift counters (only updated when built with CDATASTRUCT_STATS)
 	};
 
 #endif /* HEAPSTRUCT_H_ */
@@ -143,6 +143,7 @@ struct idarypq* imindarypq_create( size_t degree, size_t maxSize,
 	result->compare = comparefunc;
 	result->printdata = printdatafunc;
 	result->freedata = freedatafunc;
+	result->sift = (struct datastats_sift){ 0 };
 
 	result->im = (int*)malloc(result->N * sizeof(int));
 	if (result->im == NULL) imindarypq_error("Error: failed to allocate memory for inverse map in priority queue!");
@@ -322,25 +323,35 @@ int imindarypq_minchild(struct idarypq* ipq, int i) {
  * Moves node at index i down the heap.
  */
 void imindarypq_sink(struct idarypq* ipq, int i) {
+    DATASTATS_ONLY(size_t levels = 0;)
     for (int j = imindarypq_minchild(ipq, i); j != -1; ) {
     	imindarypq_swap(ipq, i, j);
     	i = j;
     	j = imindarypq_minchild(ipq, i);
+    	DATASTATS_COUNT(levels);
     }
+
+    DATASTATS_COUNT(ipq->sift.downs);
+    DATASTATS_ONLY(datastats_histogram_add(&(ipq->sift.downdepth), levels);)
 }
 
 /*
  * Moves node at index i up the heap.
  */
 void imindarypq_swim(struct idarypq* ipq, int i) {
+	DATASTATS_ONLY(size_t levels = 0;)
 	int parent = ipq->parent[i];
 	if (parent > -1)
 		while (imindarypq_less_by_inv_index(ipq, i, parent)) {
 			imindarypq_swap(ipq, i, parent);
 			i = parent;
 			parent = ipq->parent[i];
+			DATASTATS_COUNT(levels);
 			if (parent < 0) break;
 		}
+
+	DATASTATS_COUNT(ipq->sift.ups);
+	DATASTATS_ONLY(datastats_histogram_add(&(ipq->sift.updepth), levels);)
 }
 
 /*
@@ -429,6 +440,26 @@ void imindarypq_increase(struct idarypq* ipq, int ki, void* value)
     }
 }
 
+/*
+ * Takes a statistics snapshot of the heap: size, capacity, height and the sift
+ * counters, if compiled in (see datastats_heap_metrics).
+ * */
+void imindarypq_stats(const struct idarypq* ipq, struct datastats_heap* stats)
+{
+	*stats = (struct datastats_heap){ 0 };
+	stats->size = ipq->sz;
+	stats->capacity = ipq->N;
+
+	// levels of a complete D-ary tree: 1 + D + D^2 + ... nodes
+	for (size_t nodes = 0, level = 1; nodes < ipq->sz; level *= ipq->D) {
+		nodes += level;
+		stats->height++;
+	}
+
+	stats->countersenabled = DATASTATS_ENABLED;
+	stats->sift = ipq->sift;
+}
+
 /*
  * Prints the heap indexed priority queue elements.
  */
@@ -451,17 +482,18 @@ void imindarypq_print( struct idarypq* ipq )
  */
 void imindarypq_destroy(struct idarypq* ipq)
 {
+	// values array is indexed by key index, live keys are im[0 .. sz-1]
+	if (ipq->freedata)
+		for (int i = 0; i < ipq->sz; ++i) {
+			if (ipq->values[ipq->im[i]] != NULL)
+				ipq->freedata( ipq->values[ipq->im[i]] );
+		}
+
 	free(ipq->parent);
 	free(ipq->child);
 	free(ipq->pm);
 	free(ipq->im);
 
-	if (ipq->freedata)
-		for (int i = 0; i < ipq->sz; ++i) {
-			if (ipq->values[i] != NULL)
-				ipq->freedata( ipq->values[i] );
-		}
-
 	free(ipq->values);
 	free(ipq);
 }
@@ -106,6 +106,7 @@
 #ifndef INDMINDARYHEAP_H_
 	#define INDMINDARYHEAP_H_
 	#include <stdlib.h>
+	#include "datastats.h"
 
 	typedef int (*idarypq_comparefunc)(const void* a, const void* b);
 	typedef void (*idarypq_freedata)(void* data);
@@ -136,6 +137,8 @@
 		// that this array is indexed by the key indexes (aka 'ki').
 		// this values store the priority of the heap nodes in the represented tree.
 		void** values;
+
+		struct datastats_sift sift;		// sift counters (only updated when built with CDATASTRUCT_STATS)
 	};
 
 	/*
@@ -222,6 +225,12 @@
 	 */
 	void imindarypq_print( struct idarypq* ipq );
 
+	/*
+	 * Takes a statistics snapshot of the heap: size, capacity, height and the sift
+	 * counters, if compiled in (see datastats_heap_metrics).
+	 * */
+	void imindarypq_stats(const struct idarypq* ipq, struct datastats_heap* stats);
+
 	/*
 	 * Releases priority queue instance from memory.
 	 */
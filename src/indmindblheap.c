@@ -0,0 +1,248 @@
+/*
+ * indmindblheap.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of an indexed min d-ary heap (indexed priority queue)
+ * 				whose priorities are plain doubles.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "indmindblheap.h"
+
+/*
+ * Initializes an indexed min heap of doubles with a maximum capacity of maxSize and
+ * the given degree (4: sibling group of one cache line, or 8: two cache lines).
+ */
+struct imindblpq* imindblpq_create_degree( int maxSize, int degree )
+{
+	if (degree != 4 && degree != 8) {
+		printf("Error: indexed priority queue degree must be 4 or 8; received: %d", degree);
+		abort();
+	}
+
+	struct imindblpq* result = (struct imindblpq*)malloc(sizeof(*result));
+	if (result == NULL) {
+		printf("Error: failed to allocate memory for indexed priority queue!");
+		abort();
+	}
+
+	result->N = (maxSize > 0) ? maxSize : 1;
+	result->sz = 0;
+	result->degree = degree;
+	result->pm = (int*)malloc(result->N * sizeof(int));
+
+	// position 'i' is entry 'i + degree - 1' of the block: children of a node
+	// (positions d * i + 1 to d * i + d) start at a multiple of 'degree'
+	size_t bytes = (result->N + degree - 1) * sizeof(struct imindblpq_item);
+	bytes = (bytes + IMINDBLPQ_CACHE_LINE - 1) / IMINDBLPQ_CACHE_LINE * IMINDBLPQ_CACHE_LINE;
+	result->block = aligned_alloc(IMINDBLPQ_CACHE_LINE, bytes);
+
+	if ((result->pm == NULL) || (result->block == NULL)) {
+		printf("Error: failed to allocate memory for indexed priority queue arrays!");
+		abort();
+	}
+
+	result->heap = (struct imindblpq_item*)result->block + (degree - 1);
+	for (int i = 0; i < result->N; ++i)
+		result->pm[i] = -1;
+
+	return result;
+}
+
+/*
+ * Initializes an indexed min 4-ary heap of doubles with a maximum capacity of maxSize.
+ */
+struct imindblpq* imindblpq_create( int maxSize )
+{
+	return imindblpq_create_degree(maxSize, IMINDBLPQ_DEGREE);
+}
+
+/*
+ * Checks if the priority heap is empty.
+ */
+int imindblpq_isempty( const struct imindblpq* ipq ) {
+	return (ipq->sz == 0);
+}
+
+/*
+ * Gets the number of elements on the indexed priority queue.
+ */
+int imindblpq_getsize( const struct imindblpq* ipq ) {
+	return ipq->sz;
+}
+
+/*
+ * Checks if an element with a given key index exists in the heap or not.
+ */
+int imindblpq_contains( const struct imindblpq* ipq, int ki ) {
+	return (ipq->pm[ki] != -1);
+}
+
+/*
+ * Returns the priority stored at a given key index.
+ * Note: key index must be in the heap.
+ */
+double imindblpq_valueof( const struct imindblpq* ipq, int ki ) {
+	return ipq->heap[ipq->pm[ki]].value;
+}
+
+/*
+ * Moves entry 'item' up from heap position 'i' until heap property holds.
+ */
+void imindblpq_swim( struct imindblpq* ipq, int i, struct imindblpq_item item )
+{
+	struct imindblpq_item* heap = ipq->heap;
+	int d = ipq->degree;
+
+	// shift parents down instead of swapping, the entry is written once
+	while (i > 0) {
+		int p = (i - 1) / d;
+		if (!(item.value < heap[p].value))
+			break;
+
+		heap[i] = heap[p];
+		ipq->pm[heap[i].ki] = i;
+		i = p;
+	}
+
+	heap[i] = item;
+	ipq->pm[item.ki] = i;
+}
+
+/*
+ * Moves entry 'item' down from heap position 'i' until heap property holds.
+ */
+void imindblpq_sink( struct imindblpq* ipq, int i, struct imindblpq_item item )
+{
+	struct imindblpq_item* heap = ipq->heap;
+	int d = ipq->degree;
+	int sz = ipq->sz;
+
+	for (;;) {
+		int first = i * d + 1;
+		if (first >= sz)
+			break;
+
+		int last = first + d;
+		if (last > sz)
+			last = sz;
+
+		// find smallest child (all children are in the same cache line with degree 4)
+		int min = first;
+		double minvalue = heap[first].value;
+		for (int c = first + 1; c < last; ++c) {
+			if (heap[c].value < minvalue) {
+				min = c;
+				minvalue = heap[c].value;
+			}
+		}
+
+		if (!(minvalue < item.value))
+			break;
+
+		heap[i] = heap[min];
+		ipq->pm[heap[i].ki] = i;
+		i = min;
+	}
+
+	heap[i] = item;
+	ipq->pm[item.ki] = i;
+}
+
+/*
+ * Inserts a new element in the heap at a given key index.
+ * Note: If key index already contains an element in the heap, an error will be throw.
+ */
+void imindblpq_insert( struct imindblpq* ipq, int ki, double value )
+{
+	if (imindblpq_contains(ipq, ki)) {
+		printf("Error: index already exists in indexed priority queue; received: %d", ki);
+		abort();
+	}
+
+	struct imindblpq_item item = { value, ki };
+	imindblpq_swim(ipq, ipq->sz++, item);
+}
+
+/*
+ * Strictly decreases the priority associated with 'ki' to 'value'.
+ * Nothing is done if 'value' is not smaller than the current priority.
+ */
+void imindblpq_decrease( struct imindblpq* ipq, int ki, double value )
+{
+	int i = ipq->pm[ki];
+	if (value < ipq->heap[i].value) {
+		struct imindblpq_item item = { value, ki };
+		imindblpq_swim(ipq, i, item);
+	}
+}
+
+/*
+ * Inserts element if 'ki' is not in the heap, otherwise decreases its priority.
+ */
+void imindblpq_push( struct imindblpq* ipq, int ki, double value )
+{
+	if (imindblpq_contains(ipq, ki))
+		imindblpq_decrease(ipq, ki, value);
+	else
+		imindblpq_insert(ipq, ki, value);
+}
+
+/*
+ * Returns the key index with minimum priority (does not remove it).
+ */
+int imindblpq_peekkeyindex( const struct imindblpq* ipq ) {
+	return ipq->heap[0].ki;
+}
+
+/*
+ * Returns the minimum priority (does not remove it).
+ */
+double imindblpq_peekvalue( const struct imindblpq* ipq ) {
+	return ipq->heap[0].value;
+}
+
+/*
+ * Removes the element with minimum priority.
+ * Returns the key index of the removed element.
+ */
+int imindblpq_extractkeyindex( struct imindblpq* ipq )
+{
+	if (ipq->sz == 0) {
+		printf("Error: indexed priority queue is empty!");
+		abort();
+	}
+
+	int result = ipq->heap[0].ki;
+	ipq->sz--;
+	ipq->pm[result] = -1;
+
+	if (ipq->sz > 0)
+		imindblpq_sink(ipq, 0, ipq->heap[ipq->sz]);	// last entry goes to root
+
+	return result;
+}
+
+/*
+ * Removes all elements from the heap in O(size). The heap can be reused.
+ */
+void imindblpq_clear( struct imindblpq* ipq )
+{
+	for (int i = 0; i < ipq->sz; ++i)
+		ipq->pm[ipq->heap[i].ki] = -1;
+
+	ipq->sz = 0;
+}
+
+/*
+ * Releases priority queue instance from memory.
+ */
+void imindblpq_destroy( struct imindblpq* ipq )
+{
+	free(ipq->pm);
+	free(ipq->block);
+	free(ipq);
+}
@@ -0,0 +1,139 @@
+/*
+ * indmindblheap.h
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Headers for an indexed min d-ary heap (indexed priority queue) whose
+ * 				priorities are plain doubles.
+ *
+ * 		Same model as the generic indexed priority queue (see indmindaryheap.h): each element
+ * 		has a key index 'ki' in the domain [0, N) and a priority, here a 'double' stored by
+ * 		value.
+ *
+ * 		Storing priorities by value removes the per element allocation and the comparison
+ * 		callback of the generic heap: priorities are compared with '<' and nothing is
+ * 		allocated after creation, which is what shortest path algorithms need (one insert or
+ * 		decrease per relaxed edge).
+ *
+ * 		A 4-ary layout is used by default (8-ary with imindblpq_create_degree): the tree is
+ * 		shallower than a binary heap and the children of a node are contiguous in memory.
+ *
+ * 		Cache layout: a heap entry keeps the priority and the key index side by side (16
+ * 		bytes), so a sift compares and moves entries of one array only (the position map is
+ * 		written once per moved entry). Children and parent positions are computed
+ * 		(d * i + 1, (i - 1) / d). The array is cache line aligned and shifted by d - 1
+ * 		entries, so the d children of a node always start a cache line: a sift down reads
+ * 		one cache line per level (two with degree 8).
+ *
+ * 		  Time complexity by operation
+ *	-----------------------------------------
+ * 	|	contains(ki) 			| O(1)		|
+ * 	|	peekkeyindex 			| O(1)		|
+ * 	|	extractkeyindex 		| O(logn)	|
+ * 	|	insert(ki, value) 		| O(logn)	|
+ * 	|	decrease(ki, value) 	| O(logn)	|
+ * 	|	clear			 		| O(sz)		|
+ *	-----------------------------------------
+ *
+ */
+
+#ifndef INDMINDBLHEAP_H_
+	#define INDMINDBLHEAP_H_
+
+	#include <stdlib.h>
+
+	#define IMINDBLPQ_DEGREE 4			// default degree (4 entries: one cache line)
+	#define IMINDBLPQ_CACHE_LINE 64
+
+	// heap entry: priority and key index side by side
+	struct imindblpq_item {
+		double value;		// Priority.
+		int ki;				// Key index.
+	};
+
+	// indexed min heap of doubles
+	struct imindblpq {
+		int N;				// Maximum number of elements in the heap (key indexes in [0, N)).
+		int sz;				// Current number of elements in the heap.
+		int degree;			// Number of children of a node (4 or 8).
+		int* pm;			// Position map: heap position of a key index (-1 if not in heap).
+		struct imindblpq_item* heap;	// Heap entries by position (inside 'block').
+		void* block;		// Cache line aligned allocation of the entries.
+	};
+
+	/*
+	 * Initializes an indexed min 4-ary heap of doubles with a maximum capacity of maxSize.
+	 */
+	struct imindblpq* imindblpq_create( int maxSize );
+
+	/*
+	 * Initializes an indexed min heap of doubles with a maximum capacity of maxSize and
+	 * the given degree (4: sibling group of one cache line, or 8: two cache lines).
+	 */
+	struct imindblpq* imindblpq_create_degree( int maxSize, int degree );
+
+	/*
+	 * Checks if the priority heap is empty.
+	 */
+	int imindblpq_isempty( const struct imindblpq* ipq );
+
+	/*
+	 * Gets the number of elements on the indexed priority queue.
+	 */
+	int imindblpq_getsize( const struct imindblpq* ipq );
+
+	/*
+	 * Checks if an element with a given key index exists in the heap or not.
+	 */
+	int imindblpq_contains( const struct imindblpq* ipq, int ki );
+
+	/*
+	 * Returns the priority stored at a given key index.
+	 * Note: key index must be in the heap.
+	 */
+	double imindblpq_valueof( const struct imindblpq* ipq, int ki );
+
+	/*
+	 * Inserts a new element in the heap at a given key index.
+	 * Note: If key index already contains an element in the heap, an error will be throw.
+	 */
+	void imindblpq_insert( struct imindblpq* ipq, int ki, double value );
+
+	/*
+	 * Strictly decreases the priority associated with 'ki' to 'value'.
+	 * Nothing is done if 'value' is not smaller than the current priority.
+	 */
+	void imindblpq_decrease( struct imindblpq* ipq, int ki, double value );
+
+	/*
+	 * Inserts element if 'ki' is not in the heap, otherwise decreases its priority.
+	 */
+	void imindblpq_push( struct imindblpq* ipq, int ki, double value );
+
+	/*
+	 * Returns the key index with minimum priority (does not remove it).
+	 */
+	int imindblpq_peekkeyindex( const struct imindblpq* ipq );
+
+	/*
+	 * Returns the minimum priority (does not remove it).
+	 */
+	double imindblpq_peekvalue( const struct imindblpq* ipq );
+
+	/*
+	 * Removes the element with minimum priority.
+	 * Returns the key index of the removed element.
+	 */
+	int imindblpq_extractkeyindex( struct imindblpq* ipq );
+
+	/*
+	 * Removes all elements from the heap in O(size). The heap can be reused.
+	 */
+	void imindblpq_clear( struct imindblpq* ipq );
+
+	/*
+	 * Releases priority queue instance from memory.
+	 */
+	void imindblpq_destroy( struct imindblpq* ipq );
+
+#endif /* INDMINDBLHEAP_H_ */
@@ -0,0 +1,627 @@
+/*
+ * intrusive.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Intrusive doubly linked list, red-black tree and chained hash table.
+ */
+
+#include <stdlib.h>
+#include "intrusive.h"
+
+/*
+ * ------------------------------------------------------------
+ * Intrusive doubly linked list
+ * ------------------------------------------------------------
+ */
+
+/*
+ * Initializes an empty list.
+ * */
+void ilist_init(struct ilist* list)
+{
+	list->head.prev = list->head.next = &(list->head);
+	list->size = 0;
+}
+
+/*
+ * Checks if list is empty.
+ * Returns 1 if is empty, 0 otherwise.
+ * */
+int ilist_isempty(const struct ilist* list)
+{
+	return (list->head.next == &(list->head));
+}
+
+/*
+ * Gets the first / last node, NULL if list is empty.
+ * */
+struct ilist_node* ilist_first(const struct ilist* list)
+{
+	return ilist_isempty(list) ? NULL : list->head.next;
+}
+
+struct ilist_node* ilist_last(const struct ilist* list)
+{
+	return ilist_isempty(list) ? NULL : list->head.prev;
+}
+
+/*
+ * Gets the next / previous node, NULL at the end.
+ * */
+struct ilist_node* ilist_next(const struct ilist* list, const struct ilist_node* node)
+{
+	return (node->next == &(list->head)) ? NULL : node->next;
+}
+
+struct ilist_node* ilist_prev(const struct ilist* list, const struct ilist_node* node)
+{
+	return (node->prev == &(list->head)) ? NULL : node->prev;
+}
+
+/*
+ * Links 'node' between two adjacent nodes.
+ * Note: Private function.
+ * */
+void ilist_link(struct ilist* list, struct ilist_node* prev, struct ilist_node* next,
+				struct ilist_node* node)
+{
+	node->prev = prev;
+	node->next = next;
+	prev->next = node;
+	next->prev = node;
+	list->size++;
+}
+
+/*
+ * Links 'node' at the begin / end of the list.
+ * */
+void ilist_push_front(struct ilist* list, struct ilist_node* node)
+{
+	ilist_link(list, &(list->head), list->head.next, node);
+}
+
+void ilist_push_back(struct ilist* list, struct ilist_node* node)
+{
+	ilist_link(list, list->head.prev, &(list->head), node);
+}
+
+/*
+ * Links 'node' after / before 'pos' (a node of the list).
+ * */
+void ilist_insert_after(struct ilist* list, struct ilist_node* pos, struct ilist_node* node)
+{
+	ilist_link(list, pos, pos->next, node);
+}
+
+void ilist_insert_before(struct ilist* list, struct ilist_node* pos, struct ilist_node* node)
+{
+	ilist_link(list, pos->prev, pos, node);
+}
+
+/*
+ * Unlinks 'node' (a node of the list), in O(1).
+ * */
+void ilist_remove(struct ilist* list, struct ilist_node* node)
+{
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	node->prev = node->next = NULL;
+	list->size--;
+}
+
+/*
+ * Unlinks the first / last node.
+ * Returns the node, NULL if list is empty.
+ * */
+struct ilist_node* ilist_pop_front(struct ilist* list)
+{
+	struct ilist_node* node = ilist_first(list);
+	if (node != NULL)
+		ilist_remove(list, node);
+
+	return node;
+}
+
+struct ilist_node* ilist_pop_back(struct ilist* list)
+{
+	struct ilist_node* node = ilist_last(list);
+	if (node != NULL)
+		ilist_remove(list, node);
+
+	return node;
+}
+
+/*
+ * Moves 'node' (a node of the list) to the begin of the list, in O(1).
+ * */
+void ilist_move_front(struct ilist* list, struct ilist_node* node)
+{
+	if (list->head.next == node)
+		return;
+
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	list->size--;
+	ilist_push_front(list, node);
+}
+
+/*
+ * ------------------------------------------------------------
+ * Intrusive red-black tree
+ * ------------------------------------------------------------
+ */
+
+/*
+ * Initializes an empty tree ordered by 'compare'.
+ * */
+void irbtree_init(struct irbtree* tree, irbtree_cmp compare)
+{
+	tree->root = NULL;
+	tree->compare = compare;
+	tree->size = 0;
+}
+
+/*
+ * Rotates left at 'x' (its right child takes its place).
+ * Note: Private function.
+ * */
+void irbtree_rotate_left(struct irbtree* tree, struct irbtree_node* x)
+{
+	struct irbtree_node* y = x->right;
+	x->right = y->left;
+	if (y->left != NULL)
+		y->left->parent = x;
+
+	y->parent = x->parent;
+	if (x->parent == NULL)
+		tree->root = y;
+	else if (x == x->parent->left)
+		x->parent->left = y;
+	else
+		x->parent->right = y;
+
+	y->left = x;
+	x->parent = y;
+}
+
+/*
+ * Rotates right at 'x' (its left child takes its place).
+ * Note: Private function.
+ * */
+void irbtree_rotate_right(struct irbtree* tree, struct irbtree_node* x)
+{
+	struct irbtree_node* y = x->left;
+	x->left = y->right;
+	if (y->right != NULL)
+		y->right->parent = x;
+
+	y->parent = x->parent;
+	if (x->parent == NULL)
+		tree->root = y;
+	else if (x == x->parent->right)
+		x->parent->right = y;
+	else
+		x->parent->left = y;
+
+	y->right = x;
+	x->parent = y;
+}
+
+/*
+ * Links 'node' in the tree, in O(log n) (no allocation).
+ * Returns NULL if succeeded, or the node already in the tree with an equal key
+ * ('node' is not linked).
+ * */
+struct irbtree_node* irbtree_insert(struct irbtree* tree, struct irbtree_node* node)
+{
+	struct irbtree_node* parent = NULL;
+	struct irbtree_node** link = &(tree->root);
+	while (*link != NULL) {
+		parent = *link;
+		int c = tree->compare(node, parent);
+		if (c < 0)
+			link = &(parent->left);
+		else if (c > 0)
+			link = &(parent->right);
+		else
+			return parent;
+	}
+
+	node->parent = parent;
+	node->left = node->right = NULL;
+	node->red = 1;
+	*link = node;
+	tree->size++;
+
+	// fix red parent / red child violations
+	struct irbtree_node* z = node;
+	while (z->parent != NULL && z->parent->red) {
+		struct irbtree_node* p = z->parent;
+		struct irbtree_node* g = p->parent;		// exists, a red node is not the root
+		if (p == g->left) {
+			struct irbtree_node* u = g->right;
+			if (u != NULL && u->red) {
+				p->red = u->red = 0;
+				g->red = 1;
+				z = g;
+			}
+			else {
+				if (z == p->right) {
+					z = p;
+					irbtree_rotate_left(tree, z);
+					p = z->parent;
+				}
+
+				p->red = 0;
+				g->red = 1;
+				irbtree_rotate_right(tree, g);
+			}
+		}
+		else {
+			struct irbtree_node* u = g->left;
+			if (u != NULL && u->red) {
+				p->red = u->red = 0;
+				g->red = 1;
+				z = g;
+			}
+			else {
+				if (z == p->left) {
+					z = p;
+					irbtree_rotate_right(tree, z);
+					p = z->parent;
+				}
+
+				p->red = 0;
+				g->red = 1;
+				irbtree_rotate_left(tree, g);
+			}
+		}
+	}
+
+	tree->root->red = 0;
+	return NULL;
+}
+
+/*
+ * Searches a node equal to 'key'.
+ * Returns the node if found, NULL otherwise.
+ * */
+struct irbtree_node* irbtree_find(const struct irbtree* tree, const void* key,
+								  irbtree_keycmp keycompare)
+{
+	struct irbtree_node* node = tree->root;
+	while (node != NULL) {
+		int c = keycompare(key, node);
+		if (c == 0)
+			return node;
+
+		node = (c < 0) ? node->left : node->right;
+	}
+
+	return NULL;
+}
+
+/*
+ * Searches the first node not lesser than 'key'.
+ * Returns the node if found, NULL otherwise.
+ * */
+struct irbtree_node* irbtree_lower_bound(const struct irbtree* tree, const void* key,
+										 irbtree_keycmp keycompare)
+{
+	struct irbtree_node* result = NULL;
+	struct irbtree_node* node = tree->root;
+	while (node != NULL) {
+		if (keycompare(key, node) <= 0) {
+			result = node;
+			node = node->left;
+		}
+		else
+			node = node->right;
+	}
+
+	return result;
+}
+
+/*
+ * Replaces subtree 'u' by subtree 'v' in the parent of 'u'.
+ * Note: Private function.
+ * */
+void irbtree_transplant(struct irbtree* tree, struct irbtree_node* u, struct irbtree_node* v)
+{
+	if (u->parent == NULL)
+		tree->root = v;
+	else if (u == u->parent->left)
+		u->parent->left = v;
+	else
+		u->parent->right = v;
+
+	if (v != NULL)
+		v->parent = u->parent;
+}
+
+/*
+ * Gets the leftmost node of a subtree.
+ * Note: Private function.
+ * */
+struct irbtree_node* irbtree_minimum(struct irbtree_node* node)
+{
+	while (node->left != NULL)
+		node = node->left;
+
+	return node;
+}
+
+/*
+ * Unlinks 'node' (a node of the tree), in O(log n) without key compares.
+ * */
+void irbtree_remove(struct irbtree* tree, struct irbtree_node* node)
+{
+	struct irbtree_node* x;
+	struct irbtree_node* xparent;
+	int removedred = node->red;
+
+	if (node->left == NULL) {
+		x = node->right;
+		xparent = node->parent;
+		irbtree_transplant(tree, node, node->right);
+	}
+	else if (node->right == NULL) {
+		x = node->left;
+		xparent = node->parent;
+		irbtree_transplant(tree, node, node->left);
+	}
+	else {
+		// successor takes the place (and color) of node
+		struct irbtree_node* y = irbtree_minimum(node->right);
+		removedred = y->red;
+		x = y->right;
+		if (y->parent == node)
+			xparent = y;
+		else {
+			xparent = y->parent;
+			irbtree_transplant(tree, y, y->right);
+			y->right = node->right;
+			y->right->parent = y;
+		}
+
+		irbtree_transplant(tree, node, y);
+		y->left = node->left;
+		y->left->parent = y;
+		y->red = node->red;
+	}
+
+	tree->size--;
+	node->parent = node->left = node->right = NULL;
+	if (removedred)
+		return;
+
+	// 'x' carries an extra black
+	while (x != tree->root && (x == NULL || !x->red)) {
+		if (x == xparent->left) {
+			struct irbtree_node* w = xparent->right;
+			if (w->red) {
+				w->red = 0;
+				xparent->red = 1;
+				irbtree_rotate_left(tree, xparent);
+				w = xparent->right;
+			}
+
+			if ((w->left == NULL || !w->left->red) && (w->right == NULL || !w->right->red)) {
+				w->red = 1;
+				x = xparent;
+				xparent = x->parent;
+			}
+			else {
+				if (w->right == NULL || !w->right->red) {
+					w->left->red = 0;
+					w->red = 1;
+					irbtree_rotate_right(tree, w);
+					w = xparent->right;
+				}
+
+				w->red = xparent->red;
+				xparent->red = 0;
+				if (w->right != NULL)
+					w->right->red = 0;
+				irbtree_rotate_left(tree, xparent);
+				x = tree->root;
+			}
+		}
+		else {
+			struct irbtree_node* w = xparent->left;
+			if (w->red) {
+				w->red = 0;
+				xparent->red = 1;
+				irbtree_rotate_right(tree, xparent);
+				w = xparent->left;
+			}
+
+			if ((w->right == NULL || !w->right->red) && (w->left == NULL || !w->left->red)) {
+				w->red = 1;
+				x = xparent;
+				xparent = x->parent;
+			}
+			else {
+				if (w->left == NULL || !w->left->red) {
+					w->right->red = 0;
+					w->red = 1;
+					irbtree_rotate_left(tree, w);
+					w = xparent->left;
+				}
+
+				w->red = xparent->red;
+				xparent->red = 0;
+				if (w->left != NULL)
+					w->left->red = 0;
+				irbtree_rotate_right(tree, xparent);
+				x = tree->root;
+			}
+		}
+	}
+
+	if (x != NULL)
+		x->red = 0;
+}
+
+/*
+ * Gets the first / last node in order, NULL if tree is empty.
+ * */
+struct irbtree_node* irbtree_first(const struct irbtree* tree)
+{
+	return (tree->root != NULL) ? irbtree_minimum(tree->root) : NULL;
+}
+
+struct irbtree_node* irbtree_last(const struct irbtree* tree)
+{
+	struct irbtree_node* node = tree->root;
+	if (node != NULL)
+		while (node->right != NULL)
+			node = node->right;
+
+	return node;
+}
+
+/*
+ * Gets the next / previous node in order, NULL at the end.
+ * */
+struct irbtree_node* irbtree_next(const struct irbtree_node* node)
+{
+	if (node->right != NULL)
+		return irbtree_minimum(node->right);
+
+	while (node->parent != NULL && node == node->parent->right)
+		node = node->parent;
+
+	return node->parent;
+}
+
+struct irbtree_node* irbtree_prev(const struct irbtree_node* node)
+{
+	if (node->left != NULL) {
+		struct irbtree_node* result = node->left;
+		while (result->right != NULL)
+			result = result->right;
+
+		return result;
+	}
+
+	while (node->parent != NULL && node == node->parent->left)
+		node = node->parent;
+
+	return node->parent;
+}
+
+/*
+ * ------------------------------------------------------------
+ * Intrusive chained hash table
+ * ------------------------------------------------------------
+ */
+
+/*
+ * Initializes an empty hash table with at least 'nbuckets' buckets.
+ * Returns 1 if succeeded, 0 if there is no memory.
+ * */
+int ihash_init(struct ihash* table, size_t nbuckets)
+{
+	size_t n = 1;
+	while (n < nbuckets && n <= SIZE_MAX / 2 / sizeof(struct ihash_node*))
+		n *= 2;
+
+	table->buckets = (struct ihash_node**)calloc(n, sizeof(struct ihash_node*));
+	if (table->buckets == NULL)
+		return 0;
+
+	table->mask = n - 1;
+	table->count = 0;
+	return 1;
+}
+
+/*
+ * Doubles the bucket array, nodes are moved with their memoized hash.
+ * Keeps the current buckets if there is no memory.
+ * Note: Private function.
+ * */
+void ihash_grow(struct ihash* table)
+{
+	size_t n = (table->mask + 1) * 2;
+	if (n > SIZE_MAX / sizeof(struct ihash_node*))
+		return;
+
+	struct ihash_node** buckets = (struct ihash_node**)calloc(n, sizeof(struct ihash_node*));
+	if (buckets == NULL)
+		return;
+
+	for (size_t i = 0; i <= table->mask; i++) {
+		struct ihash_node* node = table->buckets[i];
+		while (node != NULL) {
+			struct ihash_node* next = node->next;
+			struct ihash_node** bucket = &(buckets[node->hash & (n - 1)]);
+			node->next = *bucket;
+			*bucket = node;
+			node = next;
+		}
+	}
+
+	free(table->buckets);
+	table->buckets = buckets;
+	table->mask = n - 1;
+}
+
+/*
+ * Links 'node' with key hash 'hash' (duplicate keys are not checked, see ihash_find).
+ * */
+void ihash_insert(struct ihash* table, struct ihash_node* node, uint64_t hash)
+{
+	if (table->count >= (table->mask + 1) * IHASH_MAX_LOAD)
+		ihash_grow(table);
+
+	struct ihash_node** bucket = &(table->buckets[hash & table->mask]);
+	node->hash = hash;
+	node->next = *bucket;
+	*bucket = node;
+	table->count++;
+}
+
+/*
+ * Searches a node with 'key' (of given hash).
+ * Returns the node if found, NULL otherwise.
+ * */
+struct ihash_node* ihash_find(const struct ihash* table, const void* key, uint64_t hash,
+							  ihash_keyequal keyequal)
+{
+	for (struct ihash_node* node = table->buckets[hash & table->mask]; node != NULL; node = node->next)
+		if (node->hash == hash && keyequal(key, node))
+			return node;
+
+	return NULL;
+}
+
+/*
+ * Unlinks 'node' (a node of the table), in O(bucket length).
+ * */
+void ihash_remove(struct ihash* table, struct ihash_node* node)
+{
+	struct ihash_node** link = &(table->buckets[node->hash & table->mask]);
+	while (*link != NULL) {
+		if (*link == node) {
+			*link = node->next;
+			node->next = NULL;
+			table->count--;
+			return;
+		}
+
+		link = &((*link)->next);
+	}
+}
+
+/*
+ * Releases the bucket array (nodes are not touched).
+ * */
+void ihash_release(struct ihash* table)
+{
+	free(table->buckets);
+	table->buckets = NULL;
+	table->mask = 0;
+	table->count = 0;
+}
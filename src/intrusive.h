@@ -0,0 +1,250 @@
+/*****************************************************************************
+ * intrusive.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for intrusive containers: doubly linked list, red-black
+ *  			 tree and chained hash table whose link fields live inside the
+ *  			 user's structures.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  The other containers allocate a node around the user's 'void* data'. Here the user
+ *  structure embeds the link fields (struct ilist_node, struct irbtree_node, struct
+ *  ihash_node) and the containers only link them:
+ *
+ *  	struct entry {
+ *  		int key;
+ *  		struct ilist_node lru;			// position in an LRU list
+ *  		struct ihash_node byid;			// entry in a hash index
+ *  	};
+ *
+ *  	struct entry* e = INTRUSIVE_CONTAINER_OF(node, struct entry, lru);
+ *
+ *  	- inserts and removes allocate nothing (the object memory is the caller's, e.g.
+ *  	  from a pool), they can not fail;
+ *  	- one object is in several containers at once, one link field for each;
+ *  	- removing an object given a pointer to it is O(1) for the list (no search) and
+ *  	  O(log n) for the tree (no key compare).
+ *
+ *  The list is circular with a sentinel node in the list head, so no operation tests
+ *  for NULL. The tree is a red-black tree with parent links (iteration without a
+ *  stack). Compare and hash functions receive the link fields; callbacks get the
+ *  enclosing structure with INTRUSIVE_CONTAINER_OF. The hash table allocates only its
+ *  bucket array (at init and when the load passes IHASH_MAX_LOAD); a failed growth
+ *  keeps the current buckets.
+ *
+ *  Containers do not own the objects: releasing a container does not touch them.
+ *
+ *  Source: https://www.kernel.org/doc/html/latest/core-api/kernel-api.html#list-management-functions
+ *  		 T. Cormen, C. Leiserson, R. Rivest, C. Stein, "Introduction to Algorithms",
+ *  		 chapter 13 (red-black trees).
+ *
+ *******************************************************************************/
+
+#ifndef INTRUSIVE_H_
+	#define INTRUSIVE_H_
+
+	#include <stddef.h>
+	#include <stdint.h>
+
+	// gets the structure of 'type' that contains link field 'member' pointed by 'ptr'
+	#define INTRUSIVE_CONTAINER_OF(ptr, type, member) \
+		((type*)((char*)(ptr) - offsetof(type, member)))
+
+	#define IHASH_DEFAULT_BUCKETS 16
+	#define IHASH_MAX_LOAD 1			// elements per bucket before doubling the buckets
+
+	/*
+	 * ------------------------------------------------------------
+	 * Intrusive doubly linked list
+	 * ------------------------------------------------------------
+	 */
+
+	// list link field
+	struct ilist_node {
+		struct ilist_node* prev;
+		struct ilist_node* next;
+	};
+
+	// list head (sentinel node)
+	struct ilist {
+		struct ilist_node head;
+		size_t size;
+	};
+
+	/*
+	 * Initializes an empty list.
+	 * */
+	void ilist_init(struct ilist* list);
+
+	/*
+	 * Checks if list is empty.
+	 * Returns 1 if is empty, 0 otherwise.
+	 * */
+	int ilist_isempty(const struct ilist* list);
+
+	/*
+	 * Gets the first / last node, NULL if list is empty.
+	 * */
+	struct ilist_node* ilist_first(const struct ilist* list);
+	struct ilist_node* ilist_last(const struct ilist* list);
+
+	/*
+	 * Gets the next / previous node, NULL at the end.
+	 * */
+	struct ilist_node* ilist_next(const struct ilist* list, const struct ilist_node* node);
+	struct ilist_node* ilist_prev(const struct ilist* list, const struct ilist_node* node);
+
+	/*
+	 * Links 'node' at the begin / end of the list.
+	 * */
+	void ilist_push_front(struct ilist* list, struct ilist_node* node);
+	void ilist_push_back(struct ilist* list, struct ilist_node* node);
+
+	/*
+	 * Links 'node' after / before 'pos' (a node of the list).
+	 * */
+	void ilist_insert_after(struct ilist* list, struct ilist_node* pos, struct ilist_node* node);
+	void ilist_insert_before(struct ilist* list, struct ilist_node* pos, struct ilist_node* node);
+
+	/*
+	 * Unlinks 'node' (a node of the list), in O(1).
+	 * */
+	void ilist_remove(struct ilist* list, struct ilist_node* node);
+
+	/*
+	 * Unlinks the first / last node.
+	 * Returns the node, NULL if list is empty.
+	 * */
+	struct ilist_node* ilist_pop_front(struct ilist* list);
+	struct ilist_node* ilist_pop_back(struct ilist* list);
+
+	/*
+	 * Moves 'node' (a node of the list) to the begin of the list, in O(1).
+	 * */
+	void ilist_move_front(struct ilist* list, struct ilist_node* node);
+
+	/*
+	 * ------------------------------------------------------------
+	 * Intrusive red-black tree
+	 * ------------------------------------------------------------
+	 */
+
+	// tree link field
+	struct irbtree_node {
+		struct irbtree_node* parent;
+		struct irbtree_node* left;
+		struct irbtree_node* right;
+		int red;								// 1 red, 0 black
+	};
+
+	// compares two nodes, returns a negative, zero or positive int
+	typedef int (*irbtree_cmp)(const struct irbtree_node* a, const struct irbtree_node* b);
+
+	// compares a key with a node, returns a negative, zero or positive int
+	typedef int (*irbtree_keycmp)(const void* key, const struct irbtree_node* node);
+
+	// tree type
+	struct irbtree {
+		struct irbtree_node* root;
+		irbtree_cmp compare;
+		size_t size;
+	};
+
+	/*
+	 * Initializes an empty tree ordered by 'compare'.
+	 * */
+	void irbtree_init(struct irbtree* tree, irbtree_cmp compare);
+
+	/*
+	 * Links 'node' in the tree, in O(log n) (no allocation).
+	 * Returns NULL if succeeded, or the node already in the tree with an equal key
+	 * ('node' is not linked).
+	 * */
+	struct irbtree_node* irbtree_insert(struct irbtree* tree, struct irbtree_node* node);
+
+	/*
+	 * Searches a node equal to 'key'.
+	 * Returns the node if found, NULL otherwise.
+	 * */
+	struct irbtree_node* irbtree_find(const struct irbtree* tree, const void* key,
+									  irbtree_keycmp keycompare);
+
+	/*
+	 * Searches the first node not lesser than 'key'.
+	 * Returns the node if found, NULL otherwise.
+	 * */
+	struct irbtree_node* irbtree_lower_bound(const struct irbtree* tree, const void* key,
+											 irbtree_keycmp keycompare);
+
+	/*
+	 * Unlinks 'node' (a node of the tree), in O(log n) without key compares.
+	 * */
+	void irbtree_remove(struct irbtree* tree, struct irbtree_node* node);
+
+	/*
+	 * Gets the first / last node in order, NULL if tree is empty.
+	 * */
+	struct irbtree_node* irbtree_first(const struct irbtree* tree);
+	struct irbtree_node* irbtree_last(const struct irbtree* tree);
+
+	/*
+	 * Gets the next / previous node in order, NULL at the end.
+	 * */
+	struct irbtree_node* irbtree_next(const struct irbtree_node* node);
+	struct irbtree_node* irbtree_prev(const struct irbtree_node* node);
+
+	/*
+	 * ------------------------------------------------------------
+	 * Intrusive chained hash table
+	 * ------------------------------------------------------------
+	 */
+
+	// hash table link field
+	struct ihash_node {
+		struct ihash_node* next;
+		uint64_t hash;							// memoized hash of the key
+	};
+
+	// checks if a node has the given key, returns 1 if equal, 0 otherwise
+	typedef int (*ihash_keyequal)(const void* key, const struct ihash_node* node);
+
+	// hash table type
+	struct ihash {
+		struct ihash_node** buckets;
+		size_t mask;							// number of buckets - 1 (power of two)
+		size_t count;
+	};
+
+	/*
+	 * Initializes an empty hash table with at least 'nbuckets' buckets.
+	 * Returns 1 if succeeded, 0 if there is no memory.
+	 * */
+	int ihash_init(struct ihash* table, size_t nbuckets);
+
+	/*
+	 * Links 'node' with key hash 'hash' (duplicate keys are not checked, see ihash_find).
+	 * */
+	void ihash_insert(struct ihash* table, struct ihash_node* node, uint64_t hash);
+
+	/*
+	 * Searches a node with 'key' (of given hash).
+	 * Returns the node if found, NULL otherwise.
+	 * */
+	struct ihash_node* ihash_find(const struct ihash* table, const void* key, uint64_t hash,
+								  ihash_keyequal keyequal);
+
+	/*
+	 * Unlinks 'node' (a node of the table), in O(bucket length).
+	 * */
+	void ihash_remove(struct ihash* table, struct ihash_node* node);
+
+	/*
+	 * Releases the bucket array (nodes are not touched).
+	 * */
+	void ihash_release(struct ihash* table);
+
+#endif /* INTRUSIVE_H_ */
@@ -42,41 +42,215 @@
 #include <assert.h>
 #include "linkedlist.h"
 
+//--------------------- node pool ------------------
+
 /*
- * Creates a new linked list.
+ * Creates a new pool of list nodes with given number of nodes per slab.
+ * Returns the new pool if succeeded, NULL otherwise.
  * */
-struct linkedlist* linkedlist_create( linkedlist_isequal isequalfunc,
-		  	  	  	  	  	  	  	  linkedlist_freedata freedatafunc )
+struct linkedlist_nodepool* linkedlist_nodepool_create(size_t slabnodes)
+{
+	return linkedlist_nodepool_create_allocator(slabnodes, NULL);
+}
+
+/*
+ * Creates a new pool of list nodes whose structure and slabs are allocated by
+ * 'allocator' (see allocator.h, NULL: C library). Lists created on the pool
+ * (linkedlist_create_pooled) take their structure from the same allocator.
+ * Returns the new pool if succeeded, NULL otherwise.
+ * */
+struct linkedlist_nodepool* linkedlist_nodepool_create_allocator( size_t slabnodes,
+																  const struct allocator* allocator )
+{
+	assert(slabnodes > 0);
+	struct linkedlist_nodepool* result = allocator_alloc(allocator, sizeof(*result));
+
+	if (result != NULL) {
+		result->slabnodes = slabnodes;
+		result->nslabs = 0;
+		result->slabs = NULL;
+		result->freelist = NULL;
+		result->allocator = allocator;
+	}
+
+	return result;
+}
+
+/*
+ * Allocates a new slab and threads its nodes on the pool free list.
+ * Returns '1' if succeeded, '0' otherwise.
+ * */
+int linkedlist_nodepool_grow(struct linkedlist_nodepool* pool)
+{
+	struct linkedlist_slab* slab = allocator_alloc( pool->allocator, sizeof(*slab) +
+													pool->slabnodes * sizeof(struct linkedlistnode) );
+	if (slab == NULL)
+		return 0;
+
+	// link slab nodes in order, last one points to current free list
+	for (size_t i = 0; i < pool->slabnodes - 1; ++i)
+		slab->nodes[i].next = &(slab->nodes[i + 1]);
+
+	slab->nodes[pool->slabnodes - 1].next = pool->freelist;
+	pool->freelist = &(slab->nodes[0]);
+
+	slab->next = pool->slabs;
+	pool->slabs = slab;
+	pool->nslabs++;
+	return 1;
+}
+
+/*
+ * Takes a node from the pool, allocating a new slab if free list is empty.
+ * Returns the node if succeeded, NULL otherwise.
+ * */
+struct linkedlistnode* linkedlist_nodepool_alloc(struct linkedlist_nodepool* pool)
+{
+	if ((pool->freelist == NULL) && (!linkedlist_nodepool_grow(pool)))
+		return NULL;
+
+	struct linkedlistnode* result = pool->freelist;
+	pool->freelist = result->next;
+	return result;
+}
+
+/*
+ * Returns a node to the pool free list.
+ * */
+void linkedlist_nodepool_free(struct linkedlist_nodepool* pool, struct linkedlistnode* node)
+{
+	node->data = NULL;
+	node->next = pool->freelist;
+	pool->freelist = node;
+}
+
+/*
+ * Releases the pool and all its slabs from memory in O(slabs).
+ * Note: every node taken from the pool becomes invalid.
+ * */
+void linkedlist_nodepool_destroy(struct linkedlist_nodepool* pool)
+{
+	struct linkedlist_slab* slab = pool->slabs;
+	struct linkedlist_slab* next = NULL;
+
+	while (slab != NULL) {
+		next = slab->next;
+		allocator_free( pool->allocator, slab, sizeof(*slab) +
+						pool->slabnodes * sizeof(struct linkedlistnode) );
+		slab = next;
+	}
+
+	allocator_free(pool->allocator, pool, sizeof(*pool));
+}
+
+//--------------------- linked list ------------------
+
+/*
+ * Allocates a node for the list (from pool, if any).
+ * */
+struct linkedlistnode* linkedlist_allocnode(struct linkedlist* list)
+{
+	if (list->pool != NULL)
+		return linkedlist_nodepool_alloc(list->pool);
+	else
+		return malloc(sizeof(struct linkedlistnode));
+}
+
+/*
+ * Releases a node removed from the list (returns it to the list pool, if any).
+ * Node data is not released.
+ * */
+void linkedlist_freenode(struct linkedlist* list, struct linkedlistnode* node)
+{
+	if (list->pool != NULL)
+		linkedlist_nodepool_free(list->pool, node);
+	else
+		free(node);
+}
+
+/*
+ * Creates a new linked list whose structure is allocated by 'allocator'.
+ * Note: Private function.
+ * */
+struct linkedlist* linkedlist_create_with( linkedlist_isequal isequalfunc,
+										   linkedlist_freedata freedatafunc,
+										   const struct allocator* allocator )
 {
 	struct linkedlist* result = NULL;
-	result = malloc(sizeof(*result));
+	result = allocator_alloc(allocator, sizeof(*result));
 	if (result != NULL) {
-		struct linkedlistnode** hp = malloc(sizeof *hp);
+		struct linkedlistnode** hp = allocator_alloc(allocator, sizeof *hp);
 		if (hp != NULL)
 		{
 			*hp = NULL;
 			result->headp = hp;
 
-			struct linkedlistnode** tp = malloc(sizeof *tp);
+			struct linkedlistnode** tp = allocator_alloc(allocator, sizeof *tp);
 			if (tp != NULL)	{
 				*tp = NULL;
 				result->tailp = tp;
 			}
 			else {
-				free(hp);
-				free(result);
+				allocator_free(allocator, hp, sizeof *hp);
+				allocator_free(allocator, result, sizeof(*result));
 				result = NULL;
 			}
 		}
 		else {
-			free(result);
+			allocator_free(allocator, result, sizeof(*result));
 			result = NULL;
 		}
 	}
 
-	result->size = 0;
-	result->isequalfunc = isequalfunc;
-	result->freedata = freedatafunc;
+	if (result != NULL) {
+		result->size = 0;
+		result->isequalfunc = isequalfunc;
+		result->freedata = freedatafunc;
+		result->pool = NULL;
+		result->ownspool = 0;
+		result->allocator = allocator;
+	}
+
+	return result;
+}
+
+/*
+ * Creates a new linked list.
+ * */
+struct linkedlist* linkedlist_create( linkedlist_isequal isequalfunc,
+		  	  	  	  	  	  	  	  linkedlist_freedata freedatafunc )
+{
+	return linkedlist_create_with(isequalfunc, freedatafunc, NULL);
+}
+
+/*
+ * Creates a new linked list that takes its nodes from a pool.
+ * If 'pool' is NULL a private pool is created and released with the list,
+ * otherwise the (shared) pool must outlive the list and the list structure is
+ * allocated by the pool allocator.
+ * Returns the new list if succeeded, NULL otherwise.
+ * */
+struct linkedlist* linkedlist_create_pooled( linkedlist_isequal isequalfunc,
+											 linkedlist_freedata freedatafunc,
+											 struct linkedlist_nodepool* pool )
+{
+	struct linkedlist* result = linkedlist_create_with( isequalfunc, freedatafunc,
+														(pool != NULL) ? pool->allocator : NULL );
+
+	if (result != NULL) {
+		if (pool == NULL) {
+			pool = linkedlist_nodepool_create(LINKEDLIST_NODEPOOL_DEFAULT_SLAB);
+			if (pool == NULL) {
+				linkedlist_destroy(result);
+				return NULL;
+			}
+
+			result->ownspool = 1;
+		}
+
+		result->pool = pool;
+	}
+
 	return result;
 }
 
@@ -96,7 +270,7 @@ int linkedlist_push(struct linkedlist* list, void* new_data) {
 	int result = 0;
 	assert(list != NULL);
 
-	struct linkedlistnode* new_node = malloc(sizeof(*new_node));
+	struct linkedlistnode* new_node = linkedlist_allocnode(list);
 
 	if (new_node != NULL) {
 		if (linkedlist_isempty(list)) {
@@ -127,7 +301,7 @@ int linkedlist_append(struct linkedlist* list, void* new_data) {
 	int result = 0;
 	assert(list != NULL);
 
-	struct linkedlistnode* new_node = malloc(sizeof(*new_node));
+	struct linkedlistnode* new_node = linkedlist_allocnode(list);
 
 	if (new_node != NULL) {
 		new_node->next = NULL;
@@ -341,15 +515,33 @@ void linkedlist_destroy(struct linkedlist* list) {
 	assert(list != NULL);
 	struct linkedlistnode* node = NULL;
 
-	while ((node = linkedlist_remove_first(list)) != NULL)  {
-		if (node->data != NULL)
-			if (list->freedata != NULL)
-				list->freedata(node->data);
+	if (list->pool == NULL) {
+		while ((node = linkedlist_remove_first(list)) != NULL)  {
+			if (node->data != NULL)
+				if (list->freedata != NULL)
+					list->freedata(node->data);
 
-		free(node);
+			free(node);
+		}
+	}
+	else {
+		// nodes are released in bulk, only data needs a walk
+		if (list->freedata != NULL) {
+			for (node = *(list->headp); node != NULL; node = node->next)
+				if (node->data != NULL)
+					list->freedata(node->data);
+		}
+
+		if (list->ownspool)
+			linkedlist_nodepool_destroy(list->pool);	// O(slabs)
+		else if (list->size > 0) {
+			// splice whole list on shared pool free list in O(1)
+			(*(list->tailp))->next = list->pool->freelist;
+			list->pool->freelist = *(list->headp);
+		}
 	}
 
-	free(list->headp);
-	free(list->tailp);
-	free(list);
+	allocator_free(list->allocator, list->headp, sizeof(*(list->headp)));
+	allocator_free(list->allocator, list->tailp, sizeof(*(list->tailp)));
+	allocator_free(list->allocator, list, sizeof(*list));
 }
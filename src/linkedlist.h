@@ -33,18 +33,53 @@
  *    where n is the number of elements in the linked list, as compared to arrays that
  *    take O(1) time.
  *
+ *-----------------------------------------------------------------------
+ *
+ *  Node pools
+ *
+ *    By default each node is allocated with malloc. A list can instead take its
+ *    nodes from a slab pool (linkedlist_nodepool): nodes are carved from slabs of
+ *    N nodes and returned to a free list when removed, so push/remove churn does
+ *    not reach the global allocator. The pool can be private to one list or shared
+ *    by many lists (e.g. all buckets of an hash table). Destroying a pool releases
+ *    its slabs in O(slabs), whatever the number of nodes. Slabs can come from a
+ *    custom allocator (linkedlist_nodepool_create_allocator, see allocator.h).
+ *
+ *    Pools are not thread safe; share a pool only between lists used by the same
+ *    thread (or under the same lock).
+ *
  ***********************************************************************/
 
 #ifndef LINKEDLIST_H_
 
 	#define LINKEDLIST_H_
 
+	#include <stdlib.h>
+	#include "allocator.h"
+
+	#define LINKEDLIST_NODEPOOL_DEFAULT_SLAB 64
+
 	// Represents a node in list
 	struct linkedlistnode {
 		void* data;
 		struct linkedlistnode* next;
 	};
 
+	// Slab of nodes of a node pool
+	struct linkedlist_slab {
+		struct linkedlist_slab* next;			// next slab in pool
+		struct linkedlistnode nodes[];			// slab nodes
+	};
+
+	// Pool of list nodes
+	struct linkedlist_nodepool {
+		size_t slabnodes;						// number of nodes per slab
+		size_t nslabs;							// number of allocated slabs
+		struct linkedlist_slab* slabs;			// allocated slabs
+		struct linkedlistnode* freelist;		// released nodes (linked by 'next')
+		const struct allocator* allocator;		// allocator of pool, slabs and pooled lists (NULL: C library)
+	};
+
 	typedef void (*linkedlist_freedata)(void* data);
 	typedef int (*linkedlist_isequal)(const void* a, const void* b);
 
@@ -55,14 +90,60 @@
 		struct linkedlistnode** headp;			// pointer to first node
 		struct linkedlistnode** tailp;			// pointer to last node
 		size_t size;							// number of elements in list
+		struct linkedlist_nodepool* pool;		// node pool (NULL if nodes are malloc'ed)
+		int ownspool;							// '1' if pool is released with the list
+		const struct allocator* allocator;		// allocator of list structure (pool allocator for pooled lists)
 	};
 
+	/*
+	 * Creates a new pool of list nodes with given number of nodes per slab.
+	 * Returns the new pool if succeeded, NULL otherwise.
+	 * */
+	struct linkedlist_nodepool* linkedlist_nodepool_create(size_t slabnodes);
+
+	/*
+	 * Creates a new pool of list nodes whose structure and slabs are allocated by
+	 * 'allocator' (see allocator.h, NULL: C library). Lists created on the pool
+	 * (linkedlist_create_pooled) take their structure from the same allocator.
+	 * Returns the new pool if succeeded, NULL otherwise.
+	 * */
+	struct linkedlist_nodepool* linkedlist_nodepool_create_allocator( size_t slabnodes,
+																	  const struct allocator* allocator );
+
+	/*
+	 * Takes a node from the pool, allocating a new slab if free list is empty.
+	 * Returns the node if succeeded, NULL otherwise.
+	 * */
+	struct linkedlistnode* linkedlist_nodepool_alloc(struct linkedlist_nodepool* pool);
+
+	/*
+	 * Returns a node to the pool free list.
+	 * */
+	void linkedlist_nodepool_free(struct linkedlist_nodepool* pool, struct linkedlistnode* node);
+
+	/*
+	 * Releases the pool and all its slabs from memory in O(slabs).
+	 * Note: every node taken from the pool becomes invalid.
+	 * */
+	void linkedlist_nodepool_destroy(struct linkedlist_nodepool* pool);
+
 	/*
 	 * Creates a new linked list.
 	 * */
 	struct linkedlist* linkedlist_create( linkedlist_isequal isequalfunc,
 										  linkedlist_freedata freedatafunc );
 
+	/*
+	 * Creates a new linked list that takes its nodes from a pool.
+	 * If 'pool' is NULL a private pool is created and released with the list,
+	 * otherwise the (shared) pool must outlive the list and the list structure is
+	 * allocated by the pool allocator.
+	 * Returns the new list if succeeded, NULL otherwise.
+	 * */
+	struct linkedlist* linkedlist_create_pooled( linkedlist_isequal isequalfunc,
+												 linkedlist_freedata freedatafunc,
+												 struct linkedlist_nodepool* pool );
+
 	/*
 	 * Checks if list is empty.
 	 * Returns 1 if is empty, 0 otherwise.
@@ -133,15 +214,23 @@
 	/*
 	 * Removes the first node from list.
 	 * Returns the remove node if succeeded, NULL otherwise.
+	 * Note: release the node with 'linkedlist_freenode'.
 	 * */
 	struct linkedlistnode* linkedlist_remove_first(struct linkedlist* list);
 
 	/*
 	 * Removes the node from list that references given data.
 	 * Returns the remove node if succeeded, NULL otherwise.
+	 * Note: release the node with 'linkedlist_freenode'.
 	 * */
 	struct linkedlistnode* linkedlist_remove(struct linkedlist* list, const void* data);
 
+	/*
+	 * Releases a node removed from the list (returns it to the list pool, if any).
+	 * Node data is not released.
+	 * */
+	void linkedlist_freenode(struct linkedlist* list, struct linkedlistnode* node);
+
 	/*
 	 * Releases the entire list..
 	 * */
@@ -89,7 +89,7 @@ struct linkedlistqueue* linkedlistqueue_createWithSizeLimit( uint maxsize,
 															 linkedlist_freedata freedata )
 {
 	struct linkedlistqueue* result = NULL;
-	struct linkedlist* queue = linkedlist_create( NULL, freedata );
+	struct linkedlist* queue = linkedlist_create_pooled( NULL, freedata, NULL );
 
 	if (queue == NULL)
 		return NULL;
@@ -184,7 +184,7 @@ void* linkedlistqueue_dequeue(struct linkedlistqueue* q) {
 		q->front = linkedlist_getfirst(q->queue);
 		q->rear = linkedlist_getlast(q->queue);
 		result = node->data;
-		free(node);
+		linkedlist_freenode(q->queue, node);
 	}
 
 	return result;
@@ -99,7 +99,7 @@ struct linkedliststack* linkedliststack_create( )
 struct linkedliststack* linkedliststack_create_freedata(linkedlist_freedata freedata ) {
 	struct linkedliststack* result = NULL;
 
-	struct linkedlist* list = linkedlist_create( NULL, freedata );
+	struct linkedlist* list = linkedlist_create_pooled( NULL, freedata, NULL );
 	if (list == NULL)
 		return NULL;
 	else
@@ -160,7 +160,7 @@ void* linkedliststack_pop(struct linkedliststack* st) {
 			st->top = linkedlist_getfirst(st->list);
 			result = node->data;
 			// release node
-			free(node);
+			linkedlist_freenode(st->list, node);
 		}
 		else {
 			// fail to remove first node
@@ -0,0 +1,450 @@
+/*
+ * lrucache.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Bounded key/value cache with LRU eviction, TinyLFU admission and sharding.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lrucache.h"
+
+/*
+ * Mixes the user key hash (keys like small ints hash to themselves).
+ * Note: Private function.
+ * */
+uint64_t lrucache_mix(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+/*
+ * Initializes a shard with its entries pool, index and sketch.
+ * Returns 1 if succeeded, 0 otherwise.
+ * Note: Private function.
+ * */
+int lrucache_shard_init(struct lrucache_shard* shard, size_t capacity, int admission)
+{
+	shard->capacity = capacity;
+	shard->samples = 0;
+	shard->sketch = NULL;
+	shard->sketchmask = 0;
+	memset(&(shard->stats), 0, sizeof(struct lrucache_stats));
+	ilist_init(&(shard->lru));
+	ilist_init(&(shard->freelist));
+
+	shard->entries = (struct lrucache_entry*)malloc(capacity * sizeof(struct lrucache_entry));
+	if (shard->entries == NULL)
+		return 0;
+
+	// a bucket per entry: the index never grows
+	if (!ihash_init(&(shard->index), capacity)) {
+		free(shard->entries);
+		return 0;
+	}
+
+	if (admission == LRUCACHE_ADMIT_TINYLFU) {
+		size_t width = 16;
+		while (width < capacity)
+			width *= 2;
+
+		shard->sketch = (uint8_t*)calloc(LRUCACHE_SKETCH_ROWS * width, sizeof(uint8_t));
+		if (shard->sketch == NULL) {
+			ihash_release(&(shard->index));
+			free(shard->entries);
+			return 0;
+		}
+
+		shard->sketchmask = width - 1;
+	}
+
+	for (size_t i = 0; i < capacity; i++)
+		ilist_push_back(&(shard->freelist), &(shard->entries[i].lru));
+
+	return 1;
+}
+
+/*
+ * Creates a new cache for up to 'capacity' entries with an admission policy
+ * (LRUCACHE_ADMIT_...). If 'nshards' > 0 the cache is split in nshards (rounded up to
+ * a power of two) locked shards and is thread safe.
+ * Returns the new cache if succeeded, NULL otherwise.
+ * */
+struct lrucache* lrucache_create_ex( size_t capacity, size_t nshards, int admission,
+									 lrucache_hashfunc hashfunc,
+									 lrucache_isequal isequalfunc,
+									 lrucache_freedata freedatafunc )
+{
+	if (capacity == 0)
+		return NULL;
+
+	struct lrucache* cache = (struct lrucache*)malloc(sizeof(struct lrucache));
+	if (cache == NULL) {
+		printf("Memory error: failed to allocate memory for lru cache!\n");
+		return NULL;
+	}
+
+	cache->locked = (nshards > 0);
+	cache->admission = admission;
+	cache->hashfunc = hashfunc;
+	cache->isequal = isequalfunc;
+	cache->freedata = freedatafunc;
+	cache->nshards = 1;
+	cache->shardbits = 0;
+	while (cache->nshards < nshards && cache->nshards * 2 <= capacity) {
+		cache->nshards <<= 1;
+		cache->shardbits++;
+	}
+
+	cache->shards = (struct lrucache_shard*)aligned_alloc( LRUCACHE_CACHE_LINE,
+										cache->nshards * sizeof(struct lrucache_shard) );
+	if (cache->shards == NULL) {
+		printf("Memory error: failed to allocate memory for lru cache shards!\n");
+		free(cache);
+		return NULL;
+	}
+
+	size_t shardcapacity = (capacity + cache->nshards - 1) / cache->nshards;
+	for (size_t i = 0; i < cache->nshards; i++) {
+		if (!lrucache_shard_init(&(cache->shards[i]), shardcapacity, admission)) {
+			printf("Memory error: failed to allocate memory for lru cache shard!\n");
+			cache->nshards = i;
+			lrucache_destroy(cache);
+			return NULL;
+		}
+
+		if (cache->locked && pthread_mutex_init(&(cache->shards[i].lock), NULL) != 0) {
+			printf("Error: failed to initialize lru cache shard lock!\n");
+			abort();
+		}
+	}
+
+	return cache;
+}
+
+/*
+ * Creates a new cache for up to 'capacity' entries (LRU, one shard, not thread safe).
+ * Returns the new cache if succeeded, NULL otherwise.
+ * */
+struct lrucache* lrucache_create( size_t capacity, lrucache_hashfunc hashfunc,
+								  lrucache_isequal isequalfunc,
+								  lrucache_freedata freedatafunc )
+{
+	return lrucache_create_ex(capacity, 0, LRUCACHE_ADMIT_ALL, hashfunc, isequalfunc, freedatafunc);
+}
+
+/*
+ * Gets the shard of a mixed key hash and locks it (if the cache is locked).
+ * Note: Private function.
+ * */
+struct lrucache_shard* lrucache_lock(struct lrucache* cache, uint64_t hash)
+{
+	struct lrucache_shard* shard = (cache->shardbits == 0) ? &(cache->shards[0])
+									: &(cache->shards[hash >> (64 - cache->shardbits)]);
+	if (cache->locked)
+		pthread_mutex_lock(&(shard->lock));
+
+	return shard;
+}
+
+/*
+ * Unlocks a shard (if the cache is locked).
+ * Note: Private function.
+ * */
+void lrucache_unlock(struct lrucache* cache, struct lrucache_shard* shard)
+{
+	if (cache->locked)
+		pthread_mutex_unlock(&(shard->lock));
+}
+
+/*
+ * Searches the entry of a key in a shard.
+ * Returns the entry if found, NULL otherwise.
+ * Note: Private function.
+ * */
+struct lrucache_entry* lrucache_findentry(const struct lrucache* cache, struct lrucache_shard* shard,
+										  const void* key, uint64_t hash)
+{
+	for (struct ihash_node* node = shard->index.buckets[hash & shard->index.mask]; node != NULL;
+		 node = node->next) {
+		if (node->hash == hash) {
+			struct lrucache_entry* entry = INTRUSIVE_CONTAINER_OF(node, struct lrucache_entry, link);
+			if (cache->isequal(entry->key, key))
+				return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Gets the position of a hash in a sketch row.
+ * Note: Private function.
+ * */
+size_t lrucache_sketch_index(const struct lrucache_shard* shard, uint64_t hash, int row)
+{
+	// double hashing: rows use independent combinations of both hash halves
+	uint64_t h1 = hash & 0xFFFFFFFFULL;
+	uint64_t h2 = (hash >> 32) | 1;
+	return row * (shard->sketchmask + 1) + ((h1 + row * h2) & shard->sketchmask);
+}
+
+/*
+ * Gets the estimated access frequency of a hash (minimum of its counters).
+ * Note: Private function.
+ * */
+unsigned int lrucache_sketch_estimate(const struct lrucache_shard* shard, uint64_t hash)
+{
+	unsigned int result = UINT8_MAX;
+	for (int row = 0; row < LRUCACHE_SKETCH_ROWS; row++) {
+		unsigned int c = shard->sketch[lrucache_sketch_index(shard, hash, row)];
+		if (c < result)
+			result = c;
+	}
+
+	return result;
+}
+
+/*
+ * Records an access of a hash (conservative update: only the minimum counters grow).
+ * Every RESET x capacity accesses all counters are halved.
+ * Note: Private function.
+ * */
+void lrucache_sketch_record(struct lrucache_shard* shard, uint64_t hash)
+{
+	if (shard->sketch == NULL)
+		return;
+
+	unsigned int min = lrucache_sketch_estimate(shard, hash);
+	if (min < UINT8_MAX)
+		for (int row = 0; row < LRUCACHE_SKETCH_ROWS; row++) {
+			uint8_t* c = &(shard->sketch[lrucache_sketch_index(shard, hash, row)]);
+			if (*c == min)
+				(*c)++;
+		}
+
+	if (++(shard->samples) >= LRUCACHE_SKETCH_RESET * shard->capacity) {
+		size_t n = LRUCACHE_SKETCH_ROWS * (shard->sketchmask + 1);
+		for (size_t i = 0; i < n; i++)
+			shard->sketch[i] >>= 1;
+
+		shard->samples /= 2;
+	}
+}
+
+/*
+ * Gets the value of a given key and marks it as most recently used.
+ * Returns the value if found, NULL otherwise.
+ * */
+void* lrucache_get(struct lrucache* cache, const void* key)
+{
+	uint64_t hash = lrucache_mix(cache->hashfunc(key));
+	struct lrucache_shard* shard = lrucache_lock(cache, hash);
+
+	void* result = NULL;
+	lrucache_sketch_record(shard, hash);
+	struct lrucache_entry* entry = lrucache_findentry(cache, shard, key, hash);
+	if (entry != NULL) {
+		ilist_move_front(&(shard->lru), &(entry->lru));
+		result = entry->value;
+		shard->stats.hits++;
+	}
+	else
+		shard->stats.misses++;
+
+	lrucache_unlock(cache, shard);
+	return result;
+}
+
+/*
+ * Gets the value of a given key without changing the LRU order or the counters.
+ * Returns the value if found, NULL otherwise.
+ * */
+void* lrucache_peek(struct lrucache* cache, const void* key)
+{
+	uint64_t hash = lrucache_mix(cache->hashfunc(key));
+	struct lrucache_shard* shard = lrucache_lock(cache, hash);
+	struct lrucache_entry* entry = lrucache_findentry(cache, shard, key, hash);
+	void* result = (entry != NULL) ? entry->value : NULL;
+	lrucache_unlock(cache, shard);
+	return result;
+}
+
+/*
+ * Adds or replaces the value of a key (a replaced key/value pair is released).
+ * A new key in a full shard evicts the least recently used entry.
+ * Returns 1 if stored, 0 if refused by the admission policy (the caller keeps
+ * the key and value).
+ * */
+int lrucache_put(struct lrucache* cache, void* key, void* value)
+{
+	uint64_t hash = lrucache_mix(cache->hashfunc(key));
+	struct lrucache_shard* shard = lrucache_lock(cache, hash);
+
+	struct lrucache_entry* entry = lrucache_findentry(cache, shard, key, hash);
+	if (entry != NULL) {
+		// release the old pair, except what is put again
+		if (cache->freedata != NULL && (entry->key != key || entry->value != value))
+			cache->freedata((entry->key != key) ? entry->key : NULL,
+							(entry->value != value) ? entry->value : NULL);
+
+		entry->key = key;
+		entry->value = value;
+		ilist_move_front(&(shard->lru), &(entry->lru));
+		lrucache_unlock(cache, shard);
+		return 1;
+	}
+
+	struct ilist_node* node = ilist_pop_front(&(shard->freelist));
+	if (node == NULL) {
+		// full: the LRU entry is the victim
+		entry = INTRUSIVE_CONTAINER_OF(ilist_last(&(shard->lru)), struct lrucache_entry, lru);
+		if (shard->sketch != NULL
+			&& lrucache_sketch_estimate(shard, hash) <= lrucache_sketch_estimate(shard, entry->link.hash)) {
+			shard->stats.rejections++;
+			lrucache_unlock(cache, shard);
+			return 0;
+		}
+
+		ilist_remove(&(shard->lru), &(entry->lru));
+		ihash_remove(&(shard->index), &(entry->link));
+		if (cache->freedata != NULL)
+			cache->freedata(entry->key, entry->value);
+
+		shard->stats.evictions++;
+	}
+	else
+		entry = INTRUSIVE_CONTAINER_OF(node, struct lrucache_entry, lru);
+
+	entry->key = key;
+	entry->value = value;
+	ilist_push_front(&(shard->lru), &(entry->lru));
+	ihash_insert(&(shard->index), &(entry->link), hash);
+
+	lrucache_unlock(cache, shard);
+	return 1;
+}
+
+/*
+ * Removes a key (the key/value pair is released).
+ * Returns 1 if removed, 0 if not found.
+ * */
+int lrucache_remove(struct lrucache* cache, const void* key)
+{
+	uint64_t hash = lrucache_mix(cache->hashfunc(key));
+	struct lrucache_shard* shard = lrucache_lock(cache, hash);
+
+	struct lrucache_entry* entry = lrucache_findentry(cache, shard, key, hash);
+	if (entry != NULL) {
+		ilist_remove(&(shard->lru), &(entry->lru));
+		ihash_remove(&(shard->index), &(entry->link));
+		ilist_push_front(&(shard->freelist), &(entry->lru));
+		if (cache->freedata != NULL)
+			cache->freedata(entry->key, entry->value);
+	}
+
+	lrucache_unlock(cache, shard);
+	return (entry != NULL);
+}
+
+/*
+ * Gets the number of entries / the maximum number of entries.
+ * Note: with concurrent writers the size is only a snapshot.
+ * */
+size_t lrucache_getsize(struct lrucache* cache)
+{
+	size_t result = 0;
+	for (size_t i = 0; i < cache->nshards; i++) {
+		struct lrucache_shard* shard = &(cache->shards[i]);
+		if (cache->locked)
+			pthread_mutex_lock(&(shard->lock));
+
+		result += shard->lru.size;
+		lrucache_unlock(cache, shard);
+	}
+
+	return result;
+}
+
+size_t lrucache_getcapacity(const struct lrucache* cache)
+{
+	return cache->nshards * cache->shards[0].capacity;
+}
+
+/*
+ * Gets the sum of the shard counters.
+ * */
+void lrucache_getstats(struct lrucache* cache, struct lrucache_stats* stats)
+{
+	memset(stats, 0, sizeof(struct lrucache_stats));
+	for (size_t i = 0; i < cache->nshards; i++) {
+		struct lrucache_shard* shard = &(cache->shards[i]);
+		if (cache->locked)
+			pthread_mutex_lock(&(shard->lock));
+
+		stats->hits += shard->stats.hits;
+		stats->misses += shard->stats.misses;
+		stats->evictions += shard->stats.evictions;
+		stats->rejections += shard->stats.rejections;
+		lrucache_unlock(cache, shard);
+	}
+}
+
+/*
+ * Moves every used entry of a shard to its free list, releasing key/value pairs.
+ * Note: Private function.
+ * */
+void lrucache_shard_clear(struct lrucache* cache, struct lrucache_shard* shard)
+{
+	struct ilist_node* node;
+	while ((node = ilist_pop_front(&(shard->lru))) != NULL) {
+		struct lrucache_entry* entry = INTRUSIVE_CONTAINER_OF(node, struct lrucache_entry, lru);
+		ihash_remove(&(shard->index), &(entry->link));
+		ilist_push_front(&(shard->freelist), &(entry->lru));
+		if (cache->freedata != NULL)
+			cache->freedata(entry->key, entry->value);
+	}
+}
+
+/*
+ * Removes all entries (key/value pairs are released), counters are kept.
+ * */
+void lrucache_clear(struct lrucache* cache)
+{
+	for (size_t i = 0; i < cache->nshards; i++) {
+		struct lrucache_shard* shard = &(cache->shards[i]);
+		if (cache->locked)
+			pthread_mutex_lock(&(shard->lock));
+
+		lrucache_shard_clear(cache, shard);
+		lrucache_unlock(cache, shard);
+	}
+}
+
+/*
+ * Releases the cache and its entries from memory.
+ * Note: no other thread may be using the cache.
+ * */
+void lrucache_destroy(struct lrucache* cache)
+{
+	for (size_t i = 0; i < cache->nshards; i++) {
+		struct lrucache_shard* shard = &(cache->shards[i]);
+		lrucache_shard_clear(cache, shard);
+		if (cache->locked)
+			pthread_mutex_destroy(&(shard->lock));
+
+		ihash_release(&(shard->index));
+		free(shard->sketch);
+		free(shard->entries);
+	}
+
+	free(cache->shards);
+	free(cache);
+}
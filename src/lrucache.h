@@ -0,0 +1,178 @@
+/*****************************************************************************
+ * lrucache.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a bounded key/value cache with LRU eviction and
+ *  			 optional TinyLFU admission and sharding.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A cache made of a hashtable plus a dbllinkedlist pays two lookups per access (the
+ *  table gives the key, the list is searched for its node) and a malloc per insert.
+ *  Here each entry holds its key, value and the link fields of both containers (see
+ *  intrusive.h):
+ *
+ *  	- the hash index finds the entry, which is also the LRU list node, so get is
+ *  	  one lookup plus an O(1) move to the list front;
+ *  	- entries come from a pool allocated at create (capacity entries), the bucket
+ *  	  array is sized for the capacity and never grows: get, put and evict allocate
+ *  	  nothing;
+ *  	- the least recently used entry (list back) is evicted when a new key is put in
+ *  	  a full cache.
+ *
+ *  Admission (LRUCACHE_ADMIT_TINYLFU): plain LRU lets a scan of one-time keys flush
+ *  the whole cache. TinyLFU keeps approximate access frequencies of recent keys in a
+ *  count-min sketch (4 rows of 8 bit counters, halved every 10 x capacity accesses so
+ *  old popularity fades). A new key only replaces the LRU victim if it was accessed
+ *  more often than the victim, so one-time keys are rejected (put returns 0).
+ *  Accesses are counted by get (hits and misses), so a miss followed by a put of the
+ *  key counts once.
+ *
+ *  Sharding (lrucache_create_ex with nshards > 0): keys are spread over independent
+ *  caches by the top bits of the mixed hash, each one with capacity / nshards entries
+ *  and its own mutex (get updates the LRU order, so there are no readers-only paths).
+ *  Shards are cache line aligned. Eviction is per shard (approximate global LRU).
+ *  With nshards = 0 the cache has one shard and takes no locks (not thread safe).
+ *
+ *  Note: values returned by get are not protected: with a freedata function and other
+ *  threads putting keys, a value may be released when its entry is evicted.
+ *
+ *  Source: G. Einziger, R. Friedman, B. Manes, "TinyLFU: A Highly Efficient Cache
+ *  		 Admission Policy", ACM Transactions on Storage (2017).
+ *  		 https://en.wikipedia.org/wiki/Cache_replacement_policies#LRU
+ *
+ *******************************************************************************/
+
+#ifndef LRUCACHE_H_
+	#define LRUCACHE_H_
+
+	#include <stdint.h>
+	#include <pthread.h>
+	#include "intrusive.h"
+
+	#define LRUCACHE_CACHE_LINE 64
+	#define LRUCACHE_SKETCH_ROWS 4
+	#define LRUCACHE_SKETCH_RESET 10		// sketch counters are halved every RESET x capacity accesses
+
+	// admission policies
+	#define LRUCACHE_ADMIT_ALL 0			// plain LRU: new keys always evict the LRU entry
+	#define LRUCACHE_ADMIT_TINYLFU 1		// new keys must be more frequent than the LRU entry
+
+	typedef uint64_t (*lrucache_hashfunc)(const void* key);
+	typedef int (*lrucache_isequal)(const void* key1, const void* key2);
+	typedef void (*lrucache_freedata)(void* key, void* value);	// key or value is NULL if kept (replace)
+
+	// cache entry (pool element)
+	struct lrucache_entry {
+		void* key;
+		void* value;
+		struct ilist_node lru;				// LRU list (or free list) link
+		struct ihash_node link;				// hash index link
+	};
+
+	// cache counters
+	struct lrucache_stats {
+		size_t hits;
+		size_t misses;
+		size_t evictions;
+		size_t rejections;					// puts refused by the admission policy
+	};
+
+	// shard: a complete cache with its own lock
+	struct lrucache_shard {
+		pthread_mutex_t lock;
+		size_t capacity;					// maximum number of entries
+		struct lrucache_entry* entries;		// entries pool
+		struct ilist lru;					// used entries, most recent first
+		struct ilist freelist;				// unused entries
+		struct ihash index;					// key hash -> entry
+		uint8_t* sketch;					// frequency sketch (TinyLFU only)
+		size_t sketchmask;					// sketch row width - 1 (power of two)
+		size_t samples;						// accesses since the last sketch halving
+		struct lrucache_stats stats;
+	} __attribute__((aligned(LRUCACHE_CACHE_LINE)));
+
+	// cache type
+	struct lrucache {
+		size_t nshards;						// number of shards (power of two)
+		unsigned int shardbits;				// log2 of number of shards
+		int locked;							// shards take their lock (1) or not (0)
+		int admission;						// admission policy
+		lrucache_hashfunc hashfunc;
+		lrucache_isequal isequal;
+		lrucache_freedata freedata;			// releases key/value on eviction, replace and destroy
+		struct lrucache_shard* shards;
+	};
+
+	/*
+	 * Creates a new cache for up to 'capacity' entries (LRU, one shard, not thread safe).
+	 * Returns the new cache if succeeded, NULL otherwise.
+	 * */
+	struct lrucache* lrucache_create( size_t capacity, lrucache_hashfunc hashfunc,
+									  lrucache_isequal isequalfunc,
+									  lrucache_freedata freedatafunc );
+
+	/*
+	 * Creates a new cache for up to 'capacity' entries with an admission policy
+	 * (LRUCACHE_ADMIT_...). If 'nshards' > 0 the cache is split in nshards (rounded up to
+	 * a power of two) locked shards and is thread safe.
+	 * Returns the new cache if succeeded, NULL otherwise.
+	 * */
+	struct lrucache* lrucache_create_ex( size_t capacity, size_t nshards, int admission,
+										 lrucache_hashfunc hashfunc,
+										 lrucache_isequal isequalfunc,
+										 lrucache_freedata freedatafunc );
+
+	/*
+	 * Gets the value of a given key and marks it as most recently used.
+	 * Returns the value if found, NULL otherwise.
+	 * */
+	void* lrucache_get(struct lrucache* cache, const void* key);
+
+	/*
+	 * Gets the value of a given key without changing the LRU order or the counters.
+	 * Returns the value if found, NULL otherwise.
+	 * */
+	void* lrucache_peek(struct lrucache* cache, const void* key);
+
+	/*
+	 * Adds or replaces the value of a key (a replaced key/value pair is released).
+	 * A new key in a full shard evicts the least recently used entry.
+	 * Returns 1 if stored, 0 if refused by the admission policy (the caller keeps
+	 * the key and value).
+	 * */
+	int lrucache_put(struct lrucache* cache, void* key, void* value);
+
+	/*
+	 * Removes a key (the key/value pair is released).
+	 * Returns 1 if removed, 0 if not found.
+	 * */
+	int lrucache_remove(struct lrucache* cache, const void* key);
+
+	/*
+	 * Gets the number of entries / the maximum number of entries.
+	 * Note: with concurrent writers the size is only a snapshot.
+	 * */
+	size_t lrucache_getsize(struct lrucache* cache);
+	size_t lrucache_getcapacity(const struct lrucache* cache);
+
+	/*
+	 * Gets the sum of the shard counters.
+	 * */
+	void lrucache_getstats(struct lrucache* cache, struct lrucache_stats* stats);
+
+	/*
+	 * Removes all entries (key/value pairs are released), counters are kept.
+	 * */
+	void lrucache_clear(struct lrucache* cache);
+
+	/*
+	 * Releases the cache and its entries from memory.
+	 * Note: no other thread may be using the cache.
+	 * */
+	void lrucache_destroy(struct lrucache* cache);
+
+#endif /* LRUCACHE_H_ */
@@ -8,34 +8,69 @@
 #include <stdio.h>
 #include <limits.h>
 #include <string.h>
+#include <time.h>
+#include <float.h>
+#include <sched.h>
 #include "arraylist.h"
+#include "gaplist.h"
 #include "binarysearch.h"
+#include "sortedarray.h"
 #include "circdbllinkedlist.h"
 #include "circlinkedlist.h"
 #include "linkedlist.h"
+#include "unrolledlist.h"
+#include "intrusive.h"
 #include "dbllinkedlist.h"
 #include "linkedlistqueue.h"
+#include "ringqueue.h"
 #include "linkedliststack.h"
 #include "binarytree.h"
 #include "binarysearchtree.h"
 #include "avltree.h"
 #include "redblacktree.h"
+#include "prbtree.h"
 #include "heapstruct.h"
 #include "minbinaryheap.h"
 #include "maxbinaryheap.h"
 #include "fibonacciheap.h"
+#include "pairingheap.h"
+#include "radixheap.h"
+#include "indminbinaryheap.h"
 #include "arraydeque.h"
 #include "dbllinkedlistdeque.h"
 #include "hashtable_lp.h"
+#include "hashtable_simd.h"
+#include "hashtable_concurrent.h"
+#include "strintern.h"
+#include "datastats.h"
+#include "lrucache.h"
 #include "hashset.h"
+#include "bitset.h"
+#include "roaring.h"
 #include "treeset.h"
+#include "skiplist.h"
 #include "adjlgraph.h"
+#include "csrgraph.h"
 #include "indmindaryheap.h"
 #include "bfsalg.h"
+#include "bfsalg_parallel.h"
+#include "dijkstrasp_parallel.h"
 #include "dijkstrasp.h"
 #include "trie.h"
 #include "trieext.h"
+#include "radixtrie.h"
+#include "statictrie.h"
+#include "art.h"
 #include "dfsalg.h"
+#include "mstalg.h"
+#include "ccalg.h"
+#include "allocator.h"
+#include "numanode.h"
+#include "slidingwindow.h"
+#include "topk.h"
+#include "taskpool.h"
+#include "transclosure.h"
+#include "typedcontainers.h"
 
 /*
  * Depth-first search algorithm for adjacency list graph demo.
@@ -83,8 +118,8 @@ void dfsalg_demo()
 	printf("\n");
 
 	ulong* countp = (ulong*)malloc(sizeof(ulong));
-	dfsalg_countvertices(g, 0, countp);	// deph-first search rec algorithm
-	printf("Recursive DFS node count starting at node 0: %lu\n", *countp);
+	dfsalg_countvertices(g, 0, countp);	// deph-first search engine
+	printf("DFS node count starting at node 0: %lu\n", *countp);
 	if (*countp != 4) printf("Error with DFS\n\n");
 
 	dfsalg_countvertices_iteractive(g, 0, countp);	// deph-first search iteractive algorithm
@@ -92,7 +127,7 @@ void dfsalg_demo()
 	if (*countp != 4) printf("Error with DFS\n\n");
 
 	dfsalg_countvertices(g, 4, countp);	// node 4 is disconnected
-	printf("Recursive DFS node count starting at node 4: %lu\n", *countp);
+	printf("DFS node count starting at node 4: %lu\n", *countp);
 	if (*countp != 1) printf("Error with DFS\n");
 
 	dfsalg_countvertices_iteractive(g, 4, countp);	// node 4 is disconnected
@@ -156,10 +191,111 @@ void dfsalg_demo()
 	printf("\n");
 	dfsalg_destroy_ancestors(ancestors, n);
 	printf("%s", "Ancestors list destroyed successfully.\n");
+
+	// compact bitset result of the same closure
+	struct csrgraph* csr = adjlgraph_freeze_to_csr(g);
+	struct transclosure* tc = transclosure_ancestors_create(csr, 2);
+	printf("Closure: %d components, vertice 2 has %zu ancestors, 0 is ancestor of 3: %s\n",
+			tc->numcomponents, transclosure_countancestors(tc, 2),
+			transclosure_isancestor(tc, 0, 3) ? "yes" : "no");
+	transclosure_destroy(tc);
+	csrgraph_destroy(csr);
+
+	// iteractive DFS engine with one reusable workspace
+	struct dfsalg_workspace* ws = dfsalg_workspace_create(n);
+	int* order = dfsalg_toposort(ws, g);
+	printf("Topological order: ");
+	if (order) {
+		for (int i = 0; i < n; ++i)
+			printf("%d ", order[i]);
+		free(order);
+	}
+	printf("\n");
+
+	adjlgraph_addedge( g, 2, 0, NULL, 0);	// close cycle 0->4->1->2->0
+	int component[n];
+	printf("Strongly connected components after adding edge 2->0: %d\n", dfsalg_scc(ws, g, component));
+	order = dfsalg_toposort(ws, g);
+	printf("Topological order exists: %s\n", (order == NULL) ? "no" : "yes");
+	free(order);
+	dfsalg_workspace_destroy(ws);
 	adjlgraph_destroy(g);
 	printf("%s", "Adjaceny list graph destroyed successfully.\n");
 }
 
+void taskpool_demo()
+{
+	printf("_________\n");
+	printf("WORK-STEALING TASK POOL\n");
+	printf("Task pool demo ------------\n\n");
+
+	#define TASKPOOL_DEMO_THREADS 4
+
+	struct taskpool* pool = taskpool_create(TASKPOOL_DEMO_THREADS);
+	printf("Pool with %d workers (calling thread is worker 0)\n", taskpool_getthreads(pool));
+
+	// parallel DFS count over a random graph with one unreachable vertex
+	int n = 100000, m = 400000;
+	struct adjlgraph_edgeitem* edges = malloc(m * sizeof(*edges));
+	srand(43);
+	for (int i = 0; i < m; ++i) {
+		edges[i].from = rand() % (n - 1);
+		edges[i].to = rand() % (n - 1);
+		edges[i].weight = 1;
+	}
+
+	struct adjlgraph* g = adjlgraph_creategraph(n, DIRECTED_AGRAPH, NULL, NULL, NULL, NULL);
+	for (int i = 0; i < n; ++i)
+		adjlgraph_addvertex(g, i, NULL);
+
+	adjlgraph_addedges(g, edges, m, 1);
+	struct csrgraph* cg = csrgraph_create_from_edges(n, DIRECTED_AGRAPH, edges, m, 1);
+
+	ulong sequential = 0, parallel = 0, csrparallel = 0;
+	dfsalg_countvertices(g, 0, &sequential);
+	dfsalg_countvertices_parallel(pool, g, 0, &parallel);
+	dfsalg_csr_countvertices_parallel(pool, cg, 0, &csrparallel);
+	printf("Graph: %d vertices, %d edges\n", n, m);
+	printf("DFS count from 0: sequential %lu, parallel %lu, parallel CSR %lu\n",
+		   sequential, parallel, csrparallel);
+	if (sequential != parallel || sequential != csrparallel) printf("Error with parallel DFS\n");
+
+	csrgraph_destroy(cg);
+	adjlgraph_destroy(g);
+	free(edges);
+
+	// parallel traversal of a red-black tree, one partial sum per worker
+	int compare(const void* a, const void* b) {
+		return (*((int*)a) > *((int*)b)) - (*((int*)a) < *((int*)b));
+	}
+
+	static long sums[TASKPOOL_DEMO_THREADS * 8];		// 64 bytes apart
+	void sumvisit(void* data, int worker, void* arg) {
+		sums[worker * 8] += *((int*)data);
+	}
+
+	int count = 50000;
+	int* values = malloc(count * sizeof(int));
+	struct rbtree* tree = rbtree_create(NULL, NULL, compare, NULL, NULL, NULL, NULL);
+	for (int i = 0; i < count; ++i) {
+		values[i] = i + 1;
+		rbtree_insert(tree, &values[i]);
+	}
+
+	rbtree_parallel_foreach(pool, tree, sumvisit, NULL);
+	long total = 0;
+	for (int t = 0; t < TASKPOOL_DEMO_THREADS; ++t)
+		total += sums[t * 8];
+
+	printf("Red-black tree of %d elements, parallel sum: %ld (expected %ld)\n", count, total,
+		   (long)count * (count + 1) / 2);
+
+	rbtree_destroy(tree);
+	free(values);
+	taskpool_destroy(pool);
+	printf("Task pool destroyed successfully.\n");
+}
+
 /*
  * Trie extensions demo.
  * */
@@ -204,14 +340,262 @@ void trie_extensions_demo()
 		arraylist_destroy(slist);	// free list
 	}
 //free(prefixp);
+
+	// streaming: one reused buffer, stops after 3 words
+	bool printword(const char* word, size_t length, void* context) {
+		printf("%c%s%c (%zu chars)\n", '"', word, '"', length);
+		return true;
+	}
+
+	printf("\nFirst 3 sugestions for prefix '%s' (streaming):\n", prefix);
+	trieext_foreachword(t, prefix, 3, printword, NULL);
+
+	// top-k by weight (ex: word frequencies)
+	double freqs[9] = {50, 30, 20, 40, 90, 10, 70, 5, 60};
+	for (int i = 0; i < n; ++i)
+		trieext_setweight(t, strings[i], freqs[i]);
+
+	double weights[3];
+	slist = trieext_topk(t, prefix, 3, weights);
+	printf("\nTop 3 words by weight for prefix '%s':\n", prefix);
+	if (slist != NULL) {
+		for (int i = 0; i < slist->length; ++i) {
+			char* sug = (char*)arraylist_get_item_at(slist, i);
+			printf("%c%s%c weight %.0f\n", '"', sug, '"', weights[i]);
+			free(sug);
+		}
+
+		arraylist_destroy(slist);
+	}
+
 	printf("\n");
 	trie_destroy(t);
 	printf("%s", "Trie destroyed successfully.\n");
 }
 
+/*
+ * Compressed trie (radix tree) demo.
+ * */
+void radixtrie_demo()
+{
+	printf("_________\n");
+	printf("RADIX TRIE\n");
+	printf("Radix trie demo ------------\n");
+	printf("\n");
+	struct radixtrie* t = radixtrie_create();
+
+	// any byte is accepted, no index functions are needed
+	char* strings[9] = {"hello", "dog", "hell", "cat", "a", "hel", "help", "helps", "helping"};
+	int n = 9;
+	for (int i = 0; i < n; ++i) {
+		printf("Insert '%s'\n", strings[i]);
+		radixtrie_insert(t, strings[i]);
+	}
+
+	printf("\nPrint trie:\n");
+	radixtrie_print(t);
+	printf("\nWords: %zu, nodes: %zu (uncompressed trie: 18 nodes)\n",
+			radixtrie_getsize(t), t->nodes);
+
+	printf("\nSearch words:\n");
+	printf("Search for '%s': %s\n", "help", radixtrie_search(t, "help") ? "FOUND" : "NOT FOUND");
+	printf("Search for '%s': %s\n", "he", radixtrie_search(t, "he") ? "FOUND" : "NOT FOUND");
+	printf("Search for '%s': %s\n", "helpings", radixtrie_search(t, "helpings") ? "FOUND" : "NOT FOUND");
+
+	char prefix[] = "hel";
+	struct arraylist* slist = radixtrie_getwords(t, prefix);
+	printf("\nAuto sugestions for prefix '%s':\n", prefix);
+	if (slist == NULL)
+		printf("NO SUGESTIONS FOUND!\n");
+	else {
+		for (int i = 0; i < slist->length; ++i) {
+			char* sug = (char*)arraylist_get_item_at(slist, i);
+			printf("%c%s%c\n", '"', sug, '"');
+			free(sug);
+		}
+
+		arraylist_destroy(slist);
+	}
+
+	printf("\n");
+	char* dwords[3] = {"hel", "help", "dog"};
+	for (int i = 0; i < 3; ++i) {
+		if (radixtrie_delete(t, dwords[i]))
+			printf("Deleted word '%s'.\n", dwords[i]);
+		else
+			printf("Failed to delete word '%s'.\n", dwords[i]);
+	}
+
+	printf("\nPrint trie:\n");
+	radixtrie_print(t);
+	printf("\nWords: %zu, nodes: %zu, memory: %zu bytes\n", radixtrie_getsize(t), t->nodes,
+			radixtrie_memsize(t));
+	printf("(a node of an uncompressed trie with 256 chars takes %zu bytes)\n",
+			sizeof(struct trienode) + 256 * sizeof(struct trienode*));
+
+	radixtrie_destroy(t);
+	printf("%s", "Radix trie destroyed successfully.\n");
+}
+
+/*
+ * Static (succinct) trie demo.
+ * */
+void statictrie_demo()
+{
+	printf("_________\n");
+	printf("STATIC TRIE\n");
+	printf("Static trie demo ------------\n");
+	printf("\n");
+
+	// words must be sorted
+	char* strings[9] = {"a", "cat", "dog", "hel", "hell", "hello", "help", "helping", "helps"};
+	int n = 9;
+	struct statictrie* st = statictrie_create_from_sorted(strings, n);
+	printf("Static trie built from %d sorted words: %zu nodes, %zu bytes\n", n, st->numnodes,
+			statictrie_memsize(st));
+
+	printf("\nPrint trie:\n");
+	statictrie_print(st);
+
+	printf("\nSearch words:\n");
+	printf("Search for '%s': %s\n", "help", statictrie_search(st, "help") ? "FOUND" : "NOT FOUND");
+	printf("Search for '%s': %s\n", "he", statictrie_search(st, "he") ? "FOUND" : "NOT FOUND");
+
+	char prefix[] = "help";
+	struct arraylist* slist = statictrie_getwords(st, prefix);
+	printf("\nAuto sugestions for prefix '%s':\n", prefix);
+	if (slist == NULL)
+		printf("NO SUGESTIONS FOUND!\n");
+	else {
+		for (int i = 0; i < slist->length; ++i) {
+			char* sug = (char*)arraylist_get_item_at(slist, i);
+			printf("%c%s%c\n", '"', sug, '"');
+			free(sug);
+		}
+
+		arraylist_destroy(slist);
+	}
+
+	printf("\nSave trie image and map it back (no parsing, no copy)\n");
+	const char* triefile = "statictrie_demo.bin";
+	if (statictrie_save(st, triefile)) {
+		struct statictrie* mt = statictrie_map(triefile);
+		if (mt) {
+			printf("Mapped trie: %zu words, search for '%s': %s\n", statictrie_getsize(mt),
+					"hello", statictrie_search(mt, "hello") ? "FOUND" : "NOT FOUND");
+			statictrie_destroy(mt);
+		}
+		else
+			printf("Failed to map trie file '%s'\n", triefile);
+
+		remove(triefile);
+	}
+	else
+		printf("Failed to save trie file '%s'\n", triefile);
+
+	statictrie_destroy(st);
+
+	// build from an existing trie
+	struct trie* t = trie_create_trie(26, NULL, NULL);
+	char* twords[4] = {"kit", "cattle", "kin", "cat"};
+	for (int i = 0; i < 4; ++i)
+		trie_insert(t, twords[i]);
+
+	st = statictrie_create_from_trie(t);
+	trie_destroy(t);
+	printf("\nStatic trie built from a trie (%zu words):\n", statictrie_getsize(st));
+	statictrie_print(st);
+	statictrie_destroy(st);
+	printf("%s", "Static trie destroyed successfully.\n");
+}
+
 /*
  * Trie demo.
  * */
+/*
+ * Adaptive radix tree demo.
+ * */
+void art_demo()
+{
+	void printvalue(void* data) {
+		printf("%d", *((int*)data));
+	}
+
+	int printurl(const unsigned char* key, size_t keylen, void* value, void* context) {
+		printf("  %.*s -> %d\n", (int)keylen, (const char*)key, *((int*)value));
+		return 1;
+	}
+
+	printf("_________\n");
+	printf("ADAPTIVE RADIX TREE\n");
+	printf("Adaptive radix tree demo ------------\n");
+	printf("\n");
+	struct art* t = art_create(printvalue, NULL);
+
+	// keys are byte strings (no terminator is stored)
+	const char* urls[8] = {"example.com/", "example.com/about", "example.com/blog",
+						   "example.com/blog/2026/art", "example.org/", "example.com/blog/2026",
+						   "api.example.com/v1", "api.example.com/v2"};
+	int hits[8] = {120, 15, 64, 9, 33, 21, 250, 180};
+	for (int i = 0; i < 8; ++i)
+		art_insert(t, (const unsigned char*)urls[i], strlen(urls[i]), &hits[i]);
+
+	printf("Print tree (%zu keys):\n", art_getsize(t));
+	art_print(t);
+
+	const char* s1 = "example.com/blog";
+	const char* s2 = "example.com/bl";
+	int* v = art_search(t, (const unsigned char*)s1, strlen(s1));
+	printf("\nSearch for '%s': %s (%d)\n", s1, v ? "FOUND" : "NOT FOUND", v ? *v : 0);
+	printf("Search for '%s': %s\n", s2,
+		   art_contains(t, (const unsigned char*)s2, strlen(s2)) ? "FOUND" : "NOT FOUND");
+
+	const char* prefix = "example.com/blog";
+	printf("\nPrefix scan '%s':\n", prefix);
+	size_t count = art_prefix_scan(t, (const unsigned char*)prefix, strlen(prefix), printurl, NULL);
+	printf("%zu keys found\n", count);
+
+	const char* from = "example.com/c";
+	printf("\nKeys from '%s' (iterator seek):\n", from);
+	struct art_iter it;
+	for (struct artleaf* l = art_iter_seek(t, (const unsigned char*)from, strlen(from), &it); l;
+		 l = art_iter_next(&it))
+		printurl(l->key, l->keylen, l->value, NULL);
+	art_iter_release(&it);
+
+	art_remove(t, (const unsigned char*)s1, strlen(s1));
+	printf("\nRemoved '%s', search: %s, keys: %zu\n", s1,
+		   art_contains(t, (const unsigned char*)s1, strlen(s1)) ? "FOUND" : "NOT FOUND",
+		   art_getsize(t));
+	art_destroy(t);
+
+	// integer keys, big endian keeps numeric order
+	printf("\nInteger keys (IPv4 addresses):\n");
+	struct art* ips = art_create(printvalue, NULL);
+	int ids[6] = {1, 2, 3, 4, 5, 6};
+	uint64_t addrs[6] = {0xC0A80001, 0x0A000001, 0xC0A8000A, 0x08080808, 0x0A0000FE, 0xC0A80002};
+	unsigned char key[8];
+	for (int i = 0; i < 6; ++i) {
+		art_encode_u64(addrs[i], key);
+		art_insert(ips, key, 8, &ids[i]);
+	}
+
+	art_encode_u64(0x0A000000, key);
+	printf("Addresses from 10.0.0.0 in ascending order:\n");
+	for (struct artleaf* l = art_iter_seek(ips, key, 8, &it); l; l = art_iter_next(&it))
+		printf("  %d.%d.%d.%d -> %d\n", l->key[4], l->key[5], l->key[6], l->key[7],
+			   *((int*)l->value));
+	art_iter_release(&it);
+
+	struct artleaf* mn = art_minimum(ips);
+	struct artleaf* mx = art_maximum(ips);
+	printf("Minimum: %d.%d.%d.%d, maximum: %d.%d.%d.%d\n", mn->key[4], mn->key[5], mn->key[6],
+		   mn->key[7], mx->key[4], mx->key[5], mx->key[6], mx->key[7]);
+
+	art_destroy(ips);
+	printf("%s", "Adaptive radix trees destroyed successfully.\n");
+}
+
 void trie_demo()
 {
 	printf("_________\n");
@@ -392,126 +776,903 @@ void adjlgraph_demo()
 }
 
 /*
- * Treeset (ordered set) demo.
+ * Priority queues benchmark: Dijkstra one to all queries on a random integer weighted
+ * graph with every priority queue (results must be the same).
  * */
-void treeset_demo()
+void pqueue_benchmark_demo()
 {
+	printf("_________\n");
+	printf("PRIORITY QUEUES FOR DIJKSTRA\n");
+	printf("PRIORITY QUEUES benchmark ------------\n");
+	printf("\n");
+
 	/*
-	 * Compare function for treeset elements.
-	 * Returns 0, 1 or -1.
+	 * Compares two boxed (or 'dist' entry) doubles.
 	 */
-	int compare(const void* key1, const void* key2) {
-		if ((key1 == NULL) && (key2 == NULL)) return 0;
-		else if (key1 == NULL) return -1;
-		else if (key2 == NULL) return 1;
-		else {
-			int ikey1 = *((int*)key1);
-			int ikey2 = *((int*)key2);
-
-			if (ikey1 == ikey2) return 0;
-			else if (ikey1 > ikey2) return 1;
-			else return -1;
-		}
+	int compare(const void* a, const void* b) {
+		double da = *((const double*)a), db = *((const double*)b);
+		return (da > db) - (da < db);
 	}
 
 	/*
-	 * Computes size of a set element in bytes.
-	 * Note: Used by the reb-black tree.
+	 * Boxes a distance (generic indexed heaps store priorities by pointer).
 	 */
-	size_t calcelementsize(const void* data) {
-		return sizeof(int);
+	double* box(double d) {
+		double* p = malloc(sizeof(double));
+		*p = d;
+		return p;
 	}
 
 	/*
-	 * Needed for red-black tree to perform operations like removing nodes.
+	 * Elapsed milliseconds since 't0'.
 	 */
-	void copyelement( void* dest, const void* from ) {
-		if (from)
-			if (dest)
-				*((int*)dest) = *((int*)from);
+	double elapsed(struct timespec* t0) {
+		struct timespec t1;
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		return (t1.tv_sec - t0->tv_sec) * 1e3 + (t1.tv_nsec - t0->tv_nsec) / 1e6;
 	}
 
-	/*
-	 * Prints a set element.
-	 */
-	void printelement(const void* element) {
-		if (element) {
-			int ivalue = *((int*)element);
-			printf("%d", ivalue);
-		}
+	int n = 20000, m = 160000, queries = 5;
+	struct adjlgraph_edgeitem* edges = malloc(m * sizeof(*edges));
+	srand(29);
+	for (int i = 0; i < m; ++i) {
+		edges[i].from = rand() % n;
+		edges[i].to = rand() % n;
+		edges[i].weight = 1 + rand() % 100;
 	}
 
-	printf("_________\n");
-	printf("TREESET (ordered set)\n");
-	printf("\nTreeset (with red-black tree) demo ------------\n");
-	printf("Uses a red-black tree to store elements\n\n");
-	struct treeset* set = treeset_create( calcelementsize, copyelement,
-										  compare, printelement, NULL );
+	struct csrgraph* g = csrgraph_create_from_edges(n, DIRECTED_AGRAPH, edges, m, 1);
+	printf("Graph: %d vertices, %d edges (weights 1 to 100), %d one to all queries\n\n",
+		   n, m, queries);
+
+	double* dist = malloc(n * sizeof(double));
+	double* refdist = malloc(n * sizeof(double));
+	int* done = malloc(n * sizeof(int));
+	double checksum = 0;
+	struct timespec t0;
+
+	// generic indexed heaps (binary and 4-ary) with boxed priorities
+	for (int kind = 0; kind < 2; ++kind) {
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (int q = 0; q < queries; ++q) {
+			struct iminbinarypq* bpq = NULL;
+			struct idarypq* dpq = NULL;
+			if (kind == 0) bpq = iminbinpq_create(n, compare, NULL, free);
+			else dpq = imindarypq_create(4, n, compare, NULL, free);
+
+			for (int v = 0; v < n; ++v) { dist[v] = DBL_MAX; done[v] = 0; }
+			dist[q] = 0;
+			if (kind == 0) iminbinpq_insert(bpq, q, box(0));
+			else imindarypq_insert(dpq, q, box(0));
+
+			while (kind == 0 ? !iminbinpq_isempty(bpq) : !imindarypq_isempty(dpq)) {
+				int u = (kind == 0) ? iminbinpq_extractkeyindex(bpq) : imindarypq_extractkeyindex(dpq);
+				done[u] = 1;
+				for (size_t e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+					int v = g->targets[e];
+					double nd = dist[u] + g->weights[e];
+					if (done[v] || nd >= dist[v]) continue;
+					if (kind == 0) {
+						if (dist[v] == DBL_MAX) iminbinpq_insert(bpq, v, box(nd));
+						else iminbinpq_decrease(bpq, v, box(nd));
+					}
+					else {
+						if (dist[v] == DBL_MAX) imindarypq_insert(dpq, v, box(nd));
+						else imindarypq_decrease(dpq, v, box(nd));
+					}
+					dist[v] = nd;
+				}
+			}
 
-//	char spaces[] = "    ";
-	int values[100];
-	int n = 100;
+			if (kind == 0) iminbinpq_destroy(bpq);
+			else imindarypq_destroy(dpq);
+		}
+		printf("%-36s %8.1f ms\n", kind == 0 ? "indminbinaryheap (boxed doubles):" :
+				"indmindaryheap D=4 (boxed doubles):", elapsed(&t0));
+		memcpy(refdist, dist, n * sizeof(double));
+	}
 
-	// insert values in treeset { 99, 98, 97, 96, 95, 94, 93, 92, 91, 90 }
-	for (int i = 0; i < 10; ++i) {
-		values[i] = (n-1) - i;
-		treeset_add( set, &values[i] );
+	// Fibonacci heap with node handles (elements point to 'dist' entries)
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	struct fibheapnode** fhandles = malloc(n * sizeof(struct fibheapnode*));
+	for (int q = 0; q < queries; ++q) {
+		double minus_inf = -DBL_MAX;
+		struct fibheap* fh = fibheap_create(&minus_inf, compare, NULL, NULL);
+		for (int v = 0; v < n; ++v) { dist[v] = DBL_MAX; done[v] = 0; }
+		dist[q] = 0;
+		fhandles[q] = fibheap_insert(fh, &dist[q]);
+
+		while (fh->mini != NULL) {
+			struct fibheapnode* node = fibheap_extract_min(fh);
+			int u = (int)((double*)node->key - dist);
+			fibheap_destroynode(fh, node);
+			done[u] = 1;
+			for (size_t e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+				int v = g->targets[e];
+				double nd = dist[u] + g->weights[e];
+				if (done[v] || nd >= dist[v]) continue;
+				int queued = (dist[v] != DBL_MAX);
+				dist[v] = nd;
+				if (queued) fibheap_decrease_key(fh, fhandles[v], &dist[v]);
+				else fhandles[v] = fibheap_insert(fh, &dist[v]);
+			}
+		}
+
+		fibheap_destroy(fh);
+	}
+	printf("%-36s %8.1f ms\n", "fibonacciheap (node handles):", elapsed(&t0));
+	free(fhandles);
+
+	int mismatches = 0;
+	for (int v = 0; v < n; ++v)
+		if (dist[v] != refdist[v]) mismatches++;
+
+	// Dijkstra contexts
+	const char* names[] = { "dijkstrasp 4-ary heap of doubles:", "dijkstrasp pairing heap:",
+							"dijkstrasp radix heap:" };
+	for (int queue = DIJKSTRASP_QUEUE_DARY; queue <= DIJKSTRASP_QUEUE_RADIX; ++queue) {
+		struct dijkstrasp_context* ctx = dijkstrasp_context_create_queue(n, queue);
+		int size = 0;
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (int q = 0; q < queries; ++q)
+			dijkstrasp_context_csr_shortest_path(ctx, g, q, -1, &size);
+		printf("%-36s %8.1f ms\n", names[queue], elapsed(&t0));
+
+		for (int v = 0; v < n; ++v)
+			if (dijkstrasp_context_distance(ctx, v) != refdist[v]) mismatches++;
+
+		dijkstrasp_context_destroy(ctx);
 	}
 
-	printf("Print treeset:\n");
-	treeset_print( set , 0);
+	for (int v = 0; v < n; ++v)
+		if (refdist[v] != DBL_MAX) checksum += refdist[v];
 
-	printf( "\nTreeset size: %zu\n", set->size);
+	printf("\nSum of distances from vertex %d: %.0f, mismatches between queues: %d\n",
+		   queries - 1, checksum, mismatches);
 
-	// check if hashtable contains key '2'
-	printf("Does treeset contains element '%d'?\n", values[2]);
-	if (treeset_contains(set, &values[2]))
-		printf("YES\n\n");
-	else
-		printf("NO\n\n");
+	free(edges);
+	free(dist);
+	free(refdist);
+	free(done);
+	csrgraph_destroy(g);
+}
 
-	// remove element with values[2]
-	printf("Element with value = '%d' will be removed from treeset.\n", values[2]);
-	void* del = treeset_remove(set, &values[2]);
-	if (del != NULL) {
-		printf("Element '%d') was removed from treeset.\n",	*((int*)del));
-	}
-	else
-		printf("Failed to remove element '%d' from treeset!\n", values[2]);
+/*
+ * CSR (compressed sparse row) graph demo.
+ * */
+void csrgraph_demo()
+{
+	printf("_________\n");
+	printf("CSR GRAPH\n");
+	printf("Compressed sparse row graph demo ------------\n");
 
-	// check if set contains element values[2]
-	printf("\nDoes treeset contains value '%d'?\n", values[2]);
-	if (treeset_contains(set, &values[2]))
-		printf("YES\n\n");
-	else
-		printf("NO\n\n");
+	printf("\nImmutable graph built from an adjacency list graph, edges are stored in flat arrays\n\n");
+	int numvertices = 13;
+	struct adjlgraph* ag = adjlgraph_creategraph( numvertices, UNDIRECTED_AGRAPH,
+												  NULL, NULL,
+												  NULL, NULL );
 
-	printf("Treeset size: %zu\n", set->size);
+	for (int i = 0; i < numvertices; ++i) {
+		adjlgraph_addvertex(ag, i, NULL);
+	}
 
-	printf("\nPrint treeset:\n");
-	treeset_print(set, 0);
+	adjlgraph_addedge(ag, 0, 7, NULL, 1);
+	adjlgraph_addedge(ag, 0, 9, NULL, 1);
+	adjlgraph_addedge(ag, 0, 11, NULL, 1);
+	adjlgraph_addedge(ag, 7, 11, NULL, 1);
+	adjlgraph_addedge(ag, 7, 6, NULL, 1);
+	adjlgraph_addedge(ag, 7, 3, NULL, 1);
+	adjlgraph_addedge(ag, 6, 5, NULL, 1);
+	adjlgraph_addedge(ag, 3, 4, NULL, 1);
+	adjlgraph_addedge(ag, 2, 3, NULL, 1);
+	adjlgraph_addedge(ag, 2, 12, NULL, 1);
+	adjlgraph_addedge(ag, 12, 8, NULL, 1);
+	adjlgraph_addedge(ag, 8, 1, NULL, 1);
+	adjlgraph_addedge(ag, 1, 10, NULL, 1);
+	adjlgraph_addedge(ag, 10, 9, NULL, 1);
+	adjlgraph_addedge(ag, 9, 8, NULL, 1);
 
-	struct rbtree* tree = set->tree;
-	printf("Root: %d\n\n", *((int*)tree->root->data));
+	// freeze and release source graph, CSR graph does not depend on it
+	struct csrgraph* cg = adjlgraph_freeze_to_csr(ag);
+	adjlgraph_destroy(ag);
 
+	printf("Print CSR graph (%zu edges):\n", csrgraph_getnumedges(cg));
+	csrgraph_print(cg);
 	printf("\n");
-	int test_values[] = { 4, 91, 99, 100 };
-	int ntest = 4;
 
-	// test floor
-	for (int i = 0; i < ntest; i++) {
-		void* floor = treeset_floor(set, set->tree->root, &test_values[i]);
-		printf("Floor of '%d': ", test_values[i]);
+	int start = 10, end = 5;
+	int res_size = -1;
+	int* spath = bfsalg_csr_shortest_path(cg, start, end, &res_size);
 
-		if (floor)
-			printf("%d\n", *((int*)floor) );
-		else
-			printf("no value found.\n");
+	printf("Breadth first search shortest path from vertice %d to %d:\n", start, end);
+	if (spath) {
+		bfsalg_print_path(spath, res_size);
+		free(spath);
+	} else {
+		printf("No path found from '%d' to '%d'.\n", start, end);
 	}
 
+	// many queries reusing the same buffers, nothing is cleared between queries
+	struct bfsalg_workspace* ws = bfsalg_workspace_create(cg->numvertices);
+	printf("Path lengths from vertice %d (reusable workspace):", start);
+	for (end = 0; end < cg->numvertices; ++end) {
+		spath = bfsalg_workspace_csr_shortest_path(ws, cg, start, end, &res_size);
+		if (spath) {
+			printf(" %d=%d", end, res_size - 1);
+			free(spath);
+		}
+	}
 	printf("\n");
+	bfsalg_workspace_destroy(ws);
 
-	// test ceiling
+	// level synchronous search with 4 threads (undirected graph is its own reverse)
+	end = 5;
+	spath = bfsalg_parallel_shortest_path(cg, NULL, start, end, 4, &res_size);
+	printf("Parallel breadth first search shortest path from vertice %d to %d:\n", start, end);
+	if (spath) {
+		bfsalg_print_path(spath, res_size);
+		free(spath);
+	} else {
+		printf("No path found from '%d' to '%d'.\n", start, end);
+	}
+
+	ulong count = 0;
+	dfsalg_csr_countvertices(cg, 0, &count);
+	printf("Depth first search connected vertices from vertice 0: %lu\n\n", count);
+	csrgraph_destroy(cg);
+
+	printf("Bulk loading edges (one allocation for all edge nodes)\n\n");
+	struct adjlgraph_edgeitem bulkedges[] = { {0, 1, 1}, {0, 2, 1}, {1, 3, 1}, {2, 3, 1}, {3, 4, 1} };
+	ag = adjlgraph_creategraph( 5, UNDIRECTED_AGRAPH, NULL, NULL, NULL, NULL );
+	adjlgraph_addedges(ag, bulkedges, 5, 1);	// vertices are created by the loader
+	printf("Bulk loaded graph (%zu edges):\n", adjlgraph_getnumedges(ag));
+	adjlgraph_print(ag);
+	adjlgraph_destroy(ag);
+
+	cg = csrgraph_create_from_edges(5, UNDIRECTED_AGRAPH, bulkedges, 5, 2);
+	printf("CSR graph built directly from the edges: %zu edges, degree of vertex 3: %zu\n\n",
+			csrgraph_getnumedges(cg), csrgraph_degree(cg, 3));
+	csrgraph_destroy(cg);
+
+	printf("Dijkstra shortest path on CSR graph\n\n");
+	numvertices = 5;
+	ag = adjlgraph_creategraph( numvertices, DIRECTED_AGRAPH,
+								NULL, NULL,
+								NULL, NULL );
+
+	for (int i = 0; i < numvertices; ++i) {
+		adjlgraph_addvertex(ag, i, NULL);
+	}
+
+	adjlgraph_addedge(ag, 0, 1, NULL, 4);
+	adjlgraph_addedge(ag, 0, 2, NULL, 1);
+	adjlgraph_addedge(ag, 1, 3, NULL, 1);
+	adjlgraph_addedge(ag, 2, 1, NULL, 2);
+	adjlgraph_addedge(ag, 2, 3, NULL, 5);
+	adjlgraph_addedge(ag, 3, 4, NULL, 3);
+
+	cg = adjlgraph_freeze_to_csr(ag);
+	adjlgraph_destroy(ag);
+	csrgraph_print(cg);
+	printf("\n");
+
+	start = 0; end = 4;
+	double dist[5];
+	int* spathdij = dijkstrasp_csr_shortest_path(cg, start, end, dist, &res_size);
+
+	if (spathdij) {
+		printf("Distance from '%d' to '%d': %.1f\n", start, end, dist[end]);
+		printf("Dijkstra shortest path: ");
+		dijkstrasp_print_path(spathdij, res_size);
+		free(spathdij);
+	} else {
+		printf("No path found from '%d' to '%d'.\n", start, end);
+	}
+
+	// many queries reusing the same buffers
+	struct dijkstrasp_context* ctx = dijkstrasp_context_create(cg->numvertices);
+	printf("Distances from '%d' (reusable context):", start);
+	for (end = 1; end < cg->numvertices; ++end) {
+		spathdij = dijkstrasp_context_csr_shortest_path(ctx, cg, start, end, &res_size);
+		if (spathdij) {
+			printf(" %d=%.1f", end, dijkstrasp_context_distance(ctx, end));
+			free(spathdij);
+		}
+	}
+	printf("\n");
+	dijkstrasp_context_destroy(ctx);
+	csrgraph_destroy(cg);
+
+	printf("\nPoint to point search on a 30x30 grid graph (settled vertices)\n\n");
+	int side = 30;
+	ag = adjlgraph_creategraph( side * side, UNDIRECTED_AGRAPH,
+								NULL, NULL,
+								NULL, NULL );
+
+	for (int i = 0; i < side * side; ++i) {
+		adjlgraph_addvertex(ag, i, NULL);
+	}
+
+	for (int r = 0; r < side; ++r)
+		for (int c = 0; c < side; ++c) {
+			if (c + 1 < side) adjlgraph_addedge(ag, r * side + c, r * side + c + 1, NULL, 1);
+			if (r + 1 < side) adjlgraph_addedge(ag, r * side + c, (r + 1) * side + c, NULL, 1);
+		}
+
+	cg = adjlgraph_freeze_to_csr(ag);
+	adjlgraph_destroy(ag);
+	struct csrgraph* rcg = csrgraph_create_reverse(cg);
+
+	/*
+	 * Manhattan distance between grid vertices (never overestimates).
+	 */
+	double manhattan(int v, int target, void* arg) {
+		int n = *((int*)arg);
+		return abs(v / n - target / n) + abs(v % n - target % n);
+	}
+
+	start = 5 * side + 5; end = 20 * side + 25;
+	struct dijkstrasp_context* fwd = dijkstrasp_context_create(cg->numvertices);
+	struct dijkstrasp_context* bwd = dijkstrasp_context_create(cg->numvertices);
+	double dd = 0;
+
+	spathdij = dijkstrasp_context_csr_shortest_path(fwd, cg, start, end, &res_size);
+	printf("Dijkstra:      distance %.1f, settled %d\n", dijkstrasp_context_distance(fwd, end), fwd->numsettled);
+	free(spathdij);
+
+	spathdij = dijkstrasp_context_bidirectional(fwd, bwd, cg, rcg, start, end, &dd, &res_size);
+	printf("Bidirectional: distance %.1f, settled %d\n", dd, fwd->numsettled + bwd->numsettled);
+	free(spathdij);
+
+	spathdij = dijkstrasp_context_astar_csr_shortest_path(fwd, cg, start, end, manhattan, &side, &res_size);
+	printf("A*:            distance %.1f, settled %d\n", dijkstrasp_context_distance(fwd, end), fwd->numsettled);
+	free(spathdij);
+
+	printf("\nDelta-stepping (4 threads) vs Dijkstra distances from '%d'\n\n", start);
+	double* dijdist = (double*)malloc(cg->numvertices * sizeof(double));
+	double* dsdist = (double*)malloc(cg->numvertices * sizeof(double));
+	int* dsprev = (int*)malloc(cg->numvertices * sizeof(int));
+	spathdij = dijkstrasp_csr_shortest_path(cg, start, -1, dijdist, &res_size);
+	dijkstrasp_parallel_delta_stepping(cg, start, 0, 4, dsdist, dsprev);
+	int mismatches = 0;
+	for (size_t v = 0; v < cg->numvertices; ++v)
+		if (dijdist[v] != dsdist[v])
+			mismatches++;
+
+	printf("Delta %.2f, distance to %d: %.1f, mismatches: %d\n",
+			dijkstrasp_parallel_default_delta(cg), end, dsdist[end], mismatches);
+	spath = bfsalg_reconstruct_path(start, end, dsprev, cg->numvertices, &res_size);
+	printf("Delta-stepping path to %d has %d vertices\n", end, res_size);
+	free(spath);
+	free(spathdij);
+	free(dsprev);
+	free(dsdist);
+	free(dijdist);
+
+	printf("\nGraph file: save grid graph and map it back (no parsing, no copy)\n\n");
+	// vertex payload: grid coordinates
+	int* coords = (int*)malloc(cg->numvertices * 2 * sizeof(int));
+	for (int i = 0; i < side * side; ++i) {
+		coords[2 * i] = i / side;
+		coords[2 * i + 1] = i % side;
+	}
+
+	const char* graphfile = "csrgraph_demo.bin";
+	if (csrgraph_save(cg, graphfile, 1, coords, 2 * sizeof(int), NULL, 0)) {
+		struct csrgraph* mg = csrgraph_map(graphfile);
+		if (mg) {
+			const int* xy = (const int*)csrgraph_vertexpayload(mg, end);
+			printf("Mapped graph: %zu vertices, %zu arcs, vertex %d at (%d, %d)\n",
+					mg->numvertices, mg->numarcs, end, xy[0], xy[1]);
+
+			spathdij = dijkstrasp_context_csr_shortest_path(fwd, mg, start, end, &res_size);
+			printf("Dijkstra on mapped graph: distance %.1f, settled %d\n",
+					dijkstrasp_context_distance(fwd, end), fwd->numsettled);
+			free(spathdij);
+
+			spath = bfsalg_csr_shortest_path(mg, start, end, &res_size);
+			printf("BFS on mapped graph: path with %d vertices\n", res_size);
+			free(spath);
+			csrgraph_destroy(mg);
+		}
+		else
+			printf("Failed to map graph file '%s'\n", graphfile);
+
+		remove(graphfile);
+	}
+	else
+		printf("Failed to save graph file '%s'\n", graphfile);
+
+	free(coords);
+	dijkstrasp_context_destroy(fwd);
+	dijkstrasp_context_destroy(bwd);
+	csrgraph_destroy(rcg);
+	csrgraph_destroy(cg);
+	printf("%s", "CSR graph destroyed successfully.\n");
+}
+
+/*
+ * Minimum spanning tree and connected components demo.
+ * */
+void mstalg_demo()
+{
+	printf("_________\n");
+	printf("MINIMUM SPANNING TREE AND CONNECTED COMPONENTS\n");
+	printf("Kruskal, Prim and connected components demo ------------\n\n");
+
+	// tiny weighted graph of Sedgewick's Algorithms (minimum spanning tree weight 1.81)
+	struct adjlgraph_edgeitem edges[] = {
+		{ 4, 5, 0.35 }, { 4, 7, 0.37 }, { 5, 7, 0.28 }, { 0, 7, 0.16 }, { 1, 5, 0.32 },
+		{ 0, 4, 0.38 }, { 2, 3, 0.17 }, { 1, 7, 0.19 }, { 0, 2, 0.26 }, { 1, 2, 0.36 },
+		{ 1, 3, 0.29 }, { 2, 7, 0.34 }, { 6, 2, 0.40 }, { 3, 6, 0.52 }, { 6, 0, 0.58 },
+		{ 6, 4, 0.93 }
+	};
+	int numvertices = 8, numedges = sizeof(edges) / sizeof(edges[0]);
+
+	struct adjlgraph* g = adjlgraph_creategraph(numvertices, UNDIRECTED_AGRAPH, NULL, NULL, NULL, NULL);
+	for (int i = 0; i < numvertices; ++i)
+		adjlgraph_addvertex(g, i, NULL);
+
+	adjlgraph_addedges(g, edges, numedges, 1);
+	struct csrgraph* cg = adjlgraph_freeze_to_csr(g);
+
+	double total = 0;
+	size_t size = 0;
+	struct adjlgraph_edgeitem* mst = mstalg_kruskal_adjlist(g, &total, &size);
+	printf("Kruskal (%zu edges, weight %.2f): ", size, total);
+	for (size_t i = 0; i < size; ++i)
+		printf("%d-%d %.2f  ", mst[i].from, mst[i].to, mst[i].weight);
+	printf("\n");
+	free(mst);
+
+	mst = mstalg_prim_csr(cg, &total, &size);
+	printf("Prim on CSR graph (%zu edges, weight %.2f): ", size, total);
+	for (size_t i = 0; i < size; ++i)
+		printf("%d-%d %.2f  ", mst[i].from, mst[i].to, mst[i].weight);
+	printf("\n");
+	free(mst);
+
+	csrgraph_destroy(cg);
+	adjlgraph_destroy(g);
+
+	// random sparse graph: spanning forest and components, sequential and parallel
+	int n = 200000;
+	size_t m = (size_t)n / 2 * 3;
+	struct adjlgraph_edgeitem* random = malloc(m * sizeof(struct adjlgraph_edgeitem));
+	srand(58);
+	for (size_t i = 0; i < m; ++i) {
+		random[i].from = rand() % n;
+		random[i].to = rand() % n;
+		random[i].weight = (double)(rand() % 1000);
+	}
+
+	cg = csrgraph_create_from_edges(n, UNDIRECTED_AGRAPH, random, m, 1);
+	double kruskaltotal = 0, primtotal = 0;
+	size_t kruskalsize = 0, primsize = 0;
+	free(mstalg_kruskal_csr(cg, &kruskaltotal, &kruskalsize));
+	free(mstalg_prim_csr(cg, &primtotal, &primsize));
+
+	int components = 0, parallelcomponents = 0;
+	int* labels = ccalg_components_csr(cg, &components);
+	int* parallellabels = ccalg_components_parallel(cg, 4, &parallelcomponents);
+	int same = (components == parallelcomponents);
+	for (int v = 0; same && (v < n); ++v)
+		same = (labels[v] == parallellabels[v]);
+
+	printf("\nRandom graph: %d vertices, %zu edges\n", n, m);
+	printf("Spanning forest: Kruskal %zu edges weight %.0f, Prim %zu edges weight %.0f\n",
+		   kruskalsize, kruskaltotal, primsize, primtotal);
+	printf("Connected components: %d (union-find), %d (parallel), labels %s\n",
+		   components, parallelcomponents, same ? "match" : "differ");
+	if ((kruskaltotal != primtotal) || ((size_t)(n - components) != kruskalsize) || !same)
+		printf("Error with spanning forest or components\n");
+
+	free(labels);
+	free(parallellabels);
+	csrgraph_destroy(cg);
+	free(random);
+}
+
+void allocator_demo()
+{
+	printf("_________\n");
+	printf("ALLOCATORS\n");
+	printf("Region allocator (one arena per request) demo ------------\n\n");
+
+	int compare(const void* a, const void* b) {
+		int x = *(const int*)a, y = *(const int*)b;
+		return (x > y) - (x < y);
+	}
+
+	double elapsed(struct timespec* t0) {
+		struct timespec t1;
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		return (t1.tv_sec - t0->tv_sec) * 1e3 + (t1.tv_nsec - t0->tv_nsec) / 1e6;
+	}
+
+	int n = 100000, requests = 20;
+	int* values = malloc(n * sizeof(int));
+	for (int i = 0; i < n; ++i)
+		values[i] = (int)(((long)i * 7919) % n);	// permutation of 0..n-1
+
+	// every request builds a tree, a list and a graph, then drops them all at once
+	struct allocator_region* region = allocator_region_create(0, NULL);
+	const struct allocator* a = allocator_region_get(region);
+	struct timespec t0;
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	size_t used = 0;
+	for (int r = 0; r < requests; ++r) {
+		struct rbtree* tree = rbtree_create_allocator(NULL, NULL, compare, NULL, NULL, NULL, NULL, a);
+		struct arraylist* list = arraylist_create_allocator(0, a);
+		struct adjlgraph* g = adjlgraph_creategraph_allocator(1000, DIRECTED_AGRAPH, NULL, NULL, NULL, NULL, a);
+		for (int i = 0; i < n; ++i) {
+			rbtree_insert(tree, &values[i]);
+			arraylist_add(list, &values[i]);
+		}
+
+		for (int v = 0; v < 1000; ++v)
+			adjlgraph_addvertex(g, v, NULL);
+		for (int v = 0; v < 1000; ++v)
+			adjlgraph_addedge(g, v, (v + 1) % 1000, NULL, 1.0);
+
+		used = allocator_region_getused(region);
+		allocator_region_reset(region);		// tree, list and graph are gone, no node visited
+	}
+	printf("%-40s %8.1f ms (%zu KiB per request)\n", "region allocator, reset per request:",
+			elapsed(&t0), used / 1024);
+
+	// same work with the C library, containers are destroyed node by node
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (int r = 0; r < requests; ++r) {
+		struct rbtree* tree = rbtree_create(NULL, NULL, compare, NULL, NULL, NULL, NULL);
+		struct arraylist* list = arraylist_create_capacity(0);
+		struct adjlgraph* g = adjlgraph_creategraph(1000, DIRECTED_AGRAPH, NULL, NULL, NULL, NULL);
+		for (int i = 0; i < n; ++i) {
+			rbtree_insert(tree, &values[i]);
+			arraylist_add(list, &values[i]);
+		}
+
+		for (int v = 0; v < 1000; ++v)
+			adjlgraph_addvertex(g, v, NULL);
+		for (int v = 0; v < 1000; ++v)
+			adjlgraph_addedge(g, v, (v + 1) % 1000, NULL, 1.0);
+
+		adjlgraph_destroy(g);
+		arraylist_destroy(list);
+		rbtree_destroy(tree);
+	}
+	printf("%-40s %8.1f ms\n", "malloc, destroy per request:", elapsed(&t0));
+
+	// containers in a region are never destroyed one by one
+	struct trie* t = trie_create_allocator(TRIE_DEFAULT_NUM_CHARS, NULL, NULL, a);
+	trie_insert(t, "region");
+	trie_insert(t, "regional");
+	printf("trie in region: 'regional' %s\n", trie_search(t, "regional") ? "found" : "not found");
+	allocator_region_reset(region);
+
+	allocator_region_destroy(region);
+	free(values);
+}
+
+/*
+ * Treeset (ordered set) demo.
+ * */
+void prbtree_demo()
+{
+	int compare(const void* data1, const void* data2) {
+		int a = *((int*)data1), b = *((int*)data2);
+		return (a > b) - (a < b);
+	}
+
+	void printdata(const void* data) {
+		printf("%d", *((int*)data));
+	}
+
+	printf("_________\n");
+	printf("PERSISTENT RED-BLACK TREE\n");
+	printf("\nPersistent red-black tree demo ------------\n");
+	printf("Updates copy the path to the changed node, readers search snapshots without locks\n\n");
+
+	struct prbtree* tree = prbtree_create(compare, printdata);
+
+	#define PRBTREE_DEMO_READERS 3
+	#define PRBTREE_DEMO_KEYS 2000
+
+	static int keys[PRBTREE_DEMO_KEYS];
+	for (int i = 0; i < PRBTREE_DEMO_KEYS; ++i)
+		keys[i] = i;
+
+	for (int i = 0; i < 10; ++i)
+		prbtree_insert(tree, &keys[i]);
+
+	// a snapshot does not see later changes
+	struct prbtree_snapshot* before = prbtree_snapshot_take(tree);
+	prbtree_delete(tree, &keys[3]);
+	prbtree_insert(tree, &keys[42]);
+	struct prbtree_snapshot* after = prbtree_snapshot_take(tree);
+
+	printf("Snapshot before changes (size %zu): ", before->size);
+	prbtree_snapshot_print(before);
+	printf("Snapshot after changes (size %zu): ", after->size);
+	prbtree_snapshot_print(after);
+	prbtree_snapshot_release(before);
+	prbtree_snapshot_release(after);
+
+	// readers check every snapshot is sorted while writer inserts and deletes keys
+	void* reader(void* arg) {
+		long bad = 0;
+		for (int round = 0; round < 200; ++round) {
+			struct prbtree_snapshot* snap = prbtree_snapshot_take(tree);
+			struct prbtree_iter it;
+			size_t count = 0;
+			int last = -1;
+			for (void* e = prbtree_iter_first(snap, &it); e != NULL; e = prbtree_iter_next(&it)) {
+				bad += (*((int*)e) <= last);
+				last = *((int*)e);
+				count++;
+			}
+
+			bad += (count != snap->size);
+			prbtree_snapshot_release(snap);
+		}
+
+		return (void*)bad;
+	}
+
+	pthread_t readers[PRBTREE_DEMO_READERS];
+	for (int t = 0; t < PRBTREE_DEMO_READERS; ++t)
+		pthread_create(&readers[t], NULL, reader, NULL);
+
+	for (int i = 0; i < PRBTREE_DEMO_KEYS; ++i)
+		prbtree_insert(tree, &keys[i]);
+
+	for (int i = 0; i < PRBTREE_DEMO_KEYS; i += 2)
+		prbtree_delete(tree, &keys[i]);
+
+	long bad = 0;
+	for (int t = 0; t < PRBTREE_DEMO_READERS; ++t) {
+		void* result = NULL;
+		pthread_join(readers[t], &result);
+		bad += (long)result;
+	}
+
+	struct prbtree_snapshot* snap = prbtree_snapshot_take(tree);
+	int key = 1001;
+	void* floor = prbtree_snapshot_floor(snap, &keys[1000]);
+	printf("Readers: %d, inconsistent snapshots seen: %ld\n", PRBTREE_DEMO_READERS, bad);
+	printf("Final size: %zu, contains %d: %d, floor of %d: %d\n", snap->size, key,
+		   prbtree_snapshot_search(snap, &key) != NULL, keys[1000], *((int*)floor));
+	prbtree_snapshot_release(snap);
+
+	prbtree_destroy(tree);
+	printf("%s", "Persistent red-black tree destroyed successfully.\n");
+}
+
+// type specialized containers (int and string elements stored by value)
+DEFINE_ARRAYLIST(intlist, int)
+DEFINE_ARRAYLIST_SORT(intlist, int, TC_CMP_NUM)
+DEFINE_HEAP(intheap, int, TC_CMP_NUM)
+DEFINE_HASHTABLE(intmap, int, int, tc_hash_int, TC_EQ_NUM)
+DEFINE_HASHTABLE(strmap, const char*, int, tc_hash_str, TC_EQ_STR)
+DEFINE_TREESET(intset, int, TC_CMP_NUM)
+
+/*
+ * Typed containers demo.
+ * */
+void typedcontainers_demo()
+{
+	printf("_________\n");
+	printf("TYPED CONTAINERS\n");
+	printf("TYPED CONTAINERS demo ------------\n");
+	printf("\n");
+
+	int data[] = { 42, 7, 19, 3, 88, 7, 56, 23, 3, 61 };
+	int n = sizeof(data) / sizeof(data[0]);
+
+	// array list
+	struct intlist* list = intlist_create_capacity(4);
+	for (int i = 0; i < n; i++)
+		intlist_add(list, data[i]);
+
+	printf("Array list (capacity %zu, length %zu): ", list->capacity, list->length);
+	for (size_t i = 0; i < list->length; i++)
+		printf("%d ", intlist_get_item_at(list, i));
+	printf("\n");
+	int removed = intlist_remove_at(list, 1);
+	int last = intlist_pop(list);
+	printf("Removed item at 1: %d, last: %d\n", removed, last);
+
+	// sort with inlined compare, then sorted insert and search
+	intlist_sort(list);
+	intlist_insert_sorted(list, 20);
+	size_t pos;
+	int found = intlist_find_sorted(list, 23, &pos);
+	printf("Sorted with 20 inserted: ");
+	for (size_t i = 0; i < list->length; i++)
+		printf("%d ", intlist_get_item_at(list, i));
+	printf("(23 %s at %zu)\n", found ? "found" : "not found", pos);
+
+	// heap built from list (heapify)
+	struct intheap* heap = intheap_create_from(list->buffer, list->length);
+	intheap_insert(heap, 1);
+	printf("Heap polled in order: ");
+	int x;
+	while (intheap_poll(heap, &x))
+		printf("%d ", x);
+	printf("\n");
+
+	// ordered set
+	struct intset* set = intset_create();
+	for (int i = 0; i < n; i++)
+		intset_add(set, data[i]);
+
+	printf("Ordered set (%zu elements): ", set->size);
+	struct intset_iter it;
+	for (int ok = intset_iter_first(set, &it, &x); ok; ok = intset_iter_next(&it, &x))
+		printf("%d ", x);
+	printf("\n");
+
+	int floor = -1, ceiling = -1;
+	intset_floor(set, 50, &floor);
+	intset_ceiling(set, 50, &ceiling);
+	printf("Floor(50): %d, ceiling(50): %d\n", floor, ceiling);
+	intset_remove(set, 19);
+	printf("Contains 19 after removal: %d, contains 88: %d\n",
+		   intset_contains(set, 19), intset_contains(set, 88));
+
+	// hash table int -> int (count occurrences)
+	struct intmap* counts = intmap_create(0);
+	for (int i = 0; i < n; i++) {
+		int* c = intmap_get(counts, data[i]);
+		if (c) (*c)++;
+		else intmap_put(counts, data[i], 1);
+	}
+
+	printf("Occurrences of 7: %d, of 3: %d, distinct keys: %zu\n",
+		   *intmap_get(counts, 7), *intmap_get(counts, 3), counts->count);
+
+	// hash table string -> int
+	const char* words[] = { "red", "green", "blue", "green", "red", "red" };
+	struct strmap* wordcounts = strmap_create(0);
+	for (int i = 0; i < 6; i++) {
+		int* c = strmap_get(wordcounts, words[i]);
+		if (c) (*c)++;
+		else strmap_put(wordcounts, words[i], 1);
+	}
+
+	printf("Word counts: red=%d green=%d blue=%d\n", *strmap_get(wordcounts, "red"),
+		   *strmap_get(wordcounts, "green"), *strmap_get(wordcounts, "blue"));
+	strmap_remove(wordcounts, "blue", NULL);
+	printf("Contains 'blue' after removal: %d\n", strmap_contains(wordcounts, "blue"));
+
+	intlist_destroy(list);
+	intheap_destroy(heap);
+	intset_destroy(set);
+	intmap_destroy(counts);
+	strmap_destroy(wordcounts);
+	printf("Typed containers destroyed successfully.\n");
+}
+
+void treeset_demo()
+{
+	/*
+	 * Compare function for treeset elements.
+	 * Returns 0, 1 or -1.
+	 */
+	int compare(const void* key1, const void* key2) {
+		if ((key1 == NULL) && (key2 == NULL)) return 0;
+		else if (key1 == NULL) return -1;
+		else if (key2 == NULL) return 1;
+		else {
+			int ikey1 = *((int*)key1);
+			int ikey2 = *((int*)key2);
+
+			if (ikey1 == ikey2) return 0;
+			else if (ikey1 > ikey2) return 1;
+			else return -1;
+		}
+	}
+
+	/*
+	 * Computes size of a set element in bytes.
+	 * Note: Used by the reb-black tree.
+	 */
+	size_t calcelementsize(const void* data) {
+		return sizeof(int);
+	}
+
+	/*
+	 * Needed for red-black tree to perform operations like removing nodes.
+	 */
+	void copyelement( void* dest, const void* from ) {
+		if (from)
+			if (dest)
+				*((int*)dest) = *((int*)from);
+	}
+
+	/*
+	 * Prints a set element.
+	 */
+	void printelement(const void* element) {
+		if (element) {
+			int ivalue = *((int*)element);
+			printf("%d", ivalue);
+		}
+	}
+
+	printf("_________\n");
+	printf("TREESET (ordered set)\n");
+	printf("\nTreeset (with red-black tree) demo ------------\n");
+	printf("Uses a red-black tree to store elements\n\n");
+	// nodes come from an arena: no malloc per element, destroy is O(blocks)
+	struct treeset* set = treeset_create( calcelementsize, copyelement,
+										  compare, printelement, NULL, TREESET_RBTREE,
+										  nodearena_create(sizeof(struct rbtreenode), 0) );
+
+//	char spaces[] = "    ";
+	int values[100];
+	int n = 100;
+
+	// insert values in treeset { 99, 98, 97, 96, 95, 94, 93, 92, 91, 90 }
+	for (int i = 0; i < 10; ++i) {
+		values[i] = (n-1) - i;
+		treeset_add( set, &values[i] );
+	}
+
+	printf("Print treeset:\n");
+	treeset_print( set , 0);
+
+	printf( "\nTreeset size: %zu\n", set->size);
+
+	// check if hashtable contains key '2'
+	printf("Does treeset contains element '%d'?\n", values[2]);
+	if (treeset_contains(set, &values[2]))
+		printf("YES\n\n");
+	else
+		printf("NO\n\n");
+
+	// remove element with values[2]
+	printf("Element with value = '%d' will be removed from treeset.\n", values[2]);
+	void* del = treeset_remove(set, &values[2]);
+	if (del != NULL) {
+		printf("Element '%d') was removed from treeset.\n",	*((int*)del));
+	}
+	else
+		printf("Failed to remove element '%d' from treeset!\n", values[2]);
+
+	// check if set contains element values[2]
+	printf("\nDoes treeset contains value '%d'?\n", values[2]);
+	if (treeset_contains(set, &values[2]))
+		printf("YES\n\n");
+	else
+		printf("NO\n\n");
+
+	printf("Treeset size: %zu\n", set->size);
+
+	printf("\nPrint treeset:\n");
+	treeset_print(set, 0);
+
+	struct rbtree* tree = set->tree;
+	printf("Root: %d\n\n", *((int*)tree->root->data));
+
+	printf("\n");
+	int test_values[] = { 4, 91, 99, 100 };
+	int ntest = 4;
+
+	// test floor
+	for (int i = 0; i < ntest; i++) {
+		void* floor = treeset_floor(set, set->tree->root, &test_values[i]);
+		printf("Floor of '%d': ", test_values[i]);
+
+		if (floor)
+			printf("%d\n", *((int*)floor) );
+		else
+			printf("no value found.\n");
+	}
+
+	printf("\n");
+
+	// test ceiling
 	for (int i = 0; i < ntest; i++) {
 		void* floor = treeset_ceiling(set, set->tree->root, &test_values[i]);
 		printf("Ceiling of '%d': ", test_values[i]);
@@ -538,6 +1699,31 @@ void treeset_demo()
 	treeset_print(set, 0);
 	printf("Root: %d\n\n", *((int*)set->tree->root->data));
 
+	// walk elements with a cursor
+	struct treeset_iter cursor;
+	int seek_key = 95;
+	printf("Cursor from '%d' up:", seek_key);
+	for (void* e = treeset_iter_seek(set, &seek_key, &cursor); e != NULL; e = treeset_iter_next(&cursor))
+		printf(" %d", *((int*)e));
+
+	printf("\nCursor from floor of '%d' down:", seek_key);
+	for (void* e = treeset_iter_seek_floor(set, &seek_key, &cursor); e != NULL; e = treeset_iter_prev(&cursor))
+		printf(" %d", *((int*)e));
+
+	printf("\n\n");
+
+	// order statistics (rank, select, count of range)
+	int rank_key = 95;
+	printf("Rank of '%d': %zu\n", rank_key, treeset_rank(set, &rank_key));
+	for (size_t k = 0; k < set->size; k += 4) {
+		void* kth = treeset_select(set, k);
+		printf("Element at position %zu: %d\n", k, *((int*)kth));
+	}
+
+	int count_from = 92, count_to = 96;
+	printf("Elements between '%d' and '%d': %zu\n\n", count_from, count_to,
+		   treeset_count_range(set, &count_from, &count_to));
+
 	// remove range of values between 93 and 97 from set
 	int rem_range_lower = 93;
 	int rem_range_upper = 97;
@@ -553,8 +1739,343 @@ void treeset_demo()
 
 	printf("\n");
 
+	// split in two sets and merge them back
+	int split_key = 92;
+	struct treeset* upper = treeset_split_at(set, &split_key);
+	printf("Split at '%d': ", split_key);
+	treeset_print(set, 0);
+	printf("and ");
+	treeset_print(upper, 0);
+
+	treeset_union(set, upper);
+	printf("Union (sizes %zu and %zu): ", set->size, upper->size);
+	treeset_print(set, 0);
+	treeset_destroy(upper);
+
+	// intersection walks both sets in order, shares the elements of 'set'
+	int odds[6] = {91, 93, 95, 97, 99, 101};
+	struct treeset* oddset = treeset_create( calcelementsize, copyelement, compare,
+											 printelement, NULL, TREESET_BTREE, NULL );
+	for (int i = 0; i < 6; ++i)
+		treeset_add(oddset, &odds[i]);
+
+	struct treeset* common = treeset_intersect(set, oddset, 0);
+	printf("Intersection with ");
+	treeset_print(oddset, 0);
+	printf("is ");
+	treeset_print(common, 0);
+	treeset_destroy(common);
+	treeset_destroy(oddset);
+	printf("\n");
+
 	treeset_destroy(set);
 	printf("%s", "Treeset (ordered set) destroyed successfully.\n");
+
+	printf("\nTreeset (with B+ tree) demo ------------\n");
+	printf("Uses a B+ tree (61 elements per 512 byte node) to store elements\n\n");
+	set = treeset_create( calcelementsize, copyelement, compare, printelement, NULL,
+						  TREESET_BTREE, NULL );
+
+	// insert 10000 values in scrambled order (i * 7919 mod 10007 visits 0..10006 once)
+	int nbig = 10000;
+	int* big = (int*)malloc(nbig * sizeof(int));
+	for (int i = 0; i < nbig; ++i) {
+		big[i] = (int)(((long)(i + 1) * 7919) % 10007);
+		treeset_add( set, &big[i] );
+	}
+
+	treeset_add( set, &big[0] );	// duplicate, not inserted
+	printf("Treeset size: %zu, B+ tree height: %d\n", set->size, set->btree->height);
+	printf("Min element: %d, max element: %d\n", *((int*)treeset_min(set)), *((int*)treeset_max(set)));
+
+	int probes[] = { -1, 5000, 10006, 20000 };
+	for (int i = 0; i < 4; ++i) {
+		void* floor = treeset_floor(set, NULL, &probes[i]);
+		void* ceiling = treeset_ceiling(set, NULL, &probes[i]);
+		printf("Key %d: contains %d, floor ", probes[i], treeset_contains(set, &probes[i]));
+		if (floor) printf("%d", *((int*)floor)); else printf("none");
+		printf(", ceiling ");
+		if (ceiling) printf("%d\n", *((int*)ceiling)); else printf("none\n");
+	}
+
+	int range_from = 100, range_to = 110;
+	struct arraylist* range = treeset_toarraylist_range(set, &range_from, &range_to, 0);
+	printf("Elements from %d to %d:", range_from, range_to);
+	for (int i = 0; i < range->length; ++i)
+		printf(" %d", *((int*)arraylist_get_item_at(range, i)));
+	printf("\n");
+	arraylist_destroy(range);
+
+	// stream a range with a cursor, stop early
+	struct treeset_iter it;
+	printf("Cursor from %d, first 5 elements:", probes[1]);
+	void* e = treeset_iter_seek(set, &probes[1], &it);
+	for (int i = 0; i < 5 && e != NULL; ++i, e = treeset_iter_next(&it))
+		printf(" %d", *((int*)e));
+
+	printf("\nCursor from floor of %d down, 5 elements:", probes[3]);
+	e = treeset_iter_seek_floor(set, &probes[3], &it);
+	for (int i = 0; i < 5 && e != NULL; ++i, e = treeset_iter_prev(&it))
+		printf(" %d", *((int*)e));
+
+	printf("\n");
+
+	printf("Rank of %d: %zu, element at position 5000: %d, elements in [%d, %d]: %zu\n",
+		   probes[1], treeset_rank(set, &probes[1]), *((int*)treeset_select(set, 5000)),
+		   range_from, range_to, treeset_count_range(set, &range_from, &range_to));
+
+	range_from = 30; range_to = 9979;
+	del_count = treeset_remove_range(set, &range_from, &range_to);
+	printf("%d elements were removed from set (range %d to %d).\n", del_count, range_from, range_to);
+	printf("Treeset size: %zu, B+ tree height: %d\n", set->size, set->btree->height);
+	treeset_print(set, 0);
+	btree_print(set->btree);
+
+	treeset_destroy(set);
+	free(big);
+	printf("%s", "Treeset (B+ tree) destroyed successfully.\n");
+
+	printf("\nTreeset from sorted elements demo ------------\n");
+	int nsorted = 100000;
+	int* sorted = (int*)malloc(nsorted * sizeof(int));
+	void** items = (void**)malloc(nsorted * sizeof(void*));
+	for (int i = 0; i < nsorted; ++i) {
+		sorted[i] = 2 * i;
+		items[i] = &sorted[i];
+	}
+
+	for (int backend = TREESET_RBTREE; backend <= TREESET_BTREE; ++backend) {
+		set = treeset_create_from_sorted( items, nsorted, calcelementsize, copyelement, compare,
+										  printelement, NULL, backend, NULL );
+		int key = 2 * 777;
+		printf("%s: size %zu, height %d, contains %d: %d, rank of %d: %zu\n",
+			   (backend == TREESET_RBTREE) ? "Red-black tree" : "B+ tree", set->size,
+			   (set->btree) ? set->btree->height : rbtree_treeHeightLevelOrder(set->tree),
+			   key, treeset_contains(set, &key), key, treeset_rank(set, &key));
+
+		key = 2 * nsorted;
+		treeset_add(set, &key);
+		printf("Added %d, max element: %d, size %zu\n", key, *((int*)treeset_max(set)), set->size);
+		treeset_remove(set, &key);
+		treeset_destroy(set);
+	}
+
+	items[1] = items[0];	// not sorted anymore
+	set = treeset_create_from_sorted( items, nsorted, calcelementsize, copyelement, compare,
+									  printelement, NULL, TREESET_RBTREE, NULL );
+	printf("Treeset from unsorted elements: %s\n", (set) ? "created" : "refused (NULL)");
+	free(items);
+	free(sorted);
+}
+
+/*
+ * Parallel treeset operations demo.
+ * */
+void treeset_parallel_demo()
+{
+	printf("_________\n");
+	printf("PARALLEL TREESET\n");
+	printf("Parallel treeset demo ------------\n\n");
+
+	#define TREESET_PARALLEL_DEMO_THREADS 4
+
+	int compare(const void* a, const void* b) {
+		return (*((int*)a) > *((int*)b)) - (*((int*)a) < *((int*)b));
+	}
+
+	size_t elementsize(const void* data) {
+		return sizeof(int);
+	}
+
+	void copyelement(void* dest, const void* from) {
+		*((int*)dest) = *((int*)from);
+	}
+
+	static long sums[TREESET_PARALLEL_DEMO_THREADS * 8];		// 64 bytes apart
+	void sumvisit(void* element, int worker, void* arg) {
+		sums[worker * 8] += *((int*)element);
+	}
+
+	// partial result of the reduction: sum and order check of a run of elements
+	struct runsum { long sum; long count; int first, last, sorted; };
+	void accumulate(void* partial, void* element, void* arg) {
+		struct runsum* r = (struct runsum*)partial;
+		int value = *((int*)element);
+		if ((r->count > 0) && (value <= r->last)) r->sorted = 0;
+		if (r->count == 0) r->first = value;
+		r->last = value;
+		r->sum += value;
+		r->count++;
+	}
+
+	void combine(void* result, const void* partial, void* arg) {
+		struct runsum* r = (struct runsum*)result;
+		const struct runsum* p = (const struct runsum*)partial;
+		if (p->count == 0) return;
+		if (r->count == 0) { *r = *p; return; }
+		r->sorted = r->sorted && p->sorted && (p->first > r->last);
+		r->last = p->last;
+		r->sum += p->sum;
+		r->count += p->count;
+	}
+
+	struct taskpool* pool = taskpool_create(TREESET_PARALLEL_DEMO_THREADS);
+	int count = 200000;
+	int* values = malloc(count * sizeof(int));
+	for (int i = 0; i < count; ++i)
+		values[i] = i;
+
+	// even values in 'a', multiples of 3 in 'b', both red-black trees sharing an arena
+	struct nodearena* arena = nodearena_create(sizeof(struct rbtreenode), 0);
+	struct treeset* a = treeset_create( elementsize, copyelement, compare, NULL, NULL, TREESET_RBTREE,
+										nodearena_retain(arena) );
+	struct treeset* b = treeset_create( elementsize, copyelement, compare, NULL, NULL, TREESET_RBTREE,
+										nodearena_retain(arena) );
+	struct treeset* c = treeset_create( elementsize, copyelement, compare, NULL, NULL, TREESET_BTREE, NULL );
+	for (int i = 0; i < count; ++i) {
+		if (i % 2 == 0) treeset_add(a, &values[i]);
+		if (i % 3 == 0) treeset_add(b, &values[i]);
+		treeset_add(c, &values[i]);
+	}
+
+	long expected = (long)count * (count - 1) / 2;
+	for (int backend = 0; backend < 2; ++backend) {
+		struct treeset* set = backend ? c : a;
+		for (int t = 0; t < TREESET_PARALLEL_DEMO_THREADS; ++t)
+			sums[t * 8] = 0;
+
+		treeset_parallel_foreach(pool, set, sumvisit, NULL);
+		long total = 0;
+		for (int t = 0; t < TREESET_PARALLEL_DEMO_THREADS; ++t)
+			total += sums[t * 8];
+
+		struct runsum r = { 0, 0, 0, 0, 1 };
+		treeset_parallel_reduce(pool, set, &r, sizeof(r), accumulate, combine, NULL);
+		printf( "%s set of %zu elements: parallel sum %ld, reduce sum %ld, %s order (%d..%d)\n",
+				backend ? "B+ tree" : "Red-black tree", set->size, total, r.sum,
+				r.sorted ? "ascending" : "wrong", r.first, r.last );
+		if ((total != r.sum) || (backend && (total != expected))) printf("Error with parallel reduce\n");
+	}
+
+	// common elements are multiples of 6
+	struct treeset* common = treeset_parallel_intersect(pool, a, b, 0);
+	struct treeset* expectedcommon = treeset_intersect(a, b, 0);
+	printf( "Parallel intersection of even and multiples of 3: %zu elements (expected %zu)\n",
+			common->size, expectedcommon->size );
+	treeset_destroy(common);
+	treeset_destroy(expectedcommon);
+
+	size_t expectedunion = 0;
+	for (int i = 0; i < count; ++i)
+		expectedunion += ((i % 2 == 0) || (i % 3 == 0));
+
+	treeset_parallel_union(pool, a, b);
+	struct runsum r = { 0, 0, 0, 0, 1 };
+	treeset_parallel_reduce(pool, a, &r, sizeof(r), accumulate, combine, NULL);
+	printf( "Parallel union: %zu elements (expected %zu), %s order, other set left with %zu\n",
+			a->size, expectedunion, r.sorted ? "ascending" : "wrong", b->size );
+
+	treeset_destroy(a);
+	treeset_destroy(b);
+	treeset_destroy(c);
+	nodearena_destroy(arena);
+	free(values);
+	taskpool_destroy(pool);
+	printf("Parallel treeset demo finished successfully.\n");
+}
+
+/*
+ * Lock-free skip list demo.
+ * */
+void skiplist_demo() {
+
+	int compare(const void* data1, const void* data2) {
+		long a = (long)data1, b = (long)data2;
+		return (a > b) - (a < b);
+	}
+
+	void printelement(const void* data) {
+		printf("%ld", (long)data);
+	}
+
+	printf("___________________\n");
+	printf("SKIP LIST\n");
+	printf("Lock-free skip list demo ------------\n\n");
+
+	struct skiplist* list = skiplist_create(compare, printelement, NULL);
+	long values[] = { 50, 20, 80, 10, 30, 70, 90, 60, 40 };
+	for (int i = 0; i < 9; ++i)
+		skiplist_add(list, (void*)values[i]);
+
+	printf("Skip list (%zu elements): ", skiplist_getsize(list));
+	skiplist_print(list);
+	printf("Add 30 again? %s\n", skiplist_add(list, (void*)30L) ? "added" : "already in list");
+	printf("Floor of 55: %ld, ceiling of 55: %ld, min %ld, max %ld\n",
+		   (long)skiplist_floor(list, (void*)55L), (long)skiplist_ceiling(list, (void*)55L),
+		   (long)skiplist_min(list), (long)skiplist_max(list));
+
+	struct arraylist* range = skiplist_toarraylist_range(list, (void*)25L, (void*)65L);
+	printf("Elements in [25, 65]: ");
+	for (size_t i = 0; i < range->length; ++i)
+		printf("%ld ", (long)arraylist_get_item_at(range, i));
+
+	printf("\n");
+	arraylist_destroy(range);
+
+	skiplist_remove(list, (void*)50L);
+	skiplist_remove(list, (void*)10L);
+	printf("After removing 50 and 10: ");
+	skiplist_print(list);
+	printf("Released %zu removed nodes\n\n", skiplist_reclaim(list));
+	skiplist_destroy(list);
+
+	// concurrent inserts: each thread adds every 'nthreads'-th key of [0, n)
+	#define SKIPLIST_DEMO_THREADS 4
+	long n = 400000;
+	int nthreads;
+	pthread_t threads[SKIPLIST_DEMO_THREADS];
+	long ids[SKIPLIST_DEMO_THREADS];
+
+	void* worker(void* arg) {
+		for (long k = *((long*)arg); k < n; k += nthreads)
+			skiplist_add(list, (void*)((k * 7919) % n));		// scattered keys
+
+		return NULL;
+	}
+
+	double elapsed(struct timespec* t0) {
+		struct timespec t1;
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		return (t1.tv_sec - t0->tv_sec) * 1e3 + (t1.tv_nsec - t0->tv_nsec) / 1e6;
+	}
+
+	for (nthreads = 1; nthreads <= SKIPLIST_DEMO_THREADS; nthreads *= 2) {
+		list = skiplist_create(compare, NULL, NULL);
+		struct timespec t0;
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (int t = 0; t < nthreads; ++t) {
+			ids[t] = t;
+			pthread_create(&threads[t], NULL, worker, &ids[t]);
+		}
+
+		for (int t = 0; t < nthreads; ++t)
+			pthread_join(threads[t], NULL);
+
+		double ms = elapsed(&t0);
+		long previous = -1;
+		int sorted = 1;
+		for (long k = 0; k < n; k += 1000) {
+			long element = (long)skiplist_ceiling(list, (void*)k);
+			sorted = sorted && (element == k) && (element > previous);
+			previous = element;
+		}
+
+		printf("%d thread(s): %zu keys inserted in %.1f ms, all keys found in order? %s\n",
+			   nthreads, skiplist_getsize(list), ms, sorted ? "YES" : "NO");
+		skiplist_destroy(list);
+	}
+
+	printf("Skip lists destroyed successfully.\n");
 }
 
 /*
@@ -624,35 +2145,511 @@ void hashtable_linked_list_demo()
 	else
 		printf("NO\n\n");
 
-	// remove element with key=2
-	printf("Element with key = '%d' will be removed from hashtable.\n", keys[2]);
-	void* del = hashtable_remove(htable, &keys[2]);
-	if (del != NULL) {
-		printf("Element (key = '%d' : value = '%d') removed from hashtable.\n",
-							*((int*)((struct hashtable_lp_keyvalue_pair*)del)->key),
-							*((int*)((struct hashtable_lp_keyvalue_pair*)del)->value));
-		free(del);
+	// remove element with key=2
+	printf("Element with key = '%d' will be removed from hashtable.\n", keys[2]);
+	void* del = hashtable_remove(htable, &keys[2]);
+	if (del != NULL) {
+		printf("Element (key = '%d' : value = '%d') removed from hashtable.\n",
+							*((int*)((struct hashtable_lp_keyvalue_pair*)del)->key),
+							*((int*)((struct hashtable_lp_keyvalue_pair*)del)->value));
+		free(del);
+	}
+	else
+		printf("Failed to remove element from hashtable!\n");
+
+	// check if set contains element '2' (keys[2])
+	printf("\nDoes hashtable contains key '%d'?\n", keys[2]);
+	if (hashtable_contains(htable, &keys[2]))
+		printf("YES\n\n");
+	else
+		printf("NO\n\n");
+
+	printf("Hashtable size: %zu\n", htable->count);
+
+	printf("\nPrint hashtable:\n");
+	hashtable_print(htable);
+
+	void* val = hashtable_get(htable, &keys[3]);
+	printf("\nGet value with key '%d': %d.\n", keys[3], *((int*)(((struct hashtable_keyvalue_pair*)(val))->value) ) );
+
+	hashtable_destroy(htable);
+	printf("%s", "Hash table (linked lists) destroyed successfully.\n\n");
+}
+
+void hashtable_incremental_demo()
+{
+	int hashfunc(const void* key) {
+		return *((int*)key);
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	printf("_________\n");
+	printf("HASHTABLE (linked lists version, incremental resize)\n");
+	printf("\nHash table with incremental resize demo ------------\n");
+	printf("Buckets are migrated a few at a time by later operations\n\n");
+
+	struct hashtable* htable = hashtable_create_incremental( HASHTABLE_DEFAULT_CAPACITY,
+															 HASHTABLE_DEFAULT_LOAD_FACTOR,
+															 HASHTABLE_RESIZE_FACTOR,
+															 hashfunc, isequalfunc,
+															 NULL, NULL );
+
+	int keys[100];
+	int n = 100;
+
+	for (int i = 0; i < n; ++i) {
+		keys[i] = i;
+		hashtable_put(htable, &keys[i], &keys[i]);
+		if (htable->oldarray != NULL && htable->migrateindex == 0)
+			printf("Resize started after %zu elements: %zu -> %zu buckets\n",
+					htable->count, htable->oldcapacity, htable->capacity);
+	}
+
+	printf("\nHashtable size: %zu\n", htable->count);
+	printf("Hashtable capacity: %zu\n", htable->capacity);
+	printf("Resize in progress: %s\n", (htable->oldarray != NULL) ? "YES" : "NO");
+
+	int found = 0;
+	for (int i = 0; i < n; ++i)
+		found += hashtable_contains(htable, &keys[i]);
+
+	printf("Keys found: %d\n", found);
+	printf("Resize in progress: %s\n", (htable->oldarray != NULL) ? "YES" : "NO");
+
+	hashtable_destroy(htable);
+	printf("%s", "Hash table (incremental resize) destroyed successfully.\n\n");
+}
+
+void hashtable_iter_demo()
+{
+	int hashfunc(const void* key) {
+		return *((int*)key);
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	#define ITER_DEMO_THREADS 4
+	long long sums[ITER_DEMO_THREADS] = { 0 };		// one accumulator per worker
+
+	void sumvalue(struct hashtable_keyvalue_pair* kvp, int worker, void* arg) {
+		((long long*)arg)[worker] += *((int*)kvp->value);
+	}
+
+	void countelement(void* element, int worker, void* arg) {
+		((size_t*)arg)[worker]++;
+	}
+
+	printf("_________\n");
+	printf("HASHTABLE (linked lists version, iterators)\n");
+	printf("\nZero-copy iteration demo ------------\n");
+	printf("Buckets are walked in place, no array of keys is allocated\n\n");
+
+	struct hashtable* htable = hashtable_create_incremental( HASHTABLE_DEFAULT_CAPACITY,
+															 HASHTABLE_DEFAULT_LOAD_FACTOR,
+															 HASHTABLE_RESIZE_FACTOR,
+															 hashfunc, isequalfunc,
+															 NULL, NULL );
+	int n = 100000;
+	int* keys = (int*)malloc(n * sizeof(int));
+	for (int i = 0; i < n; ++i)
+		keys[i] = i;
+
+	// stop right after a resize started: pairs of buckets not migrated yet are visited too
+	int added = 0;
+	while ((added < n) && ((added < n / 2) || (htable->oldarray == NULL))) {
+		hashtable_put(htable, &keys[added], &keys[added]);
+		added++;
+	}
+
+	printf("Hashtable size: %zu, resize in progress: %s\n", htable->count,
+		   (htable->oldarray != NULL) ? "YES" : "NO");
+
+	struct hashtable_iter it;
+	long long sum = 0;
+	size_t count = 0;
+	for (struct hashtable_keyvalue_pair* kvp = hashtable_iter_begin(htable, &it);
+		 kvp != NULL; kvp = hashtable_iter_next(&it)) {
+		sum += *((int*)kvp->value);
+		count++;
+	}
+
+	printf("Iterator: %zu pairs, sum of values %lld (expected %lld)\n", count, sum,
+		   (long long)added * (added - 1) / 2);
+
+	// 4 chunks walked one after the other cover the table exactly once
+	count = 0;
+	for (size_t c = 0; c < 4; ++c)
+		for (struct hashtable_keyvalue_pair* kvp = hashtable_iter_chunk(htable, c, 4, &it);
+			 kvp != NULL; kvp = hashtable_iter_next(&it))
+			count++;
+
+	printf("Chunked iteration (4 chunks): %zu pairs\n", count);
+
+	struct taskpool* pool = taskpool_create(ITER_DEMO_THREADS);
+	hashtable_parallel_foreach(pool, htable, 0, sumvalue, sums);
+	sum = 0;
+	for (int w = 0; w < ITER_DEMO_THREADS; ++w)
+		sum += sums[w];
+
+	printf("Parallel foreach (%d workers): sum of values %lld\n", taskpool_getthreads(pool), sum);
+
+	struct hashset* set = hashset_create(hashfunc, isequalfunc, NULL, NULL);
+	for (int i = 0; i < 1000; ++i)
+		hashset_add(set, &keys[i]);
+
+	size_t counts[ITER_DEMO_THREADS] = { 0 };
+	hashset_foreach(set, countelement, counts);
+	printf("Hashset foreach: %zu elements\n", counts[0]);
+
+	counts[0] = 0;
+	hashset_parallel_foreach(pool, set, 0, countelement, counts);
+	count = 0;
+	for (int w = 0; w < ITER_DEMO_THREADS; ++w)
+		count += counts[w];
+
+	printf("Hashset parallel foreach: %zu elements\n", count);
+
+	hashset_destroy(set);
+	taskpool_destroy(pool);
+	hashtable_destroy(htable);
+	free(keys);
+	printf("%s", "Hash table (iterators) destroyed successfully.\n\n");
+}
+
+void snapshot_demo()
+{
+	int hashfunc(const void* key) {
+		return *((int*)key);
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	int compare(const void* data1, const void* data2) {
+		int a = *((const int*)data1), b = *((const int*)data2);
+		return (a > b) - (a < b);
+	}
+
+	size_t calcelementsize(const void* data) {
+		return sizeof(int);
+	}
+
+	void copyelement(void* dest, const void* from) {
+		*((int*)dest) = *((const int*)from);
+	}
+
+	// int codec: 4 bytes, decoded to a new int
+	size_t encodeint(const void* data, void* buffer, size_t size, void* arg) {
+		if (size >= sizeof(int))
+			memcpy(buffer, data, sizeof(int));
+		return sizeof(int);
+	}
+
+	void* decodeint(const void* buffer, size_t size, void* arg) {
+		int* result = (int*)malloc(sizeof(int));
+		*result = *((const int*)buffer);
+		return result;
+	}
+
+	// loaded pairs own their decoded key and value
+	void freepair(void* data) {
+		struct hashtable_keyvalue_pair* kvp = (struct hashtable_keyvalue_pair*)data;
+		free(kvp->key);
+		free(kvp->value);
+		free(kvp);
+	}
+
+	printf("_________\n");
+	printf("SNAPSHOTS (hashtable, treeset and trie)\n");
+	printf("\nSave and load demo ------------\n");
+	printf("Loads are one sequential pass over the mapped file, containers built in bulk\n\n");
+
+	struct snapshot_codec codec = { encodeint, decodeint, encodeint, decodeint, NULL };
+	const char* file = "snapshot_demo.bin";
+	int n = 100000;
+	int* keys = (int*)malloc(n * sizeof(int));
+	int* values = (int*)malloc(n * sizeof(int));
+	for (int i = 0; i < n; ++i) {
+		keys[i] = i;
+		values[i] = 2 * i;
+	}
+
+	struct hashtable* htable = hashtable_create( HASHTABLE_DEFAULT_CAPACITY, HASHTABLE_DEFAULT_LOAD_FACTOR,
+												 HASHTABLE_RESIZE_FACTOR, hashfunc, isequalfunc, NULL, NULL );
+	for (int i = 0; i < n; ++i)
+		hashtable_put(htable, &keys[i], &values[i]);
+
+	if (hashtable_save(htable, file, &codec)) {
+		struct hashtable* loaded = hashtable_load(file, &codec, hashfunc, NULL, isequalfunc, NULL, freepair);
+		size_t matches = 0;
+		for (int i = 0; i < n; ++i) {
+			struct hashtable_keyvalue_pair* kvp = (loaded != NULL) ? hashtable_get(loaded, &keys[i]) : NULL;
+			matches += ((kvp != NULL) && (*((int*)kvp->value) == values[i]));
+		}
+
+		printf( "Hashtable: %zu pairs saved, %zu loaded (capacity %zu), %zu values match\n", htable->count,
+				(loaded != NULL) ? loaded->count : 0, (loaded != NULL) ? loaded->capacity : 0, matches );
+
+		// the view answers from the mapping, nothing is decoded
+		struct hashtable_view* view = hashtable_view_open(file, &codec, hashfunc, NULL);
+		if (view != NULL) {
+			int key = 4242, missing = -1;
+			const int* value = (const int*)hashtable_view_get(view, &key, NULL);
+			printf( "Hashtable view: get(%d) = %d, get(%d) %s\n", key, (value != NULL) ? *value : -1,
+					missing, (hashtable_view_get(view, &missing, NULL) == NULL) ? "NOT FOUND" : "FOUND" );
+			hashtable_view_close(view);
+		}
+
+		if (loaded != NULL)
+			hashtable_destroy(loaded);
+	}
+	else
+		printf("Failed to save hashtable file '%s'\n", file);
+
+	hashtable_destroy(htable);
+
+	struct snapshot_codec keycodec = { encodeint, decodeint, NULL, NULL, NULL };
+	struct treeset* set = treeset_create( calcelementsize, copyelement, compare, NULL, NULL,
+										  TREESET_RBTREE, NULL );
+	for (int i = n - 1; i >= 0; i -= 3)
+		treeset_add(set, &keys[i]);
+
+	if (treeset_save(set, file, &keycodec)) {
+		struct treeset* loaded = treeset_load( file, &keycodec, calcelementsize, copyelement, compare,
+											   NULL, free, TREESET_BTREE, NULL );
+		if (loaded != NULL) {
+			printf( "Treeset: %zu elements saved, %zu loaded in a B+ tree, min %d, max %d\n",
+					set->size, loaded->size, *((int*)treeset_min(loaded)),
+					*((int*)treeset_max(loaded)) );
+			treeset_destroy(loaded);
+		}
+	}
+	else
+		printf("Failed to save treeset file '%s'\n", file);
+
+	treeset_destroy(set);
+
+	struct trie* t = trie_create_trie(TRIE_DEFAULT_NUM_CHARS, NULL, NULL);
+	char* words[6] = {"cat", "cattle", "kin", "kit", "help", "helping"};
+	for (int i = 0; i < 6; ++i)
+		trie_insert(t, words[i]);
+
+	if (trie_save(t, file)) {
+		struct trie* loaded = trie_load(file, NULL, NULL);
+		if (loaded != NULL) {
+			printf("Trie loaded, search for '%s': %s, search for '%s': %s\nWords:\n", "kit",
+				   trie_search(loaded, "kit") ? "FOUND" : "NOT FOUND", "hel",
+				   trie_search(loaded, "hel") ? "FOUND" : "NOT FOUND");
+			trie_print(loaded);
+			trie_destroy(loaded);
+		}
+	}
+	else
+		printf("Failed to save trie file '%s'\n", file);
+
+	trie_destroy(t);
+	remove(file);
+	free(keys);
+	free(values);
+	printf("%s", "Snapshots demo finished successfully.\n\n");
+}
+
+void hashtable_hash64_demo()
+{
+	// FNV-1a over the key bytes
+	uint64_t hashfunc(const void* key) {
+		const unsigned char* p = (const unsigned char*)key;
+		uint64_t h = 14695981039346656037ULL;
+		for (size_t i = 0; i < sizeof(int); ++i) {
+			h ^= p[i];
+			h *= 1099511628211ULL;
+		}
+		return h;
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	printf("_________\n");
+	printf("HASHTABLE (64 bit hash, power of two capacity)\n");
+	printf("\nHash tables with 64 bit hash demo ------------\n");
+	printf("Buckets/slots are selected with fibonacci hashing instead of modulo a prime\n\n");
+
+	struct hashtable* htable = hashtable_create64( HASHTABLE_DEFAULT_CAPACITY, HASHTABLE_DEFAULT_LOAD_FACTOR,
+												   HASHTABLE_RESIZE_FACTOR,
+												   hashfunc, isequalfunc, NULL, NULL );
+	struct hashtable_lp* lptable = hashtable_lp_create_inline64( HASHTABLE_LP_DEFAULT_SIZE,
+																 HASHTABLE_LP_DEFAULT_LOAD_FACTOR,
+																 HASHTABLE_LP_RESIZE_FACTOR,
+																 hashfunc, isequalfunc, NULL, NULL );
+
+	int keys[100];
+	int n = 100;
+
+	for (int i = 0; i < n; ++i) {
+		keys[i] = i * 1000;
+		hashtable_put(htable, &keys[i], &keys[i]);
+		hashtable_lp_put(lptable, &keys[i], &keys[i]);
+	}
+
+	int found = 0, lpfound = 0;
+	for (int i = 0; i < n; ++i) {
+		found += hashtable_contains(htable, &keys[i]);
+		lpfound += hashtable_lp_contains(lptable, &keys[i]);
+	}
+
+	printf("Linked lists table: size = %zu, capacity = %zu, keys found = %d\n", htable->count, htable->capacity, found);
+	printf("Linear probe table: size = %zu, capacity = %zu, keys found = %d\n", lptable->count, lptable->capacity, lpfound);
+
+	hashtable_destroy(htable);
+	hashtable_lp_destroy(lptable);
+	printf("%s", "Hash tables (64 bit hash) destroyed successfully.\n\n");
+}
+
+/*
+ * Instrumentation (statistics snapshots and metrics export) demo.
+ * */
+void datastats_demo()
+{
+	// keys are multiples of 16, so all of them go to one bucket
+	int badhash(const void* key) {
+		return *((int*)key) % 16;
+	}
+
+	int goodhash(const void* key) {
+		return (int)((uint32_t)*((int*)key) * 2654435761u >> 1);
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	int comparefunc(const void* data1, const void* data2) {
+		int a = *((int*)data1), b = *((int*)data2);
+		return (a > b) - (a < b);
+	}
+
+	int avlcomparefunc(void* data, const void* key) {
+		int a = *((int*)data), b = *((int*)key);
+		return (a > b) - (a < b);
+	}
+
+	size_t datasizefunc(const void* data) {
+		return sizeof(int);
+	}
+
+	void copydatafunc(void* dest, const void* from) {
+		*((int*)dest) = *((const int*)from);
 	}
-	else
-		printf("Failed to remove element from hashtable!\n");
 
-	// check if set contains element '2' (keys[2])
-	printf("\nDoes hashtable contains key '%d'?\n", keys[2]);
-	if (hashtable_contains(htable, &keys[2]))
-		printf("YES\n\n");
-	else
-		printf("NO\n\n");
+	printf("__________________________\n");
+	printf("INSTRUMENTATION (STATISTICS)\n");
+	printf("\nStatistics snapshots demo ------------\n");
+	printf("Event counters are %s\n\n", DATASTATS_ENABLED ? "compiled in"
+		   : "not compiled in (build with -DCDATASTRUCT_STATS to enable them)");
 
-	printf("Hashtable size: %zu\n", htable->count);
+	int n = 2000;
+	int* keys = (int*)malloc(n * sizeof(int));
+	for (int i = 0; i < n; ++i)
+		keys[i] = i * 16;
 
-	printf("\nPrint hashtable:\n");
-	hashtable_print(htable);
+	struct datastats_metric metrics[DATASTATS_MAX_METRICS];
+	size_t count = 0;
 
-	void* val = hashtable_get(htable, &keys[3]);
-	printf("\nGet value with key '%d': %d.\n", keys[3], *((int*)(((struct hashtable_keyvalue_pair*)(val))->value) ) );
+	// chain lengths tell a bad hash function from a bad load factor
+	struct hashtable* bad = hashtable_create(37, 0.75, 2.0, badhash, isequalfunc, NULL, NULL);
+	struct hashtable* good = hashtable_create(37, 0.75, 2.0, goodhash, isequalfunc, NULL, NULL);
+	for (int i = 0; i < n; ++i) {
+		hashtable_put(bad, &keys[i], &keys[i]);
+		hashtable_put(good, &keys[i], &keys[i]);
+	}
 
-	hashtable_destroy(htable);
-	printf("%s", "Hash table (linked lists) destroyed successfully.\n\n");
+	struct hashtable_stats htstats;
+	hashtable_stats(bad, &htstats);
+	count = hashtable_stats_metrics(&htstats, metrics);
+	datastats_print("Chained hash table, hash = key % 16:", metrics, count);
+	hashtable_stats(good, &htstats);
+	count = hashtable_stats_metrics(&htstats, metrics);
+	datastats_print("Chained hash table, multiplicative hash:", metrics, count);
+	hashtable_destroy(bad);
+	hashtable_destroy(good);
+
+	// probe distances and tombstones of an open addressing table after removals
+	struct hashtable_lp* lptable = hashtable_lp_create_inline(64, 0.75, 2.0, goodhash, isequalfunc, NULL, NULL);
+	for (int i = 0; i < n; ++i)
+		hashtable_lp_put(lptable, &keys[i], &keys[i]);
+	for (int i = 0; i < n; i += 3)
+		free(hashtable_lp_remove(lptable, &keys[i]));
+
+	struct hashtable_lp_stats lpstats;
+	hashtable_lp_stats(lptable, &lpstats);
+	count = hashtable_lp_stats_metrics(&lpstats, metrics);
+	datastats_print("\nLinear probing hash table (inline), 1 of 3 keys removed:", metrics, count);
+	hashtable_lp_destroy(lptable);
+
+	// trees (sorted inserts, then half of the keys deleted). Deletes copy elements
+	// between nodes, so each tree gets its own keys and keys are deleted by value
+	int* rbkeys = (int*)malloc(n * sizeof(int));
+	int* avlkeys = (int*)malloc(n * sizeof(int));
+	for (int i = 0; i < n; ++i)
+		rbkeys[i] = avlkeys[i] = keys[i];
+
+	struct rbtree* rbtree = rbtree_create(NULL, datasizefunc, comparefunc, NULL, NULL, copydatafunc, NULL);
+	struct avltree* avltree = avltree_create(&avlkeys[0], avlcomparefunc, NULL, NULL, copydatafunc, NULL);
+	for (int i = 0; i < n; ++i) {
+		rbtree_insert(rbtree, &rbkeys[i]);
+		if (i > 0)
+			avltree->root = avltree_insert(avltree, avltree->root, &avlkeys[i]);
+	}
+
+	for (int i = 1; i < n; i += 2) {
+		int key = i * 16;
+		rbtree_delete(rbtree, &key);
+		avltree->root = avltree_delete(avltree, avltree->root, &key);
+	}
+
+	struct rbtree_stats rbstats;
+	rbtree_stats(rbtree, &rbstats);
+	count = rbtree_stats_metrics(&rbstats, metrics);
+	datastats_print("\nRed black tree:", metrics, count);
+
+	struct avltree_stats avlstats;
+	avltree_stats(avltree, &avlstats);
+	count = avltree_stats_metrics(&avlstats, metrics);
+	datastats_print("AVL tree:", metrics, count);
+
+	// heap (random inserts and extracts)
+	int minlimit = INT_MIN, maxlimit = INT_MAX;
+	struct heap* heap = minbinaryheap_createHeap(16, NULL, 0, &minlimit, &maxlimit, comparefunc, NULL, NULL);
+	for (int i = 0; i < n; ++i)
+		minbinaryheap_insert(heap, &keys[(i * 7919) % n]);
+	for (int i = 0; i < n / 2; ++i)
+		minbinaryheap_extract(heap);
+
+	struct datastats_heap heapstats;
+	minbinaryheap_stats(heap, &heapstats);
+	count = datastats_heap_metrics(&heapstats, metrics);
+	datastats_print("\nMin binary heap:", metrics, count);
+
+	// metrics exporter input (Prometheus text format)
+	printf("\nRed black tree metrics, Prometheus text format:\n");
+	count = rbtree_stats_metrics(&rbstats, metrics);
+	datastats_export(stdout, "cds_rbtree", "demo", metrics, count);
+
+	rbtree_destroy(rbtree);
+	avltree_destroy(avltree);
+	minbinaryheap_destroy(heap);
+	free(keys);
+	free(rbkeys);
+	free(avlkeys);
+	printf("%s", "\nInstrumented structures destroyed successfully.\n\n");
 }
 
 /*
@@ -742,16 +2739,647 @@ void hashtable_lp_demo()
 	else
 		printf("NO\n\n");
 
-	printf("Hashtable size: %zu\n", htable->count);
+	printf("Hashtable size: %zu\n", htable->count);
+
+	printf("\nPrint hashtable:\n");
+	hashtable_lp_print(htable);
+
+	void* val = hashtable_lp_get(htable, &keys[3]);
+	printf("\nGet value with key '%d': %d.\n", keys[3], *((int*)(val)) );
+
+	hashtable_lp_destroy(htable);
+	printf("%s", "Hash table (linear probe) destroyed successfully.\n\n");
+}
+
+void hashtable_lp_inline_demo()
+{
+	int hashfunc(const void* key) {
+		return *((int*)key);
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	void printitemfunc(const struct hashtable_lp_keyvalue_pair* kvp) {
+		printf("%d : %d", *((int*)kvp->key), *((int*)kvp->value));
+	}
+
+	printf("_________\n");
+	printf("HASHTABLE (linear probe version, inline storage)\n");
+	printf("\nHash table with linear probe and inline slots demo ------------\n");
+	printf("Key, value and slot state are stored together in one flat array\n\n");
+
+	struct hashtable_lp* htable = hashtable_lp_create_inline_default( hashfunc, isequalfunc,
+																	  printitemfunc, NULL );
+
+	int keys[100];
+	int values[100];
+	int n = 100;
+
+	// large set of key/value pairs to provoque array reallocations
+	for (int i = 0; i < n; ++i) {
+		keys[i] = i;
+		values[i] = (n-1) - i;
+		hashtable_lp_put(htable, &keys[i], &values[i]);
+	}
+
+	printf("Put duplicated key '%d' returns: %d\n", keys[5], hashtable_lp_put(htable, &keys[5], &values[0]));
+	printf("Hashtable size: %zu\n", htable->count);
+	printf("Hashtable capacity: %zu\n\n", htable->capacity);
+
+	// remove even keys, leaving deleted slots behind
+	for (int i = 0; i < n; i += 2)
+		free(hashtable_lp_remove(htable, &keys[i]));
+
+	printf("Even keys removed. Hashtable size: %zu\n", htable->count);
+	printf("Does hashtable contains key '%d'? %s\n", keys[2], hashtable_lp_contains(htable, &keys[2]) ? "YES" : "NO");
+	printf("Does hashtable contains key '%d'? %s\n", keys[3], hashtable_lp_contains(htable, &keys[3]) ? "YES" : "NO");
+
+	void* val = hashtable_lp_get(htable, &keys[3]);
+	printf("Get value with key '%d': %d.\n", keys[3], *((int*)(val)) );
+
+	hashtable_lp_destroy(htable);
+	printf("%s", "Hash table (linear probe, inline storage) destroyed successfully.\n\n");
+}
+
+void hashtable_lp_robinhood_demo()
+{
+	// integer mixer (sequential keys land on scattered slots, as with real keys)
+	int hashfunc(const void* key) {
+		uint32_t x = (uint32_t)*((int*)key);
+		x ^= x >> 16; x *= 0x7feb352du;
+		x ^= x >> 15; x *= 0x846ca68bu;
+		x ^= x >> 16;
+		return (int)(x >> 1);
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	void printitemfunc(const struct hashtable_lp_keyvalue_pair* kvp) {
+		printf("%d : %d", *((int*)kvp->key), *((int*)kvp->value));
+	}
+
+	printf("_________\n");
+	printf("HASHTABLE (linear probe version, robin hood storage)\n");
+	printf("\nHash table with robin hood hashing and backward-shift deletion demo ------------\n");
+	printf("Elements keep their probe distance, removes leave no deleted slots\n\n");
+
+	struct hashtable_lp* small = hashtable_lp_create_robinhood( 11, 0.9, HASHTABLE_LP_RESIZE_FACTOR,
+															   hashfunc, isequalfunc, printitemfunc, NULL );
+	int smallkeys[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	for (int i = 0; i < 8; ++i)
+		hashtable_lp_put(small, &smallkeys[i], &smallkeys[7 - i]);
+
+	free(hashtable_lp_remove(small, &smallkeys[2]));
+	free(hashtable_lp_remove(small, &smallkeys[5]));
+	printf("Keys 1 to 8 added, keys 3 and 6 removed (no DELETED slots):\n");
+	hashtable_lp_print(small);
+	printf("Put duplicated key '%d' returns: %d\n", smallkeys[0], hashtable_lp_put(small, &smallkeys[0], &smallkeys[0]));
+	printf("Does hashtable contains key '%d'? %s\n", smallkeys[2], hashtable_lp_contains(small, &smallkeys[2]) ? "YES" : "NO");
+	printf("Get value with key '%d': %d.\n\n", smallkeys[3], *((int*)hashtable_lp_get(small, &smallkeys[3])));
+	hashtable_lp_destroy(small);
+
+	// session table like churn: keep 1000 live keys, alternating one put and one remove
+	int n = 1000, rounds = 20000;
+	int* keys = (int*)malloc((n + rounds) * sizeof(int));
+	for (int i = 0; i < n + rounds; ++i)
+		keys[i] = i;
+
+	struct hashtable_lp* tables[2];
+	tables[0] = hashtable_lp_create_inline( 2048, 0.9, HASHTABLE_LP_RESIZE_FACTOR,
+											hashfunc, isequalfunc, NULL, NULL );
+	tables[1] = hashtable_lp_create_robinhood( 2048, 0.9, HASHTABLE_LP_RESIZE_FACTOR,
+											   hashfunc, isequalfunc, NULL, NULL );
+	const char* names[2] = { "inline (tombstones)", "robin hood" };
+
+	for (int t = 0; t < 2; ++t) {
+		for (int i = 0; i < n; ++i)
+			hashtable_lp_put(tables[t], &keys[i], &keys[i]);
+
+		for (int r = 0; r < rounds; ++r) {
+			hashtable_lp_put(tables[t], &keys[n + r], &keys[n + r]);
+			free(hashtable_lp_remove(tables[t], &keys[r]));
+		}
+
+		struct hashtable_lp_stats stats;
+		hashtable_lp_stats(tables[t], &stats);
+		printf( "%-20s count %zu, capacity %zu, deleted slots %zu, probe distance mean %.2f, max %zu\n",
+				names[t], stats.count, stats.capacity, stats.deleted,
+				datastats_histogram_mean(&stats.probes), stats.probes.max );
+	}
+
+	int missing = -1;
+	printf("Lookup of a missing key: %s\n", (hashtable_lp_get(tables[1], &missing) == NULL) ? "NOT FOUND" : "FOUND");
+
+	hashtable_lp_destroy(tables[0]);
+	hashtable_lp_destroy(tables[1]);
+	free(keys);
+	printf("%s", "Hash table (linear probe, robin hood storage) destroyed successfully.\n\n");
+}
+
+void hashtable_lp_lockfree_demo()
+{
+	int hashfunc(const void* key) {
+		return *((int*)key);
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	printf("_________\n");
+	printf("HASHTABLE (linear probe version, lock-free reads)\n");
+	printf("\nHash table with lock-free readers demo ------------\n");
+	printf("Readers take no locks, writer publishes changes atomically\n\n");
+
+	struct hashtable_lp* htable = hashtable_lp_create_lockfree( HASHTABLE_LP_DEFAULT_SIZE,
+																HASHTABLE_LP_DEFAULT_LOAD_FACTOR,
+																HASHTABLE_LP_RESIZE_FACTOR,
+																hashfunc, isequalfunc, NULL, NULL );
+
+	#define LOCKFREE_DEMO_READERS 3
+	#define LOCKFREE_DEMO_KEYS 1000
+
+	static int keys[LOCKFREE_DEMO_KEYS];
+	pthread_t readers[LOCKFREE_DEMO_READERS];
+
+	// readers look keys up while writer inserts them (and resizes the table)
+	void* reader(void* arg) {
+		long found = 0;
+		for (int round = 0; round < 10; ++round)
+			for (int i = 0; i < LOCKFREE_DEMO_KEYS; ++i)
+				found += (hashtable_lp_get(htable, &keys[i]) != NULL);
+
+		return (void*)found;
+	}
+
+	for (int i = 0; i < LOCKFREE_DEMO_KEYS; ++i)
+		keys[i] = i;
+
+	for (int t = 0; t < LOCKFREE_DEMO_READERS; ++t)
+		pthread_create(&readers[t], NULL, reader, NULL);
+
+	for (int i = 0; i < LOCKFREE_DEMO_KEYS; ++i)
+		hashtable_lp_put(htable, &keys[i], &keys[i]);
+
+	for (int t = 0; t < LOCKFREE_DEMO_READERS; ++t)
+		pthread_join(readers[t], NULL);
+
+	int found = 0;
+	for (int i = 0; i < LOCKFREE_DEMO_KEYS; ++i)
+		found += hashtable_lp_contains(htable, &keys[i]);
+
+	printf("Readers: %d, writer inserted %zu keys, keys found after join: %d\n",
+			LOCKFREE_DEMO_READERS, htable->count, found);
+
+	free(hashtable_lp_remove(htable, &keys[7]));
+	printf("Does hashtable contains key '%d'? %s\n", keys[7], hashtable_lp_contains(htable, &keys[7]) ? "YES" : "NO");
+
+	hashtable_lp_destroy(htable);
+	printf("%s", "Hash table (linear probe, lock-free reads) destroyed successfully.\n\n");
+}
+
+void hashtable_simd_demo()
+{
+	int hashfunc(const void* key) {
+		return *((int*)key);
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	void printitemfunc(const struct hashtable_simd_keyvalue_pair* kvp) {
+		printf("%d : %d", *((int*)kvp->key), *((int*)kvp->value));
+	}
+
+	printf("_________\n");
+	printf("HASHTABLE (group probing version)\n");
+	printf("\nHash table with group probing demo ------------\n");
+	printf("Compares 16 slot tags per step, runs up to %.3f load factor\n\n", HASHTABLE_SIMD_DEFAULT_LOAD_FACTOR);
+
+	struct hashtable_simd* htable = hashtable_simd_create_default( hashfunc, isequalfunc,
+																   printitemfunc, NULL );
+
+	int keys[100];
+	int values[100];
+	int n = 100;
+
+	// large set of key/value pairs to provoque array reallocations
+	for (int i = 0; i < n; ++i) {
+		keys[i] = i;
+		values[i] = (n-1) - i;
+		hashtable_simd_put(htable, &keys[i], &values[i]);
+	}
+
+	printf("Put duplicated key '%d' returns: %d\n", keys[5], hashtable_simd_put(htable, &keys[5], &values[0]));
+	printf("Hashtable size: %zu\n", htable->count);
+	printf("Hashtable capacity: %zu\n\n", htable->capacity);
+
+	// remove keys greater than 9
+	for (int i = 10; i < n; ++i)
+		free(hashtable_simd_remove(htable, &keys[i]));
+
+	printf("Print hashtable:\n");
+	hashtable_simd_print(htable);
+
+	printf("\nDoes hashtable contains key '%d'? %s\n", keys[20], hashtable_simd_contains(htable, &keys[20]) ? "YES" : "NO");
+	printf("Does hashtable contains key '%d'? %s\n", keys[3], hashtable_simd_contains(htable, &keys[3]) ? "YES" : "NO");
+
+	void* val = hashtable_simd_get(htable, &keys[3]);
+	printf("Get value with key '%d': %d.\n", keys[3], *((int*)(val)) );
+
+	hashtable_simd_destroy(htable);
+	printf("%s", "Hash table (group probing) destroyed successfully.\n\n");
+}
+
+void hashtable_concurrent_demo()
+{
+	int hashfunc(const void* key) {
+		return *((int*)key);
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	printf("_________\n");
+	printf("HASHTABLE (concurrent, sharded)\n");
+	printf("\nConcurrent hash table demo ------------\n");
+	printf("%d shards, each with its own reader-writer lock\n\n", HASHTABLE_CONCURRENT_DEFAULT_SHARDS);
+
+	struct hashtable_concurrent* htable = hashtable_concurrent_create_default( hashfunc, isequalfunc,
+																			   NULL, NULL );
+
+	#define CONCURRENT_DEMO_THREADS 4
+	#define CONCURRENT_DEMO_KEYS 1000
+
+	static int keys[CONCURRENT_DEMO_THREADS * CONCURRENT_DEMO_KEYS];
+	pthread_t threads[CONCURRENT_DEMO_THREADS];
+	int ids[CONCURRENT_DEMO_THREADS];
+
+	// each thread inserts its own range of keys and reads it back
+	void* worker(void* arg) {
+		int id = *((int*)arg);
+		long found = 0;
+		for (int i = id * CONCURRENT_DEMO_KEYS; i < (id + 1) * CONCURRENT_DEMO_KEYS; ++i) {
+			keys[i] = i;
+			hashtable_concurrent_put(htable, &keys[i], &keys[i]);
+		}
+
+		for (int i = id * CONCURRENT_DEMO_KEYS; i < (id + 1) * CONCURRENT_DEMO_KEYS; ++i)
+			found += (hashtable_concurrent_get(htable, &keys[i]) == &keys[i]);
+
+		return (void*)found;
+	}
+
+	for (int t = 0; t < CONCURRENT_DEMO_THREADS; ++t) {
+		ids[t] = t;
+		pthread_create(&threads[t], NULL, worker, &ids[t]);
+	}
+
+	long total = 0;
+	for (int t = 0; t < CONCURRENT_DEMO_THREADS; ++t) {
+		void* found = NULL;
+		pthread_join(threads[t], &found);
+		total += (long)found;
+	}
+
+	printf("Threads: %d, keys found by threads: %ld\n", CONCURRENT_DEMO_THREADS, total);
+	printf("Hashtable size: %zu\n", hashtable_concurrent_count(htable));
+
+	struct hashtable_keyvalue_pair* del = hashtable_concurrent_remove(htable, &keys[7]);
+	printf("Key '%d' removed: %s\n", keys[7], del ? "YES" : "NO");
+	free(del);
+	printf("Does hashtable contains key '%d'? %s\n", keys[7], hashtable_concurrent_contains(htable, &keys[7]) ? "YES" : "NO");
+
+	hashtable_concurrent_destroy(htable);
+	printf("%s", "Hash table (concurrent) destroyed successfully.\n\n");
+}
+
+void numa_demo()
+{
+	int hashfunc(const void* key) {
+		return *((int*)key);
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	printf("_________\n");
+	printf("NUMA PARTITIONS\n");
+	printf("NUMA partitioned hash table and CSR graph demo ------------\n\n");
+
+	int numnodes = numanode_getcount();
+	printf("NUMA nodes: %d, calling thread runs on node %d\n", numnodes, numanode_current());
+
+	// one worker per node: it is pinned to its node and inserts the keys the node owns
+	struct hashtable_concurrent* htable = hashtable_concurrent_create_numa( 64, 64 * HASHTABLE_DEFAULT_CAPACITY,
+																			HASHTABLE_DEFAULT_LOAD_FACTOR,
+																			hashfunc, isequalfunc, NULL, NULL );
+	#define NUMA_DEMO_KEYS 100000
+	static int keys[NUMA_DEMO_KEYS];
+	for (int i = 0; i < NUMA_DEMO_KEYS; ++i)
+		keys[i] = i;
+
+	void* worker(void* arg) {
+		int node = *((int*)arg);
+		long inserted = 0;
+		numanode_pin_thread(node);
+		for (int i = 0; i < NUMA_DEMO_KEYS; ++i)
+			if (hashtable_concurrent_getnode(htable, &keys[i]) == node)
+				inserted += hashtable_concurrent_put(htable, &keys[i], &keys[i]);
+
+		return (void*)inserted;
+	}
+
+	pthread_t* threads = malloc(numnodes * sizeof(pthread_t));
+	int* nodes = malloc(numnodes * sizeof(int));
+	for (int n = 0; n < numnodes; ++n) {
+		nodes[n] = n;
+		pthread_create(&threads[n], NULL, worker, &nodes[n]);
+	}
+
+	for (int n = 0; n < numnodes; ++n) {
+		void* inserted = NULL;
+		pthread_join(threads[n], &inserted);
+		printf("Node %d worker inserted %ld keys\n", n, (long)inserted);
+	}
+
+	printf("Hashtable size: %zu, key 4242 lives on node %d\n", hashtable_concurrent_count(htable),
+			hashtable_concurrent_getnode(htable, &keys[4242]));
+	hashtable_concurrent_destroy(htable);
+	free(threads);
+	free(nodes);
+
+	// vertex range partitioned graph: parallel BFS workers scan their node's partition
+	int n = 100000;
+	size_t m = (size_t)n * 4;
+	struct adjlgraph_edgeitem* edges = malloc(m * sizeof(struct adjlgraph_edgeitem));
+	srand(60);
+	for (size_t i = 0; i < m; ++i) {
+		edges[i].from = rand() % n;
+		edges[i].to = rand() % n;
+		edges[i].weight = 1.0;
+	}
+
+	struct csrgraph* g = csrgraph_create_from_edges(n, UNDIRECTED_AGRAPH, edges, m, 1);
+	struct csrgraph* pg = csrgraph_create_partitioned(g, (numnodes > 1) ? numnodes : 2);
+	printf("Partitions (first vertex):");
+	for (int k = 0; k <= pg->numpartitions; ++k)
+		printf(" %zu", pg->partitions[k]);
+	printf("\n");
+
+	int* prev = bfsalg_parallel_parents(g, NULL, 0, 4);
+	int* pprev = bfsalg_parallel_parents(pg, NULL, 0, 4);
+	int reached = 0, preached = 0;
+	for (int v = 0; v < n; ++v) {
+		reached += (prev[v] >= 0);
+		preached += (pprev[v] >= 0);
+	}
+	printf("Vertices reached from 0: %d (partitioned graph: %d)\n", reached, preached);
+
+	free(prev);
+	free(pprev);
+	csrgraph_destroy(pg);
+	csrgraph_destroy(g);
+	free(edges);
+}
+
+void streamagg_demo()
+{
+	printf("_________\n");
+	printf("STREAM AGGREGATES\n");
+	printf("Sliding window min/max and top-k heavy hitters demo ------------\n\n");
+
+	uint64_t hashkey(const void* key) {
+		return *(const uint32_t*)key * 0x9E3779B97F4A7C15ULL;
+	}
+
+	int equalkeys(const void* key1, const void* key2) {
+		return *(const uint32_t*)key1 == *(const uint32_t*)key2;
+	}
+
+	// latencies of a service: last 1000 requests of the last 60 seconds
+	struct slidingwindow* window = slidingwindow_create(1000, 60.0);
+	srand(61);
+	double time = 0, min, max;
+	for (int i = 1; i <= 100000; ++i) {
+		time += 0.01 * (rand() % 10);
+		double latency = 5.0 + (rand() % 1000) / 100.0 + ((i % 25000 < 100) ? 200.0 : 0.0);	// spikes
+		slidingwindow_push(window, latency, time);
+		if ((i % 25000 == 50) || (i % 25000 == 1500)) {
+			slidingwindow_getmin(window, &min);
+			slidingwindow_getmax(window, &max);
+			printf("t=%7.1fs window of %4zu requests: min %6.2f ms, max %6.2f ms\n", time,
+					slidingwindow_getcount(window), min, max);
+		}
+	}
+
+	slidingwindow_expire(window, time + 120.0);	// nothing in the last minute
+	printf("After two idle minutes the window has %zu requests\n\n", slidingwindow_getcount(window));
+	slidingwindow_destroy(window);
+
+	// endpoints hit by requests: a few hot ones, a long tail of cold ones
+	size_t k = 64, top = 5;
+	struct topk* trackers[3] = { topk_create_spacesaving(k, sizeof(uint32_t), hashkey, equalkeys),
+								 topk_create_countmin(k, 2048, 4, sizeof(uint32_t), hashkey, equalkeys),
+								 topk_create(top, sizeof(uint32_t), hashkey, equalkeys) };
+	const char* names[3] = { "space-saving", "count-min", "exact tracker" };
+	int n = 1000000;
+	uint32_t* truth = calloc(10000, sizeof(uint32_t));
+	for (int i = 0; i < n; ++i) {
+		uint32_t endpoint = (i % 4 == 0) ? (uint32_t)(rand() % 10) : (uint32_t)(10 + rand() % 9990);
+		truth[endpoint]++;
+		topk_add(trackers[0], &endpoint, 1);
+		topk_add(trackers[1], &endpoint, 1);
+	}
+
+	// the exact tracker ranks counts computed elsewhere
+	for (uint32_t e = 0; e < 10000; ++e)
+		topk_offer(trackers[2], &e, truth[e]);
+
+	struct topk_item items[64];
+	for (int t = 0; t < 3; ++t) {
+		size_t count = topk_getitems(trackers[t], items);
+		printf("%-13s top %zu:", names[t], top);
+		for (size_t i = 0; (i < count) && (i < top); ++i)
+			printf(" %u:%lu", *(const uint32_t*)items[i].key, (unsigned long)items[i].count);
+		printf("\n");
+	}
+
+	for (int t = 0; t < 3; ++t)
+		topk_destroy(trackers[t]);
+	free(truth);
+}
+
+void lrucache_demo()
+{
+	uint64_t hashfunc(const void* key) {
+		return (uint64_t)*((int*)key);
+	}
+
+	int isequalfunc(const void* key1, const void* key2) {
+		return (*((int*)key1) == *((int*)key2));
+	}
+
+	void print_lru(struct lrucache* cache) {
+		struct ilist* lru = &(cache->shards[0].lru);
+		for (struct ilist_node* n = ilist_first(lru); n != NULL; n = ilist_next(lru, n))
+			printf("%d ", *((int*)INTRUSIVE_CONTAINER_OF(n, struct lrucache_entry, lru)->key));
+	}
+
+	printf("_________\n");
+	printf("LRU CACHE\n");
+	printf("\nLRU cache demo ------------\n\n");
+
+	static int keys[20000];
+	for (int i = 0; i < 20000; ++i)
+		keys[i] = i;
+
+	struct lrucache* cache = lrucache_create(4, hashfunc, isequalfunc, NULL);
+	for (int i = 1; i <= 4; ++i)
+		lrucache_put(cache, &keys[i], &keys[i * 10]);
+
+	printf("Put 1..4, LRU order (most recent first): ");
+	print_lru(cache);
+	int* value = lrucache_get(cache, &keys[2]);
+	printf("\nGet 2 = %d, order: ", value ? *value : -1);
+	print_lru(cache);
+	lrucache_put(cache, &keys[5], &keys[50]);
+	printf("\nPut 5 (evicts 1), order: ");
+	print_lru(cache);
+	printf("\nGet 1: %s, size %zu of %zu\n\n", lrucache_get(cache, &keys[1]) ? "found" : "not found",
+		   lrucache_getsize(cache), lrucache_getcapacity(cache));
+	lrucache_destroy(cache);
+
+	// hot keys read again and again, interleaved with a scan of one-time keys
+	for (int admission = LRUCACHE_ADMIT_ALL; admission <= LRUCACHE_ADMIT_TINYLFU; ++admission) {
+		cache = lrucache_create_ex(100, 0, admission, hashfunc, isequalfunc, NULL);
+		for (int k = 1000; k < 20000; ++k) {
+			if (k % 50 == 0)
+				for (int h = 0; h < 90; ++h)
+					if (lrucache_get(cache, &keys[h]) == NULL)
+						lrucache_put(cache, &keys[h], &keys[h]);
+
+			if (lrucache_get(cache, &keys[k]) == NULL)
+				lrucache_put(cache, &keys[k], &keys[k]);
+		}
+
+		struct lrucache_stats stats;
+		lrucache_getstats(cache, &stats);
+		printf("%s: hot key hit rate %.1f%%, evictions %zu, rejected %zu\n",
+			   (admission == LRUCACHE_ADMIT_ALL) ? "LRU    " : "TinyLFU",
+			   100.0 * (stats.hits) / (380 * 90), stats.evictions, stats.rejections);
+		lrucache_destroy(cache);
+	}
+
+	// sharded cache shared by threads
+	#define LRUCACHE_DEMO_THREADS 4
+	cache = lrucache_create_ex(1024, 16, LRUCACHE_ADMIT_TINYLFU, hashfunc, isequalfunc, NULL);
+	pthread_t threads[LRUCACHE_DEMO_THREADS];
+	int ids[LRUCACHE_DEMO_THREADS];
+
+	void* worker(void* arg) {
+		unsigned int seed = *((int*)arg) + 1;
+		for (int i = 0; i < 50000; ++i) {
+			// skewed keys: most accesses go to the first 512
+			int k = (rand_r(&seed) % 4 != 0) ? rand_r(&seed) % 512 : rand_r(&seed) % 20000;
+			if (lrucache_get(cache, &keys[k]) == NULL)
+				lrucache_put(cache, &keys[k], &keys[k]);
+		}
+
+		return NULL;
+	}
+
+	for (int t = 0; t < LRUCACHE_DEMO_THREADS; ++t) {
+		ids[t] = t;
+		pthread_create(&threads[t], NULL, worker, &ids[t]);
+	}
+
+	for (int t = 0; t < LRUCACHE_DEMO_THREADS; ++t)
+		pthread_join(threads[t], NULL);
+
+	struct lrucache_stats stats;
+	lrucache_getstats(cache, &stats);
+	printf("\n%zu shards, %d threads: size %zu of %zu, hits %zu, misses %zu\n", cache->nshards,
+		   LRUCACHE_DEMO_THREADS, lrucache_getsize(cache), lrucache_getcapacity(cache),
+		   stats.hits, stats.misses);
+
+	lrucache_destroy(cache);
+	printf("%s", "LRU cache destroyed successfully.\n\n");
+}
+
+/*
+ * String interning pool demo.
+ * */
+void strintern_demo() {
+	printf("_____________________\n");
+	printf("STRING INTERNING POOL\n");
+	printf("String interning pool demo ------------\n\n");
+
+	const char* text = "the quick brown fox jumps over the lazy dog and the dog sleeps";
+	struct strintern* pool = strintern_create(16);
+
+	// tokenize the text 1000 times: every occurrence maps to the same canonical copy
+	size_t tokens = 0, copiesbytes = 0;
+	const char* first = NULL;
+	char word[32];
+	for (int r = 0; r < 1000; ++r) {
+		for (const char* p = text; *p; ) {
+			size_t length = strcspn(p, " ");
+			const char* canonical = strintern_intern_len(pool, p, length);
+			if (length == 3 && strncmp(p, "dog", 3) == 0 && first == NULL)
+				first = canonical;
+
+			tokens++;
+			copiesbytes += length + 1 + 16;		// strdup copy plus malloc header
+			p += length + (p[length] == ' ');
+		}
+	}
+
+	printf("%zu tokens, %zu distinct strings\n", tokens, strintern_getcount(pool));
+	printf("One copy per token: %zu bytes, interned: %zu bytes\n", copiesbytes,
+		   strintern_sizeinbytes(pool));
+
+	strcpy(word, "dog");
+	const char* dog = strintern_intern(pool, word);
+	printf("Interning \"%s\" again returns the same pointer? %s (id %u, length %zu)\n",
+		   word, (dog == first) ? "YES" : "NO", strintern_idof(dog), strintern_lengthof(dog));
+	printf("Lookup of \"cat\" (not added): %s\n", strintern_lookup(pool, "cat") ? "found" : "not found");
+
+	// per string counters indexed by id
+	size_t* counts = calloc(strintern_getcount(pool), sizeof(size_t));
+	for (const char* p = text; *p; ) {
+		size_t length = strcspn(p, " ");
+		counts[strintern_idof(strintern_intern_len(pool, p, length))]++;
+		p += length + (p[length] == ' ');
+	}
+
+	printf("Word counts by id:");
+	for (uint32_t id = 0; id < strintern_getcount(pool); ++id)
+		printf(" %s=%zu", strintern_get(pool, id), counts[id]);
 
-	printf("\nPrint hashtable:\n");
-	hashtable_lp_print(htable);
+	printf("\n");
+	free(counts);
 
-	void* val = hashtable_lp_get(htable, &keys[3]);
-	printf("\nGet value with key '%d': %d.\n", keys[3], *((int*)(val)) );
+	// hash table keyed by canonical strings: hash of the id, pointer equality
+	struct hashtable* htable = hashtable_create_default(strintern_hashfunc, strintern_isequal, NULL, NULL);
+	for (uint32_t id = 0; id < strintern_getcount(pool); ++id)
+		hashtable_put(htable, (void*)strintern_get(pool, id), NULL);
 
-	hashtable_lp_destroy(htable);
-	printf("%s", "Hash table (linear probe) destroyed successfully.\n\n");
+	printf("Hash table with interned keys: %zu keys, contains \"fox\"? %s\n", htable->count,
+		   hashtable_contains(htable, (void*)strintern_intern(pool, "fox")) ? "YES" : "NO");
+	printf("strintern_compare(\"brown\", \"quick\") < 0? %s\n",
+		   (strintern_compare(strintern_lookup(pool, "brown"), strintern_lookup(pool, "quick")) < 0) ? "YES" : "NO");
+
+	hashtable_destroy(htable);
+	strintern_destroy(pool);
+	printf("String pool destroyed successfully.\n");
 }
 
 /*
@@ -847,10 +3475,198 @@ void hashset_demo() {
 	printf("\nPrint set:\n");
 	hashset_print(set);
 
+	// batch lookup of elements 0..4
+	void* batch[5];
+	int found[5];
+	for (int i = 0; i < 5; ++i)
+		batch[i] = &intdata[i];
+
+	hashset_contains_batch(set, batch, 5, found);
+	printf("\nBatch lookup of elements 0..4:");
+	for (int i = 0; i < 5; ++i)
+		printf(" %d=%s", intdata[i], found[i] ? "YES" : "NO");
+	printf("\n");
+
 	hashset_destroy(set);
 	printf("\nHashset destroyed successfully.\n");
 }
 
+/*
+ * Bloom and cuckoo filters demo.
+ * */
+void membershipfilters_demo() {
+
+	int hashfunc(const void* element) {
+		return *((int*)element);
+	}
+
+	int isequal(const void* a, const void* b) {
+		return (*(int*)a == *(int*)b);
+	}
+
+	printf("___________________\n");
+	printf("MEMBERSHIP FILTERS\n");
+	printf("Blocked Bloom filter and cuckoo filter demo ------------\n\n");
+
+	#define FILTERS_DEMO_N 50000
+	static int elements[2 * FILTERS_DEMO_N];
+	for (int i = 0; i < 2 * FILTERS_DEMO_N; ++i)
+		elements[i] = i * 7 + 3;
+
+	// first half is added, second half is only looked up
+	struct bloomfilter* bloom = bloomfilter_create(FILTERS_DEMO_N, BLOOMFILTER_DEFAULT_BITS, hashfunc);
+	struct cuckoofilter* cuckoo = cuckoofilter_create(FILTERS_DEMO_N, hashfunc);
+	for (int i = 0; i < FILTERS_DEMO_N; ++i) {
+		bloomfilter_add(bloom, &elements[i]);
+		cuckoofilter_add(cuckoo, &elements[i]);
+	}
+
+	int bloomfp = 0, cuckoofp = 0, missed = 0;
+	for (int i = 0; i < FILTERS_DEMO_N; ++i)
+		missed += !bloomfilter_maycontain(bloom, &elements[i]) + !cuckoofilter_maycontain(cuckoo, &elements[i]);
+	for (int i = FILTERS_DEMO_N; i < 2 * FILTERS_DEMO_N; ++i) {
+		bloomfp += bloomfilter_maycontain(bloom, &elements[i]);
+		cuckoofp += cuckoofilter_maycontain(cuckoo, &elements[i]);
+	}
+
+	printf("%d elements added, false negatives: %d\n", FILTERS_DEMO_N, missed);
+	printf("Bloom:  %zu blocks of %d bits (%.1f bits/element, k = %u), false positives %.3f%% (estimated %.3f%%)\n",
+		   bloom->nblocks, BLOOMFILTER_BLOCK_BITS,
+		   (double)bloom->nblocks * BLOOMFILTER_BLOCK_BITS / FILTERS_DEMO_N, bloom->nhashes,
+		   100.0 * bloomfp / FILTERS_DEMO_N, 100.0 * bloomfilter_fprate(bloom));
+	printf("Cuckoo: %zu slots (%.1f bits/element), false positives %.3f%%\n",
+		   cuckoofilter_getcapacity(cuckoo), 16.0 * cuckoofilter_getcapacity(cuckoo) / FILTERS_DEMO_N,
+		   100.0 * cuckoofp / FILTERS_DEMO_N);
+
+	// cuckoo filters follow deletes
+	for (int i = 0; i < FILTERS_DEMO_N; i += 2)
+		cuckoofilter_remove(cuckoo, &elements[i]);
+	printf("Cuckoo after removing half: size %zu, may contain %d? %s, %d? %s\n\n",
+		   cuckoofilter_getsize(cuckoo), elements[0], cuckoofilter_maycontain(cuckoo, &elements[0]) ? "YES" : "NO",
+		   elements[1], cuckoofilter_maycontain(cuckoo, &elements[1]) ? "YES" : "NO");
+
+	// as hashset pre-filter: absent elements rarely reach the bucket chains
+	int prefilters[3] = { HASHSET_PREFILTER_NONE, HASHSET_PREFILTER_BLOOM, HASHSET_PREFILTER_CUCKOO };
+	const char* names[3] = { "none  ", "Bloom ", "cuckoo" };
+	for (int p = 0; p < 3; ++p) {
+		struct hashset* set = hashset_create(hashfunc, isequal, NULL, NULL);
+		hashset_set_prefilter(set, prefilters[p]);
+		for (int i = 0; i < FILTERS_DEMO_N; ++i)
+			hashset_add(set, &elements[i]);
+
+		int found = 0, passed = 0;
+		for (int i = FILTERS_DEMO_N; i < 2 * FILTERS_DEMO_N; ++i) {
+			if (set->bloom != NULL)
+				passed += bloomfilter_maycontain(set->bloom, &elements[i]);
+			else if (set->cuckoo != NULL)
+				passed += cuckoofilter_maycontain(set->cuckoo, &elements[i]);
+			else
+				passed++;
+			found += hashset_contains(set, &elements[i]);
+		}
+
+		printf("Hashset pre-filter %s: %d absent lookups, %d reached the table, found %d\n",
+			   names[p], FILTERS_DEMO_N, passed, found);
+		hashset_destroy(set);
+	}
+
+	bloomfilter_destroy(bloom);
+	cuckoofilter_destroy(cuckoo);
+	printf("Filters destroyed successfully.\n");
+}
+
+/*
+ * Bitset and roaring bitmap demo.
+ * */
+void bitset_demo() {
+
+	void print_bitset(const struct bitset* set) {
+		printf("{ ");
+		for (size_t i = bitset_next(set, 0); i < set->nbits; i = bitset_next(set, i + 1))
+			printf("%zu ", i);
+		printf("}");
+	}
+
+	void print_value(uint32_t value, void* arg) {
+		printf("%u ", value);
+	}
+
+	printf("___________________\n");
+	printf("BITSET\n");
+	printf("Bitset and roaring bitmap demo ------------\n\n");
+
+	struct bitset* a = bitset_create(100);
+	struct bitset* b = bitset_create(100);
+	for (int i = 0; i < 100; i += 3)
+		bitset_set(a, i);
+	for (int i = 0; i < 100; i += 5)
+		bitset_set(b, i);
+
+	printf("A (multiples of 3), %zu elements: ", bitset_count(a));
+	print_bitset(a);
+	printf("\nB (multiples of 5), %zu elements\n", bitset_count(b));
+	printf("Rank of 50 in A (elements < 50): %zu\n", bitset_rank(a, 50));
+
+	struct bitset* c = bitset_create(100);
+	bitset_or(c, a);
+	printf("A AND B (%zu): ", bitset_and(c, b));
+	print_bitset(c);
+	bitset_clearall(c);
+	bitset_or(c, a);
+	printf("\nA ANDNOT B: %zu elements, A OR B: ", bitset_andnot(c, b));
+	bitset_clearall(c);
+	bitset_or(c, a);
+	printf("%zu elements\n", bitset_or(c, b));
+
+	bitset_destroy(a);
+	bitset_destroy(b);
+	bitset_destroy(c);
+
+	size_t n = 1000000;
+	printf("\nVisited set of %zu vertices: bool array %zu KB, bitset %zu KB\n",
+		   n, n * sizeof(bool) / 1024, (n + 7) / 8 / 1024);
+
+	// sparse and clustered values: array containers and one bitmap container
+	struct roaring* r1 = roaring_create();
+	struct roaring* r2 = roaring_create();
+	for (uint32_t i = 0; i < 100; ++i)
+		roaring_add(r1, i * 1000003u);				// spread over the 32 bit space
+	for (uint32_t i = 0; i < 20000; ++i)
+		roaring_add(r1, 5000000 + i);				// a dense run
+	for (uint32_t i = 0; i < 30000; i += 2)
+		roaring_add(r2, 5010000 + i);
+
+	printf("\nRoaring R1: %zu values in %zu containers, %zu bytes (bitset of the range: %u bytes)\n",
+		   roaring_cardinality(r1), r1->count, roaring_sizeinbytes(r1), 99u * 1000003u / 8);
+	printf("R1 contains %u? %s, %u? %s\n", 7000021u, roaring_contains(r1, 7000021u) ? "YES" : "NO",
+		   7000022u, roaring_contains(r1, 7000022u) ? "YES" : "NO");
+	printf("Rank of 5010000 in R1: %zu\n", roaring_rank(r1, 5010000));
+
+	struct roaring* rand_ = roaring_and(r1, r2);
+	struct roaring* ror = roaring_or(r1, r2);
+	struct roaring* randnot = roaring_andnot(r1, r2);
+	printf("R1 AND R2: %zu values, R1 OR R2: %zu values, R1 ANDNOT R2: %zu values\n",
+		   roaring_cardinality(rand_), roaring_cardinality(ror), roaring_cardinality(randnot));
+
+	roaring_remove(rand_, 5010000);
+	struct roaring* head = roaring_create();
+	for (uint32_t v = 5010000; v < 5010010; ++v)
+		roaring_add(head, v);
+	struct roaring* first = roaring_and(rand_, head);
+	printf("First values of R1 AND R2 after removing 5010000: ");
+	roaring_foreach(first, print_value, NULL);
+	printf("\n");
+
+	roaring_destroy(first);
+	roaring_destroy(head);
+	roaring_destroy(rand_);
+	roaring_destroy(ror);
+	roaring_destroy(randnot);
+	roaring_destroy(r1);
+	roaring_destroy(r2);
+	printf("Bitsets destroyed successfully.\n");
+}
+
 /*
  * Double linked list deque demo.
  * */
@@ -993,6 +3809,33 @@ void arraydeque_demo() {
 	printdata(arraydeque_back(q));
 	printf("\n\n");
 
+	// BFS like frontier: levels pushed and popped in bulk
+	printf("Bulk push/pop of 3 levels of 1000 elements\n");
+	static int level[1000];
+	void* items[1000];
+	for (int i = 0; i < 1000; i++) {
+		level[i] = i;
+		items[i] = &level[i];
+	}
+
+	for (int l = 0; l < 3; l++)
+		arraydeque_push_back_n(q, items, 1000);
+
+	printf("Current capacity: %zu, size: %zu\n", q->capacity, q->size);
+
+	size_t popped = 0;
+	while (q->size >= 1000)
+		popped += arraydeque_pop_front_n(q, items, 1000);
+
+	printf("Popped %zu elements, capacity after shrinking: %zu, size: %zu\n", popped,
+		   q->capacity, q->size);
+	printf("Front element: ");
+	printdata(arraydeque_front(q));
+	printf("\n");
+
+	arraydeque_reserve(q, 500);
+	printf("Reserved 500, capacity: %zu\n\n", q->capacity);
+
 	arraydeque_destroy(q);
 	printf("Array deque destroyed successfully.\n");
 }
@@ -1043,15 +3886,15 @@ void fibonacciheap_demo() {
 
 	int minval = INT_MIN;
 	int intdata[] = {5, 2, 8};
-	int eight = intdata[2];
 	int n = 3;	//sizeof(intdata) / sizeof(intdata[0]);
+	struct fibheapnode* handles[3];
 	printf("Creating an initial empty heap\n");
 	struct fibheap* fh = fibheap_create((void*)(&minval), compare, printdata, NULL);
 
 	printf("Load heap with elements in the following order:\n");
 	for (int i = 0; i < n; ++i) {
 		printf("%d ", intdata[i]);
-		fibheap_insert(fh, &intdata[i]);
+		handles[i] = fibheap_insert(fh, &intdata[i]);	// node handle
 	}
 
 	printf("\n\n");
@@ -1074,7 +3917,7 @@ void fibonacciheap_demo() {
 	// Now we will decrease the value of node '8' to '7'
 	int seven = 7;
 	printf("Decrease value of 8 to 7\n");
-	fibheap_find_and_decrease(fh, fh->mini, &eight, &seven);
+	fibheap_decrease_key(fh, handles[2], &seven);	// O(1), no search
 	fibheap_print(fh);
 	/*
 	 * Root nodes: 5
@@ -1082,7 +3925,7 @@ void fibonacciheap_demo() {
 
 	// Now we will delete the node '7'
 	printf("Delete the node 7\n");
-	struct fibheapnode* delnode = fibheap_delete(fh, &seven);
+	struct fibheapnode* delnode = fibheap_delete_node(fh, handles[2]);
 	printf("Node '%d' deleted from heap.\n", *((int*)(delnode->key)));
 
 	fibheap_print(fh);
@@ -1382,6 +4225,52 @@ void binaryheaparray_demo() {
 	maxbinaryheap_destroy(maxbinaryheap);
 	printf("Max binary heap destroyed successfully.\n\n");
 
+	printf("--------------------------------------------------\n");
+	printf("--------------------------------------------------\n");
+
+	printf("\nBATCH OPERATIONS AND TOP-K -----------\n\n");
+
+	// capacity 1 on purpose, array grows on demand
+	minbinaryheap = minbinaryheap_createHeap(1, datalist, 3, (void*)min, (void*)max,
+											 compare, printdata, NULL);
+	printf("Min heap built bottom-up from 3 elements, insert batch of 3 more:\n");
+	minbinaryheap_insert_batch(minbinaryheap, &datalist[3], n - 3);
+	minbinaryheap_print(minbinaryheap);
+
+	void* out[6];
+	int count = minbinaryheap_extract_batch(minbinaryheap, 4, out);
+	printf("Extract batch of 4 smallest:");
+	for (int i = 0; i < count; i++)
+		printf(" %d", *((int*)out[i]));
+
+	printf("\nHeap size: %d\n\n", minbinaryheap->size);
+	minbinaryheap_destroy(minbinaryheap);
+
+	// bounded top-k: a min heap keeps the k greatest, a max heap the k smallest
+	int k = 3;
+	minbinaryheap = minbinaryheap_createHeap(k, NULL, 0, (void*)min, (void*)max,
+											 compare, printdata, NULL);
+	maxbinaryheap = maxbinaryheap_createHeap(k, NULL, 0, (void*)min, (void*)max,
+											 compare, printdata, NULL);
+	for (int i = 0; i < n; ++i) {
+		minbinaryheap_insert_topk(minbinaryheap, datalist[i], k);
+		maxbinaryheap_insert_topk(maxbinaryheap, datalist[i], k);
+	}
+
+	count = minbinaryheap_extract_batch(minbinaryheap, k, out);
+	printf("Top-%d greatest (ascending):", k);
+	for (int i = 0; i < count; i++)
+		printf(" %d", *((int*)out[i]));
+
+	count = maxbinaryheap_extract_batch(maxbinaryheap, k, out);
+	printf("\nTop-%d smallest (descending):", k);
+	for (int i = 0; i < count; i++)
+		printf(" %d", *((int*)out[i]));
+
+	printf("\n\n");
+	minbinaryheap_destroy(minbinaryheap);
+	maxbinaryheap_destroy(maxbinaryheap);
+
 	free(p1);
 	free(max);
 	free(min);
@@ -1455,7 +4344,7 @@ void rbtree_demo() {
 
 	// create empty tree (no root)
 	struct rbtree* tree = rbtree_create( NULL, calcdatasize, compare, NULL,
-										 printdata, copydata );
+										 printdata, copydata, NULL );
 
 	printf("Red-black tree created successfully (empty).\n");
 	printf("Tree size: %d\n\n", rbtree_getSizeIt(tree));
@@ -1625,7 +4514,7 @@ void avltree_demo() {
 
 	// put '3' as root
 	struct avltree* tree = avltree_create(&intdata[0], compare, NULL,
-			printnode, copydata);
+			printnode, copydata, NULL);
 
 	printf("AVL tree created successfully with root = '%d'\n", *((int*)(tree->root->data)));
 	printf("Tree size: %d\n\n", avltree_getSizeIt(tree));
@@ -1718,6 +4607,21 @@ void avltree_demo() {
 
 	printf("Tree size (iterative alg): %d\n", avltree_getSizeIt(tree));
 
+	// walk tree with a cursor, both ways
+	struct avltree_iter it;
+	int seek_key = 2;
+	printf("Cursor from '%d' up:", seek_key);
+	avltree_iter_seek(tree, &seek_key, &it);
+	for (void* e = avltree_iter_get(&it); e != NULL; e = avltree_iter_next(&it))
+		printf(" %d", *((int*)e));
+
+	printf("\nCursor from last down:");
+	avltree_iter_last(tree, &it);
+	for (void* e = avltree_iter_get(&it); e != NULL; e = avltree_iter_prev(&it))
+		printf(" %d", *((int*)e));
+
+	printf("\n");
+
 	avltree_destroy(tree);
 	printf("AVL tree destroyed successfully.\n\n");
 }
@@ -1785,7 +4689,7 @@ void bst_demo() {
 
 	// put '3' as root
 	struct binarytree* tree = bst_create(&intdata[2], compare, NULL,
-			printnode, copydata);
+			printnode, copydata, NULL);
 
 	printf("Binary search tree created successfully with root = '%d'\n", *((int*)(tree->root->data)));
 	printf("Tree size: %d\n\n", bst_getSizeIt(tree));
@@ -1942,7 +4846,7 @@ void binarytree_demo() {
 	int n = sizeof(intdata) / sizeof(intdata[0]);
 
 	struct binarytree* tree = binarytree_create(&intdata[0], compare, NULL,
-			printnode, copydata);
+			printnode, copydata, NULL);
 
 	printf("Binary tree created successfully with root = '%d'\n", *((int*)(tree->root->data)));
 
@@ -1958,15 +4862,15 @@ void binarytree_demo() {
 
 	// build tree
 	struct binarytreenode* root = tree->root;
-	struct binarytreenode* node1 = binarytree_createnode(&intdata[1]);
-	struct binarytreenode* node2 = binarytree_createnode(&intdata[2]);
-	struct binarytreenode* node3 = binarytree_createnode(&intdata[3]);
-	struct binarytreenode* node4 = binarytree_createnode(&intdata[4]);
-//	struct binarytreenode* node5 = binarytree_createnode(&intdata[5]);
-//	struct binarytreenode* node6 = binarytree_createnode(&intdata[6]);
+	struct binarytreenode* node1 = binarytree_createnode(tree, &intdata[1]);
+	struct binarytreenode* node2 = binarytree_createnode(tree, &intdata[2]);
+	struct binarytreenode* node3 = binarytree_createnode(tree, &intdata[3]);
+	struct binarytreenode* node4 = binarytree_createnode(tree, &intdata[4]);
+//	struct binarytreenode* node5 = binarytree_createnode(tree, &intdata[5]);
+//	struct binarytreenode* node6 = binarytree_createnode(tree, &intdata[6]);
 
-	struct binarytreenode* delnode3 = binarytree_createnode(&intdata[3]);
-	struct binarytreenode* delnode4 = binarytree_createnode(&intdata[4]);
+	struct binarytreenode* delnode3 = binarytree_createnode(tree, &intdata[3]);
+	struct binarytreenode* delnode4 = binarytree_createnode(tree, &intdata[4]);
 
 	root->left = node1;
 	root->right = node2;
@@ -2049,6 +4953,68 @@ void binarytree_demo() {
 	free(delnode4);
 }
 
+void binarytree_complete_demo() {
+	int compare(void* data, const void* key) {
+		int idata = *((int*)data), ikey = *((const int*)key);
+		return (idata > ikey) - (idata < ikey);
+	}
+
+	void printnode(struct binarytreenode* node) {
+		printf("%d ", *((int*)node->data));
+	}
+
+	void copydata(void* dest, const void* from) {
+		*((int*)dest) = *((const int*)from);
+	}
+
+	printf("___________\n");
+	printf("BINARY TREE (complete tree mode)\n");
+	printf("\nLevel ordered insert demo -----------\n");
+	printf("Nodes are kept in level order: insert links to node (count - 1) / 2, no traversal\n\n");
+
+	int n = 15;
+	int intdata[15];
+	for (int i = 0; i < n; ++i)
+		intdata[i] = i + 1;
+
+	struct binarytree* tree = binarytree_create_complete(&intdata[0], compare, NULL, printnode, copydata, NULL);
+	for (int i = 1; i < n; ++i)
+		tree->root = binarytree_insertnode_levelordered(tree, tree->root, &intdata[i]);
+
+	printf("Tree size: %d, height: %d\n", binarytree_getSizeIt(tree), binarytree_treeHeightLevelOrder(tree));
+	printf("Level order: ");
+	binarytree_levelorder(tree, printnode);
+	printf("\nInorder:     ");
+	binarytree_inorder(tree->root, printnode);
+	printf("\n");
+
+	// the deleted value is replaced by the last node in level order (15)
+	int key = 2;
+	printf("\nDelete node '%d'\n", key);
+	tree->root = binarytree_delete(tree, &key);
+	printf("Level order: ");
+	binarytree_levelorder(tree, printnode);
+	printf("\n");
+
+	// build time of a large tree (before, each insert walked the tree with a queue)
+	int big = 1000000;
+	int* bigdata = (int*)malloc(big * sizeof(int));
+	for (int i = 0; i < big; ++i)
+		bigdata[i] = i;
+
+	clock_t start = clock();
+	binarytree_clear(tree);
+	for (int i = 0; i < big; ++i)
+		tree->root = binarytree_insertnode_levelordered(tree, tree->root, &bigdata[i]);
+
+	printf( "\n%d level ordered inserts: %.3f s, tree height: %d\n", big,
+			(double)(clock() - start) / CLOCKS_PER_SEC, binarytree_treeDepth(tree->root) );
+
+	binarytree_destroy(tree);
+	free(bigdata);
+	printf("Binary tree (complete tree mode) destroyed successfully.\n\n");
+}
+
 /*
  * Linked list queue demo.
  * */
@@ -2113,6 +5079,118 @@ void linkedlistqueue_demo() {
 	printf("Linked list queue destroyed successfully.\n");
 }
 
+void ringqueue_demo() {
+
+	#define RINGQUEUE_DEMO_MESSAGES 200000
+	#define RINGQUEUE_DEMO_BATCH 32
+	#define RINGQUEUE_DEMO_THREADS 2
+
+	printf("_________\n");
+	printf("RING QUEUE (lock-free, bounded)\n");
+	printf("\nSPSC ring queue demo ------------\n");
+
+	struct ringqueue_spsc* spsc = ringqueue_spsc_create(1000);
+	printf("Capacity (1000 rounded up to a power of two): %zu\n", ringqueue_spsc_capacity(spsc));
+
+	// producer sends 1..n, batched; a full queue yields the processor
+	void* spsc_producer(void* arg) {
+		void* batch[RINGQUEUE_DEMO_BATCH];
+		long next = 1;
+		while (next <= RINGQUEUE_DEMO_MESSAGES) {
+			size_t n = 0;
+			while (n < RINGQUEUE_DEMO_BATCH && next + (long)n <= RINGQUEUE_DEMO_MESSAGES) {
+				batch[n] = (void*)(next + (long)n);
+				n++;
+			}
+
+			size_t sent = ringqueue_spsc_enqueue_batch(spsc, batch, n);
+			next += (long)sent;
+			if (sent == 0)
+				sched_yield();
+		}
+
+		return NULL;
+	}
+
+	pthread_t producer;
+	pthread_create(&producer, NULL, spsc_producer, NULL);
+
+	// consumer checks the order and sums the messages
+	long received = 0, sum = 0, inorder = 1;
+	void* batch[RINGQUEUE_DEMO_BATCH];
+	while (received < RINGQUEUE_DEMO_MESSAGES) {
+		size_t n = ringqueue_spsc_dequeue_batch(spsc, batch, RINGQUEUE_DEMO_BATCH);
+		for (size_t i = 0; i < n; ++i) {
+			inorder &= ((long)batch[i] == received + 1);
+			sum += (long)batch[i];
+			received++;
+		}
+
+		if (n == 0)
+			sched_yield();
+	}
+
+	pthread_join(producer, NULL);
+	printf("Messages received: %ld, in order: %s, sum: %ld\n", received, inorder ? "YES" : "NO", sum);
+	printf("Queue size at the end: %zu\n", ringqueue_spsc_size(spsc));
+	ringqueue_spsc_destroy(spsc);
+
+	printf("\nMPMC ring queue demo ------------\n");
+
+	struct ringqueue_mpmc* mpmc = ringqueue_mpmc_create(256);
+	static _Atomic long consumed = 0;
+	static _Atomic long total = 0;
+	int ids[RINGQUEUE_DEMO_THREADS];
+	pthread_t producers[RINGQUEUE_DEMO_THREADS], consumers[RINGQUEUE_DEMO_THREADS];
+
+	// producer 'id' sends messages id + 1, id + 1 + threads, ...
+	void* mpmc_producer(void* arg) {
+		int id = *((int*)arg);
+		for (long m = id + 1; m <= RINGQUEUE_DEMO_MESSAGES; m += RINGQUEUE_DEMO_THREADS)
+			while (!ringqueue_mpmc_enqueue(mpmc, (void*)m))
+				sched_yield();
+
+		return NULL;
+	}
+
+	void* mpmc_consumer(void* arg) {
+		void* batch[RINGQUEUE_DEMO_BATCH];
+		while (atomic_load(&consumed) < RINGQUEUE_DEMO_MESSAGES) {
+			size_t n = ringqueue_mpmc_dequeue_batch(mpmc, batch, RINGQUEUE_DEMO_BATCH);
+			long s = 0;
+			for (size_t i = 0; i < n; ++i)
+				s += (long)batch[i];
+
+			atomic_fetch_add(&total, s);
+			atomic_fetch_add(&consumed, (long)n);
+			if (n == 0)
+				sched_yield();
+		}
+
+		return NULL;
+	}
+
+	for (int t = 0; t < RINGQUEUE_DEMO_THREADS; ++t) {
+		ids[t] = t;
+		pthread_create(&producers[t], NULL, mpmc_producer, &ids[t]);
+		pthread_create(&consumers[t], NULL, mpmc_consumer, NULL);
+	}
+
+	for (int t = 0; t < RINGQUEUE_DEMO_THREADS; ++t) {
+		pthread_join(producers[t], NULL);
+		pthread_join(consumers[t], NULL);
+	}
+
+	printf("Producers: %d, consumers: %d\n", RINGQUEUE_DEMO_THREADS, RINGQUEUE_DEMO_THREADS);
+	printf("Messages received: %ld, sum: %ld (expected %ld)\n", atomic_load(&consumed),
+		   atomic_load(&total), (long)RINGQUEUE_DEMO_MESSAGES * (RINGQUEUE_DEMO_MESSAGES + 1) / 2);
+
+	void* x = NULL;
+	printf("Dequeue from empty queue: %s\n", ringqueue_mpmc_dequeue(mpmc, &x) ? "OK" : "EMPTY");
+	ringqueue_mpmc_destroy(mpmc);
+	printf("Ring queues destroyed successfully.\n");
+}
+
 /*
  * Linked list stack demo.
  * */
@@ -2186,16 +5264,16 @@ void arraylist_demo() {
 
 	struct arraylist* alist = arraylist_create_capacity(6);
 
-	printf("Capacity: %d\n", alist->capacity);
-	printf("Length: %d\n\n", alist->length);
+	printf("Capacity: %zu\n", alist->capacity);
+	printf("Length: %zu\n\n", alist->length);
 
 	for (int i = 0; i < n; ++i) {
 	    arraylist_add(alist, &intdata[i]);
 	    printf("Inserted value at end '%d':\n", intdata[i]);
 	}
 
-	printf("\nCapacity: %d\n", alist->capacity);
-	printf("Length: %d\n\n", alist->length);
+	printf("\nCapacity: %zu\n", alist->capacity);
+	printf("Length: %zu\n\n", alist->length);
 
 	// print array
 	printf("Print arraylist:\n");
@@ -2210,16 +5288,16 @@ void arraylist_demo() {
 	el = arraylist_remove_at(alist, alist->length-1);
 	if (el != NULL) printf("Item '%d' removed successfully!\n", *((int*)el));
 
-	printf("\nCapacity: %d\n", alist->capacity);
-	printf("Length: %d\n\n", alist->length);
+	printf("\nCapacity: %zu\n", alist->capacity);
+	printf("Length: %zu\n\n", alist->length);
 
 	printf("Shrink to fit.\n");
 	if (!arraylist_shrink_to_fit(alist))
 		printf("Failed to shrink array list!\n");
 	else
 	{
-		printf("Capacity: %d\n", alist->capacity);
-		printf("Length: %d\n", alist->length);
+		printf("Capacity: %zu\n", alist->capacity);
+		printf("Length: %zu\n", alist->length);
 	}
 
 	// print array
@@ -2227,10 +5305,143 @@ void arraylist_demo() {
 	print_arraylist(alist);
 	printf("\n");
 
+	// insert in the middle, then bulk append with one allocation
+	int middle = 10;
+	arraylist_insert(alist, 2, &middle);
+	void* more[3] = {&intdata[0], &intdata[1], &intdata[2]};
+	arraylist_reserve(alist, 32);
+	arraylist_add_all(alist, more, 3);
+	printf("\nInsert '%d' at 2, reserve 32 and append 3 items:\n", middle);
+	print_arraylist(alist);
+	printf("\nCapacity: %zu\n", alist->capacity);
+	printf("Length: %zu\n", alist->length);
+
+	// sort, then keep the list sorted
+	int compare(const void* a, const void* b) {
+		int v1 = *((const int*)a);
+		int v2 = *((const int*)b);
+		return (v1 > v2) - (v1 < v2);
+	}
+
+	arraylist_sort(alist, compare);
+	printf("\nSorted arraylist:\n");
+	print_arraylist(alist);
+
+	int sorted_value = 7;
+	arraylist_insert_sorted(alist, &sorted_value, compare);
+	printf("\nInsert '%d' sorted:\n", sorted_value);
+	print_arraylist(alist);
+
+	int keys[2] = {5, 8};
+	for (int i = 0; i < 2; ++i) {
+		size_t pos;
+		void* found = arraylist_find_sorted(alist, &keys[i], compare, &pos);
+		printf("\nFind sorted '%d': %s (position %zu)", keys[i], found ? "FOUND" : "NOT FOUND", pos);
+	}
+
+	printf("\n");
 	arraylist_destroy(alist);
+
+	// parallel sort of a large list (one thread per processor)
+	size_t nbig = 1000000;
+	int* values = (int*)malloc(nbig * sizeof(int));
+	struct arraylist* big = arraylist_create_capacity(nbig);
+	for (size_t i = 0; i < nbig; ++i) {
+		values[i] = (int)((i * 2654435761u) % 1000003);
+		arraylist_add(big, &values[i]);
+	}
+
+	arraylist_sort_parallel(big, compare, 0);
+	int ordered = 1;
+	for (size_t i = 1; i < big->length; ++i)
+		if (compare(big->buffer[i - 1], big->buffer[i]) > 0)
+			ordered = 0;
+
+	printf("\nParallel sort of %zu elements: %s (first %d, last %d)\n", big->length,
+		   ordered ? "sorted" : "NOT SORTED", *((int*)big->buffer[0]),
+		   *((int*)big->buffer[big->length - 1]));
+	arraylist_destroy(big);
+	free(values);
 	printf("\nArraylist destroyed successfully.\n");
 }
 
+void gaplist_demo() {
+
+	void print_gaplist(struct gaplist* g) {
+		for (size_t i = 0; i < gaplist_getsize(g); ++i)
+			printf("%c", *((char*)gaplist_get_item_at(g, i)));
+	}
+
+	printf("___________\n");
+	printf("GAPLIST\n");
+	printf("Gap list demo ------------\n");
+
+	// text edited on the stack, no allocation up to GAPLIST_INLINE_CAPACITY chars
+	static char text[] = "hello world";
+	static char edit[] = "big ";
+	struct gaplist g;
+	gaplist_init(&g);
+	for (size_t i = 0; i < strlen(text); ++i)
+		gaplist_add(&g, text + i);
+
+	printf("Text: \"");
+	print_gaplist(&g);
+	printf("\" (%zu chars)\n", gaplist_getsize(&g));
+
+	// typing at the cursor: consecutive inserts only fill the gap
+	for (size_t i = 0; i < strlen(edit); ++i)
+		gaplist_insert(&g, 6 + i, edit + i);
+
+	printf("Insert \"big \" at 6: \"");
+	print_gaplist(&g);
+	printf("\"\n");
+
+	// backspace twice at the end of "hello" (cursor at 5)
+	gaplist_remove_at(&g, 4);
+	gaplist_remove_at(&g, 3);
+	printf("Remove 2 chars before 5: \"");
+	print_gaplist(&g);
+	printf("\"\n");
+
+	// grow past the inline buffer
+	for (int i = 0; i < 3; ++i)
+		for (size_t j = 0; j < strlen(edit); ++j)
+			gaplist_insert(&g, 4 + i * strlen(edit) + j, edit + j);
+
+	printf("Insert 3 more \"big \" at 4: \"");
+	print_gaplist(&g);
+	printf("\" (capacity %zu)\n", g.capacity);
+	gaplist_release(&g);
+
+	// clustered inserts in the middle: gaplist against arraylist
+	const size_t n = 50000;
+	static int value = 0;
+	struct gaplist* gl = gaplist_create();
+	struct arraylist* al = arraylist_create();
+	for (size_t i = 0; i < 1000; ++i) {
+		gaplist_add(gl, &value);
+		arraylist_add(al, &value);
+	}
+
+	clock_t begin = clock();
+	for (size_t i = 0; i < n; ++i)
+		gaplist_insert(gl, 500 + i, &value);
+	double gtime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+	begin = clock();
+	for (size_t i = 0; i < n; ++i)
+		arraylist_insert(al, 500 + i, &value);
+	double atime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+	printf("%zu clustered middle inserts: gaplist %zu elements, arraylist %zu elements\n",
+		   n, gaplist_getsize(gl), al->length);
+	printf("Gap list faster than array list: %s\n", (gtime <= atime) ? "yes" : "no");
+
+	gaplist_destroy(gl);
+	arraylist_destroy(al);
+	printf("Gap list destroyed successfully.\n");
+}
+
 /*
  * Binary search demo.
  * */
@@ -2278,7 +5489,7 @@ void binarysearch_demo() {
 
 	for (int i = 0; i < nvals; ++i) {
 		printf("\nSearch position of '%d':", svalues[i]);
-		int pos = binarySearch(data, 0, n, &svalues[i], compare);
+		int pos = binarySearch(data, 0, n - 1, &svalues[i], compare);
 
 		if (pos < 0)
 			printf(" Element not found!");
@@ -2286,7 +5497,80 @@ void binarysearch_demo() {
 			printf(" Position %d", pos);
 	}
 
-	printf("\n\n----------------\n");
+	printf("\n\nTyped search kernels (int32_t) -----------\n");
+	int32_t ids[40];
+	for (int i = 0; i < 40; ++i)
+		ids[i] = i * 5 - (i % 3);		// sorted ids, some gaps
+
+	int32_t needles[4] = {-3, 60, 62, 500};
+	size_t lower[4];
+	binarysearch_lower_bound_batch_i32(ids, 40, needles, 4, lower);
+	for (int i = 0; i < 4; ++i)
+		printf("Id %d: lower bound %zu, upper bound %zu (batch lower bound %zu)\n", needles[i],
+			   binarysearch_lower_bound_i32(ids, 40, needles[i]),
+			   binarysearch_upper_bound_i32(ids, 40, needles[i]), lower[i]);
+
+	// Eytzinger layout: slots 1..n, ranks map a slot to its sorted position
+	int32_t* eyt = (int32_t*)aligned_alloc(64, 64 * ((41 * sizeof(int32_t) + 63) / 64));
+	size_t ranks[41];
+	binarysearch_eytzinger_build_i32(ids, 40, eyt, ranks);
+	printf("Eytzinger layout (first 8 slots):");
+	for (int k = 1; k <= 8; ++k)
+		printf(" %d", eyt[k]);
+
+	printf("\n");
+	for (int i = 0; i < 4; ++i) {
+		size_t k = binarysearch_eytzinger_lower_bound_i32(eyt, 40, needles[i]);
+		if (k == 0)
+			printf("Eytzinger search %d: no element not lesser\n", needles[i]);
+		else
+			printf("Eytzinger search %d: slot %zu, value %d, sorted position %zu\n", needles[i],
+				   k, eyt[k], ranks[k]);
+	}
+
+	free(eyt);
+	printf("\n----------------\n");
+}
+
+/*
+ * Sorted array algorithms demo.
+ * */
+void sortedarray_demo() {
+	printf("___________\n");
+	printf("SORTED ARRAY SET OPERATIONS\n");
+	printf("\nSorted array demo -----------\n\n");
+
+	// posting lists: documents containing each term
+	int32_t term1[12] = {2, 5, 8, 13, 21, 34, 55, 89, 144, 233, 377, 610};
+	int32_t term2[8] = {1, 5, 13, 20, 34, 100, 377, 600};
+	int32_t out[20];
+
+	void print_list(const char* name, const int32_t* list, size_t n) {
+		printf("%s:", name);
+		for (size_t i = 0; i < n; ++i)
+			printf(" %d", list[i]);
+		printf("\n");
+	}
+
+	print_list("Term 1", term1, 12);
+	print_list("Term 2", term2, 8);
+	print_list("Intersection", out, sortedarray_intersect_i32(term1, 12, term2, 8, out));
+	print_list("Union", out, sortedarray_union_i32(term1, 12, term2, 8, out));
+	print_list("Term 1 not term 2", out, sortedarray_difference_i32(term1, 12, term2, 8, out));
+
+	// a rare term against a long list: galloping instead of merging
+	int32_t* frequent = (int32_t*)malloc(10000 * sizeof(int32_t));
+	for (int i = 0; i < 10000; ++i)
+		frequent[i] = i * 3;
+
+	int32_t rare[4] = {9, 1000, 15000, 29997};
+	print_list("Rare term in frequent term (galloped)", out,
+			   sortedarray_intersect_i32(rare, 4, frequent, 10000, out));
+	printf("Gallop from position 100 to first >= 1000: %zu\n",
+		   sortedarray_gallop_i32(frequent, 10000, 100, 1000));
+	free(frequent);
+
+	printf("\n----------------\n");
 }
 
 /*
@@ -2549,7 +5833,7 @@ void singlelinklist_demo() {
 
 	if (rnode != NULL) {
 		printf("Node removed successfully\n");
-		free(rnode);
+		linkedlist_freenode(list, rnode);
 	}
 
 	printf("\nPrint list:\n");
@@ -2564,6 +5848,221 @@ void singlelinklist_demo() {
 	// free resources
 	linkedlist_destroy(list);
 	printf("\nLinked list destroyed successfully.\n");
+
+	printf("\nPooled linked lists demo -----------\n\n");
+
+	// two lists sharing one node pool (slabs of 4 nodes)
+	struct linkedlist_nodepool* pool = linkedlist_nodepool_create(4);
+	struct linkedlist* list1 = linkedlist_create_pooled(isequal, NULL, pool);
+	struct linkedlist* list2 = linkedlist_create_pooled(isequal, NULL, pool);
+
+	for(int i = 0; i != n; ++i) {
+		linkedlist_append(list1, &data[i]);
+		linkedlist_push(list2, &data[i]);
+	}
+
+	printf("List 1: ");
+	print_list(list1);
+	printf("List 2: ");
+	print_list(list2);
+	printf("Pool slabs: %zu\n", pool->nslabs);
+
+	// nodes of list 1 go back to the pool and are reused by list 2
+	linkedlist_destroy(list1);
+	for(int i = 0; i != n; ++i)
+		linkedlist_append(list2, &data[i]);
+
+	printf("List 2: ");
+	print_list(list2);
+	printf("Pool slabs after reuse: %zu\n", pool->nslabs);
+
+	linkedlist_destroy(list2);
+	linkedlist_nodepool_destroy(pool);
+	printf("\nPooled lists destroyed successfully.\n");
+}
+
+void unrolledlist_demo() {
+
+	int isequal(const void* a, const void* b) {
+		return *((int*)a) == *((int*)b);
+	}
+
+	void print_unrolledlist(struct unrolledlist* list) {
+		struct unrolledlist_iter it;
+		for (void* x = unrolledlist_iter_first(list, &it); it.node != NULL; x = unrolledlist_iter_next(&it))
+			printf("%d ", *((int*)x));
+	}
+
+	printf("___________\n");
+	printf("UNROLLED LINKED LIST\n");
+	printf("Unrolled linked list demo ------------\n");
+	printf("Node capacity: %d elements\n\n", UNROLLEDLIST_NODE_CAPACITY);
+
+	static int values[100000];
+	for (int i = 0; i < 100000; ++i)
+		values[i] = i;
+
+	struct unrolledlist* list = unrolledlist_create(isequal, NULL);
+	for (int i = 5; i < 10; ++i)
+		unrolledlist_append(list, &values[i]);
+	for (int i = 4; i >= 0; --i)
+		unrolledlist_push(list, &values[i]);
+
+	printf("List: ");
+	print_unrolledlist(list);
+	printf("\n");
+
+	struct unrolledlist_pos pos;
+	if (unrolledlist_find(list, &values[7], &pos)) {
+		unrolledlist_insert_after(list, &pos, &values[70]);
+		unrolledlist_insert_after(list, &pos, &values[71]);
+	}
+
+	unrolledlist_insert_at(list, 0, &values[99]);
+	printf("Insert 70 and 71 after 7, 99 at 0: ");
+	print_unrolledlist(list);
+	printf("\n");
+
+	unrolledlist_remove(list, &values[3]);
+	unrolledlist_remove_first(list);
+	printf("Remove 3 and first element: ");
+	print_unrolledlist(list);
+	printf("\nElement at 5: %d, size: %zu\n\n", *((int*)unrolledlist_getdata_at(list, 5)),
+		   unrolledlist_getsize(list));
+	unrolledlist_destroy(list);
+
+	// large list: the same scan over a linked list and an unrolled list
+	int n = 100000;
+	list = unrolledlist_create(isequal, NULL);
+	struct linkedlist* linked = linkedlist_create(isequal, NULL);
+	for (int i = 0; i < n; ++i) {
+		unrolledlist_append(list, &values[i]);
+		linkedlist_append(linked, &values[i]);
+	}
+
+	printf("%d elements: %zu unrolled nodes (%zu bytes) instead of %d list nodes (%zu bytes)\n",
+		   n, list->nodes, list->nodes * sizeof(struct unrolledlistnode), n,
+		   n * sizeof(struct linkedlistnode));
+
+	long sum1 = 0, sum2 = 0;
+	struct unrolledlist_iter it;
+	for (void* x = unrolledlist_iter_first(list, &it); it.node != NULL; x = unrolledlist_iter_next(&it))
+		sum1 += *((int*)x);
+	for (struct linkedlistnode* node = linkedlist_getfirst(linked); node != NULL; node = node->next)
+		sum2 += *((int*)node->data);
+
+	printf("Scan sums: unrolled %ld, linked %ld\n", sum1, sum2);
+	printf("Element at %d: %d\n", n / 2 + 17, *((int*)unrolledlist_getdata_at(list, n / 2 + 17)));
+
+	linkedlist_destroy(linked);
+	unrolledlist_destroy(list);
+	printf("Unrolled linked list destroyed successfully.\n");
+}
+
+void intrusive_demo() {
+
+	// one object in three containers: an LRU list, a hash index and an ordered tree
+	struct entry {
+		int id;
+		int score;
+		struct ilist_node lru;
+		struct ihash_node byid;
+		struct irbtree_node byscore;
+	};
+
+	int comparescore(const struct irbtree_node* a, const struct irbtree_node* b) {
+		const struct entry* x = INTRUSIVE_CONTAINER_OF(a, struct entry, byscore);
+		const struct entry* y = INTRUSIVE_CONTAINER_OF(b, struct entry, byscore);
+		if (x->score != y->score)
+			return (x->score < y->score) ? -1 : 1;
+		return (x->id > y->id) - (x->id < y->id);
+	}
+
+	int isid(const void* key, const struct ihash_node* node) {
+		return INTRUSIVE_CONTAINER_OF(node, struct entry, byid)->id == *((const int*)key);
+	}
+
+	uint64_t hashid(int id) {
+		return (uint64_t)id * 0x9E3779B97F4A7C15ULL;
+	}
+
+	void print_lru(struct ilist* list) {
+		for (struct ilist_node* n = ilist_first(list); n != NULL; n = ilist_next(list, n))
+			printf("%d ", INTRUSIVE_CONTAINER_OF(n, struct entry, lru)->id);
+	}
+
+	void print_byscore(struct irbtree* tree) {
+		for (struct irbtree_node* n = irbtree_first(tree); n != NULL; n = irbtree_next(n)) {
+			struct entry* e = INTRUSIVE_CONTAINER_OF(n, struct entry, byscore);
+			printf("%d(%d) ", e->id, e->score);
+		}
+	}
+
+	printf("___________\n");
+	printf("INTRUSIVE CONTAINERS\n");
+	printf("Intrusive list, red-black tree and hash table demo ------------\n\n");
+
+	// entries come from one array: linking them allocates nothing
+	struct entry entries[8];
+	int scores[8] = { 50, 20, 80, 10, 70, 30, 60, 40 };
+
+	struct ilist lru;
+	struct ihash index;
+	struct irbtree ranking;
+	ilist_init(&lru);
+	irbtree_init(&ranking, comparescore);
+	if (!ihash_init(&index, IHASH_DEFAULT_BUCKETS)) {
+		printf("Error: failed to create intrusive hash table!\n");
+		return;
+	}
+
+	for (int i = 0; i < 8; ++i) {
+		entries[i].id = 100 + i;
+		entries[i].score = scores[i];
+		ilist_push_front(&lru, &entries[i].lru);
+		ihash_insert(&index, &entries[i].byid, hashid(entries[i].id));
+		irbtree_insert(&ranking, &entries[i].byscore);
+	}
+
+	printf("LRU order (most recent first): ");
+	print_lru(&lru);
+	printf("\nBy score: ");
+	print_byscore(&ranking);
+	printf("\n\n");
+
+	// lookups by id touch the entry: O(1) move to the LRU front
+	int touched[3] = { 101, 105, 100 };
+	for (int i = 0; i < 3; ++i) {
+		struct ihash_node* node = ihash_find(&index, &touched[i], hashid(touched[i]), isid);
+		if (node != NULL)
+			ilist_move_front(&lru, &INTRUSIVE_CONTAINER_OF(node, struct entry, byid)->lru);
+	}
+
+	printf("Touch 101, 105, 100. LRU order: ");
+	print_lru(&lru);
+	printf("\n");
+
+	// evict the two least recent entries from every container
+	for (int i = 0; i < 2; ++i) {
+		struct ilist_node* node = ilist_pop_back(&lru);
+		struct entry* e = INTRUSIVE_CONTAINER_OF(node, struct entry, lru);
+		ihash_remove(&index, &e->byid);
+		irbtree_remove(&ranking, &e->byscore);
+		printf("Evict %d\n", e->id);
+	}
+
+	printf("LRU order: ");
+	print_lru(&lru);
+	printf("\nBy score: ");
+	print_byscore(&ranking);
+	printf("\nSizes: list %zu, hash %zu, tree %zu\n", lru.size, index.count, ranking.size);
+
+	int missing = 103;
+	printf("Find %d: %s\n", missing,
+		   ihash_find(&index, &missing, hashid(missing), isid) != NULL ? "found" : "not found");
+
+	ihash_release(&index);
+	printf("Intrusive containers released successfully (entries untouched).\n");
 }
 
 /*
@@ -2646,8 +6145,14 @@ int main() {
 	printf("\n");
 	arraylist_demo();
 	printf("\n\n");
+	gaplist_demo();
+	printf("\n\n");
 	singlelinklist_demo();
 	printf("\n\n");
+	unrolledlist_demo();
+	printf("\n\n");
+	intrusive_demo();
+	printf("\n\n");
 	circsinglelinklist_demo();
 	printf("\n\n");
 	doublelinklist_demo();
@@ -2656,16 +6161,50 @@ int main() {
 	printf("\n\n");
 	hashtable_lp_demo();
 	printf("\n\n");
+	hashtable_lp_inline_demo();
+	printf("\n\n");
+	hashtable_lp_robinhood_demo();
+	printf("\n\n");
+	hashtable_lp_lockfree_demo();
+	printf("\n\n");
+	hashtable_simd_demo();
+	printf("\n\n");
+	hashtable_concurrent_demo();
+	printf("\n\n");
+	numa_demo();
+	printf("\n\n");
+	streamagg_demo();
+	printf("\n\n");
+	lrucache_demo();
+	printf("\n\n");
+	strintern_demo();
+	printf("\n\n");
 	hashtable_linked_list_demo();
 	printf("\n\n");
+	hashtable_incremental_demo();
+	printf("\n\n");
+	hashtable_iter_demo();
+	printf("\n\n");
+	snapshot_demo();
+	printf("\n\n");
+	hashtable_hash64_demo();
+	printf("\n\n");
+	datastats_demo();
+	printf("\n\n");
 	binarysearch_demo();
 	printf("\n\n");
+	sortedarray_demo();
+	printf("\n\n");
 	linkedliststack_demo();
 	printf("\n\n");
 	linkedlistqueue_demo();
 	printf("\n\n");
+	ringqueue_demo();
+	printf("\n\n");
 	binarytree_demo();
 	printf("\n\n");
+	binarytree_complete_demo();
+	printf("\n\n");
 	bst_demo();
 	printf("\n\n");
 	avltree_demo();
@@ -2680,17 +6219,45 @@ int main() {
 	printf("\n\n");
 	hashset_demo();
 	printf("\n\n");
+	membershipfilters_demo();
+	printf("\n\n");
+	bitset_demo();
+	printf("\n\n");
 	rbtree_demo();
 	printf("\n\n");
+	prbtree_demo();
+	printf("\n\n");
 	treeset_demo();
 	printf("\n\n");
+	treeset_parallel_demo();
+	printf("\n\n");
+	skiplist_demo();
+	printf("\n\n");
+	typedcontainers_demo();
+	printf("\n\n");
 	adjlgraph_demo();
 	printf("\n\n");
+	csrgraph_demo();
+	printf("\n\n");
+	mstalg_demo();
+	printf("\n\n");
+	allocator_demo();
+	printf("\n\n");
+	pqueue_benchmark_demo();
+	printf("\n\n");
 	trie_demo();
 	printf("\n\n");
 	trie_extensions_demo();
 	printf("\n\n");
+	radixtrie_demo();
+	printf("\n\n");
+	statictrie_demo();
+	printf("\n\n");
+	art_demo();
+	printf("\n\n");
 	dfsalg_demo();
+	printf("\n\n");
+	taskpool_demo();
 	printf("\n");
 	return EXIT_SUCCESS;
 }
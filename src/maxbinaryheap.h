@@ -182,6 +182,8 @@
 
 	/*
 	 * Function to create a min heap.
+	 * Elements of 'datalist' are loaded and heapified bottom-up in O(n) (Floyd).
+	 * Note: 'capacity' is the initial size of the array, it grows on demand.
 	 */
 	struct heap* maxbinaryheap_createHeap(int capacity, void** datalist,
 										int listsize,
@@ -233,6 +235,36 @@
 	  */
 	 void maxbinaryheap_delete(struct heap* h, int i);
 
+	 /*
+	  * Inserts 'n' elements in the heap with a single growth of the array.
+	  * When the batch is not smaller than the heap, elements are appended and the heap is
+	  * rebuilt bottom-up in O(size + n), otherwise each one is sifted up in O(log N).
+	  */
+	 void maxbinaryheap_insert_batch(struct heap* h, void** datalist, int n);
+
+	 /*
+	  * Removes up to 'k' priority elements from the heap into array 'out' (in descending
+	  * order), in O(k log N).
+	  * Returns the number of elements removed (lesser than 'k' if heap has less elements).
+	  */
+	 int maxbinaryheap_extract_batch(struct heap* h, int k, void** out);
+
+	 /*
+	  * Bounded top-k mode: inserts an element keeping at most 'k' elements in the heap,
+	  * the 'k' smallest ones seen so far (root is the greatest of them and the one to drop).
+	  * When heap is full, the new element replaces the root only if it is lesser,
+	  * in O(log k), so a stream of n elements is reduced in O(n log k) with O(k) memory.
+	  * Returns the element that did not stay in the heap (the new one or the replaced
+	  * root, to be released by the caller), or NULL if no element was dropped.
+	  */
+	 void* maxbinaryheap_insert_topk(struct heap* h, void* data, int k);
+
+	 /*
+	  * Takes a statistics snapshot of the heap: size, capacity, height and the sift
+	  * counters, if compiled in (see datastats_heap_metrics).
+	  * */
+	 void maxbinaryheap_stats(const struct heap* h, struct datastats_heap* stats);
+
 	 /*
 	  * Prints the heap elements (equivalent to level order traversal in a binary tree).
 	  * */
@@ -9,6 +9,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <limits.h>
 #include "heapstruct.h"
 
 /*
@@ -47,29 +48,83 @@ void minbinaryheap_swap(struct heap* h, int i, int j)
 //}
 
 /*
- * A recursive method to heapify a subtree with the root at given index
+ * Counts a sift that moved an element from index 'from' to index 'to' (levels moved
+ * are the difference of the depths, floor(log2(i + 1))).
+ * Note: Private function.
+ */
+void minbinaryheap_count_sift(struct datastats_histogram* depth, size_t* count, int from, int to)
+{
+	int levels = (31 - __builtin_clz((unsigned)from + 1)) - (31 - __builtin_clz((unsigned)to + 1));
+	datastats_histogram_add(depth, (size_t)((levels < 0) ? -levels : levels));
+	(*count)++;
+}
+
+/*
+ * Method to heapify a subtree with the root at given index (sift down).
  * This method assumes that the subtrees are already heapified.
+ * Note: iterative, the element at 'i' only moves once to its final position.
  */
 void minbinaryheap_heapify(struct heap* h, int i)
 {
-    int l = minbinaryheap_left(i);
-    int r = minbinaryheap_right(i);
-    int smallest = i;
-    if (l < h->size && (h->compare(h->arr[l], h->arr[i]) < 0))
-        smallest = l;
-    if (r < h->size && (h->compare(h->arr[r], h->arr[smallest]) < 0))
-        smallest = r;
-    if (smallest != i)
-    {
-    	minbinaryheap_swap(h, i, smallest);
+	void* data = h->arr[i];
+	int half = h->size / 2;		// nodes with at least one child
+	DATASTATS_ONLY(int start = i;)
 
-//    	minbinaryheap_swap(h->arr[i], h->arr[smallest]);
-        minbinaryheap_heapify(h, smallest);
-    }
+	while (i < half) {
+		int child = minbinaryheap_left(i);
+		int r = child + 1;
+		if (r < h->size && (h->compare(h->arr[r], h->arr[child]) < 0))
+			child = r;
+
+		if (h->compare(h->arr[child], data) >= 0)
+			break;
+
+		h->arr[i] = h->arr[child];
+		i = child;
+	}
+
+	h->arr[i] = data;
+	DATASTATS_ONLY(minbinaryheap_count_sift(&(h->sift.downdepth), &(h->sift.downs), start, i);)
+}
+
+/*
+ * Grows heap array to hold at least 'mincapacity' elements (capacity is doubled).
+ */
+void minbinaryheap_grow(struct heap* h, int mincapacity)
+{
+	if (mincapacity <= h->capacity)
+		return;
+
+	int capacity = (h->capacity > 0) ? h->capacity : 1;
+	while (capacity < mincapacity)
+		capacity = (capacity > INT_MAX / 2) ? mincapacity : capacity * 2;
+
+	void** arr = (void**)realloc(h->arr, capacity * sizeof(void*));
+	if (arr == NULL) {
+		printf("Memory error growing heap array of data.");
+		abort();
+	}
+
+	h->arr = arr;
+	h->capacity = capacity;
+}
+
+/*
+ * Builds the heap property over all elements of the array, bottom-up (Floyd).
+ * Sifts down every node with children from the last one to the root, in O(n):
+ * half of the nodes are leaves and are not moved, a node at height k moves at most
+ * k levels, so the total work is bounded by 2n moves.
+ */
+void minbinaryheap_build(struct heap* h)
+{
+	for (int i = h->size / 2 - 1; i >= 0; i--)
+		minbinaryheap_heapify(h, i);
 }
 
 /*
  * Function to create a min heap.
+ * Elements of 'datalist' are loaded and heapified bottom-up in O(n) (Floyd).
+ * Note: 'capacity' is the initial size of the array, it grows on demand.
  */
 struct heap* minbinaryheap_createHeap(int capacity, void** datalist, int listsize,
 										void* minlimit,
@@ -81,6 +136,10 @@ struct heap* minbinaryheap_createHeap(int capacity, void** datalist, int listsiz
 										heap_printdata printdatafunc,
 										heap_freedata freedatafunc)
 {
+    // Capacity is only the initial size of the array (it grows on demand)
+    if (capacity < listsize) capacity = listsize;
+    if (capacity < 1) capacity = 1;
+
     // Allocating memory to heap h
 	int arrsize = capacity * sizeof(void*);
     struct heap* h = (struct heap*)malloc(sizeof(struct heap));
@@ -101,6 +160,7 @@ struct heap* minbinaryheap_createHeap(int capacity, void** datalist, int listsiz
 //    *(h->MINVALUE) = minlimit;
     h->printdata = printdatafunc;
     h->freedata = freedatafunc;
+    h->sift = (struct datastats_sift){ 0 };
 
     // Allocating memory to array
     h->arr = (void*)malloc(arrsize);
@@ -121,11 +181,7 @@ struct heap* minbinaryheap_createHeap(int capacity, void** datalist, int listsiz
     }
 
     h->size = i;
-    i = (h->size - 2) / 2;
-    while (i >= 0) {
-        minbinaryheap_heapify(h, i);
-        i--;
-    }
+    minbinaryheap_build(h);
     return h;
 }
 
@@ -138,10 +194,7 @@ struct heap* minbinaryheap_createHeap(int capacity, void** datalist, int listsiz
 void minbinaryheap_insert(struct heap* h, void* data)
 {
     if (h->size == h->capacity)
-    {
-        printf("\nOverflow: Could not insert value\n");
-        return;
-    }
+    	minbinaryheap_grow(h, h->size + 1);
 
     // First insert the new key at the end
     h->size++;
@@ -149,11 +202,13 @@ void minbinaryheap_insert(struct heap* h, void* data)
     h->arr[i] = data;
 
     // Fix the min heap property if it is violated
+    DATASTATS_ONLY(int start = i;)
     while (i != 0 && (h->compare(h->arr[minbinaryheap_parent(i)], h->arr[i]) > 0))
     {
     	minbinaryheap_swap(h, i, minbinaryheap_parent(i));
     	i = minbinaryheap_parent(i);
     }
+    DATASTATS_ONLY(minbinaryheap_count_sift(&(h->sift.updepth), &(h->sift.ups), start, i);)
 }
 
 /*
@@ -197,11 +252,13 @@ void* minbinaryheap_peek(struct heap* h) { return h->arr[0]; }
 void minbinaryheap_decreasekey(struct heap* h, int i, void* new_val)
 {
 	 h->arr[i] = new_val;
+	 DATASTATS_ONLY(int start = i;)
 	 while (i != 0 && (h->compare(h->arr[minbinaryheap_parent(i)], h->arr[i]) > 0))
 	 {
 		 minbinaryheap_swap(h, i, minbinaryheap_parent(i));
 		 i = minbinaryheap_parent(i);
 	 }
+	 DATASTATS_ONLY(minbinaryheap_count_sift(&(h->sift.updepth), &(h->sift.ups), start, i);)
 }
 
 /*
@@ -217,6 +274,81 @@ void minbinaryheap_delete(struct heap* h, int i)
 	minbinaryheap_extract(h);
 }
 
+/*
+ * Inserts 'n' elements in the heap with a single growth of the array.
+ * When the batch is not smaller than the heap, elements are appended and the heap is
+ * rebuilt bottom-up in O(size + n), otherwise each one is sifted up in O(log N).
+ */
+void minbinaryheap_insert_batch(struct heap* h, void** datalist, int n)
+{
+	if (n <= 0)
+		return;
+
+	minbinaryheap_grow(h, h->size + n);
+	if (n < h->size) {
+		for (int i = 0; i < n; i++)
+			minbinaryheap_insert(h, datalist[i]);
+	}
+	else {
+		for (int i = 0; i < n; i++)
+			h->arr[h->size++] = datalist[i];
+
+		minbinaryheap_build(h);
+	}
+}
+
+/*
+ * Removes up to 'k' priority elements from the heap into array 'out' (in ascending
+ * order), in O(k log N).
+ * Returns the number of elements removed (lesser than 'k' if heap has less elements).
+ */
+int minbinaryheap_extract_batch(struct heap* h, int k, void** out)
+{
+	int count = 0;
+	while (count < k && h->size > 0)
+		out[count++] = minbinaryheap_extract(h);
+
+	return count;
+}
+
+/*
+ * Bounded top-k mode: inserts an element keeping at most 'k' elements in the heap,
+ * the 'k' greatest ones seen so far (root is the smallest of them and the one to drop).
+ * When heap is full, the new element replaces the root only if it is greater,
+ * in O(log k), so a stream of n elements is reduced in O(n log k) with O(k) memory.
+ * Returns the element that did not stay in the heap (the new one or the replaced
+ * root, to be released by the caller), or NULL if no element was dropped.
+ */
+void* minbinaryheap_insert_topk(struct heap* h, void* data, int k)
+{
+	if (h->size < k) {
+		minbinaryheap_insert(h, data);
+		return NULL;
+	}
+
+	if (k <= 0 || h->compare(data, h->arr[0]) <= 0)
+		return data;
+
+	void* dropped = h->arr[0];
+	h->arr[0] = data;
+	minbinaryheap_heapify(h, 0);
+	return dropped;
+}
+
+/*
+ * Takes a statistics snapshot of the heap: size, capacity, height and the sift
+ * counters, if compiled in (see datastats_heap_metrics).
+ * */
+void minbinaryheap_stats(const struct heap* h, struct datastats_heap* stats)
+{
+	*stats = (struct datastats_heap){ 0 };
+	stats->size = (size_t)h->size;
+	stats->capacity = (size_t)h->capacity;
+	stats->height = (h->size > 0) ? 32 - __builtin_clz((unsigned)h->size) : 0;
+	stats->countersenabled = DATASTATS_ENABLED;
+	stats->sift = h->sift;
+}
+
 /*
  * Prints the heap elements (equivalent to level order traversal in a binary tree).
  * */
@@ -0,0 +1,394 @@
+/*
+ * mstalg.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Minimum spanning tree algorithms: Kruskal with a radix sorted flat
+ * 				edge array and union-find, eager Prim with an indexed 4-ary heap.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "mstalg.h"
+#include "unionfind.h"
+#include "indmindblheap.h"
+
+#define MSTALG_SIGNBIT ((uint64_t)1 << 63)
+#define MSTALG_RADIX 256				// values of a sort digit (one byte)
+
+// edge record of Kruskal sort (16 bytes)
+struct mstalg_edge {
+	uint64_t key;		// weight mapped to an unsigned key of the same order
+	int from;
+	int to;
+};
+
+/*
+ * Maps a weight to an unsigned key with the same order (negative weights have their
+ * bits flipped, positive ones their sign bit set), and back.
+ * Note: Private functions.
+ */
+uint64_t mstalg_weight_key(double weight)
+{
+	uint64_t bits;
+	memcpy(&bits, &weight, sizeof(bits));
+	return (bits & MSTALG_SIGNBIT) ? ~bits : (bits | MSTALG_SIGNBIT);
+}
+
+double mstalg_key_weight(uint64_t key)
+{
+	uint64_t bits = (key & MSTALG_SIGNBIT) ? (key & ~MSTALG_SIGNBIT) : ~key;
+	double weight;
+	memcpy(&weight, &bits, sizeof(weight));
+	return weight;
+}
+
+/*
+ * Allocates an array of 'count' Kruskal edge records.
+ * Note: Private function.
+ */
+struct mstalg_edge* mstalg_edges_alloc(size_t count)
+{
+	struct mstalg_edge* edges = (struct mstalg_edge*)malloc(((count > 0) ? count : 1) * sizeof(struct mstalg_edge));
+	if (edges == NULL) {
+		printf("Memory error: failed to allocate memory for spanning tree edges!");
+		abort();
+	}
+
+	return edges;
+}
+
+/*
+ * Allocates the result of a spanning forest of 'numvertices' vertices (at most
+ * numvertices - 1 edges).
+ * Note: Private function.
+ */
+struct adjlgraph_edgeitem* mstalg_result_alloc(size_t numvertices)
+{
+	struct adjlgraph_edgeitem* result = (struct adjlgraph_edgeitem*)malloc(
+			((numvertices > 1) ? numvertices - 1 : 1) * sizeof(struct adjlgraph_edgeitem) );
+	if (result == NULL) {
+		printf("Memory error: failed to allocate memory for spanning tree!");
+		abort();
+	}
+
+	return result;
+}
+
+/*
+ * Sorts edge records by key with a stable least significant digit radix sort, one
+ * byte per pass. Byte counts of all passes are taken in a single read of the records
+ * and passes where every key has the same byte are skipped.
+ * Returns the sorted array ('edges' or 'tmp').
+ * Note: Private function.
+ */
+struct mstalg_edge* mstalg_radixsort(struct mstalg_edge* edges, struct mstalg_edge* tmp, size_t count)
+{
+	static const int passes = (int)sizeof(uint64_t);
+	size_t (*counts)[MSTALG_RADIX] = calloc(passes, sizeof(*counts));
+	if (counts == NULL) {
+		printf("Memory error: failed to allocate memory for spanning tree sort!");
+		abort();
+	}
+
+	for (size_t i = 0; i < count; ++i)
+		for (int p = 0; p < passes; ++p)
+			counts[p][(edges[i].key >> (8 * p)) & 0xff]++;
+
+	struct mstalg_edge* from = edges;
+	struct mstalg_edge* to = tmp;
+	for (int p = 0; p < passes; ++p) {
+		size_t* c = counts[p];
+		if ((count == 0) || (c[(edges[0].key >> (8 * p)) & 0xff] == count))
+			continue;		// same byte in every key
+
+		size_t pos = 0;
+		for (int d = 0; d < MSTALG_RADIX; ++d) {
+			size_t n = c[d];
+			c[d] = pos;
+			pos += n;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+			to[c[(from[i].key >> (8 * p)) & 0xff]++] = from[i];
+
+		struct mstalg_edge* swap = from;
+		from = to;
+		to = swap;
+	}
+
+	free(counts);
+	return from;
+}
+
+/*
+ * Kruskal algorithm on an array of edge records (records are overwritten by the sort,
+ * which allocates 'count' more records).
+ * Note: Private function.
+ */
+struct adjlgraph_edgeitem* mstalg_kruskal_records( size_t numvertices, struct mstalg_edge* edges,
+												   size_t count, double* total_p, size_t* size_p )
+{
+	struct mstalg_edge* tmp = mstalg_edges_alloc(count);
+	struct mstalg_edge* sorted = mstalg_radixsort(edges, tmp, count);
+	struct adjlgraph_edgeitem* result = mstalg_result_alloc(numvertices);
+	struct unionfind* uf = unionfind_create((int)numvertices);
+
+	size_t size = 0;
+	double total = 0;
+	for (size_t i = 0; (i < count) && (unionfind_getnumsets(uf) > 1); ++i) {
+		if (!unionfind_union(uf, sorted[i].from, sorted[i].to))
+			continue;	// would close a cycle
+
+		double weight = mstalg_key_weight(sorted[i].key);
+		result[size++] = (struct adjlgraph_edgeitem){ sorted[i].from, sorted[i].to, weight };
+		total += weight;
+	}
+
+	unionfind_destroy(uf);
+	free(tmp);
+	*total_p = total;
+	*size_p = size;
+	return result;
+}
+
+/*
+ * Computes the minimum spanning forest of a graph of 'numvertices' vertices given by an
+ * array of edges, with Kruskal algorithm (edges are taken as undirected).
+ * Total weight of the forest is returned in 'total_p' and its number of edges in 'size_p'.
+ * Returns the forest edges (never NULL).
+ * Note: returned array must be released later from memory.
+ */
+struct adjlgraph_edgeitem* mstalg_kruskal( size_t numvertices, const struct adjlgraph_edgeitem* edges,
+										   size_t count, double* total_p, size_t* size_p )
+{
+	struct mstalg_edge* records = mstalg_edges_alloc(count);
+	for (size_t i = 0; i < count; ++i)
+		records[i] = (struct mstalg_edge){ mstalg_weight_key(edges[i].weight), edges[i].from, edges[i].to };
+
+	struct adjlgraph_edgeitem* result = mstalg_kruskal_records(numvertices, records, count, total_p, size_p);
+	free(records);
+	return result;
+}
+
+/*
+ * Computes the minimum spanning forest of an adjacency list graph with Kruskal algorithm.
+ * Total weight of the forest is returned in 'total_p' and its number of edges in 'size_p'.
+ * Returns the forest edges (never NULL).
+ * Note: returned array must be released later from memory.
+ */
+struct adjlgraph_edgeitem* mstalg_kruskal_adjlist( const struct adjlgraph* g, double* total_p,
+												   size_t* size_p )
+{
+	// undirected edges are in both lists: only the copy with from < to is taken
+	int undirected = (g->etype == UNDIRECTED_AGRAPH);
+	size_t count = 0;
+	for (size_t v = 0; v < g->numvertices; ++v)
+		if (g->vertexlist[v] != NULL)
+			for (struct adjlgedge* e = g->vertexlist[v]->edgeslist; e != NULL; e = e->next)
+				count += (!undirected || ((size_t)e->vertexindex > v));
+
+	struct mstalg_edge* records = mstalg_edges_alloc(count);
+	size_t pos = 0;
+	for (size_t v = 0; v < g->numvertices; ++v)
+		if (g->vertexlist[v] != NULL)
+			for (struct adjlgedge* e = g->vertexlist[v]->edgeslist; e != NULL; e = e->next)
+				if (!undirected || ((size_t)e->vertexindex > v))
+					records[pos++] = (struct mstalg_edge){ mstalg_weight_key(e->weight), (int)v, e->vertexindex };
+
+	struct adjlgraph_edgeitem* result = mstalg_kruskal_records(g->numvertices, records, count, total_p, size_p);
+	free(records);
+	return result;
+}
+
+/*
+ * Computes the minimum spanning forest of a CSR graph with Kruskal algorithm (edges of
+ * graphs without weights weigh 1).
+ * Total weight of the forest is returned in 'total_p' and its number of edges in 'size_p'.
+ * Returns the forest edges (never NULL).
+ * Note: returned array must be released later from memory.
+ */
+struct adjlgraph_edgeitem* mstalg_kruskal_csr( const struct csrgraph* g, double* total_p,
+											   size_t* size_p )
+{
+	int undirected = (g->etype == UNDIRECTED_AGRAPH);
+	size_t count = 0;
+	for (size_t v = 0; v < g->numvertices; ++v)
+		for (size_t e = g->offsets[v]; e < g->offsets[v + 1]; ++e)
+			count += (!undirected || ((size_t)g->targets[e] > v));
+
+	struct mstalg_edge* records = mstalg_edges_alloc(count);
+	size_t pos = 0;
+	for (size_t v = 0; v < g->numvertices; ++v)
+		for (size_t e = g->offsets[v]; e < g->offsets[v + 1]; ++e)
+			if (!undirected || ((size_t)g->targets[e] > v))
+				records[pos++] = (struct mstalg_edge){ mstalg_weight_key((g->weights != NULL) ? g->weights[e] : 1.0),
+													   (int)v, g->targets[e] };
+
+	struct adjlgraph_edgeitem* result = mstalg_kruskal_records(g->numvertices, records, count, total_p, size_p);
+	free(records);
+	return result;
+}
+
+// state of eager Prim algorithm
+struct mstalg_prim_state {
+	struct imindblpq* pq;		// vertices out of the tree by lightest joining edge
+	int* from;					// tree end of the lightest joining edge of each vertex
+	char* intree;				// vertex is in the tree
+	struct adjlgraph_edgeitem* result;
+	size_t size;
+	double total;
+};
+
+/*
+ * Allocates the state of eager Prim algorithm for 'n' vertices.
+ * Note: Private function.
+ */
+void mstalg_prim_init(struct mstalg_prim_state* st, size_t n)
+{
+	st->pq = imindblpq_create((n > 0) ? (int)n : 1);
+	st->from = (int*)malloc(((n > 0) ? n : 1) * sizeof(int));
+	st->intree = (char*)calloc((n > 0) ? n : 1, sizeof(char));
+	if ((st->from == NULL) || (st->intree == NULL)) {
+		printf("Memory error: failed to allocate memory for Prim algorithm!");
+		abort();
+	}
+
+	st->result = mstalg_result_alloc(n);
+	st->size = 0;
+	st->total = 0;
+}
+
+/*
+ * Scans edge v-w: 'w' is queued, or its key is decreased, if the edge is lighter than
+ * the lightest edge joining it to the tree.
+ * Note: Private function.
+ */
+void mstalg_prim_relax(struct mstalg_prim_state* st, int v, int w, double weight)
+{
+	if (st->intree[w])
+		return;
+
+	if (!imindblpq_contains(st->pq, w))
+		imindblpq_insert(st->pq, w, weight);
+	else if (weight < imindblpq_valueof(st->pq, w))
+		imindblpq_decrease(st->pq, w, weight);
+	else
+		return;
+
+	st->from[w] = v;
+}
+
+/*
+ * Moves the vertex closest to the tree into it (and its joining edge to the result).
+ * Returns the vertex.
+ * Note: Private function.
+ */
+int mstalg_prim_next(struct mstalg_prim_state* st)
+{
+	double weight = imindblpq_peekvalue(st->pq);
+	int v = imindblpq_extractkeyindex(st->pq);
+	st->intree[v] = 1;
+	st->result[st->size++] = (struct adjlgraph_edgeitem){ st->from[v], v, weight };
+	st->total += weight;
+	return v;
+}
+
+/*
+ * Releases Prim state (but the result) and returns the result with its size and weight.
+ * Note: Private function.
+ */
+struct adjlgraph_edgeitem* mstalg_prim_done(struct mstalg_prim_state* st, double* total_p, size_t* size_p)
+{
+	imindblpq_destroy(st->pq);
+	free(st->from);
+	free(st->intree);
+	*total_p = st->total;
+	*size_p = st->size;
+	return st->result;
+}
+
+/*
+ * Checks that Prim algorithm runs on an undirected graph (aborts otherwise).
+ * Note: Private function.
+ */
+void mstalg_prim_check(adjlgraph_edgetype etype)
+{
+	if (etype == DIRECTED_AGRAPH) {
+		printf("Error: Prim algorithm requires an undirected graph!");
+		abort();
+	}
+}
+
+/*
+ * Computes the minimum spanning forest of an undirected adjacency list graph with
+ * eager Prim algorithm.
+ * Total weight of the forest is returned in 'total_p' and its number of edges in 'size_p'.
+ * Returns the forest edges (never NULL).
+ * Note: returned array must be released later from memory.
+ */
+struct adjlgraph_edgeitem* mstalg_prim_adjlist( const struct adjlgraph* g, double* total_p,
+												size_t* size_p )
+{
+	mstalg_prim_check(g->etype);
+	struct mstalg_prim_state st;
+	mstalg_prim_init(&st, g->numvertices);
+
+	// one tree per component
+	for (size_t root = 0; root < g->numvertices; ++root) {
+		if (st.intree[root])
+			continue;
+
+		st.intree[root] = 1;
+		int v = (int)root;
+		for (;;) {
+			if (g->vertexlist[v] != NULL)
+				for (struct adjlgedge* e = g->vertexlist[v]->edgeslist; e != NULL; e = e->next)
+					mstalg_prim_relax(&st, v, e->vertexindex, e->weight);
+
+			if (imindblpq_isempty(st.pq))
+				break;
+
+			v = mstalg_prim_next(&st);
+		}
+	}
+
+	return mstalg_prim_done(&st, total_p, size_p);
+}
+
+/*
+ * Computes the minimum spanning forest of an undirected CSR graph with eager Prim
+ * algorithm (edges of graphs without weights weigh 1).
+ * Total weight of the forest is returned in 'total_p' and its number of edges in 'size_p'.
+ * Returns the forest edges (never NULL).
+ * Note: returned array must be released later from memory.
+ */
+struct adjlgraph_edgeitem* mstalg_prim_csr( const struct csrgraph* g, double* total_p,
+											size_t* size_p )
+{
+	mstalg_prim_check(g->etype);
+	struct mstalg_prim_state st;
+	mstalg_prim_init(&st, g->numvertices);
+
+	// one tree per component
+	for (size_t root = 0; root < g->numvertices; ++root) {
+		if (st.intree[root])
+			continue;
+
+		st.intree[root] = 1;
+		int v = (int)root;
+		for (;;) {
+			for (size_t e = g->offsets[v]; e < g->offsets[v + 1]; ++e)
+				mstalg_prim_relax(&st, v, g->targets[e], (g->weights != NULL) ? g->weights[e] : 1.0);
+
+			if (imindblpq_isempty(st.pq))
+				break;
+
+			v = mstalg_prim_next(&st);
+		}
+	}
+
+	return mstalg_prim_done(&st, total_p, size_p);
+}
@@ -0,0 +1,101 @@
+/*****************************************************************************
+ * mstalg.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for minimum spanning tree algorithms (Kruskal and Prim)
+ *  			 on adjacency list graphs, CSR graphs and edge arrays.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Both algorithms return a minimum spanning forest: one minimum spanning tree per
+ *  connected component, so the result has numvertices - components edges (a graph
+ *  is connected when the result has numvertices - 1 edges). Result edges are an
+ *  array of 'struct adjlgraph_edgeitem' in the order they were added.
+ *
+ *  Kruskal
+ *
+ *  	All edges are copied once to a flat array of 16 byte records (weight key,
+ *  	from, to), sorted by weight and scanned in order, an edge being kept when
+ *  	its ends are in different sets of a union-find structure (see unionfind.h).
+ *  	The scan stops as soon as a single set is left.
+ *  	Weights are sorted with a least significant digit radix sort on the bits of
+ *  	the double (mapped so that unsigned order is the order of the doubles), one
+ *  	byte per pass: passes where all keys have the same byte are skipped, so small
+ *  	integer weights take one or two passes. Sort is stable, equal weights keep the
+ *  	order of the edge lists.
+ *  	Edges of directed graphs are taken as undirected (spanning forest of the
+ *  	underlying undirected graph).
+ *
+ *  Prim (eager)
+ *
+ *  	Vertices outside the tree are kept in an indexed 4-ary heap of doubles (see
+ *  	indmindblheap.h) keyed by the lightest edge that joins them to the tree; each
+ *  	scanned edge is at most one insert or one decrease key, so the heap never holds
+ *  	more than one entry per vertex (the lazy version queues every edge).
+ *  	O(E log V) like Kruskal but with no sort, the better choice for dense graphs.
+ *  	Requires undirected graphs (edges in both directions).
+ *
+ *  Source: R. Sedgewick, K. Wayne, "Algorithms", 4th edition, section 4.3.
+ *
+ *******************************************************************************/
+
+#ifndef MSTALG_H_
+	#define MSTALG_H_
+
+	#include <stdlib.h>
+	#include "adjlgraph.h"
+	#include "csrgraph.h"
+
+	/*
+	 * Computes the minimum spanning forest of a graph of 'numvertices' vertices given by an
+	 * array of edges, with Kruskal algorithm (edges are taken as undirected).
+	 * Total weight of the forest is returned in 'total_p' and its number of edges in 'size_p'.
+	 * Returns the forest edges (never NULL).
+	 * Note: returned array must be released later from memory.
+	 */
+	struct adjlgraph_edgeitem* mstalg_kruskal( size_t numvertices, const struct adjlgraph_edgeitem* edges,
+											   size_t count, double* total_p, size_t* size_p );
+
+	/*
+	 * Computes the minimum spanning forest of an adjacency list graph with Kruskal algorithm.
+	 * Total weight of the forest is returned in 'total_p' and its number of edges in 'size_p'.
+	 * Returns the forest edges (never NULL).
+	 * Note: returned array must be released later from memory.
+	 */
+	struct adjlgraph_edgeitem* mstalg_kruskal_adjlist( const struct adjlgraph* g, double* total_p,
+													   size_t* size_p );
+
+	/*
+	 * Computes the minimum spanning forest of a CSR graph with Kruskal algorithm (edges of
+	 * graphs without weights weigh 1).
+	 * Total weight of the forest is returned in 'total_p' and its number of edges in 'size_p'.
+	 * Returns the forest edges (never NULL).
+	 * Note: returned array must be released later from memory.
+	 */
+	struct adjlgraph_edgeitem* mstalg_kruskal_csr( const struct csrgraph* g, double* total_p,
+												   size_t* size_p );
+
+	/*
+	 * Computes the minimum spanning forest of an undirected adjacency list graph with
+	 * eager Prim algorithm.
+	 * Total weight of the forest is returned in 'total_p' and its number of edges in 'size_p'.
+	 * Returns the forest edges (never NULL).
+	 * Note: returned array must be released later from memory.
+	 */
+	struct adjlgraph_edgeitem* mstalg_prim_adjlist( const struct adjlgraph* g, double* total_p,
+													size_t* size_p );
+
+	/*
+	 * Computes the minimum spanning forest of an undirected CSR graph with eager Prim
+	 * algorithm (edges of graphs without weights weigh 1).
+	 * Total weight of the forest is returned in 'total_p' and its number of edges in 'size_p'.
+	 * Returns the forest edges (never NULL).
+	 * Note: returned array must be released later from memory.
+	 */
+	struct adjlgraph_edgeitem* mstalg_prim_csr( const struct csrgraph* g, double* total_p,
+												size_t* size_p );
+
+#endif /* MSTALG_H_ */
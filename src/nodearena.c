@@ -0,0 +1,167 @@
+/********************************************************************************
+ * nodearena.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Arena allocator for fixed size nodes (tree nodes, list nodes, ...).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Blocks are allocated on demand and never shrink until reset/destroy.
+ *  A free node stores the next free node in its first bytes.
+ *
+ *  Source: https://en.wikipedia.org/wiki/Region-based_memory_management
+ *
+ ***************************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "nodearena.h"
+
+/*
+ * Creates a new arena for nodes of a given size.
+ * If 'blocknodes' is 0 the default block size is used.
+ * Returns the new arena if succeeded, NULL otherwise.
+ * */
+struct nodearena* nodearena_create(size_t nodesize, size_t blocknodes)
+{
+	return nodearena_create_allocator(nodesize, blocknodes, NULL);
+}
+
+/*
+ * Creates a new arena for nodes of a given size whose blocks are allocated by
+ * 'allocator' (see allocator.h, NULL: C library).
+ * If 'blocknodes' is 0 the default block size is used.
+ * Returns the new arena if succeeded, NULL otherwise.
+ * */
+struct nodearena* nodearena_create_allocator(size_t nodesize, size_t blocknodes,
+											 const struct allocator* allocator)
+{
+	assert(nodesize > 0);
+	struct nodearena* result = allocator_alloc(allocator, sizeof(*result));
+
+	if (result != NULL) {
+		// round up to pointer size, keeps nodes aligned and fits free list link
+		result->nodesize = (nodesize + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+		result->blocknodes = (blocknodes > 0) ? blocknodes : NODEARENA_DEFAULT_BLOCK;
+		result->used = result->capacity = 0;	// no current block
+		result->nblocks = 0;
+		result->blocks = NULL;
+		result->freelist = NULL;
+		result->refs = 1;
+		result->allocator = allocator;
+	}
+
+	return result;
+}
+
+/*
+ * Allocates a new current block of 'count' nodes.
+ * Returns 1 (true) if succeeded, 0 (false) otherwise.
+ * */
+int nodearena_addblock(struct nodearena* arena, size_t count)
+{
+	struct nodearena_block* block = allocator_alloc(arena->allocator, sizeof(*block) + count * arena->nodesize);
+	if (block == NULL)
+		return 0;
+
+	block->next = arena->blocks;
+	block->count = count;
+	arena->blocks = block;
+	arena->nblocks++;
+	arena->used = 0;
+	arena->capacity = count;
+	return 1;
+}
+
+/*
+ * Allocates a node from the arena.
+ * Returns the new (uninitialized) node if succeeded, NULL otherwise.
+ * */
+void* nodearena_alloc(struct nodearena* arena)
+{
+	void* result = arena->freelist;
+
+	if (result != NULL) {
+		arena->freelist = *(void**)result;
+		return result;
+	}
+
+	if ((arena->used == arena->capacity) && !nodearena_addblock(arena, arena->blocknodes))
+		return NULL;
+
+	result = arena->blocks->nodes + arena->used * arena->nodesize;
+	arena->used++;
+	return result;
+}
+
+/*
+ * Makes sure the next 'count' nodes taken from the arena (not from its free list)
+ * are contiguous, allocating a block of at least 'count' nodes if needed (the rest
+ * of the current block is left unused).
+ * Returns 1 (true) if succeeded, 0 (false) otherwise.
+ * */
+int nodearena_reserve(struct nodearena* arena, size_t count)
+{
+	if (arena->capacity - arena->used >= count)
+		return 1;
+
+	return nodearena_addblock(arena, (count > arena->blocknodes) ? count : arena->blocknodes);
+}
+
+/*
+ * Returns a node to the arena free list.
+ * */
+void nodearena_free(struct nodearena* arena, void* node)
+{
+	*(void**)node = arena->freelist;
+	arena->freelist = node;
+}
+
+/*
+ * Releases all nodes of the arena in O(blocks). The arena can be used again.
+ * Note: every node taken from the arena becomes invalid.
+ * */
+void nodearena_reset(struct nodearena* arena)
+{
+	struct nodearena_block* block = arena->blocks;
+	struct nodearena_block* next = NULL;
+
+	while (block != NULL) {
+		next = block->next;
+		allocator_free(arena->allocator, block, sizeof(*block) + block->count * arena->nodesize);
+		block = next;
+	}
+
+	arena->blocks = NULL;
+	arena->nblocks = 0;
+	arena->used = arena->capacity = 0;
+	arena->freelist = NULL;
+}
+
+/*
+ * Adds an owner to the arena (e.g. a tree split from another one keeps its nodes
+ * in the same arena). Each owner calls nodearena_destroy once.
+ * Returns the arena.
+ * */
+struct nodearena* nodearena_retain(struct nodearena* arena)
+{
+	arena->refs++;
+	return arena;
+}
+
+/*
+ * Removes an owner from the arena. When the last one is removed releases the
+ * arena and all its nodes from memory in O(blocks).
+ * */
+void nodearena_destroy(struct nodearena* arena)
+{
+	if (--arena->refs > 0)
+		return;
+
+	nodearena_reset(arena);
+	allocator_free(arena->allocator, arena, sizeof(*arena));
+}
@@ -0,0 +1,111 @@
+/*****************************************************************************
+ * nodearena.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: Arena allocator for fixed size nodes (tree nodes, list nodes, ...).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Nodes are carved contiguously from large blocks (bump allocation), so consecutive
+ *  insertions land next to each other in memory and a container with millions of
+ *  nodes costs a few thousand malloc calls instead of millions.
+ *
+ *  Released nodes are kept on a free list and reused by the next allocations.
+ *  The arena can be reset (or destroyed) in O(blocks): every node is released at
+ *  once, without walking the container that owns them.
+ *
+ *  Blocks come from the C library, or from an allocator (see allocator.h) given to
+ *  nodearena_create_allocator.
+ *
+ *  The arena is not thread safe.
+ *
+ *  Source: https://en.wikipedia.org/wiki/Region-based_memory_management
+ *
+ *******************************************************************************/
+
+#ifndef NODEARENA_H_
+	#define NODEARENA_H_
+
+	#include <stdlib.h>
+	#include "allocator.h"
+
+	#define NODEARENA_DEFAULT_BLOCK 4096		// default number of nodes per block
+
+	// block of nodes
+	struct nodearena_block {
+		struct nodearena_block* next;			// next (older) block
+		size_t count;							// nodes of the block
+		char nodes[];							// block memory
+	};
+
+	// node arena type
+	struct nodearena {
+		size_t nodesize;						// size of one node in bytes (pointer aligned)
+		size_t blocknodes;						// number of nodes per block
+		size_t used;							// nodes taken from the current block
+		size_t capacity;						// nodes of the current block
+		size_t nblocks;							// number of allocated blocks
+		struct nodearena_block* blocks;			// allocated blocks (current one first)
+		void* freelist;							// released nodes
+		size_t refs;							// owners of the arena (see nodearena_retain)
+		const struct allocator* allocator;		// allocator of arena and blocks (NULL: C library)
+	};
+
+	/*
+	 * Creates a new arena for nodes of a given size.
+	 * If 'blocknodes' is 0 the default block size is used.
+	 * Returns the new arena if succeeded, NULL otherwise.
+	 * */
+	struct nodearena* nodearena_create(size_t nodesize, size_t blocknodes);
+
+	/*
+	 * Creates a new arena for nodes of a given size whose blocks are allocated by
+	 * 'allocator' (see allocator.h, NULL: C library).
+	 * If 'blocknodes' is 0 the default block size is used.
+	 * Returns the new arena if succeeded, NULL otherwise.
+	 * */
+	struct nodearena* nodearena_create_allocator(size_t nodesize, size_t blocknodes,
+												 const struct allocator* allocator);
+
+	/*
+	 * Allocates a node from the arena.
+	 * Returns the new (uninitialized) node if succeeded, NULL otherwise.
+	 * */
+	void* nodearena_alloc(struct nodearena* arena);
+
+	/*
+	 * Makes sure the next 'count' nodes taken from the arena (not from its free list)
+	 * are contiguous, allocating a block of at least 'count' nodes if needed (the rest
+	 * of the current block is left unused).
+	 * Returns 1 (true) if succeeded, 0 (false) otherwise.
+	 * */
+	int nodearena_reserve(struct nodearena* arena, size_t count);
+
+	/*
+	 * Returns a node to the arena free list.
+	 * */
+	void nodearena_free(struct nodearena* arena, void* node);
+
+	/*
+	 * Releases all nodes of the arena in O(blocks). The arena can be used again.
+	 * Note: every node taken from the arena becomes invalid.
+	 * */
+	void nodearena_reset(struct nodearena* arena);
+
+	/*
+	 * Adds an owner to the arena (e.g. a tree split from another one keeps its nodes
+	 * in the same arena). Each owner calls nodearena_destroy once.
+	 * Returns the arena.
+	 * */
+	struct nodearena* nodearena_retain(struct nodearena* arena);
+
+	/*
+	 * Removes an owner from the arena. When the last one is removed releases the
+	 * arena and all its nodes from memory in O(blocks).
+	 * */
+	void nodearena_destroy(struct nodearena* arena);
+
+#endif /* NODEARENA_H_ */
@@ -0,0 +1,249 @@
+/*
+ * numanode.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: NUMA helpers: topology from /sys, thread pinning and memory placed
+ * 				on a node with mbind (no libnuma).
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+	#define _GNU_SOURCE			// sched_getcpu, pthread_setaffinity_np, mremap
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "numanode.h"
+
+#define NUMANODE_SYSFS "/sys/devices/system/node"
+#define NUMANODE_MPOL_PREFERRED 1		// memory policy: node first, others if full
+#define NUMANODE_MPOL_MF_MOVE 2			// mbind flag: move pages already touched
+#define NUMANODE_MASK_WORDS ((NUMANODE_MAX_NODES + 8 * sizeof(unsigned long) - 1) / (8 * sizeof(unsigned long)))
+
+static int numanode_count = 1;								// number of nodes
+static int numanode_cpunode[NUMANODE_MAX_CPUS];			// node of each cpu
+static cpu_set_t numanode_cpus[NUMANODE_MAX_NODES];		// cpus of each node
+static struct allocator numanode_allocators[NUMANODE_MAX_NODES];	// allocator of each node
+static pthread_once_t numanode_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Reads a sysfs list ("0-3,8,10-11") and calls 'add' (if not NULL) for each number
+ * below 'max'.
+ * Returns the highest number read plus one, 0 if the file can not be read.
+ * Note: Private function.
+ */
+int numanode_read_list(const char* path, int max, void (*add)(int value, void* arg), void* arg)
+{
+	FILE* f = fopen(path, "r");
+	if (f == NULL)
+		return 0;
+
+	char line[4096];
+	int result = 0;
+	if (fgets(line, sizeof(line), f) != NULL) {
+		char* p = line;
+		while ((*p >= '0') && (*p <= '9')) {
+			long first = strtol(p, &p, 10);
+			long last = first;
+			if (*p == '-')
+				last = strtol(p + 1, &p, 10);
+
+			for (long v = first; (v <= last) && (v < max); ++v) {
+				if (add != NULL)
+					add((int)v, arg);
+				if (v + 1 > result)
+					result = (int)(v + 1);
+			}
+
+			if (*p == ',')
+				p++;
+		}
+	}
+
+	fclose(f);
+	return result;
+}
+
+/*
+ * List callback: a cpu of the node in 'arg'.
+ * Note: Private function.
+ */
+void numanode_add_cpu(int cpu, void* arg) {
+	int node = *(int*)arg;
+	numanode_cpunode[cpu] = node;
+	CPU_SET(cpu, &numanode_cpus[node]);
+}
+
+/*
+ * Allocator interface of a node (context is the node number).
+ * Note: Private functions.
+ */
+void* numanode_allocator_alloc(void* ctx, size_t size) {
+	return numanode_alloc(size, (int)(intptr_t)ctx);
+}
+
+void* numanode_allocator_realloc(void* ctx, void* ptr, size_t oldsize, size_t newsize)
+{
+	if (ptr == NULL)
+		return numanode_allocator_alloc(ctx, newsize);
+
+	// the mapping keeps its memory policy when moved
+	void* result = mremap(ptr, (oldsize > 0) ? oldsize : 1, (newsize > 0) ? newsize : 1, MREMAP_MAYMOVE);
+	return (result == MAP_FAILED) ? NULL : result;
+}
+
+void numanode_allocator_free(void* ctx, void* ptr, size_t size) {
+	(void)ctx;
+	numanode_free(ptr, size);
+}
+
+/*
+ * Reads the node topology (once).
+ * Note: Private function.
+ */
+void numanode_init(void)
+{
+	for (int node = 0; node < NUMANODE_MAX_NODES; ++node) {
+		CPU_ZERO(&numanode_cpus[node]);
+		numanode_allocators[node] = (struct allocator){ numanode_allocator_alloc, numanode_allocator_realloc,
+														numanode_allocator_free, (void*)(intptr_t)node };
+	}
+
+	int count = numanode_read_list(NUMANODE_SYSFS "/online", NUMANODE_MAX_NODES, NULL, NULL);
+	numanode_count = (count > 0) ? count : 1;
+
+	int found = 0;
+	char path[128];
+	for (int node = 0; node < count; ++node) {
+		snprintf(path, sizeof(path), NUMANODE_SYSFS "/node%d/cpulist", node);
+		found |= (numanode_read_list(path, NUMANODE_MAX_CPUS, numanode_add_cpu, &node) > 0);
+	}
+
+	if (!found) {
+		// no topology: one node with the cpus the process may run on
+		numanode_count = 1;
+		if (sched_getaffinity(0, sizeof(cpu_set_t), &numanode_cpus[0]) != 0)
+			CPU_ZERO(&numanode_cpus[0]);
+	}
+}
+
+/*
+ * Gets the number of NUMA nodes of the machine (1 if topology is not available).
+ */
+int numanode_getcount(void)
+{
+	pthread_once(&numanode_once, numanode_init);
+	return numanode_count;
+}
+
+/*
+ * Gets the node of a given cpu (0 if unknown).
+ */
+int numanode_of_cpu(int cpu)
+{
+	pthread_once(&numanode_once, numanode_init);
+	return ((cpu >= 0) && (cpu < NUMANODE_MAX_CPUS)) ? numanode_cpunode[cpu] : 0;
+}
+
+/*
+ * Gets the node the calling thread is running on.
+ */
+int numanode_current(void)
+{
+	return numanode_of_cpu(sched_getcpu());
+}
+
+/*
+ * Gets the home node of part 'part' of 'nparts' parts (workers, shards, graph
+ * partitions) split evenly among nodes: consecutive parts share a node.
+ */
+int numanode_of_part(int part, int nparts)
+{
+	int count = numanode_getcount();
+	if (nparts < 1)
+		return 0;
+
+	return (int)((long)(part % nparts) * count / nparts);
+}
+
+/*
+ * Pins the calling thread to the cpus of a given node.
+ * Returns 1 if succeeded, 0 otherwise (thread affinity is not changed).
+ */
+int numanode_pin_thread(int node)
+{
+	if ((node < 0) || (node >= numanode_getcount()) || (CPU_COUNT(&numanode_cpus[node]) == 0))
+		return 0;
+
+	return (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &numanode_cpus[node]) == 0);
+}
+
+/*
+ * Places the pages of an anonymous memory range on a given node. Pages touched
+ * later are allocated on the node, pages already touched are moved when possible.
+ * Only pages fully inside the range are bound.
+ * Returns 1 if succeeded, 0 otherwise.
+ */
+int numanode_bind(void* addr, size_t size, int node)
+{
+	if ((node < 0) || (node >= numanode_getcount()))
+		return 0;
+	if (numanode_count == 1)
+		return 1;	// nothing to place
+
+	uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+	uintptr_t begin = ((uintptr_t)addr + page - 1) & ~(page - 1);
+	uintptr_t end = ((uintptr_t)addr + size) & ~(page - 1);
+	if (end <= begin)
+		return 1;	// no whole page
+
+	unsigned long mask[NUMANODE_MASK_WORDS] = { 0 };
+	mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+	return (syscall( SYS_mbind, (void*)begin, (unsigned long)(end - begin), NUMANODE_MPOL_PREFERRED,
+					 mask, (unsigned long)(NUMANODE_MAX_NODES + 1), NUMANODE_MPOL_MF_MOVE ) == 0);
+}
+
+/*
+ * Allocates 'size' bytes of zeroed memory (whole pages) placed on a given node.
+ * Returns the memory, NULL if there is no memory.
+ */
+void* numanode_alloc(size_t size, int node)
+{
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	size_t len = (size > 0) ? (size + page - 1) & ~(page - 1) : page;
+	void* result = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (result == MAP_FAILED)
+		return NULL;
+
+	numanode_bind(result, len, node);	// best effort: unbound memory still works
+	return result;
+}
+
+/*
+ * Releases memory allocated with 'numanode_alloc' ('size' as given to it).
+ */
+void numanode_free(void* ptr, size_t size)
+{
+	if (ptr != NULL)
+		munmap(ptr, (size > 0) ? size : 1);
+}
+
+/*
+ * Gets an allocator (see allocator.h) of memory placed on a given node (one mapping
+ * per allocation, use it as parent of a region allocator).
+ */
+const struct allocator* numanode_allocator(int node)
+{
+	pthread_once(&numanode_once, numanode_init);
+	if ((node < 0) || (node >= NUMANODE_MAX_NODES))
+		node = 0;
+
+	return &numanode_allocators[node];
+}
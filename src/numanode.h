@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * numanode.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers of NUMA helpers: node topology, thread pinning and
+ *  			 memory placed on a given node.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  On multi-socket servers each socket (node) has its own memory, reached by the
+ *  other sockets through a slower link. Linux places a page on the node of the
+ *  thread that first touches it, so a container filled by one thread lives on one
+ *  node and threads of the other sockets pay remote misses on every lookup.
+ *
+ *  Partitioned containers (hashtable_concurrent_create_numa, csrgraph_create_partitioned)
+ *  give each node its own part of the data, allocated on that node, and workers
+ *  pinned to a node (numanode_pin_thread) work mostly on their local part.
+ *
+ *  Topology is read once from /sys/devices/system/node (online nodes and the cpu
+ *  list of each node). Memory is placed with the mbind system call on anonymous
+ *  mappings (preferred policy: pages fall back to other nodes when the node is
+ *  full), so no libnuma is needed. Placement is best effort: on machines with one
+ *  node, kernels without NUMA support or sandboxes denying mbind every function
+ *  still works and memory is simply not bound.
+ *
+ *  numanode_allocator(node) is an allocator (see allocator.h) doing one mapping
+ *  per allocation, so it is meant as the parent of a region allocator
+ *  (allocator_region_create(0, numanode_allocator(node))), which carves small
+ *  allocations from large node local blocks.
+ *
+ *  Source: https://www.kernel.org/doc/html/latest/admin-guide/mm/numa_memory_policy.html
+ *
+ *******************************************************************************/
+
+#ifndef NUMANODE_H_
+	#define NUMANODE_H_
+
+	#include <stdlib.h>
+	#include "allocator.h"
+
+	#define NUMANODE_MAX_NODES 64			// nodes above this limit are ignored
+	#define NUMANODE_MAX_CPUS 1024			// cpus above this limit are ignored
+
+	/*
+	 * Gets the number of NUMA nodes of the machine (1 if topology is not available).
+	 */
+	int numanode_getcount(void);
+
+	/*
+	 * Gets the node of a given cpu (0 if unknown).
+	 */
+	int numanode_of_cpu(int cpu);
+
+	/*
+	 * Gets the node the calling thread is running on.
+	 */
+	int numanode_current(void);
+
+	/*
+	 * Gets the home node of part 'part' of 'nparts' parts (workers, shards, graph
+	 * partitions) split evenly among nodes: consecutive parts share a node.
+	 */
+	int numanode_of_part(int part, int nparts);
+
+	/*
+	 * Pins the calling thread to the cpus of a given node.
+	 * Returns 1 if succeeded, 0 otherwise (thread affinity is not changed).
+	 */
+	int numanode_pin_thread(int node);
+
+	/*
+	 * Allocates 'size' bytes of zeroed memory (whole pages) placed on a given node.
+	 * Returns the memory, NULL if there is no memory.
+	 */
+	void* numanode_alloc(size_t size, int node);
+
+	/*
+	 * Releases memory allocated with 'numanode_alloc' ('size' as given to it).
+	 */
+	void numanode_free(void* ptr, size_t size);
+
+	/*
+	 * Places the pages of an anonymous memory range on a given node. Pages touched
+	 * later are allocated on the node, pages already touched are moved when possible.
+	 * Only pages fully inside the range are bound.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 */
+	int numanode_bind(void* addr, size_t size, int node);
+
+	/*
+	 * Gets an allocator (see allocator.h) of memory placed on a given node (one mapping
+	 * per allocation, use it as parent of a region allocator).
+	 */
+	const struct allocator* numanode_allocator(int node);
+
+#endif /* NUMANODE_H_ */
@@ -0,0 +1,297 @@
+/*
+ * pairingheap.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of a pairing heap with node handles.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "pairingheap.h"
+
+/*
+ * Creates a new empty pairing heap.
+ * Returns pointer to created heap instance.
+ */
+struct pairheap* pairheap_create( pairheap_cmp comparefunc,
+								  pairheap_printdata printdatafunc,
+								  pairheap_freedata freedatafunc )
+{
+	struct pairheap* result = (struct pairheap*)malloc(sizeof(*result));
+	if (result == NULL) {
+		printf("Memory error allocating pairing heap structure instance.");
+		abort();
+	}
+
+	result->root = NULL;
+	result->spare = NULL;
+	result->size = 0;
+	result->compare = comparefunc;
+	result->printdata = printdatafunc;
+	result->freedata = freedatafunc;
+	return result;
+}
+
+/*
+ * Checks if the heap is empty.
+ */
+int pairheap_isempty(const struct pairheap* ph) {
+	return ph->root == NULL;
+}
+
+/*
+ * Gets the number of elements in the heap.
+ */
+size_t pairheap_getsize(const struct pairheap* ph) {
+	return ph->size;
+}
+
+/*
+ * Gets a node from spare nodes or allocates a new one.
+ */
+struct pairheapnode* pairheap_newnode(struct pairheap* ph, void* key)
+{
+	struct pairheapnode* node = ph->spare;
+	if (node != NULL)
+		ph->spare = node->next;
+	else {
+		node = (struct pairheapnode*)malloc(sizeof(*node));
+		if (node == NULL) {
+			printf("Memory error allocating pairing heap node.");
+			abort();
+		}
+	}
+
+	node->key = key;
+	node->child = node->next = node->prev = NULL;
+	return node;
+}
+
+/*
+ * Keeps a node for reuse.
+ */
+void pairheap_releasenode(struct pairheap* ph, struct pairheapnode* node)
+{
+	node->next = ph->spare;
+	ph->spare = node;
+}
+
+/*
+ * Melds two heap ordered trees: root with larger key becomes first child of the other.
+ * Returns root of result tree.
+ */
+struct pairheapnode* pairheap_meld(struct pairheap* ph, struct pairheapnode* a,
+								   struct pairheapnode* b)
+{
+	if (a == NULL) return b;
+	if (b == NULL) return a;
+
+	if (ph->compare(b->key, a->key) < 0) {
+		struct pairheapnode* t = a;
+		a = b;
+		b = t;
+	}
+
+	b->prev = a;
+	b->next = a->child;
+	if (a->child != NULL)
+		a->child->prev = b;
+
+	a->child = b;
+	a->next = a->prev = NULL;
+	return a;
+}
+
+/*
+ * Melds a list of sibling trees in two passes (pairing heap rule): trees are melded
+ * in pairs from left to right, then pairs are melded from right to left.
+ * Returns root of result tree.
+ */
+struct pairheapnode* pairheap_combine(struct pairheap* ph, struct pairheapnode* first)
+{
+	struct pairheapnode* pairs = NULL;		// melded pairs, last pair first
+
+	while (first != NULL) {
+		struct pairheapnode* a = first;
+		struct pairheapnode* b = a->next;
+		first = (b != NULL) ? b->next : NULL;
+
+		a->next = a->prev = NULL;
+		if (b != NULL)
+			b->next = b->prev = NULL;
+
+		struct pairheapnode* m = pairheap_meld(ph, a, b);
+		m->next = pairs;
+		pairs = m;
+	}
+
+	struct pairheapnode* result = NULL;
+	while (pairs != NULL) {
+		struct pairheapnode* next = pairs->next;
+		pairs->next = NULL;
+		result = pairheap_meld(ph, result, pairs);
+		pairs = next;
+	}
+
+	return result;
+}
+
+/*
+ * Unlinks a (non root) node subtree from its parent and siblings.
+ */
+void pairheap_cut(struct pairheapnode* node)
+{
+	if (node->prev->child == node)
+		node->prev->child = node->next;	// first child
+	else
+		node->prev->next = node->next;
+
+	if (node->next != NULL)
+		node->next->prev = node->prev;
+
+	node->next = node->prev = NULL;
+}
+
+/*
+ * Inserts an element in the heap, in O(1).
+ * Returns the node of the element: a stable handle for pairheap_decrease_key and
+ * pairheap_delete_node until the element leaves the heap.
+ */
+struct pairheapnode* pairheap_insert(struct pairheap* ph, void* key)
+{
+	struct pairheapnode* node = pairheap_newnode(ph, key);
+	ph->root = pairheap_meld(ph, ph->root, node);
+	ph->size++;
+	return node;
+}
+
+/*
+ * Gets the minimum element without removing it. Returns NULL if heap is empty.
+ */
+void* pairheap_peek(const struct pairheap* ph) {
+	return (ph->root != NULL) ? ph->root->key : NULL;
+}
+
+/*
+ * Removes the minimum element, in O(log n) amortized.
+ * Returns removed element, NULL if heap is empty.
+ * Note: node of the element is reused, its handle is no longer valid.
+ */
+void* pairheap_extract_min(struct pairheap* ph)
+{
+	struct pairheapnode* root = ph->root;
+	if (root == NULL)
+		return NULL;
+
+	void* key = root->key;
+	ph->root = pairheap_combine(ph, root->child);
+	ph->size--;
+	pairheap_releasenode(ph, root);
+	return key;
+}
+
+/*
+ * Changes the element of a node to a lesser or equal one 'key' (may be the same
+ * element, after its priority was decreased).
+ * Note: new key must not be greater than the current one.
+ */
+void pairheap_decrease_key(struct pairheap* ph, struct pairheapnode* node, void* key)
+{
+	node->key = key;
+	if (node == ph->root)
+		return;
+
+	// subtree stays heap ordered, only its link to the parent may be violated
+	pairheap_cut(node);
+	ph->root = pairheap_meld(ph, ph->root, node);
+}
+
+/*
+ * Removes a node from the heap given its handle, in O(log n) amortized.
+ * Returns the element of removed node.
+ */
+void* pairheap_delete_node(struct pairheap* ph, struct pairheapnode* node)
+{
+	if (node == ph->root)
+		return pairheap_extract_min(ph);
+
+	void* key = node->key;
+	pairheap_cut(node);
+	ph->root = pairheap_meld(ph, ph->root, pairheap_combine(ph, node->child));
+	ph->size--;
+	pairheap_releasenode(ph, node);
+	return key;
+}
+
+/*
+ * Moves all elements of heap 'other' to heap 'ph', in O(1) ('other' becomes empty).
+ * Note: both heaps must have the same compare function.
+ */
+void pairheap_merge(struct pairheap* ph, struct pairheap* other)
+{
+	ph->root = pairheap_meld(ph, ph->root, other->root);
+	ph->size += other->size;
+	other->root = NULL;
+	other->size = 0;
+}
+
+/*
+ * Prints the minimum element and the size of the heap.
+ */
+void pairheap_print(const struct pairheap* ph)
+{
+	if (ph->root == NULL)
+		printf("The heap is empty\n");
+	else {
+		printf("Minimum: ");
+		if (ph->printdata)
+			ph->printdata(ph->root->key);
+		printf(", the heap has %zu node(s)\n", ph->size);
+	}
+}
+
+/*
+ * Removes all elements from the heap (released with 'freedata' if defined).
+ * Nodes are kept for reuse.
+ */
+void pairheap_clear(struct pairheap* ph)
+{
+	// walk tree as a binary tree (left: child, right: next) rotating right,
+	// a node without child is released (O(n), no stack)
+	struct pairheapnode* node = ph->root;
+	while (node != NULL) {
+		if (node->child != NULL) {
+			struct pairheapnode* child = node->child;
+			node->child = child->next;
+			child->next = node;
+			node = child;
+		}
+		else {
+			struct pairheapnode* next = node->next;
+			if (ph->freedata)
+				ph->freedata(node->key);
+
+			pairheap_releasenode(ph, node);
+			node = next;
+		}
+	}
+
+	ph->root = NULL;
+	ph->size = 0;
+}
+
+/*
+ * Releases the heap, its nodes and elements (if 'freedata' is defined) from memory.
+ */
+void pairheap_destroy(struct pairheap* ph)
+{
+	pairheap_clear(ph);
+	while (ph->spare != NULL) {
+		struct pairheapnode* next = ph->spare->next;
+		free(ph->spare);
+		ph->spare = next;
+	}
+
+	free(ph);
+}
@@ -0,0 +1,142 @@
+/*****************************************************************************
+ * pairingheap.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a pairing heap (min heap) with node handles.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A pairing heap is a single heap ordered multiway tree: the root is the minimum and
+ *  every node keeps its children in a list (first child, next sibling). All the work
+ *  is done by 'meld', which makes the root with the larger key the first child of the
+ *  other one (one compare, O(1)):
+ *
+ *  	- insert melds a single node tree with the root;
+ *  	- decrease key cuts the node subtree from its parent and melds it with the root;
+ *  	- extract min removes the root and melds its children in two passes (pairs from
+ *  	  left to right, then the pairs from right to left).
+ *
+ *  ------------------------------------------------------------------------
+ *  | Operation				| Amortized time	| Fibonacci heap		   |
+ *  ------------------------------------------------------------------------
+ *  | insert, meld, min		| O(1)				| O(1)					   |
+ *  | decrease key			| o(log n) *		| O(1)					   |
+ *  | extract min, delete	| O(log n)			| O(log n)				   |
+ *  ------------------------------------------------------------------------
+ *  * between O(log log n) and O(2^(2 * sqrt(log log n))).
+ *
+ *  In practice it is faster than the Fibonacci heap: a node has 3 links (no parent,
+ *  degree or mark), there is no consolidation array and no cascading cuts.
+ *
+ *  Elements are stored by pointer (as in the Fibonacci heap). Insert returns the node,
+ *  that is a stable handle to the element until it leaves the heap. Released nodes are
+ *  kept and reused by later inserts.
+ *
+ *  Source: M. Fredman, R. Sedgewick, D. Sleator, R. Tarjan, "The pairing heap: a new
+ *  		 form of self-adjusting heap", Algorithmica 1 (1986).
+ *  		 https://en.wikipedia.org/wiki/Pairing_heap
+ *
+ *******************************************************************************/
+
+#ifndef PAIRINGHEAP_H_
+	#define PAIRINGHEAP_H_
+
+	#include <stdlib.h>
+
+	typedef int (*pairheap_cmp)(const void* key1, const void* key2);
+	typedef void (*pairheap_freedata)(void* data);
+	typedef void (*pairheap_printdata)(const void* data);
+
+	// heap node (element handle)
+	struct pairheapnode {
+		void* key;
+		struct pairheapnode* child;		// first child
+		struct pairheapnode* next;		// next sibling
+		struct pairheapnode* prev;		// previous sibling (parent if first child)
+	};
+
+	struct pairheap {
+		struct pairheapnode* root;		// minimum element (NULL if heap is empty)
+		struct pairheapnode* spare;		// released nodes (linked by 'next')
+		size_t size;					// number of elements
+		pairheap_cmp compare;			// compare function (returns 0, 1 or -1)
+		pairheap_freedata freedata;		// function to release an element from memory
+		pairheap_printdata printdata;	// function to print an element
+	};
+
+	/*
+	 * Creates a new empty pairing heap.
+	 * Returns pointer to created heap instance.
+	 */
+	struct pairheap* pairheap_create( pairheap_cmp comparefunc,
+									  pairheap_printdata printdatafunc,
+									  pairheap_freedata freedatafunc );
+
+	/*
+	 * Checks if the heap is empty.
+	 */
+	int pairheap_isempty(const struct pairheap* ph);
+
+	/*
+	 * Gets the number of elements in the heap.
+	 */
+	size_t pairheap_getsize(const struct pairheap* ph);
+
+	/*
+	 * Inserts an element in the heap, in O(1).
+	 * Returns the node of the element: a stable handle for pairheap_decrease_key and
+	 * pairheap_delete_node until the element leaves the heap.
+	 */
+	struct pairheapnode* pairheap_insert(struct pairheap* ph, void* key);
+
+	/*
+	 * Gets the minimum element without removing it. Returns NULL if heap is empty.
+	 */
+	void* pairheap_peek(const struct pairheap* ph);
+
+	/*
+	 * Removes the minimum element, in O(log n) amortized.
+	 * Returns removed element, NULL if heap is empty.
+	 * Note: node of the element is reused, its handle is no longer valid.
+	 */
+	void* pairheap_extract_min(struct pairheap* ph);
+
+	/*
+	 * Changes the element of a node to a lesser or equal one 'key' (may be the same
+	 * element, after its priority was decreased).
+	 * Note: new key must not be greater than the current one.
+	 */
+	void pairheap_decrease_key(struct pairheap* ph, struct pairheapnode* node, void* key);
+
+	/*
+	 * Removes a node from the heap given its handle, in O(log n) amortized.
+	 * Returns the element of removed node.
+	 */
+	void* pairheap_delete_node(struct pairheap* ph, struct pairheapnode* node);
+
+	/*
+	 * Moves all elements of heap 'other' to heap 'ph', in O(1) ('other' becomes empty).
+	 * Note: both heaps must have the same compare function.
+	 */
+	void pairheap_merge(struct pairheap* ph, struct pairheap* other);
+
+	/*
+	 * Prints the minimum element and the size of the heap.
+	 */
+	void pairheap_print(const struct pairheap* ph);
+
+	/*
+	 * Removes all elements from the heap (released with 'freedata' if defined).
+	 * Nodes are kept for reuse.
+	 */
+	void pairheap_clear(struct pairheap* ph);
+
+	/*
+	 * Releases the heap, its nodes and elements (if 'freedata' is defined) from memory.
+	 */
+	void pairheap_destroy(struct pairheap* ph);
+
+#endif /* PAIRINGHEAP_H_ */
@@ -0,0 +1,653 @@
+/********************************************************************************
+ * prbtree.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of a persistent (copy-on-write) red-black tree with
+ *  			lock free readers.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Update functions follow the functional algorithms: each one takes ownership of
+ *  one reference of its subtree arguments and returns one reference of the result.
+ *  prbtree_open takes a node apart (its children references go to the caller), and
+ *  prbtree_mknode builds a node from parts. A node with a single reference belongs to
+ *  the running update only, so opening it does not copy anything and its memory is
+ *  reused by the next prbtree_mknode.
+ *
+ *  Source: S. Kahrs, "Red-black trees with types", JFP 11 (2001).
+ *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "prbtree.h"
+
+/*
+ * Creates a new empty persistent tree.
+ * Returns pointer to created tree instance.
+ */
+struct prbtree* prbtree_create(prbtree_cmp comparefunc, prbtree_printdata printdatafunc)
+{
+	struct prbtree* result = (struct prbtree*)malloc(sizeof(struct prbtree));
+	struct prbtree_snapshot* empty = (struct prbtree_snapshot*)malloc(sizeof(struct prbtree_snapshot));
+	if (!result || !empty) {
+		printf("Memory error: failed to allocate memory for persistent tree!");
+		abort();
+	}
+
+	empty->tree = result;
+	empty->root = NULL;
+	empty->size = 0;
+	empty->refs = 1;
+
+	result->current = empty;
+	result->spare = NULL;
+	result->compare = comparefunc;
+	result->printdata = printdatafunc;
+	pthread_mutex_init(&result->writelock, NULL);
+	pthread_mutex_init(&result->snaplock, NULL);
+	return result;
+}
+
+/*
+ * Adds a reference to a node (NULL is allowed).
+ * Returns the node.
+ */
+struct prbtreenode* prbtree_retain(struct prbtreenode* node)
+{
+	if (node != NULL)
+		__atomic_add_fetch(&node->refs, 1, __ATOMIC_RELAXED);
+
+	return node;
+}
+
+/*
+ * Removes a reference from a node, releasing it (and its children references) when
+ * none is left. Can be called by any thread.
+ */
+void prbtree_release(struct prbtreenode* node)
+{
+	while (node != NULL && __atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+		struct prbtreenode* right = node->right;
+		prbtree_release(node->left);
+		free(node);
+		node = right;
+	}
+}
+
+/*
+ * Builds a node from parts, taking the references of 'left' and 'right'.
+ * Returns the node (one reference).
+ */
+struct prbtreenode* prbtree_mknode( struct prbtree* tree, int c, struct prbtreenode* left,
+									void* data, struct prbtreenode* right )
+{
+	struct prbtreenode* result = tree->spare;
+	if (result != NULL)
+		tree->spare = result->right;
+	else {
+		result = (struct prbtreenode*)malloc(sizeof(struct prbtreenode));
+		if (!result) {
+			printf("Memory error: failed to allocate memory for persistent tree node!");
+			abort();
+		}
+	}
+
+	result->refs = 1;
+	result->c = c;
+	result->left = left;
+	result->data = data;
+	result->right = right;
+	return result;
+}
+
+/*
+ * Takes a node apart, its reference is given in exchange for one reference of each
+ * child. A node owned only by the caller is not copied, its memory is kept for reuse.
+ */
+void prbtree_open( struct prbtree* tree, struct prbtreenode* node, struct prbtreenode** left_p,
+				   void** data_p, struct prbtreenode** right_p )
+{
+	*data_p = node->data;
+
+	if (__atomic_load_n(&node->refs, __ATOMIC_ACQUIRE) == 1) {
+		// private node: children references move to the caller
+		*left_p = node->left;
+		*right_p = node->right;
+		node->right = tree->spare;
+		tree->spare = node;
+		return;
+	}
+
+	*left_p = prbtree_retain(node->left);
+	*right_p = prbtree_retain(node->right);
+	prbtree_release(node);
+}
+
+/*
+ * Checks if node is red (NULL leaves are black).
+ */
+int prbtree_isred(const struct prbtreenode* node) {
+	return node != NULL && node->c == PRB_RED;
+}
+
+/*
+ * Checks if node is black (and not a NULL leaf).
+ */
+int prbtree_isblack(const struct prbtreenode* node) {
+	return node != NULL && node->c == PRB_BLACK;
+}
+
+/*
+ * Gets a node with the given color (same node if it already has it).
+ */
+struct prbtreenode* prbtree_paint(struct prbtree* tree, struct prbtreenode* node, int c)
+{
+	if (node == NULL || node->c == c)
+		return node;
+
+	struct prbtreenode *left, *right;
+	void* data;
+	prbtree_open(tree, node, &left, &data, &right);
+	return prbtree_mknode(tree, c, left, data, right);
+}
+
+/*
+ * Builds a black node from parts fixing a red node with a red child below it (Okasaki),
+ * or a red node with two red children (Kahrs).
+ */
+struct prbtreenode* prbtree_balance( struct prbtree* tree, struct prbtreenode* a, void* x,
+									 struct prbtreenode* b )
+{
+	struct prbtreenode *l, *m, *r, *t;
+	void *y, *z;
+
+	if (prbtree_isred(a) && prbtree_isred(b)) {
+		a = prbtree_paint(tree, a, PRB_BLACK);
+		b = prbtree_paint(tree, b, PRB_BLACK);
+		return prbtree_mknode(tree, PRB_RED, a, x, b);
+	}
+
+	if (prbtree_isred(a) && prbtree_isred(a->left)) {
+		// (R (R l y m) z r) x b
+		prbtree_open(tree, a, &t, &z, &r);
+		prbtree_open(tree, t, &l, &y, &m);
+		return prbtree_mknode( tree, PRB_RED, prbtree_mknode(tree, PRB_BLACK, l, y, m), z,
+							   prbtree_mknode(tree, PRB_BLACK, r, x, b) );
+	}
+
+	if (prbtree_isred(a) && prbtree_isred(a->right)) {
+		// (R l y (R m z r)) x b
+		prbtree_open(tree, a, &l, &y, &t);
+		prbtree_open(tree, t, &m, &z, &r);
+		return prbtree_mknode( tree, PRB_RED, prbtree_mknode(tree, PRB_BLACK, l, y, m), z,
+							   prbtree_mknode(tree, PRB_BLACK, r, x, b) );
+	}
+
+	if (prbtree_isred(b) && prbtree_isred(b->right)) {
+		// a x (R l y (R m z r))
+		prbtree_open(tree, b, &l, &y, &t);
+		prbtree_open(tree, t, &m, &z, &r);
+		return prbtree_mknode( tree, PRB_RED, prbtree_mknode(tree, PRB_BLACK, a, x, l), y,
+							   prbtree_mknode(tree, PRB_BLACK, m, z, r) );
+	}
+
+	if (prbtree_isred(b) && prbtree_isred(b->left)) {
+		// a x (R (R l y m) z r)
+		prbtree_open(tree, b, &t, &z, &r);
+		prbtree_open(tree, t, &l, &y, &m);
+		return prbtree_mknode( tree, PRB_RED, prbtree_mknode(tree, PRB_BLACK, a, x, l), y,
+							   prbtree_mknode(tree, PRB_BLACK, m, z, r) );
+	}
+
+	return prbtree_mknode(tree, PRB_BLACK, a, x, b);
+}
+
+/*
+ * Inserts 'data' (not in the tree) in subtree of 'node'.
+ * Returns new subtree (its root may be red with a red child).
+ */
+struct prbtreenode* prbtree_ins(struct prbtree* tree, struct prbtreenode* node, void* data)
+{
+	if (node == NULL)
+		return prbtree_mknode(tree, PRB_RED, NULL, data, NULL);
+
+	int c = node->c;
+	struct prbtreenode *left, *right;
+	void* x;
+	prbtree_open(tree, node, &left, &x, &right);
+
+	if (tree->compare(x, data) > 0)
+		left = prbtree_ins(tree, left, data);
+	else
+		right = prbtree_ins(tree, right, data);
+
+	return (c == PRB_BLACK) ? prbtree_balance(tree, left, x, right)
+							: prbtree_mknode(tree, PRB_RED, left, x, right);
+}
+
+/*
+ * Turns a black node red (its subtree loses one black level).
+ */
+struct prbtreenode* prbtree_sub1(struct prbtree* tree, struct prbtreenode* node)
+{
+	if (!prbtree_isblack(node)) {
+		printf("Error: persistent tree invariant violation!");
+		abort();
+	}
+
+	return prbtree_paint(tree, node, PRB_RED);
+}
+
+/*
+ * Builds a node from parts when its left subtree 'bl' lost one black level.
+ */
+struct prbtreenode* prbtree_balleft( struct prbtree* tree, struct prbtreenode* bl, void* x,
+									 struct prbtreenode* r )
+{
+	struct prbtreenode *a, *b, *c, *t;
+	void *y, *z;
+
+	if (prbtree_isred(bl))
+		return prbtree_mknode(tree, PRB_RED, prbtree_paint(tree, bl, PRB_BLACK), x, r);
+
+	if (prbtree_isblack(r))
+		return prbtree_balance(tree, bl, x, prbtree_paint(tree, r, PRB_RED));
+
+	if (prbtree_isred(r) && prbtree_isblack(r->left)) {
+		// bl x (R (B a y b) z c)
+		prbtree_open(tree, r, &t, &z, &c);
+		prbtree_open(tree, t, &a, &y, &b);
+		return prbtree_mknode( tree, PRB_RED, prbtree_mknode(tree, PRB_BLACK, bl, x, a), y,
+							   prbtree_balance(tree, b, z, prbtree_sub1(tree, c)) );
+	}
+
+	printf("Error: persistent tree invariant violation!");
+	abort();
+}
+
+/*
+ * Builds a node from parts when its right subtree 'bl' lost one black level.
+ */
+struct prbtreenode* prbtree_balright( struct prbtree* tree, struct prbtreenode* l, void* x,
+									  struct prbtreenode* bl )
+{
+	struct prbtreenode *a, *b, *c, *t;
+	void *y, *z;
+
+	if (prbtree_isred(bl))
+		return prbtree_mknode(tree, PRB_RED, l, x, prbtree_paint(tree, bl, PRB_BLACK));
+
+	if (prbtree_isblack(l))
+		return prbtree_balance(tree, prbtree_paint(tree, l, PRB_RED), x, bl);
+
+	if (prbtree_isred(l) && prbtree_isblack(l->right)) {
+		// (R a y (B b z c)) x bl
+		prbtree_open(tree, l, &a, &y, &t);
+		prbtree_open(tree, t, &b, &z, &c);
+		return prbtree_mknode( tree, PRB_RED, prbtree_balance(tree, prbtree_sub1(tree, a), y, b),
+							   z, prbtree_mknode(tree, PRB_BLACK, c, x, bl) );
+	}
+
+	printf("Error: persistent tree invariant violation!");
+	abort();
+}
+
+/*
+ * Appends two subtrees of same black height (all elements of 'a' lesser than all
+ * elements of 'b'), used to remove the node above them.
+ */
+struct prbtreenode* prbtree_app(struct prbtree* tree, struct prbtreenode* a, struct prbtreenode* b)
+{
+	struct prbtreenode *a1, *a2, *b1, *b2, *m, *m1, *m2;
+	void *x, *y, *z;
+
+	if (a == NULL)
+		return b;
+
+	if (b == NULL)
+		return a;
+
+	if (prbtree_isred(a) != prbtree_isred(b)) {
+		if (prbtree_isred(b)) {
+			prbtree_open(tree, b, &b1, &y, &b2);
+			return prbtree_mknode(tree, PRB_RED, prbtree_app(tree, a, b1), y, b2);
+		}
+
+		prbtree_open(tree, a, &a1, &x, &a2);
+		return prbtree_mknode(tree, PRB_RED, a1, x, prbtree_app(tree, a2, b));
+	}
+
+	// both red or both black
+	int c = a->c;
+	prbtree_open(tree, a, &a1, &x, &a2);
+	prbtree_open(tree, b, &b1, &y, &b2);
+	m = prbtree_app(tree, a2, b1);
+
+	if (prbtree_isred(m)) {
+		prbtree_open(tree, m, &m1, &z, &m2);
+		return prbtree_mknode( tree, PRB_RED, prbtree_mknode(tree, c, a1, x, m1), z,
+							   prbtree_mknode(tree, c, m2, y, b2) );
+	}
+
+	if (c == PRB_RED)
+		return prbtree_mknode(tree, PRB_RED, a1, x, prbtree_mknode(tree, PRB_RED, m, y, b2));
+
+	return prbtree_balleft(tree, a1, x, prbtree_mknode(tree, PRB_BLACK, m, y, b2));
+}
+
+/*
+ * Removes element equal to 'key' (in the tree) from subtree of 'node'.
+ * Returns new subtree, removed element in '*removed_p'.
+ */
+struct prbtreenode* prbtree_del( struct prbtree* tree, struct prbtreenode* node, const void* key,
+								 void** removed_p )
+{
+	struct prbtreenode *left, *right;
+	void* x;
+
+	int c = tree->compare(node->data, key);
+	if (c == 0) {
+		*removed_p = node->data;
+		prbtree_open(tree, node, &left, &x, &right);
+		return prbtree_app(tree, left, right);
+	}
+
+	prbtree_open(tree, node, &left, &x, &right);
+	if (c > 0) {
+		int shrinks = prbtree_isblack(left);
+		left = prbtree_del(tree, left, key, removed_p);
+		return (shrinks) ? prbtree_balleft(tree, left, x, right)
+						 : prbtree_mknode(tree, PRB_RED, left, x, right);
+	}
+
+	int shrinks = prbtree_isblack(right);
+	right = prbtree_del(tree, right, key, removed_p);
+	return (shrinks) ? prbtree_balright(tree, left, x, right)
+					 : prbtree_mknode(tree, PRB_RED, left, x, right);
+}
+
+/*
+ * Searches subtree of 'node' for an element equal to 'key'.
+ * Returns element instance if found, NULL otherwise.
+ */
+void* prbtree_searchnode(const struct prbtree* tree, const struct prbtreenode* node, const void* key)
+{
+	while (node != NULL) {
+		int c = tree->compare(node->data, key);
+		if (c == 0)
+			return node->data;
+
+		node = (c > 0) ? node->left : node->right;
+	}
+
+	return NULL;
+}
+
+/*
+ * Releases a snapshot (any thread), and its nodes if it was the last reference.
+ */
+void prbtree_snapshot_release(struct prbtree_snapshot* snap)
+{
+	if (__atomic_sub_fetch(&snap->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+		prbtree_release(snap->root);
+		free(snap);
+	}
+}
+
+/*
+ * Publishes a new version of the tree (writer), releasing the reference of the tree
+ * to the previous one.
+ */
+void prbtree_publish(struct prbtree* tree, struct prbtreenode* root, size_t size)
+{
+	struct prbtree_snapshot* version = (struct prbtree_snapshot*)malloc(sizeof(struct prbtree_snapshot));
+	if (!version) {
+		printf("Memory error: failed to allocate memory for persistent tree version!");
+		abort();
+	}
+
+	version->tree = tree;
+	version->root = root;
+	version->size = size;
+	version->refs = 1;
+
+	pthread_mutex_lock(&tree->snaplock);
+	struct prbtree_snapshot* old = tree->current;
+	tree->current = version;
+	pthread_mutex_unlock(&tree->snaplock);
+
+	prbtree_snapshot_release(old);
+}
+
+/*
+ * Inserts an element and publishes a new version, in O(log n).
+ * Returns '1' (true) if inserted, '0' (false) if an equal element already exists.
+ */
+int prbtree_insert(struct prbtree* tree, void* data)
+{
+	pthread_mutex_lock(&tree->writelock);
+	struct prbtree_snapshot* current = tree->current;	// only writers change it
+
+	if (prbtree_searchnode(tree, current->root, data) != NULL) {
+		pthread_mutex_unlock(&tree->writelock);
+		return 0;
+	}
+
+	struct prbtreenode* root = prbtree_ins(tree, prbtree_retain(current->root), data);
+	prbtree_publish(tree, prbtree_paint(tree, root, PRB_BLACK), current->size + 1);
+	pthread_mutex_unlock(&tree->writelock);
+	return 1;
+}
+
+/*
+ * Removes the element equal to 'key' and publishes a new version, in O(log n).
+ * Returns removed element, NULL if not found.
+ */
+void* prbtree_delete(struct prbtree* tree, const void* key)
+{
+	void* result = NULL;
+	pthread_mutex_lock(&tree->writelock);
+	struct prbtree_snapshot* current = tree->current;
+
+	if (prbtree_searchnode(tree, current->root, key) != NULL) {
+		struct prbtreenode* root = prbtree_del(tree, prbtree_retain(current->root), key, &result);
+		prbtree_publish(tree, prbtree_paint(tree, root, PRB_BLACK), current->size - 1);
+	}
+
+	pthread_mutex_unlock(&tree->writelock);
+	return result;
+}
+
+/*
+ * Takes the current version of the tree. It does not change until released
+ * (prbtree_snapshot_release), whatever writers do.
+ */
+struct prbtree_snapshot* prbtree_snapshot_take(struct prbtree* tree)
+{
+	pthread_mutex_lock(&tree->snaplock);
+	struct prbtree_snapshot* result = tree->current;
+	__atomic_add_fetch(&result->refs, 1, __ATOMIC_RELAXED);
+	pthread_mutex_unlock(&tree->snaplock);
+	return result;
+}
+
+/*
+ * Searches a snapshot for an element equal to 'key' (no lock).
+ * Returns element instance if found, NULL otherwise.
+ */
+void* prbtree_snapshot_search(const struct prbtree_snapshot* snap, const void* key) {
+	return prbtree_searchnode(snap->tree, snap->root, key);
+}
+
+/*
+ * Gets greatest element lesser than or equal to 'key' of a snapshot.
+ * Returns NULL if none.
+ */
+void* prbtree_snapshot_floor(const struct prbtree_snapshot* snap, const void* key)
+{
+	void* result = NULL;
+	for (const struct prbtreenode* node = snap->root; node != NULL; ) {
+		int c = snap->tree->compare(node->data, key);
+		if (c == 0)
+			return node->data;
+
+		if (c < 0) {
+			result = node->data;
+			node = node->right;
+		}
+		else
+			node = node->left;
+	}
+
+	return result;
+}
+
+/*
+ * Gets smallest element larger than or equal to 'key' of a snapshot.
+ * Returns NULL if none.
+ */
+void* prbtree_snapshot_ceiling(const struct prbtree_snapshot* snap, const void* key)
+{
+	void* result = NULL;
+	for (const struct prbtreenode* node = snap->root; node != NULL; ) {
+		int c = snap->tree->compare(node->data, key);
+		if (c == 0)
+			return node->data;
+
+		if (c > 0) {
+			result = node->data;
+			node = node->left;
+		}
+		else
+			node = node->right;
+	}
+
+	return result;
+}
+
+/*
+ * Gets the element at cursor, NULL if there is none.
+ */
+void* prbtree_iter_get(const struct prbtree_iter* it) {
+	return (it->depth > 0) ? it->path[it->depth - 1]->data : NULL;
+}
+
+/*
+ * Pushes 'node' and its leftmost descendants to cursor path.
+ */
+void prbtree_iter_pushleft(struct prbtree_iter* it, struct prbtreenode* node)
+{
+	for (; node != NULL; node = node->left)
+		it->path[it->depth++] = node;
+}
+
+/*
+ * Positions cursor at the smallest element of a snapshot.
+ * Returns that element, NULL if none.
+ */
+void* prbtree_iter_first(const struct prbtree_snapshot* snap, struct prbtree_iter* it)
+{
+	it->depth = 0;
+	prbtree_iter_pushleft(it, snap->root);
+	return prbtree_iter_get(it);
+}
+
+/*
+ * Positions cursor at the smallest element larger than or equal to 'key'.
+ * Returns that element, NULL if none.
+ */
+void* prbtree_iter_seek(const struct prbtree_snapshot* snap, const void* key, struct prbtree_iter* it)
+{
+	int found = 0;	// path length up to the best candidate
+	it->depth = 0;
+
+	for (struct prbtreenode* node = snap->root; node != NULL; ) {
+		it->path[it->depth++] = node;
+
+		int c = snap->tree->compare(node->data, key);
+		if (c == 0) {
+			found = it->depth;
+			break;
+		}
+
+		if (c > 0) {
+			found = it->depth;
+			node = node->left;
+		}
+		else
+			node = node->right;
+	}
+
+	it->depth = found;
+	return prbtree_iter_get(it);
+}
+
+/*
+ * Moves cursor to the next element.
+ * Returns that element, NULL if cursor moved past the end.
+ */
+void* prbtree_iter_next(struct prbtree_iter* it)
+{
+	if (it->depth == 0)
+		return NULL;
+
+	struct prbtreenode* node = it->path[it->depth - 1];
+	if (node->right != NULL)
+		prbtree_iter_pushleft(it, node->right);
+	else {
+		// go up until coming from a left child
+		while (it->depth > 1 && it->path[it->depth - 2]->right == it->path[it->depth - 1])
+			it->depth--;
+
+		it->depth--;
+	}
+
+	return prbtree_iter_get(it);
+}
+
+/*
+ * Prints elements of a snapshot in order.
+ */
+void prbtree_snapshot_print(const struct prbtree_snapshot* snap)
+{
+	if (!snap->tree->printdata) {
+		printf("Error: 'printdata' function is undefined. Can't print tree.");
+		abort();
+	}
+
+	struct prbtree_iter it;
+	printf("{ ");
+	for (void* e = prbtree_iter_first(snap, &it); e != NULL; ) {
+		snap->tree->printdata(e);
+
+		e = prbtree_iter_next(&it);
+		if (e != NULL)
+			printf("; ");
+	}
+
+	printf(" }\n");
+}
+
+/*
+ * Releases the tree structure and its current version from memory.
+ * Note: all snapshots must be released before.
+ */
+void prbtree_destroy(struct prbtree* tree)
+{
+	prbtree_snapshot_release(tree->current);
+
+	while (tree->spare != NULL) {
+		struct prbtreenode* next = tree->spare->right;
+		free(tree->spare);
+		tree->spare = next;
+	}
+
+	pthread_mutex_destroy(&tree->writelock);
+	pthread_mutex_destroy(&tree->snaplock);
+	free(tree);
+}
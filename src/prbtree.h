@@ -0,0 +1,155 @@
+/*****************************************************************************
+ * prbtree.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a persistent (copy-on-write) red-black tree with
+ *  			 lock free readers.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  The red-black tree (redblacktree.h) rotates nodes in place, so readers must lock
+ *  it while it is changed. This tree never changes a published node: an update
+ *  copies the O(log n) nodes on the path from the root to the changed element and
+ *  publishes the new root as a new version (snapshot). Readers take a snapshot and
+ *  search it without any lock; writers do not wait for readers.
+ *
+ *  	- nodes have no parent pointer (a node is shared by many versions) and keep a
+ *  	  reference count: number of parents plus versions having it as root;
+ *  	- a version is released when the tree moves to a newer one and every reader
+ *  	  released it, then nodes left without references are released;
+ *  	- nodes created by the current update and not yet published are changed in
+ *  	  place (only one reference), so an update allocates about one node per level.
+ *
+ *  Balancing is the functional red-black tree of Okasaki (insertion) and Kahrs
+ *  (deletion): same invariants as redblacktree.h, O(log n) per operation.
+ *
+ *  Writers are serialized by a mutex. Taking a snapshot holds a second mutex only to
+ *  read the current version and count the reader (releasing it is an atomic decrement),
+ *  so a reader should keep a snapshot for a batch of lookups.
+ *
+ *  Elements are not released by the tree: a removed element may still be visible in
+ *  older snapshots.
+ *
+ *  Source: C. Okasaki, "Red-black trees in a functional setting", JFP 9 (1999).
+ *  		 S. Kahrs, "Red-black trees with types", JFP 11 (2001).
+ *  		 J. Driscoll et al., "Making data structures persistent", JCSS 38 (1989).
+ *
+ *******************************************************************************/
+
+#ifndef PRBTREE_H_
+	#define PRBTREE_H_
+
+	#include <stdlib.h>
+	#include <pthread.h>
+
+	#define PRB_BLACK 0					// black node
+	#define PRB_RED 1					// red node
+	#define PRBTREE_ITER_MAXDEPTH 128	// red-black tree height is at most 2 * log2(n + 1)
+
+	typedef int (*prbtree_cmp)(const void* data1, const void* data2);
+	typedef void (*prbtree_printdata)(const void* data);
+
+	// tree node (never changed once published)
+	struct prbtreenode {
+		int refs;						// parents and versions pointing to node (atomic)
+		int c;							// color: PRB_RED or PRB_BLACK
+		void* data;
+		struct prbtreenode* left;
+		struct prbtreenode* right;
+	};
+
+	// version of the tree (snapshot)
+	struct prbtree_snapshot {
+		const struct prbtree* tree;
+		struct prbtreenode* root;
+		size_t size;					// number of elements
+		int refs;						// readers plus tree if current version (atomic)
+	};
+
+	struct prbtree {
+		struct prbtree_snapshot* current;	// last published version
+		struct prbtreenode* spare;			// released private nodes, reused by writer
+		prbtree_cmp compare;				// compare function (returns 0, 1 or -1)
+		prbtree_printdata printdata;		// function to print data
+		pthread_mutex_t writelock;			// serializes writers
+		pthread_mutex_t snaplock;			// protects 'current' while taken/replaced
+	};
+
+	// in order cursor on a snapshot
+	struct prbtree_iter {
+		int depth;										// path length (0: no current element)
+		struct prbtreenode* path[PRBTREE_ITER_MAXDEPTH];	// path[depth - 1] is current node
+	};
+
+	/*
+	 * Creates a new empty persistent tree.
+	 * Returns pointer to created tree instance.
+	 */
+	struct prbtree* prbtree_create(prbtree_cmp comparefunc, prbtree_printdata printdatafunc);
+
+	/*
+	 * Inserts an element and publishes a new version, in O(log n).
+	 * Returns '1' (true) if inserted, '0' (false) if an equal element already exists.
+	 */
+	int prbtree_insert(struct prbtree* tree, void* data);
+
+	/*
+	 * Removes the element equal to 'key' and publishes a new version, in O(log n).
+	 * Returns removed element, NULL if not found.
+	 */
+	void* prbtree_delete(struct prbtree* tree, const void* key);
+
+	/*
+	 * Takes the current version of the tree. It does not change until released
+	 * (prbtree_snapshot_release), whatever writers do.
+	 */
+	struct prbtree_snapshot* prbtree_snapshot_take(struct prbtree* tree);
+
+	/*
+	 * Releases a snapshot taken with prbtree_snapshot_take.
+	 */
+	void prbtree_snapshot_release(struct prbtree_snapshot* snap);
+
+	/*
+	 * Searches a snapshot for an element equal to 'key' (no lock).
+	 * Returns element instance if found, NULL otherwise.
+	 */
+	void* prbtree_snapshot_search(const struct prbtree_snapshot* snap, const void* key);
+
+	/*
+	 * Gets greatest element lesser than or equal to 'key' (floor) or smallest element
+	 * larger than or equal to 'key' (ceiling) of a snapshot. Returns NULL if none.
+	 */
+	void* prbtree_snapshot_floor(const struct prbtree_snapshot* snap, const void* key);
+	void* prbtree_snapshot_ceiling(const struct prbtree_snapshot* snap, const void* key);
+
+	/*
+	 * Positions cursor at the smallest element of a snapshot (prbtree_iter_first) or at
+	 * the smallest element larger than or equal to 'key' (prbtree_iter_seek).
+	 * Returns that element, NULL if none.
+	 * Note: cursor is valid while the snapshot is not released.
+	 */
+	void* prbtree_iter_first(const struct prbtree_snapshot* snap, struct prbtree_iter* it);
+	void* prbtree_iter_seek(const struct prbtree_snapshot* snap, const void* key, struct prbtree_iter* it);
+
+	/*
+	 * Moves cursor to the next element.
+	 * Returns that element, NULL if cursor moved past the end.
+	 */
+	void* prbtree_iter_next(struct prbtree_iter* it);
+
+	/*
+	 * Prints elements of a snapshot in order.
+	 */
+	void prbtree_snapshot_print(const struct prbtree_snapshot* snap);
+
+	/*
+	 * Releases the tree structure and its current version from memory.
+	 * Note: all snapshots must be released before.
+	 */
+	void prbtree_destroy(struct prbtree* tree);
+
+#endif /* PRBTREE_H_ */
@@ -0,0 +1,275 @@
+/*
+ * radixheap.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of an indexed radix heap (monotone priority queue).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "radixheap.h"
+
+#define RADIXHEAP_NONE -1
+
+/*
+ * Initializes an indexed radix heap with a maximum capacity of maxSize.
+ */
+struct radixheap* radixheap_create( int maxSize )
+{
+	if (maxSize <= 0) {
+		printf("Error: radix heap maximum size must be greater than zero!");
+		abort();
+	}
+
+	struct radixheap* rh = (struct radixheap*)malloc(sizeof(*rh));
+	if (rh == NULL) {
+		printf("Memory error allocating radix heap structure instance.");
+		abort();
+	}
+
+	rh->N = maxSize;
+	rh->sz = 0;
+	rh->last = 0;
+	rh->nonempty = 0;
+	rh->values = (uint64_t*)malloc(maxSize * sizeof(uint64_t));
+	rh->next = (int*)malloc(maxSize * sizeof(int));
+	rh->prev = (int*)malloc(maxSize * sizeof(int));
+	rh->bucket = (signed char*)malloc(maxSize * sizeof(signed char));
+	if (!rh->values || !rh->next || !rh->prev || !rh->bucket) {
+		printf("Memory error allocating radix heap arrays.");
+		abort();
+	}
+
+	for (int i = 0; i < maxSize; i++)
+		rh->bucket[i] = RADIXHEAP_NONE;
+
+	for (int b = 0; b < RADIXHEAP_BUCKETS; b++)
+		rh->head[b] = RADIXHEAP_NONE;
+
+	return rh;
+}
+
+/*
+ * Checks if the heap is empty.
+ */
+int radixheap_isempty( const struct radixheap* rh ) {
+	return rh->sz == 0;
+}
+
+/*
+ * Gets the number of elements on the heap.
+ */
+int radixheap_getsize( const struct radixheap* rh ) {
+	return rh->sz;
+}
+
+/*
+ * Checks key index range.
+ */
+void radixheap_checkki( const struct radixheap* rh, int ki )
+{
+	if (ki < 0 || ki >= rh->N) {
+		printf("Error: radix heap key index %d out of range!", ki);
+		abort();
+	}
+}
+
+/*
+ * Checks if an element with a given key index exists in the heap or not.
+ */
+int radixheap_contains( const struct radixheap* rh, int ki ) {
+	radixheap_checkki(rh, ki);
+	return rh->bucket[ki] != RADIXHEAP_NONE;
+}
+
+/*
+ * Returns priority of a given key index.
+ */
+uint64_t radixheap_valueof( const struct radixheap* rh, int ki ) {
+	return rh->values[ki];
+}
+
+/*
+ * Gets the bucket of a priority (relative to last extracted minimum).
+ */
+int radixheap_bucketof( const struct radixheap* rh, uint64_t value ) {
+	return (value == rh->last) ? 0 : 64 - __builtin_clzll(value ^ rh->last);
+}
+
+/*
+ * Links key index at the head of a bucket.
+ */
+void radixheap_link( struct radixheap* rh, int ki, int b )
+{
+	rh->bucket[ki] = (signed char)b;
+	rh->prev[ki] = RADIXHEAP_NONE;
+	rh->next[ki] = rh->head[b];
+	if (rh->head[b] != RADIXHEAP_NONE)
+		rh->prev[rh->head[b]] = ki;
+
+	rh->head[b] = ki;
+	if (b > 0)
+		rh->nonempty |= 1ULL << (b - 1);
+}
+
+/*
+ * Unlinks key index from its bucket.
+ */
+void radixheap_unlink( struct radixheap* rh, int ki )
+{
+	int b = rh->bucket[ki];
+	if (rh->prev[ki] != RADIXHEAP_NONE)
+		rh->next[rh->prev[ki]] = rh->next[ki];
+	else
+		rh->head[b] = rh->next[ki];
+
+	if (rh->next[ki] != RADIXHEAP_NONE)
+		rh->prev[rh->next[ki]] = rh->prev[ki];
+
+	if (b > 0 && rh->head[b] == RADIXHEAP_NONE)
+		rh->nonempty &= ~(1ULL << (b - 1));
+
+	rh->bucket[ki] = RADIXHEAP_NONE;
+}
+
+/*
+ * Checks priority against last extracted minimum.
+ */
+void radixheap_checkvalue( const struct radixheap* rh, uint64_t value )
+{
+	if (value < rh->last) {
+		printf("Error: radix heap priority is lesser than last extracted minimum!");
+		abort();
+	}
+}
+
+/*
+ * Inserts key index 'ki' with priority 'value'.
+ * Note: 'ki' must not be in the heap and 'value' must not be lesser than the last
+ * extracted minimum, an error will be throw.
+ */
+void radixheap_insert( struct radixheap* rh, int ki, uint64_t value )
+{
+	if (radixheap_contains(rh, ki)) {
+		printf("Error: radix heap already contains key index %d!", ki);
+		abort();
+	}
+
+	radixheap_checkvalue(rh, value);
+	rh->values[ki] = value;
+	radixheap_link(rh, ki, radixheap_bucketof(rh, value));
+	rh->sz++;
+}
+
+/*
+ * Decreases priority of key index 'ki' to 'value'.
+ * Note: 'value' must not be lesser than the last extracted minimum.
+ */
+void radixheap_decrease( struct radixheap* rh, int ki, uint64_t value )
+{
+	if (!radixheap_contains(rh, ki)) {
+		printf("Error: radix heap does not contain key index %d!", ki);
+		abort();
+	}
+
+	radixheap_checkvalue(rh, value);
+	rh->values[ki] = value;
+
+	int b = radixheap_bucketof(rh, value);
+	if (b != rh->bucket[ki]) {
+		radixheap_unlink(rh, ki);
+		radixheap_link(rh, ki, b);
+	}
+}
+
+/*
+ * Fills bucket 0 if it is empty: smallest priority of the first non empty bucket
+ * becomes the last minimum and elements of that bucket move to lower buckets.
+ */
+void radixheap_pull( struct radixheap* rh )
+{
+	if (rh->head[0] != RADIXHEAP_NONE || rh->nonempty == 0)
+		return;
+
+	int b = __builtin_ctzll(rh->nonempty) + 1;
+
+	uint64_t min = rh->values[rh->head[b]];
+	for (int ki = rh->next[rh->head[b]]; ki != RADIXHEAP_NONE; ki = rh->next[ki])
+		if (rh->values[ki] < min)
+			min = rh->values[ki];
+
+	rh->last = min;
+
+	int ki = rh->head[b];
+	rh->head[b] = RADIXHEAP_NONE;
+	rh->nonempty &= ~(1ULL << (b - 1));
+	while (ki != RADIXHEAP_NONE) {
+		int next = rh->next[ki];
+		radixheap_link(rh, ki, radixheap_bucketof(rh, rh->values[ki]));
+		ki = next;
+	}
+}
+
+/*
+ * Returns the key index with minimum priority without removing it (-1 if empty).
+ */
+int radixheap_peekkeyindex( struct radixheap* rh )
+{
+	radixheap_pull(rh);
+	return rh->head[0];
+}
+
+/*
+ * Returns the minimum priority (heap must not be empty).
+ */
+uint64_t radixheap_peekvalue( struct radixheap* rh )
+{
+	radixheap_pull(rh);
+	return rh->last;
+}
+
+/*
+ * Removes the key index with minimum priority.
+ * Returns the removed key index (-1 if heap is empty).
+ */
+int radixheap_extractkeyindex( struct radixheap* rh )
+{
+	radixheap_pull(rh);
+	int ki = rh->head[0];
+	if (ki != RADIXHEAP_NONE) {
+		radixheap_unlink(rh, ki);
+		rh->sz--;
+	}
+
+	return ki;
+}
+
+/*
+ * Removes all elements and resets last minimum to zero, in O(sz).
+ */
+void radixheap_clear( struct radixheap* rh )
+{
+	for (int b = 0; b < RADIXHEAP_BUCKETS; b++) {
+		for (int ki = rh->head[b]; ki != RADIXHEAP_NONE; ki = rh->next[ki])
+			rh->bucket[ki] = RADIXHEAP_NONE;
+
+		rh->head[b] = RADIXHEAP_NONE;
+	}
+
+	rh->sz = 0;
+	rh->last = 0;
+	rh->nonempty = 0;
+}
+
+/*
+ * Releases the heap from memory.
+ */
+void radixheap_destroy( struct radixheap* rh )
+{
+	free(rh->values);
+	free(rh->next);
+	free(rh->prev);
+	free(rh->bucket);
+	free(rh);
+}
@@ -0,0 +1,132 @@
+/*****************************************************************************
+ * radixheap.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for an indexed radix heap (monotone priority queue of
+ *  			 unsigned integer priorities).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A radix heap only accepts priorities not lesser than the last extracted minimum
+ *  ('last'), which always holds in Dijkstra with non-negative integer weights. Elements
+ *  are kept in 65 buckets by the highest bit in which their priority differs from
+ *  'last':
+ *
+ *  	bucket(p) = 0 if p == last, else 1 + index of highest bit of (p XOR last)
+ *
+ *  Bucket 0 holds the elements equal to the minimum. When it is empty, extract finds
+ *  the first non empty bucket, makes its smallest priority the new 'last' and moves
+ *  its elements to lower buckets (they all differ from the new 'last' in lower bits).
+ *  An element only moves down, at most 64 times, so operations are O(1) amortized
+ *  (O(log C) for priorities up to C) with no compares between elements other than
+ *  the minimum search of one bucket.
+ *
+ *  Same indexed model as the other indexed priority queues (see indmindaryheap.h): each
+ *  element has a key index 'ki' in the domain [0, N), buckets are doubly linked lists of
+ *  key indexes in arrays, so nothing is allocated after creation and decrease key
+ *  (move to another bucket) is O(1).
+ *
+ * 		  Time complexity by operation
+ *	-----------------------------------------
+ * 	|	contains(ki) 			| O(1)		|
+ * 	|	insert(ki, value) 		| O(1)		|
+ * 	|	decrease(ki, value) 	| O(1)		|
+ * 	|	extractkeyindex 		| O(log C)*	|
+ * 	|	clear			 		| O(sz)		|
+ *	-----------------------------------------
+ *	* amortized, C: largest priority
+ *
+ *  Source: R. Ahuja, K. Mehlhorn, J. Orlin, R. Tarjan, "Faster algorithms for the
+ *  		 shortest path problem", JACM 37 (1990).
+ *  		 http://ssp.impulsetrain.com/radix-heap.html
+ *
+ *******************************************************************************/
+
+#ifndef RADIXHEAP_H_
+	#define RADIXHEAP_H_
+
+	#include <stdlib.h>
+	#include <stdint.h>
+
+	#define RADIXHEAP_BUCKETS 65		// bucket 0 (equal to last) and one per bit
+
+	struct radixheap {
+		int N;							// Maximum number of elements (key indexes in [0, N)).
+		int sz;							// Current number of elements in the heap.
+		uint64_t last;					// Last extracted minimum (priorities are >= last).
+		uint64_t nonempty;				// Bit 'i - 1' set if bucket 'i' (i > 0) has elements.
+		uint64_t* values;				// Priority of each key index.
+		int* next;						// Next key index in the same bucket (-1: none).
+		int* prev;						// Previous key index in the same bucket (-1: none).
+		signed char* bucket;			// Bucket of each key index (-1 if not in heap).
+		int head[RADIXHEAP_BUCKETS];	// First key index of each bucket (-1 if empty).
+	};
+
+	/*
+	 * Initializes an indexed radix heap with a maximum capacity of maxSize.
+	 */
+	struct radixheap* radixheap_create( int maxSize );
+
+	/*
+	 * Checks if the heap is empty.
+	 */
+	int radixheap_isempty( const struct radixheap* rh );
+
+	/*
+	 * Gets the number of elements on the heap.
+	 */
+	int radixheap_getsize( const struct radixheap* rh );
+
+	/*
+	 * Checks if an element with a given key index exists in the heap or not.
+	 */
+	int radixheap_contains( const struct radixheap* rh, int ki );
+
+	/*
+	 * Returns priority of a given key index.
+	 */
+	uint64_t radixheap_valueof( const struct radixheap* rh, int ki );
+
+	/*
+	 * Inserts key index 'ki' with priority 'value'.
+	 * Note: 'ki' must not be in the heap and 'value' must not be lesser than the last
+	 * extracted minimum, an error will be throw.
+	 */
+	void radixheap_insert( struct radixheap* rh, int ki, uint64_t value );
+
+	/*
+	 * Decreases priority of key index 'ki' to 'value'.
+	 * Note: 'value' must not be lesser than the last extracted minimum.
+	 */
+	void radixheap_decrease( struct radixheap* rh, int ki, uint64_t value );
+
+	/*
+	 * Returns the key index with minimum priority without removing it (-1 if empty).
+	 */
+	int radixheap_peekkeyindex( struct radixheap* rh );
+
+	/*
+	 * Returns the minimum priority (heap must not be empty).
+	 */
+	uint64_t radixheap_peekvalue( struct radixheap* rh );
+
+	/*
+	 * Removes the key index with minimum priority.
+	 * Returns the removed key index (-1 if heap is empty).
+	 */
+	int radixheap_extractkeyindex( struct radixheap* rh );
+
+	/*
+	 * Removes all elements and resets last minimum to zero, in O(sz).
+	 */
+	void radixheap_clear( struct radixheap* rh );
+
+	/*
+	 * Releases the heap from memory.
+	 */
+	void radixheap_destroy( struct radixheap* rh );
+
+#endif /* RADIXHEAP_H_ */
@@ -0,0 +1,489 @@
+/*
+ * radixtrie.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of a compressed trie (radix tree / Patricia trie).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "radixtrie.h"
+#include "arraylist.h"
+
+/*
+ * Creates a new node with edge label 'label' of length 'labellen'.
+ */
+struct radixtrienode* radixtrie_create_node( struct radixtrie* t, const unsigned char* label,
+											 size_t labellen )
+{
+	struct radixtrienode* result = (struct radixtrienode*)malloc(sizeof(*result) + labellen);
+	if (!result) {
+		printf("Memory error: failed to allocate memory for radixtrienode structure!");
+		abort();
+	}
+
+	result->terminal = false;
+	result->nchildren = 0;
+	result->labellen = (uint32_t)labellen;
+	result->keys = NULL;
+	result->children = NULL;
+	if (labellen > 0)
+		memcpy(result->label, label, labellen);
+	t->nodes++;
+	return result;
+}
+
+/*
+ * Releases a node (not its children) from memory.
+ */
+void radixtrie_free_node(struct radixtrie* t, struct radixtrienode* node)
+{
+	free(node->keys);
+	free(node->children);
+	free(node);
+	t->nodes--;
+}
+
+/*
+ * Creates a compressed trie instance.
+ */
+struct radixtrie* radixtrie_create()
+{
+	struct radixtrie* result = (struct radixtrie*)malloc(sizeof(*result));
+	if (!result) {
+		printf("Memory error: failed to allocate memory for radixtrie structure!");
+		abort();
+	}
+
+	result->size = 0;
+	result->nodes = 0;
+	result->root = radixtrie_create_node(result, NULL, 0);
+	return result;
+}
+
+/*
+ * Searches child of a node by first char of its label (binary search over keys).
+ * Returns index of child if found, otherwise -1 and 'pos' is set with the index
+ * where a child with that char must be inserted.
+ */
+int radixtrie_findchild(const struct radixtrienode* node, unsigned char c, int* pos)
+{
+	int lo = 0;
+	int hi = node->nchildren - 1;
+	while (lo <= hi) {
+		int mid = (lo + hi) >> 1;
+		if (node->keys[mid] == c)
+			return mid;
+		else if (node->keys[mid] < c)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+
+	if (pos) *pos = lo;
+	return -1;
+}
+
+/*
+ * Resizes children arrays of a node to a new number of children.
+ */
+void radixtrie_resize_children(struct radixtrienode* node, int nchildren)
+{
+	if (nchildren == 0) {
+		free(node->keys);
+		free(node->children);
+		node->keys = NULL;
+		node->children = NULL;
+	}
+	else {
+		unsigned char* keys = (unsigned char*)realloc(node->keys, nchildren);
+		struct radixtrienode** children = (struct radixtrienode**)realloc(node->children,
+											nchildren * sizeof(struct radixtrienode*));
+		if (!keys || !children) {
+			printf("Memory error: failed to allocate memory for radixtrienode children!");
+			abort();
+		}
+
+		node->keys = keys;
+		node->children = children;
+	}
+
+	node->nchildren = (uint16_t)nchildren;
+}
+
+/*
+ * Inserts a child in a node at index 'pos' (keeps keys sorted).
+ */
+void radixtrie_add_child(struct radixtrienode* node, int pos, struct radixtrienode* child)
+{
+	int n = node->nchildren;
+	radixtrie_resize_children(node, n + 1);
+	memmove(&node->keys[pos + 1], &node->keys[pos], n - pos);
+	memmove(&node->children[pos + 1], &node->children[pos],
+			(n - pos) * sizeof(struct radixtrienode*));
+	node->keys[pos] = child->label[0];
+	node->children[pos] = child;
+}
+
+/*
+ * Removes child at index 'pos' from a node.
+ */
+void radixtrie_remove_child(struct radixtrienode* node, int pos)
+{
+	int n = node->nchildren;
+	memmove(&node->keys[pos], &node->keys[pos + 1], n - pos - 1);
+	memmove(&node->children[pos], &node->children[pos + 1],
+			(n - pos - 1) * sizeof(struct radixtrienode*));
+	radixtrie_resize_children(node, n - 1);
+}
+
+/*
+ * Splits the node at 'slot' after the first 'k' chars of its label: the node keeps the
+ * first 'k' chars and a new child takes the remaining chars, the word flag and children.
+ * Returns the (reallocated) node, also stored in 'slot'.
+ */
+struct radixtrienode* radixtrie_split( struct radixtrie* t, struct radixtrienode** slot,
+									   size_t k )
+{
+	struct radixtrienode* node = *slot;
+	struct radixtrienode* tail = radixtrie_create_node(t, node->label + k, node->labellen - k);
+	tail->terminal = node->terminal;
+	tail->nchildren = node->nchildren;
+	tail->keys = node->keys;
+	tail->children = node->children;
+
+	struct radixtrienode* head = (struct radixtrienode*)realloc(node, sizeof(*node) + k);
+	if (!head) {
+		printf("Memory error: failed to allocate memory for radixtrienode structure!");
+		abort();
+	}
+
+	head->terminal = false;
+	head->labellen = (uint32_t)k;
+	head->nchildren = 0;
+	head->keys = NULL;
+	head->children = NULL;
+	radixtrie_add_child(head, 0, tail);
+	*slot = head;
+	return head;
+}
+
+/*
+ * Merges the node at 'slot' (no word ending and a single child) with its child.
+ */
+void radixtrie_merge(struct radixtrie* t, struct radixtrienode** slot)
+{
+	struct radixtrienode* node = *slot;
+	struct radixtrienode* child = node->children[0];
+	struct radixtrienode* merged = (struct radixtrienode*)malloc(sizeof(*merged)
+										+ node->labellen + child->labellen);
+	if (!merged) {
+		printf("Memory error: failed to allocate memory for radixtrienode structure!");
+		abort();
+	}
+
+	merged->terminal = child->terminal;
+	merged->nchildren = child->nchildren;
+	merged->labellen = node->labellen + child->labellen;
+	merged->keys = child->keys;
+	merged->children = child->children;
+	memcpy(merged->label, node->label, node->labellen);
+	memcpy(merged->label + node->labellen, child->label, child->labellen);
+
+	free(node->keys);
+	free(node->children);
+	free(node);
+	free(child);
+	t->nodes--;		// two nodes become one
+	*slot = merged;
+}
+
+/*
+ * Inserts new text in the trie.
+ * Returns 'true' if succeeded, 'false' otherwise.
+ * Note: Duplicated words and empty words are not allowed.
+ */
+bool radixtrie_insert(struct radixtrie* t, char* signedtext)
+{
+	// forces all characters to be unsigned (no negative chars)
+	unsigned char* text = (unsigned char*)signedtext;
+	size_t len = strlen(signedtext);
+	if (len == 0)
+		return false;
+
+	struct radixtrienode* current = t->root;
+	size_t i = 0;
+	while (i < len) {
+		int pos = 0;
+		int c = radixtrie_findchild(current, text[i], &pos);
+		if (c < 0) {
+			// no child shares next char, rest of the word goes to a new leaf
+			struct radixtrienode* leaf = radixtrie_create_node(t, text + i, len - i);
+			leaf->terminal = true;
+			radixtrie_add_child(current, pos, leaf);
+			t->size++;
+			return true;
+		}
+
+		struct radixtrienode* child = current->children[c];
+		size_t k = 1;	// first char already matches
+		while (k < child->labellen && i + k < len && child->label[k] == text[i + k])
+			k++;
+
+		if (k < child->labellen)
+			child = radixtrie_split(t, &current->children[c], k);
+
+		current = child;
+		i += k;
+	}
+
+	// not duplicated text?
+	if (current->terminal)
+		return false;
+
+	current->terminal = true;
+	t->size++;
+	return true;
+}
+
+/*
+ * Searches for a word in the trie.
+ * Return 'true' if succeeded,'false' otherwise.
+ */
+bool radixtrie_search(const struct radixtrie* t, char* signedtext)
+{
+	unsigned char* text = (unsigned char*)signedtext;
+	size_t len = strlen(signedtext);
+	const struct radixtrienode* current = t->root;
+	size_t i = 0;
+
+	while (i < len) {
+		int c = radixtrie_findchild(current, text[i], NULL);
+		if (c < 0)
+			return false;
+
+		current = current->children[c];
+		if (current->labellen > len - i ||
+			memcmp(current->label, text + i, current->labellen) != 0)
+			return false;
+
+		i += current->labellen;
+	}
+
+	return (i > 0) && current->terminal;
+}
+
+/*
+ * Deletes a word from the trie.
+ * Returns 'true' if succeeded,'false' otherwise.
+ * Note: removes the node of the word if it has no children and merges with their
+ * 		 single child the nodes left without word and with only one child.
+ */
+bool radixtrie_delete(struct radixtrie* t, char* signedtext)
+{
+	unsigned char* text = (unsigned char*)signedtext;
+	size_t len = strlen(signedtext);
+	struct radixtrienode** slot = &t->root;			// slot of current node
+	struct radixtrienode** parentslot = NULL;		// slot of parent node
+	int index = -1;									// index of current node in parent
+	size_t i = 0;
+
+	while (i < len) {
+		struct radixtrienode* node = *slot;
+		int c = radixtrie_findchild(node, text[i], NULL);
+		if (c < 0)
+			return false;
+
+		struct radixtrienode* child = node->children[c];
+		if (child->labellen > len - i ||
+			memcmp(child->label, text + i, child->labellen) != 0)
+			return false;
+
+		parentslot = slot;
+		slot = &node->children[c];
+		index = c;
+		i += child->labellen;
+	}
+
+	struct radixtrienode* node = *slot;
+	if (i == 0 || !node->terminal)
+		return false;	// word not found in the trie
+
+	node->terminal = false;
+	t->size--;
+
+	if (node->nchildren == 1)
+		radixtrie_merge(t, slot);
+	else if (node->nchildren == 0) {
+		struct radixtrienode* parent = *parentslot;
+		radixtrie_remove_child(parent, index);
+		radixtrie_free_node(t, node);
+
+		// parent may be left as a chain node (root is never merged)
+		if (parent != t->root && !parent->terminal && parent->nchildren == 1)
+			radixtrie_merge(t, parentslot);
+	}
+
+	return true;
+}
+
+/*
+ * Helper recursive function to collect words under a node ('buffer' holds the chars
+ * of the path until the node, of length 'length').
+ */
+void radixtrie_getwords_rec( const struct radixtrienode* node, unsigned char** buffer,
+							 size_t* capacity, size_t length, struct arraylist* a )
+{
+	if (length + node->labellen + 1 > *capacity) {
+		size_t newcapacity = *capacity * 2;
+		while (length + node->labellen + 1 > newcapacity)
+			newcapacity *= 2;
+
+		unsigned char* newbuffer = (unsigned char*)realloc(*buffer, newcapacity);
+		if (!newbuffer) {
+			printf("Memory error: failed to allocate memory for radixtrie word buffer!");
+			abort();
+		}
+
+		*buffer = newbuffer;
+		*capacity = newcapacity;
+	}
+
+	memcpy(*buffer + length, node->label, node->labellen);
+	length += node->labellen;
+
+	if (node->terminal) {
+		unsigned char* word = (unsigned char*)malloc(length + 1);
+		if (!word) {
+			printf("Memory error: failed to allocate memory for radixtrie word!");
+			abort();
+		}
+
+		memcpy(word, *buffer, length);
+		word[length] = 0;
+		arraylist_add(a, word);
+	}
+
+	for (int i = 0; i < node->nchildren; ++i)
+		radixtrie_getwords_rec(node->children[i], buffer, capacity, length, a);
+}
+
+/*
+ * Gets a list of words that shares a given prefix (in ascending order).
+ * Returns an arraylist with founded words, 'NULL' if no word found.
+ * Note: words are new allocated strings, to be released by the caller.
+ */
+struct arraylist* radixtrie_getwords(const struct radixtrie* t, char* prefix)
+{
+	unsigned char* text = (unsigned char*)prefix;
+	size_t len = strlen(prefix);
+	const struct radixtrienode* current = t->root;
+	size_t i = 0;		// chars of prefix matched until 'current' (label excluded)
+
+	// find the node whose path contains the whole prefix
+	while (i < len) {
+		int c = radixtrie_findchild(current, text[i], NULL);
+		if (c < 0)
+			return NULL;
+
+		const struct radixtrienode* child = current->children[c];
+		size_t k = 1;
+		while (k < child->labellen && i + k < len && child->label[k] == text[i + k])
+			k++;
+
+		if (i + k < len && k < child->labellen)
+			return NULL;	// prefix and label differ
+
+		current = child;
+		if (i + k == len)
+			break;			// prefix ends inside (or at end of) current label
+
+		i += k;
+	}
+
+	if (t->size == 0)
+		return NULL;
+
+	// path until 'current' is the first 'i' chars of prefix
+	size_t capacity = i + 64;
+	unsigned char* buffer = (unsigned char*)malloc(capacity);
+	if (!buffer) {
+		printf("Memory error: failed to allocate memory for radixtrie word buffer!");
+		abort();
+	}
+
+	memcpy(buffer, text, i);
+	struct arraylist* result = arraylist_create_capacity(20);
+	radixtrie_getwords_rec(current, &buffer, &capacity, i, result);
+	free(buffer);
+	return result;
+}
+
+/*
+ * Gets the number of words in the trie.
+ */
+size_t radixtrie_getsize(const struct radixtrie* t) {
+	return t->size;
+}
+
+/*
+ * Helper recursive function to sum bytes allocated by a node and its descendants.
+ */
+size_t radixtrie_memsize_rec(const struct radixtrienode* node)
+{
+	size_t result = sizeof(*node) + node->labellen
+					+ node->nchildren * (sizeof(unsigned char) + sizeof(struct radixtrienode*));
+	for (int i = 0; i < node->nchildren; ++i)
+		result += radixtrie_memsize_rec(node->children[i]);
+
+	return result;
+}
+
+/*
+ * Gets the number of bytes allocated by trie nodes and trie structure.
+ */
+size_t radixtrie_memsize(const struct radixtrie* t) {
+	return sizeof(*t) + radixtrie_memsize_rec(t->root);
+}
+
+/*
+ * Prints words of trie in ascending order.
+ */
+void radixtrie_print(const struct radixtrie* t)
+{
+	if (t->size == 0) {
+		printf("TRIE EMPTY!");
+		return;
+	}
+
+	struct arraylist* words = radixtrie_getwords(t, "");
+	for (int i = 0; i < words->length; ++i) {
+		char* word = (char*)arraylist_get_item_at(words, i);
+		printf("Word: '%s'\n", word);
+		free(word);
+	}
+
+	arraylist_destroy(words);
+}
+
+/*
+ * Releases trie nodes recursively.
+ */
+void radixtrie_destroy_rec(struct radixtrie* t, struct radixtrienode* node)
+{
+	for (int i = 0; i < node->nchildren; ++i)
+		radixtrie_destroy_rec(t, node->children[i]);
+
+	radixtrie_free_node(t, node);
+}
+
+/*
+ * Release trie from memory.
+ */
+void radixtrie_destroy(struct radixtrie* t) {
+	radixtrie_destroy_rec(t, t->root);
+	free(t);
+}
@@ -0,0 +1,130 @@
+/*****************************************************************************
+ * radixtrie.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a compressed trie (radix tree / Patricia trie) of strings.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  The trie in trie.h allocates an array of 'array_size' child pointers in every node,
+ *  even in the (many) nodes with a single child, and one node per character of a word:
+ *  with a 256 chars alphabet a node takes more than 2KB.
+ *
+ *  The compressed trie stores the same words with two changes:
+ *
+ *  	- chains of nodes with a single child and no word ending in them are collapsed
+ *  	  in one node, the chars of the chain become the edge label of the node (kept in
+ *  	  the node allocation). Every node (but root) either ends a word or has at least
+ *  	  2 children, so there are less than 2 * n nodes for n words;
+ *
+ *  	- children are stored sparsely in two exact size arrays sorted by the first char
+ *  	  of their label: the chars ('keys') and the child pointers. A child is found by
+ *  	  binary search over the keys, which do not touch the child nodes.
+ *
+ *  	  "hel", "hell", "hello", "help", "helps", "helping"
+ *
+ *  	             (root)
+ *  	               | "hel"*
+ *  	         --------------
+ *  	        | "l"*         | "p"*
+ *  	        | "o"*      ---------
+ *  	                   | "ing"*  | "s"*
+ *  	   * a word ends in the node
+ *
+ *  Insertion may split a node: the label is cut where it differs from the word and the
+ *  node keeps the common part. Deletion merges back a node left with a single child and
+ *  no word ending in it. Nodes keep the raw bytes of the words, so any alphabet can be
+ *  used (no index functions) and words are visited in byte order.
+ *
+ *  Operations have the same interface than trie.h / trieext.h: insert, search and
+ *  delete in O(L) (L: length of the word) and prefix search (auto complete) returning
+ *  an arraylist of new allocated strings.
+ *
+ *  Source: D. Morrison, "PATRICIA - Practical Algorithm To Retrieve Information Coded in
+ *  		 Alphanumeric", JACM 15 (1968).
+ *  		 https://en.wikipedia.org/wiki/Radix_tree
+ *
+ *******************************************************************************/
+
+#ifndef RADIXTRIE_H_
+	#define RADIXTRIE_H_
+
+	#include <stdlib.h>
+	#include <stdint.h>
+	#include <stdbool.h>
+	#include "arraylist.h"
+
+	// declares a compressed trie node
+	struct radixtrienode {
+		bool terminal;						// a word ends in this node
+		uint16_t nchildren;					// number of children (up to 256)
+		uint32_t labellen;					// length of edge label
+		unsigned char* keys;				// first char of each child label (sorted)
+		struct radixtrienode** children;	// children, same order as 'keys'
+		unsigned char label[];				// edge label (chars from parent to node)
+	};
+
+	// declares compressed trie structure
+	struct radixtrie {
+		struct radixtrienode* root;		// root node (empty label)
+		size_t size;					// number of words
+		size_t nodes;					// number of nodes (root included)
+	};
+
+	/*
+	 * Creates a compressed trie instance.
+	 */
+	struct radixtrie* radixtrie_create();
+
+	/*
+	 * Inserts new text in the trie.
+	 * Returns 'true' if succeeded, 'false' otherwise.
+	 * Note: Duplicated words and empty words are not allowed.
+	 */
+	bool radixtrie_insert(struct radixtrie* t, char* signedtext);
+
+	/*
+	 * Searches for a word in the trie.
+	 * Return 'true' if succeeded,'false' otherwise.
+	 */
+	bool radixtrie_search(const struct radixtrie* t, char* signedtext);
+
+	/*
+	 * Deletes a word from the trie.
+	 * Returns 'true' if succeeded,'false' otherwise.
+	 * Note: removes the node of the word if it has no children and merges with their
+	 * 		 single child the nodes left without word and with only one child.
+	 */
+	bool radixtrie_delete(struct radixtrie* t, char* signedtext);
+
+	/*
+	 * Gets a list of words that shares a given prefix (in ascending order).
+	 * Returns an arraylist with founded words, 'NULL' if no word found.
+	 * Note: words are new allocated strings, to be released by the caller.
+	 */
+	struct arraylist* radixtrie_getwords(const struct radixtrie* t, char* prefix);
+
+	/*
+	 * Gets the number of words in the trie.
+	 */
+	size_t radixtrie_getsize(const struct radixtrie* t);
+
+	/*
+	 * Gets the number of bytes allocated by trie nodes and trie structure.
+	 */
+	size_t radixtrie_memsize(const struct radixtrie* t);
+
+	/*
+	 * Prints words of trie in ascending order.
+	 */
+	void radixtrie_print(const struct radixtrie* t);
+
+	/*
+	 * Release trie from memory.
+	 */
+	void radixtrie_destroy(struct radixtrie* t);
+
+#endif /* RADIXTRIE_H_ */
@@ -115,28 +115,57 @@
  */
 
 #include <stdlib.h>
+#include <assert.h>
 #include "redblacktree.h"
 #include "linkedlistqueue.h"
+#include "taskpool.h"
 #include <stdio.h>
 #include <string.h>
 
+// rotations done by the calling thread (rotations do not know their tree, so insert and
+// delete count the difference). Only updated when built with CDATASTRUCT_STATS.
+DATASTATS_ONLY(static __thread size_t rbtree_rotations = 0;)
+
 /*
  * Function to create a new red-black tree.
  * Returns pointer to created red-black tree instance is succeeded, NULL otherwise.
  */
 struct rbtree* rbtree_create( void* rootdata, rbtree_calcdatasize calcdatasizefunc,
 							  rbtree_cmp comparefunc, rbtree_freedata freedatafunc,
-							  rbtree_printdata printdatafunc, rbtree_copydata copydatafunc)
+							  rbtree_printdata printdatafunc, rbtree_copydata copydatafunc,
+							  struct nodearena* arena )
+{
+	return rbtree_create_allocator( rootdata, calcdatasizefunc, comparefunc, freedatafunc,
+									printdatafunc, copydatafunc, arena, NULL );
+}
+
+/*
+ * Function to create a new red black tree whose structure and nodes (when
+ * 'arena' is NULL) are allocated by 'allocator' (see allocator.h, NULL: C
+ * library). Nodes of an arena come from the allocator of the arena.
+ * Returns pointer to created red black tree instance is succeeded, NULL otherwise.
+ */
+struct rbtree* rbtree_create_allocator( void* rootdata, rbtree_calcdatasize calcdatasizefunc,
+										rbtree_cmp comparefunc, rbtree_freedata freedatafunc,
+										rbtree_printdata printdatafunc, rbtree_copydata copydatafunc,
+										struct nodearena* arena, const struct allocator* allocator )
 {
-	struct rbtree* result = (struct rbtree*)malloc(sizeof(*result));
+	assert((arena == NULL) || (arena->nodesize >= sizeof(struct rbtreenode)));
+
+	struct rbtree* result = (struct rbtree*)allocator_alloc(allocator, sizeof(*result));
 	if (result != NULL) {
+		result->arena = arena;
+		result->allocator = allocator;
+		result->ranked = 0;
+		result->counters = (struct rbtree_counters){ 0 };
+
 		if (rootdata != NULL)
-			result->root = rbtree_createnode(NULL, rootdata);
+			result->root = rbtree_createnode(result, NULL, rootdata);
 		else
 			result->root = NULL;
 
 		if ((rootdata != NULL) && (result->root == NULL)) {
-			free(result);
+			allocator_free(allocator, result, sizeof(*result));
 			result = NULL;
 		}
 		else {
@@ -154,20 +183,37 @@ struct rbtree* rbtree_create( void* rootdata, rbtree_calcdatasize calcdatasizefu
 /*
  * Function to create a new red-black tree node.
  */
-struct rbtreenode* rbtree_createnode(struct rbtreenode* parent, void* data)
+struct rbtreenode* rbtree_createnode(struct rbtree* tree, struct rbtreenode* parent, void* data)
 {
-	struct rbtreenode* result = (struct rbtreenode*)malloc(sizeof(*result));
+	struct rbtreenode* result = NULL;
+	if (tree->arena != NULL)
+		result = (struct rbtreenode*)nodearena_alloc(tree->arena);
+	else
+		result = (struct rbtreenode*)allocator_alloc(tree->allocator, sizeof(*result));
+
 	if (result != NULL)
 	{
 		result->data = data;
 		result->c = RB_RED;		// red by default
 		result->parent = parent;
 		result->left = result->right = NULL;
+		result->size = 1;
 	}
 
 	return result;
 }
 
+/*
+ * Releases a given tree node (not its data) to the arena or to the heap.
+ * */
+void rbtree_freenode(struct rbtree* t, struct rbtreenode* node)
+{
+	if (t->arena != NULL)
+		nodearena_free(t->arena, node);
+	else
+		allocator_free(t->allocator, node, sizeof(*node));
+}
+
 /*
  * Releases a given avl tree node and its data from memory.
  * */
@@ -178,7 +224,7 @@ void rbtree_destroynode(struct rbtree* t, struct rbtreenode* node)
 
 	node->parent = node->left = node->right = NULL;
 	node->data = NULL;
-	free(node);
+	rbtree_freenode(t, node);
 }
 
 /*
@@ -197,11 +243,12 @@ void rbtree_swapcolors(struct rbtreenode *x1, struct rbtreenode *x2) {
  *  	 need callback function 'tree->calcdatasize(u->data)'
  */
 void rbtree_swapvalues(struct rbtree* tree, struct rbtreenode* u, struct rbtreenode* v) {
-	void* udata = (void*)malloc(tree->calcdatasize(u->data));
+	size_t size = tree->calcdatasize(u->data);
+	void* udata = allocator_alloc(tree->allocator, size);
 	tree->copydata(udata, u->data);
 	tree->copydata(u->data, v->data);
 	tree->copydata(v->data, udata);
-	free(udata);
+	allocator_free(tree->allocator, udata, size);
 }
 
 /*
@@ -299,6 +346,13 @@ struct rbtreenode* rbtree_BSTreplace(struct rbtreenode* x)
 		return x->right;
 }
 
+/*
+ * Gets the subtree size of a node (0 for NULL).
+ */
+size_t rbtree_nodesize(const struct rbtreenode* node) {
+	return (node != NULL) ? node->size : 0;
+}
+
 /*
  * Rotates temp node to the right.
  * Returns new root.
@@ -319,6 +373,7 @@ struct rbtreenode* rbtree_rightrotate(struct rbtreenode* temp, struct rbtreenode
 {
 	struct rbtreenode* result = root;
     struct rbtreenode* left = temp->left;
+    DATASTATS_COUNT(rbtree_rotations);
 
     temp->left = left->right;
     if (temp->left)
@@ -333,6 +388,10 @@ struct rbtreenode* rbtree_rightrotate(struct rbtreenode* temp, struct rbtreenode
     left->right = temp;
     temp->parent = left;
 
+    // subtree sizes: rotated node has the old size of 'temp'
+    left->size = temp->size;
+    temp->size = 1 + rbtree_nodesize(temp->left) + rbtree_nodesize(temp->right);
+
     return result;
 }
 
@@ -356,6 +415,8 @@ struct rbtreenode* rbtree_leftrotate(struct rbtreenode* temp, struct rbtreenode*
 {
 	struct rbtreenode* result = root;
     struct rbtreenode* right = temp->right;
+    DATASTATS_COUNT(rbtree_rotations);
+
     temp->right = right->left;
     if (temp->right)
         temp->right->parent = temp;
@@ -370,6 +431,9 @@ struct rbtreenode* rbtree_leftrotate(struct rbtreenode* temp, struct rbtreenode*
     right->left = temp;
     temp->parent = right;
 
+    right->size = temp->size;
+    temp->size = 1 + rbtree_nodesize(temp->left) + rbtree_nodesize(temp->right);
+
     return result;
 }
 
@@ -544,7 +608,7 @@ int rbtree_insert(struct rbtree* tree, void* data)
 {
 	int result = 0;	// false
 	struct rbtreenode* root = tree->root;
-    struct rbtreenode* newNode = rbtree_createnode(NULL, data);
+    struct rbtreenode* newNode = rbtree_createnode(tree, NULL, data);
     if (root == NULL) {
     	// when root is null
     	// simply insert value at root
@@ -557,6 +621,7 @@ int rbtree_insert(struct rbtree* tree, void* data)
     	if (tree->compare(temp->data, data) == 0) {
     		// return if value already exists
     		printf("Tree insertion error: duplicated values are not allowed!");
+    		rbtree_freenode(tree, newNode);
     		return result;
 //    		return root;
     	}
@@ -572,11 +637,20 @@ int rbtree_insert(struct rbtree* tree, void* data)
     	else
     		temp->right = newNode;
 
+    	// new node is in the subtree of all nodes of its path (before rotations)
+    	if (tree->ranked)
+    		for (struct rbtreenode* p = temp; p != NULL; p = p->parent)
+    			p->size++;
+
     	// fix red red violation if exists
+    	DATASTATS_ONLY(size_t rotations = rbtree_rotations;)
     	root = rbtree_fixRedRed(root, newNode);
+    	DATASTATS_ADD(tree->counters.insertrotations, rbtree_rotations - rotations);
     	result = 1;		//true
     }
 
+    DATASTATS_COUNT(tree->counters.inserts);
+
     tree->root = root;
     return result;
 }
@@ -946,6 +1020,14 @@ void* rbtree_deletenode(struct rbtree* tree, struct rbtreenode* v)
 	int uvBlack = ((u == NULL || u->c == RB_BLACK) && (v->c == RB_BLACK));
 	struct rbtreenode* parent = v->parent;
 
+	// 'v' leaves the tree here (it has at most one child): it is no longer counted by
+	// its ancestors, nor by the rotations done while it is still linked
+	if (tree->ranked && (v->left == NULL || v->right == NULL)) {
+		for (struct rbtreenode* p = parent; p != NULL; p = p->parent)
+			p->size--;
+		v->size = 0;
+	}
+
 	if (u == NULL)
 	{
 		// u is NULL therefore v is leaf
@@ -973,7 +1055,7 @@ void* rbtree_deletenode(struct rbtree* tree, struct rbtreenode* v)
 		}
 
 		result = v->data;
-		free(v);
+		rbtree_freenode(tree, v);
 //		rbtree_destroynode(tree, v);
 		tree->root = root;
 		return result;
@@ -984,10 +1066,10 @@ void* rbtree_deletenode(struct rbtree* tree, struct rbtreenode* v)
 		if (v == root) {
 			result = v->data;
 			// v is root, assign the value of u to v, and delete u
-			tree->copydata(v, u);
-			//v->val = u->val;
+			v->data = u->data;
 			v->left = v->right = NULL; v->parent = NULL;
-			free(u);
+			v->size = 1;
+			rbtree_freenode(tree, u);
 //			rbtree_destroynode(tree, u);
 		} else {
 			// Detach v from tree and move u up
@@ -998,7 +1080,7 @@ void* rbtree_deletenode(struct rbtree* tree, struct rbtreenode* v)
 			}
 
 			result = v->data;
-			free(v);
+			rbtree_freenode(tree, v);
 //			rbtree_destroynode(tree, v);
 			u->parent = parent;
 
@@ -1050,7 +1132,10 @@ void* rbtree_delete(struct rbtree* tree, const void* val)	//, int* success)
 //    	return root;
     }
 
+    DATASTATS_ONLY(size_t rotations = rbtree_rotations;)
     result = rbtree_deletenode(tree, v);
+    DATASTATS_COUNT(tree->counters.deletes);
+    DATASTATS_ADD(tree->counters.deleterotations, rbtree_rotations - rotations);
 //    root = rbtree_deletenode(tree, v);
     return result;
 //    return root;
@@ -1343,6 +1428,89 @@ int rbtree_findNodeHeight(struct rbtree* tree, void* key)
 	return result;
 }
 
+// visit callback and argument of a parallel traversal
+struct rbtree_parallel_state {
+	rbtree_visitfunc visit;
+	void* arg;
+};
+
+/*
+ * Work item of a parallel traversal: visits every node of a subtree in pre-order,
+ * walking down and up with parent links (no stack).
+ * Note: Private function.
+ * */
+void rbtree_parallel_task(struct taskpool* pool, void* item, int worker, void* arg) {
+	struct rbtree_parallel_state* st = (struct rbtree_parallel_state*)arg;
+	struct rbtreenode* root = (struct rbtreenode*)item;
+	struct rbtreenode* prev = root->parent;
+	struct rbtreenode* cur = root;
+
+	while (cur != NULL) {
+		struct rbtreenode* next;
+		if (prev == cur->parent) {
+			// coming from above: visit, then go down
+			st->visit(cur->data, worker, st->arg);
+			next = (cur->left != NULL) ? cur->left
+				   : (cur->right != NULL) ? cur->right : cur->parent;
+		}
+		else if (prev == cur->left && cur->right != NULL)
+			next = cur->right;
+		else
+			next = cur->parent;
+
+		if (cur == root && next == root->parent)
+			break;			// subtree done
+
+		prev = cur;
+		cur = next;
+	}
+}
+
+/*
+ * Visits the nodes above 'depth' and collects the subtrees at 'depth'.
+ * Note: Private function.
+ * */
+void rbtree_parallel_split(struct rbtreenode* node, int depth, struct rbtree_parallel_state* st,
+						   void** items, size_t* n) {
+	if (node == NULL)
+		return;
+
+	if (depth == 0) {
+		items[(*n)++] = node;
+		return;
+	}
+
+	st->visit(node->data, 0, st->arg);
+	rbtree_parallel_split(node->left, depth - 1, st, items, n);
+	rbtree_parallel_split(node->right, depth - 1, st, items, n);
+}
+
+/*
+ * Calls 'visit' for the data of every node, in any order and concurrently on the
+ * threads of 'pool'. The tree is split in about 8 subtrees per thread (the nodes
+ * above them are visited by the calling thread), each subtree is a work item
+ * walked with parent links and idle workers steal the remaining ones.
+ * Note: the tree must not be changed during the traversal.
+ * */
+void rbtree_parallel_foreach(struct taskpool* pool, struct rbtree* tree,
+							 rbtree_visitfunc visit, void* arg) {
+	struct rbtree_parallel_state st = { .visit = visit, .arg = arg };
+	int depth = 0;
+	while (depth < 20 && ((size_t)1 << depth) < 8 * (size_t)taskpool_getthreads(pool))
+		depth++;
+
+	void** items = (void**)malloc(((size_t)1 << depth) * sizeof(void*));
+	if (items == NULL) {
+		printf("Memory error: failed to allocate memory for parallel traversal!\n");
+		abort();
+	}
+
+	size_t n = 0;
+	rbtree_parallel_split(tree->root, depth, &st, items, &n);
+	taskpool_run(pool, rbtree_parallel_task, &st, items, n);
+	free(items);
+}
+
 /*
  * Prints tree nodes data.
  * */
@@ -1426,6 +1594,291 @@ void rbtree_print(struct rbtree* tree, char* spaces) {
     }
 }
 
+/*
+ * Computes subtree sizes of all nodes of a subtree (postorder).
+ * Returns size of subtree.
+ */
+size_t rbtree_computesizes(struct rbtreenode* node)
+{
+	if (node == NULL)
+		return 0;
+
+	node->size = 1 + rbtree_computesizes(node->left) + rbtree_computesizes(node->right);
+	return node->size;
+}
+
+/*
+ * Enables order statistics: computes the subtree size of every node in O(n) and,
+ * from then on, insertions, deletions and rotations keep them up to date at
+ * O(1) extra cost per visited node. Does nothing if already enabled.
+ * */
+void rbtree_enable_ranks(struct rbtree* tree)
+{
+	if (tree->ranked)
+		return;
+
+	rbtree_computesizes(tree->root);
+	tree->ranked = 1;
+}
+
+/*
+ * Gets the number of elements lesser than 'key' (or lesser than or equal if
+ * 'inclusive' is true) in O(log n).
+ * Note: tree must be ranked (see rbtree_enable_ranks).
+ * */
+size_t rbtree_rank(const struct rbtree* tree, const void* key, int inclusive)
+{
+	size_t result = 0;
+	struct rbtreenode* node = tree->root;
+
+	while (node != NULL) {
+		int c = tree->compare(node->data, key);
+		if (c < 0 || (inclusive && c == 0)) {
+			// node and its left subtree are counted
+			result += 1 + rbtree_nodesize(node->left);
+			node = node->right;
+		}
+		else
+			node = node->left;
+	}
+
+	return result;
+}
+
+/*
+ * Gets the element at position 'k' (0 based) in ascending order, in O(log n).
+ * Returns NULL if 'k' is out of range.
+ * Note: tree must be ranked (see rbtree_enable_ranks).
+ * */
+void* rbtree_select(const struct rbtree* tree, size_t k)
+{
+	struct rbtreenode* node = tree->root;
+
+	while (node != NULL) {
+		size_t leftsize = rbtree_nodesize(node->left);
+		if (k < leftsize)
+			node = node->left;
+		else if (k == leftsize)
+			return node->data;
+		else {
+			k -= leftsize + 1;
+			node = node->right;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Builds the subtree of items [lo, hi) at a given depth (see rbtree_build_sorted).
+ * Nodes at 'reddepth' are colored red.
+ * Returns root of subtree.
+ */
+struct rbtreenode* rbtree_build_range( struct rbtree* tree, struct rbtreenode* parent,
+									   void** items, size_t lo, size_t hi,
+									   int depth, int reddepth )
+{
+	if (lo >= hi)
+		return NULL;
+
+	size_t mid = lo + (hi - lo) / 2;
+	struct rbtreenode* node = rbtree_createnode(tree, parent, items[mid]);
+	node->c = (depth == reddepth) ? RB_RED : RB_BLACK;
+	node->size = hi - lo;
+	node->left = rbtree_build_range(tree, node, items, lo, mid, depth + 1, reddepth);
+	node->right = rbtree_build_range(tree, node, items, mid + 1, hi, depth + 1, reddepth);
+	return node;
+}
+
+/*
+ * Builds the tree from 'n' elements sorted in strictly ascending order, in O(n).
+ * The result is perfectly balanced: middle element goes to the root, all levels
+ * are black except the last one when it is not full, which is red (all paths
+ * have the same black height). Subtree sizes are filled (see rbtree_enable_ranks).
+ * Nodes are allocated from one contiguous arena block (an arena is created if
+ * the tree has none), in preorder.
+ * Tree must be empty.
+ * Returns 1 (true) if succeeded, 0 (false) if tree is not empty, elements are not
+ * sorted or out of memory.
+ * */
+int rbtree_build_sorted(struct rbtree* tree, void** items, size_t n)
+{
+	if (tree->root != NULL)
+		return 0;
+
+	for (size_t i = 1; i < n; ++i) {
+		if (tree->compare(items[i - 1], items[i]) >= 0)
+			return 0;
+	}
+
+	if (n == 0)
+		return 1;
+
+	if (tree->arena == NULL) {
+		tree->arena = nodearena_create_allocator(sizeof(struct rbtreenode), 0, tree->allocator);
+		if (tree->arena == NULL)
+			return 0;
+	}
+	else if (tree->arena->refs == 1)
+		nodearena_reset(tree->arena);	// tree is empty, drop its free list too
+
+	if (!nodearena_reserve(tree->arena, n))
+		return 0;
+
+	// splitting in halves puts the deepest nodes at depth floor(log2(n)): when that
+	// level is not full some paths stop one level above, so it is the red one
+	int last = 0;
+	while ((n >> (last + 1)) > 0)
+		last++;
+
+	int full = ((n & (n + 1)) == 0);	// n = 2^k - 1
+	int reddepth = (full || last == 0) ? -1 : last;
+
+	tree->root = rbtree_build_range(tree, NULL, items, 0, n, 0, reddepth);
+	return 1;
+}
+
+/*
+ * Gets the node after a given node in order (NULL if none).
+ * */
+struct rbtreenode* rbtree_nextnode(const struct rbtreenode* node)
+{
+	if (node->right != NULL)
+		return rbtree_successor(node->right);
+
+	// go up until coming from a left child
+	while (node->parent != NULL && node == node->parent->right)
+		node = node->parent;
+
+	return node->parent;
+}
+
+/*
+ * Gets the node before a given node in order (NULL if none).
+ * */
+struct rbtreenode* rbtree_prevnode(const struct rbtreenode* node)
+{
+	if (node->left != NULL) {
+		struct rbtreenode* result = node->left;
+		while (result->right != NULL)
+			result = result->right;
+
+		return result;
+	}
+
+	// go up until coming from a right child
+	while (node->parent != NULL && node == node->parent->left)
+		node = node->parent;
+
+	return node->parent;
+}
+
+/*
+ * Positions cursor at the smallest element.
+ * */
+void rbtree_iter_first(const struct rbtree* tree, struct rbtree_iter* it)
+{
+	it->tree = tree;
+	it->node = (tree->root != NULL) ? rbtree_successor(tree->root) : NULL;
+}
+
+/*
+ * Positions cursor at the largest element.
+ * */
+void rbtree_iter_last(const struct rbtree* tree, struct rbtree_iter* it)
+{
+	struct rbtreenode* node = tree->root;
+	if (node != NULL)
+		while (node->right != NULL)
+			node = node->right;
+
+	it->tree = tree;
+	it->node = node;
+}
+
+/*
+ * Positions cursor at the smallest element larger than or equal to 'key', in O(log n).
+ * */
+void rbtree_iter_seek(const struct rbtree* tree, const void* key, struct rbtree_iter* it)
+{
+	struct rbtreenode* node = tree->root;
+	struct rbtreenode* result = NULL;
+
+	while (node != NULL) {
+		int c = tree->compare(node->data, key);
+		if (c == 0) {
+			result = node;
+			break;
+		}
+		else if (c > 0) {
+			result = node;
+			node = node->left;
+		}
+		else
+			node = node->right;
+	}
+
+	it->tree = tree;
+	it->node = result;
+}
+
+/*
+ * Positions cursor at the largest element lesser than or equal to 'key', in O(log n).
+ * */
+void rbtree_iter_seek_floor(const struct rbtree* tree, const void* key, struct rbtree_iter* it)
+{
+	struct rbtreenode* node = tree->root;
+	struct rbtreenode* result = NULL;
+
+	while (node != NULL) {
+		int c = tree->compare(node->data, key);
+		if (c == 0) {
+			result = node;
+			break;
+		}
+		else if (c < 0) {
+			result = node;
+			node = node->right;
+		}
+		else
+			node = node->left;
+	}
+
+	it->tree = tree;
+	it->node = result;
+}
+
+/*
+ * Gets the element at cursor, NULL if there is none.
+ * */
+void* rbtree_iter_get(const struct rbtree_iter* it) {
+	return (it->node != NULL) ? it->node->data : NULL;
+}
+
+/*
+ * Moves cursor to the next element.
+ * Returns that element, NULL if cursor moved past the end (it stays there).
+ * */
+void* rbtree_iter_next(struct rbtree_iter* it)
+{
+	if (it->node != NULL)
+		it->node = rbtree_nextnode(it->node);
+
+	return rbtree_iter_get(it);
+}
+
+/*
+ * Moves cursor to the previous element.
+ * Returns that element, NULL if cursor moved past the end (it stays there).
+ * */
+void* rbtree_iter_prev(struct rbtree_iter* it)
+{
+	if (it->node != NULL)
+		it->node = rbtree_prevnode(it->node);
+
+	return rbtree_iter_get(it);
+}
+
 /*
  * Releases all tree nodes and associated data from memory.
  * Uses postorder traversal.
@@ -1441,12 +1894,573 @@ void rbtree_deallocate(struct rbtree* tree, struct rbtreenode* root) {
 	rbtree_destroynode(tree, root);
 }
 
+/*
+ * Gets black height of a subtree: number of black nodes from 'node' to a leaf.
+ */
+int rbtree_blackheight(const struct rbtreenode* node)
+{
+	int result = 0;
+	for (; node != NULL; node = node->left)
+		result += (node->c == RB_BLACK);
+
+	return result;
+}
+
+/*
+ * Gets the number of levels of a subtree (0 if empty).
+ * Note: Private function.
+ * */
+int rbtree_stats_height(const struct rbtreenode* node)
+{
+	if (node == NULL)
+		return 0;
+
+	int hl = rbtree_stats_height(node->left), hr = rbtree_stats_height(node->right);
+	return 1 + ((hl > hr) ? hl : hr);
+}
+
+/*
+ * Takes a statistics snapshot of the tree: size, height, black height and the
+ * event counters (rotations per insert and delete), if compiled in.
+ * */
+void rbtree_stats(const struct rbtree* tree, struct rbtree_stats* stats)
+{
+	*stats = (struct rbtree_stats){ 0 };
+	stats->size = (size_t)rbtree_getSizeIt(tree);
+	stats->height = rbtree_stats_height(tree->root);
+	stats->blackheight = rbtree_blackheight(tree->root);
+	stats->countersenabled = DATASTATS_ENABLED;
+	stats->counters = tree->counters;
+}
+
+/*
+ * Converts a statistics snapshot to a metric list (see datastats_print and
+ * datastats_export). 'metrics' must have room for DATASTATS_MAX_METRICS entries.
+ * Returns the number of metrics.
+ * */
+size_t rbtree_stats_metrics(const struct rbtree_stats* stats, struct datastats_metric* metrics)
+{
+	const struct rbtree_counters* c = &(stats->counters);
+	size_t n = 0;
+	metrics[n++] = (struct datastats_metric){ "size", (double)stats->size, NULL };
+	metrics[n++] = (struct datastats_metric){ "height", (double)stats->height, NULL };
+	metrics[n++] = (struct datastats_metric){ "black_height", (double)stats->blackheight, NULL };
+
+	if (stats->countersenabled) {
+		metrics[n++] = (struct datastats_metric){ "inserts", (double)c->inserts, NULL };
+		metrics[n++] = (struct datastats_metric){ "deletes", (double)c->deletes, NULL };
+		metrics[n++] = (struct datastats_metric){ "insert_rotations", (double)c->insertrotations, NULL };
+		metrics[n++] = (struct datastats_metric){ "delete_rotations", (double)c->deleterotations, NULL };
+		metrics[n++] = (struct datastats_metric){ "rotations_per_insert",
+				(c->inserts > 0) ? (double)c->insertrotations / (double)c->inserts : 0.0, NULL };
+		metrics[n++] = (struct datastats_metric){ "rotations_per_delete",
+				(c->deletes > 0) ? (double)c->deleterotations / (double)c->deletes : 0.0, NULL };
+	}
+
+	return n;
+}
+
+/*
+ * Gets node without right child in the subtree of the given node (largest one).
+ */
+struct rbtreenode* rbtree_maxnode(struct rbtreenode* x)
+{
+	while (x->right != NULL)
+		x = x->right;
+
+	return x;
+}
+
+/*
+ * Joins two subtrees and a middle node, all elements of 'left' < 'mid' < all elements
+ * of 'right'. Subtrees must be detached (NULL parent), their roots may be red.
+ * Returns root of joined tree (with NULL parent).
+ *
+ * The tree with larger black height is walked down along its spine facing the other
+ * one, up to a black node with the black height of the other tree. 'mid' replaces that
+ * node, red, with the node and the other tree as children, and the red-red violation
+ * is fixed as after an insertion. Time complexity: O(|bh(left) - bh(right)| + 1).
+ */
+struct rbtreenode* rbtree_join_nodes( struct rbtreenode* left, struct rbtreenode* mid,
+									  struct rbtreenode* right )
+{
+	// a red root can be made black, tree stays valid
+	if (left != NULL) left->c = RB_BLACK;
+	if (right != NULL) right->c = RB_BLACK;
+
+	int hl = rbtree_blackheight(left);
+	int hr = rbtree_blackheight(right);
+	mid->parent = NULL;
+
+	if (hl == hr) {
+		mid->c = RB_BLACK;
+		mid->left = left;
+		mid->right = right;
+		if (left != NULL) left->parent = mid;
+		if (right != NULL) right->parent = mid;
+		mid->size = 1 + rbtree_nodesize(left) + rbtree_nodesize(right);
+		return mid;
+	}
+
+	int towardsright = (hl > hr);
+	struct rbtreenode* root = (towardsright) ? left : right;
+	struct rbtreenode* other = (towardsright) ? right : left;
+	struct rbtreenode* parent = NULL;
+	struct rbtreenode* node = root;
+	int h = (towardsright) ? hl : hr;
+	int target = (towardsright) ? hr : hl;
+
+	while (node != NULL && (node->c == RB_RED || h > target)) {
+		h -= (node->c == RB_BLACK);
+		parent = node;
+		node = (towardsright) ? node->right : node->left;
+	}
+
+	mid->c = RB_RED;
+	mid->parent = parent;
+	if (towardsright) {
+		mid->left = node;
+		mid->right = other;
+		parent->right = mid;
+	}
+	else {
+		mid->left = other;
+		mid->right = node;
+		parent->left = mid;
+	}
+
+	if (node != NULL) node->parent = mid;
+	if (other != NULL) other->parent = mid;
+
+	mid->size = 1 + rbtree_nodesize(node) + rbtree_nodesize(other);
+	for (struct rbtreenode* p = parent; p != NULL; p = p->parent)
+		p->size += 1 + rbtree_nodesize(other);
+
+	return rbtree_fixRedRed(root, mid);
+}
+
+/*
+ * Splits subtree of 'node' in elements lesser than 'key' ('*left_p') and larger than
+ * 'key' ('*right_p'). The node equal to 'key', if any, is detached and returned in
+ * '*mid_p' (NULL otherwise). Returned roots have NULL parent.
+ *
+ * Going down the search path, subtrees on each side are joined back with the path
+ * nodes. Black heights of joined trees only grow, so joins cost O(log n) in total.
+ */
+void rbtree_split_nodes( const struct rbtree* tree, struct rbtreenode* node, const void* key,
+						 struct rbtreenode** left_p, struct rbtreenode** mid_p,
+						 struct rbtreenode** right_p )
+{
+	if (node == NULL) {
+		*left_p = *right_p = NULL;
+		*mid_p = NULL;
+		return;
+	}
+
+	struct rbtreenode* left = node->left;
+	struct rbtreenode* right = node->right;
+	if (left != NULL) left->parent = NULL;
+	if (right != NULL) right->parent = NULL;
+	node->left = node->right = node->parent = NULL;
+	node->size = 1;
+
+	int c = tree->compare(node->data, key);
+	if (c == 0) {
+		*left_p = left;
+		*mid_p = node;
+		*right_p = right;
+	}
+	else if (c > 0) {
+		struct rbtreenode* rest = NULL;
+		rbtree_split_nodes(tree, left, key, left_p, mid_p, &rest);
+		*right_p = rbtree_join_nodes(rest, node, right);
+	}
+	else {
+		struct rbtreenode* rest = NULL;
+		rbtree_split_nodes(tree, right, key, &rest, mid_p, right_p);
+		*left_p = rbtree_join_nodes(left, node, rest);
+	}
+}
+
+/*
+ * Joins two subtrees, all elements of 'left' < all elements of 'right', taking the
+ * largest node of 'left' as middle node.
+ * Returns root of joined tree.
+ */
+struct rbtreenode* rbtree_concat_nodes( const struct rbtree* tree, struct rbtreenode* left,
+										struct rbtreenode* right )
+{
+	if (left == NULL)
+		return right;
+
+	if (right == NULL)
+		return left;
+
+	// detach largest node of 'left' (nothing is larger than it)
+	struct rbtreenode* max = rbtree_maxnode(left);
+	struct rbtreenode* rest = NULL;
+	rbtree_split_nodes(tree, left, max->data, &left, &max, &rest);
+	return rbtree_join_nodes(left, max, right);
+}
+
+/*
+ * Sets a new root (black).
+ */
+void rbtree_setroot(struct rbtree* tree, struct rbtreenode* root)
+{
+	if (root != NULL) {
+		root->parent = NULL;
+		root->c = RB_BLACK;
+	}
+
+	tree->root = root;
+}
+
+/*
+ * Moves all elements larger than or equal to 'key' to a new tree (same callbacks,
+ * nodes stay in the same arena), in O(log n).
+ * Both trees are ranked (see rbtree_enable_ranks), so their sizes are root->size.
+ * Returns the new tree, NULL if out of memory.
+ * */
+struct rbtree* rbtree_split(struct rbtree* tree, const void* key)
+{
+	struct rbtree* result = rbtree_create_allocator( NULL, tree->calcdatasize, tree->compare, tree->freedata,
+													 tree->printdata, tree->copydata, NULL, tree->allocator );
+	if (result == NULL)
+		return NULL;
+
+	if (tree->arena != NULL)
+		result->arena = nodearena_retain(tree->arena);
+
+	rbtree_enable_ranks(tree);
+	result->ranked = 1;
+
+	struct rbtreenode *left = NULL, *mid = NULL, *right = NULL;
+	rbtree_split_nodes(tree, tree->root, key, &left, &mid, &right);
+	if (mid != NULL)
+		right = rbtree_join_nodes(NULL, mid, right);
+
+	rbtree_setroot(tree, left);
+	rbtree_setroot(result, right);
+	return result;
+}
+
+/*
+ * Checks if nodes of two trees come from the same place (same arena or, without
+ * arenas, same allocator), so they can be moved from one tree to the other.
+ * Note: Private function.
+ */
+int rbtree_samenodes(const struct rbtree* tree, const struct rbtree* other)
+{
+	return (tree->arena == other->arena) && ((tree->arena != NULL) || (tree->allocator == other->allocator));
+}
+
+/*
+ * Inserts all elements of subtree of 'node' (from other tree) in 'tree' and releases
+ * the nodes to 'other'. Elements already in 'tree' are released (freedata).
+ * Returns number of released duplicates.
+ */
+size_t rbtree_movenodes(struct rbtree* tree, struct rbtree* other, struct rbtreenode* node)
+{
+	if (node == NULL)
+		return 0;
+
+	size_t result = rbtree_movenodes(tree, other, node->left);
+	result += rbtree_movenodes(tree, other, node->right);
+
+	if (rbtree_search(tree, tree->root, node->data) == NULL)
+		rbtree_insert(tree, node->data);
+	else {
+		if (tree->freedata != NULL)
+			tree->freedata(node->data);
+
+		result++;
+	}
+
+	rbtree_freenode(other, node);
+	return result;
+}
+
+/*
+ * Union of two subtrees (nodes of same arena): for each root of the first one, the
+ * second one is split at its element and both sides are merged recursively, then
+ * joined back with the root. Duplicates of the second subtree are detached and
+ * pushed to the list '*dups_p' (linked by their right child, see rbtree_release_list).
+ */
+struct rbtreenode* rbtree_union_nodes( struct rbtree* tree, struct rbtreenode* a,
+									   struct rbtreenode* b, struct rbtreenode** dups_p )
+{
+	if (a == NULL)
+		return b;
+
+	if (b == NULL)
+		return a;
+
+	struct rbtreenode* left = a->left;
+	struct rbtreenode* right = a->right;
+	if (left != NULL) left->parent = NULL;
+	if (right != NULL) right->parent = NULL;
+	a->left = a->right = a->parent = NULL;
+
+	struct rbtreenode *bleft = NULL, *dup = NULL, *bright = NULL;
+	rbtree_split_nodes(tree, b, a->data, &bleft, &dup, &bright);
+	if (dup != NULL) {
+		dup->right = *dups_p;
+		*dups_p = dup;
+	}
+
+	left = rbtree_union_nodes(tree, left, bleft, dups_p);
+	right = rbtree_union_nodes(tree, right, bright, dups_p);
+	return rbtree_join_nodes(left, a, right);
+}
+
+/*
+ * Releases a list of detached nodes linked by their right child, and their data.
+ * Returns the number of released nodes.
+ */
+size_t rbtree_release_list(struct rbtree* tree, struct rbtreenode* list)
+{
+	size_t result = 0;
+	while (list != NULL) {
+		struct rbtreenode* next = list->right;
+		rbtree_destroynode(tree, list);
+		list = next;
+		result++;
+	}
+
+	return result;
+}
+
+/*
+ * Moves all elements of 'other' to 'tree', 'other' is left empty. Elements of 'other'
+ * already in 'tree' are released (freedata).
+ * If all elements of one tree are lesser than all elements of the other one they are
+ * joined in O(log n), otherwise in O(m log(n / m + 1)) with m the size of the smaller
+ * tree. Trees with nodes in different arenas (or allocators) fall back to one insertion
+ * per element.
+ * Both trees are ranked (see rbtree_enable_ranks).
+ * Returns number of released duplicates.
+ * */
+size_t rbtree_union(struct rbtree* tree, struct rbtree* other)
+{
+	size_t result = 0;
+	rbtree_enable_ranks(tree);
+	rbtree_enable_ranks(other);
+
+	if (other->root == NULL)
+		return 0;
+
+	if (!rbtree_samenodes(tree, other)) {
+		result = rbtree_movenodes(tree, other, other->root);
+		other->root = NULL;
+		return result;
+	}
+
+	struct rbtreenode* a = tree->root;
+	struct rbtreenode* b = other->root;
+	other->root = NULL;
+
+	if (a == NULL)
+		rbtree_setroot(tree, b);
+	else if (tree->compare(rbtree_maxnode(a)->data, rbtree_successor(b)->data) < 0)
+		rbtree_setroot(tree, rbtree_concat_nodes(tree, a, b));		// all 'a' < all 'b'
+	else if (tree->compare(rbtree_maxnode(b)->data, rbtree_successor(a)->data) < 0)
+		rbtree_setroot(tree, rbtree_concat_nodes(tree, b, a));		// all 'b' < all 'a'
+	else {
+		// smaller tree is walked, larger one is split
+		if (a->size < b->size) {
+			struct rbtreenode* t = a; a = b; b = t;
+		}
+
+		struct rbtreenode* dups = NULL;
+		rbtree_setroot(tree, rbtree_union_nodes(tree, b, a, &dups));
+		result = rbtree_release_list(tree, dups);
+	}
+
+	return result;
+}
+
+// task of a parallel union: union of two subtrees, joined by its parent task
+struct rbtree_union_task {
+	struct rbtreenode* a;					// walked subtree (its root is the middle node)
+	struct rbtreenode* b;					// subtree split at the root of 'a'
+	struct rbtreenode* left;				// union of the left sides (set by a child task)
+	struct rbtreenode* right;				// union of the right sides (set by a child task)
+	struct rbtreenode** result;				// where the joined subtree goes
+	struct rbtree_union_task* parent;		// task waiting for this one (NULL: first task)
+	_Atomic int pending;					// child tasks not finished
+};
+
+// tree and per worker duplicate lists of a parallel union
+struct rbtree_union_state {
+	struct rbtree* tree;
+	struct rbtreenode** dups;				// one list per worker (see rbtree_union_nodes)
+};
+
+/*
+ * Ends a task of a parallel union: the last child task of a parent joins both sides
+ * with the middle node and ends the parent, up the chain.
+ * Note: Private function.
+ * */
+void rbtree_union_task_done(struct rbtree_union_task* task)
+{
+	for (;;) {
+		struct rbtree_union_task* parent = task->parent;
+		if (parent == NULL)
+			return;		// first task belongs to the caller
+
+		free(task);
+		if (atomic_fetch_sub(&(parent->pending), 1) != 1)
+			return;		// other side still running
+
+		*(parent->result) = rbtree_join_nodes(parent->left, parent->a, parent->right);
+		task = parent;
+	}
+}
+
+/*
+ * Work item of a parallel union: small unions run sequentially, larger ones split
+ * 'b' at the root of 'a' and spawn the union of each side.
+ * Note: Private function.
+ * */
+void rbtree_union_task_run(struct taskpool* pool, void* item, int worker, void* arg)
+{
+	struct rbtree_union_state* st = (struct rbtree_union_state*)arg;
+	struct rbtree_union_task* task = (struct rbtree_union_task*)item;
+	struct rbtreenode* a = task->a;
+	struct rbtreenode* b = task->b;
+
+	if ((a == NULL) || (b == NULL) || (a->size + b->size <= RBTREE_PARALLEL_UNION_GRAIN)) {
+		*(task->result) = rbtree_union_nodes(st->tree, a, b, &(st->dups[worker]));
+		rbtree_union_task_done(task);
+		return;
+	}
+
+	struct rbtreenode* left = a->left;
+	struct rbtreenode* right = a->right;
+	if (left != NULL) left->parent = NULL;
+	if (right != NULL) right->parent = NULL;
+	a->left = a->right = a->parent = NULL;
+
+	struct rbtreenode *bleft = NULL, *dup = NULL, *bright = NULL;
+	rbtree_split_nodes(st->tree, b, a->data, &bleft, &dup, &bright);
+	if (dup != NULL) {
+		dup->right = st->dups[worker];
+		st->dups[worker] = dup;
+	}
+
+	// each child task is released when it ends (see rbtree_union_task_done)
+	struct rbtree_union_task* lefttask = (struct rbtree_union_task*)malloc(sizeof(struct rbtree_union_task));
+	struct rbtree_union_task* righttask = (struct rbtree_union_task*)malloc(sizeof(struct rbtree_union_task));
+	if ((lefttask == NULL) || (righttask == NULL)) {
+		printf("Memory error: failed to allocate memory for parallel union!\n");
+		abort();
+	}
+
+	*lefttask = (struct rbtree_union_task){ left, bleft, NULL, NULL, &(task->left), task, 0 };
+	*righttask = (struct rbtree_union_task){ right, bright, NULL, NULL, &(task->right), task, 0 };
+	atomic_store(&(task->pending), 2);
+	taskpool_spawn(pool, worker, righttask);
+	rbtree_union_task_run(pool, lefttask, worker, arg);	// left side on this worker
+}
+
+/*
+ * Moves all elements of 'other' to 'tree' like rbtree_union, running the join based
+ * union on the threads of 'pool': the root of the smaller tree splits the larger one
+ * and both sides are merged as separate tasks, the last one to finish joins them
+ * with the root. Unions below RBTREE_PARALLEL_UNION_GRAIN nodes run sequentially,
+ * as do trees in different arenas and trees whose elements do not overlap.
+ * Both trees are ranked (see rbtree_enable_ranks).
+ * Returns number of released duplicates.
+ * */
+size_t rbtree_parallel_union(struct taskpool* pool, struct rbtree* tree, struct rbtree* other)
+{
+	rbtree_enable_ranks(tree);
+	rbtree_enable_ranks(other);
+
+	struct rbtreenode* a = tree->root;
+	struct rbtreenode* b = other->root;
+	if ( (a == NULL) || (b == NULL) || !rbtree_samenodes(tree, other)
+		 || (a->size + b->size <= RBTREE_PARALLEL_UNION_GRAIN)
+		 || (tree->compare(rbtree_maxnode(a)->data, rbtree_successor(b)->data) < 0)
+		 || (tree->compare(rbtree_maxnode(b)->data, rbtree_successor(a)->data) < 0) )
+		return rbtree_union(tree, other);
+
+	// smaller tree is walked, larger one is split
+	if (a->size < b->size) {
+		struct rbtreenode* t = a; a = b; b = t;
+	}
+
+	int nthreads = taskpool_getthreads(pool);
+	struct rbtree_union_state st = { tree, (struct rbtreenode**)calloc(nthreads, sizeof(struct rbtreenode*)) };
+	if (st.dups == NULL) {
+		printf("Memory error: failed to allocate memory for parallel union!\n");
+		abort();
+	}
+
+	struct rbtreenode* root = NULL;
+	struct rbtree_union_task first = { b, a, NULL, NULL, &root, NULL, 0 };
+	void* item = &first;
+	other->root = NULL;
+	taskpool_run(pool, rbtree_union_task_run, &st, &item, 1);
+	rbtree_setroot(tree, root);
+
+	size_t result = 0;
+	for (int w = 0; w < nthreads; ++w)
+		result += rbtree_release_list(tree, st.dups[w]);
+
+	free(st.dups);
+	return result;
+}
+
+/*
+ * Removes all elements between 'from' and 'to' (inclusive), releasing their data
+ * (freedata), in O(log n + k) for 'k' removed elements: the range is split off the
+ * tree, its nodes released, and both sides joined back.
+ * Tree is ranked (see rbtree_enable_ranks).
+ * Returns number of removed elements.
+ * */
+size_t rbtree_remove_range(struct rbtree* tree, const void* from, const void* to)
+{
+	if (tree->root == NULL || tree->compare(from, to) > 0)
+		return 0;
+
+	rbtree_enable_ranks(tree);
+
+	// tree = low | range | high
+	struct rbtreenode *low = NULL, *mid = NULL, *rest = NULL, *range = NULL, *high = NULL;
+	rbtree_split_nodes(tree, tree->root, from, &low, &mid, &rest);
+	if (mid != NULL)
+		rest = rbtree_join_nodes(NULL, mid, rest);
+
+	rbtree_split_nodes(tree, rest, to, &range, &mid, &high);
+	if (mid != NULL)
+		range = rbtree_join_nodes(range, mid, NULL);
+
+	size_t result = rbtree_nodesize(range);
+	rbtree_deallocate(tree, range);
+	rbtree_setroot(tree, rbtree_concat_nodes(tree, low, high));
+	return result;
+}
+
+
 /*
  * Releases all nodes and their data from tree.
  * */
 void rbtree_clear(struct rbtree* tree)
 {
-	rbtree_deallocate(tree, tree->root);
+	if (tree->arena == NULL || tree->arena->refs > 1)
+		// heap nodes, or arena shared with other trees (see rbtree_split)
+		rbtree_deallocate(tree, tree->root);
+	else {
+		// only data needs a walk, nodes go away with the arena blocks
+		if (tree->freedata != NULL)
+			rbtree_deallocate(tree, tree->root);
+
+		nodearena_reset(tree->arena);
+	}
+
+	tree->root = NULL;
 }
 
 /*
@@ -1455,6 +2469,10 @@ void rbtree_clear(struct rbtree* tree)
 void rbtree_destroy(struct rbtree* tree)
 {
 	rbtree_clear(tree);
-	free(tree);
+
+	if (tree->arena != NULL)
+		nodearena_destroy(tree->arena);
+
+	allocator_free(tree->allocator, tree, sizeof(*tree));
 }
 
@@ -117,8 +117,12 @@
 #ifndef REDBLACKTREE_H_
 	#define REDBLACKTREE_H_
 
+	#include "nodearena.h"
+	#include "datastats.h"
+
 	#define RB_BLACK 0	// black node
 	#define RB_RED 1	// red node
+	#define RBTREE_PARALLEL_UNION_GRAIN 4096	// nodes of a parallel union task run sequentially
 
 	// red black tree node
 	struct rbtreenode {
@@ -127,6 +131,7 @@
 		struct rbtreenode* parent;
 		struct rbtreenode* left;
 		struct rbtreenode* right;
+		size_t size;	// nodes in subtree (kept up to date when tree is ranked)
 	};
 
 	// callback function to (hard) copy data from one tree node to another
@@ -135,8 +140,29 @@
 	typedef int (*rbtree_cmp)(const void* data1, const void* data2);
 	typedef void (*rbtree_freedata)(void* data);
 	typedef void (*rbtree_printdata)(const void* data);
+	// callback of parallel traversals ('worker' is the index of the running thread)
+	typedef void (*rbtree_visitfunc)(void* data, int worker, void* arg);
+
+	struct taskpool;	// work-stealing thread pool (see taskpool.h)
 //	typedef void (*rbtree_printnode)(struct rbtreenode* node);
 
+	// event counters (only updated when built with CDATASTRUCT_STATS, see datastats.h)
+	struct rbtree_counters {
+		size_t inserts;					// successful inserts
+		size_t deletes;					// successful deletes
+		size_t insertrotations;			// rotations done by inserts
+		size_t deleterotations;			// rotations done by deletes
+	};
+
+	// statistics snapshot of a red black tree (see rbtree_stats)
+	struct rbtree_stats {
+		size_t size;
+		int height;						// levels of the tree (0 if empty)
+		int blackheight;				// black nodes from root to a leaf
+		int countersenabled;			// counters below were compiled in
+		struct rbtree_counters counters;
+	};
+
 
 		struct rbtree {
 			struct rbtreenode* root;
@@ -145,22 +171,41 @@
 			rbtree_cmp compare;			// compare function (returns 0, 1 or -1)
 			rbtree_freedata freedata;	// function to release data from memory.
 			rbtree_printdata printdata;	// function to print node's data
+			struct nodearena* arena;	// node arena (NULL if nodes are malloc'ed)
+			const struct allocator* allocator;	// allocator of structure and nodes (NULL: C library)
+			int ranked;					// subtree sizes are maintained (see rbtree_enable_ranks)
+			struct rbtree_counters counters;	// event counters (see datastats.h)
 
 //			rbtree_printnode printnode;	// function to print data node
 		};
 
 		/*
 		 * Function to create a new red black tree.
+		 * If 'arena' is not NULL nodes are allocated from it (node size must be at
+		 * least sizeof(struct rbtreenode)); the tree owns the arena and releases it
+		 * when destroyed.
 		 * Returns pointer to created red black tree instance is succeeded, NULL otherwise.
 		 */
 		struct rbtree* rbtree_create(void* rootdata, rbtree_calcdatasize calcdatasizefunc,
 				rbtree_cmp comparefunc, rbtree_freedata freedatafunc,
-				rbtree_printdata printdatafunc, rbtree_copydata copydatafunc);
+				rbtree_printdata printdatafunc, rbtree_copydata copydatafunc,
+				struct nodearena* arena);
+
+		/*
+		 * Function to create a new red black tree whose structure and nodes (when
+		 * 'arena' is NULL) are allocated by 'allocator' (see allocator.h, NULL: C
+		 * library). Nodes of an arena come from the allocator of the arena.
+		 * Returns pointer to created red black tree instance is succeeded, NULL otherwise.
+		 */
+		struct rbtree* rbtree_create_allocator(void* rootdata, rbtree_calcdatasize calcdatasizefunc,
+				rbtree_cmp comparefunc, rbtree_freedata freedatafunc,
+				rbtree_printdata printdatafunc, rbtree_copydata copydatafunc,
+				struct nodearena* arena, const struct allocator* allocator);
 
 		/*
 		 * Function to create a new red black tree node.
 		 */
-		struct rbtreenode* rbtree_createnode(struct rbtreenode* parent, void* data);
+		struct rbtreenode* rbtree_createnode(struct rbtree* tree, struct rbtreenode* parent, void* data);
 
 		/*
 		 * Inserts the given value to tree.
@@ -392,13 +437,160 @@
 		 * */
 		int rbtree_treeHeightLevelOrder(struct rbtree* tree);
 
+		/*
+		 * Gets the subtree size of a node (0 for NULL).
+		 * Note: only up to date when tree is ranked (see rbtree_enable_ranks).
+		 */
+		size_t rbtree_nodesize(const struct rbtreenode* node);
+
+		/*
+		 * Enables order statistics: computes the subtree size of every node in O(n) and,
+		 * from then on, insertions, deletions and rotations keep them up to date at
+		 * O(1) extra cost per visited node. Does nothing if already enabled.
+		 * */
+		void rbtree_enable_ranks(struct rbtree* tree);
+
+		/*
+		 * Gets the number of elements lesser than 'key' (or lesser than or equal if
+		 * 'inclusive' is true) in O(log n).
+		 * Note: tree must be ranked (see rbtree_enable_ranks).
+		 * */
+		size_t rbtree_rank(const struct rbtree* tree, const void* key, int inclusive);
+
+		/*
+		 * Gets the element at position 'k' (0 based) in ascending order, in O(log n).
+		 * Returns NULL if 'k' is out of range.
+		 * Note: tree must be ranked (see rbtree_enable_ranks).
+		 * */
+		void* rbtree_select(const struct rbtree* tree, size_t k);
+
+		/*
+		 * Builds the tree from 'n' elements sorted in strictly ascending order, in O(n).
+		 * The result is perfectly balanced: middle element goes to the root, all levels
+		 * are black except the last one when it is not full, which is red (all paths
+		 * have the same black height). Subtree sizes are filled (see rbtree_enable_ranks).
+		 * Nodes are allocated from one contiguous arena block (an arena is created if
+		 * the tree has none), in preorder.
+		 * Tree must be empty.
+		 * Returns 1 (true) if succeeded, 0 (false) if tree is not empty, elements are not
+		 * sorted or out of memory.
+		 * */
+		int rbtree_build_sorted(struct rbtree* tree, void** items, size_t n);
+
+		/*
+		 * In order cursor: walks the tree through parent pointers, one step is O(1)
+		 * amortized (O(log n) worst case) and no memory is allocated. 'node' is NULL
+		 * when the cursor is past either end.
+		 * Note: cursor is invalid after the tree is changed.
+		 * */
+		struct rbtree_iter {
+			const struct rbtree* tree;
+			struct rbtreenode* node;	// current node (NULL: no current element)
+		};
+
+		/*
+		 * Gets the node after/before a given node in order (NULL if none).
+		 * */
+		struct rbtreenode* rbtree_nextnode(const struct rbtreenode* node);
+		struct rbtreenode* rbtree_prevnode(const struct rbtreenode* node);
+
+		/*
+		 * Positions cursor at the smallest/largest element.
+		 * */
+		void rbtree_iter_first(const struct rbtree* tree, struct rbtree_iter* it);
+		void rbtree_iter_last(const struct rbtree* tree, struct rbtree_iter* it);
+
+		/*
+		 * Positions cursor at the smallest element larger than or equal to 'key'
+		 * (rbtree_iter_seek) or at the largest element lesser than or equal to 'key'
+		 * (rbtree_iter_seek_floor), in O(log n).
+		 * */
+		void rbtree_iter_seek(const struct rbtree* tree, const void* key, struct rbtree_iter* it);
+		void rbtree_iter_seek_floor(const struct rbtree* tree, const void* key, struct rbtree_iter* it);
+
+		/*
+		 * Gets the element at cursor, NULL if there is none.
+		 * */
+		void* rbtree_iter_get(const struct rbtree_iter* it);
+
+		/*
+		 * Moves cursor to the next/previous element.
+		 * Returns that element, NULL if cursor moved past the end (it stays there).
+		 * */
+		void* rbtree_iter_next(struct rbtree_iter* it);
+		void* rbtree_iter_prev(struct rbtree_iter* it);
+
+		/*
+		 * Moves all elements larger than or equal to 'key' to a new tree (same callbacks,
+		 * nodes stay in the same arena), in O(log n).
+		 * Both trees are ranked (see rbtree_enable_ranks), so their sizes are root->size.
+		 * Returns the new tree, NULL if out of memory.
+		 * */
+		struct rbtree* rbtree_split(struct rbtree* tree, const void* key);
+
+		/*
+		 * Moves all elements of 'other' to 'tree', 'other' is left empty. Elements of 'other'
+		 * already in 'tree' are released (freedata).
+		 * If all elements of one tree are lesser than all elements of the other one they are
+		 * joined in O(log n), otherwise in O(m log(n / m + 1)) with m the size of the smaller
+		 * tree. Trees with nodes in different arenas (or allocators) fall back to one insertion
+		 * per element.
+		 * Both trees are ranked (see rbtree_enable_ranks).
+		 * Returns number of released duplicates.
+		 * */
+		size_t rbtree_union(struct rbtree* tree, struct rbtree* other);
+
+		/*
+		 * Removes all elements between 'from' and 'to' (inclusive), releasing their data
+		 * (freedata), in O(log n + k) for 'k' removed elements: the range is split off the
+		 * tree, its nodes released, and both sides joined back.
+		 * Tree is ranked (see rbtree_enable_ranks).
+		 * Returns number of removed elements.
+		 * */
+		size_t rbtree_remove_range(struct rbtree* tree, const void* from, const void* to);
+
+		/*
+		 * Moves all elements of 'other' to 'tree' like rbtree_union, running the join based
+		 * union on the threads of 'pool': the root of the smaller tree splits the larger one
+		 * and both sides are merged as separate tasks, the last one to finish joins them
+		 * with the root. Unions below RBTREE_PARALLEL_UNION_GRAIN nodes run sequentially,
+		 * as do trees in different arenas and trees whose elements do not overlap.
+		 * Both trees are ranked (see rbtree_enable_ranks).
+		 * Returns number of released duplicates.
+		 * */
+		size_t rbtree_parallel_union(struct taskpool* pool, struct rbtree* tree, struct rbtree* other);
+
+		/*
+		 * Calls 'visit' for the data of every node, in any order and concurrently on the
+		 * threads of 'pool'. The tree is split in about 8 subtrees per thread (the nodes
+		 * above them are visited by the calling thread), each subtree is a work item
+		 * walked with parent links and idle workers steal the remaining ones.
+		 * Note: the tree must not be changed during the traversal.
+		 * */
+		void rbtree_parallel_foreach(struct taskpool* pool, struct rbtree* tree,
+									 rbtree_visitfunc visit, void* arg);
+
 		/*
 		 * Prints tree nodes data.
 		 * */
 		void rbtree_print(struct rbtree* tree, char* spaces);
 
+		/*
+		 * Takes a statistics snapshot of the tree: size, height, black height and the
+		 * event counters (rotations per insert and delete), if compiled in.
+		 * */
+		void rbtree_stats(const struct rbtree* tree, struct rbtree_stats* stats);
+
+		/*
+		 * Converts a statistics snapshot to a metric list (see datastats_print and
+		 * datastats_export). 'metrics' must have room for DATASTATS_MAX_METRICS entries.
+		 * Returns the number of metrics.
+		 * */
+		size_t rbtree_stats_metrics(const struct rbtree_stats* stats, struct datastats_metric* metrics);
+
 		/*
 		 * Releases all nodes and data instance from red-black tree.
+		 * Note: with an arena and no 'freedata' nodes are released at once in O(blocks).
 		 * */
 		void rbtree_clear(struct rbtree* tree);
 
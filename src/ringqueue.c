@@ -0,0 +1,359 @@
+/*
+ * ringqueue.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Bounded lock-free SPSC and MPMC queues over a circular array.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ringqueue.h"
+
+/*
+ * Rounds 'capacity' up to a power of two (at least RINGQUEUE_MIN_CAPACITY).
+ * Returns 0 if too large.
+ * Note: Private function.
+ * */
+size_t ringqueue_round_capacity(size_t capacity) {
+	size_t result = RINGQUEUE_MIN_CAPACITY;
+	while (result < capacity) {
+		if (result > SIZE_MAX / 2 / sizeof(struct ringqueue_cell))
+			return 0;
+
+		result *= 2;
+	}
+
+	return result;
+}
+
+/*
+ * Creates a SPSC queue for at least 'capacity' elements (rounded up to a power of two).
+ * Returns NULL if there is no memory.
+ * */
+struct ringqueue_spsc* ringqueue_spsc_create(size_t capacity) {
+	capacity = ringqueue_round_capacity(capacity);
+	if (capacity == 0)
+		return NULL;
+
+	struct ringqueue_spsc* result = aligned_alloc(RINGQUEUE_CACHE_LINE, sizeof(struct ringqueue_spsc));
+	if (result == NULL)
+		return NULL;
+
+	result->slots = malloc(capacity * sizeof(void*));
+	if (result->slots == NULL) {
+		free(result);
+		return NULL;
+	}
+
+	result->mask = capacity - 1;
+	atomic_init(&(result->head), 0);
+	atomic_init(&(result->tail), 0);
+	result->tailcache = 0;
+	result->headcache = 0;
+	return result;
+}
+
+/*
+ * Enqueues an element (producer thread only).
+ * Returns 1 if succeeded, 0 if the queue is full.
+ * */
+int ringqueue_spsc_enqueue(struct ringqueue_spsc* q, void* x) {
+	size_t tail = atomic_load_explicit(&(q->tail), memory_order_relaxed);
+	if (tail - q->headcache > q->mask) {
+		// looks full, see how far the consumer got
+		q->headcache = atomic_load_explicit(&(q->head), memory_order_acquire);
+		if (tail - q->headcache > q->mask)
+			return 0;
+	}
+
+	q->slots[tail & q->mask] = x;
+	atomic_store_explicit(&(q->tail), tail + 1, memory_order_release);
+	return 1;
+}
+
+/*
+ * Dequeues an element into 'out' (consumer thread only).
+ * Returns 1 if succeeded, 0 if the queue is empty.
+ * */
+int ringqueue_spsc_dequeue(struct ringqueue_spsc* q, void** out) {
+	size_t head = atomic_load_explicit(&(q->head), memory_order_relaxed);
+	if (head == q->tailcache) {
+		// looks empty, see how far the producer got
+		q->tailcache = atomic_load_explicit(&(q->tail), memory_order_acquire);
+		if (head == q->tailcache)
+			return 0;
+	}
+
+	*out = q->slots[head & q->mask];
+	atomic_store_explicit(&(q->head), head + 1, memory_order_release);
+	return 1;
+}
+
+/*
+ * Enqueues up to 'n' elements of 'items' in order (producer thread only).
+ * Returns the number of enqueued elements.
+ * */
+size_t ringqueue_spsc_enqueue_batch(struct ringqueue_spsc* q, void** items, size_t n) {
+	size_t capacity = q->mask + 1;
+	size_t tail = atomic_load_explicit(&(q->tail), memory_order_relaxed);
+	size_t room = capacity - (tail - q->headcache);
+	if (room < n) {
+		q->headcache = atomic_load_explicit(&(q->head), memory_order_acquire);
+		room = capacity - (tail - q->headcache);
+	}
+
+	if (n > room)
+		n = room;
+
+	// copy in (at most) two blocks, before and after the end of the array
+	size_t start = tail & q->mask;
+	size_t first = (n < capacity - start) ? n : capacity - start;
+	memcpy(q->slots + start, items, first * sizeof(void*));
+	memcpy(q->slots, items + first, (n - first) * sizeof(void*));
+	atomic_store_explicit(&(q->tail), tail + n, memory_order_release);
+	return n;
+}
+
+/*
+ * Dequeues up to 'n' elements into 'out' (consumer thread only).
+ * Returns the number of dequeued elements.
+ * */
+size_t ringqueue_spsc_dequeue_batch(struct ringqueue_spsc* q, void** out, size_t n) {
+	size_t capacity = q->mask + 1;
+	size_t head = atomic_load_explicit(&(q->head), memory_order_relaxed);
+	size_t count = q->tailcache - head;
+	if (count < n) {
+		q->tailcache = atomic_load_explicit(&(q->tail), memory_order_acquire);
+		count = q->tailcache - head;
+	}
+
+	if (n > count)
+		n = count;
+
+	size_t start = head & q->mask;
+	size_t first = (n < capacity - start) ? n : capacity - start;
+	memcpy(out, q->slots + start, first * sizeof(void*));
+	memcpy(out + first, q->slots, (n - first) * sizeof(void*));
+	atomic_store_explicit(&(q->head), head + n, memory_order_release);
+	return n;
+}
+
+/*
+ * Gets the number of elements (a snapshot while other threads are working).
+ * */
+size_t ringqueue_spsc_size(struct ringqueue_spsc* q) {
+	size_t head = atomic_load_explicit(&(q->head), memory_order_acquire);
+	size_t tail = atomic_load_explicit(&(q->tail), memory_order_acquire);
+	return tail - head;
+}
+
+/*
+ * Gets the capacity of the queue.
+ * */
+size_t ringqueue_spsc_capacity(const struct ringqueue_spsc* q) {
+	return q->mask + 1;
+}
+
+/*
+ * Releases the queue from memory (elements are not released).
+ * */
+void ringqueue_spsc_destroy(struct ringqueue_spsc* q) {
+	free(q->slots);
+	free(q);
+}
+
+/*
+ * Creates a MPMC queue for at least 'capacity' elements (rounded up to a power of two).
+ * Returns NULL if there is no memory.
+ * */
+struct ringqueue_mpmc* ringqueue_mpmc_create(size_t capacity) {
+	capacity = ringqueue_round_capacity(capacity);
+	if (capacity == 0)
+		return NULL;
+
+	struct ringqueue_mpmc* result = aligned_alloc(RINGQUEUE_CACHE_LINE, sizeof(struct ringqueue_mpmc));
+	if (result == NULL)
+		return NULL;
+
+	result->cells = malloc(capacity * sizeof(struct ringqueue_cell));
+	if (result->cells == NULL) {
+		free(result);
+		return NULL;
+	}
+
+	// slot i is free for the producer of position i
+	for (size_t i = 0; i < capacity; i++)
+		atomic_init(&(result->cells[i].seq), i);
+
+	result->mask = capacity - 1;
+	atomic_init(&(result->head), 0);
+	atomic_init(&(result->tail), 0);
+	return result;
+}
+
+/*
+ * Enqueues an element (any thread).
+ * Returns 1 if succeeded, 0 if the queue is full.
+ * */
+int ringqueue_mpmc_enqueue(struct ringqueue_mpmc* q, void* x) {
+	struct ringqueue_cell* cell;
+	size_t pos = atomic_load_explicit(&(q->tail), memory_order_relaxed);
+	for (;;) {
+		cell = &(q->cells[pos & q->mask]);
+		size_t seq = atomic_load_explicit(&(cell->seq), memory_order_acquire);
+		intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+		if (dif == 0) {
+			// slot is free, claim the position (a failed CAS reloads 'pos')
+			if (atomic_compare_exchange_weak_explicit(&(q->tail), &pos, pos + 1,
+													  memory_order_relaxed, memory_order_relaxed))
+				break;
+		}
+		else if (dif < 0)
+			return 0;		// slot still holds the element of the previous lap: full
+		else
+			pos = atomic_load_explicit(&(q->tail), memory_order_relaxed);
+	}
+
+	cell->data = x;
+	atomic_store_explicit(&(cell->seq), pos + 1, memory_order_release);
+	return 1;
+}
+
+/*
+ * Dequeues an element into 'out' (any thread).
+ * Returns 1 if succeeded, 0 if the queue is empty.
+ * */
+int ringqueue_mpmc_dequeue(struct ringqueue_mpmc* q, void** out) {
+	struct ringqueue_cell* cell;
+	size_t pos = atomic_load_explicit(&(q->head), memory_order_relaxed);
+	for (;;) {
+		cell = &(q->cells[pos & q->mask]);
+		size_t seq = atomic_load_explicit(&(cell->seq), memory_order_acquire);
+		intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+		if (dif == 0) {
+			if (atomic_compare_exchange_weak_explicit(&(q->head), &pos, pos + 1,
+													  memory_order_relaxed, memory_order_relaxed))
+				break;
+		}
+		else if (dif < 0)
+			return 0;		// slot not written yet: empty
+		else
+			pos = atomic_load_explicit(&(q->head), memory_order_relaxed);
+	}
+
+	*out = cell->data;
+	atomic_store_explicit(&(cell->seq), pos + q->mask + 1, memory_order_release);
+	return 1;
+}
+
+/*
+ * Enqueues up to 'n' elements of 'items' at consecutive positions (any thread).
+ * Returns the number of enqueued elements.
+ * */
+size_t ringqueue_mpmc_enqueue_batch(struct ringqueue_mpmc* q, void** items, size_t n) {
+	if (n == 0)
+		return 0;
+
+	size_t k;
+	size_t pos = atomic_load_explicit(&(q->tail), memory_order_relaxed);
+	for (;;) {
+		// count the free slots from 'pos'
+		for (k = 0; k < n; k++) {
+			size_t seq = atomic_load_explicit(&(q->cells[(pos + k) & q->mask].seq), memory_order_acquire);
+			if (seq != pos + k)
+				break;
+		}
+
+		if (k == 0) {
+			size_t seq = atomic_load_explicit(&(q->cells[pos & q->mask].seq), memory_order_relaxed);
+			if ((intptr_t)seq - (intptr_t)pos < 0)
+				return 0;
+
+			pos = atomic_load_explicit(&(q->tail), memory_order_relaxed);
+			continue;
+		}
+
+		if (atomic_compare_exchange_weak_explicit(&(q->tail), &pos, pos + k,
+												  memory_order_relaxed, memory_order_relaxed))
+			break;
+	}
+
+	for (size_t i = 0; i < k; i++) {
+		struct ringqueue_cell* cell = &(q->cells[(pos + i) & q->mask]);
+		cell->data = items[i];
+		atomic_store_explicit(&(cell->seq), pos + i + 1, memory_order_release);
+	}
+
+	return k;
+}
+
+/*
+ * Dequeues up to 'n' elements of consecutive positions into 'out' (any thread).
+ * Returns the number of dequeued elements.
+ * */
+size_t ringqueue_mpmc_dequeue_batch(struct ringqueue_mpmc* q, void** out, size_t n) {
+	if (n == 0)
+		return 0;
+
+	size_t k;
+	size_t pos = atomic_load_explicit(&(q->head), memory_order_relaxed);
+	for (;;) {
+		// count the written slots from 'pos'
+		for (k = 0; k < n; k++) {
+			size_t seq = atomic_load_explicit(&(q->cells[(pos + k) & q->mask].seq), memory_order_acquire);
+			if (seq != pos + k + 1)
+				break;
+		}
+
+		if (k == 0) {
+			size_t seq = atomic_load_explicit(&(q->cells[pos & q->mask].seq), memory_order_relaxed);
+			if ((intptr_t)seq - (intptr_t)(pos + 1) < 0)
+				return 0;
+
+			pos = atomic_load_explicit(&(q->head), memory_order_relaxed);
+			continue;
+		}
+
+		if (atomic_compare_exchange_weak_explicit(&(q->head), &pos, pos + k,
+												  memory_order_relaxed, memory_order_relaxed))
+			break;
+	}
+
+	for (size_t i = 0; i < k; i++) {
+		struct ringqueue_cell* cell = &(q->cells[(pos + i) & q->mask]);
+		out[i] = cell->data;
+		atomic_store_explicit(&(cell->seq), pos + i + q->mask + 1, memory_order_release);
+	}
+
+	return k;
+}
+
+/*
+ * Gets the number of elements (a snapshot while other threads are working).
+ * */
+size_t ringqueue_mpmc_size(struct ringqueue_mpmc* q) {
+	size_t head = atomic_load_explicit(&(q->head), memory_order_acquire);
+	size_t tail = atomic_load_explicit(&(q->tail), memory_order_acquire);
+	if (tail - head > q->mask + 1)
+		return q->mask + 1;		// counters read while moving
+
+	return tail - head;
+}
+
+/*
+ * Gets the capacity of the queue.
+ * */
+size_t ringqueue_mpmc_capacity(const struct ringqueue_mpmc* q) {
+	return q->mask + 1;
+}
+
+/*
+ * Releases the queue from memory (elements are not released).
+ * Note: no other thread may be using the queue.
+ * */
+void ringqueue_mpmc_destroy(struct ringqueue_mpmc* q) {
+	free(q->cells);
+	free(q);
+}
@@ -0,0 +1,170 @@
+/*****************************************************************************
+ * ringqueue.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for bounded lock-free queues over a circular array:
+ *  			 single producer / single consumer (SPSC) and multiple producers /
+ *  			 multiple consumers (MPMC).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Both queues use a fixed circular array like arraydeque.h, but never grow: the
+ *  capacity is rounded up to a power of two and positions are free running counters
+ *  (slot = position & mask), so full and empty are told apart without a size field
+ *  and no lock is ever taken. Enqueue of a full queue and dequeue of an empty one
+ *  fail at once (returns 0), the caller decides to spin, yield or sleep.
+ *
+ *  Head and tail live in different cache lines (RINGQUEUE_CACHE_LINE), so producers
+ *  and consumers do not invalidate each other's line on every operation (false
+ *  sharing).
+ *
+ *  SPSC: the producer owns 'tail', the consumer owns 'head'. Each side publishes its
+ *  counter with a release store and reads the other one with an acquire load. Each
+ *  side also keeps a private copy of the other counter in its own cache line and only
+ *  reloads it when the copy says full (or empty), so in steady state an operation
+ *  touches no shared line but the slot itself.
+ *
+ *  MPMC (D. Vyukov bounded queue): every slot has a sequence number. Slot of position
+ *  p is free for the producer of p when seq == p and holds the element for the
+ *  consumer of p when seq == p + 1; after the dequeue it becomes p + capacity (free
+ *  for the next lap). Producers claim positions with a CAS on 'tail' and consumers
+ *  with a CAS on 'head', then publish the slot with a release store of its sequence.
+ *  Threads only contend on the CAS, the element copy is done outside of it.
+ *
+ *  Batch operations move up to n elements with one counter update (SPSC) or one CAS
+ *  (MPMC, all the claimed slots must be ready), which divides the cost of the shared
+ *  cache line traffic by the batch size.
+ *
+ *  Source: D. Vyukov, "Bounded MPMC queue", 1024cores.net (2010).
+ *  		 M. Herlihy, N. Shavit, "The Art of Multiprocessor Programming", chapter 10 (2008).
+ *
+ *******************************************************************************/
+
+#ifndef RINGQUEUE_H_
+	#define RINGQUEUE_H_
+
+	#include <stddef.h>
+	#include <stdatomic.h>
+
+	#define RINGQUEUE_CACHE_LINE 64
+	#define RINGQUEUE_MIN_CAPACITY 2
+
+	// single producer / single consumer queue
+	struct ringqueue_spsc {
+		size_t mask;												// capacity - 1
+		void** slots;
+		_Atomic size_t head __attribute__((aligned(RINGQUEUE_CACHE_LINE)));		// next position to dequeue
+		size_t tailcache;											// consumer's copy of tail
+		_Atomic size_t tail __attribute__((aligned(RINGQUEUE_CACHE_LINE)));		// next position to enqueue
+		size_t headcache;											// producer's copy of head
+	} __attribute__((aligned(RINGQUEUE_CACHE_LINE)));
+
+	// slot of a MPMC queue
+	struct ringqueue_cell {
+		_Atomic size_t seq;											// position the slot is ready for
+		void* data;
+	};
+
+	// multiple producers / multiple consumers queue
+	struct ringqueue_mpmc {
+		size_t mask;												// capacity - 1
+		struct ringqueue_cell* cells;
+		_Atomic size_t head __attribute__((aligned(RINGQUEUE_CACHE_LINE)));		// next position to dequeue
+		_Atomic size_t tail __attribute__((aligned(RINGQUEUE_CACHE_LINE)));		// next position to enqueue
+	} __attribute__((aligned(RINGQUEUE_CACHE_LINE)));
+
+	/*
+	 * Creates a SPSC queue for at least 'capacity' elements (rounded up to a power of two).
+	 * Returns NULL if there is no memory.
+	 * */
+	struct ringqueue_spsc* ringqueue_spsc_create(size_t capacity);
+
+	/*
+	 * Enqueues an element (producer thread only).
+	 * Returns 1 if succeeded, 0 if the queue is full.
+	 * */
+	int ringqueue_spsc_enqueue(struct ringqueue_spsc* q, void* x);
+
+	/*
+	 * Dequeues an element into 'out' (consumer thread only).
+	 * Returns 1 if succeeded, 0 if the queue is empty.
+	 * */
+	int ringqueue_spsc_dequeue(struct ringqueue_spsc* q, void** out);
+
+	/*
+	 * Enqueues up to 'n' elements of 'items' in order (producer thread only).
+	 * Returns the number of enqueued elements.
+	 * */
+	size_t ringqueue_spsc_enqueue_batch(struct ringqueue_spsc* q, void** items, size_t n);
+
+	/*
+	 * Dequeues up to 'n' elements into 'out' (consumer thread only).
+	 * Returns the number of dequeued elements.
+	 * */
+	size_t ringqueue_spsc_dequeue_batch(struct ringqueue_spsc* q, void** out, size_t n);
+
+	/*
+	 * Gets the number of elements (a snapshot while other threads are working).
+	 * */
+	size_t ringqueue_spsc_size(struct ringqueue_spsc* q);
+
+	/*
+	 * Gets the capacity of the queue.
+	 * */
+	size_t ringqueue_spsc_capacity(const struct ringqueue_spsc* q);
+
+	/*
+	 * Releases the queue from memory (elements are not released).
+	 * */
+	void ringqueue_spsc_destroy(struct ringqueue_spsc* q);
+
+	/*
+	 * Creates a MPMC queue for at least 'capacity' elements (rounded up to a power of two).
+	 * Returns NULL if there is no memory.
+	 * */
+	struct ringqueue_mpmc* ringqueue_mpmc_create(size_t capacity);
+
+	/*
+	 * Enqueues an element (any thread).
+	 * Returns 1 if succeeded, 0 if the queue is full.
+	 * */
+	int ringqueue_mpmc_enqueue(struct ringqueue_mpmc* q, void* x);
+
+	/*
+	 * Dequeues an element into 'out' (any thread).
+	 * Returns 1 if succeeded, 0 if the queue is empty.
+	 * */
+	int ringqueue_mpmc_dequeue(struct ringqueue_mpmc* q, void** out);
+
+	/*
+	 * Enqueues up to 'n' elements of 'items' at consecutive positions (any thread).
+	 * Returns the number of enqueued elements.
+	 * */
+	size_t ringqueue_mpmc_enqueue_batch(struct ringqueue_mpmc* q, void** items, size_t n);
+
+	/*
+	 * Dequeues up to 'n' elements of consecutive positions into 'out' (any thread).
+	 * Returns the number of dequeued elements.
+	 * */
+	size_t ringqueue_mpmc_dequeue_batch(struct ringqueue_mpmc* q, void** out, size_t n);
+
+	/*
+	 * Gets the number of elements (a snapshot while other threads are working).
+	 * */
+	size_t ringqueue_mpmc_size(struct ringqueue_mpmc* q);
+
+	/*
+	 * Gets the capacity of the queue.
+	 * */
+	size_t ringqueue_mpmc_capacity(const struct ringqueue_mpmc* q);
+
+	/*
+	 * Releases the queue from memory (elements are not released).
+	 * Note: no other thread may be using the queue.
+	 * */
+	void ringqueue_mpmc_destroy(struct ringqueue_mpmc* q);
+
+#endif /* RINGQUEUE_H_ */
@@ -0,0 +1,643 @@
+/*
+ * roaring.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Roaring bitmap with array and bitmap containers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitset.h"
+#include "roaring.h"
+
+#define ROARING_MIN_ARRAY 4
+
+/*
+ * Aborts if an allocation failed.
+ * Note: Private function.
+ * */
+void* roaring_checkalloc(void* p)
+{
+	if (p == NULL) {
+		printf("Memory error: failed to allocate memory for roaring bitmap!\n");
+		abort();
+	}
+
+	return p;
+}
+
+/*
+ * Creates a new empty roaring bitmap.
+ * Returns the new bitmap if succeeded, NULL otherwise.
+ * */
+struct roaring* roaring_create()
+{
+	struct roaring* r = (struct roaring*)malloc(sizeof(struct roaring));
+	if (r == NULL) {
+		printf("Memory error: failed to allocate memory for roaring bitmap!\n");
+		return NULL;
+	}
+
+	r->containers = NULL;
+	r->count = 0;
+	r->capacity = 0;
+	return r;
+}
+
+/*
+ * Searches the container of a chunk key.
+ * Returns its index (or the index where it would be inserted), 'found' tells which.
+ * Note: Private function.
+ * */
+size_t roaring_find(const struct roaring* r, uint16_t key, int* found)
+{
+	size_t lo = 0, hi = r->count;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (r->containers[mid].key < key)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	*found = (lo < r->count && r->containers[lo].key == key);
+	return lo;
+}
+
+/*
+ * Inserts a container at 'index' (ownership of its data moves to the bitmap).
+ * Note: Private function.
+ * */
+void roaring_insert_container(struct roaring* r, size_t index, const struct roaring_container* c)
+{
+	if (r->count == r->capacity) {
+		r->capacity = (r->capacity > 0) ? r->capacity * 2 : 4;
+		r->containers = (struct roaring_container*)roaring_checkalloc(
+			realloc(r->containers, r->capacity * sizeof(struct roaring_container)) );
+	}
+
+	memmove(r->containers + index + 1, r->containers + index,
+			(r->count - index) * sizeof(struct roaring_container));
+	r->containers[index] = *c;
+	r->count++;
+}
+
+/*
+ * Appends a container (keys must stay sorted), an empty one is released instead.
+ * Note: Private function.
+ * */
+void roaring_append_container(struct roaring* r, struct roaring_container* c)
+{
+	if (c->cardinality == 0) {
+		free(c->array);
+		return;
+	}
+
+	roaring_insert_container(r, r->count, c);
+}
+
+/*
+ * Removes and releases the container at 'index'.
+ * Note: Private function.
+ * */
+void roaring_remove_container(struct roaring* r, size_t index)
+{
+	free(r->containers[index].array);
+	memmove(r->containers + index, r->containers + index + 1,
+			(r->count - index - 1) * sizeof(struct roaring_container));
+	r->count--;
+}
+
+/*
+ * Gets the position of the first array value not lesser than 'low'.
+ * Note: Private function.
+ * */
+uint32_t roaring_array_lowerbound(const struct roaring_container* c, uint16_t low)
+{
+	uint32_t lo = 0, hi = c->cardinality;
+	while (lo < hi) {
+		uint32_t mid = lo + (hi - lo) / 2;
+		if (c->array[mid] < low)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/*
+ * Creates an empty array container for 'capacity' values.
+ * Note: Private function.
+ * */
+struct roaring_container roaring_new_array(uint16_t key, uint32_t capacity)
+{
+	struct roaring_container c;
+	c.key = key;
+	c.isbitmap = 0;
+	c.cardinality = 0;
+	c.capacity = (capacity > ROARING_MIN_ARRAY) ? capacity : ROARING_MIN_ARRAY;
+	c.array = (uint16_t*)roaring_checkalloc(malloc(c.capacity * sizeof(uint16_t)));
+	return c;
+}
+
+/*
+ * Creates an empty bitmap container.
+ * Note: Private function.
+ * */
+struct roaring_container roaring_new_bitmap(uint16_t key)
+{
+	struct roaring_container c;
+	c.key = key;
+	c.isbitmap = 1;
+	c.cardinality = 0;
+	c.capacity = 0;
+	c.bitmap = (uint64_t*)roaring_checkalloc(calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t)));
+	return c;
+}
+
+/*
+ * Copies a container.
+ * Note: Private function.
+ * */
+struct roaring_container roaring_copy_container(const struct roaring_container* c)
+{
+	struct roaring_container result;
+	if (c->isbitmap) {
+		result = roaring_new_bitmap(c->key);
+		memcpy(result.bitmap, c->bitmap, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+	}
+	else {
+		result = roaring_new_array(c->key, c->cardinality);
+		memcpy(result.array, c->array, c->cardinality * sizeof(uint16_t));
+	}
+
+	result.cardinality = c->cardinality;
+	return result;
+}
+
+/*
+ * Converts an array container to a bitmap container.
+ * Note: Private function.
+ * */
+void roaring_to_bitmap(struct roaring_container* c)
+{
+	struct roaring_container b = roaring_new_bitmap(c->key);
+	for (uint32_t i = 0; i < c->cardinality; i++)
+		b.bitmap[c->array[i] / 64] |= (1ULL << (c->array[i] % 64));
+
+	b.cardinality = c->cardinality;
+	free(c->array);
+	*c = b;
+}
+
+/*
+ * Converts a bitmap container to an array container.
+ * Note: Private function.
+ * */
+void roaring_to_array(struct roaring_container* c)
+{
+	struct roaring_container a = roaring_new_array(c->key, c->cardinality);
+	for (uint32_t w = 0; w < ROARING_BITMAP_WORDS; w++)
+		for (uint64_t word = c->bitmap[w]; word != 0; word &= word - 1)
+			a.array[a.cardinality++] = (uint16_t)(w * 64 + __builtin_ctzll(word));
+
+	free(c->bitmap);
+	*c = a;
+}
+
+/*
+ * Gives a container the smallest representation for its cardinality.
+ * Note: Private function.
+ * */
+void roaring_normalize(struct roaring_container* c)
+{
+	if (c->isbitmap && c->cardinality <= ROARING_ARRAY_MAX)
+		roaring_to_array(c);
+	else if (!c->isbitmap && c->cardinality > ROARING_ARRAY_MAX)
+		roaring_to_bitmap(c);
+}
+
+/*
+ * Adds a value.
+ * Returns 1 if added, 0 if it was already in the bitmap.
+ * */
+int roaring_add(struct roaring* r, uint32_t value)
+{
+	uint16_t key = value >> 16, low = value & 0xFFFF;
+	int found;
+	size_t index = roaring_find(r, key, &found);
+	if (!found) {
+		struct roaring_container c = roaring_new_array(key, ROARING_MIN_ARRAY);
+		roaring_insert_container(r, index, &c);
+	}
+
+	struct roaring_container* c = &(r->containers[index]);
+	if (!c->isbitmap) {
+		uint32_t pos = roaring_array_lowerbound(c, low);
+		if (pos < c->cardinality && c->array[pos] == low)
+			return 0;
+
+		if (c->cardinality < ROARING_ARRAY_MAX) {
+			if (c->cardinality == c->capacity) {
+				c->capacity = (c->capacity * 2 < ROARING_ARRAY_MAX) ? c->capacity * 2 : ROARING_ARRAY_MAX;
+				c->array = (uint16_t*)roaring_checkalloc(realloc(c->array, c->capacity * sizeof(uint16_t)));
+			}
+
+			memmove(c->array + pos + 1, c->array + pos, (c->cardinality - pos) * sizeof(uint16_t));
+			c->array[pos] = low;
+			c->cardinality++;
+			return 1;
+		}
+
+		// a full array becomes a bitmap
+		roaring_to_bitmap(c);
+	}
+
+	uint64_t mask = 1ULL << (low % 64);
+	if (c->bitmap[low / 64] & mask)
+		return 0;
+
+	c->bitmap[low / 64] |= mask;
+	c->cardinality++;
+	return 1;
+}
+
+/*
+ * Removes a value.
+ * Returns 1 if removed, 0 if it was not in the bitmap.
+ * */
+int roaring_remove(struct roaring* r, uint32_t value)
+{
+	uint16_t key = value >> 16, low = value & 0xFFFF;
+	int found;
+	size_t index = roaring_find(r, key, &found);
+	if (!found)
+		return 0;
+
+	struct roaring_container* c = &(r->containers[index]);
+	if (c->isbitmap) {
+		uint64_t mask = 1ULL << (low % 64);
+		if ((c->bitmap[low / 64] & mask) == 0)
+			return 0;
+
+		c->bitmap[low / 64] &= ~mask;
+		if (--(c->cardinality) == ROARING_ARRAY_MAX)
+			roaring_to_array(c);
+	}
+	else {
+		uint32_t pos = roaring_array_lowerbound(c, low);
+		if (pos == c->cardinality || c->array[pos] != low)
+			return 0;
+
+		memmove(c->array + pos, c->array + pos + 1, (c->cardinality - pos - 1) * sizeof(uint16_t));
+		c->cardinality--;
+	}
+
+	if (c->cardinality == 0)
+		roaring_remove_container(r, index);
+
+	return 1;
+}
+
+/*
+ * Checks if bitmap contains a value.
+ * */
+int roaring_contains(const struct roaring* r, uint32_t value)
+{
+	uint16_t low = value & 0xFFFF;
+	int found;
+	size_t index = roaring_find(r, value >> 16, &found);
+	if (!found)
+		return 0;
+
+	const struct roaring_container* c = &(r->containers[index]);
+	if (c->isbitmap)
+		return (c->bitmap[low / 64] >> (low % 64)) & 1;
+
+	uint32_t pos = roaring_array_lowerbound(c, low);
+	return (pos < c->cardinality && c->array[pos] == low);
+}
+
+/*
+ * Gets the number of values.
+ * */
+size_t roaring_cardinality(const struct roaring* r)
+{
+	size_t result = 0;
+	for (size_t i = 0; i < r->count; i++)
+		result += r->containers[i].cardinality;
+
+	return result;
+}
+
+/*
+ * Gets the number of values lesser than 'value' (rank).
+ * */
+size_t roaring_rank(const struct roaring* r, uint32_t value)
+{
+	uint16_t low = value & 0xFFFF;
+	int found;
+	size_t index = roaring_find(r, value >> 16, &found);
+
+	size_t result = 0;
+	for (size_t i = 0; i < index; i++)
+		result += r->containers[i].cardinality;
+
+	if (found) {
+		const struct roaring_container* c = &(r->containers[index]);
+		if (c->isbitmap) {
+			result += bitset_words_count(c->bitmap, low / 64);
+			result += __builtin_popcountll(c->bitmap[low / 64] & ((1ULL << (low % 64)) - 1));
+		}
+		else
+			result += roaring_array_lowerbound(c, low);
+	}
+
+	return result;
+}
+
+/*
+ * Intersection of two containers with the same key.
+ * Note: Private function.
+ * */
+struct roaring_container roaring_container_and(const struct roaring_container* a,
+											   const struct roaring_container* b)
+{
+	struct roaring_container result;
+	if (a->isbitmap && b->isbitmap) {
+		result = roaring_copy_container(a);
+		result.cardinality = bitset_words_and(result.bitmap, b->bitmap, ROARING_BITMAP_WORDS);
+		roaring_normalize(&result);
+		return result;
+	}
+
+	if (a->isbitmap || b->isbitmap) {
+		// probe the bitmap with each array value
+		const struct roaring_container* array = a->isbitmap ? b : a;
+		const struct roaring_container* bitmap = a->isbitmap ? a : b;
+		result = roaring_new_array(a->key, array->cardinality);
+		for (uint32_t i = 0; i < array->cardinality; i++) {
+			uint16_t v = array->array[i];
+			if ((bitmap->bitmap[v / 64] >> (v % 64)) & 1)
+				result.array[result.cardinality++] = v;
+		}
+
+		return result;
+	}
+
+	result = roaring_new_array(a->key, (a->cardinality < b->cardinality) ? a->cardinality : b->cardinality);
+	uint32_t i = 0, j = 0;
+	while (i < a->cardinality && j < b->cardinality) {
+		if (a->array[i] < b->array[j])
+			i++;
+		else if (a->array[i] > b->array[j])
+			j++;
+		else {
+			result.array[result.cardinality++] = a->array[i];
+			i++;
+			j++;
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Union of two containers with the same key.
+ * Note: Private function.
+ * */
+struct roaring_container roaring_container_or(const struct roaring_container* a,
+											  const struct roaring_container* b)
+{
+	struct roaring_container result;
+	if (a->isbitmap && b->isbitmap) {
+		result = roaring_copy_container(a);
+		result.cardinality = bitset_words_or(result.bitmap, b->bitmap, ROARING_BITMAP_WORDS);
+		return result;
+	}
+
+	if (a->isbitmap || b->isbitmap) {
+		// set the array values in a copy of the bitmap
+		const struct roaring_container* array = a->isbitmap ? b : a;
+		result = roaring_copy_container(a->isbitmap ? a : b);
+		for (uint32_t i = 0; i < array->cardinality; i++) {
+			uint16_t v = array->array[i];
+			uint64_t mask = 1ULL << (v % 64);
+			result.cardinality += ((result.bitmap[v / 64] & mask) == 0);
+			result.bitmap[v / 64] |= mask;
+		}
+
+		return result;
+	}
+
+	if (a->cardinality + b->cardinality > ROARING_ARRAY_MAX) {
+		// probably too large for an array: set both in a bitmap
+		result = roaring_new_bitmap(a->key);
+		for (uint32_t i = 0; i < a->cardinality; i++)
+			result.bitmap[a->array[i] / 64] |= (1ULL << (a->array[i] % 64));
+		for (uint32_t i = 0; i < b->cardinality; i++)
+			result.bitmap[b->array[i] / 64] |= (1ULL << (b->array[i] % 64));
+
+		result.cardinality = bitset_words_count(result.bitmap, ROARING_BITMAP_WORDS);
+		roaring_normalize(&result);
+		return result;
+	}
+
+	result = roaring_new_array(a->key, a->cardinality + b->cardinality);
+	uint32_t i = 0, j = 0;
+	while (i < a->cardinality || j < b->cardinality) {
+		if (j == b->cardinality || (i < a->cardinality && a->array[i] < b->array[j]))
+			result.array[result.cardinality++] = a->array[i++];
+		else if (i == a->cardinality || b->array[j] < a->array[i])
+			result.array[result.cardinality++] = b->array[j++];
+		else {
+			result.array[result.cardinality++] = a->array[i++];
+			j++;
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Difference (a minus b) of two containers with the same key.
+ * Note: Private function.
+ * */
+struct roaring_container roaring_container_andnot(const struct roaring_container* a,
+												  const struct roaring_container* b)
+{
+	struct roaring_container result;
+	if (a->isbitmap) {
+		result = roaring_copy_container(a);
+		if (b->isbitmap)
+			result.cardinality = bitset_words_andnot(result.bitmap, b->bitmap, ROARING_BITMAP_WORDS);
+		else
+			for (uint32_t i = 0; i < b->cardinality; i++) {
+				uint16_t v = b->array[i];
+				uint64_t mask = 1ULL << (v % 64);
+				result.cardinality -= ((result.bitmap[v / 64] & mask) != 0);
+				result.bitmap[v / 64] &= ~mask;
+			}
+
+		roaring_normalize(&result);
+		return result;
+	}
+
+	result = roaring_new_array(a->key, a->cardinality);
+	if (b->isbitmap) {
+		for (uint32_t i = 0; i < a->cardinality; i++) {
+			uint16_t v = a->array[i];
+			if (((b->bitmap[v / 64] >> (v % 64)) & 1) == 0)
+				result.array[result.cardinality++] = v;
+		}
+
+		return result;
+	}
+
+	uint32_t i = 0, j = 0;
+	while (i < a->cardinality) {
+		if (j == b->cardinality || a->array[i] < b->array[j])
+			result.array[result.cardinality++] = a->array[i++];
+		else if (a->array[i] > b->array[j])
+			j++;
+		else {
+			i++;
+			j++;
+		}
+	}
+
+	return result;
+}
+
+#define ROARING_OP_AND 0
+#define ROARING_OP_OR 1
+#define ROARING_OP_ANDNOT 2
+
+/*
+ * Merges the containers of two bitmaps by key and combines them with an operation.
+ * Note: Private function.
+ * */
+struct roaring* roaring_combine(const struct roaring* a, const struct roaring* b, int op)
+{
+	struct roaring* result = (struct roaring*)roaring_checkalloc(roaring_create());
+	size_t i = 0, j = 0;
+	while (i < a->count || j < b->count) {
+		struct roaring_container c;
+		if (j == b->count || (i < a->count && a->containers[i].key < b->containers[j].key)) {
+			// chunk only in 'a'
+			if (op != ROARING_OP_AND) {
+				c = roaring_copy_container(&(a->containers[i]));
+				roaring_append_container(result, &c);
+			}
+			i++;
+		}
+		else if (i == a->count || b->containers[j].key < a->containers[i].key) {
+			// chunk only in 'b'
+			if (op == ROARING_OP_OR) {
+				c = roaring_copy_container(&(b->containers[j]));
+				roaring_append_container(result, &c);
+			}
+			j++;
+		}
+		else {
+			if (op == ROARING_OP_AND)
+				c = roaring_container_and(&(a->containers[i]), &(b->containers[j]));
+			else if (op == ROARING_OP_OR)
+				c = roaring_container_or(&(a->containers[i]), &(b->containers[j]));
+			else
+				c = roaring_container_andnot(&(a->containers[i]), &(b->containers[j]));
+
+			roaring_append_container(result, &c);
+			i++;
+			j++;
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Creates a new bitmap with the intersection / union / difference (a minus b)
+ * of two bitmaps.
+ * */
+struct roaring* roaring_and(const struct roaring* a, const struct roaring* b)
+{
+	return roaring_combine(a, b, ROARING_OP_AND);
+}
+
+struct roaring* roaring_or(const struct roaring* a, const struct roaring* b)
+{
+	return roaring_combine(a, b, ROARING_OP_OR);
+}
+
+struct roaring* roaring_andnot(const struct roaring* a, const struct roaring* b)
+{
+	return roaring_combine(a, b, ROARING_OP_ANDNOT);
+}
+
+/*
+ * Calls 'visit' for each value in increasing order.
+ * */
+void roaring_foreach(const struct roaring* r, roaring_visitfunc visit, void* arg)
+{
+	for (size_t i = 0; i < r->count; i++) {
+		const struct roaring_container* c = &(r->containers[i]);
+		uint32_t high = (uint32_t)c->key << 16;
+		if (c->isbitmap) {
+			for (uint32_t w = 0; w < ROARING_BITMAP_WORDS; w++)
+				for (uint64_t word = c->bitmap[w]; word != 0; word &= word - 1)
+					visit(high | (w * 64 + __builtin_ctzll(word)), arg);
+		}
+		else
+			for (uint32_t j = 0; j < c->cardinality; j++)
+				visit(high | c->array[j], arg);
+	}
+}
+
+/*
+ * Copies the values in increasing order to 'out' (roaring_cardinality values).
+ * */
+void roaring_toarray(const struct roaring* r, uint32_t* out)
+{
+	size_t n = 0;
+	for (size_t i = 0; i < r->count; i++) {
+		const struct roaring_container* c = &(r->containers[i]);
+		uint32_t high = (uint32_t)c->key << 16;
+		if (c->isbitmap) {
+			for (uint32_t w = 0; w < ROARING_BITMAP_WORDS; w++)
+				for (uint64_t word = c->bitmap[w]; word != 0; word &= word - 1)
+					out[n++] = high | (w * 64 + __builtin_ctzll(word));
+		}
+		else
+			for (uint32_t j = 0; j < c->cardinality; j++)
+				out[n++] = high | c->array[j];
+	}
+}
+
+/*
+ * Gets the memory used by the containers in bytes.
+ * */
+size_t roaring_sizeinbytes(const struct roaring* r)
+{
+	size_t result = sizeof(struct roaring) + r->capacity * sizeof(struct roaring_container);
+	for (size_t i = 0; i < r->count; i++)
+		result += r->containers[i].isbitmap ? ROARING_BITMAP_WORDS * sizeof(uint64_t)
+											: r->containers[i].capacity * sizeof(uint16_t);
+
+	return result;
+}
+
+/*
+ * Releases the bitmap from memory.
+ * */
+void roaring_destroy(struct roaring* r)
+{
+	for (size_t i = 0; i < r->count; i++)
+		free(r->containers[i].array);
+
+	free(r->containers);
+	free(r);
+}
@@ -0,0 +1,133 @@
+/*****************************************************************************
+ * roaring.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a roaring bitmap, a compressed set of 32 bit unsigned
+ *  			 integers for sparse or clustered values.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A plain bitset (see bitset.h) costs range / 8 bytes whatever the number of elements.
+ *  A roaring bitmap splits the 32 bit space in 2^16 chunks by the high 16 bits of the
+ *  values and keeps a container only for non empty chunks, sorted by chunk key. Each
+ *  container stores the low 16 bits of its values as:
+ *
+ *  	- a sorted array of uint16_t while it holds up to ROARING_ARRAY_MAX (4096)
+ *  	  values (2 bytes per value);
+ *  	- a bitmap of 2^16 bits (8 KB, 1024 words) when it holds more, which is then
+ *  	  smaller than the array.
+ *
+ *  Containers switch representation when they cross ROARING_ARRAY_MAX, so every chunk
+ *  costs at most 2 bytes per value and at most 8 KB.
+ *
+ *  Set algebra (AND, OR, ANDNOT) merges the sorted container lists by key and combines
+ *  matching containers with the algorithm of their types: bitmap-bitmap uses the SSE2
+ *  word kernels of bitset.h, array-array a merge of sorted arrays, array-bitmap probes
+ *  the bitmap for each array value.
+ *
+ *  Rank sums the cardinalities of the containers before the value chunk plus a binary
+ *  search (array) or a popcount (bitmap) inside it.
+ *
+ *  Out of memory errors abort (as the dynamic arrays of the library).
+ *
+ *  Source: S. Chambi, D. Lemire, O. Kaser, R. Godin, "Better bitmap performance with
+ *  		 Roaring bitmaps", Software: Practice and Experience (2016).
+ *  		 https://roaringbitmap.org/
+ *
+ *******************************************************************************/
+
+#ifndef ROARING_H_
+	#define ROARING_H_
+
+	#include <stdint.h>
+	#include <stddef.h>
+
+	#define ROARING_ARRAY_MAX 4096				// values of an array container
+	#define ROARING_BITMAP_WORDS 1024			// words of a bitmap container (2^16 bits)
+
+	// container of the values of one chunk (same high 16 bits)
+	struct roaring_container {
+		uint16_t key;							// high 16 bits
+		uint16_t isbitmap;						// 1 bitmap, 0 sorted array
+		uint32_t cardinality;					// number of values
+		uint32_t capacity;						// array capacity (array containers)
+		union {
+			uint16_t* array;					// sorted low 16 bits
+			uint64_t* bitmap;					// 2^16 bits
+		};
+	};
+
+	// roaring bitmap type
+	struct roaring {
+		struct roaring_container* containers;	// sorted by key
+		size_t count;							// number of containers
+		size_t capacity;						// containers array capacity
+	};
+
+	typedef void (*roaring_visitfunc)(uint32_t value, void* arg);
+
+	/*
+	 * Creates a new empty roaring bitmap.
+	 * Returns the new bitmap if succeeded, NULL otherwise.
+	 * */
+	struct roaring* roaring_create();
+
+	/*
+	 * Adds a value.
+	 * Returns 1 if added, 0 if it was already in the bitmap.
+	 * */
+	int roaring_add(struct roaring* r, uint32_t value);
+
+	/*
+	 * Removes a value.
+	 * Returns 1 if removed, 0 if it was not in the bitmap.
+	 * */
+	int roaring_remove(struct roaring* r, uint32_t value);
+
+	/*
+	 * Checks if bitmap contains a value.
+	 * */
+	int roaring_contains(const struct roaring* r, uint32_t value);
+
+	/*
+	 * Gets the number of values.
+	 * */
+	size_t roaring_cardinality(const struct roaring* r);
+
+	/*
+	 * Gets the number of values lesser than 'value' (rank).
+	 * */
+	size_t roaring_rank(const struct roaring* r, uint32_t value);
+
+	/*
+	 * Creates a new bitmap with the intersection / union / difference (a minus b)
+	 * of two bitmaps.
+	 * */
+	struct roaring* roaring_and(const struct roaring* a, const struct roaring* b);
+	struct roaring* roaring_or(const struct roaring* a, const struct roaring* b);
+	struct roaring* roaring_andnot(const struct roaring* a, const struct roaring* b);
+
+	/*
+	 * Calls 'visit' for each value in increasing order.
+	 * */
+	void roaring_foreach(const struct roaring* r, roaring_visitfunc visit, void* arg);
+
+	/*
+	 * Copies the values in increasing order to 'out' (roaring_cardinality values).
+	 * */
+	void roaring_toarray(const struct roaring* r, uint32_t* out);
+
+	/*
+	 * Gets the memory used by the containers in bytes.
+	 * */
+	size_t roaring_sizeinbytes(const struct roaring* r);
+
+	/*
+	 * Releases the bitmap from memory.
+	 * */
+	void roaring_destroy(struct roaring* r);
+
+#endif /* ROARING_H_ */
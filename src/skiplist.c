@@ -0,0 +1,530 @@
+/*
+ * skiplist.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Lock-free concurrent skip list (ordered set) with marked pointers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "skiplist.h"
+
+#define SKIPLIST_MARK ((uintptr_t)1)
+#define SKIPLIST_PTR(p) ((struct skiplistnode*)((p) & ~SKIPLIST_MARK))
+#define SKIPLIST_ISMARKED(p) (((p) & SKIPLIST_MARK) != 0)
+
+/*
+ * Allocates a node with 'toplevel' levels.
+ * Note: Private function.
+ * */
+struct skiplistnode* skiplist_createnode(void* data, int toplevel)
+{
+	struct skiplistnode* node = (struct skiplistnode*)malloc( sizeof(struct skiplistnode)
+															  + toplevel * sizeof(_Atomic(uintptr_t)) );
+	if (node == NULL) {
+		printf("Memory error: failed to allocate memory for skip list node!\n");
+		return NULL;
+	}
+
+	node->data = data;
+	node->toplevel = toplevel;
+	node->retired = NULL;
+	for (int level = 0; level < toplevel; level++)
+		atomic_init(&(node->next[level]), 0);
+
+	return node;
+}
+
+/*
+ * Creates a new empty skip list.
+ * Returns the new skip list if succeeded, NULL otherwise.
+ * */
+struct skiplist* skiplist_create( skiplist_compare comparefunc,
+								  skiplist_printelement printelementfunc,
+								  skiplist_freedata freedatafunc )
+{
+	struct skiplist* list = (struct skiplist*)malloc(sizeof(struct skiplist));
+	if (list == NULL) {
+		printf("Memory error: failed to allocate memory for skip list!\n");
+		return NULL;
+	}
+
+	list->head = skiplist_createnode(NULL, SKIPLIST_MAX_LEVEL);
+	if (list->head == NULL) {
+		free(list);
+		return NULL;
+	}
+
+	atomic_init(&(list->size), 0);
+	atomic_init(&(list->retired), NULL);
+	list->compare = comparefunc;
+	list->printelement = printelementfunc;
+	list->freedata = freedatafunc;
+	return list;
+}
+
+/*
+ * Gets a random level in [1, SKIPLIST_MAX_LEVEL], level k with probability 1 / 2^k
+ * (xorshift64* generator, one state per thread).
+ * Note: Private function.
+ * */
+int skiplist_randomlevel()
+{
+	static __thread uint64_t state = 0;
+	if (state == 0)
+		state = ((uint64_t)(uintptr_t)&state) * 0x9E3779B97F4A7C15ULL | 1;
+
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+	uint64_t r = state * 0x2545F4914F6CDD1DULL;
+	return 1 + __builtin_ctzll((r >> 32) | (1ULL << (SKIPLIST_MAX_LEVEL - 1)));
+}
+
+/*
+ * Finds the predecessor and successor of 'key' at every level: preds[level] is the
+ * last node lesser than the key, succs[level] the first node not lesser than the key.
+ * Unlinks the marked (removed) nodes met on the way and starts over if a CAS fails.
+ * Returns 1 if succs[0] holds the key, 0 otherwise.
+ * Note: Private function.
+ * */
+int skiplist_find( struct skiplist* list, const void* key,
+				   struct skiplistnode** preds, struct skiplistnode** succs )
+{
+	struct skiplistnode* pred;
+	struct skiplistnode* curr;
+
+retry:
+	pred = list->head;
+	for (int level = SKIPLIST_MAX_LEVEL - 1; level >= 0; level--) {
+		curr = SKIPLIST_PTR(atomic_load_explicit(&(pred->next[level]), memory_order_acquire));
+		while (curr != NULL) {
+			uintptr_t succ = atomic_load_explicit(&(curr->next[level]), memory_order_acquire);
+			if (SKIPLIST_ISMARKED(succ)) {
+				// 'curr' was removed, unlink it from this level (fails if 'pred' changed
+				// or was removed too)
+				uintptr_t expected = (uintptr_t)curr;
+				if (!atomic_compare_exchange_strong_explicit( &(pred->next[level]), &expected,
+															  succ & ~SKIPLIST_MARK,
+															  memory_order_acq_rel,
+															  memory_order_acquire ))
+					goto retry;
+
+				curr = SKIPLIST_PTR(succ);
+				continue;
+			}
+
+			if (list->compare(curr->data, key) >= 0)
+				break;
+
+			pred = curr;
+			curr = SKIPLIST_PTR(succ);
+		}
+
+		preds[level] = pred;
+		succs[level] = curr;
+	}
+
+	return (succs[0] != NULL) && (list->compare(succs[0]->data, key) == 0);
+}
+
+/*
+ * Gets the number of elements.
+ * */
+size_t skiplist_getsize(struct skiplist* list)
+{
+	return atomic_load_explicit(&(list->size), memory_order_relaxed);
+}
+
+/*
+ * Adds an element (thread safe).
+ * Returns 1 if added, 0 if an equal element is already in the list (the caller
+ * keeps the element) or out of memory.
+ * */
+int skiplist_add(struct skiplist* list, void* value)
+{
+	struct skiplistnode* preds[SKIPLIST_MAX_LEVEL];
+	struct skiplistnode* succs[SKIPLIST_MAX_LEVEL];
+	struct skiplistnode* node = NULL;
+	int toplevel = skiplist_randomlevel();
+
+	// link level 0: the element is in the set from here on
+	for (;;) {
+		if (skiplist_find(list, value, preds, succs)) {
+			free(node);
+			return 0;
+		}
+
+		if (node == NULL) {
+			node = skiplist_createnode(value, toplevel);
+			if (node == NULL)
+				return 0;
+		}
+
+		for (int level = 0; level < toplevel; level++)
+			atomic_store_explicit(&(node->next[level]), (uintptr_t)succs[level], memory_order_relaxed);
+
+		// counted before it is visible, so a concurrent remove never takes size below 0
+		atomic_fetch_add_explicit(&(list->size), 1, memory_order_relaxed);
+		uintptr_t expected = (uintptr_t)succs[0];
+		if (atomic_compare_exchange_strong_explicit( &(preds[0]->next[0]), &expected, (uintptr_t)node,
+													 memory_order_release, memory_order_relaxed ))
+			break;
+
+		atomic_fetch_sub_explicit(&(list->size), 1, memory_order_relaxed);
+	}
+
+	// link the upper levels, stop if a remove marks the node meanwhile
+	for (int level = 1; level < toplevel; level++) {
+		for (;;) {
+			uintptr_t next = atomic_load_explicit(&(node->next[level]), memory_order_acquire);
+			if (SKIPLIST_ISMARKED(next))
+				return 1;
+
+			if ( (next != (uintptr_t)succs[level])
+				 && !atomic_compare_exchange_strong_explicit( &(node->next[level]), &next,
+						 	 	 	 	 	 	 	 	 	  (uintptr_t)succs[level],
+															  memory_order_release,
+															  memory_order_relaxed ) )
+				continue;
+
+			uintptr_t expected = (uintptr_t)succs[level];
+			if (atomic_compare_exchange_strong_explicit( &(preds[level]->next[level]), &expected,
+														 (uintptr_t)node, memory_order_release,
+														 memory_order_relaxed ))
+				break;
+
+			skiplist_find(list, value, preds, succs);
+			if (succs[0] != node)
+				return 1;		// removed meanwhile
+		}
+
+		// removed while being linked: unlink this level again (the remover may have
+		// searched before it was linked)
+		if (SKIPLIST_ISMARKED(atomic_load_explicit(&(node->next[level]), memory_order_acquire))) {
+			skiplist_find(list, value, preds, succs);
+			return 1;
+		}
+	}
+
+	return 1;
+}
+
+/*
+ * Checks if list contains an element equal to 'value' (thread safe).
+ * */
+int skiplist_contains(struct skiplist* list, const void* value)
+{
+	struct skiplistnode* pred = list->head;
+	struct skiplistnode* curr = NULL;
+
+	for (int level = SKIPLIST_MAX_LEVEL - 1; level >= 0; level--) {
+		curr = SKIPLIST_PTR(atomic_load_explicit(&(pred->next[level]), memory_order_acquire));
+		while (curr != NULL) {
+			uintptr_t succ = atomic_load_explicit(&(curr->next[level]), memory_order_acquire);
+			while (SKIPLIST_ISMARKED(succ)) {
+				// step over removed nodes
+				curr = SKIPLIST_PTR(succ);
+				if (curr == NULL)
+					break;
+
+				succ = atomic_load_explicit(&(curr->next[level]), memory_order_acquire);
+			}
+
+			if ((curr == NULL) || (list->compare(curr->data, value) >= 0))
+				break;
+
+			pred = curr;
+			curr = SKIPLIST_PTR(succ);
+		}
+	}
+
+	return (curr != NULL) && (list->compare(curr->data, value) == 0);
+}
+
+/*
+ * Adds a removed node to the retired list (thread safe).
+ * Note: Private function.
+ * */
+void skiplist_retire(struct skiplist* list, struct skiplistnode* node)
+{
+	node->retired = atomic_load_explicit(&(list->retired), memory_order_relaxed);
+	while (!atomic_compare_exchange_weak_explicit( &(list->retired), &(node->retired), node,
+												   memory_order_release, memory_order_relaxed ))
+		;
+}
+
+/*
+ * Removes the element equal to 'value' (thread safe).
+ * The element is released by skiplist_reclaim or skiplist_destroy.
+ * Returns 1 if removed, 0 if not found.
+ * */
+int skiplist_remove(struct skiplist* list, const void* value)
+{
+	struct skiplistnode* preds[SKIPLIST_MAX_LEVEL];
+	struct skiplistnode* succs[SKIPLIST_MAX_LEVEL];
+
+	if (!skiplist_find(list, value, preds, succs))
+		return 0;
+
+	// mark the upper levels, top down
+	struct skiplistnode* node = succs[0];
+	for (int level = node->toplevel - 1; level >= 1; level--) {
+		uintptr_t next = atomic_load_explicit(&(node->next[level]), memory_order_acquire);
+		while ( !SKIPLIST_ISMARKED(next)
+				&& !atomic_compare_exchange_weak_explicit( &(node->next[level]), &next,
+														   next | SKIPLIST_MARK,
+														   memory_order_acq_rel,
+														   memory_order_acquire ) )
+			;
+	}
+
+	// marking level 0 removes the element, only one thread succeeds
+	uintptr_t next = atomic_load_explicit(&(node->next[0]), memory_order_acquire);
+	while (!SKIPLIST_ISMARKED(next)) {
+		if (atomic_compare_exchange_weak_explicit( &(node->next[0]), &next, next | SKIPLIST_MARK,
+												   memory_order_acq_rel, memory_order_acquire )) {
+			atomic_fetch_sub_explicit(&(list->size), 1, memory_order_relaxed);
+			skiplist_find(list, value, preds, succs);		// unlink it
+			skiplist_retire(list, node);
+			return 1;
+		}
+	}
+
+	return 0;		// removed by another thread
+}
+
+/*
+ * Gets floor element of a key: greatest element lesser than or equal to the key.
+ * Returns NULL if there is none.
+ * */
+void* skiplist_floor(struct skiplist* list, const void* key)
+{
+	struct skiplistnode* preds[SKIPLIST_MAX_LEVEL];
+	struct skiplistnode* succs[SKIPLIST_MAX_LEVEL];
+
+	if (skiplist_find(list, key, preds, succs))
+		return succs[0]->data;
+
+	return (preds[0] != list->head) ? preds[0]->data : NULL;
+}
+
+/*
+ * Gets ceiling element of a key: smallest element larger than or equal to the key.
+ * Returns NULL if there is none.
+ * */
+void* skiplist_ceiling(struct skiplist* list, const void* key)
+{
+	struct skiplistnode* preds[SKIPLIST_MAX_LEVEL];
+	struct skiplistnode* succs[SKIPLIST_MAX_LEVEL];
+
+	skiplist_find(list, key, preds, succs);
+	return (succs[0] != NULL) ? succs[0]->data : NULL;
+}
+
+/*
+ * Gets the first node of level 0 not lesser than 'from' that is not removed, or the
+ * first node if 'from' is NULL.
+ * Note: Private function.
+ * */
+struct skiplistnode* skiplist_first_from(struct skiplist* list, const void* from)
+{
+	struct skiplistnode* curr;
+	if (from != NULL) {
+		struct skiplistnode* preds[SKIPLIST_MAX_LEVEL];
+		struct skiplistnode* succs[SKIPLIST_MAX_LEVEL];
+		skiplist_find(list, from, preds, succs);
+		curr = succs[0];
+	}
+	else
+		curr = SKIPLIST_PTR(atomic_load_explicit(&(list->head->next[0]), memory_order_acquire));
+
+	while ( (curr != NULL)
+			&& SKIPLIST_ISMARKED(atomic_load_explicit(&(curr->next[0]), memory_order_acquire)) )
+		curr = SKIPLIST_PTR(atomic_load_explicit(&(curr->next[0]), memory_order_acquire));
+
+	return curr;
+}
+
+/*
+ * Gets the smallest element.
+ * Returns NULL if list is empty.
+ * */
+void* skiplist_min(struct skiplist* list)
+{
+	struct skiplistnode* first = skiplist_first_from(list, NULL);
+	return (first != NULL) ? first->data : NULL;
+}
+
+/*
+ * Gets the largest element.
+ * Returns NULL if list is empty.
+ * */
+void* skiplist_max(struct skiplist* list)
+{
+	// move right only onto nodes that are not removed, so 'pred' is a candidate
+	struct skiplistnode* pred = list->head;
+	for (int level = SKIPLIST_MAX_LEVEL - 1; level >= 0; level--) {
+		struct skiplistnode* curr = SKIPLIST_PTR(atomic_load_explicit(&(pred->next[level]),
+																	  memory_order_acquire));
+		while (curr != NULL) {
+			if (!SKIPLIST_ISMARKED(atomic_load_explicit(&(curr->next[0]), memory_order_acquire)))
+				pred = curr;
+
+			curr = SKIPLIST_PTR(atomic_load_explicit(&(curr->next[level]), memory_order_acquire));
+		}
+	}
+
+	return (pred != list->head) ? pred->data : NULL;
+}
+
+/*
+ * Calls 'visit' for each element in [from, to] in ascending order.
+ * Returns the number of visited elements.
+ * */
+size_t skiplist_foreach_range( struct skiplist* list, const void* from, const void* to,
+							   skiplist_visit visit, void* arg )
+{
+	size_t count = 0;
+	struct skiplistnode* curr = skiplist_first_from(list, from);
+
+	while ((curr != NULL) && (list->compare(curr->data, to) <= 0)) {
+		uintptr_t next = atomic_load_explicit(&(curr->next[0]), memory_order_acquire);
+		if (!SKIPLIST_ISMARKED(next)) {
+			visit(curr->data, arg);
+			count++;
+		}
+
+		curr = SKIPLIST_PTR(next);
+	}
+
+	return count;
+}
+
+/*
+ * Adds an element to an arraylist (visit function of skiplist_toarraylist_range).
+ * Note: Private function.
+ * */
+void skiplist_range_visitor(void* element, void* arg)
+{
+	arraylist_add((struct arraylist*)arg, element);
+}
+
+/*
+ * Returns elements between a given range in ascending order (elements are not
+ * copied).
+ * Note: Returning list must be released later from memory.
+ * */
+struct arraylist* skiplist_toarraylist_range( struct skiplist* list, const void* from,
+											  const void* to )
+{
+	struct arraylist* result = arraylist_create();
+	if (result != NULL)
+		skiplist_foreach_range(list, from, to, skiplist_range_visitor, result);
+
+	return result;
+}
+
+/*
+ * Releases the removed nodes and their elements.
+ * Note: Not thread safe, no other thread may be using the list.
+ * Returns the number of released nodes.
+ * */
+size_t skiplist_reclaim(struct skiplist* list)
+{
+	// unlink marked nodes still linked at some level (ex: a remove that lost the
+	// race to unlink against an insert still linking upper levels)
+	for (int level = 0; level < SKIPLIST_MAX_LEVEL; level++) {
+		struct skiplistnode* pred = list->head;
+		struct skiplistnode* curr = SKIPLIST_PTR(atomic_load_explicit(&(pred->next[level]),
+																	  memory_order_relaxed));
+		while (curr != NULL) {
+			uintptr_t succ = atomic_load_explicit(&(curr->next[level]), memory_order_relaxed);
+			if (SKIPLIST_ISMARKED(succ))
+				atomic_store_explicit(&(pred->next[level]), succ & ~SKIPLIST_MARK, memory_order_relaxed);
+			else
+				pred = curr;
+
+			curr = SKIPLIST_PTR(succ);
+		}
+	}
+
+	size_t count = 0;
+	struct skiplistnode* node = atomic_exchange_explicit(&(list->retired), NULL, memory_order_acquire);
+	while (node != NULL) {
+		struct skiplistnode* next = node->retired;
+		if (list->freedata)
+			list->freedata(node->data);
+
+		free(node);
+		node = next;
+		count++;
+	}
+
+	return count;
+}
+
+/*
+ * Prints the elements in ascending order.
+ * */
+void skiplist_print(struct skiplist* list)
+{
+	if (!list->printelement) {
+		printf("Error: 'printelement' function is undefined. Can't print skip list.");
+		abort();
+	}
+
+	printf("{ ");
+	struct skiplistnode* curr = skiplist_first_from(list, NULL);
+	while (curr != NULL) {
+		list->printelement(curr->data);
+
+		curr = SKIPLIST_PTR(atomic_load_explicit(&(curr->next[0]), memory_order_acquire));
+		while ( (curr != NULL)
+				&& SKIPLIST_ISMARKED(atomic_load_explicit(&(curr->next[0]), memory_order_acquire)) )
+			curr = SKIPLIST_PTR(atomic_load_explicit(&(curr->next[0]), memory_order_acquire));
+
+		if (curr != NULL)
+			printf("; ");
+	}
+
+	printf(" }\n");
+}
+
+/*
+ * Removes and releases all elements.
+ * Note: Not thread safe.
+ * */
+void skiplist_clear(struct skiplist* list)
+{
+	skiplist_reclaim(list);
+
+	struct skiplistnode* curr = SKIPLIST_PTR(atomic_load_explicit(&(list->head->next[0]),
+																  memory_order_relaxed));
+	while (curr != NULL) {
+		struct skiplistnode* next = SKIPLIST_PTR(atomic_load_explicit(&(curr->next[0]),
+																	  memory_order_relaxed));
+		if (list->freedata)
+			list->freedata(curr->data);
+
+		free(curr);
+		curr = next;
+	}
+
+	for (int level = 0; level < SKIPLIST_MAX_LEVEL; level++)
+		atomic_store_explicit(&(list->head->next[level]), 0, memory_order_relaxed);
+
+	atomic_store_explicit(&(list->size), 0, memory_order_relaxed);
+}
+
+/*
+ * Releases the skip list and its elements from memory.
+ * Note: Not thread safe.
+ * */
+void skiplist_destroy(struct skiplist* list)
+{
+	skiplist_clear(list);
+	free(list->head);
+	free(list);
+}
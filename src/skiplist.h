@@ -0,0 +1,173 @@
+/*****************************************************************************
+ * skiplist.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a lock-free concurrent skip list, an ordered set that
+ *  			 many threads can insert into, remove from and search at the same time.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A red-black tree (treeset.h) cannot take concurrent writers: a rotation changes
+ *  nodes far from the inserted one. A skip list is a sorted linked list with extra
+ *  express levels (node levels are random, each level has half the nodes of the one
+ *  below), so an insert or remove only changes the links next to its own node, with one
+ *  CAS per level and no locks:
+ *
+ *  	- insert: find the predecessors and successors of the key at every level, link
+ *  	  the node at level 0 with a CAS (this is the moment it becomes part of the set),
+ *  	  then link the upper levels one by one;
+ *  	- remove: mark the next pointers of the node, from the top level down (the mark
+ *  	  is the low bit of the pointer). Marking level 0 removes the element; the
+ *  	  thread that marks it owns the removal. Marked nodes are unlinked by the
+ *  	  searches of any thread that walks over them;
+ *  	- contains, min and max never write (they step over marked nodes); floor and
+ *  	  ceiling run the insert search, which also unlinks the marked nodes it meets.
+ *
+ *  Threads working on different keys rarely CAS the same pointer, so insert
+ *  throughput grows with the number of threads.
+ *
+ *  Memory reclamation: a thread may still be reading a node right after another
+ *  thread removed it. Removed nodes (and their elements) are kept in a retired list
+ *  and released by skiplist_reclaim or skiplist_destroy, which must be called when no
+ *  other thread is using the list (ex: between batches of work). Because elements are
+ *  compared until then, skiplist_remove does not give the element back.
+ *
+ *  Range traversals (skiplist_foreach_range, skiplist_toarraylist_range) are weakly
+ *  consistent: they see each element that is in the set for the whole traversal,
+ *  elements added or removed meanwhile may or may not be seen.
+ *
+ *  Source: M. Herlihy, N. Shavit, "The Art of Multiprocessor Programming", chapter 14
+ *  		 (Lock-free skip lists).
+ *  		 K. Fraser, "Practical lock-freedom", PhD thesis, University of Cambridge (2004).
+ *
+ *******************************************************************************/
+
+#ifndef SKIPLIST_H_
+	#define SKIPLIST_H_
+
+	#include <stddef.h>
+	#include <stdint.h>
+	#include <stdatomic.h>
+	#include "arraylist.h"
+
+	#define SKIPLIST_MAX_LEVEL 24				// enough for 2^24 (16M) elements at p = 1/2
+
+	typedef int (*skiplist_compare)(const void* data1, const void* data2);
+	typedef void (*skiplist_printelement)(const void* data);
+	typedef void (*skiplist_freedata)(void* data);
+
+	// visit function for range traversals
+	typedef void (*skiplist_visit)(void* element, void* arg);
+
+	// skip list node, 'next' holds 'toplevel' marked pointers
+	struct skiplistnode {
+		void* data;
+		int toplevel;
+		struct skiplistnode* retired;			// next node of the retired list
+		_Atomic(uintptr_t) next[];
+	};
+
+	// skip list type
+	struct skiplist {
+		struct skiplistnode* head;				// sentinel with SKIPLIST_MAX_LEVEL levels
+		atomic_size_t size;
+		_Atomic(struct skiplistnode*) retired;	// removed nodes not yet released
+		skiplist_compare compare;
+		skiplist_printelement printelement;
+		skiplist_freedata freedata;
+	};
+
+	/*
+	 * Creates a new empty skip list.
+	 * Returns the new skip list if succeeded, NULL otherwise.
+	 * */
+	struct skiplist* skiplist_create( skiplist_compare comparefunc,
+									  skiplist_printelement printelementfunc,
+									  skiplist_freedata freedatafunc );
+
+	/*
+	 * Gets the number of elements.
+	 * */
+	size_t skiplist_getsize(struct skiplist* list);
+
+	/*
+	 * Adds an element (thread safe).
+	 * Returns 1 if added, 0 if an equal element is already in the list (the caller
+	 * keeps the element) or out of memory.
+	 * */
+	int skiplist_add(struct skiplist* list, void* value);
+
+	/*
+	 * Checks if list contains an element equal to 'value' (thread safe).
+	 * */
+	int skiplist_contains(struct skiplist* list, const void* value);
+
+	/*
+	 * Removes the element equal to 'value' (thread safe).
+	 * The element is released by skiplist_reclaim or skiplist_destroy.
+	 * Returns 1 if removed, 0 if not found.
+	 * */
+	int skiplist_remove(struct skiplist* list, const void* value);
+
+	/*
+	 * Gets floor element of a key: greatest element lesser than or equal to the key.
+	 * Returns NULL if there is none.
+	 * */
+	void* skiplist_floor(struct skiplist* list, const void* key);
+
+	/*
+	 * Gets ceiling element of a key: smallest element larger than or equal to the key.
+	 * Returns NULL if there is none.
+	 * */
+	void* skiplist_ceiling(struct skiplist* list, const void* key);
+
+	/*
+	 * Gets the smallest / largest element.
+	 * Returns NULL if list is empty.
+	 * */
+	void* skiplist_min(struct skiplist* list);
+	void* skiplist_max(struct skiplist* list);
+
+	/*
+	 * Calls 'visit' for each element in [from, to] in ascending order.
+	 * Returns the number of visited elements.
+	 * */
+	size_t skiplist_foreach_range( struct skiplist* list, const void* from, const void* to,
+								   skiplist_visit visit, void* arg );
+
+	/*
+	 * Returns elements between a given range in ascending order (elements are not
+	 * copied).
+	 * Note: Returning list must be released later from memory.
+	 * */
+	struct arraylist* skiplist_toarraylist_range( struct skiplist* list, const void* from,
+												  const void* to );
+
+	/*
+	 * Releases the removed nodes and their elements.
+	 * Note: Not thread safe, no other thread may be using the list.
+	 * Returns the number of released nodes.
+	 * */
+	size_t skiplist_reclaim(struct skiplist* list);
+
+	/*
+	 * Prints the elements in ascending order.
+	 * */
+	void skiplist_print(struct skiplist* list);
+
+	/*
+	 * Removes and releases all elements.
+	 * Note: Not thread safe.
+	 * */
+	void skiplist_clear(struct skiplist* list);
+
+	/*
+	 * Releases the skip list and its elements from memory.
+	 * Note: Not thread safe.
+	 * */
+	void skiplist_destroy(struct skiplist* list);
+
+#endif /* SKIPLIST_H_ */
@@ -0,0 +1,176 @@
+/*
+ * slidingwindow.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Sliding window minimum and maximum with monotonic array deques.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "slidingwindow.h"
+
+/*
+ * Creates a sliding window of the last 'capacity' values (at least 1), limited to
+ * the values of the last 'span' time units if 'span' > 0.
+ */
+struct slidingwindow* slidingwindow_create(size_t capacity, double span)
+{
+	if (capacity < 1)
+		capacity = 1;
+
+	struct slidingwindow* result = (struct slidingwindow*)malloc(sizeof(struct slidingwindow));
+	struct slidingwindow_entry* entries = (result != NULL) ? (struct slidingwindow_entry*)malloc(
+										  capacity * sizeof(struct slidingwindow_entry)) : NULL;
+	if (entries == NULL) {
+		printf("Memory error: failed to allocate memory for sliding window!\n");
+		abort();
+	}
+
+	result->capacity = capacity;
+	result->span = (span > 0) ? span : 0;
+	result->nextseq = 0;
+	result->oldestseq = 0;
+	result->entries = entries;
+	size_t dequecapacity = (capacity > ARRAYDEQUE_MIN_CAPACITY) ? capacity : ARRAYDEQUE_MIN_CAPACITY;
+	result->mindeque = arraydeque_create_capacity(dequecapacity, NULL, NULL);
+	result->maxdeque = arraydeque_create_capacity(dequecapacity, NULL, NULL);
+
+	// deques never hold more entries than the window: no growth nor shrink afterwards
+	if (!arraydeque_reserve(result->mindeque, dequecapacity) || !arraydeque_reserve(result->maxdeque, dequecapacity)) {
+		printf("Memory error: failed to allocate memory for sliding window deques!\n");
+		abort();
+	}
+
+	return result;
+}
+
+/*
+ * Drops the oldest values of the window while 'oldestseq' is behind 'seq' or, if
+ * the window has a time span, while they are not after 'time' - span.
+ * Note: Private function.
+ */
+void slidingwindow_drop(struct slidingwindow* window, size_t seq, double time)
+{
+	while (window->oldestseq < window->nextseq) {
+		const struct slidingwindow_entry* oldest = &window->entries[window->oldestseq % window->capacity];
+		if ((window->oldestseq >= seq) && ((window->span == 0) || (oldest->time > time - window->span)))
+			break;
+
+		window->oldestseq++;
+	}
+
+	// expired entries are at the front of the deques
+	while ((window->mindeque->size > 0) &&
+		   (((struct slidingwindow_entry*)arraydeque_front(window->mindeque))->seq < window->oldestseq))
+		arraydeque_pop_front(window->mindeque);
+
+	while ((window->maxdeque->size > 0) &&
+		   (((struct slidingwindow_entry*)arraydeque_front(window->maxdeque))->seq < window->oldestseq))
+		arraydeque_pop_front(window->maxdeque);
+}
+
+/*
+ * Adds a value at a given time to the window (times must not decrease) and drops
+ * the values leaving the window. O(1) amortized.
+ */
+void slidingwindow_push(struct slidingwindow* window, double value, double time)
+{
+	// the new value takes the slot of the value 'capacity' pushes older
+	size_t seq = window->nextseq;
+	slidingwindow_drop(window, (seq >= window->capacity) ? seq - window->capacity + 1 : 0, time);
+
+	struct slidingwindow_entry* entry = &window->entries[seq % window->capacity];
+	entry->value = value;
+	entry->time = time;
+	entry->seq = seq;
+	window->nextseq++;
+
+	// entries that can not be the minimum (maximum) of any window holding the new one
+	while ((window->mindeque->size > 0) &&
+		   (((struct slidingwindow_entry*)arraydeque_back(window->mindeque))->value >= value))
+		arraydeque_pop_back(window->mindeque);
+
+	while ((window->maxdeque->size > 0) &&
+		   (((struct slidingwindow_entry*)arraydeque_back(window->maxdeque))->value <= value))
+		arraydeque_pop_back(window->maxdeque);
+
+	arraydeque_push_back(window->mindeque, entry);
+	arraydeque_push_back(window->maxdeque, entry);
+}
+
+/*
+ * Drops the values that are out of the window at a given time, without adding a
+ * value (only for windows with a time span).
+ */
+void slidingwindow_expire(struct slidingwindow* window, double time)
+{
+	if (window->span > 0)
+		slidingwindow_drop(window, window->oldestseq, time);
+}
+
+/*
+ * Gets the minimum value of the window.
+ * Returns 1 if succeeded, 0 otherwise (window is empty).
+ */
+int slidingwindow_getmin(const struct slidingwindow* window, double* value)
+{
+	if (window->mindeque->size == 0)
+		return 0;
+
+	*value = ((struct slidingwindow_entry*)arraydeque_front(window->mindeque))->value;
+	return 1;
+}
+
+/*
+ * Gets the maximum value of the window.
+ * Returns 1 if succeeded, 0 otherwise (window is empty).
+ */
+int slidingwindow_getmax(const struct slidingwindow* window, double* value)
+{
+	if (window->maxdeque->size == 0)
+		return 0;
+
+	*value = ((struct slidingwindow_entry*)arraydeque_front(window->maxdeque))->value;
+	return 1;
+}
+
+/*
+ * Gets the number of values in the window.
+ */
+size_t slidingwindow_getcount(const struct slidingwindow* window)
+{
+	return window->nextseq - window->oldestseq;
+}
+
+/*
+ * Checks if the window is empty.
+ */
+int slidingwindow_isempty(const struct slidingwindow* window)
+{
+	return (window->nextseq == window->oldestseq);
+}
+
+/*
+ * Removes every value from the window.
+ */
+void slidingwindow_clear(struct slidingwindow* window)
+{
+	window->oldestseq = window->nextseq;
+	while (window->mindeque->size > 0)
+		arraydeque_pop_back(window->mindeque);
+
+	while (window->maxdeque->size > 0)
+		arraydeque_pop_back(window->maxdeque);
+}
+
+/*
+ * Releases a sliding window from memory.
+ */
+void slidingwindow_destroy(struct slidingwindow* window)
+{
+	arraydeque_destroy(window->mindeque);
+	arraydeque_destroy(window->maxdeque);
+	free(window->entries);
+	free(window);
+}
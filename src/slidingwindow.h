@@ -0,0 +1,109 @@
+/*****************************************************************************
+ * slidingwindow.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers of a sliding window aggregate (minimum and maximum of the
+ *  			 last values of a stream) built on monotonic array deques.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  The window holds the last 'capacity' values pushed and, when a time span is given,
+ *  only the values whose time is greater than (time of the last push - span). Values
+ *  are kept in a circular array of 'capacity' entries (value, time and sequence number),
+ *  which is the FIFO of the window: the oldest entry leaves first.
+ *
+ *  Monotonic deques
+ *
+ *  	The minimum is tracked by an arraydeque of entries with increasing values: a new
+ *  	value first pops from the back every entry not lesser than itself (those can no
+ *  	longer be the minimum of any window holding the new value) and is then pushed at
+ *  	the back. The front is the minimum of the window; it is popped when it expires.
+ *  	The maximum uses a second deque with decreasing values.
+ *  	Every entry is pushed and popped at most once per deque, so push is O(1)
+ *  	amortized and getmin / getmax are O(1).
+ *
+ *  Memory is fixed at creation: the entries array and both deques are sized for
+ *  'capacity' entries (arraydeque_reserve, so the deques never grow nor shrink) and
+ *  pushes never allocate.
+ *
+ *  Source: https://www.geeksforgeeks.org/sliding-window-maximum-maximum-of-all-subarrays-of-size-k/
+ *
+ *******************************************************************************/
+
+#ifndef SLIDINGWINDOW_H_
+	#define SLIDINGWINDOW_H_
+
+	#include <stdlib.h>
+	#include "arraydeque.h"
+
+	// value of the window
+	struct slidingwindow_entry {
+		double value;
+		double time;
+		size_t seq;						// sequence number of the push
+	};
+
+	struct slidingwindow {
+		size_t capacity;				// maximum number of values in the window
+		double span;					// time span of the window (0: no time limit)
+		size_t nextseq;					// sequence number of the next push
+		size_t oldestseq;				// sequence number of the oldest value in the window
+		struct slidingwindow_entry* entries;	// values by sequence number (modulo capacity)
+		struct arraydeque* mindeque;	// entries of increasing values (front is the minimum)
+		struct arraydeque* maxdeque;	// entries of decreasing values (front is the maximum)
+	};
+
+	/*
+	 * Creates a sliding window of the last 'capacity' values (at least 1), limited to
+	 * the values of the last 'span' time units if 'span' > 0.
+	 */
+	struct slidingwindow* slidingwindow_create(size_t capacity, double span);
+
+	/*
+	 * Adds a value at a given time to the window (times must not decrease) and drops
+	 * the values leaving the window. O(1) amortized.
+	 */
+	void slidingwindow_push(struct slidingwindow* window, double value, double time);
+
+	/*
+	 * Drops the values that are out of the window at a given time, without adding a
+	 * value (only for windows with a time span).
+	 */
+	void slidingwindow_expire(struct slidingwindow* window, double time);
+
+	/*
+	 * Gets the minimum value of the window.
+	 * Returns 1 if succeeded, 0 otherwise (window is empty).
+	 */
+	int slidingwindow_getmin(const struct slidingwindow* window, double* value);
+
+	/*
+	 * Gets the maximum value of the window.
+	 * Returns 1 if succeeded, 0 otherwise (window is empty).
+	 */
+	int slidingwindow_getmax(const struct slidingwindow* window, double* value);
+
+	/*
+	 * Gets the number of values in the window.
+	 */
+	size_t slidingwindow_getcount(const struct slidingwindow* window);
+
+	/*
+	 * Checks if the window is empty.
+	 */
+	int slidingwindow_isempty(const struct slidingwindow* window);
+
+	/*
+	 * Removes every value from the window.
+	 */
+	void slidingwindow_clear(struct slidingwindow* window);
+
+	/*
+	 * Releases a sliding window from memory.
+	 */
+	void slidingwindow_destroy(struct slidingwindow* window);
+
+#endif /* SLIDINGWINDOW_H_ */
@@ -0,0 +1,254 @@
+/*
+ * snapshot.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Binary snapshot files shared by hashtable, treeset and trie: sequential
+ * 				writer and read only mapped images.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snapshot.h"
+
+#define SNAPSHOT_WRITE_BUFFER ((size_t)1 << 20)	// stdio buffer of the writer (1 MiB)
+#define SNAPSHOT_ENCODE_BUFFER 256				// initial encoding buffer
+
+/*
+ * Creates a snapshot file of the kind 'magic' (SNAPSHOT_MAGIC_...) and writes a
+ * blank header, records follow it.
+ * Returns 1 if succeeded, 0 otherwise.
+ */
+int snapshot_writer_open(struct snapshot_writer* w, const char* path, const char* magic)
+{
+	memset(w, 0, sizeof(*w));
+	w->file = fopen(path, "wb");
+	if (w->file == NULL)
+		return 0;
+
+	setvbuf(w->file, NULL, _IOFBF, SNAPSHOT_WRITE_BUFFER);
+	w->buffersize = SNAPSHOT_ENCODE_BUFFER;
+	w->buffer = (unsigned char*)malloc(w->buffersize);
+	if (w->buffer == NULL) {
+		fclose(w->file);
+		return 0;
+	}
+
+	memcpy(w->header.magic, magic, sizeof(w->header.magic));
+	w->header.version = SNAPSHOT_FILE_VERSION;
+	w->header.byteorder = SNAPSHOT_FILE_BYTEORDER;
+	snapshot_write(w, &(w->header), sizeof(w->header));
+	w->header.recordspos = w->pos;
+	return 1;
+}
+
+/*
+ * Writes 'size' bytes, padded to SNAPSHOT_FILE_ALIGN.
+ */
+void snapshot_write(struct snapshot_writer* w, const void* data, size_t size)
+{
+	static const unsigned char zeros[SNAPSHOT_FILE_ALIGN] = { 0 };
+	size_t pad = SNAPSHOT_ALIGNUP(size) - size;
+
+	if ((size > 0) && (fwrite(data, 1, size, w->file) != size))
+		w->failed = 1;
+	if ((pad > 0) && (fwrite(zeros, 1, pad, w->file) != pad))
+		w->failed = 1;
+
+	w->pos += size + pad;
+}
+
+/*
+ * Grows the writer buffer to at least 'size' bytes (contents are kept).
+ * Note: Private function.
+ */
+void snapshot_reserve(struct snapshot_writer* w, size_t size)
+{
+	if (size <= w->buffersize)
+		return;
+
+	size_t buffersize = w->buffersize;
+	while (buffersize < size)
+		buffersize *= 2;
+
+	unsigned char* buffer = (unsigned char*)realloc(w->buffer, buffersize);
+	if (buffer == NULL) {
+		printf("Memory error: failed to allocate memory for snapshot encoding buffer!");
+		abort();
+	}
+
+	w->buffer = buffer;
+	w->buffersize = buffersize;
+}
+
+/*
+ * Encodes an element in the writer buffer at 'offset' (buffer is grown when the
+ * element does not fit).
+ * Returns the size of the encoding.
+ * Note: Private function.
+ */
+size_t snapshot_encode_element( struct snapshot_writer* w, size_t offset, snapshot_encode encode,
+								const void* data, void* arg )
+{
+	snapshot_reserve(w, offset + 1);
+	size_t size = encode(data, w->buffer + offset, w->buffersize - offset, arg);
+	if (size > w->buffersize - offset) {
+		snapshot_reserve(w, offset + size);
+		encode(data, w->buffer + offset, w->buffersize - offset, arg);
+	}
+
+	return size;
+}
+
+/*
+ * Writes the record of a key (and value, if the codec encodes values).
+ */
+void snapshot_write_record( struct snapshot_writer* w, const struct snapshot_codec* codec,
+							uint64_t hash, const void* key, const void* value )
+{
+	// value is encoded after the padded key, both written with the record
+	struct snapshot_record rec = { hash, 0, 0 };
+	rec.keysize = (uint32_t)snapshot_encode_element(w, 0, codec->encodekey, key, codec->arg);
+	size_t valuepos = SNAPSHOT_ALIGNUP((size_t)rec.keysize);
+
+	if (codec->encodevalue != NULL)
+		rec.valuesize = (uint32_t)snapshot_encode_element(w, valuepos, codec->encodevalue, value, codec->arg);
+
+	snapshot_write(w, &rec, sizeof(rec));
+	snapshot_write(w, w->buffer, rec.keysize);
+	snapshot_write(w, w->buffer + valuepos, rec.valuesize);
+	w->header.count++;
+}
+
+/*
+ * Writes the header (w->header, its size fields are set here) and closes the file.
+ * Returns 1 if every write succeeded, 0 otherwise.
+ */
+int snapshot_writer_close(struct snapshot_writer* w)
+{
+	w->header.filesize = w->pos;
+	if ((fseek(w->file, 0, SEEK_SET) != 0)
+		|| (fwrite(&(w->header), 1, sizeof(w->header), w->file) != sizeof(w->header)))
+		w->failed = 1;
+
+	if (fclose(w->file) != 0)
+		w->failed = 1;
+
+	free(w->buffer);
+	w->file = NULL;
+	w->buffer = NULL;
+	return !w->failed;
+}
+
+/*
+ * Checks the header of a snapshot of a given size and kind.
+ * Note: Private function.
+ */
+int snapshot_image_ok(const void* data, size_t size, const char* magic)
+{
+	if (size < sizeof(struct snapshot_fileheader))
+		return 0;
+
+	const struct snapshot_fileheader* h = (const struct snapshot_fileheader*)data;
+	uint64_t recordsend = (h->indexpos != 0) ? h->indexpos : h->filesize;
+
+	return (memcmp(h->magic, magic, sizeof(h->magic)) == 0)
+		&& (h->version == SNAPSHOT_FILE_VERSION)
+		&& (h->byteorder == SNAPSHOT_FILE_BYTEORDER)
+		&& (h->filesize <= size)
+		&& (h->recordspos >= sizeof(struct snapshot_fileheader))
+		&& (h->recordspos <= recordsend) && (recordsend <= h->filesize)
+		&& ((h->indexpos == 0)
+			|| (((h->filesize - h->indexpos) / sizeof(uint64_t) > h->capacity)
+				&& ((h->indexpos % SNAPSHOT_FILE_ALIGN) == 0)));
+}
+
+/*
+ * Maps a snapshot file of the kind 'magic' read only and checks its header.
+ * 'sequential' advises the kernel to read ahead (loads) instead of reading the
+ * pages on access only (views).
+ * Returns 1 if succeeded, 0 if the file can not be mapped or is not a valid snapshot.
+ */
+int snapshot_image_open(struct snapshot_image* img, const char* path, const char* magic, int sequential)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return 0;
+
+	struct stat s;
+	if ((fstat(fd, &s) != 0) || ((size_t)s.st_size < sizeof(struct snapshot_fileheader))) {
+		close(fd);
+		return 0;
+	}
+
+	void* mapping = mmap(NULL, s.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);	// mapping keeps the file open
+	if (mapping == MAP_FAILED)
+		return 0;
+
+	if (!snapshot_image_ok(mapping, s.st_size, magic)) {
+		munmap(mapping, s.st_size);
+		return 0;
+	}
+
+	madvise(mapping, s.st_size, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+	img->data = (const unsigned char*)mapping;
+	img->size = s.st_size;
+	img->header = (const struct snapshot_fileheader*)mapping;
+	return 1;
+}
+
+/*
+ * Gets the record at position 'pos' of a snapshot.
+ * Returns the record, NULL if it is out of the records section (corrupt file).
+ */
+const struct snapshot_record* snapshot_image_record(const struct snapshot_image* img, uint64_t pos)
+{
+	const struct snapshot_fileheader* h = img->header;
+	uint64_t end = (h->indexpos != 0) ? h->indexpos : h->filesize;
+
+	if ((pos < h->recordspos) || (pos % SNAPSHOT_FILE_ALIGN != 0)
+		|| (pos + sizeof(struct snapshot_record) > end))
+		return NULL;
+
+	const struct snapshot_record* rec = (const struct snapshot_record*)(img->data + pos);
+	if (snapshot_record_next(rec, pos) > end)
+		return NULL;
+
+	return rec;
+}
+
+/*
+ * Gets the position of the record following the record at 'pos'.
+ */
+uint64_t snapshot_record_next(const struct snapshot_record* rec, uint64_t pos)
+{
+	return pos + sizeof(struct snapshot_record) + SNAPSHOT_ALIGNUP((uint64_t)rec->keysize)
+		   + SNAPSHOT_ALIGNUP((uint64_t)rec->valuesize);
+}
+
+/*
+ * Gets the encoded value of a record.
+ */
+const void* snapshot_record_value(const struct snapshot_record* rec)
+{
+	return rec->data + SNAPSHOT_ALIGNUP((uint64_t)rec->keysize);
+}
+
+/*
+ * Unmaps a snapshot file.
+ */
+void snapshot_image_close(struct snapshot_image* img)
+{
+	if (img->data != NULL)
+		munmap((void*)img->data, img->size);
+
+	img->data = NULL;
+	img->header = NULL;
+	img->size = 0;
+}
@@ -0,0 +1,174 @@
+/*****************************************************************************
+ * snapshot.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers of the binary snapshot files shared by hashtable, treeset
+ *  			 and trie (save, bulk load and read only mapped views).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A snapshot is a header followed by sections, every position aligned to 8 bytes:
+ *
+ *  	- the header (struct snapshot_fileheader) names the container (magic), the file
+ *  	  version and byte order, and the container settings (capacity, load factor...);
+ *  	- the records: one per element, { hash, key size, value size } followed by the
+ *  	  encoded key and value, each padded to 8 bytes so decoders can read them in
+ *  	  place (the trie writes its nodes there instead, see trie_save);
+ *  	- an optional index (hash tables: offset of the first record of each bucket).
+ *
+ *  Keys and values are written and read by the callbacks of a 'struct snapshot_codec':
+ *  the encoder works like snprintf (writes at most 'size' bytes and returns the size
+ *  it needs, so it is called again with a larger buffer when the element does not fit)
+ *  and the decoder builds a new element from its encoding.
+ *
+ *  Files are written sequentially and loaded back with one sequential pass over a
+ *  read only mapping (madvise sequential), so a load runs at about the speed of a
+ *  sequential read of the file and containers are built in bulk (see hashtable_load,
+ *  treeset_load and trie_load). A mapping can also be kept as a read only view, see
+ *  hashtable_view_open.
+ *
+ *  Snapshots are only readable on machines with the same byte order.
+ *
+ *******************************************************************************/
+
+#ifndef SNAPSHOT_H_
+	#define SNAPSHOT_H_
+
+	#include <stdio.h>
+	#include <stdint.h>
+	#include <stddef.h>
+
+	#define SNAPSHOT_FILE_VERSION 1
+	#define SNAPSHOT_FILE_BYTEORDER 0x01020304		// detects snapshots written with other byte order
+	#define SNAPSHOT_FILE_ALIGN 8					// alignment of sections, keys and values
+	#define SNAPSHOT_MAGIC_HASHTABLE "SNAPHTAB"		// first 8 bytes of each kind of snapshot
+	#define SNAPSHOT_MAGIC_TREESET "SNAPTSET"
+	#define SNAPSHOT_MAGIC_TRIE "SNAPTRIE"
+
+	// flags of a snapshot header
+	#define SNAPSHOT_FLAG_VALUES 1					// records have values
+	#define SNAPSHOT_FLAG_HASH64 2					// hash table saved with a 64 bit hash function
+	#define SNAPSHOT_FLAG_INCREMENTAL 4				// hash table with incremental resize
+
+	#define SNAPSHOT_ALIGNUP(n) (((n) + SNAPSHOT_FILE_ALIGN - 1) & ~(uint64_t)(SNAPSHOT_FILE_ALIGN - 1))
+
+	/*
+	 * Encodes an element: writes at most 'size' bytes in 'buffer'.
+	 * Returns the size of the encoding (if greater than 'size' nothing was written and
+	 * the encoder is called again with a buffer of that size).
+	 */
+	typedef size_t (*snapshot_encode)(const void* data, void* buffer, size_t size, void* arg);
+
+	/*
+	 * Decodes an element from 'size' bytes (aligned to 8) of a snapshot.
+	 * Returns the new element.
+	 */
+	typedef void* (*snapshot_decode)(const void* buffer, size_t size, void* arg);
+
+	// callbacks that write and read the elements of a snapshot
+	struct snapshot_codec {
+		snapshot_encode encodekey;
+		snapshot_decode decodekey;
+		snapshot_encode encodevalue;				// NULL: values are not saved (loaded as NULL)
+		snapshot_decode decodevalue;
+		void* arg;									// argument of all callbacks
+	};
+
+	// header of a snapshot file
+	struct snapshot_fileheader {
+		char magic[8];								// SNAPSHOT_MAGIC_...
+		uint32_t version;							// SNAPSHOT_FILE_VERSION
+		uint32_t byteorder;							// SNAPSHOT_FILE_BYTEORDER
+		uint64_t count;								// records (trie: nodes)
+		uint64_t capacity;							// hash table buckets, trie chars per node
+		uint64_t recordspos;						// first record
+		uint64_t indexpos;							// uint64_t[capacity + 1] bucket offsets (0 if none)
+		uint64_t filesize;							// total file size
+		uint32_t flags;								// SNAPSHOT_FLAG_...
+		float loadfactor;							// hash table settings
+		float resizefactor;
+		uint32_t reserved;
+	};
+
+	// record of an element (key followed by value, each padded to SNAPSHOT_FILE_ALIGN)
+	struct snapshot_record {
+		uint64_t hash;								// memoized key hash (0 if none)
+		uint32_t keysize;
+		uint32_t valuesize;
+		unsigned char data[];
+	};
+
+	// sequential writer of a snapshot file
+	struct snapshot_writer {
+		FILE* file;
+		struct snapshot_fileheader header;			// written again on close
+		uint64_t pos;								// bytes written
+		unsigned char* buffer;						// encoding buffer
+		size_t buffersize;
+		int failed;									// a write failed
+	};
+
+	// snapshot file mapped in memory (read only)
+	struct snapshot_image {
+		const unsigned char* data;
+		size_t size;
+		const struct snapshot_fileheader* header;
+	};
+
+	/*
+	 * Creates a snapshot file of the kind 'magic' (SNAPSHOT_MAGIC_...) and writes a
+	 * blank header, records follow it.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 */
+	int snapshot_writer_open(struct snapshot_writer* w, const char* path, const char* magic);
+
+	/*
+	 * Writes 'size' bytes, padded to SNAPSHOT_FILE_ALIGN.
+	 */
+	void snapshot_write(struct snapshot_writer* w, const void* data, size_t size);
+
+	/*
+	 * Writes the record of a key (and value, if the codec encodes values).
+	 */
+	void snapshot_write_record( struct snapshot_writer* w, const struct snapshot_codec* codec,
+								uint64_t hash, const void* key, const void* value );
+
+	/*
+	 * Writes the header (w->header, its size fields are set here) and closes the file.
+	 * Returns 1 if every write succeeded, 0 otherwise.
+	 */
+	int snapshot_writer_close(struct snapshot_writer* w);
+
+	/*
+	 * Maps a snapshot file of the kind 'magic' read only and checks its header.
+	 * 'sequential' advises the kernel to read ahead (loads) instead of reading the
+	 * pages on access only (views).
+	 * Returns 1 if succeeded, 0 if the file can not be mapped or is not a valid snapshot.
+	 */
+	int snapshot_image_open(struct snapshot_image* img, const char* path, const char* magic, int sequential);
+
+	/*
+	 * Gets the record at position 'pos' of a snapshot.
+	 * Returns the record, NULL if it is out of the records section (corrupt file).
+	 */
+	const struct snapshot_record* snapshot_image_record(const struct snapshot_image* img, uint64_t pos);
+
+	/*
+	 * Gets the position of the record following the record at 'pos'.
+	 */
+	uint64_t snapshot_record_next(const struct snapshot_record* rec, uint64_t pos);
+
+	/*
+	 * Gets the encoded value of a record.
+	 */
+	const void* snapshot_record_value(const struct snapshot_record* rec);
+
+	/*
+	 * Unmaps a snapshot file.
+	 */
+	void snapshot_image_close(struct snapshot_image* img);
+
+#endif /* SNAPSHOT_H_ */
@@ -0,0 +1,281 @@
+/*
+ * sortedarray.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Galloping search and set operations over sorted arrays.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "sortedarray.h"
+#include "binarysearch.h"
+
+#if defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
+
+/*
+ * Gets the index of the first element of sorted 'arr' not lesser than 'x', starting
+ * at 'start' (elements before it are known to be lesser), in O(log(index - start)).
+ * Returns n if there is none.
+ */
+size_t sortedarray_gallop_i32(const int32_t* arr, size_t n, size_t start, int32_t x)
+{
+	if (start >= n || arr[start] >= x)
+		return start;
+
+	// arr[lo] < x, double the step until arr[lo + bound] >= x
+	size_t lo = start, bound = 1;
+	while (lo + bound < n && arr[lo + bound] < x) {
+		lo += bound;
+		bound *= 2;
+	}
+
+	size_t hi = (lo + bound < n) ? lo + bound : n;
+	return lo + 1 + binarysearch_lower_bound_i32(arr + lo + 1, hi - lo - 1, x);
+}
+
+size_t sortedarray_gallop(void** arr, size_t n, size_t start, const void* x,
+						  sortedarray_compare compare)
+{
+	if (start >= n || compare(arr[start], x) >= 0)
+		return start;
+
+	size_t lo = start, bound = 1;
+	while (lo + bound < n && compare(arr[lo + bound], x) < 0) {
+		lo += bound;
+		bound *= 2;
+	}
+
+	// binary search in (lo, hi]
+	size_t hi = (lo + bound < n) ? lo + bound : n;
+	lo++;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (compare(arr[mid], x) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/*
+ * Intersection of a small set with a much larger one, by galloping.
+ */
+size_t sortedarray_intersect_gallop_i32(const int32_t* small, size_t ns, const int32_t* large,
+										size_t nl, int32_t* out)
+{
+	size_t count = 0, j = 0;
+	for (size_t i = 0; i < ns && j < nl; i++) {
+		j = sortedarray_gallop_i32(large, nl, j, small[i]);
+		if (j < nl && large[j] == small[i])
+			out[count++] = small[i];
+	}
+
+	return count;
+}
+
+/*
+ * Writes in 'out' the elements of both sets (capacity: min(na, nb)).
+ * Returns the number of written elements.
+ */
+size_t sortedarray_intersect_i32(const int32_t* a, size_t na, const int32_t* b, size_t nb,
+								 int32_t* out)
+{
+	if (na * SORTEDARRAY_GALLOP_RATIO < nb)
+		return sortedarray_intersect_gallop_i32(a, na, b, nb, out);
+	if (nb * SORTEDARRAY_GALLOP_RATIO < na)
+		return sortedarray_intersect_gallop_i32(b, nb, a, na, out);
+
+	size_t count = 0, i = 0, j = 0;
+#if defined(__SSE2__)
+	// blocks of 4: every element of 'a' block against every element of 'b' block
+	while (i + 4 <= na && j + 4 <= nb) {
+		__m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+		__m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+		__m128i eq = _mm_or_si128(
+						_mm_or_si128(_mm_cmpeq_epi32(va, vb),
+									 _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39))),
+						_mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4E)),
+									 _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93))));
+		int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+		while (mask) {
+			out[count++] = a[i + __builtin_ctz(mask)];
+			mask &= mask - 1;
+		}
+
+		int32_t amax = a[i + 3], bmax = b[j + 3];
+		i += (amax <= bmax) ? 4 : 0;
+		j += (bmax <= amax) ? 4 : 0;
+	}
+#endif
+
+	while (i < na && j < nb) {
+		if (a[i] < b[j])
+			i++;
+		else if (b[j] < a[i])
+			j++;
+		else {
+			out[count++] = a[i];
+			i++;
+			j++;
+		}
+	}
+
+	return count;
+}
+
+/*
+ * Writes in 'out' the elements of any of the sets (capacity: na + nb).
+ * Returns the number of written elements.
+ */
+size_t sortedarray_union_i32(const int32_t* a, size_t na, const int32_t* b, size_t nb,
+							 int32_t* out)
+{
+	size_t count = 0, i = 0, j = 0;
+	while (i < na && j < nb) {
+		int32_t x = a[i], y = b[j];
+		out[count++] = (x <= y) ? x : y;
+		i += (x <= y);
+		j += (y <= x);
+	}
+
+	while (i < na)
+		out[count++] = a[i++];
+	while (j < nb)
+		out[count++] = b[j++];
+
+	return count;
+}
+
+/*
+ * Writes in 'out' the elements of 'a' not in 'b' (capacity: na).
+ * Returns the number of written elements.
+ */
+size_t sortedarray_difference_i32(const int32_t* a, size_t na, const int32_t* b, size_t nb,
+								  int32_t* out)
+{
+	size_t count = 0, j = 0;
+	if (na * SORTEDARRAY_GALLOP_RATIO < nb) {
+		for (size_t i = 0; i < na; i++) {
+			j = sortedarray_gallop_i32(b, nb, j, a[i]);
+			if (j == nb || b[j] != a[i])
+				out[count++] = a[i];
+		}
+
+		return count;
+	}
+
+	size_t i = 0;
+	while (i < na && j < nb) {
+		if (a[i] < b[j])
+			out[count++] = a[i++];
+		else {
+			i += (a[i] == b[j]);
+			j++;
+		}
+	}
+
+	while (i < na)
+		out[count++] = a[i++];
+
+	return count;
+}
+
+/*
+ * Appends to 'out' the elements of both sets (elements of 'a'), of any of the sets
+ * (elements of 'a' when in both) or of 'a' not in 'b'. Elements are not copied.
+ * Returns the number of appended elements.
+ */
+size_t sortedarray_intersect(void** a, size_t na, void** b, size_t nb,
+							 sortedarray_compare compare, struct arraylist* out)
+{
+	size_t count = 0, i = 0, j = 0;
+	if (na * SORTEDARRAY_GALLOP_RATIO < nb) {
+		for (; i < na && j < nb; i++) {
+			j = sortedarray_gallop(b, nb, j, a[i], compare);
+			if (j < nb && compare(b[j], a[i]) == 0) {
+				arraylist_add(out, a[i]);
+				count++;
+			}
+		}
+
+		return count;
+	}
+
+	if (nb * SORTEDARRAY_GALLOP_RATIO < na) {
+		for (; j < nb && i < na; j++) {
+			i = sortedarray_gallop(a, na, i, b[j], compare);
+			if (i < na && compare(a[i], b[j]) == 0) {
+				arraylist_add(out, a[i]);
+				count++;
+			}
+		}
+
+		return count;
+	}
+
+	while (i < na && j < nb) {
+		int cmp = compare(a[i], b[j]);
+		if (cmp == 0) {
+			arraylist_add(out, a[i]);
+			count++;
+		}
+
+		i += (cmp <= 0);
+		j += (cmp >= 0);
+	}
+
+	return count;
+}
+
+size_t sortedarray_union(void** a, size_t na, void** b, size_t nb,
+						 sortedarray_compare compare, struct arraylist* out)
+{
+	size_t count = 0, i = 0, j = 0;
+	while (i < na && j < nb) {
+		int cmp = compare(a[i], b[j]);
+		arraylist_add(out, (cmp <= 0) ? a[i] : b[j]);
+		count++;
+		i += (cmp <= 0);
+		j += (cmp >= 0);
+	}
+
+	for (; i < na; i++, count++)
+		arraylist_add(out, a[i]);
+	for (; j < nb; j++, count++)
+		arraylist_add(out, b[j]);
+
+	return count;
+}
+
+size_t sortedarray_difference(void** a, size_t na, void** b, size_t nb,
+							  sortedarray_compare compare, struct arraylist* out)
+{
+	size_t count = 0, i = 0, j = 0;
+	int gallop = (na * SORTEDARRAY_GALLOP_RATIO < nb);
+	for (; i < na; i++) {
+		int found = 0;
+		if (gallop) {
+			j = sortedarray_gallop(b, nb, j, a[i], compare);
+			found = (j < nb && compare(b[j], a[i]) == 0);
+		}
+		else {
+			int cmp = 1;
+			while (j < nb && (cmp = compare(b[j], a[i])) < 0)
+				j++;
+
+			found = (j < nb && cmp == 0);
+		}
+
+		if (!found) {
+			arraylist_add(out, a[i]);
+			count++;
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * sortedarray.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for sorted array algorithms: galloping search and set
+ *  			 operations (intersection, union, difference).
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Arrays are sets: elements in strictly ascending order (no duplicates). Results are
+ *  sorted sets too, written in a caller buffer (int32_t arrays) or appended to an
+ *  arraylist ('void*' arrays with a compare function).
+ *
+ *  Galloping (exponential) search finds the first element not lesser than 'x' from a
+ *  start position: it probes start + 1, start + 3, start + 7... until it passes 'x' and
+ *  then does a binary search in the last window. Finding the next element of a
+ *  sorted sequence of needles costs O(log d), d being the distance to it, instead of
+ *  O(log n).
+ *
+ *  The set operations choose the algorithm by the size of the operands:
+ *
+ *  	- sizes of the same order: linear merge, O(n + m). The int32_t intersection
+ *  	  compares blocks of 4 elements of each array at once with SSE2 (all 16 pairs
+ *  	  with 4 compares and 3 rotations) and skips the block with the lowest maximum;
+ *  	- one array SORTEDARRAY_GALLOP_RATIO times larger than the other: each element of
+ *  	  the small one is galloped in the large one from the last position found,
+ *  	  O(m log(n / m)).
+ *
+ *  Source: J. Bentley, A. Yao, "An almost optimal algorithm for unbounded searching" (1976).
+ *  		 D. Lemire, L. Boytsov, N. Kurz, "SIMD Compression and the Intersection of
+ *  		 Sorted Integers", Software: Practice and Experience (2016).
+ *
+ *******************************************************************************/
+
+#ifndef SORTEDARRAY_H_
+	#define SORTEDARRAY_H_
+
+	#include <stddef.h>
+	#include <stdint.h>
+	#include "arraylist.h"
+
+	#define SORTEDARRAY_GALLOP_RATIO 32		// size ratio to switch from merge to galloping
+
+	// function to compare two elements, returns a negative, zero or positive int
+	typedef int (*sortedarray_compare)(const void* a, const void* b);
+
+	/*
+	 * Gets the index of the first element of sorted 'arr' not lesser than 'x', starting
+	 * at 'start' (elements before it are known to be lesser), in O(log(index - start)).
+	 * Returns n if there is none.
+	 */
+	size_t sortedarray_gallop_i32(const int32_t* arr, size_t n, size_t start, int32_t x);
+	size_t sortedarray_gallop(void** arr, size_t n, size_t start, const void* x,
+							  sortedarray_compare compare);
+
+	/*
+	 * Writes in 'out' the elements of both sets (capacity: min(na, nb)).
+	 * Returns the number of written elements.
+	 */
+	size_t sortedarray_intersect_i32(const int32_t* a, size_t na, const int32_t* b, size_t nb,
+									 int32_t* out);
+
+	/*
+	 * Writes in 'out' the elements of any of the sets (capacity: na + nb).
+	 * Returns the number of written elements.
+	 */
+	size_t sortedarray_union_i32(const int32_t* a, size_t na, const int32_t* b, size_t nb,
+								 int32_t* out);
+
+	/*
+	 * Writes in 'out' the elements of 'a' not in 'b' (capacity: na).
+	 * Returns the number of written elements.
+	 */
+	size_t sortedarray_difference_i32(const int32_t* a, size_t na, const int32_t* b, size_t nb,
+									  int32_t* out);
+
+	/*
+	 * Appends to 'out' the elements of both sets (elements of 'a'), of any of the sets
+	 * (elements of 'a' when in both) or of 'a' not in 'b'. Elements are not copied.
+	 * Returns the number of appended elements.
+	 */
+	size_t sortedarray_intersect(void** a, size_t na, void** b, size_t nb,
+								 sortedarray_compare compare, struct arraylist* out);
+	size_t sortedarray_union(void** a, size_t na, void** b, size_t nb,
+							 sortedarray_compare compare, struct arraylist* out);
+	size_t sortedarray_difference(void** a, size_t na, void** b, size_t nb,
+								  sortedarray_compare compare, struct arraylist* out);
+
+#endif /* SORTEDARRAY_H_ */
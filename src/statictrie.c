@@ -0,0 +1,530 @@
+/*
+ * statictrie.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of an immutable succinct trie (LOUDS encoded).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "statictrie.h"
+#include "trieext.h"
+#include "arraylist.h"
+
+// node of the breadth first build: words [lo, hi) share the first 'depth' chars
+struct statictrie_buildnode {
+	size_t lo;
+	size_t hi;
+	uint32_t depth;
+	uint32_t degree;		// number of children
+	unsigned char label;	// char of edge from parent
+	bool terminal;			// a word ends in node
+};
+
+/*
+ * Rounds a position up to next multiple of STATICTRIE_FILE_ALIGN.
+ */
+uint64_t statictrie_file_align(uint64_t pos) {
+	return (pos + STATICTRIE_FILE_ALIGN - 1) & ~((uint64_t)STATICTRIE_FILE_ALIGN - 1);
+}
+
+/*
+ * Computes the sections layout of an image for a given number of nodes.
+ */
+void statictrie_layout(struct statictrie_fileheader* h, uint64_t numnodes)
+{
+	memset(h, 0, sizeof(*h));
+	memcpy(h->magic, STATICTRIE_FILE_MAGIC, sizeof(h->magic));
+	h->version = STATICTRIE_FILE_VERSION;
+	h->byteorder = STATICTRIE_FILE_BYTEORDER;
+	h->numnodes = numnodes;
+	h->numsamples = (numnodes + STATICTRIE_SELECT_SAMPLE - 1) / STATICTRIE_SELECT_SAMPLE;
+	h->loudspos = statictrie_file_align(sizeof(*h));
+	h->terminalpos = h->loudspos + ((2 * numnodes + 62) / 64) * sizeof(uint64_t);
+	h->selectpos = h->terminalpos + ((numnodes + 63) / 64) * sizeof(uint64_t);
+	h->labelspos = h->selectpos + h->numsamples * sizeof(uint32_t);
+	h->filesize = statictrie_file_align(h->labelspos + numnodes);
+}
+
+/*
+ * Points the trie arrays into a valid image.
+ */
+void statictrie_bind(struct statictrie* st, void* image, size_t size)
+{
+	const struct statictrie_fileheader* h = (const struct statictrie_fileheader*)image;
+	char* base = (char*)image;
+	st->numnodes = h->numnodes;
+	st->numwords = h->numwords;
+	st->louds = (const uint64_t*)(base + h->loudspos);
+	st->terminal = (const uint64_t*)(base + h->terminalpos);
+	st->select = (const uint32_t*)(base + h->selectpos);
+	st->labels = (const unsigned char*)(base + h->labelspos);
+	st->image = image;
+	st->imagesize = size;
+}
+
+/*
+ * Allocates a static trie structure.
+ */
+struct statictrie* statictrie_alloc()
+{
+	struct statictrie* result = (struct statictrie*)malloc(sizeof(*result));
+	if (!result) {
+		printf("Memory error: failed to allocate memory for statictrie structure!");
+		abort();
+	}
+
+	return result;
+}
+
+/*
+ * Builds a static trie from an array of 'n' words sorted in ascending order (strcmp).
+ * Duplicated words are stored once and empty words are ignored, 'words' is not changed.
+ * Returns the new static trie.
+ * Note: words not sorted is an error, program is aborted.
+ */
+struct statictrie* statictrie_create_from_sorted(char** words, size_t n)
+{
+	for (size_t i = 1; i < n; i++)
+		if (strcmp(words[i - 1], words[i]) > 0) {
+			printf("Error: static trie words must be sorted ('%s' > '%s')!", words[i - 1], words[i]);
+			abort();
+		}
+
+	size_t lo = 0;
+	while (lo < n && words[lo][0] == 0)
+		lo++;	// skip empty words
+
+	// breadth first: nodes array is also the queue
+	size_t capacity = 1024;
+	size_t count = 1;
+	struct statictrie_buildnode* nodes = (struct statictrie_buildnode*)malloc(capacity * sizeof(*nodes));
+	if (!nodes) {
+		printf("Memory error: failed to allocate memory for statictrie build!");
+		abort();
+	}
+
+	nodes[0] = (struct statictrie_buildnode){ lo, n, 0, 0, 0, false };
+	size_t numwords = 0;
+
+	for (size_t k = 0; k < count; k++) {
+		size_t i = nodes[k].lo;
+		size_t hi = nodes[k].hi;
+		uint32_t d = nodes[k].depth;
+
+		// words equal to node prefix are first (sorted)
+		if (k > 0 && i < hi && (unsigned char)words[i][d] == 0) {
+			nodes[k].terminal = true;
+			numwords++;
+			while (i < hi && (unsigned char)words[i][d] == 0)
+				i++;
+		}
+
+		// one child per distinct next char
+		while (i < hi) {
+			unsigned char c = (unsigned char)words[i][d];
+			size_t j = i + 1;
+			while (j < hi && (unsigned char)words[j][d] == c)
+				j++;
+
+			if (count == capacity) {
+				capacity *= 2;
+				nodes = (struct statictrie_buildnode*)realloc(nodes, capacity * sizeof(*nodes));
+				if (!nodes) {
+					printf("Memory error: failed to allocate memory for statictrie build!");
+					abort();
+				}
+			}
+
+			nodes[count++] = (struct statictrie_buildnode){ i, j, d + 1, 0, c, false };
+			nodes[k].degree++;
+			i = j;
+		}
+	}
+
+	if (count > UINT32_MAX / 2) {
+		printf("Error: static trie has too many nodes (%zu)!", count);
+		abort();
+	}
+
+	// write image
+	struct statictrie_fileheader h;
+	statictrie_layout(&h, count);
+	h.numwords = numwords;
+
+	char* image = (char*)calloc(1, h.filesize);
+	if (!image) {
+		printf("Memory error: failed to allocate memory for statictrie image!");
+		abort();
+	}
+
+	memcpy(image, &h, sizeof(h));
+	uint64_t* louds = (uint64_t*)(image + h.loudspos);
+	uint64_t* terminal = (uint64_t*)(image + h.terminalpos);
+	uint32_t* select = (uint32_t*)(image + h.selectpos);
+	unsigned char* labels = (unsigned char*)(image + h.labelspos);
+
+	uint64_t pos = 0;
+	for (size_t k = 0; k < count; k++) {
+		for (uint32_t c = 0; c < nodes[k].degree; c++, pos++)
+			louds[pos >> 6] |= 1ULL << (pos & 63);
+
+		if (k % STATICTRIE_SELECT_SAMPLE == 0)
+			select[k / STATICTRIE_SELECT_SAMPLE] = (uint32_t)pos;
+
+		pos++;	// '0' ending node 'k'
+
+		if (nodes[k].terminal)
+			terminal[k >> 6] |= 1ULL << (k & 63);
+
+		labels[k] = nodes[k].label;
+	}
+
+	free(nodes);
+
+	struct statictrie* result = statictrie_alloc();
+	statictrie_bind(result, image, h.filesize);
+	result->mapped = 0;
+	return result;
+}
+
+/*
+ * Compares two strings (qsort callback).
+ */
+int statictrie_compare_words(const void* a, const void* b) {
+	return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+/*
+ * Builds a static trie with the words of a trie. The trie is not changed.
+ * Returns the new static trie.
+ */
+struct statictrie* statictrie_create_from_trie(struct trie* t)
+{
+	struct arraylist* words = trieext_getwords(t, "");
+	if (words == NULL)
+		return statictrie_create_from_sorted(NULL, 0);
+
+	// trie order follows its index function, sort to byte order
+	qsort(words->buffer, words->length, sizeof(void*), statictrie_compare_words);
+	struct statictrie* result = statictrie_create_from_sorted((char**)words->buffer, words->length);
+
+	for (unsigned int i = 0; i < words->length; i++)
+		free(words->buffer[i]);
+
+	arraylist_destroy(words);
+	return result;
+}
+
+/*
+ * Gets the position of the k-th '0' (k from 0) of the LOUDS bit vector.
+ */
+uint64_t statictrie_select0(const struct statictrie* st, uint64_t k)
+{
+	uint64_t pos = st->select[k / STATICTRIE_SELECT_SAMPLE];
+	uint64_t r = k % STATICTRIE_SELECT_SAMPLE;	// zeros to skip after sampled one
+	if (r == 0)
+		return pos;
+
+	pos++;
+	uint64_t w = pos >> 6;
+	uint64_t zeros = ~st->louds[w] & (~0ULL << (pos & 63));
+	for (;;) {
+		uint64_t c = __builtin_popcountll(zeros);
+		if (c >= r)
+			break;
+
+		r -= c;
+		zeros = ~st->louds[++w];
+	}
+
+	while (--r > 0)
+		zeros &= zeros - 1;		// clear lowest zeros
+
+	return (w << 6) + __builtin_ctzll(zeros);
+}
+
+/*
+ * Gets first child and number of children of a node.
+ */
+void statictrie_children(const struct statictrie* st, uint64_t node, uint64_t* first,
+						 uint64_t* degree)
+{
+	uint64_t start = (node == 0) ? 0 : statictrie_select0(st, node - 1) + 1;
+	uint64_t end = statictrie_select0(st, node);
+	*degree = end - start;
+	*first = start - node + 1;	// ones before node bits, plus root
+}
+
+/*
+ * Gets the child of a node by the char of its edge (binary search over labels).
+ * Returns child node or -1 if not found.
+ */
+int64_t statictrie_child(const struct statictrie* st, uint64_t node, unsigned char c)
+{
+	uint64_t first, degree;
+	statictrie_children(st, node, &first, &degree);
+
+	int64_t lo = (int64_t)first;
+	int64_t hi = (int64_t)(first + degree) - 1;
+	while (lo <= hi) {
+		int64_t mid = (lo + hi) >> 1;
+		if (st->labels[mid] == c)
+			return mid;
+		else if (st->labels[mid] < c)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+
+	return -1;
+}
+
+/*
+ * Checks if a word ends in a node.
+ */
+bool statictrie_isterminal(const struct statictrie* st, uint64_t node) {
+	return (st->terminal[node >> 6] >> (node & 63)) & 1;
+}
+
+/*
+ * Searches for a word in the trie.
+ * Return 'true' if succeeded,'false' otherwise.
+ */
+bool statictrie_search(const struct statictrie* st, char* signedtext)
+{
+	unsigned char* text = (unsigned char*)signedtext;
+	int64_t node = 0;
+	for (size_t i = 0; text[i] != 0; i++) {
+		node = statictrie_child(st, node, text[i]);
+		if (node < 0)
+			return false;
+	}
+
+	return statictrie_isterminal(st, node);
+}
+
+/*
+ * Helper recursive function to collect words under a node ('buffer' holds the chars
+ * of the path until the node, of length 'length').
+ */
+void statictrie_getwords_rec( const struct statictrie* st, uint64_t node, char** buffer,
+							  size_t* capacity, size_t length, struct arraylist* a )
+{
+	if (statictrie_isterminal(st, node)) {
+		char* word = (char*)malloc(length + 1);
+		if (!word) {
+			printf("Memory error: failed to allocate memory for statictrie word!");
+			abort();
+		}
+
+		memcpy(word, *buffer, length);
+		word[length] = 0;
+		arraylist_add(a, word);
+	}
+
+	uint64_t first, degree;
+	statictrie_children(st, node, &first, &degree);
+	if (degree == 0)
+		return;
+
+	if (length + 1 >= *capacity) {
+		*capacity *= 2;
+		*buffer = (char*)realloc(*buffer, *capacity);
+		if (!*buffer) {
+			printf("Memory error: failed to allocate memory for statictrie word buffer!");
+			abort();
+		}
+	}
+
+	for (uint64_t c = first; c < first + degree; c++) {
+		(*buffer)[length] = (char)st->labels[c];
+		statictrie_getwords_rec(st, c, buffer, capacity, length + 1, a);
+	}
+}
+
+/*
+ * Gets a list of words that shares a given prefix (in ascending order).
+ * Returns an arraylist with founded words, 'NULL' if no word found.
+ * Note: words are new allocated strings, to be released by the caller.
+ */
+struct arraylist* statictrie_getwords(const struct statictrie* st, char* prefix)
+{
+	unsigned char* text = (unsigned char*)prefix;
+	size_t len = strlen(prefix);
+	int64_t node = 0;
+	for (size_t i = 0; i < len; i++) {
+		node = statictrie_child(st, node, text[i]);
+		if (node < 0)
+			return NULL;
+	}
+
+	if (st->numwords == 0)
+		return NULL;	// only root
+
+	size_t capacity = len + 64;
+	char* buffer = (char*)malloc(capacity);
+	if (!buffer) {
+		printf("Memory error: failed to allocate memory for statictrie word buffer!");
+		abort();
+	}
+
+	memcpy(buffer, prefix, len);
+	struct arraylist* result = arraylist_create_capacity(20);
+	statictrie_getwords_rec(st, node, &buffer, &capacity, len, result);
+	free(buffer);
+	return result;
+}
+
+/*
+ * Gets the number of words in the trie.
+ */
+size_t statictrie_getsize(const struct statictrie* st) {
+	return st->numwords;
+}
+
+/*
+ * Gets the number of bytes used by the trie (image and trie structure).
+ */
+size_t statictrie_memsize(const struct statictrie* st) {
+	return sizeof(*st) + st->imagesize;
+}
+
+/*
+ * Prints words of trie in ascending order.
+ */
+void statictrie_print(const struct statictrie* st)
+{
+	struct arraylist* words = statictrie_getwords(st, "");
+	if (words == NULL) {
+		printf("TRIE EMPTY!");
+		return;
+	}
+
+	for (unsigned int i = 0; i < words->length; ++i) {
+		char* word = (char*)arraylist_get_item_at(words, i);
+		printf("Word: '%s'\n", word);
+		free(word);
+	}
+
+	arraylist_destroy(words);
+}
+
+/*
+ * Saves the trie image to a binary file that can be mapped back with 'statictrie_map'.
+ * Returns 1 if succeeded, 0 otherwise.
+ */
+int statictrie_save(const struct statictrie* st, const char* path)
+{
+	FILE* f = fopen(path, "wb");
+	if (f == NULL)
+		return 0;
+
+	int result = fwrite(st->image, 1, st->imagesize, f) == st->imagesize;
+	if (fclose(f) != 0)
+		result = 0;
+
+	return result;
+}
+
+/*
+ * Checks the header of an image of a given size.
+ */
+int statictrie_image_ok(const void* buffer, size_t size)
+{
+	if (buffer == NULL || size < sizeof(struct statictrie_fileheader)
+		|| ((uintptr_t)buffer % STATICTRIE_FILE_ALIGN) != 0)
+		return 0;
+
+	const struct statictrie_fileheader* h = (const struct statictrie_fileheader*)buffer;
+	if (memcmp(h->magic, STATICTRIE_FILE_MAGIC, sizeof(h->magic)) != 0
+		|| h->version != STATICTRIE_FILE_VERSION
+		|| h->byteorder != STATICTRIE_FILE_BYTEORDER
+		|| h->numnodes == 0 || h->numnodes > UINT32_MAX / 2
+		|| h->numwords >= h->numnodes)
+		return 0;
+
+	// layout is fully defined by the number of nodes
+	struct statictrie_fileheader expected;
+	statictrie_layout(&expected, h->numnodes);
+	return h->numsamples == expected.numsamples
+		&& h->loudspos == expected.loudspos
+		&& h->terminalpos == expected.terminalpos
+		&& h->selectpos == expected.selectpos
+		&& h->labelspos == expected.labelspos
+		&& h->filesize == expected.filesize
+		&& h->filesize <= size;
+}
+
+/*
+ * Maps a trie file saved with 'statictrie_save' into memory. Arrays point directly into
+ * the read only mapping, pages are loaded on first access.
+ * Returns the mapped trie or NULL if file can not be mapped or is not a valid trie file.
+ * Note: 'statictrie_destroy' unmaps the file.
+ */
+struct statictrie* statictrie_map(const char* path)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+
+	struct stat s;
+	if (fstat(fd, &s) != 0 || (size_t)s.st_size < sizeof(struct statictrie_fileheader)) {
+		close(fd);
+		return NULL;
+	}
+
+	void* mapping = mmap(NULL, s.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);	// mapping keeps the file open
+	if (mapping == MAP_FAILED)
+		return NULL;
+
+	if (!statictrie_image_ok(mapping, s.st_size)) {
+		munmap(mapping, s.st_size);
+		return NULL;
+	}
+
+	struct statictrie* result = statictrie_alloc();
+	statictrie_bind(result, mapping, s.st_size);
+	result->mapped = 1;
+	return result;
+}
+
+/*
+ * Opens a trie image already in memory (ex: 'st->image' of another trie or a buffer
+ * read from a file), aligned to 8 bytes. Arrays point into the buffer (no copy),
+ * that must not be released or changed while the trie is used.
+ * Returns the trie or NULL if buffer is not a valid trie image.
+ */
+struct statictrie* statictrie_open(const void* buffer, size_t size)
+{
+	if (!statictrie_image_ok(buffer, size))
+		return NULL;
+
+	struct statictrie* result = statictrie_alloc();
+	statictrie_bind(result, (void*)buffer, size);
+	result->mapped = -1;
+	return result;
+}
+
+/*
+ * Releases trie from memory (or unmaps a mapped trie). Buffers given to
+ * 'statictrie_open' are not released.
+ */
+void statictrie_destroy(struct statictrie* st)
+{
+	if (st->mapped == 1)
+		munmap(st->image, st->imagesize);
+	else if (st->mapped == 0)
+		free(st->image);
+
+	free(st);
+}
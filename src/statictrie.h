@@ -0,0 +1,158 @@
+/*****************************************************************************
+ * statictrie.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for an immutable succinct trie (LOUDS encoded) of strings.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A dictionary that is built once and then only read does not need nodes and pointers.
+ *  The static trie is built from a sorted list of words (or from the words of a
+ *  'struct trie') and keeps the shape of the trie in a LOUDS bit vector (Level Order
+ *  Unary Degree Sequence):
+ *
+ *  	- nodes are numbered in breadth first order (root is node 0);
+ *  	- for each node, in that order, the bit vector has one '1' per child followed by
+ *  	  a '0', so node 'k' ends at the k-th '0' and its children are the consecutive
+ *  	  nodes starting at (ones before node 'k' bits) + 1;
+ *  	- 'labels' keeps the char of the edge from its parent for every node (children of
+ *  	  a node are consecutive and sorted, found by binary search) and 'terminal' has
+ *  	  one bit per node set if a word ends there.
+ *
+ *  	  "a", "an", "at", "be"		nodes: 0:root 1:'a'* 2:'b' 3:'n'* 4:'t'* 5:'e'*
+ *  	  louds: 110 110 10 0 0 0
+ *
+ *  Node 'k' starts after the (k-1)-th '0', so navigation only needs 'select0' (position
+ *  of the k-th '0'): the position of every 64th '0' is sampled and the rest is found by
+ *  counting zeros (popcount) in the following words of the bit vector.
+ *
+ *  Memory is about 10 bits per node (2 bits of LOUDS, 1 terminal bit, 8 bits of label
+ *  and the select samples), against a pointer per char in the trie of trie.h.
+ *
+ *  The trie is a single flat image (header followed by the arrays, positions aligned
+ *  to 8 bytes). 'statictrie_save' writes that image to a file, 'statictrie_map' maps it
+ *  back (no parsing, no copy) and 'statictrie_open' reads an image already in memory.
+ *  Images are only readable on machines with the same byte order.
+ *
+ *  Source: G. Jacobson, "Space-efficient static trees and graphs", FOCS (1989).
+ *  		 https://en.wikipedia.org/wiki/Succinct_data_structure
+ *
+ *******************************************************************************/
+
+#ifndef STATICTRIE_H_
+	#define STATICTRIE_H_
+
+	#include <stdlib.h>
+	#include <stdint.h>
+	#include <stdbool.h>
+	#include "arraylist.h"
+	#include "trie.h"
+
+	#define STATICTRIE_FILE_MAGIC "STATTRIE"		// first 8 bytes of a trie image
+	#define STATICTRIE_FILE_VERSION 1
+	#define STATICTRIE_FILE_BYTEORDER 0x01020304	// detects images written with other byte order
+	#define STATICTRIE_FILE_ALIGN 8					// alignment of image sections
+	#define STATICTRIE_SELECT_SAMPLE 64				// a position sampled every 64 zeros
+
+	// static trie struct (arrays point into the image)
+	struct statictrie {
+		size_t numnodes;				// number of nodes (root included)
+		size_t numwords;				// number of words
+		const uint64_t* louds;			// LOUDS bit vector (2 * numnodes - 1 bits)
+		const uint64_t* terminal;		// one bit per node, set if a word ends in node
+		const uint32_t* select;			// position of every STATICTRIE_SELECT_SAMPLE-th '0'
+		const unsigned char* labels;	// char of the edge from parent of each node
+		void* image;					// trie image (header and arrays)
+		size_t imagesize;				// size of image
+		int mapped;						// 1: image mapped from file, 0: allocated, -1: not owned
+	};
+
+	// header of a trie image, followed by the sections it points to
+	struct statictrie_fileheader {
+		char magic[8];					// STATICTRIE_FILE_MAGIC
+		uint32_t version;				// STATICTRIE_FILE_VERSION
+		uint32_t byteorder;				// STATICTRIE_FILE_BYTEORDER
+		uint64_t numnodes;
+		uint64_t numwords;
+		uint64_t numsamples;
+		uint64_t loudspos;				// uint64_t[(2 * numnodes + 62) / 64]
+		uint64_t terminalpos;			// uint64_t[(numnodes + 63) / 64]
+		uint64_t selectpos;				// uint32_t[numsamples]
+		uint64_t labelspos;				// unsigned char[numnodes]
+		uint64_t filesize;				// total image size
+	};
+
+	/*
+	 * Builds a static trie from an array of 'n' words sorted in ascending order (strcmp).
+	 * Duplicated words are stored once and empty words are ignored, 'words' is not changed.
+	 * Returns the new static trie.
+	 * Note: words not sorted is an error, program is aborted.
+	 */
+	struct statictrie* statictrie_create_from_sorted(char** words, size_t n);
+
+	/*
+	 * Builds a static trie with the words of a trie. The trie is not changed.
+	 * Returns the new static trie.
+	 */
+	struct statictrie* statictrie_create_from_trie(struct trie* t);
+
+	/*
+	 * Searches for a word in the trie.
+	 * Return 'true' if succeeded,'false' otherwise.
+	 */
+	bool statictrie_search(const struct statictrie* st, char* signedtext);
+
+	/*
+	 * Gets a list of words that shares a given prefix (in ascending order).
+	 * Returns an arraylist with founded words, 'NULL' if no word found.
+	 * Note: words are new allocated strings, to be released by the caller.
+	 */
+	struct arraylist* statictrie_getwords(const struct statictrie* st, char* prefix);
+
+	/*
+	 * Gets the number of words in the trie.
+	 */
+	size_t statictrie_getsize(const struct statictrie* st);
+
+	/*
+	 * Gets the number of bytes used by the trie (image and trie structure).
+	 */
+	size_t statictrie_memsize(const struct statictrie* st);
+
+	/*
+	 * Prints words of trie in ascending order.
+	 */
+	void statictrie_print(const struct statictrie* st);
+
+	/*
+	 * Saves the trie image to a binary file that can be mapped back with 'statictrie_map'.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 */
+	int statictrie_save(const struct statictrie* st, const char* path);
+
+	/*
+	 * Maps a trie file saved with 'statictrie_save' into memory. Arrays point directly into
+	 * the read only mapping, pages are loaded on first access.
+	 * Returns the mapped trie or NULL if file can not be mapped or is not a valid trie file.
+	 * Note: 'statictrie_destroy' unmaps the file.
+	 */
+	struct statictrie* statictrie_map(const char* path);
+
+	/*
+	 * Opens a trie image already in memory (ex: 'st->image' of another trie or a buffer
+	 * read from a file), aligned to 8 bytes. Arrays point into the buffer (no copy),
+	 * that must not be released or changed while the trie is used.
+	 * Returns the trie or NULL if buffer is not a valid trie image.
+	 */
+	struct statictrie* statictrie_open(const void* buffer, size_t size);
+
+	/*
+	 * Releases trie from memory (or unmaps a mapped trie). Buffers given to
+	 * 'statictrie_open' are not released.
+	 */
+	void statictrie_destroy(struct statictrie* st);
+
+#endif /* STATICTRIE_H_ */
@@ -0,0 +1,342 @@
+/*
+ * strintern.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: String interning pool (arena of strings and open addressing index).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "strintern.h"
+
+/*
+ * Hash of 'length' characters (FNV-1a, 64 bit).
+ * Note: Private function.
+ * */
+uint64_t strintern_hash(const char* s, size_t length)
+{
+	uint64_t h = 0xCBF29CE484222325ULL;
+	for (size_t i = 0; i < length; i++) {
+		h ^= (unsigned char)s[i];
+		h *= 0x100000001B3ULL;
+	}
+
+	return h;
+}
+
+/*
+ * Creates a new empty pool for about 'capacity' strings (grows as needed).
+ * If 'capacity' is 0 the default capacity is used.
+ * Returns the new pool if succeeded, NULL otherwise.
+ * */
+struct strintern* strintern_create(size_t capacity)
+{
+	if (capacity == 0)
+		capacity = STRINTERN_DEFAULT_CAPACITY;
+
+	struct strintern* pool = (struct strintern*)malloc(sizeof(struct strintern));
+	if (pool == NULL) {
+		printf("Memory error: failed to allocate memory for string pool!\n");
+		return NULL;
+	}
+
+	pool->nslots = 16;
+	while (pool->nslots < 2 * capacity)
+		pool->nslots <<= 1;
+
+	pool->slots = (uint32_t*)calloc(pool->nslots, sizeof(uint32_t));
+	pool->strings = (const char**)malloc(capacity * sizeof(const char*));
+	pool->hashes = (uint64_t*)malloc(capacity * sizeof(uint64_t));
+	if ((pool->slots == NULL) || (pool->strings == NULL) || (pool->hashes == NULL)) {
+		printf("Memory error: failed to allocate memory for string pool index!\n");
+		free(pool->slots);
+		free(pool->strings);
+		free(pool->hashes);
+		free(pool);
+		return NULL;
+	}
+
+	pool->count = 0;
+	pool->capacity = capacity;
+	pool->blocks = NULL;
+	pool->bytes = 0;
+	return pool;
+}
+
+/*
+ * Finds the slot of a string: the slot holding its id, or the empty slot where it
+ * would be added.
+ * Note: Private function.
+ * */
+size_t strintern_findslot( const struct strintern* pool, const char* s, size_t length,
+						   uint64_t hash )
+{
+	size_t mask = pool->nslots - 1;
+	size_t i = (size_t)(hash ^ (hash >> 32)) & mask;
+	for (;;) {
+		uint32_t slot = pool->slots[i];
+		if (slot == 0)
+			return i;
+
+		uint32_t id = slot - 1;
+		const char* other = pool->strings[id];
+		if ( (pool->hashes[id] == hash) && (strintern_lengthof(other) == length)
+			 && (memcmp(other, s, length) == 0) )
+			return i;
+
+		i = (i + 1) & mask;
+	}
+}
+
+/*
+ * Doubles the index and the id arrays.
+ * Returns 1 (true) if succeeded, 0 (false) otherwise.
+ * Note: Private function.
+ * */
+int strintern_grow(struct strintern* pool)
+{
+	size_t capacity = pool->capacity * 2;
+	const char** strings = (const char**)realloc(pool->strings, capacity * sizeof(const char*));
+	if (strings == NULL)
+		return 0;
+
+	pool->strings = strings;
+	uint64_t* hashes = (uint64_t*)realloc(pool->hashes, capacity * sizeof(uint64_t));
+	if (hashes == NULL)
+		return 0;
+
+	pool->hashes = hashes;
+	pool->capacity = capacity;
+
+	size_t nslots = pool->nslots;
+	while (nslots < 2 * capacity)
+		nslots <<= 1;
+
+	if (nslots == pool->nslots)
+		return 1;
+
+	// re-insert ids with their memoized hashes (no string is read)
+	uint32_t* slots = (uint32_t*)calloc(nslots, sizeof(uint32_t));
+	if (slots == NULL)
+		return 0;
+
+	for (size_t id = 0; id < pool->count; id++) {
+		uint64_t hash = pool->hashes[id];
+		size_t i = (size_t)(hash ^ (hash >> 32)) & (nslots - 1);
+		while (slots[i] != 0)
+			i = (i + 1) & (nslots - 1);
+
+		slots[i] = (uint32_t)(id + 1);
+	}
+
+	free(pool->slots);
+	pool->slots = slots;
+	pool->nslots = nslots;
+	return 1;
+}
+
+/*
+ * Takes 'size' bytes (multiple of 8) from the arena. Strings larger than a quarter
+ * of a block get a block of their own, so the current block keeps being filled.
+ * Returns NULL if out of memory.
+ * Note: Private function.
+ * */
+char* strintern_arena_alloc(struct strintern* pool, size_t size)
+{
+	struct strintern_block* block = pool->blocks;
+	if ((block != NULL) && (block->used + size <= block->capacity)) {
+		char* p = block->data + block->used;
+		block->used += size;
+		return p;
+	}
+
+	// blocks double from STRINTERN_FIRST_BLOCK_SIZE up to STRINTERN_BLOCK_SIZE
+	size_t capacity = STRINTERN_FIRST_BLOCK_SIZE;
+	if (block != NULL)
+		capacity = (2 * block->capacity < STRINTERN_BLOCK_SIZE) ? 2 * block->capacity : STRINTERN_BLOCK_SIZE;
+
+	if (size > STRINTERN_BLOCK_SIZE / 4)
+		capacity = size;
+
+	struct strintern_block* newblock = (struct strintern_block*)malloc( sizeof(struct strintern_block)
+																		+ capacity );
+	if (newblock == NULL) {
+		printf("Memory error: failed to allocate memory for string pool block!\n");
+		return NULL;
+	}
+
+	newblock->capacity = capacity;
+	newblock->used = size;
+	if ((block != NULL) && (size > STRINTERN_BLOCK_SIZE / 4)) {
+		// dedicated block: keep the current one first
+		newblock->next = block->next;
+		block->next = newblock;
+	}
+	else {
+		newblock->next = block;
+		pool->blocks = newblock;
+	}
+
+	return newblock->data;
+}
+
+/*
+ * Interns the first 'length' characters of 's' (need not be zero terminated).
+ * Returns NULL if out of memory.
+ * */
+const char* strintern_intern_len(struct strintern* pool, const char* s, size_t length)
+{
+	uint64_t hash = strintern_hash(s, length);
+	size_t i = strintern_findslot(pool, s, length, hash);
+	if (pool->slots[i] != 0)
+		return pool->strings[pool->slots[i] - 1];
+
+	if ((length > UINT32_MAX) || (pool->count >= STRINTERN_NOID - 1))
+		return NULL;
+
+	if (pool->count == pool->capacity) {
+		if (!strintern_grow(pool)) {
+			printf("Memory error: failed to grow string pool index!\n");
+			return NULL;
+		}
+
+		i = strintern_findslot(pool, s, length, hash);
+	}
+
+	// header, characters and terminator, 8 byte aligned
+	size_t size = (sizeof(struct strintern_header) + length + 1 + 7) & ~(size_t)7;
+	char* p = strintern_arena_alloc(pool, size);
+	if (p == NULL)
+		return NULL;
+
+	struct strintern_header* header = (struct strintern_header*)p;
+	header->id = (uint32_t)pool->count;
+	header->length = (uint32_t)length;
+	char* canonical = (char*)(header + 1);
+	memcpy(canonical, s, length);
+	canonical[length] = '\0';
+
+	pool->strings[pool->count] = canonical;
+	pool->hashes[pool->count] = hash;
+	pool->slots[i] = (uint32_t)(++pool->count);
+	pool->bytes += length + 1;
+	return canonical;
+}
+
+/*
+ * Interns a string: returns the canonical copy of 's', adding it if needed.
+ * Returns NULL if out of memory.
+ * */
+const char* strintern_intern(struct strintern* pool, const char* s)
+{
+	return strintern_intern_len(pool, s, strlen(s));
+}
+
+/*
+ * Interns a string and returns its id.
+ * Returns STRINTERN_NOID if out of memory.
+ * */
+uint32_t strintern_id(struct strintern* pool, const char* s)
+{
+	const char* canonical = strintern_intern(pool, s);
+	return (canonical != NULL) ? strintern_idof(canonical) : STRINTERN_NOID;
+}
+
+/*
+ * Gets the canonical copy of a string without adding it.
+ * Returns NULL if 's' is not in the pool.
+ * */
+const char* strintern_lookup(const struct strintern* pool, const char* s)
+{
+	size_t length = strlen(s);
+	size_t i = strintern_findslot(pool, s, length, strintern_hash(s, length));
+	return (pool->slots[i] != 0) ? pool->strings[pool->slots[i] - 1] : NULL;
+}
+
+/*
+ * Gets the canonical string of an id.
+ * Returns NULL if id is not valid.
+ * */
+const char* strintern_get(const struct strintern* pool, uint32_t id)
+{
+	return (id < pool->count) ? pool->strings[id] : NULL;
+}
+
+/*
+ * Gets the number of distinct strings.
+ * */
+size_t strintern_getcount(const struct strintern* pool)
+{
+	return pool->count;
+}
+
+/*
+ * Gets the memory used by the pool in bytes (strings, headers and index).
+ * */
+size_t strintern_sizeinbytes(const struct strintern* pool)
+{
+	size_t result = sizeof(struct strintern) + pool->nslots * sizeof(uint32_t)
+					+ pool->capacity * (sizeof(const char*) + sizeof(uint64_t));
+
+	for (struct strintern_block* block = pool->blocks; block != NULL; block = block->next)
+		result += sizeof(struct strintern_block) + block->capacity;
+
+	return result;
+}
+
+/*
+ * Container callbacks for canonical strings.
+ * */
+int strintern_isequal(const void* key1, const void* key2)
+{
+	return key1 == key2;
+}
+
+int strintern_hashfunc(const void* key)
+{
+	return (int)strintern_idof((const char*)key);
+}
+
+uint64_t strintern_hashfunc64(const void* key)
+{
+	// ids are dense, spread them over 64 bits (murmur3 finalizer)
+	uint64_t h = strintern_idof((const char*)key);
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+int strintern_compare(const void* data1, const void* data2)
+{
+	return (data1 == data2) ? 0 : strcmp((const char*)data1, (const char*)data2);
+}
+
+int strintern_compare_id(const void* data1, const void* data2)
+{
+	uint32_t a = strintern_idof((const char*)data1);
+	uint32_t b = strintern_idof((const char*)data2);
+	return (a > b) - (a < b);
+}
+
+/*
+ * Releases the pool and all its strings from memory.
+ * */
+void strintern_destroy(struct strintern* pool)
+{
+	struct strintern_block* block = pool->blocks;
+	while (block != NULL) {
+		struct strintern_block* next = block->next;
+		free(block);
+		block = next;
+	}
+
+	free(pool->slots);
+	free(pool->strings);
+	free(pool->hashes);
+	free(pool);
+}
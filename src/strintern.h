@@ -0,0 +1,155 @@
+/*****************************************************************************
+ * strintern.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a string interning pool: keeps one canonical copy of
+ *  			 each distinct string and gives it a stable id.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Hash tables, sets and trees keyed by strings keep one copy of a string per
+ *  container (often per element) and compare them with strcmp on every probe. With
+ *  the pool every distinct string is stored once and all containers hold the same
+ *  canonical pointer, so:
+ *
+ *  	- equal strings have equal pointers: equality is a pointer compare
+ *  	  (strintern_isequal, for hashtable_isequal);
+ *  	- each string has a dense id (0, 1, 2, ... in interning order), stored right
+ *  	  before its characters, so strintern_idof and strintern_lengthof are O(1) and
+ *  	  need no lookup. Hash tables hash the id (strintern_hashfunc) and ordered sets
+ *  	  can order by id (strintern_compare_id) or alphabetically with a pointer check
+ *  	  first (strintern_compare);
+ *  	- ids index plain arrays (ex: per string counters or a bitset of seen strings).
+ *
+ *  Strings are bump allocated in blocks doubling from 1 KB to 64 KB (an 8 byte
+ *  header, the characters and the terminating zero, no malloc overhead per string);
+ *  canonical pointers stay valid until the pool is destroyed. The index is an open addressing table of 32 bit ids
+ *  (linear probing, load factor up to 1/2): a probe compares the memoized 64 bit hash
+ *  of the string before its length and characters, so strcmp runs about once per
+ *  interned string.
+ *
+ *  Strings are never removed (the pool grows until destroyed). Not thread safe.
+ *
+ *  Source: https://en.wikipedia.org/wiki/String_interning
+ *  		 https://en.wikipedia.org/wiki/Hash_consing
+ *
+ *******************************************************************************/
+
+#ifndef STRINTERN_H_
+	#define STRINTERN_H_
+
+	#include <stddef.h>
+	#include <stdint.h>
+
+	#define STRINTERN_FIRST_BLOCK_SIZE 1024		// bytes of the first arena block
+	#define STRINTERN_BLOCK_SIZE 65536			// maximum bytes of an arena block
+	#define STRINTERN_DEFAULT_CAPACITY 1024		// initial number of strings
+	#define STRINTERN_NOID UINT32_MAX			// id of a string not in the pool
+
+	// header stored right before the characters of an interned string
+	struct strintern_header {
+		uint32_t id;
+		uint32_t length;
+	};
+
+	// arena block of strings
+	struct strintern_block {
+		struct strintern_block* next;
+		size_t used;							// bytes taken
+		size_t capacity;						// bytes of 'data'
+		char data[];
+	};
+
+	// string interning pool type
+	struct strintern {
+		uint32_t* slots;						// index: id + 1 per slot, 0 is empty
+		size_t nslots;							// power of two
+		const char** strings;					// canonical string of each id
+		uint64_t* hashes;						// hash of each id
+		size_t count;							// number of strings
+		size_t capacity;						// capacity of 'strings' and 'hashes'
+		struct strintern_block* blocks;			// current block first
+		size_t bytes;							// characters stored, terminators included
+	};
+
+	/*
+	 * Creates a new empty pool for about 'capacity' strings (grows as needed).
+	 * If 'capacity' is 0 the default capacity is used.
+	 * Returns the new pool if succeeded, NULL otherwise.
+	 * */
+	struct strintern* strintern_create(size_t capacity);
+
+	/*
+	 * Interns a string: returns the canonical copy of 's', adding it if needed.
+	 * Returns NULL if out of memory.
+	 * */
+	const char* strintern_intern(struct strintern* pool, const char* s);
+
+	/*
+	 * Interns the first 'length' characters of 's' (need not be zero terminated).
+	 * Returns NULL if out of memory.
+	 * */
+	const char* strintern_intern_len(struct strintern* pool, const char* s, size_t length);
+
+	/*
+	 * Interns a string and returns its id.
+	 * Returns STRINTERN_NOID if out of memory.
+	 * */
+	uint32_t strintern_id(struct strintern* pool, const char* s);
+
+	/*
+	 * Gets the canonical copy of a string without adding it.
+	 * Returns NULL if 's' is not in the pool.
+	 * */
+	const char* strintern_lookup(const struct strintern* pool, const char* s);
+
+	/*
+	 * Gets the canonical string of an id.
+	 * Returns NULL if id is not valid.
+	 * */
+	const char* strintern_get(const struct strintern* pool, uint32_t id);
+
+	/*
+	 * Gets the id / length of a canonical string (a pointer returned by the pool).
+	 * */
+	static inline uint32_t strintern_idof(const char* canonical) {
+		return ((const struct strintern_header*)canonical - 1)->id;
+	}
+
+	static inline size_t strintern_lengthof(const char* canonical) {
+		return ((const struct strintern_header*)canonical - 1)->length;
+	}
+
+	/*
+	 * Gets the number of distinct strings.
+	 * */
+	size_t strintern_getcount(const struct strintern* pool);
+
+	/*
+	 * Gets the memory used by the pool in bytes (strings, headers and index).
+	 * */
+	size_t strintern_sizeinbytes(const struct strintern* pool);
+
+	/*
+	 * Container callbacks for canonical strings:
+	 * 	- strintern_isequal: pointer equality (hashtable_isequal);
+	 * 	- strintern_hashfunc / strintern_hashfunc64: hash of the id (hashtable_hashfunc,
+	 * 	  hashtable_hashfunc64);
+	 * 	- strintern_compare: alphabetical order, equal pointers skip strcmp (rbtree_cmp);
+	 * 	- strintern_compare_id: interning order, O(1) (rbtree_cmp).
+	 * */
+	int strintern_isequal(const void* key1, const void* key2);
+	int strintern_hashfunc(const void* key);
+	uint64_t strintern_hashfunc64(const void* key);
+	int strintern_compare(const void* data1, const void* data2);
+	int strintern_compare_id(const void* data1, const void* data2);
+
+	/*
+	 * Releases the pool and all its strings from memory.
+	 * */
+	void strintern_destroy(struct strintern* pool);
+
+#endif /* STRINTERN_H_ */
@@ -0,0 +1,226 @@
+/*
+ * taskpool.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Work-stealing thread pool over Chase-Lev deques.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sched.h>
+#include "taskpool.h"
+
+/*
+ * Steals an item from another worker, starting at a random victim.
+ * Returns 1 if succeeded, 0 if every deque looked empty.
+ * Note: Private function.
+ */
+int taskpool_steal(struct taskpool* pool, struct taskpool_worker* w, void** item)
+{
+	int n = pool->nthreads;
+	int start = rand_r(&(w->seed)) % n;
+	int retry = 1;
+	while (retry) {
+		retry = 0;
+		for (int k = 0; k < n; k++) {
+			int victim = (start + k) % n;
+			if (victim == w->id)
+				continue;
+
+			int r = wsdeque_steal(pool->workers[victim].deque, item);
+			if (r == WSDEQUE_STOLEN)
+				return 1;
+
+			if (r == WSDEQUE_ABORT)
+				retry = 1;		// victim had work, look again
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Processes items of the current run until there are no pending items.
+ * Note: Private function.
+ */
+void taskpool_work(struct taskpool* pool, struct taskpool_worker* w)
+{
+	void* item;
+	while (atomic_load_explicit(&(pool->pending), memory_order_acquire) > 0) {
+		if (wsdeque_pop(w->deque, &item) || taskpool_steal(pool, w, &item)) {
+			pool->func(pool, item, w->id, pool->arg);
+			// after the item's own spawns, so pending is never 0 too soon
+			atomic_fetch_sub_explicit(&(pool->pending), 1, memory_order_release);
+		}
+		else
+			sched_yield();
+	}
+}
+
+/*
+ * Thread function: waits for a run, works on it and reports it left.
+ * Note: Private function.
+ */
+void* taskpool_thread(void* arg)
+{
+	struct taskpool_worker* w = (struct taskpool_worker*)arg;
+	struct taskpool* pool = w->pool;
+	unsigned long seen = 0;
+
+	pthread_mutex_lock(&(pool->lock));
+	for (;;) {
+		while (pool->generation == seen && !pool->shutdown)
+			pthread_cond_wait(&(pool->start), &(pool->lock));
+
+		if (pool->shutdown)
+			break;
+
+		seen = pool->generation;
+		pthread_mutex_unlock(&(pool->lock));
+
+		taskpool_work(pool, w);
+
+		pthread_mutex_lock(&(pool->lock));
+		pool->finished++;
+		pthread_cond_signal(&(pool->done));
+	}
+
+	pthread_mutex_unlock(&(pool->lock));
+	return NULL;
+}
+
+/*
+ * Creates a pool of 'nthreads' workers (< 1: one per online processor), the calling
+ * thread of taskpool_run being one of them.
+ * Returns NULL if there is no memory.
+ */
+struct taskpool* taskpool_create(int nthreads)
+{
+	if (nthreads < 1) {
+		long cores = sysconf(_SC_NPROCESSORS_ONLN);
+		nthreads = (cores > 0) ? (int)cores : 1;
+	}
+
+	struct taskpool* pool = aligned_alloc(TASKPOOL_CACHE_LINE, sizeof(struct taskpool));
+	if (pool == NULL)
+		return NULL;
+
+	pool->workers = aligned_alloc(TASKPOOL_CACHE_LINE, nthreads * sizeof(struct taskpool_worker));
+	if (pool->workers == NULL) {
+		free(pool);
+		return NULL;
+	}
+
+	pool->nthreads = nthreads;
+	pool->func = NULL;
+	pool->arg = NULL;
+	atomic_init(&(pool->pending), 0);
+	pthread_mutex_init(&(pool->lock), NULL);
+	pthread_cond_init(&(pool->start), NULL);
+	pthread_cond_init(&(pool->done), NULL);
+	pool->generation = 0;
+	pool->finished = 0;
+	pool->shutdown = 0;
+
+	for (int i = 0; i < nthreads; i++) {
+		struct taskpool_worker* w = &(pool->workers[i]);
+		w->pool = pool;
+		w->id = i;
+		w->seed = 0x9E3779B9u * (unsigned int)(i + 1);
+		w->deque = wsdeque_create(WSDEQUE_DEFAULT_CAPACITY);
+		if (w->deque == NULL) {
+			printf("Error: failed to allocate memory for task pool deque!\n");
+			abort();
+		}
+	}
+
+	// the calling thread of taskpool_run is worker 0
+	for (int i = 1; i < nthreads; i++)
+		if (pthread_create(&(pool->workers[i].thread), NULL, taskpool_thread, &(pool->workers[i])) != 0) {
+			printf("Error: failed to create task pool thread!\n");
+			abort();
+		}
+
+	return pool;
+}
+
+/*
+ * Gets the number of workers of the pool.
+ */
+int taskpool_getthreads(const struct taskpool* pool)
+{
+	return pool->nthreads;
+}
+
+/*
+ * Runs 'func' over 'n' initial items (spread over the workers) and every item
+ * spawned by the run, returns when all are processed.
+ * Note: one run at a time, not reentrant.
+ */
+void taskpool_run(struct taskpool* pool, taskpool_func func, void* arg, void** items, size_t n)
+{
+	if (n == 0)
+		return;
+
+	pool->func = func;
+	pool->arg = arg;
+	atomic_store_explicit(&(pool->pending), (long)n, memory_order_relaxed);
+
+	// workers are sleeping, their deques can be filled from here
+	for (size_t i = 0; i < n; i++)
+		if (!wsdeque_push(pool->workers[i % pool->nthreads].deque, items[i])) {
+			printf("Error: failed to allocate memory for task pool deque!\n");
+			abort();
+		}
+
+	pthread_mutex_lock(&(pool->lock));
+	pool->finished = 0;
+	pool->generation++;
+	pthread_cond_broadcast(&(pool->start));
+	pthread_mutex_unlock(&(pool->lock));
+
+	taskpool_work(pool, &(pool->workers[0]));
+
+	// no worker may still be reading func/arg when the run returns
+	pthread_mutex_lock(&(pool->lock));
+	while (pool->finished < pool->nthreads - 1)
+		pthread_cond_wait(&(pool->done), &(pool->lock));
+	pthread_mutex_unlock(&(pool->lock));
+}
+
+/*
+ * Adds a work item to the current run (only from inside a run function).
+ */
+void taskpool_spawn(struct taskpool* pool, int worker, void* item)
+{
+	atomic_fetch_add_explicit(&(pool->pending), 1, memory_order_relaxed);
+	if (!wsdeque_push(pool->workers[worker].deque, item)) {
+		printf("Error: failed to allocate memory for task pool deque!\n");
+		abort();
+	}
+}
+
+/*
+ * Stops the threads and releases the pool from memory.
+ */
+void taskpool_destroy(struct taskpool* pool)
+{
+	pthread_mutex_lock(&(pool->lock));
+	pool->shutdown = 1;
+	pthread_cond_broadcast(&(pool->start));
+	pthread_mutex_unlock(&(pool->lock));
+
+	for (int i = 1; i < pool->nthreads; i++)
+		pthread_join(pool->workers[i].thread, NULL);
+
+	for (int i = 0; i < pool->nthreads; i++)
+		wsdeque_destroy(pool->workers[i].deque);
+
+	pthread_mutex_destroy(&(pool->lock));
+	pthread_cond_destroy(&(pool->start));
+	pthread_cond_destroy(&(pool->done));
+	free(pool->workers);
+	free(pool);
+}
@@ -0,0 +1,105 @@
+/*****************************************************************************
+ * taskpool.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a small work-stealing thread pool: a run processes
+ *  			 work items with one function, items may spawn more items.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  The pool starts its threads once and reuses them for every run (threads sleep on
+ *  a condition variable between runs). The thread calling taskpool_run is worker 0,
+ *  so a pool of N threads creates N - 1 threads.
+ *
+ *  A work item is a pointer-sized value (a node, a vertex number...) processed by the
+ *  function of the run, so spawning allocates nothing: items go to the Chase-Lev deque
+ *  of the worker (see wsdeque.h).
+ *
+ *  	- a worker pops its own deque (LIFO, depth-first and cache friendly);
+ *  	- when empty it steals the oldest item of a random victim;
+ *  	- the run ends when the count of pending items (spawned and not finished) is 0,
+ *  	  taskpool_run returns after every worker has left the run.
+ *
+ *  Idle workers spin on steal attempts with sched_yield, so a run should be much
+ *  longer than a scheduler time slice for the threads to pay off.
+ *
+ *  Source: R. Blumofe, C. Leiserson, "Scheduling Multithreaded Computations by Work
+ *  		 Stealing", Journal of the ACM (1999).
+ *
+ *******************************************************************************/
+
+#ifndef TASKPOOL_H_
+	#define TASKPOOL_H_
+
+	#include <stddef.h>
+	#include <stdatomic.h>
+	#include <pthread.h>
+	#include "wsdeque.h"
+
+	#define TASKPOOL_CACHE_LINE 64
+
+	struct taskpool;
+
+	/*
+	 * Processes one work item of a run. 'worker' is the index (0..nthreads - 1) of the
+	 * running thread, for per thread results.
+	 */
+	typedef void (*taskpool_func)(struct taskpool* pool, void* item, int worker, void* arg);
+
+	// worker thread and its deque
+	struct taskpool_worker {
+		struct taskpool* pool;
+		struct wsdeque* deque;
+		pthread_t thread;
+		int id;
+		unsigned int seed;					// victim selection
+	} __attribute__((aligned(TASKPOOL_CACHE_LINE)));
+
+	// thread pool type
+	struct taskpool {
+		int nthreads;
+		struct taskpool_worker* workers;
+		taskpool_func func;					// function of the current run
+		void* arg;							// argument of the current run
+		_Atomic long pending __attribute__((aligned(TASKPOOL_CACHE_LINE)));	// items not finished
+		pthread_mutex_t lock __attribute__((aligned(TASKPOOL_CACHE_LINE)));
+		pthread_cond_t start;				// new run or shutdown
+		pthread_cond_t done;				// a worker left the run
+		unsigned long generation;			// run number
+		int finished;						// workers that left the current run
+		int shutdown;
+	};
+
+	/*
+	 * Creates a pool of 'nthreads' workers (< 1: one per online processor), the calling
+	 * thread of taskpool_run being one of them.
+	 * Returns NULL if there is no memory.
+	 */
+	struct taskpool* taskpool_create(int nthreads);
+
+	/*
+	 * Gets the number of workers of the pool.
+	 */
+	int taskpool_getthreads(const struct taskpool* pool);
+
+	/*
+	 * Runs 'func' over 'n' initial items (spread over the workers) and every item
+	 * spawned by the run, returns when all are processed.
+	 * Note: one run at a time, not reentrant.
+	 */
+	void taskpool_run(struct taskpool* pool, taskpool_func func, void* arg, void** items, size_t n);
+
+	/*
+	 * Adds a work item to the current run (only from inside a run function).
+	 */
+	void taskpool_spawn(struct taskpool* pool, int worker, void* item);
+
+	/*
+	 * Stops the threads and releases the pool from memory.
+	 */
+	void taskpool_destroy(struct taskpool* pool);
+
+#endif /* TASKPOOL_H_ */
@@ -0,0 +1,360 @@
+/*
+ * topk.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Bounded top-k tracker of a stream of keys (heap plus hash index) with
+ * 				Space-Saving and Count-Min variants.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "topk.h"
+
+#define TOPK_INDEX_LOAD_FACTOR 0.75f
+
+/*
+ * Compares two counters by count.
+ * Note: Private function (heap compare function).
+ */
+int topk_compare_counters(const void* a, const void* b)
+{
+	uint64_t x = ((const struct topk_counter*)a)->count;
+	uint64_t y = ((const struct topk_counter*)b)->count;
+	return (x > y) - (x < y);
+}
+
+/*
+ * Gets the key copy of a slot.
+ * Note: Private function.
+ */
+unsigned char* topk_slotkey(const struct topk* topk, size_t slot)
+{
+	return topk->keys + slot * topk->keysize;
+}
+
+/*
+ * Creates a tracker with given mode and sketch size (width and depth 0 if none).
+ * Note: Private function.
+ */
+struct topk* topk_create_with( topk_mode mode, size_t k, size_t width, size_t depth, size_t keysize,
+							   topk_hashfunc hashfunc, topk_isequal isequalfunc )
+{
+	if (k < 1)
+		k = 1;
+	if (keysize < 1)
+		keysize = 1;
+
+	struct topk* result = (struct topk*)malloc(sizeof(struct topk));
+	if (result == NULL) {
+		printf("Memory error: failed to allocate memory for top-k tracker!\n");
+		abort();
+	}
+
+	result->mode = mode;
+	result->k = k;
+	result->keysize = keysize;
+	result->size = 0;
+	result->total = 0;
+	result->hashfunc = hashfunc;
+	result->keys = (unsigned char*)malloc(k * keysize);
+	result->counters = (struct topk_counter*)calloc(k, sizeof(struct topk_counter));
+	result->heap = iminbinpq_create(k, topk_compare_counters, NULL, NULL);
+
+	// the index holds at most k keys: sized so it never reaches its growth threshold
+	result->index = hashtable_lp_create_robinhood64( (size_t)((float)k / TOPK_INDEX_LOAD_FACTOR) + HASHTABLE_LP_MIN_SIZE + 2,
+													 TOPK_INDEX_LOAD_FACTOR, HASHTABLE_LP_RESIZE_FACTOR,
+													 hashfunc, isequalfunc, NULL, NULL );
+
+	result->width = 0;
+	result->depth = 0;
+	result->sketch = NULL;
+	if (mode == TOPK_COUNTMIN) {
+		result->width = 1;
+		while (result->width < width)
+			result->width <<= 1;
+
+		result->depth = (depth < 1) ? 1 : (depth > TOPK_COUNTMIN_MAX_DEPTH) ? TOPK_COUNTMIN_MAX_DEPTH : depth;
+		result->sketch = (uint64_t*)calloc(result->width * result->depth, sizeof(uint64_t));
+	}
+
+	if ((result->keys == NULL) || (result->counters == NULL) || (result->index == NULL) ||
+		((mode == TOPK_COUNTMIN) && (result->sketch == NULL))) {
+		printf("Memory error: failed to allocate memory for top-k tracker arrays!\n");
+		abort();
+	}
+
+	return result;
+}
+
+/*
+ * Creates a tracker of the k heaviest keys of 'keysize' bytes (exact counts while
+ * there are at most k distinct keys).
+ */
+struct topk* topk_create(size_t k, size_t keysize, topk_hashfunc hashfunc, topk_isequal isequalfunc)
+{
+	return topk_create_with(TOPK_TRACKER, k, 0, 0, keysize, hashfunc, isequalfunc);
+}
+
+/*
+ * Creates a Space-Saving tracker of the heavy hitters among keys of 'keysize' bytes,
+ * monitoring k keys.
+ */
+struct topk* topk_create_spacesaving(size_t k, size_t keysize, topk_hashfunc hashfunc, topk_isequal isequalfunc)
+{
+	return topk_create_with(TOPK_SPACESAVING, k, 0, 0, keysize, hashfunc, isequalfunc);
+}
+
+/*
+ * Creates a Count-Min tracker of the k heaviest keys of 'keysize' bytes, with a
+ * sketch of 'depth' rows of 'width' counters (width is rounded up to a power
+ * of two).
+ */
+struct topk* topk_create_countmin( size_t k, size_t width, size_t depth, size_t keysize,
+								   topk_hashfunc hashfunc, topk_isequal isequalfunc )
+{
+	return topk_create_with(TOPK_COUNTMIN, k, width, depth, keysize, hashfunc, isequalfunc);
+}
+
+/*
+ * Gets the slot of a monitored key.
+ * Returns the slot, -1 if the key is not monitored.
+ * Note: Private function.
+ */
+long topk_findslot(const struct topk* topk, const void* key)
+{
+	struct topk_counter* counter = (struct topk_counter*)hashtable_lp_get(topk->index, key);
+	return (counter != NULL) ? (long)(counter - topk->counters) : -1;
+}
+
+/*
+ * Monitors a key with a given counter: in a free slot, or in the slot of the smallest
+ * monitored key (replaced) if the tracker is full.
+ * Note: Private function.
+ */
+void topk_admit(struct topk* topk, const void* key, uint64_t count, uint64_t error)
+{
+	size_t slot;
+	if (topk->size < topk->k) {
+		slot = topk->size++;
+		topk->counters[slot] = (struct topk_counter){ count, error };
+		memcpy(topk_slotkey(topk, slot), key, topk->keysize);
+		iminbinpq_insert(topk->heap, (int)slot, &topk->counters[slot]);
+	}
+	else {
+		slot = (size_t)iminbinpq_peekkeyindex(topk->heap);
+		hashtable_lp_erase(topk->index, topk_slotkey(topk, slot));
+		topk->counters[slot] = (struct topk_counter){ count, error };
+		memcpy(topk_slotkey(topk, slot), key, topk->keysize);
+		iminbinpq_update(topk->heap, (int)slot, &topk->counters[slot]);
+	}
+
+	hashtable_lp_put(topk->index, topk_slotkey(topk, slot), &topk->counters[slot]);
+}
+
+/*
+ * Mixes the key hash into independent row hashes (see topk_countmin_index).
+ * Note: Private function.
+ */
+uint64_t topk_countmin_mix(uint64_t hash)
+{
+	// murmur3 finalizer: every bit of the key hash reaches every bit
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+/*
+ * Gets the counter of row 'row' of a key in the sketch. Rows use the hashes
+ * h1 + row * h2 (Kirsch-Mitzenmacher), both taken from one mixed key hash.
+ * Note: Private function.
+ */
+size_t topk_countmin_index(const struct topk* topk, uint64_t hash, size_t row)
+{
+	uint64_t h2 = (hash >> 32) | 1;
+	return row * topk->width + (size_t)((hash + row * h2) & (topk->width - 1));
+}
+
+/*
+ * Gets the sketch estimate of a key (mixed hash).
+ * Note: Private function.
+ */
+uint64_t topk_countmin_query(const struct topk* topk, uint64_t hash)
+{
+	uint64_t result = UINT64_MAX;
+	for (size_t row = 0; row < topk->depth; ++row) {
+		uint64_t value = topk->sketch[topk_countmin_index(topk, hash, row)];
+		if (value < result)
+			result = value;
+	}
+
+	return result;
+}
+
+/*
+ * Adds 'weight' occurrences of a key to the sketch with conservative update: only
+ * the counters below the new estimate are raised to it.
+ * Returns the new estimate of the key.
+ * Note: Private function.
+ */
+uint64_t topk_countmin_add(struct topk* topk, const void* key, uint64_t weight)
+{
+	uint64_t hash = topk_countmin_mix(topk->hashfunc(key));
+	uint64_t estimate = topk_countmin_query(topk, hash) + weight;
+	for (size_t row = 0; row < topk->depth; ++row) {
+		uint64_t* counter = &topk->sketch[topk_countmin_index(topk, hash, row)];
+		if (*counter < estimate)
+			*counter = estimate;
+	}
+
+	return estimate;
+}
+
+/*
+ * Adds 'weight' occurrences of a key. O(log k), O(log k + depth) for Count-Min.
+ */
+void topk_add(struct topk* topk, const void* key, uint64_t weight)
+{
+	topk->total += weight;
+	if (topk->mode == TOPK_COUNTMIN) {
+		topk_offer(topk, key, topk_countmin_add(topk, key, weight));
+		return;
+	}
+
+	long slot = topk_findslot(topk, key);
+	if (slot >= 0) {
+		topk->counters[slot].count += weight;
+		iminbinpq_update(topk->heap, (int)slot, &topk->counters[slot]);
+	}
+	else if (topk->size < topk->k)
+		topk_admit(topk, key, weight, 0);
+	else if (topk->mode == TOPK_SPACESAVING) {
+		// the new key takes over the smallest count, which bounds its error
+		uint64_t min = topk_getmin(topk);
+		topk_admit(topk, key, min + weight, min);
+	}
+	else if (weight > topk_getmin(topk))
+		topk_admit(topk, key, weight, 0);
+}
+
+/*
+ * Sets the count of a key: a monitored key gets the count, another key replaces
+ * the smallest monitored key if the tracker is full and its count is greater.
+ * Returns 1 if the key is monitored afterwards, 0 otherwise.
+ */
+int topk_offer(struct topk* topk, const void* key, uint64_t count)
+{
+	long slot = topk_findslot(topk, key);
+	if (slot >= 0) {
+		topk->counters[slot].count = count;
+		iminbinpq_update(topk->heap, (int)slot, &topk->counters[slot]);
+		return 1;
+	}
+
+	if ((topk->size == topk->k) && (count <= topk_getmin(topk)))
+		return 0;
+
+	topk_admit(topk, key, count, 0);
+	return 1;
+}
+
+/*
+ * Gets the (estimated) count of a key: its counter if monitored, the sketch
+ * estimate for Count-Min trackers, 0 otherwise.
+ */
+uint64_t topk_estimate(const struct topk* topk, const void* key)
+{
+	long slot = topk_findslot(topk, key);
+	if (slot >= 0)
+		return topk->counters[slot].count;
+	else if (topk->mode == TOPK_COUNTMIN)
+		return topk_countmin_query(topk, topk_countmin_mix(topk->hashfunc(key)));
+
+	return 0;
+}
+
+/*
+ * Checks if a key is monitored.
+ */
+int topk_contains(const struct topk* topk, const void* key)
+{
+	return hashtable_lp_contains(topk->index, key);
+}
+
+/*
+ * Gets the smallest count of the monitored keys (0 if none).
+ */
+uint64_t topk_getmin(const struct topk* topk)
+{
+	if (topk->size == 0)
+		return 0;
+
+	return ((const struct topk_counter*)iminbinpq_peek(topk->heap))->count;
+}
+
+/*
+ * Gets the number of monitored keys.
+ */
+size_t topk_getsize(const struct topk* topk)
+{
+	return topk->size;
+}
+
+/*
+ * Compares two items by decreasing count.
+ * Note: Private function (qsort compare function).
+ */
+int topk_compare_items(const void* a, const void* b)
+{
+	uint64_t x = ((const struct topk_item*)a)->count;
+	uint64_t y = ((const struct topk_item*)b)->count;
+	return (x < y) - (x > y);
+}
+
+/*
+ * Gets the monitored keys by decreasing count. 'items' must have room for
+ * topk_getsize() items.
+ * Returns the number of items.
+ */
+size_t topk_getitems(const struct topk* topk, struct topk_item* items)
+{
+	for (size_t slot = 0; slot < topk->size; ++slot)
+		items[slot] = (struct topk_item){ topk_slotkey(topk, slot), topk->counters[slot].count,
+										  topk->counters[slot].error };
+
+	qsort(items, topk->size, sizeof(struct topk_item), topk_compare_items);
+	return topk->size;
+}
+
+/*
+ * Removes every key and count.
+ */
+void topk_clear(struct topk* topk)
+{
+	for (size_t slot = 0; slot < topk->size; ++slot) {
+		hashtable_lp_erase(topk->index, topk_slotkey(topk, slot));
+		iminbinpq_delete(topk->heap, (int)slot);
+	}
+
+	topk->size = 0;
+	topk->total = 0;
+	if (topk->sketch != NULL)
+		memset(topk->sketch, 0, topk->width * topk->depth * sizeof(uint64_t));
+}
+
+/*
+ * Releases a tracker from memory.
+ */
+void topk_destroy(struct topk* topk)
+{
+	hashtable_lp_destroy(topk->index);
+	iminbinpq_destroy(topk->heap);
+	free(topk->sketch);
+	free(topk->counters);
+	free(topk->keys);
+	free(topk);
+}
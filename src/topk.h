@@ -0,0 +1,164 @@
+/*****************************************************************************
+ * topk.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers of a bounded top-k tracker of a stream of keys (heavy
+ *  			 hitters): exact, Space-Saving and Count-Min variants.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A tracker monitors at most k keys, each in a slot holding a copy of the key
+ *  ('keysize' bytes) and its counter. Slots are indexed by:
+ *  	- an indexed min binary heap (see indminbinaryheap.h) of their counters, slot
+ *  	  number as key index: the root is the monitored key with the smallest count,
+ *  	  the one to replace when a heavier key arrives. A counter that changes in
+ *  	  place is sifted to its new position in O(log k);
+ *  	- a robin hood hash table (see hashtable_lp.h) from key to counter, sized so it
+ *  	  never grows and erased without tombstones (hashtable_lp_erase).
+ *  Every array is allocated at creation: updates copy keys into slots and never
+ *  allocate, so memory is fixed at O(k) (plus the sketch of the Count-Min variant).
+ *
+ *  Variants (topk_add)
+ *
+ *  	- tracker (topk_create): counts are exact while there are at most k distinct
+ *  	  keys; afterwards a new key is only admitted by topk_offer with a count above
+ *  	  the smallest one. Fits scores computed by the caller (topk_offer).
+ *  	- Space-Saving (topk_create_spacesaving): a new key replaces the smallest
+ *  	  monitored key and inherits its count, kept as the error of the new key.
+ *  	  Counts never underestimate, overestimate by at most the error (<= total / k)
+ *  	  and every key with more than total / k occurrences is monitored.
+ *  	- Count-Min (topk_create_countmin): a sketch of 'depth' rows of 'width' counters
+ *  	  estimates the count of every key (the minimum of its counter in each row,
+ *  	  never an underestimate); keys whose estimate gets above the smallest monitored
+ *  	  one replace it. Conservative update (only the counters at the minimum are
+ *  	  raised) keeps overestimates small. With width = e / epsilon and
+ *  	  depth = ln(1 / delta), estimates exceed the count by more than epsilon * total
+ *  	  with probability below delta.
+ *
+ *  Source: Metwally, Agrawal, El Abbadi, "Efficient Computation of Frequent and Top-k
+ *  		Elements in Data Streams" (Space-Saving), 2005.
+ *  		Cormode, Muthukrishnan, "An Improved Data Stream Summary: The Count-Min
+ *  		Sketch and its Applications", 2005.
+ *
+ *******************************************************************************/
+
+#ifndef TOPK_H_
+	#define TOPK_H_
+
+	#include <stdlib.h>
+	#include <stdint.h>
+	#include "indminbinaryheap.h"
+	#include "hashtable_lp.h"
+
+	#define TOPK_COUNTMIN_MAX_DEPTH 32		// rows of a Count-Min sketch above this limit are ignored
+
+	typedef uint64_t (*topk_hashfunc)(const void* key);
+	typedef int (*topk_isequal)(const void* key1, const void* key2);
+
+	typedef enum { TOPK_TRACKER = 0, TOPK_SPACESAVING, TOPK_COUNTMIN } topk_mode;
+
+	// counter of a monitored key
+	struct topk_counter {
+		uint64_t count;					// (estimated) number of occurrences
+		uint64_t error;					// maximum overestimation of count (Space-Saving)
+	};
+
+	// monitored key, as returned by topk_getitems
+	struct topk_item {
+		const void* key;				// copy of the key (valid until next update)
+		uint64_t count;
+		uint64_t error;
+	};
+
+	struct topk {
+		topk_mode mode;
+		size_t k;						// maximum number of monitored keys
+		size_t keysize;					// bytes of a key
+		size_t size;					// number of monitored keys
+		uint64_t total;					// sum of the weights added
+		topk_hashfunc hashfunc;
+		unsigned char* keys;			// key of each slot (k * keysize bytes)
+		struct topk_counter* counters;	// counter of each slot
+		struct iminbinarypq* heap;		// slots by count (smallest at root)
+		struct hashtable_lp* index;		// key -> counter of its slot
+
+		// Count-Min sketch
+		size_t width;					// counters per row (power of two)
+		size_t depth;					// number of rows
+		uint64_t* sketch;				// depth * width counters
+	};
+
+	/*
+	 * Creates a tracker of the k heaviest keys of 'keysize' bytes (exact counts while
+	 * there are at most k distinct keys).
+	 */
+	struct topk* topk_create(size_t k, size_t keysize, topk_hashfunc hashfunc, topk_isequal isequalfunc);
+
+	/*
+	 * Creates a Space-Saving tracker of the heavy hitters among keys of 'keysize' bytes,
+	 * monitoring k keys.
+	 */
+	struct topk* topk_create_spacesaving(size_t k, size_t keysize, topk_hashfunc hashfunc, topk_isequal isequalfunc);
+
+	/*
+	 * Creates a Count-Min tracker of the k heaviest keys of 'keysize' bytes, with a
+	 * sketch of 'depth' rows of 'width' counters (width is rounded up to a power
+	 * of two).
+	 */
+	struct topk* topk_create_countmin( size_t k, size_t width, size_t depth, size_t keysize,
+									   topk_hashfunc hashfunc, topk_isequal isequalfunc );
+
+	/*
+	 * Adds 'weight' occurrences of a key. O(log k), O(log k + depth) for Count-Min.
+	 */
+	void topk_add(struct topk* topk, const void* key, uint64_t weight);
+
+	/*
+	 * Sets the count of a key: a monitored key gets the count, another key replaces
+	 * the smallest monitored key if the tracker is full and its count is greater.
+	 * Returns 1 if the key is monitored afterwards, 0 otherwise.
+	 */
+	int topk_offer(struct topk* topk, const void* key, uint64_t count);
+
+	/*
+	 * Gets the (estimated) count of a key: its counter if monitored, the sketch
+	 * estimate for Count-Min trackers, 0 otherwise.
+	 */
+	uint64_t topk_estimate(const struct topk* topk, const void* key);
+
+	/*
+	 * Checks if a key is monitored.
+	 */
+	int topk_contains(const struct topk* topk, const void* key);
+
+	/*
+	 * Gets the smallest count of the monitored keys (0 if none).
+	 */
+	uint64_t topk_getmin(const struct topk* topk);
+
+	/*
+	 * Gets the number of monitored keys.
+	 */
+	size_t topk_getsize(const struct topk* topk);
+
+	/*
+	 * Gets the monitored keys by decreasing count. 'items' must have room for
+	 * topk_getsize() items.
+	 * Returns the number of items.
+	 */
+	size_t topk_getitems(const struct topk* topk, struct topk_item* items);
+
+	/*
+	 * Removes every key and count.
+	 */
+	void topk_clear(struct topk* topk);
+
+	/*
+	 * Releases a tracker from memory.
+	 */
+	void topk_destroy(struct topk* topk);
+
+#endif /* TOPK_H_ */
@@ -0,0 +1,336 @@
+/********************************************************************************
+ * transclosure.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: C implementation of a transitive closure (ancestors) engine for
+ *  			directed graphs in CSR format.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Rows are pulled from the incoming edges (reverse graph), so a component only
+ *  writes its own row and components of the same DAG level can be computed by
+ *  different threads without locks.
+ *
+ *  Source: https://en.wikipedia.org/wiki/Transitive_closure#Algorithms
+ *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "transclosure.h"
+
+// shared state of worker threads
+struct transclosure_state {
+	struct transclosure* tc;
+	const struct csrgraph* rg;			// reverse graph (incoming edges)
+	int numlevels;						// number of DAG levels
+	int* levelstart;					// first component of each level in 'levelcomps'
+	int* levelcomps;					// components grouped by level
+	atomic_int* cursors;				// next component to take of each level
+	pthread_barrier_t barrier;			// level barrier
+};
+
+/*
+ * Computes the ancestors row of component 'c'.
+ * Rows of all its predecessors must be already computed.
+ */
+void transclosure_computerow(struct transclosure* tc, const struct csrgraph* rg, int c)
+{
+	uint64_t* row = tc->reach + (size_t)c * tc->words;
+	int last = -1;
+
+	for (int i = tc->compstart[c]; i < tc->compstart[c + 1]; ++i) {
+		int u = tc->members[i];
+		for (size_t e = rg->offsets[u]; e < rg->offsets[u + 1]; ++e) {
+			int p = tc->component[rg->targets[e]];
+			if (p == c || p == last)
+				continue;
+
+			// ancestors of 'p' have higher numbers than 'p', skip lower words
+			const uint64_t* prow = tc->reach + (size_t)p * tc->words;
+			for (size_t w = (size_t)(p + 1) >> 6; w < tc->words; ++w)
+				row[w] |= prow[w];
+
+			row[p >> 6] |= (uint64_t)1 << (p & 63);
+			last = p;
+		}
+	}
+}
+
+/*
+ * Worker thread loop: computes rows level by level.
+ */
+void* transclosure_run(void* arg)
+{
+	struct transclosure_state* st = (struct transclosure_state*)arg;
+
+	for (int l = 0; l < st->numlevels; ++l) {
+		int size = st->levelstart[l + 1] - st->levelstart[l];
+		int i;
+		while ((i = atomic_fetch_add_explicit(&(st->cursors[l]), 1, memory_order_relaxed)) < size)
+			transclosure_computerow(st->tc, st->rg, st->levelcomps[st->levelstart[l] + i]);
+
+		pthread_barrier_wait(&(st->barrier));
+	}
+
+	return NULL;
+}
+
+/*
+ * Computes all rows with 'nthreads' threads, one DAG level at a time.
+ */
+void transclosure_compute_parallel(struct transclosure* tc, const struct csrgraph* rg, int nthreads)
+{
+	int nc = tc->numcomponents;
+	int* level = (int*)calloc(nc, sizeof(int));
+	struct transclosure_state st;
+	st.tc = tc;
+	st.rg = rg;
+	st.numlevels = 0;
+	if (!level) {
+		printf("Memory error: failed to allocate memory for closure levels!\n");
+		abort();
+	}
+
+	// level of a component is its longest distance to a source component
+	for (int c = nc - 1; c >= 0; --c) {
+		for (int i = tc->compstart[c]; i < tc->compstart[c + 1]; ++i) {
+			int u = tc->members[i];
+			for (size_t e = rg->offsets[u]; e < rg->offsets[u + 1]; ++e) {
+				int p = tc->component[rg->targets[e]];
+				if (p != c && level[p] + 1 > level[c])
+					level[c] = level[p] + 1;
+			}
+		}
+
+		if (level[c] + 1 > st.numlevels)
+			st.numlevels = level[c] + 1;
+	}
+
+	st.levelstart = (int*)calloc(st.numlevels + 1, sizeof(int));
+	st.levelcomps = (int*)malloc(nc * sizeof(int));
+	st.cursors = (atomic_int*)malloc(st.numlevels * sizeof(atomic_int));
+	if (!st.levelstart || !st.levelcomps || !st.cursors) {
+		printf("Memory error: failed to allocate memory for closure levels!\n");
+		abort();
+	}
+
+	// group components by level
+	for (int c = 0; c < nc; ++c)
+		st.levelstart[level[c] + 1]++;
+	for (int l = 0; l < st.numlevels; ++l) {
+		st.levelstart[l + 1] += st.levelstart[l];
+		atomic_init(&(st.cursors[l]), 0);
+	}
+	for (int c = 0; c < nc; ++c)
+		st.levelcomps[st.levelstart[level[c]]++] = c;
+	for (int l = st.numlevels; l > 0; --l)
+		st.levelstart[l] = st.levelstart[l - 1];
+	st.levelstart[0] = 0;
+
+	if (pthread_barrier_init(&(st.barrier), NULL, nthreads) != 0) {
+		printf("Error: failed to initialize closure barrier!\n");
+		abort();
+	}
+
+	pthread_t* threads = (pthread_t*)malloc(nthreads * sizeof(pthread_t));
+	if (!threads) {
+		printf("Memory error: failed to allocate memory for closure threads!\n");
+		abort();
+	}
+
+	for (int i = 1; i < nthreads; ++i)
+		if (pthread_create(&(threads[i]), NULL, transclosure_run, &st) != 0) {
+			printf("Error: failed to create closure thread!\n");
+			abort();
+		}
+
+	transclosure_run(&st);	// calling thread is a worker too
+
+	for (int i = 1; i < nthreads; ++i)
+		pthread_join(threads[i], NULL);
+
+	pthread_barrier_destroy(&(st.barrier));
+	free(threads);
+	free(st.cursors);
+	free(st.levelcomps);
+	free(st.levelstart);
+	free(level);
+}
+
+/*
+ * Computes the ancestors of every vertex of a directed graph using 'nthreads' threads.
+ * Returns the new transitive closure.
+ */
+struct transclosure* transclosure_ancestors_create(const struct csrgraph* g, int nthreads)
+{
+	struct transclosure* result = (struct transclosure*)malloc(sizeof(*result));
+	if (!result) {
+		printf("Memory error: failed to allocate memory for transitive closure!\n");
+		abort();
+	}
+
+	size_t n = g->numvertices;
+	result->numvertices = n;
+	result->component = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+	result->members = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+	if (!(result->component) || !(result->members)) {
+		printf("Memory error: failed to allocate memory for transitive closure arrays!\n");
+		abort();
+	}
+
+	// 1. condense strongly connected components
+	int nc = dfsalg_csr_scc(g, result->component);
+	result->numcomponents = nc;
+	result->compstart = (int*)calloc(nc + 1, sizeof(int));
+	result->words = (size_t)nc / 64 + 1;
+	result->reach = (uint64_t*)calloc((size_t)nc * result->words + 1, sizeof(uint64_t));
+	if (!(result->compstart) || !(result->reach)) {
+		printf("Memory error: failed to allocate memory for transitive closure bitsets!\n");
+		abort();
+	}
+
+	// group vertices by component, keeping ascending order inside each component
+	for (size_t v = 0; v < n; ++v)
+		result->compstart[result->component[v] + 1]++;
+	for (int c = 0; c < nc; ++c)
+		result->compstart[c + 1] += result->compstart[c];
+	for (size_t v = 0; v < n; ++v)
+		result->members[result->compstart[result->component[v]]++] = (int)v;
+	for (int c = nc; c > 0; --c)
+		result->compstart[c] = result->compstart[c - 1];
+	result->compstart[0] = 0;
+
+	// 2. propagate ancestors in topological order (higher component numbers first)
+	struct csrgraph* rg = csrgraph_create_reverse(g);
+	if (nthreads > 1)
+		transclosure_compute_parallel(result, rg, nthreads);
+	else
+		for (int c = nc - 1; c >= 0; --c)
+			transclosure_computerow(result, rg, c);
+
+	csrgraph_destroy(rg);
+	return result;
+}
+
+/*
+ * Checks if 'u' is an ancestor of 'v' (there is a path from 'u' to 'v', u != v).
+ * Returns '1' (true) if succeeded, '0' (false) otherwise.
+ */
+int transclosure_isancestor(const struct transclosure* tc, int u, int v)
+{
+	if (u == v)
+		return 0;
+
+	int cu = tc->component[u], cv = tc->component[v];
+	if (cu == cv)
+		return 1;
+
+	const uint64_t* row = tc->reach + (size_t)cv * tc->words;
+	return (row[cu >> 6] >> (cu & 63)) & 1;
+}
+
+/*
+ * Gets the number of ancestors of vertex 'v'.
+ */
+size_t transclosure_countancestors(const struct transclosure* tc, int v)
+{
+	int c = tc->component[v];
+	size_t result = tc->compstart[c + 1] - tc->compstart[c] - 1;
+	const uint64_t* row = tc->reach + (size_t)c * tc->words;
+
+	for (size_t w = 0; w < tc->words; ++w)
+		for (uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+			int k = (int)(w * 64 + __builtin_ctzll(bits));
+			result += tc->compstart[k + 1] - tc->compstart[k];
+		}
+
+	return result;
+}
+
+/*
+ * Compare function for sorting vertex numbers.
+ */
+int transclosure_compare_int(const void* a, const void* b)
+{
+	int x = *((const int*)a), y = *((const int*)b);
+	return (x > y) - (x < y);
+}
+
+/*
+ * Converts the closure to an array of ancestor lists (see dfsalg_find_ancestors).
+ * Each list is sorted by vertex number and does not include the vertex itself.
+ * Note: release result with 'dfsalg_destroy_ancestors'.
+ */
+struct dfsalgancestornode** transclosure_to_ancestorlists(const struct transclosure* tc)
+{
+	size_t n = tc->numvertices;
+	struct dfsalgancestornode** result = calloc((n > 0 ? n : 1), sizeof(struct dfsalgancestornode*));
+	int* buf = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+	if (!result || !buf) {
+		printf("Memory error: failed to allocate memory for ancestors lists!\n");
+		abort();
+	}
+
+	for (int c = 0; c < tc->numcomponents; ++c) {
+		// ancestors of a component: its own members and members of all reaching components
+		size_t count = 0;
+		for (int i = tc->compstart[c]; i < tc->compstart[c + 1]; ++i)
+			buf[count++] = tc->members[i];
+
+		const uint64_t* row = tc->reach + (size_t)c * tc->words;
+		for (size_t w = 0; w < tc->words; ++w)
+			for (uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+				int k = (int)(w * 64 + __builtin_ctzll(bits));
+				for (int i = tc->compstart[k]; i < tc->compstart[k + 1]; ++i)
+					buf[count++] = tc->members[i];
+			}
+
+		qsort(buf, count, sizeof(int), transclosure_compare_int);
+
+		// every member gets the same list, without itself (built backwards to keep order)
+		for (int i = tc->compstart[c]; i < tc->compstart[c + 1]; ++i) {
+			int v = tc->members[i];
+			struct dfsalgancestornode* first = NULL;
+
+			for (size_t j = count; j > 0; --j) {
+				if (buf[j - 1] == v)
+					continue;
+
+				struct dfsalgancestornode* node = (struct dfsalgancestornode*)malloc(sizeof(struct dfsalgancestornode));
+				if (!node) {
+					printf("Memory error: failed to allocate memory for ancestor node!\n");
+					abort();
+				}
+
+				node->vertice = buf[j - 1];
+				node->next = first;
+				first = node;
+			}
+
+			result[v] = first;
+		}
+	}
+
+	free(buf);
+	return result;
+}
+
+/*
+ * Releases the transitive closure from memory.
+ */
+void transclosure_destroy(struct transclosure* tc)
+{
+	free(tc->component);
+	free(tc->compstart);
+	free(tc->members);
+	free(tc->reach);
+	free(tc);
+}
@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * transclosure.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a transitive closure (ancestors) engine for directed
+ *  			 graphs in CSR format.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Running one DFS per vertex costs O(V * (V + E)). Instead the graph is condensed:
+ *
+ *  	1. Strongly connected components are computed once (iteractive Tarjan, see
+ *  	   dfsalg_csr_scc). All vertices of a component share the same ancestors;
+ *  	2. The condensed graph is a DAG. Its components are visited in topological
+ *  	   order and the ancestors of a component are the union of the ancestors of
+ *  	   its predecessors plus the predecessors themselves;
+ *  	3. Ancestor sets are bitsets with one bit per component, so a union is a loop
+ *  	   of 64 bit ORs. Tarjan numbers components in reverse topological order, so a
+ *  	   component only has ancestors with a higher number and each OR skips the
+ *  	   words below the predecessor number.
+ *
+ *  Components with the same depth in the DAG do not depend on each other, so with
+ *  more than one thread each depth level is split among worker threads.
+ *
+ *  Cost is O(V + E + E' * C / 64) time and C * C / 8 bytes for C components and
+ *  E' edges between components.
+ *
+ *  Source: https://en.wikipedia.org/wiki/Transitive_closure#Algorithms
+ *
+ *******************************************************************************/
+
+#ifndef TRANSCLOSURE_H_
+	#define TRANSCLOSURE_H_
+
+	#include <stdlib.h>
+	#include <stdint.h>
+	#include "csrgraph.h"
+	#include "dfsalg.h"
+
+	// ancestors of every vertex of a graph
+	struct transclosure {
+		size_t numvertices;					// number of vertices
+		int numcomponents;					// number of strongly connected components
+		int* component;						// component of each vertex
+		int* compstart;						// first member of each component in 'members' (numcomponents + 1)
+		int* members;						// vertices grouped by component (ascending)
+		size_t words;						// words of each bitset row
+		uint64_t* reach;					// row 'c': bit 'k' set if component 'k' reaches component 'c' (k != c)
+	};
+
+	/*
+	 * Computes the ancestors of every vertex of a directed graph using 'nthreads' threads.
+	 * Returns the new transitive closure.
+	 */
+	struct transclosure* transclosure_ancestors_create(const struct csrgraph* g, int nthreads);
+
+	/*
+	 * Checks if 'u' is an ancestor of 'v' (there is a path from 'u' to 'v', u != v).
+	 * Returns '1' (true) if succeeded, '0' (false) otherwise.
+	 */
+	int transclosure_isancestor(const struct transclosure* tc, int u, int v);
+
+	/*
+	 * Gets the number of ancestors of vertex 'v'.
+	 */
+	size_t transclosure_countancestors(const struct transclosure* tc, int v);
+
+	/*
+	 * Converts the closure to an array of ancestor lists (see dfsalg_find_ancestors).
+	 * Each list is sorted by vertex number and does not include the vertex itself.
+	 * Note: release result with 'dfsalg_destroy_ancestors'.
+	 */
+	struct dfsalgancestornode** transclosure_to_ancestorlists(const struct transclosure* tc);
+
+	/*
+	 * Releases the transitive closure from memory.
+	 */
+	void transclosure_destroy(struct transclosure* tc);
+
+#endif /* TRANSCLOSURE_H_ */
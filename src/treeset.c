@@ -35,17 +35,26 @@
 #include <stdio.h>
 #include "treeset.h"
 #include "redblacktree.h"
+#include "btree.h"
 #include "arraylist.h"
+#include "sortedarray.h"
+#include "nodearena.h"
+#include "taskpool.h"
+#include <string.h>
 
 /*
- * Function to create a new treeset.
+ * Function to create a new treeset backed by the given tree type.
+ * If 'arena' is not NULL red-black tree nodes are allocated from it; the set owns the arena.
+ * The B+ tree backend does not use an arena (must be NULL).
  * Returns pointer to created treeset instance is succeeded, NULL otherwise.
  */
 struct treeset* treeset_create( treeset_calcelementsize calcelementsizefunc,
 								treeset_copyelement copyelementfunc,
 								treeset_compare comparefunc,
 								treeset_printelement printelementfunc,
-								treeset_freedata freedatafunc )
+								treeset_freedata freedatafunc,
+								treeset_backend backend,
+								struct nodearena* arena )
 {
 
 	struct treeset* result = (struct treeset*)malloc(sizeof(struct treeset));
@@ -54,9 +63,23 @@ struct treeset* treeset_create( treeset_calcelementsize calcelementsizefunc,
 		printf("Memory error: failed to allocate memory for treeset!");
 		abort();
 	}
+	else if (backend == TREESET_BTREE) {
+		if (arena != NULL) {
+			printf("Error: B+ tree treeset backend does not use a node arena!");
+			abort();
+		}
+
+		result->backend = backend;
+		result->tree = NULL;
+		result->btree = btree_create( calcelementsizefunc, comparefunc, freedatafunc,
+									  printelementfunc, copyelementfunc );
+		result->size = 0;
+	}
 	else {
+		result->backend = TREESET_RBTREE;
+		result->btree = NULL;
 		result->tree = rbtree_create( NULL, calcelementsizefunc, comparefunc,
-									  freedatafunc, printelementfunc, copyelementfunc);
+									  freedatafunc, printelementfunc, copyelementfunc, arena);
 		if (!(result->tree)) {
 			printf("Memory error: faile to allocate memory for treeset tree!");
 			abort();
@@ -68,11 +91,44 @@ struct treeset* treeset_create( treeset_calcelementsize calcelementsizefunc,
 	return result;
 }
 
+/*
+ * Function to create a new treeset from 'n' elements sorted in strictly ascending
+ * order, in O(n) (see rbtree_build_sorted and btree_build_sorted): much faster than
+ * adding them one by one, no compares other than the order check and no rebalances.
+ * Returns pointer to created treeset instance is succeeded, NULL if elements are
+ * not sorted.
+ */
+struct treeset* treeset_create_from_sorted( void** items, size_t n,
+											treeset_calcelementsize calcelementsizefunc,
+											treeset_copyelement copyelementfunc,
+											treeset_compare comparefunc,
+											treeset_printelement printelementfunc,
+											treeset_freedata freedatafunc,
+											treeset_backend backend,
+											struct nodearena* arena )
+{
+	struct treeset* result = treeset_create( calcelementsizefunc, copyelementfunc, comparefunc,
+											 printelementfunc, freedatafunc, backend, arena );
+
+	int built = (result->btree) ? btree_build_sorted(result->btree, items, n)
+								: rbtree_build_sorted(result->tree, items, n);
+	if (!built) {
+		treeset_destroy(result);
+		return NULL;
+	}
+
+	result->size = n;
+	return result;
+}
+
 /*
  * Checks if the treeset already contains a given element.
  */
 int treeset_contains( struct treeset* set, void* value )
 {
+	if (set->btree)
+		return btree_search(set->btree, value) != NULL;
+
 	if (rbtree_search(set->tree, set->tree->root, value))
 		return 1;
 	else
@@ -85,8 +141,10 @@ int treeset_contains( struct treeset* set, void* value )
  */
 void treeset_add(struct treeset* set, void* value)
 {
-	// duplicated values will not be inserted by default in the red-black tree.
-	if (rbtree_insert(set->tree, value))
+	// duplicated values will not be inserted by default in the trees.
+	int inserted = (set->btree) ? btree_insert(set->btree, value)
+								: rbtree_insert(set->tree, value);
+	if (inserted)
 		set->size++;
 }
 
@@ -96,7 +154,8 @@ void treeset_add(struct treeset* set, void* value)
  */
 void* treeset_remove(struct treeset* set, void* value)
 {
-	void* result = rbtree_delete(set->tree, value);
+	void* result = (set->btree) ? btree_delete(set->btree, value)
+								: rbtree_delete(set->tree, value);
 	if (result)
 		set->size--;
 
@@ -109,6 +168,9 @@ void* treeset_remove(struct treeset* set, void* value)
  */
 void* treeset_max(struct treeset* set)
 {
+	if (set->btree)
+		return btree_max(set->btree);
+
 	struct rbtreenode* node = set->tree->root;
 	if (node) {
 		while (node->right) {
@@ -127,6 +189,9 @@ void* treeset_max(struct treeset* set)
  */
 void* treeset_min(struct treeset* set)
 {
+	if (set->btree)
+		return btree_min(set->btree);
+
 	struct rbtreenode* node = set->tree->root;
 	if (node) {
 		while (node->left) {
@@ -148,7 +213,7 @@ void* treeset_min(struct treeset* set)
  *
  * Returns NULL if set is empty.
  * */
-void* treeset_floor(struct treeset* set, struct rbtreenode* root, void* key)
+void* treeset_floor_node(struct treeset* set, struct rbtreenode* root, void* key)
 {
     if (!root)
         return NULL;
@@ -159,11 +224,11 @@ void* treeset_floor(struct treeset* set, struct rbtreenode* root, void* key)
 
     /* If root->data is greater than the key - go left*/
     if (set->tree->compare(root->data, key) > 0)	//(root->data > key)
-        return treeset_floor(set, root->left, key);
+        return treeset_floor_node(set, root->left, key);
 
     /* Else, the floor may lie in right subtree
       or may be equal to the root - go right*/
-    void* floorValue = treeset_floor(set, root->right, key);
+    void* floorValue = treeset_floor_node(set, root->right, key);
     return ((!(set->tree->compare(floorValue, key) > 0)) && (floorValue != NULL)) ? floorValue : root->data;
 }
 
@@ -176,7 +241,7 @@ void* treeset_floor(struct treeset* set, struct rbtreenode* root, void* key)
  *
  * Returns NULL if set is empty.
  * */
-void* treeset_ceiling(struct treeset* set, struct rbtreenode* root, void* key)
+void* treeset_ceiling_node(struct treeset* set, struct rbtreenode* root, void* key)
 {
     if (!root)
         return NULL;
@@ -187,14 +252,40 @@ void* treeset_ceiling(struct treeset* set, struct rbtreenode* root, void* key)
 
     /* If root->data is lesser than the key - go right*/
     if (set->tree->compare(root->data, key) < 0)	//(root->data < key)
-        return treeset_ceiling( set, root->right, key );
+        return treeset_ceiling_node( set, root->right, key );
 
     /* Else, the celing may lie in left subtree
       or may be equal to the root - go left*/
-    void* ceilingValue = treeset_ceiling( set, root->left, key );
+    void* ceilingValue = treeset_ceiling_node( set, root->left, key );
     return (!(set->tree->compare(ceilingValue, key) < 0)) ? ceilingValue : root->data;
 }
 
+/*
+ * Gets floor element of a key: greatest element lesser than or equal to the key.
+ * 'root' is the red-black subtree to search, it is ignored by the B+ tree backend.
+ * Returns NULL if set is empty.
+ * */
+void* treeset_floor(struct treeset* set, struct rbtreenode* root, void* key)
+{
+	if (set->btree)
+		return btree_floor(set->btree, key);
+
+	return treeset_floor_node(set, root, key);
+}
+
+/*
+ * Gets ceiling element of a key: smallest element larger than or equal to the key.
+ * 'root' is the red-black subtree to search, it is ignored by the B+ tree backend.
+ * Returns NULL if set is empty.
+ * */
+void* treeset_ceiling(struct treeset* set, struct rbtreenode* root, void* key)
+{
+	if (set->btree)
+		return btree_ceiling(set->btree, key);
+
+	return treeset_ceiling_node(set, root, key);
+}
+
 /*
  * Inorder traversal to visit nodes element in ascending order.
  */
@@ -259,8 +350,10 @@ void __tree_set_visitor_default( void* element, void** result, int i ) {
 void __treeset_range_visitor_default( struct treeset* set, void* element,
 									  void** result, int hardcopy ) {
 	if (hardcopy) {
-		void* copy_el = (void*)malloc(set->tree->calcdatasize(element));
-		set->tree->copydata(copy_el, element);
+		treeset_calcelementsize calcsize = (set->btree) ? set->btree->calcdatasize : set->tree->calcdatasize;
+		treeset_copyelement copy = (set->btree) ? set->btree->copydata : set->tree->copydata;
+		void* copy_el = (void*)malloc(calcsize(element));
+		copy(copy_el, element);
 		arraylist_add( (struct arraylist*)result, copy_el );
 	}
 	else
@@ -276,6 +369,15 @@ void** treeset_toarray(struct treeset* set)
 	void** arr = (void**)malloc(sizeof(void*) * set->size);
 	int idx = 0;
 
+	if (set->btree) {
+		// leaves are linked in order
+		for (struct btreeleaf* leaf = set->btree->first; leaf != NULL; leaf = leaf->next)
+			for (int i = 0; i < leaf->base.count; ++i)
+				arr[idx++] = leaf->items[i];
+
+		return arr;
+	}
+
 //	// visit function
 //	void visit( void* element, void** result, int i ) {
 //		result[i] = element;
@@ -294,6 +396,14 @@ void** treeset_toarray_desc(struct treeset* set)
 	void** result = (void**)malloc(sizeof(void*) * set->size);
 	int idx = 0;
 
+	if (set->btree) {
+		for (struct btreeleaf* leaf = set->btree->last; leaf != NULL; leaf = leaf->prev)
+			for (int i = leaf->base.count - 1; i >= 0; --i)
+				result[idx++] = leaf->items[i];
+
+		return result;
+	}
+
 //	// visit function
 //	void visit(void* element, void** result, int i) {
 //		result[i] = element;
@@ -313,21 +423,31 @@ struct arraylist* treeset_toarraylist_range( struct treeset* set, void* from, vo
 											 int hardcopy )
 {
 	struct arraylist* result = arraylist_create();
-    int idx = hardcopy;
+	treeset_compare compare = (set->btree) ? set->btree->compare : set->tree->compare;
+	struct treeset_iter it;
 
-	treeset_inorder_traversal_between( set, set->tree->root, (void*)result,
-									   &idx,
-								       __treeset_range_visitor_default, from, to);
+	for (void* element = treeset_iter_seek(set, from, &it);
+		 element != NULL && compare(element, to) <= 0; element = treeset_iter_next(&it))
+		__treeset_range_visitor_default(set, element, (void*)result, hardcopy);
 
 	return result;
 }
 
 /*
  * Removes elements between a given range.
+ * With the red-black tree backend runs in O(log n + k) (see rbtree_remove_range), the
+ * B+ tree backend deletes elements one by one.
  * Returns number of removed elements.
  * */
 int treeset_remove_range(struct treeset* set, void* from, void* to)
 {
+	if (!set->btree) {
+		// split the range off the tree and join both sides back (no rebalance per element)
+		size_t removed = rbtree_remove_range(set->tree, from, to);
+		set->size -= removed;
+		return (int)removed;
+	}
+
 	int count = 0;	// number of deleted node from tree.
 	// get hard copy because when deleting tree element, address of data can change
 	// and change also arraylist data references that points to same tree node data.
@@ -345,8 +465,9 @@ int treeset_remove_range(struct treeset* set, void* from, void* to)
 
 			if (deleted_value) {
 				count++;
-				if (set->tree->freedata)
-					set->tree->freedata(deleted_value);
+				treeset_freedata freedata = (set->btree) ? set->btree->freedata : set->tree->freedata;
+				if (freedata)
+					freedata(deleted_value);
 			}
 			else {
 				printf("Error: failed to remove element width address '%p' from red-black tree!", cur_element);
@@ -364,27 +485,843 @@ int treeset_remove_range(struct treeset* set, void* from, void* to)
 	return count;
 }
 
+/*
+ * Moves all elements larger than or equal to 'key' to a new set (same backend and
+ * callbacks). With the red-black tree backend runs in O(log n) (see rbtree_split), the
+ * B+ tree backend moves elements one by one.
+ * Returns the new set.
+ * */
+struct treeset* treeset_split_at(struct treeset* set, void* key)
+{
+	struct treeset* result = (struct treeset*)malloc(sizeof(struct treeset));
+	if (!result) {
+		printf("Memory error: failed to allocate memory for treeset!");
+		abort();
+	}
+
+	result->backend = set->backend;
+	if (!set->btree) {
+		result->btree = NULL;
+		result->tree = rbtree_split(set->tree, key);
+		if (!(result->tree)) {
+			printf("Memory error: faile to allocate memory for treeset tree!");
+			abort();
+		}
+
+		result->size = rbtree_nodesize(result->tree->root);
+		set->size -= result->size;
+		return result;
+	}
+
+	struct btree* bt = set->btree;
+	result->tree = NULL;
+	result->btree = btree_create( bt->calcdatasize, bt->compare, bt->freedata,
+								  bt->printdata, bt->copydata );
+
+	struct arraylist* moved = arraylist_create();
+	struct treeset_iter it;
+	for (void* element = treeset_iter_seek(set, key, &it); element != NULL;
+		 element = treeset_iter_next(&it))
+		arraylist_add(moved, element);
+
+	for (int i = 0; i < moved->length; ++i)
+		btree_delete(bt, moved->buffer[i]);
+
+	btree_build_sorted(result->btree, moved->buffer, moved->length);
+	result->size = moved->length;
+	set->size -= moved->length;
+	arraylist_destroy(moved);
+	return result;
+}
+
+/*
+ * Releases the nodes of a set but not its elements.
+ * */
+void treeset_release_nodes(struct treeset* set)
+{
+	treeset_freedata* freedata_p = (set->btree) ? &set->btree->freedata : &set->tree->freedata;
+	treeset_freedata freedata = *freedata_p;
+	*freedata_p = NULL;
+	treeset_clear(set);
+	*freedata_p = freedata;
+}
+
+/*
+ * Moves all elements of 'other' to 'set', 'other' is left empty. Elements of 'other'
+ * already in 'set' are released (freedata).
+ * When both sets use the red-black tree backend sets are merged by split and join (see
+ * rbtree_union): O(log n) when their ranges do not overlap. Otherwise a small 'other'
+ * is added element by element (m log n) and a large one is merged with 'set' in order
+ * and the tree is rebuilt from the merged elements (n + m).
+ * */
+void treeset_union(struct treeset* set, struct treeset* other)
+{
+	if (!set->btree && !other->btree) {
+		rbtree_union(set->tree, other->tree);
+		set->size = rbtree_nodesize(set->tree->root);
+		other->size = 0;
+		return;
+	}
+
+	void** elements = treeset_toarray(other);
+	size_t count = other->size;
+
+	// release nodes of 'other' but not the elements, they are moved
+	treeset_release_nodes(other);
+
+	treeset_freedata setfreedata = (set->btree) ? set->btree->freedata : set->tree->freedata;
+	size_t logn = 0;
+	while ((((size_t)1) << logn) <= set->size)
+		logn++;
+
+	if (count * logn < set->size) {
+		for (size_t i = 0; i < count; ++i) {
+			if (!treeset_contains(set, elements[i]))
+				treeset_add(set, elements[i]);
+			else if (setfreedata)
+				setfreedata(elements[i]);
+		}
+
+		free(elements);
+		return;
+	}
+
+	// merge both sorted arrays on the fly, rebuild the tree in O(n + m)
+	treeset_compare compare = (set->btree) ? set->btree->compare : set->tree->compare;
+	size_t n = set->size;
+	void** mine = treeset_toarray(set);
+	void** merged = (void**)malloc(sizeof(void*) * (n + count + 1));
+	if (!merged) {
+		printf("Memory error: failed to allocate memory for treeset union!");
+		abort();
+	}
+
+	treeset_release_nodes(set);
+	size_t i = 0, j = 0, k = 0;
+	while (i < n && j < count) {
+		int cmp = compare(mine[i], elements[j]);
+		if (cmp < 0)
+			merged[k++] = mine[i++];
+		else if (cmp > 0)
+			merged[k++] = elements[j++];
+		else {
+			merged[k++] = mine[i++];
+			if (setfreedata)
+				setfreedata(elements[j]);
+			j++;
+		}
+	}
+
+	while (i < n)
+		merged[k++] = mine[i++];
+	while (j < count)
+		merged[k++] = elements[j++];
+
+	if (set->btree)
+		btree_build_sorted(set->btree, merged, k);
+	else
+		rbtree_build_sorted(set->tree, merged, k);
+
+	set->size = k;
+	free(merged);
+	free(mine);
+	free(elements);
+}
+
+/*
+ * Creates a new set (backend and callbacks of 'set') with the elements of 'set' that
+ * are also in 'other'. Both sets are walked in order at the same time (one compare per
+ * step); when one set is SORTEDARRAY_GALLOP_RATIO times larger than the other the
+ * larger one is not walked but sought (O(log n)) at each element of the smaller one.
+ * The result is built from the sorted elements in O(k).
+ * If 'hardcopy' is true elements are copied (and released by the new set), otherwise
+ * the new set shares the elements of 'set' and does not release them.
+ * Returns the new set.
+ * */
+struct treeset* treeset_intersect(struct treeset* set, struct treeset* other, int hardcopy)
+{
+	struct treeset* small = (set->size <= other->size) ? set : other;
+	struct treeset* large = (small == set) ? other : set;
+	int skewed = (small->size * SORTEDARRAY_GALLOP_RATIO < large->size);
+	treeset_compare compare = (set->btree) ? set->btree->compare : set->tree->compare;
+
+	struct arraylist* common = arraylist_create();
+	struct treeset_iter its, itl;
+	void* x = treeset_iter_first(small, &its);
+	void* y = NULL;
+	if (x != NULL)
+		y = (skewed) ? treeset_iter_seek(large, x, &itl) : treeset_iter_first(large, &itl);
+
+	while (x != NULL && y != NULL) {
+		int cmp = compare(x, y);
+		if (cmp == 0) {
+			__treeset_range_visitor_default(set, (small == set) ? x : y, (void*)common, hardcopy);
+			x = treeset_iter_next(&its);
+			y = treeset_iter_next(&itl);
+		}
+		else if (cmp < 0)
+			x = treeset_iter_next(&its);
+		else
+			y = (skewed) ? treeset_iter_seek(large, x, &itl) : treeset_iter_next(&itl);
+	}
+
+	struct treeset* result = NULL;
+	if (set->btree) {
+		struct btree* bt = set->btree;
+		result = treeset_create_from_sorted( common->buffer, common->length, bt->calcdatasize,
+											 bt->copydata, bt->compare, bt->printdata,
+											 (hardcopy) ? bt->freedata : NULL, TREESET_BTREE, NULL );
+	}
+	else {
+		struct rbtree* rb = set->tree;
+		result = treeset_create_from_sorted( common->buffer, common->length, rb->calcdatasize,
+											 rb->copydata, rb->compare, rb->printdata,
+											 (hardcopy) ? rb->freedata : NULL, TREESET_RBTREE, NULL );
+	}
+
+	arraylist_destroy(common);
+	return result;
+}
+
+/*
+ * Gets the rank of an element: number of set elements lesser than 'value'.
+ * With the red-black tree backend runs in O(log n) (the first call enables subtree
+ * sizes in O(n), see rbtree_enable_ranks). The B+ tree backend walks its leaves.
+ * */
+size_t treeset_rank(struct treeset* set, void* value)
+{
+	if (set->btree)
+		return btree_rank(set->btree, value, 0);
+
+	rbtree_enable_ranks(set->tree);
+	return rbtree_rank(set->tree, value, 0);
+}
+
+/*
+ * Gets the element at position 'k' (0 based) in ascending order.
+ * Returns NULL if 'k' is out of range. Same cost as treeset_rank.
+ * */
+void* treeset_select(struct treeset* set, size_t k)
+{
+	if (set->btree)
+		return btree_select(set->btree, k);
+
+	rbtree_enable_ranks(set->tree);
+	return rbtree_select(set->tree, k);
+}
+
+/*
+ * Counts the elements between 'from' and 'to' (inclusive), without visiting them.
+ * Same cost as treeset_rank.
+ * */
+size_t treeset_count_range(struct treeset* set, void* from, void* to)
+{
+	size_t upto = 0, below = 0;
+	if (set->btree) {
+		upto = btree_rank(set->btree, to, 1);
+		below = btree_rank(set->btree, from, 0);
+	}
+	else {
+		rbtree_enable_ranks(set->tree);
+		upto = rbtree_rank(set->tree, to, 1);
+		below = rbtree_rank(set->tree, from, 0);
+	}
+
+	return (upto > below) ? upto - below : 0;
+}
+
+/*
+ * Positions cursor at the smallest element.
+ * Returns that element, NULL if set is empty.
+ * */
+void* treeset_iter_first(struct treeset* set, struct treeset_iter* it)
+{
+	it->set = set;
+	if (set->btree) {
+		it->leaf = set->btree->first;
+		it->pos = 0;
+	}
+	else
+		rbtree_iter_first(set->tree, &it->rb);
+
+	return treeset_iter_get(it);
+}
+
+/*
+ * Positions cursor at the largest element.
+ * Returns that element, NULL if set is empty.
+ * */
+void* treeset_iter_last(struct treeset* set, struct treeset_iter* it)
+{
+	it->set = set;
+	if (set->btree) {
+		it->leaf = set->btree->last;
+		it->pos = (it->leaf != NULL) ? it->leaf->base.count - 1 : 0;
+	}
+	else
+		rbtree_iter_last(set->tree, &it->rb);
+
+	return treeset_iter_get(it);
+}
+
+/*
+ * Positions cursor at the smallest element larger than or equal to 'key', in O(log n).
+ * Returns that element, NULL if there is none.
+ * */
+void* treeset_iter_seek(struct treeset* set, const void* key, struct treeset_iter* it)
+{
+	it->set = set;
+	if (set->btree)
+		it->leaf = btree_lowerbound(set->btree, key, &it->pos);
+	else
+		rbtree_iter_seek(set->tree, key, &it->rb);
+
+	return treeset_iter_get(it);
+}
+
+/*
+ * Positions cursor at the largest element lesser than or equal to 'key', in O(log n).
+ * Returns that element, NULL if there is none.
+ * */
+void* treeset_iter_seek_floor(struct treeset* set, const void* key, struct treeset_iter* it)
+{
+	if (!set->btree) {
+		it->set = set;
+		rbtree_iter_seek_floor(set->tree, key, &it->rb);
+		return treeset_iter_get(it);
+	}
+
+	// first element >= key, or the one before it
+	void* element = treeset_iter_seek(set, key, it);
+	if (element == NULL)
+		return treeset_iter_last(set, it);
+
+	if (set->btree->compare(element, key) == 0)
+		return element;
+
+	return treeset_iter_prev(it);
+}
+
+/*
+ * Gets the element at cursor, NULL if there is none.
+ * */
+void* treeset_iter_get(const struct treeset_iter* it)
+{
+	if (it->set->btree)
+		return (it->leaf != NULL) ? it->leaf->items[it->pos] : NULL;
+
+	return rbtree_iter_get(&it->rb);
+}
+
+/*
+ * Moves cursor to the next element.
+ * Returns that element, NULL if cursor moved past the end (it stays there).
+ * */
+void* treeset_iter_next(struct treeset_iter* it)
+{
+	if (!it->set->btree)
+		return rbtree_iter_next(&it->rb);
+
+	if (it->leaf != NULL && ++it->pos == it->leaf->base.count) {
+		it->leaf = it->leaf->next;
+		it->pos = 0;
+	}
+
+	return treeset_iter_get(it);
+}
+
+/*
+ * Moves cursor to the previous element.
+ * Returns that element, NULL if cursor moved past the end (it stays there).
+ * */
+void* treeset_iter_prev(struct treeset_iter* it)
+{
+	if (!it->set->btree)
+		return rbtree_iter_prev(&it->rb);
+
+	if (it->leaf != NULL && --it->pos < 0) {
+		it->leaf = it->leaf->prev;
+		it->pos = (it->leaf != NULL) ? it->leaf->base.count - 1 : 0;
+	}
+
+	return treeset_iter_get(it);
+}
+
+// ordered work split and callbacks of a parallel pass over a treeset
+struct treeset_parallel_state {
+	struct treeset* set;
+	size_t n;								// pieces, in ascending order of elements
+	struct rbtreenode** nodes;				// red-black tree: root of each piece
+	char* whole;							// red-black tree: 1 if piece is the subtree of its root, 0 if only the root
+	struct btreeleaf** leaves;				// B+ tree: first leaf of each piece (n + 1, last one NULL)
+	void (*element)(struct treeset_parallel_state* st, size_t piece, void* element, int worker);
+	treeset_visitfunc visit;				// foreach
+	treeset_accumulate accumulate;			// reduce
+	unsigned char* partials;				// reduce: one result per piece
+	size_t resultsize;
+	struct treeset* other;					// intersect: set sought for each element
+	struct treeset* owner;					// intersect: set whose elements (and callbacks) are kept
+	int keepother;							// intersect: keep the element found in 'other'
+	struct arraylist** common;				// intersect: common elements of each piece
+	int hardcopy;
+	void* arg;
+};
+
+/*
+ * Collects the pieces of a red-black subtree in order: subtrees at 'depth' and each
+ * node above them on its own.
+ * Note: Private function.
+ * */
+void treeset_parallel_split_rbtree(struct treeset_parallel_state* st, struct rbtreenode* node, int depth)
+{
+	if (node == NULL)
+		return;
+
+	if (depth == 0) {
+		st->nodes[st->n] = node;
+		st->whole[st->n++] = 1;
+		return;
+	}
+
+	treeset_parallel_split_rbtree(st, node->left, depth - 1);
+	st->nodes[st->n] = node;
+	st->whole[st->n++] = 0;
+	treeset_parallel_split_rbtree(st, node->right, depth - 1);
+}
+
+/*
+ * Counts the nodes of a B+ subtree at 'depth' (leaves if it is not that deep).
+ * Note: Private function.
+ * */
+size_t treeset_parallel_count_btree(const struct btreenode* node, int depth)
+{
+	if ((depth == 0) || node->leaf)
+		return 1;
+
+	const struct btreeinner* inner = (const struct btreeinner*)node;
+	size_t result = 0;
+	for (int i = 0; i <= inner->base.count; ++i)
+		result += treeset_parallel_count_btree(inner->children[i], depth - 1);
+
+	return result;
+}
+
+/*
+ * Collects the pieces of a B+ subtree in order: the first leaf of each subtree at
+ * 'depth' (a piece ends at the first leaf of the next one).
+ * Note: Private function.
+ * */
+void treeset_parallel_split_btree(struct treeset_parallel_state* st, struct btreenode* node, int depth)
+{
+	if ((depth == 0) || node->leaf) {
+		while (!node->leaf)
+			node = ((struct btreeinner*)node)->children[0];
+
+		st->leaves[st->n++] = (struct btreeleaf*)node;
+		return;
+	}
+
+	struct btreeinner* inner = (struct btreeinner*)node;
+	for (int i = 0; i <= inner->base.count; ++i)
+		treeset_parallel_split_btree(st, inner->children[i], depth - 1);
+}
+
+/*
+ * Splits the set in about 8 ordered pieces per thread of 'pool', following the tree:
+ * subtrees of the red-black tree at the depth with enough of them (plus the nodes
+ * above), subtrees of the B+ tree at the first level with enough nodes.
+ * Note: Private function.
+ * */
+void treeset_parallel_split(struct taskpool* pool, struct treeset_parallel_state* st)
+{
+	size_t target = 8 * (size_t)taskpool_getthreads(pool);
+	st->n = 0;
+
+	if (st->set->btree) {
+		struct btree* bt = st->set->btree;
+		int depth = 0;
+		size_t count = (bt->root != NULL) ? 1 : 0;
+		while ((count > 0) && (count < target) && (depth < bt->height - 1))
+			count = treeset_parallel_count_btree(bt->root, ++depth);
+
+		st->leaves = (struct btreeleaf**)malloc((count + 1) * sizeof(struct btreeleaf*));
+		if (st->leaves == NULL) {
+			printf("Memory error: failed to allocate memory for parallel treeset pass!\n");
+			abort();
+		}
+
+		if (count > 0)
+			treeset_parallel_split_btree(st, bt->root, depth);
+
+		st->leaves[st->n] = NULL;
+	}
+	else {
+		int depth = 0;
+		while ((depth < 20) && (((size_t)1 << depth) < target))
+			depth++;
+
+		size_t count = ((size_t)1 << (depth + 1));	// subtrees plus nodes above them
+		st->nodes = (struct rbtreenode**)malloc(count * sizeof(struct rbtreenode*));
+		st->whole = (char*)malloc(count);
+		if ((st->nodes == NULL) || (st->whole == NULL)) {
+			printf("Memory error: failed to allocate memory for parallel treeset pass!\n");
+			abort();
+		}
+
+		treeset_parallel_split_rbtree(st, st->set->tree->root, depth);
+	}
+}
+
+/*
+ * Work item of a parallel pass: walks the elements of one piece in order.
+ * The item is the piece number plus one (work items can not be NULL).
+ * Note: Private function.
+ * */
+void treeset_parallel_task(struct taskpool* pool, void* item, int worker, void* arg)
+{
+	struct treeset_parallel_state* st = (struct treeset_parallel_state*)arg;
+	size_t piece = (size_t)item - 1;
+
+	if (st->set->btree) {
+		for (struct btreeleaf* leaf = st->leaves[piece]; leaf != st->leaves[piece + 1]; leaf = leaf->next)
+			for (int i = 0; i < leaf->base.count; ++i)
+				st->element(st, piece, leaf->items[i], worker);
+
+		return;
+	}
+
+	struct rbtreenode* root = st->nodes[piece];
+	if (!st->whole[piece]) {
+		st->element(st, piece, root->data, worker);
+		return;
+	}
+
+	// in order walk of the subtree with parent links
+	struct rbtreenode* node = root;
+	while (node->left != NULL)
+		node = node->left;
+
+	while (node != NULL) {
+		st->element(st, piece, node->data, worker);
+
+		if (node->right != NULL) {
+			node = node->right;
+			while (node->left != NULL)
+				node = node->left;
+		}
+		else {
+			while ((node != root) && (node->parent->right == node))
+				node = node->parent;
+
+			node = (node == root) ? NULL : node->parent;
+		}
+	}
+}
+
+/*
+ * Runs a parallel pass over the pieces of the set and releases them.
+ * Note: Private function.
+ * */
+void treeset_parallel_run(struct taskpool* pool, struct treeset_parallel_state* st)
+{
+	void** items = (void**)malloc((st->n + 1) * sizeof(void*));
+	if (items == NULL) {
+		printf("Memory error: failed to allocate memory for parallel treeset pass!\n");
+		abort();
+	}
+
+	for (size_t i = 0; i < st->n; ++i)
+		items[i] = (void*)(i + 1);
+
+	taskpool_run(pool, treeset_parallel_task, st, items, st->n);
+	free(items);
+}
+
+/*
+ * Releases the pieces of a parallel pass.
+ * Note: Private function.
+ * */
+void treeset_parallel_release(struct treeset_parallel_state* st)
+{
+	free(st->nodes);
+	free(st->whole);
+	free(st->leaves);
+}
+
+/*
+ * Element callbacks of the parallel passes.
+ * Note: Private functions.
+ * */
+void treeset_parallel_visit(struct treeset_parallel_state* st, size_t piece, void* element, int worker)
+{
+	st->visit(element, worker, st->arg);
+}
+
+void treeset_parallel_accumulate(struct treeset_parallel_state* st, size_t piece, void* element, int worker)
+{
+	st->accumulate(st->partials + piece * st->resultsize, element, st->arg);
+}
+
+void treeset_parallel_common(struct treeset_parallel_state* st, size_t piece, void* element, int worker)
+{
+	struct treeset* other = st->other;
+	void* found = NULL;
+	if (other->btree)
+		found = btree_search(other->btree, element);
+	else {
+		struct rbtreenode* node = rbtree_search(other->tree, other->tree->root, element);
+		found = (node != NULL) ? node->data : NULL;
+	}
+
+	if (found != NULL)
+		__treeset_range_visitor_default( st->owner, (st->keepother) ? found : element,
+										 (void*)st->common[piece], st->hardcopy );
+}
+
+/*
+ * Calls 'visit' for every element, concurrently on the threads of 'pool': the tree
+ * is split in about 8 subtrees per thread (see treeset_parallel_reduce), each one a
+ * work item walked in order, and idle workers steal the remaining ones.
+ * Note: the set must not be changed during the traversal.
+ * */
+void treeset_parallel_foreach(struct taskpool* pool, struct treeset* set, treeset_visitfunc visit, void* arg)
+{
+	struct treeset_parallel_state st = { .set = set, .element = treeset_parallel_visit, .visit = visit, .arg = arg };
+	treeset_parallel_split(pool, &st);
+	treeset_parallel_run(pool, &st);
+	treeset_parallel_release(&st);
+}
+
+/*
+ * Reduces the elements to 'result' ('resultsize' bytes) on the threads of 'pool'.
+ * The set is split by subtree in about 8 ordered pieces per thread; each piece starts
+ * with a copy of 'result' (the identity value on input) and 'accumulate' adds its
+ * elements in ascending order. Piece results are then added to 'result' in order
+ * with 'combine', so the operation only needs to be associative (not commutative).
+ * Note: the set must not be changed during the reduction.
+ * */
+void treeset_parallel_reduce( struct taskpool* pool, struct treeset* set, void* result, size_t resultsize,
+							  treeset_accumulate accumulate, treeset_combine combine, void* arg )
+{
+	struct treeset_parallel_state st = { .set = set, .element = treeset_parallel_accumulate,
+										 .accumulate = accumulate, .resultsize = resultsize, .arg = arg };
+	treeset_parallel_split(pool, &st);
+
+	st.partials = (unsigned char*)malloc(st.n * resultsize + 1);
+	if (st.partials == NULL) {
+		printf("Memory error: failed to allocate memory for parallel treeset reduce!\n");
+		abort();
+	}
+
+	for (size_t i = 0; i < st.n; ++i)
+		memcpy(st.partials + i * resultsize, result, resultsize);
+
+	treeset_parallel_run(pool, &st);
+	for (size_t i = 0; i < st.n; ++i)
+		combine(result, st.partials + i * resultsize, arg);
+
+	free(st.partials);
+	treeset_parallel_release(&st);
+}
+
+/*
+ * Moves all elements of 'other' to 'set' like treeset_union. With the red-black tree
+ * backend in both sets the join based union runs on the threads of 'pool' (see
+ * rbtree_parallel_union); B+ tree sets are merged as in treeset_union.
+ * */
+void treeset_parallel_union(struct taskpool* pool, struct treeset* set, struct treeset* other)
+{
+	if (set->btree || other->btree) {
+		treeset_union(set, other);
+		return;
+	}
+
+	rbtree_parallel_union(pool, set->tree, other->tree);
+	set->size = rbtree_nodesize(set->tree->root);
+	other->size = 0;
+}
+
+/*
+ * Creates a new set with the elements of 'set' that are also in 'other', like
+ * treeset_intersect, on the threads of 'pool': the smaller set is split by subtree
+ * in ordered pieces, each element of a piece is sought in the larger set and the
+ * pieces of common elements are joined in order and built in O(k).
+ * Returns the new set.
+ * */
+struct treeset* treeset_parallel_intersect( struct taskpool* pool, struct treeset* set, struct treeset* other,
+											int hardcopy )
+{
+	struct treeset* small = (set->size <= other->size) ? set : other;
+	struct treeset* large = (small == set) ? other : set;
+	struct treeset_parallel_state st = { .set = small, .element = treeset_parallel_common, .other = large,
+										 .owner = set, .keepother = (small != set), .hardcopy = hardcopy };
+	treeset_parallel_split(pool, &st);
+
+	st.common = (struct arraylist**)malloc((st.n + 1) * sizeof(struct arraylist*));
+	if (st.common == NULL) {
+		printf("Memory error: failed to allocate memory for parallel treeset intersect!\n");
+		abort();
+	}
+
+	for (size_t i = 0; i < st.n; ++i)
+		st.common[i] = arraylist_create();
+
+	treeset_parallel_run(pool, &st);
+
+	size_t count = 0;
+	for (size_t i = 0; i < st.n; ++i)
+		count += st.common[i]->length;
+
+	void** items = (void**)malloc((count + 1) * sizeof(void*));
+	if (items == NULL) {
+		printf("Memory error: failed to allocate memory for parallel treeset intersect!\n");
+		abort();
+	}
+
+	count = 0;
+	for (size_t i = 0; i < st.n; ++i) {
+		memcpy(items + count, st.common[i]->buffer, st.common[i]->length * sizeof(void*));
+		count += st.common[i]->length;
+		arraylist_destroy(st.common[i]);
+	}
+
+	struct treeset* result = NULL;
+	if (set->btree) {
+		struct btree* bt = set->btree;
+		result = treeset_create_from_sorted( items, count, bt->calcdatasize, bt->copydata, bt->compare,
+											 bt->printdata, (hardcopy) ? bt->freedata : NULL, TREESET_BTREE, NULL );
+	}
+	else {
+		struct rbtree* rb = set->tree;
+		result = treeset_create_from_sorted( items, count, rb->calcdatasize, rb->copydata, rb->compare,
+											 rb->printdata, (hardcopy) ? rb->freedata : NULL, TREESET_RBTREE, NULL );
+	}
+
+	free(items);
+	free(st.common);
+	treeset_parallel_release(&st);
+	return result;
+}
+
+/*
+ * Saves the treeset to a snapshot file (see snapshot.h): one record per element,
+ * written by codec->encodekey in ascending order (codec values are not used).
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int treeset_save(struct treeset* set, const char* path, const struct snapshot_codec* codec)
+{
+	struct snapshot_codec keys = *codec;
+	keys.encodevalue = NULL;
+
+	struct snapshot_writer w;
+	if (!snapshot_writer_open(&w, path, SNAPSHOT_MAGIC_TREESET))
+		return 0;
+
+	struct treeset_iter it;
+	for (void* e = treeset_iter_first(set, &it); e != NULL; e = treeset_iter_next(&it))
+		snapshot_write_record(&w, &keys, 0, e, NULL);
+
+	return snapshot_writer_close(&w);
+}
+
+/*
+ * Loads a treeset saved with 'treeset_save'. Elements are decoded in one sequential
+ * pass and the tree is built from them in O(n) (see treeset_create_from_sorted); if
+ * they are not in ascending order of 'comparefunc' (saved with other order) they are
+ * added one by one. The set owns 'arena' (see treeset_create), also when failing.
+ * Returns the new treeset or NULL if the file can not be read or is not a valid
+ * treeset snapshot.
+ * */
+struct treeset* treeset_load( const char* path, const struct snapshot_codec* codec,
+							  treeset_calcelementsize calcelementsizefunc,
+							  treeset_copyelement copyelementfunc,
+							  treeset_compare comparefunc,
+							  treeset_printelement printelementfunc,
+							  treeset_freedata freedatafunc,
+							  treeset_backend backend,
+							  struct nodearena* arena )
+{
+	struct snapshot_image img;
+	void** items = NULL;
+	size_t n = 0;
+
+	if (snapshot_image_open(&img, path, SNAPSHOT_MAGIC_TREESET, 1)) {
+		const struct snapshot_fileheader* h = img.header;
+		// every record takes at least its header, so a larger count is a corrupt file
+		if (h->count <= (h->filesize - h->recordspos) / sizeof(struct snapshot_record))
+			items = (void**)malloc((h->count + 1) * sizeof(void*));
+
+		uint64_t pos = h->recordspos;
+		for (; (items != NULL) && (n < h->count); ++n) {
+			const struct snapshot_record* rec = snapshot_image_record(&img, pos);
+			if (rec == NULL)
+				break;		// corrupt file
+
+			items[n] = codec->decodekey(rec->data, rec->keysize, codec->arg);
+			pos = snapshot_record_next(rec, pos);
+		}
+
+		if ((items != NULL) && (n < h->count)) {
+			if (freedatafunc != NULL)
+				for (size_t i = 0; i < n; ++i)
+					freedatafunc(items[i]);
+
+			free(items);
+			items = NULL;
+		}
+
+		snapshot_image_close(&img);
+	}
+
+	if (items == NULL) {
+		if (arena != NULL)
+			nodearena_destroy(arena);
+
+		return NULL;
+	}
+
+	// a failed build releases the set and its arena reference
+	struct treeset* result = treeset_create_from_sorted( items, n, calcelementsizefunc, copyelementfunc,
+														 comparefunc, printelementfunc, freedatafunc,
+														 backend, (arena != NULL) ? nodearena_retain(arena) : NULL );
+	if (result != NULL) {
+		if (arena != NULL)
+			nodearena_destroy(arena);
+	}
+	else {
+		result = treeset_create( calcelementsizefunc, copyelementfunc, comparefunc,
+								 printelementfunc, freedatafunc, backend, arena );
+		for (size_t i = 0; i < n; ++i)
+			treeset_add(result, items[i]);
+	}
+
+	free(items);
+	return result;
+}
+
 /*
  * Prints treeset elements.
  */
 void treeset_print(struct treeset* set, int reverse)
 {
-	if (!set->tree->printdata) {
+	treeset_printelement printdata = (set->btree) ? set->btree->printdata : set->tree->printdata;
+	if (!printdata) {
 		printf("Error: 'printdata' function is undefined. Can't print set.");
 		abort();
 	}
 
-	void** asc = (reverse) ? treeset_toarray_desc(set) : treeset_toarray(set);
+	struct treeset_iter it;
+	void* element = (reverse) ? treeset_iter_last(set, &it) : treeset_iter_first(set, &it);
 	printf("{ ");
-	for (int i = 0; i < set->size; ++i) {
-		set->tree->printdata(asc[i]);
+	while (element != NULL) {
+		printdata(element);
 
-		if (i < (set->size-1))
+		element = (reverse) ? treeset_iter_prev(&it) : treeset_iter_next(&it);
+		if (element != NULL)
 			printf("; ");
 	}
 
 	printf(" }\n");
-	free(asc);
 }
 
 /*
@@ -392,7 +1329,11 @@ void treeset_print(struct treeset* set, int reverse)
  * */
 void treeset_clear(struct treeset* set)
 {
-	rbtree_clear( set->tree );
+	if (set->btree)
+		btree_clear( set->btree );
+	else
+		rbtree_clear( set->tree );
+
 	set->size = 0;
 }
 
@@ -401,7 +1342,11 @@ void treeset_clear(struct treeset* set)
  * */
 void treeset_destroy(struct treeset* set)
 {
-	rbtree_destroy( set->tree );
+	if (set->btree)
+		btree_destroy( set->btree );
+	else
+		rbtree_destroy( set->tree );
+
 	free(set);
 }
 
@@ -29,12 +29,29 @@
  * self-balancing binary search tree (Red-Black Tree). TreeSet is backed by TreeMap in
  * Java.
  *
+ * 2. Backends
+ *
+ * The set can be backed by a red-black tree (TREESET_RBTREE, one node per element) or by
+ * a B+ tree (TREESET_BTREE, up to 61 elements per 512 byte node, see btree.h). For large
+ * sets the B+ tree touches far fewer cache lines per lookup, keeps elements of a range
+ * in contiguous leaf arrays and allocates one node per ~45 elements. Both backends
+ * support the same operations.
+ *
+ * 3. Order statistics
+ *
+ * treeset_rank, treeset_select and treeset_count_range answer "how many elements are
+ * lesser than x", "which is the k-th element" and "how many elements are in [a, b]".
+ * The red-black tree keeps the size of each subtree once ranks are used, so they run
+ * in O(log n) instead of walking the elements in order.
+ *
  */
 
 #ifndef TREESET_H_
 	#define TREESET_H_
 
 	#include "redblacktree.h"
+	#include "btree.h"
+	#include "snapshot.h"
 
 	// the two next functions are used internally by the red-black tree
 	typedef rbtree_calcdatasize treeset_calcelementsize; // function to calc size in bytes of an element
@@ -44,24 +61,59 @@
 	typedef rbtree_printdata treeset_printelement;		 // function to print an element
 //	typedef void (*treeset_printelement)(const void* element); // function to print an element.
 	typedef rbtree_freedata treeset_freedata;			 // function to release an element from memory
+	typedef rbtree_visitfunc treeset_visitfunc;			 // callback of parallel traversals (see treeset_parallel_foreach)
+
+	// callbacks of a parallel reduction (see treeset_parallel_reduce): add an element to
+	// a partial result, add a partial result to the result
+	typedef void (*treeset_accumulate)(void* partial, void* element, void* arg);
+	typedef void (*treeset_combine)(void* result, const void* partial, void* arg);
 
 	// visit function for treeset traversal functions
 	typedef void (*treeset_visit)(void* element, void** result, int index);
 
+	// tree used to store set elements
+	typedef enum {
+		TREESET_RBTREE = 0,		// red-black tree
+		TREESET_BTREE = 1		// B+ tree
+	} treeset_backend;
+
 	struct treeset {
-		struct rbtree* tree;
+		treeset_backend backend;
+		struct rbtree* tree;	// red-black tree (NULL with B+ tree backend)
+		struct btree* btree;	// B+ tree (NULL with red-black tree backend)
 		size_t size;
 	};
 
 	/*
-	 * Function to create a new treeset.
+	 * Function to create a new treeset backed by the given tree type.
+	 * If 'arena' is not NULL red-black tree nodes are allocated from it
+	 * (e.g. nodearena_create(sizeof(struct rbtreenode), 0)); the set owns the arena.
+	 * The B+ tree backend does not use an arena (must be NULL).
 	 * Returns pointer to created treeset instance is succeeded, NULL otherwise.
 	 */
 	struct treeset* treeset_create( treeset_calcelementsize calcelementsizefunc,
 									treeset_copyelement copyelementfunc,
 									treeset_compare comparefunc,
 									treeset_printelement printelementfunc,
-									treeset_freedata freedatafunc );
+									treeset_freedata freedatafunc,
+									treeset_backend backend,
+									struct nodearena* arena );
+
+	/*
+	 * Function to create a new treeset from 'n' elements sorted in strictly ascending
+	 * order, in O(n) (see rbtree_build_sorted and btree_build_sorted): much faster than
+	 * adding them one by one, no compares other than the order check and no rebalances.
+	 * Returns pointer to created treeset instance is succeeded, NULL if elements are
+	 * not sorted.
+	 */
+	struct treeset* treeset_create_from_sorted( void** items, size_t n,
+												treeset_calcelementsize calcelementsizefunc,
+												treeset_copyelement copyelementfunc,
+												treeset_compare comparefunc,
+												treeset_printelement printelementfunc,
+												treeset_freedata freedatafunc,
+												treeset_backend backend,
+												struct nodearena* arena );
 
 	/*
 	 * Returns the number of elements in the treeset.
@@ -104,6 +156,8 @@
 	 * Time Complexity: O(H), where H is the height of the tree
 	 * Auxiliary Space: O(1)
 	 *
+	 * 'root' is the red-black subtree to search (ex: set->tree->root), it is ignored by
+	 * the B+ tree backend.
 	 * Returns NULL if set is empty.
 	 * */
 	void* treeset_floor(struct treeset* set, struct rbtreenode* root, void* key);
@@ -115,6 +169,8 @@
 	 * Time Complexity: O(H), where H is the height of the tree
 	 * Auxiliary Space: O(1)
 	 *
+	 * 'root' is the red-black subtree to search (ex: set->tree->root), it is ignored by
+	 * the B+ tree backend.
 	 * Returns NULL if set is empty.
 	 * */
 	void* treeset_ceiling(struct treeset* set, struct rbtreenode* root, void* key);
@@ -140,10 +196,166 @@
 
 	/*
 	 * Removes elements between a given range.
+	 * With the red-black tree backend runs in O(log n + k) (see rbtree_remove_range), the
+	 * B+ tree backend deletes elements one by one.
 	 * Returns number of removed elements.
 	 * */
 	int treeset_remove_range(struct treeset* set, void* from, void* to);
 
+	/*
+	 * Moves all elements larger than or equal to 'key' to a new set (same backend and
+	 * callbacks). With the red-black tree backend runs in O(log n) (see rbtree_split), the
+	 * B+ tree backend moves elements one by one.
+	 * Returns the new set.
+	 * */
+	struct treeset* treeset_split_at(struct treeset* set, void* key);
+
+	/*
+	 * Moves all elements of 'other' to 'set', 'other' is left empty. Elements of 'other'
+	 * already in 'set' are released (freedata).
+	 * When both sets use the red-black tree backend sets are merged by split and join (see
+	 * rbtree_union): O(log n) when their ranges do not overlap. Otherwise a small 'other'
+	 * is added element by element (m log n) and a large one is merged with 'set' in order
+	 * and the tree is rebuilt from the merged elements (n + m).
+	 * */
+	void treeset_union(struct treeset* set, struct treeset* other);
+
+	/*
+	 * Creates a new set (backend and callbacks of 'set') with the elements of 'set' that
+	 * are also in 'other'. Both sets are walked in order at the same time (one compare per
+	 * step); when one set is SORTEDARRAY_GALLOP_RATIO times larger than the other the
+	 * larger one is not walked but sought (O(log n)) at each element of the smaller one.
+	 * The result is built from the sorted elements in O(k).
+	 * If 'hardcopy' is true elements are copied (and released by the new set), otherwise
+	 * the new set shares the elements of 'set' and does not release them.
+	 * Returns the new set.
+	 * */
+	struct treeset* treeset_intersect(struct treeset* set, struct treeset* other, int hardcopy);
+
+	/*
+	 * Gets the rank of an element: number of set elements lesser than 'value'.
+	 * With the red-black tree backend runs in O(log n) (the first call enables subtree
+	 * sizes in O(n), see rbtree_enable_ranks). The B+ tree backend walks its leaves.
+	 * */
+	size_t treeset_rank(struct treeset* set, void* value);
+
+	/*
+	 * Gets the element at position 'k' (0 based) in ascending order.
+	 * Returns NULL if 'k' is out of range. Same cost as treeset_rank.
+	 * */
+	void* treeset_select(struct treeset* set, size_t k);
+
+	/*
+	 * Counts the elements between 'from' and 'to' (inclusive), without visiting them.
+	 * Same cost as treeset_rank.
+	 * */
+	size_t treeset_count_range(struct treeset* set, void* from, void* to);
+
+	/*
+	 * In order cursor over set elements: streams a range without copying it,
+	 * with O(1) memory, and can stop at any point.
+	 *
+	 *   struct treeset_iter it;
+	 *   for (void* e = treeset_iter_seek(set, from, &it); e && compare(e, to) <= 0;
+	 *        e = treeset_iter_next(&it)) ...
+	 *
+	 * Note: cursor is invalid after the set is changed.
+	 * */
+	struct treeset_iter {
+		struct treeset* set;
+		struct rbtree_iter rb;		// red-black tree backend position
+		struct btreeleaf* leaf;		// B+ tree backend position (NULL: no current element)
+		int pos;
+	};
+
+	/*
+	 * Positions cursor at the smallest/largest element.
+	 * Returns that element, NULL if set is empty.
+	 * */
+	void* treeset_iter_first(struct treeset* set, struct treeset_iter* it);
+	void* treeset_iter_last(struct treeset* set, struct treeset_iter* it);
+
+	/*
+	 * Positions cursor at the smallest element larger than or equal to 'key'
+	 * (treeset_iter_seek) or at the largest element lesser than or equal to 'key'
+	 * (treeset_iter_seek_floor), in O(log n).
+	 * Returns that element, NULL if there is none.
+	 * */
+	void* treeset_iter_seek(struct treeset* set, const void* key, struct treeset_iter* it);
+	void* treeset_iter_seek_floor(struct treeset* set, const void* key, struct treeset_iter* it);
+
+	/*
+	 * Gets the element at cursor, NULL if there is none.
+	 * */
+	void* treeset_iter_get(const struct treeset_iter* it);
+
+	/*
+	 * Moves cursor to the next/previous element.
+	 * Returns that element, NULL if cursor moved past the end (it stays there).
+	 * */
+	void* treeset_iter_next(struct treeset_iter* it);
+	void* treeset_iter_prev(struct treeset_iter* it);
+
+	/*
+	 * Calls 'visit' for every element, concurrently on the threads of 'pool': the tree
+	 * is split in about 8 subtrees per thread (see treeset_parallel_reduce), each one a
+	 * work item walked in order, and idle workers steal the remaining ones.
+	 * Note: the set must not be changed during the traversal.
+	 * */
+	void treeset_parallel_foreach(struct taskpool* pool, struct treeset* set, treeset_visitfunc visit, void* arg);
+
+	/*
+	 * Reduces the elements to 'result' ('resultsize' bytes) on the threads of 'pool'.
+	 * The set is split by subtree in about 8 ordered pieces per thread; each piece starts
+	 * with a copy of 'result' (the identity value on input) and 'accumulate' adds its
+	 * elements in ascending order. Piece results are then added to 'result' in order
+	 * with 'combine', so the operation only needs to be associative (not commutative).
+	 * Note: the set must not be changed during the reduction.
+	 * */
+	void treeset_parallel_reduce( struct taskpool* pool, struct treeset* set, void* result, size_t resultsize,
+								  treeset_accumulate accumulate, treeset_combine combine, void* arg );
+
+	/*
+	 * Moves all elements of 'other' to 'set' like treeset_union. With the red-black tree
+	 * backend in both sets the join based union runs on the threads of 'pool' (see
+	 * rbtree_parallel_union); B+ tree sets are merged as in treeset_union.
+	 * */
+	void treeset_parallel_union(struct taskpool* pool, struct treeset* set, struct treeset* other);
+
+	/*
+	 * Creates a new set with the elements of 'set' that are also in 'other', like
+	 * treeset_intersect, on the threads of 'pool': the smaller set is split by subtree
+	 * in ordered pieces, each element of a piece is sought in the larger set and the
+	 * pieces of common elements are joined in order and built in O(k).
+	 * Returns the new set.
+	 * */
+	struct treeset* treeset_parallel_intersect( struct taskpool* pool, struct treeset* set, struct treeset* other,
+												int hardcopy );
+
+	/*
+	 * Saves the treeset to a snapshot file (see snapshot.h): one record per element,
+	 * written by codec->encodekey in ascending order (codec values are not used).
+	 * Returns 1 if succeeded, 0 otherwise.
+	 * */
+	int treeset_save(struct treeset* set, const char* path, const struct snapshot_codec* codec);
+
+	/*
+	 * Loads a treeset saved with 'treeset_save'. Elements are decoded in one sequential
+	 * pass and the tree is built from them in O(n) (see treeset_create_from_sorted); if
+	 * they are not in ascending order of 'comparefunc' (saved with other order) they are
+	 * added one by one. The set owns 'arena' (see treeset_create), also when failing.
+	 * Returns the new treeset or NULL if the file can not be read or is not a valid
+	 * treeset snapshot.
+	 * */
+	struct treeset* treeset_load( const char* path, const struct snapshot_codec* codec,
+								  treeset_calcelementsize calcelementsizefunc,
+								  treeset_copyelement copyelementfunc,
+								  treeset_compare comparefunc,
+								  treeset_printelement printelementfunc,
+								  treeset_freedata freedatafunc,
+								  treeset_backend backend,
+								  struct nodearena* arena );
+
 	/*
 	 * Prints treeset elements.
 	 */
@@ -132,6 +132,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include "trie.h"
+#include "snapshot.h"
 
 /*
  * Default function to get array index for a given char.
@@ -159,7 +160,8 @@ unsigned char trie_getchar_default(unsigned int index) {
  struct trienode* trie_create_node(struct trie* t)
  {
 	 // must reserve space to flexible array
- 	 struct trienode* result = (struct trienode*)malloc(sizeof(*result) + t->array_size * sizeof(struct trienode));
+ 	 struct trienode* result = (struct trienode*)allocator_alloc( t->allocator,
+ 			 sizeof(*result) + t->array_size * sizeof(struct trienode*) );
  	 if (!result) {
  		 printf("Memory error: failed to allocate memory for trienode structure!");
  		 abort();
@@ -170,34 +172,56 @@ unsigned char trie_getchar_default(unsigned int index) {
 			result->children[i] = NULL;
 		}
 		result->terminal = false;	// no word terminates here by now
+		result->weight = 0;
+		result->maxweight = 0;
  	 }
 
  	 return result;
  }
 
+/*
+ * Releases a trienode.
+ * Note: Private function.
+ */
+void trie_free_node(struct trie* t, struct trienode* node)
+{
+	allocator_free(t->allocator, node, sizeof(*node) + t->array_size * sizeof(struct trienode*));
+}
+
 /*
  * Creates a trie instance.
  */
 struct trie* trie_create_trie( size_t num_chars, trie_getindex getindexfunc,
 							   trie_getchar getcharfunc )
 {
-	 struct trie* result = (struct trie*)malloc(sizeof(*result));
+	return trie_create_allocator(num_chars, getindexfunc, getcharfunc, NULL);
+}
+
+/*
+ * Creates a trie instance whose structure and nodes are allocated by 'allocator'
+ * (see allocator.h, NULL: C library).
+ */
+struct trie* trie_create_allocator( size_t num_chars, trie_getindex getindexfunc,
+									trie_getchar getcharfunc, const struct allocator* allocator )
+{
+	 struct trie* result = (struct trie*)allocator_alloc(allocator, sizeof(*result));
 	 if (!result) {
 		 printf("Memory error: failed to allocate memory for trienode structure!");
 		 abort();
 	 }
 	 else {
 		 result->array_size = num_chars;	// important: set before create root node
+		 result->allocator = allocator;
 
 		 // create trie root node
 		 struct trienode* rootnode = trie_create_node(result);
 		 if (!rootnode) {
 			 printf("Memory error: failed to allocate memory for trienode structure!");
-			 free(result);
+			 allocator_free(allocator, result, sizeof(*result));
 			 abort();
 		 }
 		 else {
-			 result->root = (void*)malloc(sizeof(void*));
+			 result->root = (void*)allocator_alloc(allocator, sizeof(void*));
 			 *(result->root) = rootnode;
 			 result->getindex = getindexfunc ? getindexfunc : trie_getindex_default;
 			 result->getchar = getcharfunc ? getcharfunc : trie_getchar_default;
@@ -326,8 +350,6 @@ bool trie_delete(struct trie* t, char* signedtext)
 	// onto the lookup table.
 	unsigned char* text = (unsigned char*)signedtext;
 	int len = strlen(signedtext);
-	struct trienode* removallist[255];	// should be max size of a word
-	int count = 0;						// count number of nodes after last shared node
 	int pos = 0;
 	int index = 0;
 
@@ -337,8 +359,9 @@ bool trie_delete(struct trie* t, char* signedtext)
 		if (currentnode->children[index] == NULL)
 			return false;	// word not exist in the trie
 
-		// if is not a shared node add to removal list
-		if (trie_has_more_than_one_children(currentnode, t->array_size)) {
+		// last node to keep: shared by other words or end of a shorter word
+		if (trie_has_more_than_one_children(currentnode, t->array_size) ||
+			currentnode->terminal) {
 			pos = i;
 			branchnode = currentnode;
 		}
@@ -354,27 +377,28 @@ bool trie_delete(struct trie* t, char* signedtext)
 		if (!trie_has_less_than_x_children(currentnode, 1, t->array_size)) {
 			// case 1: word is a prefix of other words
 			currentnode->terminal = false;	// to remove just turn flag to false
+			currentnode->weight = 0;
 		}
 		else {
+			// remove all trie nodes after last shared node
 			currentnode = branchnode;
 			struct trienode* delnode = NULL;
 			for (int i = pos; i < len; ++i) {
 				index = t->getindex(text[i]);
 				delnode = currentnode->children[index];
-				removallist[count++] = delnode;
 				currentnode->children[index] = NULL;	// clean index
+				if (i > pos)
+					trie_free_node(t, currentnode);
+
 				currentnode = delnode;
 			}
 
-			// remove all trie nodes after last shared node
-			// remove nodes from list
-			for (int i = count - 1; i > -1; --i)
-				free(removallist[i]);
+			trie_free_node(t, currentnode);
 
 			// check if trie is empty
 			currentnode = *(t->root);
 			if (trie_has_less_than_x_children(currentnode, 1, t->array_size)) {
-				free(currentnode);
+				trie_free_node(t, currentnode);
 				*(t->root) = NULL;
 			}
 		}
@@ -435,7 +459,7 @@ bool trie_destroy_children_rec(struct trie* t, struct trienode* node) {//, struc
 				if (trie_destroy_children_rec(t, node->children[i])) {
 					struct trienode* delnode = node->children[i];
 					node->children[i] = NULL;
-					free(delnode);
+					trie_free_node(t, delnode);
 				}
 
 		return (trie_has_less_than_x_children(node, 1, t->array_size));
@@ -450,7 +474,120 @@ bool trie_destroy_children_rec(struct trie* t, struct trienode* node) {//, struc
 void trie_destroy(struct trie* t) {
 	if (*(t->root))
 		if (trie_destroy_children_rec(t, *(t->root)))
-			free(*(t->root));	// free parent node
-	free(t->root);	// free pointer to root trienode**
-	free(t);
+			trie_free_node(t, *(t->root));	// free parent node
+	allocator_free(t->allocator, t->root, sizeof(void*));	// free pointer to root trienode**
+	allocator_free(t->allocator, t, sizeof(*t));
+}
+
+/*
+ * Writes the nodes of a subtree in preorder (see struct trie_snapshotnode).
+ * Returns the number of written nodes.
+ */
+size_t trie_save_rec(const struct trie* t, const struct trienode* node, struct snapshot_writer* w)
+{
+	uint32_t children[t->array_size > 0 ? t->array_size : 1];
+	struct trie_snapshotnode rec = { node->weight, node->maxweight, node->terminal, 0 };
+
+	for (size_t i = 0; i < t->array_size; ++i)
+		if (node->children[i] != NULL)
+			children[rec.numchildren++] = (uint32_t)i;
+
+	snapshot_write(w, &rec, sizeof(rec));
+	snapshot_write(w, children, rec.numchildren * sizeof(uint32_t));
+
+	size_t count = 1;
+	for (uint32_t i = 0; i < rec.numchildren; ++i)
+		count += trie_save_rec(t, node->children[children[i]], w);
+
+	return count;
+}
+
+/*
+ * Saves the trie to a snapshot file (see snapshot.h): its nodes in preorder, each
+ * with its weights, terminal flag and the sorted indexes of its children.
+ * The functions 'getindex' and 'getchar' are not saved.
+ * Returns 'true' if succeeded, 'false' otherwise.
+ */
+bool trie_save(const struct trie* t, const char* path)
+{
+	struct snapshot_writer w;
+	if (!snapshot_writer_open(&w, path, SNAPSHOT_MAGIC_TRIE))
+		return false;
+
+	w.header.capacity = t->array_size;
+	if (*(t->root) != NULL)
+		w.header.count = trie_save_rec(t, *(t->root), &w);
+
+	return snapshot_writer_close(&w);
+}
+
+/*
+ * Reads the subtree of the node at 'pos' of a trie snapshot; 'pos' moves past it
+ * and 'nodes' counts the read nodes.
+ * Returns the subtree root, NULL if the snapshot is corrupt (nodes read so far are
+ * linked to the trie, so its owner releases them).
+ */
+struct trienode* trie_load_rec( struct trie* t, const struct snapshot_image* img, uint64_t* pos,
+								uint64_t* nodes, struct trienode** slot )
+{
+	const struct snapshot_fileheader* h = img->header;
+	if ((*nodes >= h->count) || (*pos + sizeof(struct trie_snapshotnode) > h->filesize))
+		return NULL;
+
+	const struct trie_snapshotnode* rec = (const struct trie_snapshotnode*)(img->data + *pos);
+	const uint32_t* children = (const uint32_t*)(rec + 1);
+	if ( (rec->numchildren > t->array_size)
+		 || (rec->numchildren * sizeof(uint32_t) > h->filesize - *pos - sizeof(*rec)) )
+		return NULL;
+
+	struct trienode* node = trie_create_node(t);
+	node->terminal = (rec->terminal != 0);
+	node->weight = rec->weight;
+	node->maxweight = rec->maxweight;
+	*slot = node;
+	(*nodes)++;
+	*pos += sizeof(*rec) + SNAPSHOT_ALIGNUP(rec->numchildren * sizeof(uint32_t));
+
+	for (uint32_t i = 0; i < rec->numchildren; ++i) {
+		// indexes are strictly ascending, so no child slot is read twice
+		if ( (children[i] >= t->array_size) || ((i > 0) && (children[i] <= children[i - 1]))
+			 || (trie_load_rec(t, img, pos, nodes, &(node->children[children[i]])) == NULL) )
+			return NULL;
+	}
+
+	return node;
+}
+
+/*
+ * Loads a trie saved with 'trie_save' in one sequential pass over the snapshot,
+ * with the number of chars per node it was saved with. For read only use of large
+ * tries see statictrie (statictrie_save and statictrie_map keep it mapped in place).
+ * Returns the new trie or NULL if the file can not be read or is not a valid trie
+ * snapshot.
+ */
+struct trie* trie_load(const char* path, trie_getindex getindexfunc, trie_getchar getcharfunc)
+{
+	struct snapshot_image img;
+	if (!snapshot_image_open(&img, path, SNAPSHOT_MAGIC_TRIE, 1))
+		return NULL;
+
+	if ((img.header->capacity == 0) || (img.header->capacity > UINT32_MAX)) {
+		snapshot_image_close(&img);
+		return NULL;
+	}
+
+	struct trie* result = trie_create_trie(img.header->capacity, getindexfunc, getcharfunc);
+	trie_free_node(result, *(result->root));
+	*(result->root) = NULL;
+
+	uint64_t pos = img.header->recordspos;
+	uint64_t nodes = 0;
+	if ( (img.header->count > 0)
+		 && ((trie_load_rec(result, &img, &pos, &nodes, result->root) == NULL) || (nodes != img.header->count)) ) {
+		trie_destroy(result);
+		result = NULL;
+	}
+
+	snapshot_image_close(&img);
+	return result;
 }
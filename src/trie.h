@@ -130,6 +130,9 @@
 #ifndef TRIE_H_
 	#define TRIE_H_
 	#include <stdbool.h>
+	#include <stdint.h>
+	#include <stddef.h>
+	#include "allocator.h"
 
 	#define TRIE_DEFAULT_NUM_CHARS 26	// by default only chars from 'a' to 'z' (26 chars)
 
@@ -142,6 +145,8 @@
 	// declares a trie node
 	struct trienode {
 		bool terminal;
+		double weight;					// weight of the word ending here (see trieext_setweight)
+		double maxweight;				// upper bound of weights of words in the subtree
 		struct trienode* children[];
 	};
 
@@ -151,6 +156,16 @@
 		struct trienode** root;
 		trie_getindex getindex;		// if undefined, default method 'c' - 'a' will be used as index
 		trie_getchar getchar;		// if undefined, default method 'a' + i will be used as index
+		const struct allocator* allocator;	// allocator of trie and nodes (NULL: C library)
+	};
+
+	// node of a trie snapshot (see trie_save), followed by the indexes of its
+	// children (uint32_t, padded to SNAPSHOT_FILE_ALIGN) and then by their subtrees
+	struct trie_snapshotnode {
+		double weight;
+		double maxweight;
+		uint32_t terminal;
+		uint32_t numchildren;
 	};
 
 	/*
@@ -159,6 +174,13 @@
 	struct trie* trie_create_trie( size_t num_chars, trie_getindex getindexfunc,
 								   trie_getchar getcharfunc );
 
+	/*
+	 * Creates a trie instance whose structure and nodes are allocated by 'allocator'
+	 * (see allocator.h, NULL: C library).
+	 */
+	struct trie* trie_create_allocator( size_t num_chars, trie_getindex getindexfunc,
+										trie_getchar getcharfunc, const struct allocator* allocator );
+
 	/*
 	 * Inserts new text in the trie.
 	 * Returns 'true' if succeeded, 'false' otherwise.
@@ -197,4 +219,21 @@
 	 */
 	void trie_destroy(struct trie* t);
 
+	/*
+	 * Saves the trie to a snapshot file (see snapshot.h): its nodes in preorder, each
+	 * with its weights, terminal flag and the sorted indexes of its children.
+	 * The functions 'getindex' and 'getchar' are not saved.
+	 * Returns 'true' if succeeded, 'false' otherwise.
+	 */
+	bool trie_save(const struct trie* t, const char* path);
+
+	/*
+	 * Loads a trie saved with 'trie_save' in one sequential pass over the snapshot,
+	 * with the number of chars per node it was saved with. For read only use of large
+	 * tries see statictrie (statictrie_save and statictrie_map keep it mapped in place).
+	 * Returns the new trie or NULL if the file can not be read or is not a valid trie
+	 * snapshot.
+	 */
+	struct trie* trie_load(const char* path, trie_getindex getindexfunc, trie_getchar getcharfunc);
+
 #endif /* TRIE_H_ */
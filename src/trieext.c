@@ -6,66 +6,320 @@
  * Description: Trie data structure extension functions implemented in C.
  */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include "trie.h"
+#include "trieext.h"
 #include "arraylist.h"
 
+// state of a words enumeration
+struct trieext_walk {
+	struct trie* t;
+	char* buffer;				// chars of current path (reused for every word)
+	size_t capacity;			// size of buffer
+	size_t count;				// number of visited words
+	size_t max_results;			// maximum number of words (0: no limit)
+	trieext_visitword visit;
+	void* context;
+};
+
+// a word of a top-k search
+struct trieext_topkitem {
+	char* word;
+	double weight;
+};
+
+// state of a top-k search
+struct trieext_topk_state {
+	struct trieext_walk walk;			// path buffer
+	struct trieext_topkitem* items;		// best words, descending order of weight
+	size_t count;						// number of items
+	size_t k;
+};
+
+/*
+ * Gets the node of the last char of a prefix.
+ * Returns the node, NULL if prefix is not in the trie.
+ */
+struct trienode* trieext_findnode(struct trie* t, char* prefix)
+{
+	struct trienode* currentnode = *(t->root);
+	if (currentnode == NULL)
+		return NULL;
+
+	unsigned char* text = (unsigned char*)prefix;
+	int len = strlen(prefix);
+	for(int i = 0; i < len; ++i) {
+		int index = t->getindex(text[i]);
+		if (currentnode->children[index] == NULL)
+			return NULL;
+
+		currentnode = currentnode->children[index];
+	}
+
+	return currentnode;
+}
+
 /*
- * Recursively extract words from trie.
+ * Makes room in the path buffer for 'length' chars plus null terminal char.
  */
-void trieext_getwords_rec( struct trie* t, struct trienode* node,
-						   char* text, int length, struct arraylist* a )
+void trieext_reserve(struct trieext_walk* w, size_t length)
+{
+	if (length + 1 <= w->capacity)
+		return;
+
+	while (w->capacity < length + 1)
+		w->capacity *= 2;
+
+	w->buffer = (char*)realloc(w->buffer, w->capacity);
+	if (!w->buffer) {
+		printf("Memory error: failed to allocate memory for trie word buffer!");
+		abort();
+	}
+}
+
+/*
+ * Starts a walk under the node of a given prefix (path buffer holds the prefix).
+ */
+void trieext_walk_init(struct trieext_walk* w, struct trie* t, char* prefix)
+{
+	size_t len = strlen(prefix);
+	w->t = t;
+	w->capacity = len + 64;
+	w->buffer = (char*)malloc(w->capacity);
+	if (!w->buffer) {
+		printf("Memory error: failed to allocate memory for trie word buffer!");
+		abort();
+	}
+
+	memcpy(w->buffer, prefix, len);
+	w->count = 0;
+	w->max_results = 0;
+	w->visit = NULL;
+	w->context = NULL;
+}
+
+/*
+ * Recursively visits words under a node ('length' chars of path already in buffer).
+ * Returns 'false' when enumeration must stop.
+ */
+bool trieext_foreachword_rec(struct trieext_walk* w, struct trienode* node, size_t length)
 {
 	if (node->terminal) {
-		unsigned char* new_text = (unsigned char*)malloc(sizeof(char) * length + 1);
-		memcpy(new_text, text, length);
-		new_text[length] = 0;
-		arraylist_add(a, new_text);
+		w->buffer[length] = 0;
+		w->count++;
+		if (!w->visit(w->buffer, length, w->context))
+			return false;
+
+		if (w->max_results > 0 && w->count >= w->max_results)
+			return false;
 	}
 
-	for (int i = 0; i < t->array_size; ++i)
+	trieext_reserve(w, length + 1);
+	for (int i = 0; i < w->t->array_size; ++i)
 		if (node->children[i]) {
-			// extra space for new char plus null terminal char (0)
-			char new_prefix[length + 2];
-			memcpy(new_prefix, text, length);
-			new_prefix[length] = t->getchar(i);
-			trieext_getwords_rec(t, node->children[i], new_prefix, length+1, a);
+			w->buffer[length] = w->t->getchar(i);
+			if (!trieext_foreachword_rec(w, node->children[i], length + 1))
+				return false;
 		}
+
+	return true;
+}
+
+/*
+ * Visits the words that shares a given prefix in ascending order, up to 'max_results'
+ * words ('max_results' 0: no limit) or until 'visit' returns false.
+ * Words are built in a single buffer reused between calls: no allocation per word.
+ * Returns the number of visited words.
+ */
+size_t trieext_foreachword(struct trie* t, char* prefix, size_t max_results,
+						   trieext_visitword visit, void* context)
+{
+	struct trienode* node = trieext_findnode(t, prefix);
+	if (node == NULL)
+		return 0;
+
+	struct trieext_walk w;
+	trieext_walk_init(&w, t, prefix);
+	w.max_results = max_results;
+	w.visit = visit;
+	w.context = context;
+	trieext_foreachword_rec(&w, node, strlen(prefix));
+	free(w.buffer);
+	return w.count;
+}
+
+/*
+ * Callback that adds a copy of a word to an arraylist.
+ */
+bool trieext_addword(const char* word, size_t length, void* context)
+{
+	char* new_text = (char*)malloc(length + 1);
+	if (!new_text) {
+		printf("Memory error: failed to allocate memory for trie word!");
+		abort();
+	}
+
+	memcpy(new_text, word, length + 1);
+	arraylist_add((struct arraylist*)context, new_text);
+	return true;
+}
+
+/*
+ * Gets a list with the first 'max_results' words (in ascending order) that shares a
+ * given prefix ('max_results' 0: no limit).
+ * Returns an arraylist with founded words, 'NULL' if no word found.
+ */
+struct arraylist* trieext_getwords_limit(struct trie* t, char* prefix, size_t max_results)
+{
+	if (trieext_findnode(t, prefix) == NULL)
+		return NULL;
+
+	struct arraylist* result = arraylist_create_capacity(20);
+	trieext_foreachword(t, prefix, max_results, trieext_addword, result);
+	return result;
 }
 
 /*
  * Gets a list of words that shares a given prefix.
  * Returns an arraylist with founded words, 'NULL' if no word found.
  */
-struct arraylist* trieext_getwords(struct trie* t, char* prefix)
+struct arraylist* trieext_getwords(struct trie* t, char* prefix) {
+	return trieext_getwords_limit(t, prefix, 0);
+}
+
+/*
+ * Sets the weight (non negative) of a word of the trie and updates the subtree bounds
+ * of the nodes in its path, in O(L * array_size).
+ * Returns 'true' if succeeded, 'false' if word is not in the trie.
+ */
+bool trieext_setweight(struct trie* t, char* word, double weight)
 {
-	struct arraylist* result = NULL;
-	struct trienode* currentnode = *(t->root);
-	if (currentnode == NULL)
-		return result;
+	if (weight < 0) {
+		printf("Error: trie word weight must not be negative!");
+		abort();
+	}
 
-	bool match = true;
-	int len = strlen(prefix);
-	for(int i = 0; i < len; ++i) {
-		int index = t->getindex(prefix[i]);
-		if (currentnode->children[index] == NULL) {
-			match = false;
-			break;
+	struct trienode* node = trieext_findnode(t, word);
+	if (node == NULL || !node->terminal)
+		return false;
+
+	node->weight = weight;
+
+	// recompute bounds from word node up to root
+	unsigned char* text = (unsigned char*)word;
+	int len = strlen(word);
+	for (int depth = len; depth >= 0; --depth) {
+		struct trienode* current = *(t->root);
+		for (int i = 0; i < depth; ++i)
+			current = current->children[t->getindex(text[i])];
+
+		double bound = current->terminal ? current->weight : 0;
+		for (int i = 0; i < t->array_size; ++i)
+			if (current->children[i] && current->children[i]->maxweight > bound)
+				bound = current->children[i]->maxweight;
+
+		current->maxweight = bound;
+	}
+
+	return true;
+}
+
+/*
+ * Adds a word to the best words if its weight beats the k-th one.
+ */
+void trieext_topk_add(struct trieext_topk_state* s, size_t length, double weight)
+{
+	if (s->count == s->k && weight <= s->items[s->count - 1].weight)
+		return;
+
+	char* word = NULL;
+	if (s->count == s->k) {
+		// drop the worst word, reuse its memory if possible
+		word = s->items[--s->count].word;
+		word = (char*)realloc(word, length + 1);
+	}
+	else
+		word = (char*)malloc(length + 1);
+
+	if (!word) {
+		printf("Memory error: failed to allocate memory for trie word!");
+		abort();
+	}
+
+	memcpy(word, s->walk.buffer, length);
+	word[length] = 0;
+
+	// insert after words with greater or equal weight (words are visited in ascending order)
+	size_t pos = s->count;
+	while (pos > 0 && s->items[pos - 1].weight < weight) {
+		s->items[pos] = s->items[pos - 1];
+		pos--;
+	}
+
+	s->items[pos].word = word;
+	s->items[pos].weight = weight;
+	s->count++;
+}
+
+/*
+ * Recursively searches the best words under a node, skipping subtrees whose bound does
+ * not beat the k-th best weight.
+ */
+void trieext_topk_rec(struct trieext_topk_state* s, struct trienode* node, size_t length)
+{
+	if (s->count == s->k && node->maxweight <= s->items[s->count - 1].weight)
+		return;	// no word of this subtree can enter the best words
+
+	if (node->terminal)
+		trieext_topk_add(s, length, node->weight);
+
+	trieext_reserve(&s->walk, length + 1);
+	for (int i = 0; i < s->walk.t->array_size; ++i)
+		if (node->children[i]) {
+			s->walk.buffer[length] = s->walk.t->getchar(i);
+			trieext_topk_rec(s, node->children[i], length + 1);
 		}
+}
 
-		currentnode = currentnode->children[index];
+/*
+ * Gets the 'k' words with greatest weight that shares a given prefix, in descending
+ * order of weight (words with the same weight in ascending order). Subtrees whose
+ * bound can not beat the k-th best word are skipped.
+ * If 'weights' is defined, it receives the weight of each returned word (k entries).
+ * Returns an arraylist with founded words, 'NULL' if no word found.
+ */
+struct arraylist* trieext_topk(struct trie* t, char* prefix, size_t k, double* weights)
+{
+	struct trienode* node = trieext_findnode(t, prefix);
+	if (node == NULL || k == 0)
+		return NULL;
+
+	struct trieext_topk_state s;
+	trieext_walk_init(&s.walk, t, prefix);
+	s.items = (struct trieext_topkitem*)malloc(k * sizeof(struct trieext_topkitem));
+	if (!s.items) {
+		printf("Memory error: failed to allocate memory for trie top-k words!");
+		abort();
 	}
 
-	if (match) {
-		result = arraylist_create_capacity(20);
+	s.count = 0;
+	s.k = k;
+	trieext_topk_rec(&s, node, strlen(prefix));
+	free(s.walk.buffer);
 
-//		// create copy of prefix
-//		char* cprefix = malloc(sizeof(char) * strlen(prefix));
-		trieext_getwords_rec(t, currentnode, prefix, len, result);
+	struct arraylist* result = NULL;
+	if (s.count > 0) {
+		result = arraylist_create_capacity(s.count);
+		for (size_t i = 0; i < s.count; i++) {
+			arraylist_add(result, s.items[i].word);
+			if (weights)
+				weights[i] = s.items[i].weight;
+		}
 	}
 
+	free(s.items);
 	return result;
 }
-
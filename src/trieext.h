@@ -4,18 +4,73 @@
  *  Created on: 15/10/2023
  *      Author: Tiago C. Teixeira
  * Description: C headers for extend functions for trie data structure.
+ *
+ * Streaming enumeration
+ *
+ * 	trieext_foreachword visits the words with a given prefix in ascending order and passes
+ * 	each one to a callback, built in a single growable buffer: nothing is allocated per
+ * 	word and the walk stops after 'max_results' words (or when the callback returns
+ * 	false), so an auto complete of a short prefix does not materialize the whole subtree.
+ *
+ * Top-k by weight
+ *
+ * 	Every node keeps the weight of the word ending in it and 'maxweight', an upper bound
+ * 	of the weights in its subtree, updated along the path by trieext_setweight.
+ * 	trieext_topk walks the subtree of the prefix and skips every subtree whose bound is
+ * 	not greater than the k-th best weight found so far (branch and bound).
+ * 	Weights are non negative (new words have weight 0). trie_delete does not lower the
+ * 	bounds of the ancestors: they stay valid upper bounds, only pruning gets weaker
+ * 	until trieext_setweight is called on that path again.
  */
 
 #ifndef TRIEEXT_H_
 	#define TRIEEXT_H_
+	#include <stdbool.h>
+	#include <stddef.h>
 	#include "arraylist.h"
 	#include "trie.h"
 
+	// callback to visit a word: 'word' is null terminated and has 'length' chars, its
+	// buffer is reused after the callback returns. Returns 'false' to stop the enumeration.
+	typedef bool (*trieext_visitword)(const char* word, size_t length, void* context);
+
 	/*
 	 * Gets a list of words that shares a given prefix.
 	 * Returns an arraylist with founded words, 'NULL' if no word found.
 	 */
 	struct arraylist* trieext_getwords(struct trie* t, char* prefix);
 
+	/*
+	 * Gets a list with the first 'max_results' words (in ascending order) that shares a
+	 * given prefix ('max_results' 0: no limit).
+	 * Returns an arraylist with founded words, 'NULL' if no word found.
+	 */
+	struct arraylist* trieext_getwords_limit(struct trie* t, char* prefix, size_t max_results);
+
+	/*
+	 * Visits the words that shares a given prefix in ascending order, up to 'max_results'
+	 * words ('max_results' 0: no limit) or until 'visit' returns false.
+	 * Words are built in a single buffer reused between calls: no allocation per word.
+	 * Returns the number of visited words.
+	 */
+	size_t trieext_foreachword(struct trie* t, char* prefix, size_t max_results,
+							   trieext_visitword visit, void* context);
+
+	/*
+	 * Sets the weight (non negative) of a word of the trie and updates the subtree bounds
+	 * of the nodes in its path, in O(L * array_size).
+	 * Returns 'true' if succeeded, 'false' if word is not in the trie.
+	 */
+	bool trieext_setweight(struct trie* t, char* word, double weight);
+
+	/*
+	 * Gets the 'k' words with greatest weight that shares a given prefix, in descending
+	 * order of weight (words with the same weight in ascending order). Subtrees whose
+	 * bound can not beat the k-th best word are skipped.
+	 * If 'weights' is defined, it receives the weight of each returned word (k entries).
+	 * Returns an arraylist with founded words, 'NULL' if no word found.
+	 */
+	struct arraylist* trieext_topk(struct trie* t, char* prefix, size_t k, double* weights);
+
 
 #endif /* TRIEEXT_H_ */
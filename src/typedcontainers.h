@@ -0,0 +1,772 @@
+/*****************************************************************************
+ * typedcontainers.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: Macros to generate type specialized containers (array list, binary
+ *  			 heap, hash table and ordered set) that store elements by value.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  The generic containers store 'void*' elements and call compare/hash functions
+ *  through pointers, so an int key is boxed (one allocation and one cache miss per
+ *  access) and the comparison can not be inlined. The macros below generate, for a
+ *  given element type, a container that keeps the elements in its own arrays and
+ *  calls the compare/hash/equality expressions directly (the compiler inlines them):
+ *
+ *  	DEFINE_ARRAYLIST(name, T)						growable array of T;
+ *  	DEFINE_ARRAYLIST_SORT(name, T, cmp)				sort/sorted insert of that array;
+ *  	DEFINE_HEAP(name, T, cmp)						binary min heap of T (by 'cmp');
+ *  	DEFINE_HASHTABLE(name, K, V, hash, eq)			open addressing map K -> V;
+ *  	DEFINE_TREESET(name, T, cmp)					ordered set of T (AA tree).
+ *
+ *  'name' prefixes the generated structure and functions (ex: DEFINE_HEAP(intheap,
+ *  int, TC_CMP_NUM) generates 'struct intheap', 'intheap_create', 'intheap_insert'...).
+ *  Functions are 'static inline', so a container can be defined in every source file
+ *  that uses it.
+ *
+ *  'cmp(a, b)' returns a negative, zero or positive int, 'eq(a, b)' returns non zero
+ *  if keys are equal and 'hash(k)' returns an uint64_t. They can be function or
+ *  function like macro names. Ready made ones for int, uint64_t, double and strings
+ *  (const char*) are defined below.
+ *
+ *  Containers do not own pointed data (ex: string keys), it is not released by them.
+ *
+ *  Hash table: linear probing on a power of two array of slots with the hash stored
+ *  next to the key (rehash and most key compares skipped), removal shifts the next
+ *  slots back (no deleted markers), maximum load factor is 0.75.
+ *
+ *  Ordered set: AA tree (red-black tree variant, same O(log n) bounds) with nodes
+ *  in one array linked by 32 bit indexes (node 0 is the 'nil' sentinel).
+ *
+ *  Source: A. Andersson, "Balanced search trees made simple", WADS 1993.
+ *  		 https://en.wikipedia.org/wiki/Linear_probing
+ *
+ *******************************************************************************/
+
+#ifndef TYPEDCONTAINERS_H_
+	#define TYPEDCONTAINERS_H_
+
+	#include <stdio.h>
+	#include <stdlib.h>
+	#include <stdint.h>
+	#include <string.h>
+
+	#define TC_DEFAULT_CAPACITY 16
+	#define TC_TREESET_MAXDEPTH 96			// AA tree height is at most 2 * log2(n + 1)
+
+	// compare and equality of numbers (int, uint64_t, double...)
+	#define TC_CMP_NUM(a, b) (((a) > (b)) - ((a) < (b)))
+	#define TC_EQ_NUM(a, b) ((a) == (b))
+
+	// compare and equality of strings (const char*)
+	#define TC_CMP_STR(a, b) strcmp((a), (b))
+	#define TC_EQ_STR(a, b) (strcmp((a), (b)) == 0)
+
+	/*
+	 * Hash of an 64 bit integer (splitmix64 finalizer, every bit of key changes about
+	 * half of hash bits).
+	 */
+	static inline uint64_t tc_hash_u64(uint64_t x) {
+		x ^= x >> 30;
+		x *= 0xBF58476D1CE4E5B9ULL;
+		x ^= x >> 27;
+		x *= 0x94D049BB133111EBULL;
+		x ^= x >> 31;
+		return x;
+	}
+
+	static inline uint64_t tc_hash_int(int x) {
+		return tc_hash_u64((uint64_t)(unsigned int)x);
+	}
+
+	/*
+	 * Hash of a double (0.0 and -0.0 are equal, so they have the same hash).
+	 */
+	static inline uint64_t tc_hash_double(double x) {
+		uint64_t bits;
+		if (x == 0.0) x = 0.0;
+		memcpy(&bits, &x, sizeof(bits));
+		return tc_hash_u64(bits);
+	}
+
+	/*
+	 * Hash of a string (FNV-1a).
+	 */
+	static inline uint64_t tc_hash_str(const char* s) {
+		uint64_t h = 0xCBF29CE484222325ULL;
+		while (*s) {
+			h ^= (unsigned char)*s++;
+			h *= 0x100000001B3ULL;
+		}
+		return h;
+	}
+
+	/*
+	 * Allocation failure of a typed container (same message and behavior for all).
+	 */
+	static inline void* tc_checkalloc(void* p) {
+		if (p == NULL) {
+			printf("Memory error allocating typed container.\n");
+			abort();
+		}
+		return p;
+	}
+
+	/*
+	 * Array list of elements of type 'T'. Generates:
+	 *
+	 * 	struct name { T* buffer; size_t capacity; size_t length; };
+	 * 	struct name* name_create_capacity(size_t capacity);
+	 * 	struct name* name_create();
+	 * 	void name_reserve(struct name* a, size_t capacity);		// capacity >= 'capacity'
+	 * 	void name_add(struct name* a, T x);						// appends element
+	 * 	T name_get_item_at(const struct name* a, size_t index);
+	 * 	void name_set_item_at(struct name* a, size_t index, T x);
+	 * 	T name_remove_at(struct name* a, size_t index);			// shifts next elements
+	 * 	T name_pop(struct name* a);								// removes last element
+	 * 	void name_clear(struct name* a);
+	 * 	void name_destroy(struct name* a);
+	 *
+	 * Note: index is not checked (as array access).
+	 */
+	#define DEFINE_ARRAYLIST(name, T)													\
+		struct name {																	\
+			T* buffer;																	\
+			size_t capacity;															\
+			size_t length;																\
+		};																				\
+																						\
+		static inline struct name* name##_create_capacity(size_t capacity) {			\
+			struct name* a = tc_checkalloc(malloc(sizeof(struct name)));				\
+			if (capacity == 0) capacity = 1;											\
+			a->buffer = tc_checkalloc(malloc(sizeof(T) * capacity));					\
+			a->capacity = capacity;													\
+			a->length = 0;																\
+			return a;																	\
+		}																				\
+																						\
+		static inline struct name* name##_create() {									\
+			return name##_create_capacity(TC_DEFAULT_CAPACITY);						\
+		}																				\
+																						\
+		static inline void name##_reserve(struct name* a, size_t capacity) {			\
+			if (capacity <= a->capacity) return;										\
+			a->buffer = tc_checkalloc(realloc(a->buffer, sizeof(T) * capacity));		\
+			a->capacity = capacity;													\
+		}																				\
+																						\
+		static inline void name##_add(struct name* a, T x) {							\
+			if (a->length == a->capacity)												\
+				name##_reserve(a, a->capacity * 2);									\
+			a->buffer[a->length++] = x;												\
+		}																				\
+																						\
+		static inline T name##_get_item_at(const struct name* a, size_t index) {		\
+			return a->buffer[index];													\
+		}																				\
+																						\
+		static inline void name##_set_item_at(struct name* a, size_t index, T x) {	\
+			a->buffer[index] = x;														\
+		}																				\
+																						\
+		static inline T name##_remove_at(struct name* a, size_t index) {				\
+			T x = a->buffer[index];													\
+			memmove(&a->buffer[index], &a->buffer[index + 1],							\
+					sizeof(T) * (a->length - index - 1));								\
+			a->length--;																\
+			return x;																	\
+		}																				\
+																						\
+		static inline T name##_pop(struct name* a) {									\
+			return a->buffer[--a->length];												\
+		}																				\
+																						\
+		static inline void name##_clear(struct name* a) {								\
+			a->length = 0;																\
+		}																				\
+																						\
+		static inline void name##_destroy(struct name* a) {							\
+			free(a->buffer);															\
+			free(a);																	\
+		}
+
+	/*
+	 * Sort and sorted search for an array list generated by DEFINE_ARRAYLIST(name, T),
+	 * with 'cmp' inlined (same introsort as arraylist_sort). Generates:
+	 *
+	 * 	void name_sort(struct name* a);								// ascending, not stable
+	 * 	size_t name_lower_bound(const struct name* a, T x);		// first not lesser than 'x'
+	 * 	void name_insert_sorted(struct name* a, T x);				// after equal elements
+	 * 	int name_find_sorted(const struct name* a, T x, size_t* index);	// 0 if not found
+	 */
+	#define DEFINE_ARRAYLIST_SORT(name, T, cmp)										\
+		static inline void name##_introsort(T* v, size_t n, int depth) {				\
+			while (n > 16) {															\
+				if (depth-- == 0) {													\
+					/* heapsort */														\
+					for (size_t end = n, start = n / 2; end > 1; ) {					\
+						size_t root;													\
+						if (start > 0) root = --start;									\
+						else { T top = v[0]; v[0] = v[--end]; v[end] = top; root = 0; }	\
+						T x = v[root];													\
+						size_t child;													\
+						while ((child = 2 * root + 1) < end) {							\
+							if (child + 1 < end && cmp(v[child + 1], v[child]) > 0)	\
+								child++;												\
+							if (cmp(v[child], x) <= 0) break;							\
+							v[root] = v[child];										\
+							root = child;												\
+						}																\
+						v[root] = x;													\
+					}																	\
+					return;															\
+				}																		\
+				size_t mid = n / 2;													\
+				T t;																	\
+				if (cmp(v[mid], v[0]) < 0) { t = v[mid]; v[mid] = v[0]; v[0] = t; }	\
+				if (cmp(v[n - 1], v[mid]) < 0) { t = v[n - 1]; v[n - 1] = v[mid]; v[mid] = t; }	\
+				if (cmp(v[mid], v[0]) < 0) { t = v[mid]; v[mid] = v[0]; v[0] = t; }	\
+				T pivot = v[mid];														\
+				size_t i = 0, j = n - 1;												\
+				for (;;) {																\
+					while (cmp(v[i], pivot) < 0) i++;									\
+					while (cmp(v[j], pivot) > 0) j--;									\
+					if (i >= j) break;													\
+					t = v[i]; v[i] = v[j]; v[j] = t;									\
+					i++;																\
+					j--;																\
+				}																		\
+				size_t left = j + 1;													\
+				if (left < n - left) {													\
+					name##_introsort(v, left, depth);									\
+					v += left;															\
+					n -= left;															\
+				}																		\
+				else {																	\
+					name##_introsort(v + left, n - left, depth);						\
+					n = left;															\
+				}																		\
+			}																			\
+			for (size_t i = 1; i < n; ++i) {											\
+				T x = v[i];															\
+				size_t j = i;															\
+				while (j > 0 && cmp(v[j - 1], x) > 0) {								\
+					v[j] = v[j - 1];													\
+					j--;																\
+				}																		\
+				v[j] = x;																\
+			}																			\
+		}																				\
+																						\
+		static inline void name##_sort(struct name* a) {								\
+			int depth = 0;																\
+			for (size_t m = a->length; m > 1; m >>= 1) depth += 2;					\
+			name##_introsort(a->buffer, a->length, depth);								\
+		}																				\
+																						\
+		static inline size_t name##_lower_bound(const struct name* a, T x) {			\
+			size_t lo = 0, hi = a->length;												\
+			while (lo < hi) {															\
+				size_t mid = lo + (hi - lo) / 2;										\
+				if (cmp(a->buffer[mid], x) < 0) lo = mid + 1;							\
+				else hi = mid;															\
+			}																			\
+			return lo;																	\
+		}																				\
+																						\
+		static inline void name##_insert_sorted(struct name* a, T x) {				\
+			size_t lo = 0, hi = a->length;												\
+			while (lo < hi) {															\
+				size_t mid = lo + (hi - lo) / 2;										\
+				if (cmp(a->buffer[mid], x) <= 0) lo = mid + 1;							\
+				else hi = mid;															\
+			}																			\
+			name##_add(a, x);															\
+			memmove(&a->buffer[lo + 1], &a->buffer[lo], sizeof(T) * (a->length - 1 - lo));	\
+			a->buffer[lo] = x;															\
+		}																				\
+																						\
+		static inline int name##_find_sorted(const struct name* a, T x, size_t* index) {	\
+			size_t pos = name##_lower_bound(a, x);										\
+			if (index) *index = pos;													\
+			return pos < a->length && cmp(a->buffer[pos], x) == 0;					\
+		}
+
+	/*
+	 * Binary min heap of elements of type 'T' ('cmp(a, b) < 0': 'a' is polled first;
+	 * swap arguments to get a max heap). Generates:
+	 *
+	 * 	struct name { T* arr; size_t size; size_t capacity; };
+	 * 	struct name* name_create(size_t capacity);				// grows when full
+	 * 	struct name* name_create_from(const T* items, size_t n);	// heapify, O(n)
+	 * 	void name_insert(struct name* h, T x);
+	 * 	T name_peek(const struct name* h);						// heap must not be empty
+	 * 	int name_poll(struct name* h, T* out);					// 0 if heap is empty
+	 * 	int name_isempty(const struct name* h);
+	 * 	void name_destroy(struct name* h);
+	 */
+	#define DEFINE_HEAP(name, T, cmp)													\
+		struct name {																	\
+			T* arr;																	\
+			size_t size;																\
+			size_t capacity;															\
+		};																				\
+																						\
+		static inline struct name* name##_create(size_t capacity) {					\
+			struct name* h = tc_checkalloc(malloc(sizeof(struct name)));				\
+			if (capacity == 0) capacity = 1;											\
+			h->arr = tc_checkalloc(malloc(sizeof(T) * capacity));						\
+			h->size = 0;																\
+			h->capacity = capacity;													\
+			return h;																	\
+		}																				\
+																						\
+		static inline void name##_siftdown(struct name* h, size_t i) {				\
+			T x = h->arr[i];															\
+			size_t n = h->size;														\
+			for (;;) {																	\
+				size_t c = 2 * i + 1;													\
+				if (c >= n) break;														\
+				if (c + 1 < n && cmp(h->arr[c + 1], h->arr[c]) < 0) c++;				\
+				if (cmp(h->arr[c], x) >= 0) break;										\
+				h->arr[i] = h->arr[c];													\
+				i = c;																	\
+			}																			\
+			h->arr[i] = x;																\
+		}																				\
+																						\
+		static inline struct name* name##_create_from(const T* items, size_t n) {		\
+			struct name* h = name##_create(n);											\
+			memcpy(h->arr, items, sizeof(T) * n);										\
+			h->size = n;																\
+			for (size_t i = n / 2; i-- > 0; )											\
+				name##_siftdown(h, i);													\
+			return h;																	\
+		}																				\
+																						\
+		static inline void name##_insert(struct name* h, T x) {						\
+			if (h->size == h->capacity) {												\
+				h->capacity *= 2;														\
+				h->arr = tc_checkalloc(realloc(h->arr, sizeof(T) * h->capacity));		\
+			}																			\
+			size_t i = h->size++;														\
+			while (i > 0) {															\
+				size_t p = (i - 1) / 2;												\
+				if (cmp(x, h->arr[p]) >= 0) break;										\
+				h->arr[i] = h->arr[p];													\
+				i = p;																	\
+			}																			\
+			h->arr[i] = x;																\
+		}																				\
+																						\
+		static inline T name##_peek(const struct name* h) {							\
+			return h->arr[0];															\
+		}																				\
+																						\
+		static inline int name##_poll(struct name* h, T* out) {						\
+			if (h->size == 0) return 0;												\
+			*out = h->arr[0];															\
+			if (--h->size > 0) {														\
+				h->arr[0] = h->arr[h->size];											\
+				name##_siftdown(h, 0);													\
+			}																			\
+			return 1;																	\
+		}																				\
+																						\
+		static inline int name##_isempty(const struct name* h) {						\
+			return h->size == 0;														\
+		}																				\
+																						\
+		static inline void name##_destroy(struct name* h) {							\
+			free(h->arr);																\
+			free(h);																	\
+		}
+
+	/*
+	 * Hash table (map) of keys of type 'K' to values of type 'V'. Generates:
+	 *
+	 * 	struct name_slot { K key; V value; uint64_t hash; };	// hash 0: empty slot
+	 * 	struct name { struct name_slot* slots; size_t capacity; size_t count; };
+	 * 	struct name* name_create(size_t capacity);
+	 * 	int name_put(struct name* t, K key, V value);		// 1 if added, 0 if replaced
+	 * 	V* name_get(const struct name* t, K key);			// NULL if not found
+	 * 	int name_contains(const struct name* t, K key);
+	 * 	int name_remove(struct name* t, K key, V* out);		// 0 if not found ('out' may be NULL)
+	 * 	struct name_slot* name_next(const struct name* t, size_t* pos);	// iterates pairs
+	 * 	void name_clear(struct name* t);
+	 * 	void name_destroy(struct name* t);
+	 *
+	 * Iteration: 'size_t pos = 0;' then 'name_next(t, &pos)' until it returns NULL.
+	 * Note: a value pointer (name_get) is valid until next put or remove.
+	 */
+	#define DEFINE_HASHTABLE(name, K, V, hash, eq)										\
+		struct name##_slot {															\
+			K key;																		\
+			V value;																	\
+			uint64_t hash;																\
+		};																				\
+																						\
+		struct name {																	\
+			struct name##_slot* slots;													\
+			size_t capacity;															\
+			size_t count;																\
+		};																				\
+																						\
+		static inline uint64_t name##_hash(K key) {									\
+			uint64_t h = (uint64_t)hash(key);											\
+			return h ? h : 1;															\
+		}																				\
+																						\
+		static inline struct name* name##_create(size_t capacity) {					\
+			struct name* t = tc_checkalloc(malloc(sizeof(struct name)));				\
+			size_t c = TC_DEFAULT_CAPACITY;											\
+			while (c * 3 < capacity * 4) c *= 2;										\
+			t->slots = tc_checkalloc(calloc(c, sizeof(struct name##_slot)));			\
+			t->capacity = c;															\
+			t->count = 0;																\
+			return t;																	\
+		}																				\
+																						\
+		static inline struct name##_slot* name##_find(const struct name* t, K key) {	\
+			uint64_t h = name##_hash(key);												\
+			size_t mask = t->capacity - 1;												\
+			size_t i = h & mask;														\
+			while (t->slots[i].hash != 0) {											\
+				if (t->slots[i].hash == h && eq(t->slots[i].key, key))					\
+					return &t->slots[i];												\
+				i = (i + 1) & mask;													\
+			}																			\
+			return NULL;																\
+		}																				\
+																						\
+		static inline void name##_resize(struct name* t, size_t capacity) {			\
+			struct name##_slot* old = t->slots;										\
+			size_t oldcapacity = t->capacity;											\
+			size_t mask = capacity - 1;												\
+			t->slots = tc_checkalloc(calloc(capacity, sizeof(struct name##_slot)));	\
+			t->capacity = capacity;													\
+			for (size_t j = 0; j < oldcapacity; j++) {									\
+				if (old[j].hash == 0) continue;										\
+				size_t i = old[j].hash & mask;											\
+				while (t->slots[i].hash != 0) i = (i + 1) & mask;						\
+				t->slots[i] = old[j];													\
+			}																			\
+			free(old);																	\
+		}																				\
+																						\
+		static inline int name##_put(struct name* t, K key, V value) {				\
+			if ((t->count + 1) * 4 > t->capacity * 3)									\
+				name##_resize(t, t->capacity * 2);										\
+			uint64_t h = name##_hash(key);												\
+			size_t mask = t->capacity - 1;												\
+			size_t i = h & mask;														\
+			while (t->slots[i].hash != 0) {											\
+				if (t->slots[i].hash == h && eq(t->slots[i].key, key)) {				\
+					t->slots[i].value = value;											\
+					return 0;															\
+				}																		\
+				i = (i + 1) & mask;													\
+			}																			\
+			t->slots[i].key = key;														\
+			t->slots[i].value = value;													\
+			t->slots[i].hash = h;														\
+			t->count++;																\
+			return 1;																	\
+		}																				\
+																						\
+		static inline V* name##_get(const struct name* t, K key) {					\
+			struct name##_slot* s = name##_find(t, key);								\
+			return s ? &s->value : NULL;												\
+		}																				\
+																						\
+		static inline int name##_contains(const struct name* t, K key) {				\
+			return name##_find(t, key) != NULL;										\
+		}																				\
+																						\
+		static inline int name##_remove(struct name* t, K key, V* out) {				\
+			struct name##_slot* s = name##_find(t, key);								\
+			if (s == NULL) return 0;													\
+			if (out) *out = s->value;													\
+			size_t mask = t->capacity - 1;												\
+			size_t i = (size_t)(s - t->slots);											\
+			size_t j = i;																\
+			/* shift back next slots of the cluster that may move into the hole */	\
+			for (;;) {																	\
+				j = (j + 1) & mask;													\
+				if (t->slots[j].hash == 0) break;										\
+				size_t home = t->slots[j].hash & mask;									\
+				if (((j - home) & mask) >= ((j - i) & mask)) {							\
+					t->slots[i] = t->slots[j];											\
+					i = j;																\
+				}																		\
+			}																			\
+			t->slots[i].hash = 0;														\
+			t->count--;																\
+			return 1;																	\
+		}																				\
+																						\
+		static inline struct name##_slot* name##_next(const struct name* t,			\
+														size_t* pos) {					\
+			while (*pos < t->capacity) {												\
+				struct name##_slot* s = &t->slots[(*pos)++];							\
+				if (s->hash != 0) return s;											\
+			}																			\
+			return NULL;																\
+		}																				\
+																						\
+		static inline void name##_clear(struct name* t) {								\
+			memset(t->slots, 0, sizeof(struct name##_slot) * t->capacity);				\
+			t->count = 0;																\
+		}																				\
+																						\
+		static inline void name##_destroy(struct name* t) {							\
+			free(t->slots);															\
+			free(t);																	\
+		}
+
+	/*
+	 * Ordered set of elements of type 'T' (AA tree). Generates:
+	 *
+	 * 	struct name { struct name_node* nodes; ... size_t size; };
+	 * 	struct name* name_create();
+	 * 	int name_add(struct name* s, T x);				// 1 if added, 0 if already there
+	 * 	int name_contains(const struct name* s, T x);
+	 * 	int name_remove(struct name* s, T x);			// 1 if removed, 0 if not found
+	 * 	int name_min(const struct name* s, T* out);		// 0 if set is empty
+	 * 	int name_max(const struct name* s, T* out);
+	 * 	int name_floor(const struct name* s, T key, T* out);	// greatest <= key, 0 if none
+	 * 	int name_ceiling(const struct name* s, T key, T* out);	// smallest >= key, 0 if none
+	 * 	int name_iter_first(const struct name* s, struct name_iter* it, T* out);
+	 * 	int name_iter_next(struct name_iter* it, T* out);	// ascending order, 0 at end
+	 * 	void name_clear(struct name* s);
+	 * 	void name_destroy(struct name* s);
+	 *
+	 * Note: a cursor is valid while the set is not changed.
+	 */
+	#define DEFINE_TREESET(name, T, cmp)												\
+		struct name##_node {															\
+			T data;																	\
+			uint32_t left;																\
+			uint32_t right;															\
+			int level;																	\
+		};																				\
+																						\
+		struct name {																	\
+			struct name##_node* nodes;													\
+			uint32_t capacity;															\
+			uint32_t used;						/* nodes taken from array */			\
+			uint32_t freelist;					/* released nodes (linked by left) */	\
+			uint32_t root;																\
+			size_t size;																\
+		};																				\
+																						\
+		struct name##_iter {															\
+			const struct name* set;													\
+			int depth;																	\
+			uint32_t path[TC_TREESET_MAXDEPTH];										\
+		};																				\
+																						\
+		static inline struct name* name##_create() {									\
+			struct name* s = tc_checkalloc(malloc(sizeof(struct name)));				\
+			s->capacity = TC_DEFAULT_CAPACITY;											\
+			s->nodes = tc_checkalloc(calloc(s->capacity, sizeof(struct name##_node)));\
+			s->used = 1;																\
+			s->freelist = 0;															\
+			s->root = 0;																\
+			s->size = 0;																\
+			return s;																	\
+		}																				\
+																						\
+		static inline uint32_t name##_skew(struct name##_node* nd, uint32_t n) {		\
+			uint32_t l = nd[n].left;													\
+			if (n == 0 || nd[l].level != nd[n].level) return n;						\
+			nd[n].left = nd[l].right;													\
+			nd[l].right = n;															\
+			return l;																	\
+		}																				\
+																						\
+		static inline uint32_t name##_split(struct name##_node* nd, uint32_t n) {		\
+			uint32_t r = nd[n].right;													\
+			if (n == 0 || nd[nd[r].right].level != nd[n].level) return n;				\
+			nd[n].right = nd[r].left;													\
+			nd[r].left = n;															\
+			nd[r].level++;																\
+			return r;																	\
+		}																				\
+																						\
+		static inline uint32_t name##_ins(struct name* s, uint32_t n, T x, int* added) {	\
+			struct name##_node* nd = s->nodes;											\
+			if (n == 0) {																\
+				if (s->freelist) {														\
+					n = s->freelist;													\
+					s->freelist = nd[n].left;											\
+				}																		\
+				else n = s->used++;													\
+				nd[n].data = x;														\
+				nd[n].left = nd[n].right = 0;											\
+				nd[n].level = 1;														\
+				*added = 1;															\
+				return n;																\
+			}																			\
+			int c = cmp(x, nd[n].data);												\
+			if (c < 0) nd[n].left = name##_ins(s, nd[n].left, x, added);				\
+			else if (c > 0) nd[n].right = name##_ins(s, nd[n].right, x, added);		\
+			else return n;																\
+			n = name##_skew(nd, n);													\
+			return name##_split(nd, n);												\
+		}																				\
+																						\
+		static inline int name##_add(struct name* s, T x) {							\
+			int added = 0;																\
+			/* room for one more node: array is not moved while recursing */			\
+			if (s->freelist == 0 && s->used == s->capacity) {							\
+				s->capacity *= 2;														\
+				s->nodes = tc_checkalloc(realloc(s->nodes,								\
+									sizeof(struct name##_node) * s->capacity));		\
+			}																			\
+			s->root = name##_ins(s, s->root, x, &added);								\
+			s->size += added;															\
+			return added;																\
+		}																				\
+																						\
+		static inline uint32_t name##_del(struct name* s, uint32_t n, T x, int* removed) {	\
+			struct name##_node* nd = s->nodes;											\
+			if (n == 0) return 0;														\
+			int c = cmp(x, nd[n].data);												\
+			if (c < 0) nd[n].left = name##_del(s, nd[n].left, x, removed);				\
+			else if (c > 0) nd[n].right = name##_del(s, nd[n].right, x, removed);		\
+			else {																		\
+				*removed = 1;															\
+				if (nd[n].left == 0 && nd[n].right == 0) {								\
+					nd[n].left = s->freelist;											\
+					s->freelist = n;													\
+					return 0;															\
+				}																		\
+				uint32_t m;															\
+				if (nd[n].left == 0) {													\
+					/* replace by successor (smallest of right subtree) */			\
+					for (m = nd[n].right; nd[m].left; m = nd[m].left) ;				\
+					nd[n].data = nd[m].data;											\
+					nd[n].right = name##_del(s, nd[n].right, nd[m].data, removed);		\
+				}																		\
+				else {																	\
+					/* replace by predecessor (largest of left subtree) */			\
+					for (m = nd[n].left; nd[m].right; m = nd[m].right) ;				\
+					nd[n].data = nd[m].data;											\
+					nd[n].left = name##_del(s, nd[n].left, nd[m].data, removed);		\
+				}																		\
+			}																			\
+			/* decrease level and rebalance */										\
+			int l = nd[nd[n].left].level, r = nd[nd[n].right].level;					\
+			int should = (l < r ? l : r) + 1;											\
+			if (should < nd[n].level) {												\
+				nd[n].level = should;													\
+				if (should < r) nd[nd[n].right].level = should;						\
+			}																			\
+			n = name##_skew(nd, n);													\
+			nd[n].right = name##_skew(nd, nd[n].right);								\
+			if (nd[n].right) nd[nd[n].right].right = name##_skew(nd, nd[nd[n].right].right);	\
+			n = name##_split(nd, n);													\
+			nd[n].right = name##_split(nd, nd[n].right);								\
+			return n;																	\
+		}																				\
+																						\
+		static inline int name##_remove(struct name* s, T x) {						\
+			int removed = 0;															\
+			s->root = name##_del(s, s->root, x, &removed);								\
+			s->size -= removed;														\
+			return removed;															\
+		}																				\
+																						\
+		static inline int name##_contains(const struct name* s, T x) {				\
+			uint32_t n = s->root;														\
+			while (n) {																\
+				int c = cmp(x, s->nodes[n].data);										\
+				if (c == 0) return 1;													\
+				n = c < 0 ? s->nodes[n].left : s->nodes[n].right;						\
+			}																			\
+			return 0;																	\
+		}																				\
+																						\
+		static inline int name##_min(const struct name* s, T* out) {					\
+			uint32_t n = s->root;														\
+			if (n == 0) return 0;														\
+			while (s->nodes[n].left) n = s->nodes[n].left;								\
+			*out = s->nodes[n].data;													\
+			return 1;																	\
+		}																				\
+																						\
+		static inline int name##_max(const struct name* s, T* out) {					\
+			uint32_t n = s->root;														\
+			if (n == 0) return 0;														\
+			while (s->nodes[n].right) n = s->nodes[n].right;							\
+			*out = s->nodes[n].data;													\
+			return 1;																	\
+		}																				\
+																						\
+		static inline int name##_floor(const struct name* s, T key, T* out) {			\
+			uint32_t n = s->root, best = 0;											\
+			while (n) {																\
+				int c = cmp(key, s->nodes[n].data);									\
+				if (c == 0) { best = n; break; }										\
+				if (c < 0) n = s->nodes[n].left;										\
+				else { best = n; n = s->nodes[n].right; }								\
+			}																			\
+			if (best == 0) return 0;													\
+			*out = s->nodes[best].data;												\
+			return 1;																	\
+		}																				\
+																						\
+		static inline int name##_ceiling(const struct name* s, T key, T* out) {		\
+			uint32_t n = s->root, best = 0;											\
+			while (n) {																\
+				int c = cmp(key, s->nodes[n].data);									\
+				if (c == 0) { best = n; break; }										\
+				if (c > 0) n = s->nodes[n].right;										\
+				else { best = n; n = s->nodes[n].left; }								\
+			}																			\
+			if (best == 0) return 0;													\
+			*out = s->nodes[best].data;												\
+			return 1;																	\
+		}																				\
+																						\
+		static inline void name##_pushleft(struct name##_iter* it, uint32_t n) {		\
+			for (; n; n = it->set->nodes[n].left)										\
+				it->path[it->depth++] = n;												\
+		}																				\
+																						\
+		static inline int name##_iter_first(const struct name* s,						\
+											struct name##_iter* it, T* out) {			\
+			it->set = s;																\
+			it->depth = 0;																\
+			name##_pushleft(it, s->root);												\
+			if (it->depth == 0) return 0;												\
+			*out = s->nodes[it->path[it->depth - 1]].data;								\
+			return 1;																	\
+		}																				\
+																						\
+		static inline int name##_iter_next(struct name##_iter* it, T* out) {			\
+			if (it->depth == 0) return 0;												\
+			uint32_t n = it->path[--it->depth];										\
+			name##_pushleft(it, it->set->nodes[n].right);								\
+			if (it->depth == 0) return 0;												\
+			*out = it->set->nodes[it->path[it->depth - 1]].data;						\
+			return 1;																	\
+		}																				\
+																						\
+		static inline void name##_clear(struct name* s) {								\
+			s->used = 1;																\
+			s->freelist = 0;															\
+			s->root = 0;																\
+			s->size = 0;																\
+		}																				\
+																						\
+		static inline void name##_destroy(struct name* s) {							\
+			free(s->nodes);															\
+			free(s);																	\
+		}
+
+#endif /* TYPEDCONTAINERS_H_ */
@@ -0,0 +1,115 @@
+/*
+ * unionfind.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Union-find (disjoint set) with union by rank and path halving.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "unionfind.h"
+
+#define UNIONFIND_ROOT -1		// parent of a root of rank 0
+
+/*
+ * Creates a union-find structure with 'n' elements, each one in its own set.
+ */
+struct unionfind* unionfind_create(int n)
+{
+	struct unionfind* uf = (struct unionfind*)malloc(sizeof(struct unionfind));
+	int* parent = (int*)malloc(((n > 0) ? n : 1) * sizeof(int));
+	if ((uf == NULL) || (parent == NULL)) {
+		printf("Memory error: failed to allocate memory for union-find structure!");
+		abort();
+	}
+
+	uf->n = n;
+	uf->parent = parent;
+	unionfind_reset(uf);
+	return uf;
+}
+
+/*
+ * Puts every element back in its own set.
+ */
+void unionfind_reset(struct unionfind* uf)
+{
+	for (int i = 0; i < uf->n; ++i)
+		uf->parent[i] = UNIONFIND_ROOT;
+
+	uf->numsets = uf->n;
+}
+
+/*
+ * Finds the root (representative) of the set of element 'x'.
+ * Path is halved on the way up (see implementation notes).
+ */
+int unionfind_find(struct unionfind* uf, int x)
+{
+	int* parent = uf->parent;
+	while (parent[x] >= 0) {
+		int p = parent[x];
+		if (parent[p] >= 0)
+			parent[x] = parent[p];	// point to grand parent
+
+		x = p;
+	}
+
+	return x;
+}
+
+/*
+ * Merges the sets of elements 'x' and 'y' (union by rank).
+ * Returns 1 if the sets were merged, 0 if both elements were already in the same set.
+ */
+int unionfind_union(struct unionfind* uf, int x, int y)
+{
+	int rx = unionfind_find(uf, x);
+	int ry = unionfind_find(uf, y);
+	if (rx == ry)
+		return 0;
+
+	// roots hold -(rank + 1): the larger rank has the smaller value
+	int* parent = uf->parent;
+	if (parent[rx] > parent[ry]) {
+		int tmp = rx;
+		rx = ry;
+		ry = tmp;
+	}
+
+	if (parent[rx] == parent[ry])
+		parent[rx]--;				// same rank: new root grows one level
+
+	parent[ry] = rx;
+	uf->numsets--;
+	return 1;
+}
+
+/*
+ * Checks if elements 'x' and 'y' are in the same set.
+ */
+int unionfind_connected(struct unionfind* uf, int x, int y)
+{
+	return unionfind_find(uf, x) == unionfind_find(uf, y);
+}
+
+/*
+ * Gets the number of disjoint sets.
+ */
+int unionfind_getnumsets(const struct unionfind* uf)
+{
+	return uf->numsets;
+}
+
+/*
+ * Releases union-find structure from memory.
+ */
+void unionfind_destroy(struct unionfind* uf)
+{
+	if (uf == NULL)
+		return;
+
+	free(uf->parent);
+	free(uf);
+}
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ * unionfind.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a union-find (disjoint set) structure over the
+ *  			 integers [0, n), used by Kruskal and connected components.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  Each element has one int in a single array: the parent of the element, or for
+ *  the root of a set -(rank + 1). Keeping the rank in the root slot instead of in a
+ *  second array means a find and a union touch one array only (one cache miss per
+ *  visited element instead of two).
+ *
+ *  	- union by rank: the root of lower rank is linked below the other one, so the
+ *  	  trees are O(log n) high before any compression;
+ *  	- path halving: during a find every visited element is pointed to its grand
+ *  	  parent, in the same single pass (no recursion and no second pass of full path
+ *  	  compression, same amortized bound).
+ *
+ *  Together both give an amortized O(alpha(n)) per operation, alpha being the inverse
+ *  Ackermann function (less than 5 for any practical n).
+ *
+ * 		  Time complexity by operation
+ *	-----------------------------------------
+ * 	|	find(x) 				| O(alpha(n)) 	|
+ * 	|	union(x, y) 			| O(alpha(n)) 	|
+ * 	|	connected(x, y) 		| O(alpha(n)) 	|
+ * 	|	reset			 		| O(n)		 	|
+ *	-----------------------------------------
+ *
+ *  Source: R. E. Tarjan, J. van Leeuwen, "Worst-case Analysis of Set Union
+ *  		 Algorithms", Journal of the ACM (1984).
+ *
+ *******************************************************************************/
+
+#ifndef UNIONFIND_H_
+	#define UNIONFIND_H_
+
+	// union-find structure type
+	struct unionfind {
+		int n;				// number of elements (indexes in [0, n))
+		int numsets;		// current number of disjoint sets
+		int* parent;		// parent of each element, -(rank + 1) for roots
+	};
+
+	/*
+	 * Creates a union-find structure with 'n' elements, each one in its own set.
+	 */
+	struct unionfind* unionfind_create(int n);
+
+	/*
+	 * Puts every element back in its own set.
+	 */
+	void unionfind_reset(struct unionfind* uf);
+
+	/*
+	 * Finds the root (representative) of the set of element 'x'.
+	 * Path is halved on the way up (see implementation notes).
+	 */
+	int unionfind_find(struct unionfind* uf, int x);
+
+	/*
+	 * Merges the sets of elements 'x' and 'y' (union by rank).
+	 * Returns 1 if the sets were merged, 0 if both elements were already in the same set.
+	 */
+	int unionfind_union(struct unionfind* uf, int x, int y);
+
+	/*
+	 * Checks if elements 'x' and 'y' are in the same set.
+	 */
+	int unionfind_connected(struct unionfind* uf, int x, int y);
+
+	/*
+	 * Gets the number of disjoint sets.
+	 */
+	int unionfind_getnumsets(const struct unionfind* uf);
+
+	/*
+	 * Releases union-find structure from memory.
+	 */
+	void unionfind_destroy(struct unionfind* uf);
+
+#endif /* UNIONFIND_H_ */
@@ -0,0 +1,374 @@
+/*
+ * unrolledlist.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Unrolled linked list, a doubly linked list of small element arrays.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unrolledlist.h"
+
+/*
+ * Creates a new unrolled list.
+ * Returns the new list if succeeded, NULL otherwise.
+ * */
+struct unrolledlist* unrolledlist_create( unrolledlist_isequal isequalfunc,
+										  unrolledlist_freedata freedatafunc )
+{
+	struct unrolledlist* list = (struct unrolledlist*)malloc(sizeof(struct unrolledlist));
+	if (list == NULL) {
+		printf("Memory error: failed to allocate memory for unrolled list!\n");
+		return NULL;
+	}
+
+	list->isequalfunc = isequalfunc;
+	list->freedata = freedatafunc;
+	list->head = list->tail = NULL;
+	list->size = 0;
+	list->nodes = 0;
+	return list;
+}
+
+/*
+ * Checks if list is empty.
+ * Returns 1 if is empty, 0 otherwise.
+ * */
+int unrolledlist_isempty(const struct unrolledlist* list)
+{
+	return (list->size == 0);
+}
+
+/*
+ * Gets the number of elements in list.
+ * */
+size_t unrolledlist_getsize(const struct unrolledlist* list)
+{
+	return list->size;
+}
+
+/*
+ * Creates an empty node linked after 'prev' (at the head if 'prev' is NULL).
+ * Returns the new node if succeeded, NULL otherwise.
+ * Note: Private function.
+ * */
+struct unrolledlistnode* unrolledlist_createnode(struct unrolledlist* list,
+												 struct unrolledlistnode* prev)
+{
+	struct unrolledlistnode* node = (struct unrolledlistnode*)malloc(sizeof(struct unrolledlistnode));
+	if (node == NULL)
+		return NULL;
+
+	node->count = 0;
+	node->prev = prev;
+	node->next = (prev != NULL) ? prev->next : list->head;
+	if (node->next != NULL)
+		node->next->prev = node;
+	else
+		list->tail = node;
+
+	if (prev != NULL)
+		prev->next = node;
+	else
+		list->head = node;
+
+	list->nodes++;
+	return node;
+}
+
+/*
+ * Unlinks and releases a node.
+ * Note: Private function.
+ * */
+void unrolledlist_freenode(struct unrolledlist* list, struct unrolledlistnode* node)
+{
+	if (node->prev != NULL)
+		node->prev->next = node->next;
+	else
+		list->head = node->next;
+
+	if (node->next != NULL)
+		node->next->prev = node->prev;
+	else
+		list->tail = node->prev;
+
+	list->nodes--;
+	free(node);
+}
+
+/*
+ * Inserts an element at 'index' (0..count) of 'node', splitting the node when full.
+ * Returns 1 and the position of the new element in 'pos' (if defined) if succeeded,
+ * 0 otherwise.
+ * Note: Private function.
+ * */
+int unrolledlist_insert_in(struct unrolledlist* list, struct unrolledlistnode* node,
+						   size_t index, void* data, struct unrolledlist_pos* pos)
+{
+	if (node->count == UNROLLEDLIST_NODE_CAPACITY) {
+		// move the upper half to a new node after this one
+		struct unrolledlistnode* right = unrolledlist_createnode(list, node);
+		if (right == NULL)
+			return 0;
+
+		size_t half = UNROLLEDLIST_NODE_CAPACITY / 2;
+		memcpy(right->items, node->items + half, (UNROLLEDLIST_NODE_CAPACITY - half) * sizeof(void*));
+		right->count = UNROLLEDLIST_NODE_CAPACITY - half;
+		node->count = half;
+		if (index > half) {
+			node = right;
+			index -= half;
+		}
+	}
+
+	memmove(node->items + index + 1, node->items + index, (node->count - index) * sizeof(void*));
+	node->items[index] = data;
+	node->count++;
+	list->size++;
+
+	if (pos != NULL) {
+		pos->node = node;
+		pos->index = index;
+	}
+
+	return 1;
+}
+
+/*
+ * Adds a new element at begin of list.
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int unrolledlist_push(struct unrolledlist* list, void* new_data)
+{
+	// a full head gets a new node before it (pushes alone keep nodes full)
+	if (list->head == NULL || list->head->count == UNROLLEDLIST_NODE_CAPACITY)
+		if (unrolledlist_createnode(list, NULL) == NULL)
+			return 0;
+
+	return unrolledlist_insert_in(list, list->head, 0, new_data, NULL);
+}
+
+/*
+ * Adds a new element at end of list.
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int unrolledlist_append(struct unrolledlist* list, void* new_data)
+{
+	// a full tail gets a new node after it (appends alone keep nodes full)
+	if (list->tail == NULL || list->tail->count == UNROLLEDLIST_NODE_CAPACITY)
+		if (unrolledlist_createnode(list, list->tail) == NULL)
+			return 0;
+
+	return unrolledlist_insert_in(list, list->tail, list->tail->count, new_data, NULL);
+}
+
+/*
+ * Inserts a new element after the element at position 'pos' (see unrolledlist_find,
+ * unrolledlist_getpos_at). 'pos' is updated to the new element.
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int unrolledlist_insert_after(struct unrolledlist* list, struct unrolledlist_pos* pos,
+							  void* new_data)
+{
+	return unrolledlist_insert_in(list, pos->node, pos->index + 1, new_data, pos);
+}
+
+/*
+ * Inserts a new element at given position (zero based, 0..size).
+ * Returns 1 if succeeded, 0 otherwise.
+ * */
+int unrolledlist_insert_at(struct unrolledlist* list, size_t position, void* new_data)
+{
+	if (position >= list->size)
+		return (position == list->size) ? unrolledlist_append(list, new_data) : 0;
+
+	struct unrolledlist_pos pos;
+	unrolledlist_getpos_at(list, position, &pos);
+	return unrolledlist_insert_in(list, pos.node, pos.index, new_data, NULL);
+}
+
+/*
+ * Gets the position of the element at 'position' (zero based), in O(position / capacity).
+ * Returns 1 if succeeded, 0 if position is out of bounds.
+ * */
+int unrolledlist_getpos_at(const struct unrolledlist* list, size_t position,
+						   struct unrolledlist_pos* pos)
+{
+	if (position >= list->size)
+		return 0;
+
+	struct unrolledlistnode* node;
+	if (position < list->size / 2) {
+		// skip whole nodes from the head
+		node = list->head;
+		while (position >= node->count) {
+			position -= node->count;
+			node = node->next;
+		}
+	}
+	else {
+		// or from the tail
+		size_t back = list->size - 1 - position;
+		node = list->tail;
+		while (back >= node->count) {
+			back -= node->count;
+			node = node->prev;
+		}
+
+		position = node->count - 1 - back;
+	}
+
+	pos->node = node;
+	pos->index = position;
+	return 1;
+}
+
+/*
+ * Gets data from the element at given position (zero based) in list.
+ * Returns reference to founded data if succeeded, NULL otherwise.
+ * */
+void* unrolledlist_getdata_at(const struct unrolledlist* list, size_t position)
+{
+	struct unrolledlist_pos pos;
+	if (!unrolledlist_getpos_at(list, position, &pos))
+		return NULL;
+
+	return pos.node->items[pos.index];
+}
+
+/*
+ * Finds the first element that matches given data (isequal function).
+ * Returns 1 and its position in 'pos' if found, 0 otherwise.
+ * */
+int unrolledlist_find(const struct unrolledlist* list, const void* data,
+					  struct unrolledlist_pos* pos)
+{
+	for (struct unrolledlistnode* node = list->head; node != NULL; node = node->next)
+		for (size_t i = 0; i < node->count; i++)
+			if ((list->isequalfunc != NULL) ? list->isequalfunc(node->items[i], data)
+											: (node->items[i] == data)) {
+				pos->node = node;
+				pos->index = i;
+				return 1;
+			}
+
+	return 0;
+}
+
+/*
+ * Gets data from the first element that matches given value.
+ * Returns reference to founded data if succeeded, NULL otherwise.
+ * */
+void* unrolledlist_getdata(const struct unrolledlist* list, const void* data)
+{
+	struct unrolledlist_pos pos;
+	if (!unrolledlist_find(list, data, &pos))
+		return NULL;
+
+	return pos.node->items[pos.index];
+}
+
+/*
+ * Removes the element at 'pos'.
+ * Returns the removed data.
+ * */
+void* unrolledlist_remove_pos(struct unrolledlist* list, const struct unrolledlist_pos* pos)
+{
+	struct unrolledlistnode* node = pos->node;
+	void* result = node->items[pos->index];
+
+	memmove(node->items + pos->index, node->items + pos->index + 1,
+			(node->count - pos->index - 1) * sizeof(void*));
+	node->count--;
+	list->size--;
+
+	if (node->count == 0)
+		unrolledlist_freenode(list, node);
+	else if (node->count < UNROLLEDLIST_NODE_CAPACITY / 4 && node->next != NULL
+			 && node->count + node->next->count <= UNROLLEDLIST_NODE_CAPACITY) {
+		// merge the next node into this one
+		struct unrolledlistnode* next = node->next;
+		memcpy(node->items + node->count, next->items, next->count * sizeof(void*));
+		node->count += next->count;
+		unrolledlist_freenode(list, next);
+	}
+
+	return result;
+}
+
+/*
+ * Removes the first element from list.
+ * Returns the removed data if succeeded, NULL otherwise.
+ * */
+void* unrolledlist_remove_first(struct unrolledlist* list)
+{
+	if (list->size == 0)
+		return NULL;
+
+	struct unrolledlist_pos pos = { .node = list->head, .index = 0 };
+	return unrolledlist_remove_pos(list, &pos);
+}
+
+/*
+ * Removes the first element that matches given data.
+ * Returns the removed data if succeeded, NULL otherwise.
+ * */
+void* unrolledlist_remove(struct unrolledlist* list, const void* data)
+{
+	struct unrolledlist_pos pos;
+	if (!unrolledlist_find(list, data, &pos))
+		return NULL;
+
+	return unrolledlist_remove_pos(list, &pos);
+}
+
+/*
+ * Starts an iteration at the first element.
+ * Returns the first element, NULL if list is empty.
+ * */
+void* unrolledlist_iter_first(const struct unrolledlist* list, struct unrolledlist_iter* it)
+{
+	it->node = list->head;
+	it->index = 0;
+	return (it->node != NULL) ? it->node->items[0] : NULL;
+}
+
+/*
+ * Moves to the next element.
+ * Returns the next element, NULL at the end (it->node is NULL).
+ * */
+void* unrolledlist_iter_next(struct unrolledlist_iter* it)
+{
+	if (it->node == NULL)
+		return NULL;
+
+	if (++(it->index) == it->node->count) {
+		it->node = it->node->next;
+		it->index = 0;
+		if (it->node == NULL)
+			return NULL;
+	}
+
+	return it->node->items[it->index];
+}
+
+/*
+ * Releases the entire list (and elements data if freedata function is defined).
+ * */
+void unrolledlist_destroy(struct unrolledlist* list)
+{
+	struct unrolledlistnode* node = list->head;
+	while (node != NULL) {
+		struct unrolledlistnode* next = node->next;
+		if (list->freedata != NULL)
+			for (size_t i = 0; i < node->count; i++)
+				list->freedata(node->items[i]);
+
+		free(node);
+		node = next;
+	}
+
+	free(list);
+}
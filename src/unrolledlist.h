@@ -0,0 +1,180 @@
+/*****************************************************************************
+ * unrolledlist.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for an unrolled linked list: a doubly linked list of
+ *  			 nodes holding up to UNROLLEDLIST_NODE_CAPACITY elements each.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  A linked list node holds one element, so a scan takes a cache miss per element
+ *  and every element pays two pointers plus a malloc header. An unrolled list keeps
+ *  the elements of a node in a small contiguous array:
+ *
+ *  	- scans read UNROLLEDLIST_NODE_CAPACITY elements per node (a few cache lines)
+ *  	  and skip whole nodes when looking for a position (n / capacity hops);
+ *  	- the overhead is two pointers and a count per node instead of per element;
+ *  	- an insert shifts at most one node of elements. A full node is split in two
+ *  	  half full nodes, so inserts after a split have room again.
+ *
+ *  After a remove a node with less than a quarter of the capacity is merged with the
+ *  next node when both fit in one, so nodes stay at least a quarter full on average
+ *  and an empty node is released at once.
+ *
+ *  A position in the list is a (node, index) pair (struct unrolledlist_pos), valid
+ *  until the next insert or remove.
+ *
+ *  Source: Z. Shao, J. H. Reppy, A. W. Appel, "Unrolling Lists", ACM LISP and
+ *  		 Functional Programming (1994).
+ *
+ *******************************************************************************/
+
+#ifndef UNROLLEDLIST_H_
+	#define UNROLLEDLIST_H_
+
+	#include <stddef.h>
+
+	#define UNROLLEDLIST_NODE_CAPACITY 32		// elements per node (node is 4.5 cache lines)
+
+	typedef void (*unrolledlist_freedata)(void* data);
+	typedef int (*unrolledlist_isequal)(const void* a, const void* b);
+
+	// Represents a node (block of elements) in list
+	struct unrolledlistnode {
+		struct unrolledlistnode* next;
+		struct unrolledlistnode* prev;
+		size_t count;									// elements in node
+		void* items[UNROLLEDLIST_NODE_CAPACITY];
+	};
+
+	// Unrolled linked list data structure
+	struct unrolledlist {
+		unrolledlist_isequal isequalfunc;			// function to check if two elements are equal
+		unrolledlist_freedata freedata;				// function to release data
+		struct unrolledlistnode* head;				// first node
+		struct unrolledlistnode* tail;				// last node
+		size_t size;								// number of elements in list
+		size_t nodes;								// number of nodes
+	};
+
+	// Position of an element: node and index in node
+	struct unrolledlist_pos {
+		struct unrolledlistnode* node;
+		size_t index;
+	};
+
+	// Iterator (in order)
+	struct unrolledlist_iter {
+		struct unrolledlistnode* node;				// NULL at the end
+		size_t index;
+	};
+
+	/*
+	 * Creates a new unrolled list.
+	 * Returns the new list if succeeded, NULL otherwise.
+	 * */
+	struct unrolledlist* unrolledlist_create( unrolledlist_isequal isequalfunc,
+											  unrolledlist_freedata freedatafunc );
+
+	/*
+	 * Checks if list is empty.
+	 * Returns 1 if is empty, 0 otherwise.
+	 * */
+	int unrolledlist_isempty(const struct unrolledlist* list);
+
+	/*
+	 * Gets the number of elements in list.
+	 * */
+	size_t unrolledlist_getsize(const struct unrolledlist* list);
+
+	/*
+	 * Adds a new element at begin of list.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 * */
+	int unrolledlist_push(struct unrolledlist* list, void* new_data);
+
+	/*
+	 * Adds a new element at end of list.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 * */
+	int unrolledlist_append(struct unrolledlist* list, void* new_data);
+
+	/*
+	 * Inserts a new element after the element at position 'pos' (see unrolledlist_find,
+	 * unrolledlist_getpos_at). 'pos' is updated to the new element.
+	 * Returns 1 if succeeded, 0 otherwise.
+	 * */
+	int unrolledlist_insert_after(struct unrolledlist* list, struct unrolledlist_pos* pos,
+								  void* new_data);
+
+	/*
+	 * Inserts a new element at given position (zero based, 0..size).
+	 * Returns 1 if succeeded, 0 otherwise.
+	 * */
+	int unrolledlist_insert_at(struct unrolledlist* list, size_t position, void* new_data);
+
+	/*
+	 * Gets the position of the element at 'position' (zero based), in O(position / capacity).
+	 * Returns 1 if succeeded, 0 if position is out of bounds.
+	 * */
+	int unrolledlist_getpos_at(const struct unrolledlist* list, size_t position,
+							   struct unrolledlist_pos* pos);
+
+	/*
+	 * Gets data from the element at given position (zero based) in list.
+	 * Returns reference to founded data if succeeded, NULL otherwise.
+	 * */
+	void* unrolledlist_getdata_at(const struct unrolledlist* list, size_t position);
+
+	/*
+	 * Finds the first element that matches given data (isequal function).
+	 * Returns 1 and its position in 'pos' if found, 0 otherwise.
+	 * */
+	int unrolledlist_find(const struct unrolledlist* list, const void* data,
+						  struct unrolledlist_pos* pos);
+
+	/*
+	 * Gets data from the first element that matches given value.
+	 * Returns reference to founded data if succeeded, NULL otherwise.
+	 * */
+	void* unrolledlist_getdata(const struct unrolledlist* list, const void* data);
+
+	/*
+	 * Removes the element at 'pos'.
+	 * Returns the removed data.
+	 * */
+	void* unrolledlist_remove_pos(struct unrolledlist* list, const struct unrolledlist_pos* pos);
+
+	/*
+	 * Removes the first element from list.
+	 * Returns the removed data if succeeded, NULL otherwise.
+	 * */
+	void* unrolledlist_remove_first(struct unrolledlist* list);
+
+	/*
+	 * Removes the first element that matches given data.
+	 * Returns the removed data if succeeded, NULL otherwise.
+	 * */
+	void* unrolledlist_remove(struct unrolledlist* list, const void* data);
+
+	/*
+	 * Starts an iteration at the first element.
+	 * Returns the first element, NULL if list is empty.
+	 * */
+	void* unrolledlist_iter_first(const struct unrolledlist* list, struct unrolledlist_iter* it);
+
+	/*
+	 * Moves to the next element.
+	 * Returns the next element, NULL at the end (it->node is NULL).
+	 * */
+	void* unrolledlist_iter_next(struct unrolledlist_iter* it);
+
+	/*
+	 * Releases the entire list (and elements data if freedata function is defined).
+	 * */
+	void unrolledlist_destroy(struct unrolledlist* list);
+
+#endif /* UNROLLEDLIST_H_ */
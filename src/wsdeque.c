@@ -0,0 +1,179 @@
+/*
+ * wsdeque.c
+ *
+ *  Created on: 14/10/2026
+ *      Author: Tiago C. Teixeira
+ * Description: Chase-Lev work-stealing deque (C11 atomics version of Lê et al.).
+ */
+
+#include <stdlib.h>
+#include "wsdeque.h"
+
+/*
+ * Creates a circular array for 'capacity' (power of two) elements.
+ * Note: Private function.
+ */
+struct wsdeque_array* wsdeque_array_create(size_t capacity)
+{
+	if (capacity > (SIZE_MAX - sizeof(struct wsdeque_array)) / sizeof(void*))
+		return NULL;
+
+	struct wsdeque_array* a = malloc(sizeof(struct wsdeque_array) + capacity * sizeof(void*));
+	if (a == NULL)
+		return NULL;
+
+	a->mask = capacity - 1;
+	a->prev = NULL;
+	return a;
+}
+
+/*
+ * Creates a work-stealing deque for 'capacity' elements (rounded up to a power of two,
+ * grows when full).
+ * Returns NULL if there is no memory.
+ */
+struct wsdeque* wsdeque_create(size_t capacity)
+{
+	size_t size = 2;
+	while (size < capacity && size <= SIZE_MAX / 4)
+		size *= 2;
+
+	struct wsdeque* q = aligned_alloc(WSDEQUE_CACHE_LINE, sizeof(struct wsdeque));
+	if (q == NULL)
+		return NULL;
+
+	struct wsdeque_array* a = wsdeque_array_create(size);
+	if (a == NULL) {
+		free(q);
+		return NULL;
+	}
+
+	atomic_init(&(q->top), 0);
+	atomic_init(&(q->bottom), 0);
+	atomic_init(&(q->array), a);
+	return q;
+}
+
+/*
+ * Replaces the array by one of twice the size holding elements [top, bottom).
+ * Note: Private function (owner thread).
+ */
+struct wsdeque_array* wsdeque_grow(struct wsdeque* q, struct wsdeque_array* a,
+								   int64_t top, int64_t bottom)
+{
+	struct wsdeque_array* b = wsdeque_array_create(2 * (a->mask + 1));
+	if (b == NULL)
+		return NULL;
+
+	for (int64_t i = top; i < bottom; i++)
+		atomic_store_explicit(&(b->items[i & b->mask]),
+							  atomic_load_explicit(&(a->items[i & a->mask]), memory_order_relaxed),
+							  memory_order_relaxed);
+
+	// thieves may still read 'a', keep it until destroy
+	b->prev = a;
+	atomic_store_explicit(&(q->array), b, memory_order_release);
+	return b;
+}
+
+/*
+ * Pushes an element at the bottom (owner thread only).
+ * Returns 1 if succeeded, 0 if there is no memory to grow.
+ */
+int wsdeque_push(struct wsdeque* q, void* x)
+{
+	int64_t b = atomic_load_explicit(&(q->bottom), memory_order_relaxed);
+	int64_t t = atomic_load_explicit(&(q->top), memory_order_acquire);
+	struct wsdeque_array* a = atomic_load_explicit(&(q->array), memory_order_relaxed);
+
+	if (b - t > (int64_t)a->mask) {
+		a = wsdeque_grow(q, a, t, b);
+		if (a == NULL)
+			return 0;
+	}
+
+	atomic_store_explicit(&(a->items[b & a->mask]), x, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&(q->bottom), b + 1, memory_order_relaxed);
+	return 1;
+}
+
+/*
+ * Pops the bottom element into 'out' (owner thread only).
+ * Returns 1 if succeeded, 0 if the deque is empty.
+ */
+int wsdeque_pop(struct wsdeque* q, void** out)
+{
+	int64_t b = atomic_load_explicit(&(q->bottom), memory_order_relaxed) - 1;
+	struct wsdeque_array* a = atomic_load_explicit(&(q->array), memory_order_relaxed);
+
+	// reserve the bottom element before looking at thieves
+	atomic_store_explicit(&(q->bottom), b, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	int64_t t = atomic_load_explicit(&(q->top), memory_order_relaxed);
+
+	if (t > b) {
+		// empty, restore bottom
+		atomic_store_explicit(&(q->bottom), b + 1, memory_order_relaxed);
+		return 0;
+	}
+
+	*out = atomic_load_explicit(&(a->items[b & a->mask]), memory_order_relaxed);
+	if (t < b)
+		return 1;		// more than one element, no thief can reach this one
+
+	// last element: race with thieves for it
+	int won = atomic_compare_exchange_strong_explicit(&(q->top), &t, t + 1,
+													  memory_order_seq_cst, memory_order_relaxed);
+	atomic_store_explicit(&(q->bottom), b + 1, memory_order_relaxed);
+	return won;
+}
+
+/*
+ * Steals the top element into 'out' (any thread).
+ * Returns WSDEQUE_STOLEN, WSDEQUE_EMPTY or WSDEQUE_ABORT (another thread took it).
+ */
+int wsdeque_steal(struct wsdeque* q, void** out)
+{
+	int64_t t = atomic_load_explicit(&(q->top), memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	int64_t b = atomic_load_explicit(&(q->bottom), memory_order_acquire);
+
+	if (t >= b)
+		return WSDEQUE_EMPTY;
+
+	struct wsdeque_array* a = atomic_load_explicit(&(q->array), memory_order_acquire);
+	void* x = atomic_load_explicit(&(a->items[t & a->mask]), memory_order_relaxed);
+	if (!atomic_compare_exchange_strong_explicit(&(q->top), &t, t + 1,
+												 memory_order_seq_cst, memory_order_relaxed))
+		return WSDEQUE_ABORT;
+
+	*out = x;
+	return WSDEQUE_STOLEN;
+}
+
+/*
+ * Gets the number of elements (a snapshot while other threads are working).
+ */
+size_t wsdeque_size(struct wsdeque* q)
+{
+	int64_t b = atomic_load_explicit(&(q->bottom), memory_order_acquire);
+	int64_t t = atomic_load_explicit(&(q->top), memory_order_acquire);
+	return (b > t) ? (size_t)(b - t) : 0;
+}
+
+/*
+ * Releases the deque from memory (elements are not released).
+ * Note: no other thread may be using the deque.
+ */
+void wsdeque_destroy(struct wsdeque* q)
+{
+	struct wsdeque_array* a = atomic_load(&(q->array));
+	while (a != NULL) {
+		struct wsdeque_array* prev = a->prev;
+		free(a);
+		a = prev;
+	}
+
+	free(q);
+}
@@ -0,0 +1,103 @@
+/*****************************************************************************
+ * wsdeque.h
+ *
+ *   Created on: 14/10/2026
+ *       Author: Tiago C. Teixeira
+ *  Description: C headers for a work-stealing deque (Chase-Lev): the owner thread
+ *  			 pushes and pops at the bottom, other threads steal from the top.
+ *
+ *-------------------------------------------------------------
+ *
+ *	Implementation notes
+ *
+ *  The deque is a growable circular array indexed by two counters, 'top' (next element
+ *  to steal) and 'bottom' (next free slot of the owner). Only the owner writes
+ *  'bottom' and the array, so push and pop are plain loads and stores plus one fence:
+ *
+ *  	- push: store the element, then publish bottom + 1 (release);
+ *  	- pop: reserve the bottom element by storing bottom - 1, then read top. If more
+ *  	  than one element is left the element is taken without any atomic operation;
+ *  	  for the last one owner and thieves race with a CAS on 'top';
+ *  	- steal: read top then bottom, read the element and claim it with a CAS on
+ *  	  'top'. A thief losing the race returns WSDEQUE_ABORT and may try elsewhere.
+ *
+ *  The owner works depth-first (LIFO order, hot in its cache) while thieves take the
+ *  oldest elements, which in divide-and-conquer and graph traversals are the largest
+ *  pieces of work, so steals are rare.
+ *
+ *  When full the owner copies the elements to an array of twice the size. Thieves may
+ *  still be reading the old array, so it is kept until the deque is destroyed (all the
+ *  old arrays together are smaller than the current one).
+ *
+ *  Source: D. Chase, Y. Lev, "Dynamic Circular Work-Stealing Deque", SPAA (2005).
+ *  		 N. M. Lê, A. Pop, A. Cohen, F. Zappa Nardelli, "Correct and Efficient
+ *  		 Work-Stealing for Weak Memory Models", PPoPP (2013).
+ *
+ *******************************************************************************/
+
+#ifndef WSDEQUE_H_
+	#define WSDEQUE_H_
+
+	#include <stddef.h>
+	#include <stdint.h>
+	#include <stdatomic.h>
+
+	#define WSDEQUE_DEFAULT_CAPACITY 256
+	#define WSDEQUE_CACHE_LINE 64
+
+	// result of wsdeque_steal
+	#define WSDEQUE_EMPTY 0			// nothing to steal
+	#define WSDEQUE_STOLEN 1		// element stolen
+	#define WSDEQUE_ABORT -1		// lost a race with another thread, try again
+
+	// circular array of the deque
+	struct wsdeque_array {
+		size_t mask;								// capacity - 1 (power of two)
+		struct wsdeque_array* prev;					// replaced array (released on destroy)
+		_Atomic(void*) items[];
+	};
+
+	// work-stealing deque type
+	struct wsdeque {
+		_Atomic int64_t top __attribute__((aligned(WSDEQUE_CACHE_LINE)));		// thieves side
+		_Atomic int64_t bottom __attribute__((aligned(WSDEQUE_CACHE_LINE)));	// owner side
+		_Atomic(struct wsdeque_array*) array;
+	} __attribute__((aligned(WSDEQUE_CACHE_LINE)));
+
+	/*
+	 * Creates a work-stealing deque for 'capacity' elements (rounded up to a power of two,
+	 * grows when full).
+	 * Returns NULL if there is no memory.
+	 */
+	struct wsdeque* wsdeque_create(size_t capacity);
+
+	/*
+	 * Pushes an element at the bottom (owner thread only).
+	 * Returns 1 if succeeded, 0 if there is no memory to grow.
+	 */
+	int wsdeque_push(struct wsdeque* q, void* x);
+
+	/*
+	 * Pops the bottom element into 'out' (owner thread only).
+	 * Returns 1 if succeeded, 0 if the deque is empty.
+	 */
+	int wsdeque_pop(struct wsdeque* q, void** out);
+
+	/*
+	 * Steals the top element into 'out' (any thread).
+	 * Returns WSDEQUE_STOLEN, WSDEQUE_EMPTY or WSDEQUE_ABORT (another thread took it).
+	 */
+	int wsdeque_steal(struct wsdeque* q, void** out);
+
+	/*
+	 * Gets the number of elements (a snapshot while other threads are working).
+	 */
+	size_t wsdeque_size(struct wsdeque* q);
+
+	/*
+	 * Releases the deque from memory (elements are not released).
+	 * Note: no other thread may be using the deque.
+	 */
+	void wsdeque_destroy(struct wsdeque* q);
+
+#endif /* WSDEQUE_H_ */